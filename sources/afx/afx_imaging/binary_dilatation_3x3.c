@@ -39,6 +39,10 @@ XErrorCode BinaryDilatation3x3( const ximage* src, ximage* dst )
     {
         ret = ErrorNullParameter;
     }
+    else if ( src->format == XPixelFormatBinary1 )
+    {
+        ret = BinaryImageDilatation3x3( src, dst );
+    }
     else if ( src->format != XPixelFormatGrayscale8 )
     {
         ret = ErrorUnsupportedPixelFormat;
@@ -65,8 +69,8 @@ XErrorCode BinaryDilatation3x3( const ximage* src, ximage* dst )
 
         uint8_t* srcPtr  = src->data;
         uint8_t* dstPtr  = dst->data;
-        uint8_t* srcPtr2 = srcPtr + srcStride * heightM1 + 1;
-        uint8_t* dstPtr2 = dstPtr + dstStride * heightM1 + 1;
+        uint8_t* srcPtr2 = srcPtr + srcStride * heightM1;
+        uint8_t* dstPtr2 = dstPtr + dstStride * heightM1;
 
         #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, width, srcStride, dstStride )
         for ( y = 1; y < heightM1; y++ )
@@ -103,6 +107,8 @@ XErrorCode BinaryDilatation3x3( const ximage* src, ximage* dst )
 
         srcPtr++;
         dstPtr++;
+        srcPtr2++;
+        dstPtr2++;
 
         for ( tx = 1; tx < widthM1; tx++, dstPtr++, dstPtr2++, srcPtr++, srcPtr2++ )
         {
@@ -39,6 +39,10 @@ XErrorCode BinaryErosion3x3( const ximage* src, ximage* dst )
     {
         ret = ErrorNullParameter;
     }
+    else if ( src->format == XPixelFormatBinary1 )
+    {
+        ret = BinaryImageErosion3x3( src, dst );
+    }
     else if ( src->format != XPixelFormatGrayscale8 )
     {
         ret = ErrorUnsupportedPixelFormat;
@@ -0,0 +1,645 @@
+/*
+    Imaging library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <string.h>
+#include "ximaging.h"
+
+/* Bit-packed binary images:
+ * --------------------------------------
+ * XPixelFormatBinary1 images keep 8 pixels per byte, the most significant
+ * bit being the left most pixel. The routines below process 64 pixels at
+ * once by loading bytes of a row into 64 bit words in big endian order,
+ * so that shifting a word left/right moves pixels left/right.
+ * --------------------------------------
+ */
+
+#define ALL_BITS ( (uint64_t) 0xFFFFFFFFFFFFFFFFull )
+
+// Get mask of pixels, which are within [0, width) range, for the 64 pixels starting from the specified one
+static uint64_t RangeMask( int firstPixel, int width )
+{
+    int      lo  = XMAX( 0, -firstPixel );
+    int      hi  = XMIN( 64, width - firstPixel );
+    uint64_t ret = 0;
+
+    if ( hi > lo )
+    {
+        ret = ( ALL_BITS >> lo );
+
+        if ( hi < 64 )
+        {
+            ret &= ( ALL_BITS << ( 64 - hi ) );
+        }
+    }
+
+    return ret;
+}
+
+// Load 64 pixels of a row starting from the specified one (which may be outside of the row); outside pixels are 0
+static uint64_t LoadPixels( const uint8_t* row, int width, int firstPixel )
+{
+    int      bytesPerLine = ( width + 7 ) >> 3;
+    // floor division, since the first pixel can be negative
+    int      firstByte    = ( firstPixel >= 0 ) ? ( firstPixel >> 3 ) : -( ( -firstPixel + 7 ) >> 3 );
+    int      shift        = firstPixel - firstByte * 8;
+    uint64_t value        = 0;
+    uint8_t  lastByte     = 0;
+    int      i, byteIndex;
+
+    if ( ( firstByte >= 0 ) && ( firstByte + 9 <= bytesPerLine ) )
+    {
+        const uint8_t* ptr = row + firstByte;
+
+        for ( i = 0; i < 8; i++ )
+        {
+            value = ( value << 8 ) | ptr[i];
+        }
+        lastByte = ptr[8];
+    }
+    else
+    {
+        for ( i = 0, byteIndex = firstByte; i < 8; i++, byteIndex++ )
+        {
+            value = ( value << 8 ) | ( ( ( byteIndex >= 0 ) && ( byteIndex < bytesPerLine ) ) ? row[byteIndex] : 0 );
+        }
+        if ( ( byteIndex >= 0 ) && ( byteIndex < bytesPerLine ) )
+        {
+            lastByte = row[byteIndex];
+        }
+    }
+
+    if ( shift != 0 )
+    {
+        value = ( value << shift ) | ( lastByte >> ( 8 - shift ) );
+    }
+
+    return value & RangeMask( firstPixel, width );
+}
+
+// Store 64 pixels of a row starting from the specified word (pixels outside of row's width must be set to 0)
+static void StorePixels( uint8_t* row, int width, int wordIndex, uint64_t value )
+{
+    int bytesPerLine = ( width + 7 ) >> 3;
+    int firstByte    = wordIndex * 8;
+    int bytesToStore = XMIN( 8, bytesPerLine - firstByte );
+    int i;
+
+    for ( i = 0; i < bytesToStore; i++ )
+    {
+        row[firstByte + i] = (uint8_t) ( value >> ( 56 - i * 8 ) );
+    }
+}
+
+// Count number of set bits in a 64 bit word
+static uint32_t PopCount64( uint64_t value )
+{
+    value = value - ( ( value >> 1 ) & 0x5555555555555555ull );
+    value = ( value & 0x3333333333333333ull ) + ( ( value >> 2 ) & 0x3333333333333333ull );
+    value = ( value + ( value >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+
+    return (uint32_t) ( ( value * 0x0101010101010101ull ) >> 56 );
+}
+
+// Make sure the two provided binary images can be used for logic operation
+static XErrorCode CheckBinaryImages( const ximage* image1, const ximage* image2 )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image1 == 0 ) || ( image2 == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( image1->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( image1->format != image2->format ) ||
+              ( image1->width  != image2->width  ) ||
+              ( image1->height != image2->height ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+
+    return ret;
+}
+
+// Logic operations supported by BinaryLogicOperation()
+enum
+{
+    LogicOperation_And = 0,
+    LogicOperation_Or  = 1,
+    LogicOperation_Xor = 2
+};
+
+// Perform logic operation on the two binary images (result is put back to image1)
+static XErrorCode BinaryLogicOperation( ximage* image1, const ximage* image2, int operation )
+{
+    XErrorCode ret = CheckBinaryImages( image1, image2 );
+
+    if ( ret == SuccessCode )
+    {
+        int height       = image1->height;
+        int stride1      = image1->stride;
+        int stride2      = image2->stride;
+        int bytesPerLine = ( image1->width + 7 ) >> 3;
+        int y;
+
+        uint8_t* ptr1 = image1->data;
+        uint8_t* ptr2 = image2->data;
+
+        #pragma omp parallel for schedule(static) shared( ptr1, ptr2, bytesPerLine, stride1, stride2, operation )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row1 = ptr1 + y * stride1;
+            uint8_t* row2 = ptr2 + y * stride2;
+            uint64_t word1, word2;
+            int      x = 0;
+
+            // 64 pixels at a time (byte order does not matter for logic operations)
+            for ( ; x + 8 <= bytesPerLine; x += 8 )
+            {
+                memcpy( &word1, row1 + x, 8 );
+                memcpy( &word2, row2 + x, 8 );
+
+                word1 = ( operation == LogicOperation_And ) ? ( word1 & word2 ) :
+                        ( operation == LogicOperation_Or  ) ? ( word1 | word2 ) : ( word1 ^ word2 );
+
+                memcpy( row1 + x, &word1, 8 );
+            }
+
+            // the rest
+            for ( ; x < bytesPerLine; x++ )
+            {
+                row1[x] = ( operation == LogicOperation_And ) ? ( row1[x] & row2[x] ) :
+                          ( operation == LogicOperation_Or  ) ? ( row1[x] | row2[x] ) : ( row1[x] ^ row2[x] );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Converts grayscale image into bit-packed binary image (non zero pixels are set to 1)
+XErrorCode GrayscaleToBinary( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( src->format != XPixelFormatGrayscale8 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width != dst->width ) || ( src->height != dst->height ) || ( dst->format != XPixelFormatBinary1 ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int width     = src->width;
+        int height    = src->height;
+        int srcStride = src->stride;
+        int dstStride = dst->stride;
+        int y;
+
+        uint8_t* srcPtr = src->data;
+        uint8_t* dstPtr = dst->data;
+
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, width, srcStride, dstStride )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* srcRow = srcPtr + y * srcStride;
+            uint8_t* dstRow = dstPtr + y * dstStride;
+            int      x = 0, i;
+
+            // 8 pixels at a time
+            for ( ; x + 8 <= width; x += 8, srcRow += 8, dstRow++ )
+            {
+                uint8_t value = 0;
+
+                for ( i = 0; i < 8; i++ )
+                {
+                    value = (uint8_t) ( ( value << 1 ) | ( ( srcRow[i] != 0 ) ? 1 : 0 ) );
+                }
+
+                *dstRow = value;
+            }
+
+            // pixels of the last byte, with unused bits set to 0
+            if ( x < width )
+            {
+                uint8_t value = 0;
+
+                for ( i = 0; x < width; x++, i++, srcRow++ )
+                {
+                    if ( *srcRow != 0 )
+                    {
+                        value |= (uint8_t) ( 0x80 >> i );
+                    }
+                }
+
+                *dstRow = value;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Perform logic AND of two binary images (result is put back to image1)
+XErrorCode BinaryImageAnd( ximage* image1, const ximage* image2 )
+{
+    return BinaryLogicOperation( image1, image2, LogicOperation_And );
+}
+
+// Perform logic OR of two binary images (result is put back to image1)
+XErrorCode BinaryImageOr( ximage* image1, const ximage* image2 )
+{
+    return BinaryLogicOperation( image1, image2, LogicOperation_Or );
+}
+
+// Perform logic XOR of two binary images (result is put back to image1)
+XErrorCode BinaryImageXor( ximage* image1, const ximage* image2 )
+{
+    return BinaryLogicOperation( image1, image2, LogicOperation_Xor );
+}
+
+// Invert binary image
+XErrorCode BinaryImageNot( ximage* image )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( image == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( image->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        int     height       = image->height;
+        int     stride       = image->stride;
+        int     bytesPerLine = ( image->width + 7 ) >> 3;
+        // keep unused bits of the last byte set to 0
+        uint8_t lastByteMask = (uint8_t) ( ( image->width & 7 ) == 0 ? 0xFF : ( 0xFF00 >> ( image->width & 7 ) ) );
+        int     y;
+
+        uint8_t* ptr = image->data;
+
+        #pragma omp parallel for schedule(static) shared( ptr, bytesPerLine, stride, lastByteMask )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row = ptr + y * stride;
+            uint64_t word;
+            int      x = 0;
+
+            for ( ; x + 8 <= bytesPerLine; x += 8 )
+            {
+                memcpy( &word, row + x, 8 );
+                word = ~word;
+                memcpy( row + x, &word, 8 );
+            }
+
+            for ( ; x < bytesPerLine; x++ )
+            {
+                row[x] = (uint8_t) ~row[x];
+            }
+
+            row[bytesPerLine - 1] &= lastByteMask;
+        }
+    }
+
+    return ret;
+}
+
+// Count number of set pixels in a binary image
+XErrorCode BinaryImagePopulationCount( const ximage* image, uint32_t* count )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image == 0 ) || ( count == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( image->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        int      width    = image->width;
+        int      height   = image->height;
+        int      stride   = image->stride;
+        int      words    = ( width + 63 ) >> 6;
+        uint32_t total    = 0;
+        int      y;
+
+        uint8_t* ptr = image->data;
+
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* row = ptr + y * stride;
+            int            w;
+
+            for ( w = 0; w < words; w++ )
+            {
+                total += PopCount64( LoadPixels( row, width, w * 64 ) );
+            }
+        }
+
+        *count = total;
+    }
+
+    return ret;
+}
+
+// 3x3 erosion filter for bit-packed binary images (edge pixels are set to 0, same as BinaryErosion3x3() does)
+XErrorCode BinaryImageErosion3x3( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( src->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width < 3 ) || ( src->height < 3 ) )
+    {
+        ret = ErrorImageIsTooSmall;
+    }
+    else if ( ( dst->width  != src->width  ) ||
+              ( dst->height != src->height ) ||
+              ( dst->format != src->format ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int width        = src->width;
+        int height       = src->height;
+        int heightM1     = height - 1;
+        int srcStride    = src->stride;
+        int dstStride    = dst->stride;
+        int words        = ( width + 63 ) >> 6;
+        int bytesPerLine = ( width + 7 ) >> 3;
+        int y;
+
+        uint8_t* srcPtr = src->data;
+        uint8_t* dstPtr = dst->data;
+
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, width, srcStride, dstStride, words )
+        for ( y = 1; y < heightM1; y++ )
+        {
+            const uint8_t* srcRow = srcPtr + y * srcStride;
+            uint8_t*       dstRow = dstPtr + y * dstStride;
+            // previous, current and next words of the 3 rows
+            uint64_t       prev[3] = { 0, 0, 0 }, cur[3], next[3];
+            int            w, i;
+
+            for ( i = 0; i < 3; i++ )
+            {
+                cur[i] = LoadPixels( srcRow + ( i - 1 ) * srcStride, width, 0 );
+            }
+
+            for ( w = 0; w < words; w++ )
+            {
+                int      firstPixel = w * 64;
+                // first and last pixels of a row are always set to 0
+                uint64_t value      = RangeMask( firstPixel - 1, width - 2 );
+
+                for ( i = 0; i < 3; i++ )
+                {
+                    next[i] = LoadPixels( srcRow + ( i - 1 ) * srcStride, width, firstPixel + 64 );
+
+                    // pixel itself, its left and right neighbours
+                    value &= cur[i] & ( ( cur[i] >> 1 ) | ( prev[i] << 63 ) ) & ( ( cur[i] << 1 ) | ( next[i] >> 63 ) );
+
+                    prev[i] = cur[i];
+                    cur[i]  = next[i];
+                }
+
+                StorePixels( dstRow, width, w, value );
+            }
+        }
+
+        // set first and last rows to black
+        memset( dstPtr, 0, bytesPerLine );
+        memset( dstPtr + heightM1 * dstStride, 0, bytesPerLine );
+    }
+
+    return ret;
+}
+
+// 3x3 dilatation filter for bit-packed binary images
+XErrorCode BinaryImageDilatation3x3( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( src->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width < 3 ) || ( src->height < 3 ) )
+    {
+        ret = ErrorImageIsTooSmall;
+    }
+    else if ( ( dst->width  != src->width  ) ||
+              ( dst->height != src->height ) ||
+              ( dst->format != src->format ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int width     = src->width;
+        int height    = src->height;
+        int srcStride = src->stride;
+        int dstStride = dst->stride;
+        int words     = ( width + 63 ) >> 6;
+        int y;
+
+        uint8_t* srcPtr = src->data;
+        uint8_t* dstPtr = dst->data;
+
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, width, height, srcStride, dstStride, words )
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* srcRow = srcPtr + y * srcStride;
+            uint8_t*       dstRow = dstPtr + y * dstStride;
+            // previous, current and next words of the 3 rows (rows outside of the image are kept 0)
+            uint64_t       prev[3] = { 0, 0, 0 }, cur[3] = { 0, 0, 0 }, next[3] = { 0, 0, 0 };
+            int            rowsStart = ( y == 0 ) ? 1 : 0;
+            int            rowsEnd   = ( y == height - 1 ) ? 2 : 3;
+            int            w, i;
+
+            for ( i = rowsStart; i < rowsEnd; i++ )
+            {
+                cur[i] = LoadPixels( srcRow + ( i - 1 ) * srcStride, width, 0 );
+            }
+
+            for ( w = 0; w < words; w++ )
+            {
+                int      firstPixel = w * 64;
+                uint64_t value      = 0;
+
+                // pixels outside of the image are loaded as 0, so don't affect the result
+                for ( i = rowsStart; i < rowsEnd; i++ )
+                {
+                    next[i] = LoadPixels( srcRow + ( i - 1 ) * srcStride, width, firstPixel + 64 );
+
+                    // pixel itself, its left and right neighbours
+                    value |= cur[i] | ( cur[i] >> 1 ) | ( prev[i] << 63 ) | ( cur[i] << 1 ) | ( next[i] >> 63 );
+
+                    prev[i] = cur[i];
+                    cur[i]  = next[i];
+                }
+
+                StorePixels( dstRow, width, w, value & RangeMask( firstPixel, width ) );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Applies hit-and-miss morphological operator to the specified bit-packed binary image.
+// See HitAndMiss() for the description of parameters.
+XErrorCode BinaryImageHitAndMiss( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize, XHitAndMissMode mode )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) || ( se == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( dst->width  != src->width )  ||
+              ( dst->height != src->height ) ||
+              ( dst->format != src->format ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else if ( src->format != XPixelFormatBinary1 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( seSize < 3 ) || ( seSize > 51 ) || ( ( seSize & 1 ) == 0 ) )
+    {
+        // don't allow even kernels or too small/big kernels
+        ret = ErrorArgumentOutOfRange;
+    }
+    else
+    {
+        int width     = src->width;
+        int height    = src->height;
+        int srcStride = src->stride;
+        int dstStride = dst->stride;
+        int radius    = seSize >> 1;
+        int modeIndex = (int) mode;
+        int words     = ( width + 63 ) >> 6;
+        int y;
+
+        uint8_t* srcPtr = src->data;
+        uint8_t* dstPtr = dst->data;
+
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, width, height, srcStride, dstStride, radius, se, modeIndex, words )
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* srcRow = srcPtr + y * srcStride;
+            uint8_t*       dstRow = dstPtr + y * dstStride;
+            int            w, i, j;
+
+            for ( w = 0; w < words; w++ )
+            {
+                int      firstPixel = w * 64;
+                uint64_t inRange    = RangeMask( firstPixel, width );
+                // bits are set for the pixels, which match structuring element so far
+                uint64_t match      = inRange;
+                uint64_t srcValue   = LoadPixels( srcRow, width, firstPixel );
+                int8_t*  sePtr      = se;
+                uint64_t dstValue;
+
+                for ( i = -radius; ( i <= radius ) && ( match != 0 ); i++ )
+                {
+                    const uint8_t* row = srcRow + i * srcStride;
+
+                    for ( j = -radius; j <= radius; j++, sePtr++ )
+                    {
+                        int8_t   seValue = *sePtr;
+                        uint64_t pixels;
+
+                        // skip "don't care" value
+                        if ( seValue == -1 )
+                        {
+                            continue;
+                        }
+
+                        // required pixel is outside of the image or structuring element has unknown value
+                        if ( ( y + i < 0 ) || ( y + i >= height ) || ( ( seValue != 0 ) && ( seValue != 1 ) ) )
+                        {
+                            match = 0;
+                            break;
+                        }
+
+                        pixels = LoadPixels( row, width, firstPixel + j );
+
+                        // pixels outside of the image fail both foreground and background elements
+                        match &= ( seValue == 1 ) ? pixels : ( ~pixels & RangeMask( firstPixel + j, width ) );
+
+                        if ( match == 0 )
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                switch ( modeIndex )
+                {
+                case HMMode_Thinning:
+                    dstValue = srcValue & ~match;
+                    break;
+
+                case HMMode_Thickening:
+                    dstValue = srcValue | match;
+                    break;
+
+                default:
+                    dstValue = match;
+                    break;
+                }
+
+                StorePixels( dstRow, width, w, dstValue & inRange );
+            }
+        }
+    }
+
+    return ret;
+}
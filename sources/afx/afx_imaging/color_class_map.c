@@ -0,0 +1,211 @@
+/*
+    Imaging library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "ximaging.h"
+
+// Color classification map keeps one bit for each of 2^24 colors - bit's index is formed from red, green and blue values
+#define COLOR_CLASS_INDEX(r, g, b) ( ( (uint32_t) (r) << 16 ) | ( (uint32_t) (g) << 8 ) | (uint32_t) (b) )
+
+// Check if HSL color is in the specified range
+static bool IsHslInRange( const xhsl* hsl, uint16_t hueMin, uint16_t hueMax, const xhsl* minValues, const xhsl* maxValues )
+{
+    return ( ( hsl->Saturation >= minValues->Saturation ) && ( hsl->Saturation <= maxValues->Saturation ) &&
+             ( hsl->Luminance >= minValues->Luminance ) && ( hsl->Luminance <= maxValues->Luminance ) &&
+             (
+                ( ( hueMin < hueMax ) &&   ( hsl->Hue >= hueMin ) && ( hsl->Hue <= hueMax ) ) ||
+                ( ( hueMin > hueMax ) && ( ( hsl->Hue >= hueMin ) || ( hsl->Hue <= hueMax ) ) )
+             ) );
+}
+
+// Check if HSV color is in the specified range
+static bool IsHsvInRange( const xhsv* hsv, uint16_t hueMin, uint16_t hueMax, const xhsv* minValues, const xhsv* maxValues )
+{
+    return ( ( hsv->Saturation >= minValues->Saturation ) && ( hsv->Saturation <= maxValues->Saturation ) &&
+             ( hsv->Value >= minValues->Value ) && ( hsv->Value <= maxValues->Value ) &&
+             (
+                ( ( hueMin < hueMax ) &&   ( hsv->Hue >= hueMin ) && ( hsv->Hue <= hueMax ) ) ||
+                ( ( hueMin > hueMax ) && ( ( hsv->Hue >= hueMin ) || ( hsv->Hue <= hueMax ) ) )
+             ) );
+}
+
+// Build color classification map for the specified HSL range
+XErrorCode BuildHslColorClassMap( uint8_t* colorClassMap, xhsl minValues, xhsl maxValues )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( colorClassMap == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        uint16_t hueMin = minValues.Hue % 360;
+        uint16_t hueMax = maxValues.Hue % 360;
+        int      r;
+
+        // every red value fills its own 8K block of the map
+        #pragma omp parallel for schedule(static) shared( colorClassMap, hueMin, hueMax, minValues, maxValues )
+        for ( r = 0; r < 256; r++ )
+        {
+            uint8_t* mapPtr = colorClassMap + ( COLOR_CLASS_INDEX( r, 0, 0 ) >> 3 );
+            xargb    rgb;
+            xhsl     hsl;
+            int      g, b, bit;
+            uint8_t  mask;
+
+            rgb.components.r = (uint8_t) r;
+
+            for ( g = 0; g < 256; g++ )
+            {
+                rgb.components.g = (uint8_t) g;
+
+                for ( b = 0; b < 256; b += 8, mapPtr++ )
+                {
+                    mask = 0;
+
+                    for ( bit = 0; bit < 8; bit++ )
+                    {
+                        rgb.components.b = (uint8_t) ( b + bit );
+
+                        Rgb2Hsl( &rgb, &hsl );
+
+                        if ( IsHslInRange( &hsl, hueMin, hueMax, &minValues, &maxValues ) )
+                        {
+                            mask |= (uint8_t) ( 1 << bit );
+                        }
+                    }
+
+                    *mapPtr = mask;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Build color classification map for the specified HSV range
+XErrorCode BuildHsvColorClassMap( uint8_t* colorClassMap, xhsv minValues, xhsv maxValues )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( colorClassMap == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        uint16_t hueMin = minValues.Hue % 360;
+        uint16_t hueMax = maxValues.Hue % 360;
+        int      r;
+
+        #pragma omp parallel for schedule(static) shared( colorClassMap, hueMin, hueMax, minValues, maxValues )
+        for ( r = 0; r < 256; r++ )
+        {
+            uint8_t* mapPtr = colorClassMap + ( COLOR_CLASS_INDEX( r, 0, 0 ) >> 3 );
+            xargb    rgb;
+            xhsv     hsv;
+            int      g, b, bit;
+            uint8_t  mask;
+
+            rgb.components.r = (uint8_t) r;
+
+            for ( g = 0; g < 256; g++ )
+            {
+                rgb.components.g = (uint8_t) g;
+
+                for ( b = 0; b < 256; b += 8, mapPtr++ )
+                {
+                    mask = 0;
+
+                    for ( bit = 0; bit < 8; bit++ )
+                    {
+                        rgb.components.b = (uint8_t) ( b + bit );
+
+                        Rgb2Hsv( &rgb, &hsv );
+
+                        if ( IsHsvInRange( &hsv, hueMin, hueMax, &minValues, &maxValues ) )
+                        {
+                            mask |= (uint8_t) ( 1 << bit );
+                        }
+                    }
+
+                    *mapPtr = mask;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Remove colors outside/inside of the class defined by color classification map
+XErrorCode ColorClassFiltering( ximage* src, const uint8_t* colorClassMap, bool fillOutside, xargb fillColor )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( colorClassMap == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( src->format != XPixelFormatRGB24 ) && ( src->format != XPixelFormatRGBA32 ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        uint8_t* ptr       = src->data;
+        int      width     = src->width;
+        int      height    = src->height;
+        int      stride    = src->stride;
+        int      pixelSize = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+        // pixels are updated if their class bit is equal to this value
+        uint8_t  fillOnBit = ( fillOutside ) ? 0 : 1;
+        int      y;
+
+        #pragma omp parallel for schedule(static) shared( ptr, width, stride, pixelSize, colorClassMap, fillOnBit, fillColor )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row = ptr + y * stride;
+            uint32_t index;
+            int      x;
+
+            for ( x = 0; x < width; x++, row += pixelSize )
+            {
+                index = COLOR_CLASS_INDEX( row[RedIndex], row[GreenIndex], row[BlueIndex] );
+
+                if ( ( ( colorClassMap[index >> 3] >> ( index & 7 ) ) & 1 ) == fillOnBit )
+                {
+                    row[RedIndex]   = fillColor.components.r;
+                    row[GreenIndex] = fillColor.components.g;
+                    row[BlueIndex]  = fillColor.components.b;
+
+                    if ( pixelSize == 4 )
+                    {
+                        row[AlphaIndex] = fillColor.components.a;
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
@@ -34,147 +34,67 @@
  * --------------------------------------
  */
 
-// forward declaration ----
-static void ContrastStretching8( ximage* src );
-static void ContrastStretching24( ximage* src );
-// ------------------------
-
 // Contrast stretching image processing filter
 XErrorCode ContrastStretching( ximage* src )
 {
-    XErrorCode ret = SuccessCode;
+    uint32_t   values[3][256];
+    xhistogram histograms[3] = { { values[0], 256 }, { values[1], 256 }, { values[2], 256 } };
+    XErrorCode ret = GetImageHistograms( src, histograms );
 
-    if ( src == 0 )
+    if ( ret == SuccessCode )
     {
-        ret = ErrorNullParameter;
-    }
-    else
-    {
-        switch ( src->format )
-        {
-        case XPixelFormatGrayscale8:
-            ContrastStretching8( src );
-            break;
-
-        case XPixelFormatRGB24:
-        case XPixelFormatRGBA32:
-            ContrastStretching24( src );
-            break;
-
-        default:
-            ret = ErrorUnsupportedPixelFormat;
-            break;
-        }
+        ret = ContrastStretchingUsingHistograms( src, &histograms[0], &histograms[1], &histograms[2] );
     }
 
     return ret;
 }
 
-// Contrast stretching image processing filter for 8 bpp grayscale images
-void ContrastStretching8( ximage* src )
+// Contrast stretching image processing filter, which uses already calculated histograms of the image
+// (for grayscale images only the first histogram is used)
+XErrorCode ContrastStretchingUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                              const xhistogram* greenHistogram, const xhistogram* blueHistogram )
 {
-    int width  = src->width;
-    int height = src->height;
-    int offset = src->stride - width;
-    int x, y;
-
-    uint8_t  min = 255;
-    uint8_t  max = 0;
-    uint8_t  value;
-    uint8_t* ptr = src->data;
+    XErrorCode ret = SuccessCode;
 
-    for ( y = 0; y < height; y++ )
+    if ( ( src == 0 ) || ( redHistogram == 0 ) )
     {
-        for ( x = 0; x < width; x++, ptr++ )
-        {
-            value = *ptr;
-
-            if ( value < min )
-            {
-                min = value;
-            }
-            else if ( value > max )
-            {
-                max = value;
-            }
-        }
-
-        ptr += offset;
+        ret = ErrorNullParameter;
     }
-
-    if ( ( min != 0 ) || ( max != 255 ) )
+    else if ( src->format == XPixelFormatGrayscale8 )
     {
-        LevelsLinearGrayscale( src, min, max, 0, 255 );
-    }
-}
-
-// Contrast stretching image processing filter for 24/32 bpp colour images
-void ContrastStretching24( ximage* src )
-{
-    int width     = src->width;
-    int height    = src->height;
-    int pixelSize = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
-    int offset    = src->stride - width * pixelSize;
-    int x, y;
-
-    uint8_t minR = 255;
-    uint8_t maxR = 0;
-    uint8_t minG = 255;
-    uint8_t maxG = 0;
-    uint8_t minB = 255;
-    uint8_t maxB = 0;
-    uint8_t value;
+        uint8_t min = (uint8_t) redHistogram->min;
+        uint8_t max = (uint8_t) redHistogram->max;
 
-    uint8_t* ptr = src->data;
-
-    for ( y = 0; y < height; y++ )
+        if ( ( min != 0 ) || ( max != 255 ) )
+        {
+            ret = LevelsLinearGrayscale( src, min, max, 0, 255 );
+        }
+    }
+    else if ( ( src->format == XPixelFormatRGB24 ) || ( src->format == XPixelFormatRGBA32 ) )
     {
-        for ( x = 0; x < width; x++ )
+        if ( ( greenHistogram == 0 ) || ( blueHistogram == 0 ) )
         {
-            // red component
-            value = ptr[RedIndex];
-
-            if ( value < minR )
-            {
-                minR = value;
-            }
-            else if ( value > maxR )
-            {
-                maxR = value;
-            }
-
-            // green component
-            value = ptr[GreenIndex];
-
-            if ( value < minG )
-            {
-                minG = value;
-            }
-            else if ( value > maxG )
-            {
-                maxG = value;
-            }
-
-            // blue component
-            value = ptr[BlueIndex];
-
-            if ( value < minB )
-            {
-                minB = value;
-            }
-            else if ( value > maxB )
+            ret = ErrorNullParameter;
+        }
+        else
+        {
+            uint8_t minR = (uint8_t) redHistogram->min;
+            uint8_t maxR = (uint8_t) redHistogram->max;
+            uint8_t minG = (uint8_t) greenHistogram->min;
+            uint8_t maxG = (uint8_t) greenHistogram->max;
+            uint8_t minB = (uint8_t) blueHistogram->min;
+            uint8_t maxB = (uint8_t) blueHistogram->max;
+
+            if ( ( minR != 0 ) || ( maxR != 255 ) || ( minG != 0 ) || ( maxG != 255 ) || ( minB != 0 ) || ( maxB != 255 ) )
             {
-                maxB = value;
+                ret = LevelsLinear( src, minR, maxR, 0, 255, minG, maxG, 0, 255, minB, maxB, 0, 255 );
             }
-
-            ptr += pixelSize;
         }
-
-        ptr += offset;
     }
-
-    if ( ( minR != 0 ) || ( maxR != 255 ) || ( minG != 0 ) || ( maxG != 255 ) || ( minB != 0 ) || ( maxB != 255 ) )
+    else
     {
-        LevelsLinear( src, minR, maxR, 0, 255, minG, maxG, 0, 255, minB, maxB, 0, 255 );
+        ret = ErrorUnsupportedPixelFormat;
     }
+
+    return ret;
 }
@@ -19,11 +19,41 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <math.h>
 #include "ximaging.h"
 
-// Calculates distance transformation of a binary image, which represents a distance map -
-// shortest distance from non-background pixel to object's edge.
-XErrorCode DistanceTransformation( const ximage* src, ximage* dst )
+/* Algorithm:
+ * --------------------------------------
+ * Exact Euclidean distance transformation is done in two separable passes
+ * (Meijster/Felzenszwalb style):
+ *
+ * 1) every column is scanned down and up to find distance to the nearest
+ *    feature pixel within the column;
+ * 2) every row finds lower envelope of parabolas (x - i)^2 + g(i)^2 built
+ *    from column distances, which gives squared distance to the nearest
+ *    feature pixel in the whole image.
+ *
+ * Both passes take linear time. Columns are processed by blocks of adjacent
+ * columns and rows are processed independently, so both passes run in
+ * parallel. Feature pixels are background pixels when calculating distance
+ * for objects, and object pixels when calculating distance for background.
+ * In the first case pixels outside of the image are treated as background.
+ * --------------------------------------
+ */
+
+// Number of adjacent columns processed together by the first pass
+#define COLUMNS_BLOCK_SIZE  (64)
+// Number of rows processed by the second pass using the same scratch buffers
+#define ROWS_BLOCK_SIZE     (16)
+
+// Floor of integer division for positive denominator
+static int64_t FloorDiv( int64_t numerator, int64_t denominator )
+{
+    return ( numerator >= 0 ) ? numerator / denominator : -( ( -numerator + denominator - 1 ) / denominator );
+}
+
+// Calculates exact Euclidean distance transformation of a binary image (see ximaging.h for details)
+XErrorCode EuclideanDistanceTransformation( const ximage* src, ximage* dst, ximage* nearestFeatures, bool backgroundDistance )
 {
     XErrorCode ret = SuccessCode;
 
@@ -36,424 +66,257 @@ XErrorCode DistanceTransformation( const ximage* src, ximage* dst )
         ret = ErrorUnsupportedPixelFormat;
     }
     else if ( ( dst->width  != src->width  ) ||
-              ( dst->height != src->height ) )
+              ( dst->height != src->height ) ||
+              ( ( nearestFeatures != 0 ) && ( ( nearestFeatures->width  != src->width  ) ||
+                                              ( nearestFeatures->height != src->height ) ) ) )
     {
         ret = ErrorImageParametersMismatch;
     }
-    else if ( dst->format != XPixelFormatGrayscale16 )
+    else if ( ( ( dst->format != XPixelFormatGrayscale16 ) &&
+                ( dst->format != XPixelFormatGrayscale32 ) &&
+                ( dst->format != XPixelFormatGrayscaleR4 ) ) ||
+              ( ( nearestFeatures != 0 ) && ( nearestFeatures->format != XPixelFormatGrayscale32 ) ) )
     {
         ret = ErrorInvalidArgument;
     }
     else
     {
-        int width     = src->width;
-        int height    = src->height;
-        int widthM1   = width - 1;
-        int srcStride = src->stride;
-        int dstStride = dst->stride;
-        int x, y;
-
-        uint8_t*  srcPtr = src->data;
-        uint8_t*  dstPtr = dst->data;
-        uint8_t*  srcRow;
-        uint16_t* dstRow;
-        uint16_t* dstRowPrev;
-        uint16_t  value, temp;
-
-        // --- going from top/left to bottom/right ---
-
-        // --- first row
-        dstRow = (uint16_t*) dstPtr;
-        srcRow = srcPtr;
-
-        for ( x = 0; x < width; x++ )
+        int      width          = src->width;
+        int      height         = src->height;
+        int      srcStride      = src->stride;
+        int      dstStride      = dst->stride;
+        int      nearestStride  = ( nearestFeatures != 0 ) ? nearestFeatures->stride : 0;
+        int      dstFormat      = (int) dst->format;
+        // pixels outside of image are features (background) only when calculating distance for objects
+        bool     outsideFeature = ( !backgroundDistance );
+        // number of parabolas' sites per row - including two virtual features outside of the image if needed
+        int      sitesCount     = ( outsideFeature ) ? width + 2 : width;
+        int      firstSite      = ( outsideFeature ) ? -1 : 0;
+        // distance, which is bigger than anything possible within image, used if there are no features
+        int64_t  infinity       = (int64_t) width + height + 2;
+        int64_t  infinity2      = infinity * infinity;
+        // distance reported if there are no features at all
+        uint16_t noFeatureValue = (uint16_t) XMIN( 65535, XMAX( width, height ) );
+        int      columnBlocks   = ( width  + COLUMNS_BLOCK_SIZE - 1 ) / COLUMNS_BLOCK_SIZE;
+        int      rowBlocks      = ( height + ROWS_BLOCK_SIZE - 1 ) / ROWS_BLOCK_SIZE;
+        int      block;
+
+        uint8_t* srcPtr     = src->data;
+        uint8_t* dstPtr     = dst->data;
+        uint8_t* nearestPtr = ( nearestFeatures != 0 ) ? nearestFeatures->data : 0;
+
+        // distance to the nearest feature within column and row of that feature (-1 if outside or none)
+        int32_t* columnDistance = (int32_t*) XMAlloc( sizeof( int32_t ) * width * height );
+        int32_t* columnFeature  = ( nearestFeatures != 0 ) ? (int32_t*) XMAlloc( sizeof( int32_t ) * width * height ) : 0;
+        // sites of the lower envelope and starting points of their regions (for every block of rows)
+        int32_t* envelopeSites  = (int32_t*) XMAlloc( sizeof( int32_t ) * sitesCount * rowBlocks );
+        int64_t* envelopeStarts = (int64_t*) XMAlloc( sizeof( int64_t ) * sitesCount * rowBlocks );
+
+        if ( ( columnDistance == 0 ) || ( envelopeSites == 0 ) || ( envelopeStarts == 0 ) ||
+             ( ( nearestFeatures != 0 ) && ( columnFeature == 0 ) ) )
         {
-            *dstRow = ( *srcRow == 0 ) ? 0 : 1;
-
-            dstRow++;
-            srcRow++;
+            ret = ErrorOutOfMemory;
         }
-
-        // --- rest of the rows
-        for ( y = 1; y < height; y++ )
+        else
         {
-            srcRow     = srcPtr + y * srcStride;
-            dstRow     = (uint16_t*) ( dstPtr + y * dstStride );
-            dstRowPrev = (uint16_t*) ( dstPtr + ( y - 1 ) * dstStride );
-
-            // first pixel of the row
-            *dstRow = ( *srcRow == 0 ) ? 0 : 1;
-            // last pixel of the row
-            dstRow[widthM1] = ( srcRow[widthM1] == 0 ) ? 0 : 1;
-
-            // pixels between first and last
-            srcRow++;
-            dstRow++;
-            dstRowPrev++;
-
-            // pixels between first and last
-            for ( x = 1; x < widthM1; x++ )
+            // --- 1st pass - distance to the nearest feature within column ---
+            #pragma omp parallel for schedule(static) shared( srcPtr, columnDistance, columnFeature, width, height, srcStride, outsideFeature, infinity, backgroundDistance )
+            for ( block = 0; block < columnBlocks; block++ )
             {
-                if ( *srcRow == 0 )
-                {
-                    *dstRow = 0;
-                }
-                else
+                int startX = block * COLUMNS_BLOCK_SIZE;
+                int endX   = XMIN( startX + COLUMNS_BLOCK_SIZE, width );
+                int x, y;
+
+                // going down
+                for ( y = 0; y < height; y++ )
                 {
-                    value = dstRow[-1];
+                    const uint8_t* srcRow      = srcPtr + y * srcStride;
+                    int32_t*       distanceRow = columnDistance + y * width;
+                    int32_t*       featureRow  = ( columnFeature != 0 ) ? columnFeature + y * width : 0;
 
-                    temp = dstRowPrev[-1];
-                    if ( temp < value )
+                    for ( x = startX; x < endX; x++ )
                     {
-                        value = temp;
+                        int32_t distance, feature;
+
+                        if ( ( srcRow[x] != 0 ) == backgroundDistance )
+                        {
+                            distance = 0;
+                            feature  = y;
+                        }
+                        else if ( y == 0 )
+                        {
+                            distance = ( outsideFeature ) ? 1 : (int32_t) infinity;
+                            feature  = -1;
+                        }
+                        else
+                        {
+                            distance = distanceRow[x - width];
+                            feature  = ( featureRow != 0 ) ? featureRow[x - width] : -1;
+
+                            if ( distance < infinity )
+                            {
+                                distance++;
+                            }
+                        }
+
+                        distanceRow[x] = distance;
+                        if ( featureRow != 0 )
+                        {
+                            featureRow[x] = feature;
+                        }
                     }
+                }
 
-                    temp = *dstRowPrev;
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
+                // going up
+                for ( y = height - 1; y >= 0; y-- )
+                {
+                    int32_t* distanceRow = columnDistance + y * width;
+                    int32_t* featureRow  = ( columnFeature != 0 ) ? columnFeature + y * width : 0;
 
-                    temp = dstRowPrev[1];
-                    if ( temp < value )
+                    for ( x = startX; x < endX; x++ )
                     {
-                        value = temp;
+                        int32_t distance, feature;
+
+                        if ( y == height - 1 )
+                        {
+                            distance = ( outsideFeature ) ? 1 : (int32_t) infinity;
+                            feature  = -1;
+                        }
+                        else
+                        {
+                            distance = distanceRow[x + width];
+                            feature  = ( featureRow != 0 ) ? featureRow[x + width] : -1;
+
+                            if ( distance < infinity )
+                            {
+                                distance++;
+                            }
+                        }
+
+                        if ( distance < distanceRow[x] )
+                        {
+                            distanceRow[x] = distance;
+                            if ( featureRow != 0 )
+                            {
+                                featureRow[x] = feature;
+                            }
+                        }
                     }
-
-                    *dstRow = value + 1;
                 }
-
-                srcRow++;
-                dstRow++;
-                dstRowPrev++;
             }
-        }
-
-        // --- going from bottom/right to top/left ---
 
-        // --- last row
-        dstRow = (uint16_t*) ( dstPtr + ( height - 1 ) * dstStride + widthM1 * 2 );
-
-        for ( x = 0; x < width; x++ )
-        {
-            if ( *dstRow != 0 )
+            // --- 2nd pass - lower envelope of parabolas for every row ---
+            #pragma omp parallel for schedule(static) shared( dstPtr, nearestPtr, columnDistance, columnFeature, envelopeSites, envelopeStarts, width, height, dstStride, nearestStride, dstFormat, sitesCount, firstSite, infinity, infinity2, noFeatureValue )
+            for ( block = 0; block < rowBlocks; block++ )
             {
-                // if source is 0, the destination is set to 0 already before. so check if non 0 only
-                *dstRow = 1;
-            }
-
-            dstRow--;
-        }
+                int32_t* sites  = envelopeSites  + block * sitesCount;
+                int64_t* starts = envelopeStarts + block * sitesCount;
+                int      startY = block * ROWS_BLOCK_SIZE;
+                int      endY   = XMIN( startY + ROWS_BLOCK_SIZE, height );
+                int      x, y, i, k, envelopeSize;
 
-        // --- rest of the rows
-        for ( y = height - 2; y >= 0; y-- )
-        {
-            dstRow     = (uint16_t*) ( dstPtr + y * dstStride + ( widthM1 - 1 ) * 2 );
-            dstRowPrev = (uint16_t*) ( dstPtr + ( y + 1 ) * dstStride + ( widthM1 - 1 ) * 2 );
-
-            // pixels between last and first
-            for ( x = 1; x < widthM1; x++ )
-            {
-                if ( *dstRow != 0 )
+                for ( y = startY; y < endY; y++ )
                 {
-                    value = dstRow[1];
+                    const int32_t* distanceRow = columnDistance + y * width;
+                    const int32_t* featureRow  = ( columnFeature != 0 ) ? columnFeature + y * width : 0;
+                    uint8_t*       dstRow      = dstPtr + y * dstStride;
+                    uint32_t*      nearestRow  = ( nearestPtr != 0 ) ? (uint32_t*) ( nearestPtr + y * nearestStride ) : 0;
 
-                    temp = dstRowPrev[1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
+                    // build lower envelope of parabolas - sites are columns (virtual ones are -1 and width)
+                    k = -1;
 
-                    temp = *dstRowPrev;
-                    if ( temp < value )
+                    for ( i = firstSite; i < firstSite + sitesCount; i++ )
                     {
-                        value = temp;
+                        int64_t g  = ( ( i < 0 ) || ( i >= width ) ) ? 0 : distanceRow[i];
+                        int64_t g2 = g * g;
+                        int64_t separation = 0;
+
+                        while ( k >= 0 )
+                        {
+                            // last x for which the previous site is still nearer than the new one
+                            int64_t prev  = sites[k];
+                            int64_t prevG = ( ( prev < 0 ) || ( prev >= width ) ) ? 0 : distanceRow[prev];
+
+                            separation = FloorDiv( (int64_t) i * i - prev * prev + g2 - prevG * prevG, 2 * ( i - prev ) );
+
+                            if ( separation >= starts[k] )
+                            {
+                                break;
+                            }
+                            k--;
+                        }
+
+                        k++;
+                        sites[k]  = i;
+                        starts[k] = ( k == 0 ) ? INT64_MIN : separation + 1;
                     }
 
-                    temp = dstRowPrev[-1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
+                    envelopeSize = k + 1;
 
-                    if ( value < *dstRow )
+                    // find squared distance for every pixel of the row from the envelope
+                    for ( x = 0, k = 0; x < width; x++ )
                     {
-                        *dstRow = value + 1;
+                        int64_t site, g, distance2;
+
+                        while ( ( k + 1 < envelopeSize ) && ( starts[k + 1] <= x ) )
+                        {
+                            k++;
+                        }
+
+                        site      = sites[k];
+                        g         = ( ( site < 0 ) || ( site >= width ) ) ? 0 : distanceRow[site];
+                        distance2 = ( x - site ) * ( x - site ) + g * g;
+
+                        if ( dstFormat == XPixelFormatGrayscale16 )
+                        {
+                            ( (uint16_t*) dstRow )[x] = ( distance2 >= infinity2 ) ? noFeatureValue :
+                                (uint16_t) XMIN( 65535, (int64_t) ( sqrt( (double) distance2 ) + 0.5 ) );
+                        }
+                        else if ( dstFormat == XPixelFormatGrayscale32 )
+                        {
+                            ( (uint32_t*) dstRow )[x] = ( distance2 >= infinity2 ) ? 0xFFFFFFFF :
+                                (uint32_t) XMIN( 0xFFFFFFFE, distance2 );
+                        }
+                        else
+                        {
+                            ( (float*) dstRow )[x] = ( distance2 >= infinity2 ) ? (float) noFeatureValue :
+                                (float) sqrt( (double) distance2 );
+                        }
+
+                        if ( nearestRow != 0 )
+                        {
+                            int32_t featureY = ( ( site < 0 ) || ( site >= width ) || ( distance2 >= infinity2 ) ) ? -1 : featureRow[site];
+
+                            nearestRow[x] = ( featureY < 0 ) ? 0xFFFFFFFF : (uint32_t) featureY * (uint32_t) width + (uint32_t) site;
+                        }
                     }
                 }
-
-                dstRow--;
-                dstRowPrev--;
             }
         }
+
+        XFree( (void**) &columnDistance );
+        XFree( (void**) &columnFeature );
+        XFree( (void**) &envelopeSites );
+        XFree( (void**) &envelopeStarts );
     }
 
     return ret;
 }
 
+// Calculates distance transformation of a binary image, which represents a distance map -
+// shortest distance from non-background pixel to object's edge.
+XErrorCode DistanceTransformation( const ximage* src, ximage* dst )
+{
+    return ( ( dst != 0 ) && ( dst->format != XPixelFormatGrayscale16 ) ) ? ErrorInvalidArgument :
+           EuclideanDistanceTransformation( src, dst, 0, false );
+}
+
 // Calculates distance transformation of background in a binary image, which represents a distance map -
 // shortest distance from background pixel to an object.
 XErrorCode BackgroundDistanceTransformation( const ximage* src, ximage* dst )
 {
-    XErrorCode ret = SuccessCode;
-
-    if ( ( src == 0 ) || ( dst == 0 ) )
-    {
-        ret = ErrorNullParameter;
-    }
-    else if ( src->format != XPixelFormatGrayscale8 )
-    {
-        ret = ErrorUnsupportedPixelFormat;
-    }
-    else if ( ( dst->width  != src->width  ) ||
-              ( dst->height != src->height ) )
-    {
-        ret = ErrorImageParametersMismatch;
-    }
-    else if ( dst->format != XPixelFormatGrayscale16 )
-    {
-        ret = ErrorInvalidArgument;
-    }
-    else
-    {
-        int width     = src->width;
-        int height    = src->height;
-        int widthM1   = width - 1;
-        int srcStride = src->stride;
-        int dstStride = dst->stride;
-        int x, y;
-
-        uint8_t*  srcPtr = src->data;
-        uint8_t*  dstPtr = dst->data;
-        uint8_t*  srcRow;
-        uint16_t* dstRow;
-        uint16_t* dstRowPrev;
-        uint16_t  value, temp;
-        uint16_t  mapMaxValue = (uint16_t) XMAX( width, height );
-
-        // --- going from top/left to bottom/right ---
-
-        // --- first row
-        dstRow = (uint16_t*) dstPtr;
-        srcRow = srcPtr;
-
-        *dstRow = ( *srcRow != 0 ) ? 0 : mapMaxValue; // first pixel
-        dstRow++;
-        srcRow++;
-
-        for ( x = 1; x < width; x++ )
-        {
-            if ( *srcRow != 0 )
-            {
-                *dstRow = 0;
-            }
-            else
-            {
-                *dstRow = ( dstRow[-1] == mapMaxValue ) ? mapMaxValue : dstRow[-1] + 1;
-            }
-
-            dstRow++;
-            srcRow++;
-        }
-
-        // --- rest of the rows
-        for ( y = 1; y < height; y++ )
-        {
-            srcRow     = srcPtr + y * srcStride;
-            dstRow     = (uint16_t*) ( dstPtr + y * dstStride );
-            dstRowPrev = (uint16_t*) ( dstPtr + ( y - 1 ) * dstStride );
-
-            // first pixel of the row
-            if ( *srcRow != 0 )
-            {
-                *dstRow = 0;
-            }
-            else
-            {
-                value = *dstRowPrev;
-
-                temp = dstRowPrev[1];
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                *dstRow = value + 1;
-            }
-
-            // pixels between first and last
-            srcRow++;
-            dstRow++;
-            dstRowPrev++;
-
-            // pixels between first and last
-            for ( x = 1; x < widthM1; x++ )
-            {
-                if ( *srcRow != 0 )
-                {
-                    *dstRow = 0;
-                }
-                else
-                {
-                    value = dstRow[-1];
-
-                    temp = dstRowPrev[-1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    temp = *dstRowPrev;
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    temp = dstRowPrev[1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    *dstRow = value + 1;
-                }
-
-                srcRow++;
-                dstRow++;
-                dstRowPrev++;
-            }
-
-            // last pixel of the row
-            if ( *srcRow != 0 )
-            {
-                *dstRow = 0;
-            }
-            else
-            {
-                value = dstRow[-1];
-
-                temp = dstRowPrev[-1];
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                temp = *dstRowPrev;
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                *dstRow = value + 1;
-            }
-        }
-
-        // --- going from bottom/right to top/left ---
-
-        // --- last row
-        // skip the very last pixel, since it should get correct distance in any case
-        dstRow = (uint16_t*) ( dstPtr + ( height - 1 ) * dstStride + ( widthM1 - 1 ) * 2 );
-
-        for ( x = 1; x < width; x++ )
-        {
-            if ( *dstRow != 0 )
-            {
-                if ( dstRow[1] < *dstRow )
-                {
-                    *dstRow = dstRow[1] + 1;
-                }
-            }
-
-            dstRow--;
-        }
-
-        // --- rest of the rows
-        for ( y = height - 2; y >= 0; y-- )
-        {
-            dstRow     = (uint16_t*) ( dstPtr + y * dstStride + widthM1 * 2 );
-            dstRowPrev = (uint16_t*) ( dstPtr + ( y + 1 ) * dstStride + widthM1 * 2 );
-
-            // last pixel of the row
-            if ( *dstRow != 0 )
-            {
-                value = *dstRowPrev;
-
-                temp = dstRowPrev[-1];
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                if ( value < *dstRow )
-                {
-                    *dstRow = value + 1;
-                }
-            }
-
-            dstRow--;
-            dstRowPrev--;
-
-            // pixels between last and first
-            for ( x = 1; x < widthM1; x++ )
-            {
-                if ( *dstRow != 0 )
-                {
-                    value = dstRow[1];
-
-                    temp = dstRowPrev[1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    temp = *dstRowPrev;
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    temp = dstRowPrev[-1];
-                    if ( temp < value )
-                    {
-                        value = temp;
-                    }
-
-                    if ( value < *dstRow )
-                    {
-                        *dstRow = value + 1;
-                    }
-                }
-
-                dstRow--;
-                dstRowPrev--;
-            }
-
-            // first pixel of the row
-            if ( *dstRow != 0 )
-            {
-                value = dstRow[1];
-
-                temp = dstRowPrev[1];
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                temp = *dstRowPrev;
-                if ( temp < value )
-                {
-                    value = temp;
-                }
-
-                if ( value < *dstRow )
-                {
-                    *dstRow = value + 1;
-                }
-            }
-        }
-    }
-
-    return ret;
+    return ( ( dst != 0 ) && ( dst->format != XPixelFormatGrayscale16 ) ) ? ErrorInvalidArgument :
+           EuclideanDistanceTransformation( src, dst, 0, true );
 }
 
 // Removes specified amount of objects' edges in a segmented grayscale image
@@ -2324,16 +2324,16 @@ XErrorCode XDrawingMaskedFill( ximage* image, const ximage* mask, int32_t maskX,
             {
                 uint8_t* imageRow = imagePtr + y * stride + startX;
                 uint8_t* maskRow  = maskPtr + y * maskStride + startX;
-                float    fillCoef, imageCoef;
+                uint32_t fillCoef, imageCoef;
                 int      x;
 
                 for ( x = startX; x < stopX; x++ )
                 {
-                    fillCoef  = (float)( *maskRow ) / 255.0f;
-                    imageCoef = 1.0f - fillCoef;
+                    fillCoef  = *maskRow;
+                    imageCoef = 255 - fillCoef;
 
-                    *imageRow = (uint8_t) ( fillCoef  * fillValue +
-                                           imageCoef * *imageRow );
+                    *imageRow = (uint8_t) ( ( fillCoef  * fillValue +
+                                              imageCoef * *imageRow ) / 255 );
 
                     imageRow++;
                     maskRow++;
@@ -2349,25 +2349,40 @@ XErrorCode XDrawingMaskedFill( ximage* image, const ximage* mask, int32_t maskX,
             {
                 uint8_t* imageRow = imagePtr + y * stride + startX * pixelSize;
                 uint8_t* maskRow  = maskPtr + y * maskStride + startX;
-                float    fillCoef, imageCoef;
+                uint32_t fillCoef, imageCoef;
                 int      x;
 
                 for ( x = startX; x < stopX; x++ )
                 {
-                    fillCoef  = (float)( *maskRow ) / 255.0f;
-                    imageCoef = 1.0f - fillCoef;
+                    fillCoef  = *maskRow;
+                    imageCoef = 255 - fillCoef;
 
-                    imageRow[RedIndex]   = (uint8_t)( fillCoef  * fillColor.components.r +
-                                                      imageCoef * imageRow[RedIndex] );
-                    imageRow[GreenIndex] = (uint8_t)( fillCoef  * fillColor.components.g +
-                                                      imageCoef * imageRow[GreenIndex] );
-                    imageRow[BlueIndex]  = (uint8_t)( fillCoef  * fillColor.components.b +
-                                                      imageCoef * imageRow[BlueIndex] );
+                    // most of the mask is usually either empty or full, so avoid blending for those
+                    if ( fillCoef == 255 )
+                    {
+                        imageRow[RedIndex]   = fillColor.components.r;
+                        imageRow[GreenIndex] = fillColor.components.g;
+                        imageRow[BlueIndex]  = fillColor.components.b;
 
-                    if ( pixelSize == 4 )
+                        if ( pixelSize == 4 )
+                        {
+                            imageRow[AlphaIndex] = fillColor.components.a;
+                        }
+                    }
+                    else if ( fillCoef != 0 )
                     {
-                        imageRow[AlphaIndex]  = (uint8_t)( fillCoef  * fillColor.components.a +
-                                                           imageCoef * imageRow[AlphaIndex] );
+                        imageRow[RedIndex]   = (uint8_t)( ( fillCoef  * fillColor.components.r +
+                                                            imageCoef * imageRow[RedIndex] ) / 255 );
+                        imageRow[GreenIndex] = (uint8_t)( ( fillCoef  * fillColor.components.g +
+                                                            imageCoef * imageRow[GreenIndex] ) / 255 );
+                        imageRow[BlueIndex]  = (uint8_t)( ( fillCoef  * fillColor.components.b +
+                                                            imageCoef * imageRow[BlueIndex] ) / 255 );
+
+                        if ( pixelSize == 4 )
+                        {
+                            imageRow[AlphaIndex] = (uint8_t)( ( fillCoef  * fillColor.components.a +
+                                                                imageCoef * imageRow[AlphaIndex] ) / 255 );
+                        }
                     }
 
                     imageRow += pixelSize;
@@ -25,6 +25,8 @@
 // Then it updates all pixel value multiplying them with next coefficients: mean/redMean, mean/greenMean, mean/blueMean
 XErrorCode GrayWorldNormalization( ximage* src )
 {
+    uint32_t   values[3][256];
+    xhistogram histograms[3] = { { values[0], 256 }, { values[1], 256 }, { values[2], 256 } };
     XErrorCode ret = SuccessCode;
 
     if ( src == 0 )
@@ -37,14 +39,38 @@ XErrorCode GrayWorldNormalization( ximage* src )
     }
     else
     {
-        int width     = src->width;
-        int height    = src->height;
-        int area      = width * height;
-        int stride    = src->stride;
-        int pixelSize = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
-        int x, y, i;
+        ret = GetColorImageHistograms( src, &histograms[0], &histograms[1], &histograms[2] );
 
-        uint8_t* base = src->data;
+        if ( ret == SuccessCode )
+        {
+            ret = GrayWorldNormalizationUsingHistograms( src, &histograms[0], &histograms[1], &histograms[2] );
+        }
+    }
+
+    return ret;
+}
+
+// Performs gray world normalization filter using already calculated RGB histograms of the image
+XErrorCode GrayWorldNormalizationUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                                  const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( redHistogram == 0 ) || ( greenHistogram == 0 ) || ( blueHistogram == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( src->format != XPixelFormatRGB24 ) && ( src->format != XPixelFormatRGBA32 ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        double   area = (double) src->width * src->height;
+        uint64_t rsum = 0;
+        uint64_t gsum = 0;
+        uint64_t bsum = 0;
+        int      i;
 
         double rmean, gmean, bmean, mean;
         float  kr, kg, kb;
@@ -53,51 +79,18 @@ XErrorCode GrayWorldNormalization( ximage* src )
         uint8_t greenMap[256];
         uint8_t blueMap[256];
 
-        if ( area < 0xFFFFFF )
-        {
-            uint32_t rsum = 0;
-            uint32_t gsum = 0;
-            uint32_t bsum = 0;
-
-            for ( y = 0; y < height; y++ )
-            {
-                uint8_t* ptr = base + y * stride;
-
-                for ( x = 0; x < width; x++, ptr += pixelSize )
-                {
-                    rsum += ptr[RedIndex];
-                    gsum += ptr[GreenIndex];
-                    bsum += ptr[BlueIndex];
-                }
-            }
-
-            rmean = (double) rsum / area;
-            gmean = (double) gsum / area;
-            bmean = (double) bsum / area;
-        }
-        else
+        // sums of pixel values are restored from histograms, so no need in another pass over the image
+        for ( i = 0; i < 256; i++ )
         {
-            double rsum = 0;
-            double gsum = 0;
-            double bsum = 0;
-
-            for ( y = 0; y < height; y++ )
-            {
-                uint8_t* ptr = base + y * stride;
-
-                for ( x = 0; x < width; x++, ptr += pixelSize )
-                {
-                    rsum += ptr[RedIndex];
-                    gsum += ptr[GreenIndex];
-                    bsum += ptr[BlueIndex];
-                }
-            }
-
-            rmean = rsum / area;
-            gmean = gsum / area;
-            bmean = bsum / area;
+            rsum += (uint64_t) redHistogram->values[i]   * i;
+            gsum += (uint64_t) greenHistogram->values[i] * i;
+            bsum += (uint64_t) blueHistogram->values[i]  * i;
         }
 
+        rmean = (double) rsum / area;
+        gmean = (double) gsum / area;
+        bmean = (double) bsum / area;
+
         mean = ( rmean + gmean + bmean ) / 3;
 
         kr = (float) ( mean / rmean );
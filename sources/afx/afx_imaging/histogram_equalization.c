@@ -19,7 +19,6 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
-#include <stdlib.h>
 #include "ximaging.h"
 
 /* Algorithm:
@@ -35,37 +34,16 @@
  * --------------------------------------
  */
 
-// forward declaration ----
-static void HistogramEqualization8( ximage* src );
-static void HistogramEqualization24( ximage* src );
-// ------------------------
-
 // Histogram equalization image processing filter
 XErrorCode HistogramEqualization( ximage* src )
 {
-    XErrorCode ret = SuccessCode;
+    uint32_t   values[3][256];
+    xhistogram histograms[3] = { { values[0], 256 }, { values[1], 256 }, { values[2], 256 } };
+    XErrorCode ret = GetImageHistograms( src, histograms );
 
-    if ( src == 0 )
-    {
-        ret = ErrorNullParameter;
-    }
-    else
+    if ( ret == SuccessCode )
     {
-        switch ( src->format )
-        {
-        case XPixelFormatGrayscale8:
-            HistogramEqualization8( src );
-            break;
-
-        case XPixelFormatRGB24:
-        case XPixelFormatRGBA32:
-            HistogramEqualization24( src );
-            break;
-
-        default:
-            ret = ErrorUnsupportedPixelFormat;
-            break;
-        }
+        ret = HistogramEqualizationUsingHistograms( src, &histograms[0], &histograms[1], &histograms[2] );
     }
 
     return ret;
@@ -89,80 +67,47 @@ static void EqualizeHistogram( const uint32_t* histogram, uint32_t pixelsCount,
     }
 }
 
-// Histogram equalization image processing filter for 8bpp grayscale images
-void HistogramEqualization8( ximage* src )
+// Histogram equalization image processing filter, which uses already calculated histograms of the image
+// (for grayscale images only the first histogram is used)
+XErrorCode HistogramEqualizationUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                                 const xhistogram* greenHistogram, const xhistogram* blueHistogram )
 {
-    int width  = src->width;
-    int height = src->height;
-    int offset = src->stride - width;
-    int x, y;
-
-    uint8_t* ptr = src->data;
+    XErrorCode ret = SuccessCode;
 
-    uint32_t* histogram = (uint32_t*) calloc( 256, sizeof( uint32_t ) );
-    uint8_t*  map = (uint8_t*) calloc( 256, sizeof( uint8_t ) );
+    uint8_t mapR[256];
+    uint8_t mapG[256];
+    uint8_t mapB[256];
 
-    for ( y = 0; y < height; y++ )
+    if ( ( src == 0 ) || ( redHistogram == 0 ) )
     {
-        for ( x = 0; x < width; x++ )
-        {
-            histogram[*ptr]++;
-            ptr++;
-        }
-
-        ptr += offset;
+        ret = ErrorNullParameter;
     }
-
-    EqualizeHistogram( histogram, src->width * src->height, map );
-    GrayscaleRemapping( src, map );
-
-    free( histogram );
-    free( map );
-}
-
-// Histogram equalization image processing filter for 24/32bpp grayscale images
-void HistogramEqualization24( ximage* src )
-{
-    int width     = src->width;
-    int height    = src->height;
-    int pixelSize = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
-    int offset    = src->stride - width * pixelSize;
-    int x, y;
-
-    uint32_t pixelsCount = src->width * src->height;
-    uint8_t* ptr = src->data;
-
-    uint32_t* histogramR = (uint32_t*) calloc( 256, sizeof( uint32_t ) );
-    uint32_t* histogramG = (uint32_t*) calloc( 256, sizeof( uint32_t ) );
-    uint32_t* histogramB = (uint32_t*) calloc( 256, sizeof( uint32_t ) );
-    uint8_t*  mapR = (uint8_t*) calloc( 256, sizeof( uint8_t ) );
-    uint8_t*  mapG = (uint8_t*) calloc( 256, sizeof( uint8_t ) );
-    uint8_t*  mapB = (uint8_t*) calloc( 256, sizeof( uint8_t ) );
-
-    for ( y = 0; y < height; y++ )
+    else if ( src->format == XPixelFormatGrayscale8 )
+    {
+        EqualizeHistogram( redHistogram->values, src->width * src->height, mapR );
+        ret = GrayscaleRemapping( src, mapR );
+    }
+    else if ( ( src->format == XPixelFormatRGB24 ) || ( src->format == XPixelFormatRGBA32 ) )
     {
-        for ( x = 0; x < width; x++ )
+        if ( ( greenHistogram == 0 ) || ( blueHistogram == 0 ) )
         {
-            histogramR[ptr[RedIndex]]++;
-            histogramG[ptr[GreenIndex]]++;
-            histogramB[ptr[BlueIndex]]++;
-
-            ptr += pixelSize;
+            ret = ErrorNullParameter;
         }
+        else
+        {
+            uint32_t pixelsCount = src->width * src->height;
 
-        ptr += offset;
-    }
-
-    EqualizeHistogram( histogramR, pixelsCount, mapR );
-    EqualizeHistogram( histogramG, pixelsCount, mapG );
-    EqualizeHistogram( histogramB, pixelsCount, mapB );
+            EqualizeHistogram( redHistogram->values,   pixelsCount, mapR );
+            EqualizeHistogram( greenHistogram->values, pixelsCount, mapG );
+            EqualizeHistogram( blueHistogram->values,  pixelsCount, mapB );
 
-    ColorRemapping( src, mapR, mapG, mapB );
+            ret = ColorRemapping( src, mapR, mapG, mapB );
+        }
+    }
+    else
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
 
-    free( histogramR );
-    free( histogramG );
-    free( histogramB );
-    free( mapR );
-    free( mapG );
-    free( mapB );
+    return ret;
 }
@@ -19,9 +19,21 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <stdlib.h>
 #include <string.h>
 #include "ximaging.h"
 
+// Images are split into horizontal bands, which get their own partial histograms calculated in parallel
+#define MIN_BAND_HEIGHT (32)
+#define MAX_BANDS_COUNT (32)
+
+// forward declaration ----
+static void CalculateGrayscaleBandHistogram( const uint8_t* ptr, int width, int height, int stride, uint32_t* values );
+static void CalculateColorBandHistograms( const uint8_t* ptr, int width, int height, int stride, int pixelSize,
+                                          uint32_t* redValues, uint32_t* greenValues, uint32_t* blueValues );
+static XErrorCode CalculateHistograms( const ximage* image, uint32_t** values, int channels );
+// ------------------------
+
 // Calculate RGB histogram for 24/32 bpp color image
 XErrorCode GetColorImageHistograms( const ximage* image, xhistogram* redHistogram, xhistogram* greenHistogram, xhistogram* blueHistogram )
 {
@@ -43,37 +55,13 @@ XErrorCode GetColorImageHistograms( const ximage* image, xhistogram* redHistogra
     }
     else
     {
-        int width     = image->width;
-        int height    = image->height;
-        int stride    = image->stride;
-        int pixelSize = ( image->format == XPixelFormatRGB24 ) ? 3 : 4;
-        int x, y;
-
-        uint8_t* ptr = image->data;
-        uint8_t* rowPtr;
-
-        uint32_t* redHistogramValues   = redHistogram->values;
-        uint32_t* greenHistogramValues = greenHistogram->values;
-        uint32_t* blueHistogramValues  = blueHistogram->values;
-
-        memset( redHistogramValues,   0, sizeof( uint32_t ) * 256 );
-        memset( greenHistogramValues, 0, sizeof( uint32_t ) * 256 );
-        memset( blueHistogramValues,  0, sizeof( uint32_t ) * 256 );
-
-        for ( y = 0; y < height; y++ )
-        {
-            rowPtr = ptr + stride * y;
-
-            for ( x = 0; x < width; x++ )
-            {
-                redHistogramValues  [rowPtr[RedIndex  ]]++;
-                greenHistogramValues[rowPtr[GreenIndex]]++;
-                blueHistogramValues [rowPtr[BlueIndex ]]++;
+        uint32_t* values[3] = { redHistogram->values, greenHistogram->values, blueHistogram->values };
 
-                rowPtr += pixelSize;
-            }
-        }
+        ret = CalculateHistograms( image, values, 3 );
+    }
 
+    if ( ret == SuccessCode )
+    {
         XHistogramUpdate( redHistogram );
         XHistogramUpdate( greenHistogram );
         XHistogramUpdate( blueHistogram );
@@ -101,31 +89,195 @@ XErrorCode GetGrayscaleImageHistogram( const ximage* image, xhistogram* histogra
     }
     else
     {
-        int width  = image->width;
-        int height = image->height;
-        int stride = image->stride;
-        int x, y;
+        ret = CalculateHistograms( image, &histogram->values, 1 );
+    }
+
+    if ( ret == SuccessCode )
+    {
+        XHistogramUpdate( histogram );
+    }
+
+    return ret;
+}
+
+// Calculate histograms of 8 bpp grayscale image (one histogram) or 24/32 bpp color image (red, green and blue histograms)
+XErrorCode GetImageHistograms( const ximage* image, xhistogram* histograms )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image == 0 ) || ( histograms == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( image->format == XPixelFormatGrayscale8 )
+    {
+        ret = GetGrayscaleImageHistogram( image, &histograms[0] );
+    }
+    else
+    {
+        ret = GetColorImageHistograms( image, &histograms[0], &histograms[1], &histograms[2] );
+    }
 
-        uint8_t* ptr    = image->data;
-        uint8_t* rowPtr;
+    return ret;
+}
 
-        uint32_t* histogramValues = histogram->values;
+// Calculate histograms of 8 bpp grayscale (1 channel) or 24/32 bpp color (3 channels) image
+static XErrorCode CalculateHistograms( const ximage* image, uint32_t** values, int channels )
+{
+    XErrorCode ret        = SuccessCode;
+    int        width      = image->width;
+    int        height     = image->height;
+    int        stride     = image->stride;
+    int        pixelSize  = ( image->format == XPixelFormatRGBA32 ) ? 4 : 3;
+    int        bandsCount = height / MIN_BAND_HEIGHT;
+    int        band, i, c;
+
+    if ( bandsCount > MAX_BANDS_COUNT )
+    {
+        bandsCount = MAX_BANDS_COUNT;
+    }
 
-        memset( histogramValues, 0, sizeof( uint32_t ) * 256 );
+    if ( bandsCount <= 1 )
+    {
+        if ( channels == 1 )
+        {
+            CalculateGrayscaleBandHistogram( image->data, width, height, stride, values[0] );
+        }
+        else
+        {
+            CalculateColorBandHistograms( image->data, width, height, stride, pixelSize, values[0], values[1], values[2] );
+        }
+    }
+    else
+    {
+        // partial histograms of all bands, which are summed at the end
+        uint32_t* bandValues = (uint32_t*) malloc( bandsCount * channels * 256 * sizeof( uint32_t ) );
 
-        for ( y = 0; y < height; y++ )
+        if ( bandValues == 0 )
+        {
+            ret = ErrorOutOfMemory;
+        }
+        else
         {
-            rowPtr = ptr + stride * y;
+            const uint8_t* data = image->data;
 
-            for ( x = 0; x < width; x++ )
+            #pragma omp parallel for schedule(static) shared( data, width, height, stride, pixelSize, bandsCount, bandValues, channels )
+            for ( band = 0; band < bandsCount; band++ )
             {
-                histogramValues[*rowPtr]++;
-                rowPtr += 1;
+                int       startY = (int) ( (int64_t) height * band / bandsCount );
+                int       endY   = (int) ( (int64_t) height * ( band + 1 ) / bandsCount );
+                uint32_t* partial = bandValues + band * channels * 256;
+
+                if ( channels == 1 )
+                {
+                    CalculateGrayscaleBandHistogram( data + startY * stride, width, endY - startY, stride, partial );
+                }
+                else
+                {
+                    CalculateColorBandHistograms( data + startY * stride, width, endY - startY, stride, pixelSize,
+                                                  partial, partial + 256, partial + 512 );
+                }
             }
-        }
 
-        XHistogramUpdate( histogram );
+            for ( c = 0; c < channels; c++ )
+            {
+                uint32_t* dst = values[c];
+
+                memcpy( dst, bandValues + c * 256, 256 * sizeof( uint32_t ) );
+
+                for ( band = 1; band < bandsCount; band++ )
+                {
+                    const uint32_t* src = bandValues + ( band * channels + c ) * 256;
+
+                    for ( i = 0; i < 256; i++ )
+                    {
+                        dst[i] += src[i];
+                    }
+                }
+            }
+
+            free( bandValues );
+        }
     }
 
     return ret;
 }
+
+// Calculate histogram of a band of 8 bpp grayscale image
+static void CalculateGrayscaleBandHistogram( const uint8_t* ptr, int width, int height, int stride, uint32_t* values )
+{
+    // 4 banks of counters are used for interleaved pixels, so runs of equal values (which are common)
+    // don't wait for previous increment of the same counter to complete
+    uint32_t       banks[4][256];
+    int            widthM3 = width - 3;
+    int            x, y, i;
+    const uint8_t* row;
+
+    memset( banks, 0, sizeof( banks ) );
+
+    for ( y = 0; y < height; y++ )
+    {
+        row = ptr + y * stride;
+
+        for ( x = 0; x < widthM3; x += 4 )
+        {
+            banks[0][row[x    ]]++;
+            banks[1][row[x + 1]]++;
+            banks[2][row[x + 2]]++;
+            banks[3][row[x + 3]]++;
+        }
+
+        for ( ; x < width; x++ )
+        {
+            banks[0][row[x]]++;
+        }
+    }
+
+    for ( i = 0; i < 256; i++ )
+    {
+        values[i] = banks[0][i] + banks[1][i] + banks[2][i] + banks[3][i];
+    }
+}
+
+// Calculate RGB histograms of a band of 24/32 bpp color image
+static void CalculateColorBandHistograms( const uint8_t* ptr, int width, int height, int stride, int pixelSize,
+                                          uint32_t* redValues, uint32_t* greenValues, uint32_t* blueValues )
+{
+    // 2 banks of counters per channel - for odd and even pixels
+    uint32_t       banks[2][3][256];
+    int            widthM1 = width - 1;
+    int            x, y, i;
+    const uint8_t* row;
+
+    memset( banks, 0, sizeof( banks ) );
+
+    for ( y = 0; y < height; y++ )
+    {
+        row = ptr + y * stride;
+
+        for ( x = 0; x < widthM1; x += 2, row += pixelSize * 2 )
+        {
+            banks[0][0][row[RedIndex  ]]++;
+            banks[0][1][row[GreenIndex]]++;
+            banks[0][2][row[BlueIndex ]]++;
+
+            banks[1][0][row[pixelSize + RedIndex  ]]++;
+            banks[1][1][row[pixelSize + GreenIndex]]++;
+            banks[1][2][row[pixelSize + BlueIndex ]]++;
+        }
+
+        if ( x < width )
+        {
+            banks[0][0][row[RedIndex  ]]++;
+            banks[0][1][row[GreenIndex]]++;
+            banks[0][2][row[BlueIndex ]]++;
+        }
+    }
+
+    for ( i = 0; i < 256; i++ )
+    {
+        redValues[i]   = banks[0][0][i] + banks[1][0][i];
+        greenValues[i] = banks[0][1][i] + banks[1][1][i];
+        blueValues[i]  = banks[0][2][i] + banks[1][2][i];
+    }
+}
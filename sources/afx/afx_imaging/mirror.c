@@ -19,20 +19,22 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include "ximaging.h"
+#include "xcpuid.h"
 
-// forward declaration ----
-static void MirrorImage8X( ximage* src );
-static void MirrorImage8Y( ximage* src );
-static void MirrorImage8XY( ximage* src );
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif
 
-static void MirrorImage24X( ximage* src );
-static void MirrorImage24Y( ximage* src );
-static void MirrorImage24XY( ximage* src );
+// Size of the buffer used to swap rows
+#define SWAP_BUFFER_SIZE (1024)
 
-static void MirrorImage32X( ximage* src );
-static void MirrorImage32Y( ximage* src );
-static void MirrorImage32XY( ximage* src );
+// forward declaration ----
+static void SwapRows( uint8_t* row1, uint8_t* row2, int length );
+static void SwapMirroredPixels( uint8_t* row1, uint8_t* row2, int width, int pixelSize, int simdLevel );
 // ------------------------
 
 // Mirror the specified image over X and/or Y axis
@@ -44,417 +46,206 @@ XErrorCode MirrorImage( ximage* src, bool xMirror, bool yMirror )
     {
         ret = ErrorNullParameter;
     }
-    else
+    else if ( ( src->format != XPixelFormatGrayscale8 ) &&
+              ( src->format != XPixelFormatGrayscale16 ) &&
+              ( src->format != XPixelFormatRGB24 ) &&
+              ( src->format != XPixelFormatRGBA32 ) &&
+              ( src->format != XPixelFormatRGB48 ) &&
+              ( src->format != XPixelFormatRGBA64 ) )
     {
-        switch ( src->format )
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( xMirror ) || ( yMirror ) )
+    {
+        int width      = src->width;
+        int height     = src->height;
+        int heightM1   = height - 1;
+        int halfHeight = height / 2;
+        int stride     = src->stride;
+        int pixelSize  = (int) XImageBitsPerPixel( src->format ) / 8;
+        int simdLevel  = ( IsSSSE3( ) ) ? 2 : ( IsSSE2( ) ) ? 1 : 0;
+        int y;
+
+        uint8_t* ptr = src->data;
+
+        if ( !yMirror )
         {
-        case XPixelFormatGrayscale8:
-            if ( ( xMirror & yMirror ) != false )
-            {
-                MirrorImage8XY( src );
-            }
-            else if ( xMirror != false )
+            // mirror around X axis - swap rows
+            #pragma omp parallel for schedule(static) shared( ptr, width, heightM1, stride, pixelSize )
+            for ( y = 0; y < halfHeight; y++ )
             {
-                MirrorImage8X( src );
+                SwapRows( ptr + y * stride, ptr + ( heightM1 - y ) * stride, width * pixelSize );
             }
-            else if ( yMirror != false )
+        }
+        else if ( !xMirror )
+        {
+            // mirror around Y axis - reverse every row
+            #pragma omp parallel for schedule(static) shared( ptr, width, stride, pixelSize, simdLevel )
+            for ( y = 0; y < height; y++ )
             {
-                MirrorImage8Y( src );
-            }
+                uint8_t* row = ptr + y * stride;
 
-            break;
-
-        case XPixelFormatRGB24:
-            if ( ( xMirror & yMirror ) != false )
-            {
-                MirrorImage24XY( src );
+                SwapMirroredPixels( row, row, width, pixelSize, simdLevel );
             }
-            else if ( xMirror != false )
-            {
-                MirrorImage24X( src );
-            }
-            else if ( yMirror != false )
+        }
+        else
+        {
+            // mirror around both axes - swap rows reversing them
+            #pragma omp parallel for schedule(static) shared( ptr, width, heightM1, stride, pixelSize, simdLevel )
+            for ( y = 0; y < halfHeight; y++ )
             {
-                MirrorImage24Y( src );
+                SwapMirroredPixels( ptr + y * stride, ptr + ( heightM1 - y ) * stride, width, pixelSize, simdLevel );
             }
-            break;
 
-        case XPixelFormatRGBA32:
-            if ( ( xMirror & yMirror ) != false )
-            {
-                MirrorImage32XY( src );
-            }
-            else if ( xMirror != false )
-            {
-                MirrorImage32X( src );
-            }
-            else if ( yMirror != false )
+            if ( ( height & 1 ) != 0 )
             {
-                MirrorImage32Y( src );
-            }
-            break;
+                uint8_t* row = ptr + halfHeight * stride;
 
-        default:
-            ret = ErrorUnsupportedPixelFormat;
+                SwapMirroredPixels( row, row, width, pixelSize, simdLevel );
+            }
         }
     }
 
     return ret;
 }
 
-// Mirror 8bpp grayscale image around Y axis
-void MirrorImage8Y( ximage* src )
-{
-    int width     = src->width;
-    int height    = src->height;
-    int widthM1   = width - 1;
-    int halfWidth = width / 2;
-    int stride    = src->stride;
-    int x, y;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
-    uint8_t  temp;
-
-    for ( y = 0; y < height; y++ )
-    {
-        rowStart = ptr + y * stride;
-        rowEnd   = rowStart + widthM1;
-
-        for ( x = 0; x < halfWidth; x++, rowStart++, rowEnd-- )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-        }
-    }
-}
-
-// Mirror 8bpp grayscale image around X axis
-void MirrorImage8X( ximage* src )
+// Swap content of two rows
+static void SwapRows( uint8_t* row1, uint8_t* row2, int length )
 {
-    int width      = src->width;
-    int height     = src->height;
-    int heightM1   = height - 1;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
-    uint8_t  temp;
+    uint8_t buffer[SWAP_BUFFER_SIZE];
+    int     offset, count;
 
-    for ( y = 0; y < halfHeight; y++ )
+    for ( offset = 0; offset < length; offset += SWAP_BUFFER_SIZE )
     {
-        rowStart = ptr + y * stride;
-        rowEnd   = ptr + ( heightM1 - y ) * stride;
+        count = XMIN( SWAP_BUFFER_SIZE, length - offset );
 
-        for ( x = 0; x < width; x++, rowStart++, rowEnd++ )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-        }
+        memcpy( buffer, row1 + offset, count );
+        memcpy( row1 + offset, row2 + offset, count );
+        memcpy( row2 + offset, buffer, count );
     }
 }
 
-// Mirror 8bpp grayscale image around X and Y axes
-void MirrorImage8XY( ximage* src )
+// Reverse order of pixels in 16 byte register
+static __m128i ReversePixels( __m128i pixels, int pixelSize )
 {
-    int width      = src->width;
-    int height     = src->height;
-    int widthM1    = width - 1;
-    int heightM1   = height - 1;
-    int halfWidth  = width / 2;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
-    uint8_t  temp;
+    __m128i ret;
 
-    for ( y = 0; y < halfHeight; y++ )
+    switch ( pixelSize )
     {
-        rowStart = ptr + y * stride;
-        rowEnd   = ptr + ( heightM1 - y ) * stride + widthM1;
-
-        for ( x = 0; x < width; x++, rowStart++, rowEnd-- )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-        }
-    }
-
-    if ( ( height & 1 ) != 0 )
-    {
-        rowStart = ptr + halfHeight * stride;
-        rowEnd   = rowStart + widthM1;
-
-        for ( x = 0; x < halfWidth; x++, rowStart++, rowEnd-- )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-        }
+    case 1:
+        ret = _mm_shuffle_epi8( pixels, _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+        break;
+
+    case 2:
+        ret = _mm_shuffle_epi32( pixels, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+        ret = _mm_shufflelo_epi16( ret, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+        ret = _mm_shufflehi_epi16( ret, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+        break;
+
+    case 4:
+        ret = _mm_shuffle_epi32( pixels, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+        break;
+
+    default:
+        ret = _mm_shuffle_epi32( pixels, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+        break;
     }
-}
-
-// Mirror 24bpp color image around Y axis
-void MirrorImage24Y( ximage* src )
-{
-    int width     = src->width;
-    int height    = src->height;
-    int widthM1   = width - 1;
-    int halfWidth = width / 2;
-    int stride    = src->stride;
-    int x, y;
-
-    int widthM1x3 = widthM1 * 3;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
 
-    uint8_t  temp;
-
-    for ( y = 0; y < height; y++ )
-    {
-        rowStart = ptr + y * stride;
-        rowEnd   = rowStart + widthM1x3;
-
-        for ( x = 0; x < halfWidth; x++, rowStart += 3, rowEnd -= 3 )
-        {
-            temp        = *rowStart;
-            *rowStart   = *rowEnd;
-            *rowEnd     = temp;
-
-            temp        = rowStart[1];
-            rowStart[1] = rowEnd[1];
-            rowEnd[1]   = temp;
-
-            temp        = rowStart[2];
-            rowStart[2] = rowEnd[2];
-            rowEnd[2]   = temp;
-        }
-    }
+    return ret;
 }
 
-// Mirror 24bpp color image around X axis
-void MirrorImage24X( ximage* src )
+/*
+ * Swap pixel x of the first row with pixel (width - 1 - x) of the second row. If both rows
+ * are the same, then only half of the pixels get swapped, which reverses the row.
+ * simdLevel: 0 - no SIMD, 1 - SSE2 (16/32/64 bpp images), 2 - SSSE3 (also 8/24 bpp images)
+ */
+static void SwapMirroredPixels( uint8_t* row1, uint8_t* row2, int width, int pixelSize, int simdLevel )
 {
-    int width      = src->width;
-    int height     = src->height;
-    int heightM1   = height - 1;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
+    int      count = ( row1 == row2 ) ? width / 2 : width;
+    uint8_t* ptr1  = row1;
+    uint8_t* ptr2  = row2 + ( width - 1 ) * pixelSize;
+    int      x     = 0;
+    int      i;
     uint8_t  temp;
 
-    for ( y = 0; y < halfHeight; y++ )
+    if ( ( ( pixelSize == 1 ) && ( simdLevel >= 2 ) ) ||
+         ( ( ( pixelSize == 2 ) || ( pixelSize == 4 ) || ( pixelSize == 8 ) ) && ( simdLevel >= 1 ) ) )
     {
-        rowStart = ptr + y * stride;
-        rowEnd   = ptr + ( heightM1 - y ) * stride;
+        int      blockPixels = 16 / pixelSize;
+        uint8_t* blockEnd2   = ptr2 + pixelSize;
+        __m128i  block1, block2;
 
-        for ( x = 0; x < width; x++  )
+        // swap 16 byte blocks while they don't overlap
+        for ( ; x + blockPixels <= count; x += blockPixels )
         {
-            // red
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-
-            rowStart++;
-            rowEnd++;
-
-            // green
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
+            blockEnd2 -= 16;
 
-            rowStart++;
-            rowEnd++;
+            block1 = _mm_loadu_si128( (const __m128i*) ptr1 );
+            block2 = _mm_loadu_si128( (const __m128i*) blockEnd2 );
 
-            // blue
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
+            _mm_storeu_si128( (__m128i*) ptr1,      ReversePixels( block2, pixelSize ) );
+            _mm_storeu_si128( (__m128i*) blockEnd2, ReversePixels( block1, pixelSize ) );
 
-            rowStart++;
-            rowEnd++;
+            ptr1 += 16;
         }
-    }
-}
-
-// Mirror 24bpp color image around X and Y axes
-void MirrorImage24XY( ximage* src )
-{
-    int width      = src->width;
-    int height     = src->height;
-    int widthM1    = width - 1;
-    int heightM1   = height - 1;
-    int halfWidth  = width / 2;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    uint8_t* ptr = src->data;
-    uint8_t* rowStart;
-    uint8_t* rowEnd;
-    uint8_t  temp;
-
-    for ( y = 0; y < halfHeight; y++ )
-    {
-        rowStart = ptr + y * stride;
-        rowEnd   = ptr + ( heightM1 - y ) * stride + widthM1 * 3;
-
-        for ( x = 0; x < width; x++, rowStart += 3, rowEnd -= 3 )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
 
-            temp        = rowStart[1];
-            rowStart[1] = rowEnd[1];
-            rowEnd[1]   = temp;
-
-            temp        = rowStart[2];
-            rowStart[2] = rowEnd[2];
-            rowEnd[2]   = temp;
-        }
+        ptr2 = blockEnd2 - pixelSize;
     }
-
-    if ( ( height & 1 ) != 0 )
+    else if ( ( pixelSize == 3 ) && ( simdLevel >= 2 ) )
     {
-        rowStart = ptr + halfHeight * stride;
-        rowEnd   = rowStart + widthM1 * 3;
-
-        for ( x = 0; x < halfWidth; x++, rowStart += 3, rowEnd -= 3 )
+        // 10 pixels (30 bytes) are swapped at a time using two overlapping blocks - [0, 16) and [14, 30);
+        // first block keeps pixels 0-4 in bytes 0-14, while the second keeps pixels 5-9 in bytes 1-15
+        __m128i  reverseSecond   = _mm_set_epi8( -1, 3, 2, 1, 6, 5, 4, 9, 8, 7, 12, 11, 10, 15, 14, 13 );
+        __m128i  reverseFirst    = _mm_set_epi8( 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, -1 );
+        __m128i  lastFromFirst   = _mm_set_epi8( 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 );
+        __m128i  firstFromSecond = _mm_set_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3 );
+        uint8_t* blockStart2     = ptr2 + 3;
+        __m128i  first1, second1, first2, second2;
+
+        for ( ; x + 10 <= count; x += 10 )
         {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-
-            temp        = rowStart[1];
-            rowStart[1] = rowEnd[1];
-            rowEnd[1]   = temp;
+            blockStart2 -= 30;
 
-            temp        = rowStart[2];
-            rowStart[2] = rowEnd[2];
-            rowEnd[2]   = temp;
-        }
-    }
-}
-
-// Mirror 32bpp color image around Y axis
-void MirrorImage32Y( ximage* src )
-{
-    int width     = src->width;
-    int height    = src->height;
-    int widthM1   = width - 1;
-    int halfWidth = width / 2;
-    int stride    = src->stride;
-    int x, y;
+            first1  = _mm_loadu_si128( (const __m128i*) ptr1 );
+            second1 = _mm_loadu_si128( (const __m128i*) ( ptr1 + 14 ) );
+            first2  = _mm_loadu_si128( (const __m128i*) blockStart2 );
+            second2 = _mm_loadu_si128( (const __m128i*) ( blockStart2 + 14 ) );
 
-    int widthM1x4 = widthM1 * 4;
+            _mm_storeu_si128( (__m128i*) ptr1,
+                _mm_or_si128( _mm_shuffle_epi8( second2, reverseSecond ), _mm_shuffle_epi8( first2, lastFromFirst ) ) );
+            _mm_storeu_si128( (__m128i*) ( ptr1 + 14 ),
+                _mm_or_si128( _mm_shuffle_epi8( first2, reverseFirst ), _mm_shuffle_epi8( second2, firstFromSecond ) ) );
 
-    uint8_t*  ptr = src->data;
-    uint32_t* rowStart;
-    uint32_t* rowEnd;
-    uint32_t  temp;
+            _mm_storeu_si128( (__m128i*) blockStart2,
+                _mm_or_si128( _mm_shuffle_epi8( second1, reverseSecond ), _mm_shuffle_epi8( first1, lastFromFirst ) ) );
+            _mm_storeu_si128( (__m128i*) ( blockStart2 + 14 ),
+                _mm_or_si128( _mm_shuffle_epi8( first1, reverseFirst ), _mm_shuffle_epi8( second1, firstFromSecond ) ) );
 
-    for ( y = 0; y < height; y++ )
-    {
-        rowStart = (uint32_t*) ( ptr + y * stride );
-        rowEnd   = (uint32_t*) ( ptr + y * stride + widthM1x4 );
-
-        for ( x = 0; x < halfWidth; x++, rowStart++, rowEnd-- )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
+            ptr1 += 30;
         }
-    }
-}
 
-// Mirror 32bpp color image around X axis
-void MirrorImage32X( ximage* src )
-{
-    int width      = src->width;
-    int height     = src->height;
-    int heightM1   = height - 1;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    uint8_t*  ptr = src->data;
-    uint32_t* rowStart;
-    uint32_t* rowEnd;
-    uint32_t  temp;
-
-    for ( y = 0; y < halfHeight; y++ )
-    {
-        rowStart = (uint32_t*) ( ptr + y * stride );
-        rowEnd   = (uint32_t*) ( ptr + ( heightM1 - y ) * stride );
-
-        for ( x = 0; x < width; x++, rowStart++, rowEnd++ )
-        {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
-        }
+        ptr2 = blockStart2 - 3;
     }
-}
 
-// Mirror 32bpp color image around X and Y axes
-void MirrorImage32XY( ximage* src )
-{
-    int width      = src->width;
-    int height     = src->height;
-    int widthM1    = width - 1;
-    int heightM1   = height - 1;
-    int halfWidth  = width / 2;
-    int halfHeight = height / 2;
-    int stride     = src->stride;
-    int x, y;
-
-    int widthM1x4  = widthM1 * 4;
-
-    uint8_t*  ptr = src->data;
-    uint32_t* rowStart;
-    uint32_t* rowEnd;
-    uint32_t  temp;
-
-    for ( y = 0; y < halfHeight; y++ )
+    if ( pixelSize == 3 )
     {
-        rowStart = (uint32_t*) ( ptr + y * stride );
-        rowEnd   = (uint32_t*) ( ptr + ( heightM1 - y ) * stride + widthM1x4 );
-
-        for ( x = 0; x < width; x++, rowStart++, rowEnd-- )
+        for ( ; x < count; x++, ptr1 += 3, ptr2 -= 3 )
         {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
+            temp = ptr1[0]; ptr1[0] = ptr2[0]; ptr2[0] = temp;
+            temp = ptr1[1]; ptr1[1] = ptr2[1]; ptr2[1] = temp;
+            temp = ptr1[2]; ptr1[2] = ptr2[2]; ptr2[2] = temp;
         }
     }
-
-    if ( ( height & 1 ) != 0 )
+    else
     {
-        rowStart = (uint32_t*) ( ptr + halfHeight * stride );
-        rowEnd   = (uint32_t*) ( ptr + halfHeight * stride + widthM1x4 );
-
-        for ( x = 0; x < halfWidth; x++, rowStart++, rowEnd-- )
+        for ( ; x < count; x++, ptr1 += pixelSize, ptr2 -= pixelSize )
         {
-            temp      = *rowStart;
-            *rowStart = *rowEnd;
-            *rowEnd   = temp;
+            for ( i = 0; i < pixelSize; i++ )
+            {
+                temp    = ptr1[i];
+                ptr1[i] = ptr2[i];
+                ptr2[i] = temp;
+            }
         }
     }
 }
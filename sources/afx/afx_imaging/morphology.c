@@ -20,6 +20,7 @@
 */
 
 #include <memory.h>
+#include <stdlib.h>
 #include <math.h>
 #include "ximaging.h"
 
@@ -28,6 +29,7 @@ static void Erosion8bpp( const ximage* src, ximage* dst, int8_t* se, uint32_t se
 static void Erosion24bpp( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize );
 static void Dilatation8bpp( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize );
 static void Dilatation24bpp( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize );
+static XErrorCode FastMinMaxFilter( const ximage* src, ximage* dst, const int8_t* se, uint32_t seSize, bool isMax );
 // ------------------------
 
 // Applies erosion morphological operator to the specified image.
@@ -60,8 +62,9 @@ XErrorCode Erosion( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize
         // don't allow even kernels or too small/big kernels
         ret = ErrorArgumentOutOfRange;
     }
-    else
+    else if ( FastMinMaxFilter( src, dst, se, seSize, false ) != SuccessCode )
     {
+        // structuring element can not be decomposed - check every element of it for every pixel
         if ( src->format == XPixelFormatGrayscale8 )
         {
             Erosion8bpp( src, dst, se, seSize );
@@ -105,8 +108,9 @@ XErrorCode Dilatation( const ximage* src, ximage* dst, int8_t* se, uint32_t seSi
         // don't allow even kernels or too small/big kernels
         ret = ErrorArgumentOutOfRange;
     }
-    else
+    else if ( FastMinMaxFilter( src, dst, se, seSize, true ) != SuccessCode )
     {
+        // structuring element can not be decomposed - check every element of it for every pixel
         if ( src->format == XPixelFormatGrayscale8 )
         {
             Dilatation8bpp( src, dst, se, seSize );
@@ -140,6 +144,10 @@ XErrorCode HitAndMiss( const ximage* src, ximage* dst, int8_t* se, uint32_t seSi
     {
         ret = ErrorImageParametersMismatch;
     }
+    else if ( src->format == XPixelFormatBinary1 )
+    {
+        ret = BinaryImageHitAndMiss( src, dst, se, seSize, mode );
+    }
     else if ( src->format != XPixelFormatGrayscale8 )
     {
         ret = ErrorUnsupportedPixelFormat;
@@ -196,8 +204,8 @@ XErrorCode HitAndMiss( const ximage* src, ximage* dst, int8_t* se, uint32_t seSi
                         }
 
                         // check, if we are outside
-                        if ( ( y + i < 0 ) || ( y + i >= width  ) ||
-                             ( x + j < 0 ) || ( x + j >= height ) )
+                        if ( ( y + i < 0 ) || ( y + i >= height ) ||
+                             ( x + j < 0 ) || ( x + j >= width  ) )
                         {
                             // if it so, the result is zero, because it was required pixel
                             dstValue = 0;
@@ -1053,3 +1061,407 @@ void Dilatation24bpp( const ximage* src, ximage* dst, int8_t* se, uint32_t seSiz
         }
     }
 }
+
+// ===== Fast erosion/dilatation for structuring elements, which can be decomposed =====
+//
+// Rectangular structuring elements (which includes squares and lines) are separable - processing is done with
+// horizontal line first and then with vertical line. Both are done with van Herk/Gil-Werman algorithm, which
+// requires about 3 comparisons per pixel regardless of line length. Diamond structuring element of radius R is
+// decomposed into R successive passes with 3x3 cross.
+//
+// Pixels outside of image are treated as neutral values (255 for erosion and 0 for dilatation), which gives same
+// result as the direct implementation ignoring them, since all the supported structuring elements cover their centre.
+
+// Check if the structuring element is a solid rectangle covering its centre; provides its extent from the centre
+static bool IsRectangularStructuringElement( const int8_t* se, int seSize, int* left, int* right, int* top, int* bottom )
+{
+    int  radius = seSize >> 1;
+    int  minX = seSize, maxX = -1, minY = seSize, maxY = -1;
+    int  x, y;
+    bool ret = true;
+
+    // find bounding rectangle of structuring element's items
+    for ( y = 0; y < seSize; y++ )
+    {
+        for ( x = 0; x < seSize; x++ )
+        {
+            if ( se[y * seSize + x] == 1 )
+            {
+                minX = XMIN( minX, x );
+                maxX = XMAX( maxX, x );
+                minY = XMIN( minY, y );
+                maxY = XMAX( maxY, y );
+            }
+        }
+    }
+
+    if ( ( minX > radius ) || ( maxX < radius ) || ( minY > radius ) || ( maxY < radius ) )
+    {
+        ret = false;
+    }
+    else
+    {
+        // make sure the bounding rectangle is filled
+        for ( y = minY; ( y <= maxY ) && ( ret ); y++ )
+        {
+            for ( x = minX; x <= maxX; x++ )
+            {
+                if ( se[y * seSize + x] != 1 )
+                {
+                    ret = false;
+                    break;
+                }
+            }
+        }
+
+        *left   = radius - minX;
+        *right  = maxX - radius;
+        *top    = radius - minY;
+        *bottom = maxY - radius;
+    }
+
+    return ret;
+}
+
+// Check if the structuring element is a diamond of radius 2 or more; provides the radius
+static bool IsDiamondStructuringElement( const int8_t* se, int seSize, int* diamondRadius )
+{
+    int  radius = seSize >> 1;
+    int  extent = 0;
+    int  x, y;
+    bool ret = true;
+
+    // diamond's radius is the extent of the middle row
+    while ( ( extent < radius ) && ( se[radius * seSize + radius + extent + 1] == 1 ) )
+    {
+        extent++;
+    }
+
+    for ( y = 0; ( y < seSize ) && ( ret ); y++ )
+    {
+        for ( x = 0; x < seSize; x++ )
+        {
+            int8_t expected = ( abs( x - radius ) + abs( y - radius ) <= extent ) ? 1 : 0;
+
+            // anything, which is not 1, is ignored by morphology operators
+            if ( ( se[y * seSize + x] == 1 ) != ( expected == 1 ) )
+            {
+                ret = false;
+                break;
+            }
+        }
+    }
+
+    *diamondRadius = extent;
+
+    return ( ( ret ) && ( extent >= 2 ) );
+}
+
+// Perform min/max filtering of rows with a line of (left + right + 1) length using van Herk/Gil-Werman algorithm.
+// Scratch buffer must have space for 2 * ( width + left + right ) pixels per each row of the image.
+static void RowsMinMaxFilter( const ximage* src, ximage* dst, uint8_t* scratch, int left, int right, bool isMax )
+{
+    int      width       = src->width;
+    int      height      = src->height;
+    int      srcStride   = src->stride;
+    int      dstStride   = dst->stride;
+    int      pixelSize   = ( src->format == XPixelFormatGrayscale8 ) ? 1 : ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+    int      lineLength  = left + right + 1;
+    int      paddedWidth = width + lineLength - 1;
+    uint8_t  neutral     = ( isMax ) ? 0 : 255;
+    uint8_t* srcPtr      = src->data;
+    uint8_t* dstPtr      = dst->data;
+    int      y;
+
+    #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, scratch, width, srcStride, dstStride, pixelSize, lineLength, paddedWidth, neutral, left, isMax )
+    for ( y = 0; y < height; y++ )
+    {
+        const uint8_t* srcRow = srcPtr + y * srcStride;
+        uint8_t*       dstRow = dstPtr + y * dstStride;
+        // g - min/max from start of a block to the current pixel; h - min/max from current pixel to end of the block
+        uint8_t*       g      = scratch + (size_t) y * paddedWidth * pixelSize * 2;
+        uint8_t*       h      = g + paddedWidth * pixelSize;
+        int            t, c, x;
+
+        // padded row with values starting from (-left) pixel of the source row
+        for ( t = 0; t < left * pixelSize; t++ )
+        {
+            h[t] = neutral;
+        }
+        memcpy( h + left * pixelSize, srcRow, width * pixelSize );
+        for ( t = ( left + width ) * pixelSize; t < paddedWidth * pixelSize; t++ )
+        {
+            h[t] = neutral;
+        }
+
+        // forward pass
+        for ( t = 0; t < paddedWidth; t++ )
+        {
+            uint8_t* gp = g + t * pixelSize;
+            uint8_t* hp = h + t * pixelSize;
+
+            if ( t % lineLength == 0 )
+            {
+                for ( c = 0; c < pixelSize; c++ )
+                {
+                    gp[c] = hp[c];
+                }
+            }
+            else
+            {
+                for ( c = 0; c < pixelSize; c++ )
+                {
+                    gp[c] = ( isMax ) ? XMAX( gp[c - pixelSize], hp[c] ) : XMIN( gp[c - pixelSize], hp[c] );
+                }
+            }
+        }
+
+        // backward pass (done in place, since each item depends on its own value and the next one only)
+        for ( t = paddedWidth - 2; t >= 0; t-- )
+        {
+            if ( ( t + 1 ) % lineLength != 0 )
+            {
+                uint8_t* hp = h + t * pixelSize;
+
+                for ( c = 0; c < pixelSize; c++ )
+                {
+                    hp[c] = ( isMax ) ? XMAX( hp[c], hp[c + pixelSize] ) : XMIN( hp[c], hp[c + pixelSize] );
+                }
+            }
+        }
+
+        // result is made of the two partial results
+        for ( x = 0; x < width * pixelSize; x++ )
+        {
+            uint8_t hv = h[x];
+            uint8_t gv = g[x + ( lineLength - 1 ) * pixelSize];
+
+            dstRow[x] = ( isMax ) ? XMAX( hv, gv ) : XMIN( hv, gv );
+        }
+    }
+}
+
+// Perform min/max filtering of columns with a line of (top + bottom + 1) length using van Herk/Gil-Werman algorithm.
+// Rows are processed as a whole, so it goes through memory sequentially. The image is processed in place.
+// Scratch buffer must have space for 2 * ( height + top + bottom ) rows of the image.
+static void ColumnsMinMaxFilter( ximage* image, uint8_t* scratch, int top, int bottom, bool isMax )
+{
+    int      width        = image->width;
+    int      height       = image->height;
+    int      stride       = image->stride;
+    int      pixelSize    = ( image->format == XPixelFormatGrayscale8 ) ? 1 : ( image->format == XPixelFormatRGB24 ) ? 3 : 4;
+    int      lineSize     = width * pixelSize;
+    int      lineLength   = top + bottom + 1;
+    int      paddedHeight = height + lineLength - 1;
+    int      blocksCount  = ( paddedHeight + lineLength - 1 ) / lineLength;
+    uint8_t  neutral      = ( isMax ) ? 0 : 255;
+    uint8_t* ptr          = image->data;
+    uint8_t* gData        = scratch;
+    uint8_t* hData        = scratch + (size_t) paddedHeight * lineSize;
+    int      block, y;
+
+    // each block of rows is independent in both passes
+    #pragma omp parallel for schedule(static) shared( ptr, gData, hData, height, stride, lineSize, lineLength, paddedHeight, neutral, top, isMax )
+    for ( block = 0; block < blocksCount; block++ )
+    {
+        int blockStart = block * lineLength;
+        int blockEnd   = XMIN( blockStart + lineLength, paddedHeight );
+        int t, x;
+
+        // padded column values starting from (-top) row of the source image
+        for ( t = blockStart; t < blockEnd; t++ )
+        {
+            int sy = t - top;
+
+            if ( ( sy < 0 ) || ( sy >= height ) )
+            {
+                memset( hData + (size_t) t * lineSize, neutral, lineSize );
+            }
+            else
+            {
+                memcpy( hData + (size_t) t * lineSize, ptr + sy * stride, lineSize );
+            }
+        }
+
+        // forward pass
+        memcpy( gData + (size_t) blockStart * lineSize, hData + (size_t) blockStart * lineSize, lineSize );
+
+        for ( t = blockStart + 1; t < blockEnd; t++ )
+        {
+            const uint8_t* gPrev = gData + (size_t) ( t - 1 ) * lineSize;
+            const uint8_t* hRow  = hData + (size_t) t * lineSize;
+            uint8_t*       gRow  = gData + (size_t) t * lineSize;
+
+            for ( x = 0; x < lineSize; x++ )
+            {
+                gRow[x] = ( isMax ) ? XMAX( gPrev[x], hRow[x] ) : XMIN( gPrev[x], hRow[x] );
+            }
+        }
+
+        // backward pass
+        for ( t = blockEnd - 2; t >= blockStart; t-- )
+        {
+            const uint8_t* hNext = hData + (size_t) ( t + 1 ) * lineSize;
+            uint8_t*       hRow  = hData + (size_t) t * lineSize;
+
+            for ( x = 0; x < lineSize; x++ )
+            {
+                hRow[x] = ( isMax ) ? XMAX( hRow[x], hNext[x] ) : XMIN( hRow[x], hNext[x] );
+            }
+        }
+    }
+
+    // result is made of the two partial results
+    #pragma omp parallel for schedule(static) shared( ptr, gData, hData, height, stride, lineSize, lineLength, isMax )
+    for ( y = 0; y < height; y++ )
+    {
+        const uint8_t* hRow   = hData + (size_t) y * lineSize;
+        const uint8_t* gRow   = gData + (size_t) ( y + lineLength - 1 ) * lineSize;
+        uint8_t*       dstRow = ptr + y * stride;
+        int            x;
+
+        for ( x = 0; x < lineSize; x++ )
+        {
+            dstRow[x] = ( isMax ) ? XMAX( hRow[x], gRow[x] ) : XMIN( hRow[x], gRow[x] );
+        }
+    }
+}
+
+// Perform min/max filtering with 3x3 cross structuring element (pixels outside of image are ignored)
+static void CrossMinMaxFilter( const ximage* src, ximage* dst, bool isMax )
+{
+    int      width     = src->width;
+    int      height    = src->height;
+    int      srcStride = src->stride;
+    int      dstStride = dst->stride;
+    int      pixelSize = ( src->format == XPixelFormatGrayscale8 ) ? 1 : ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+    int      lineSize  = width * pixelSize;
+    uint8_t* srcPtr    = src->data;
+    uint8_t* dstPtr    = dst->data;
+    int      y;
+
+    #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, height, srcStride, dstStride, pixelSize, lineSize, isMax )
+    for ( y = 0; y < height; y++ )
+    {
+        const uint8_t* srcRow  = srcPtr + y * srcStride;
+        const uint8_t* srcRowA = ( y > 0 ) ? srcRow - srcStride : srcRow;
+        const uint8_t* srcRowB = ( y < height - 1 ) ? srcRow + srcStride : srcRow;
+        uint8_t*       dstRow  = dstPtr + y * dstStride;
+        int            x;
+
+        for ( x = 0; x < lineSize; x++ )
+        {
+            uint8_t v  = srcRow[x];
+            uint8_t vl = ( x >= pixelSize ) ? srcRow[x - pixelSize] : v;
+            uint8_t vr = ( x + pixelSize < lineSize ) ? srcRow[x + pixelSize] : v;
+
+            if ( isMax )
+            {
+                v = XMAX3( v, vl, vr );
+                v = XMAX3( v, srcRowA[x], srcRowB[x] );
+            }
+            else
+            {
+                v = XMIN3( v, vl, vr );
+                v = XMIN3( v, srcRowA[x], srcRowB[x] );
+            }
+
+            dstRow[x] = v;
+        }
+    }
+}
+
+// Restore alpha channel of the destination 32 bpp image from the source image
+static void RestoreAlphaChannel( const ximage* src, ximage* dst )
+{
+    if ( src->format == XPixelFormatRGBA32 )
+    {
+        int width  = src->width;
+        int height = src->height;
+        int x, y;
+
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* srcRow = src->data + y * src->stride + AlphaIndex;
+            uint8_t*       dstRow = dst->data + y * dst->stride + AlphaIndex;
+
+            for ( x = 0; x < width; x++, srcRow += 4, dstRow += 4 )
+            {
+                *dstRow = *srcRow;
+            }
+        }
+    }
+}
+
+// Do erosion (min) or dilatation (max) using decomposition of structuring element if it is possible.
+// Returns ErrorNotImplemented if structuring element is not supported, so caller has to use direct implementation.
+static XErrorCode FastMinMaxFilter( const ximage* src, ximage* dst, const int8_t* se, uint32_t seSize, bool isMax )
+{
+    XErrorCode ret = ErrorNotImplemented;
+    int        left, right, top, bottom, diamondRadius;
+
+    if ( IsRectangularStructuringElement( se, (int) seSize, &left, &right, &top, &bottom ) )
+    {
+        int      pixelSize   = ( src->format == XPixelFormatGrayscale8 ) ? 1 : ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+        size_t   rowsScratch = (size_t) src->height * ( src->width + left + right ) * pixelSize * 2;
+        size_t   colsScratch = (size_t) ( src->height + top + bottom ) * src->width * pixelSize * 2;
+        uint8_t* scratch     = (uint8_t*) XMAlloc( XMAX( rowsScratch, colsScratch ) );
+
+        if ( scratch == 0 )
+        {
+            ret = ErrorOutOfMemory;
+        }
+        else
+        {
+            // horizontal line goes from source to destination, and then vertical line is done in place
+            RowsMinMaxFilter( src, dst, scratch, left, right, isMax );
+
+            if ( top + bottom != 0 )
+            {
+                ColumnsMinMaxFilter( dst, scratch, top, bottom, isMax );
+            }
+
+            RestoreAlphaChannel( src, dst );
+
+            XFree( (void**) &scratch );
+            ret = SuccessCode;
+        }
+    }
+    else if ( IsDiamondStructuringElement( se, (int) seSize, &diamondRadius ) )
+    {
+        ximage* tempImage = 0;
+
+        ret = XImageAllocateRaw( src->width, src->height, src->format, &tempImage );
+
+        if ( ret == SuccessCode )
+        {
+            ximage* passSrc = dst;
+            ximage* passDst = tempImage;
+            int     i;
+
+            CrossMinMaxFilter( src, dst, isMax );
+
+            for ( i = 1; i < diamondRadius; i++ )
+            {
+                ximage* swap;
+
+                CrossMinMaxFilter( passSrc, passDst, isMax );
+
+                swap    = passSrc;
+                passSrc = passDst;
+                passDst = swap;
+            }
+
+            if ( passSrc != dst )
+            {
+                ret = XImageCopyData( passSrc, dst );
+            }
+
+            RestoreAlphaChannel( src, dst );
+        }
+
+        XImageFree( &tempImage );
+    }
+
+    return ret;
+}
@@ -20,61 +20,64 @@
 */
 
 #include "ximaging.h"
-#include <string.h>
 
 // N. Otsu, "A threshold selection method from gray-level histograms",
 // IEEE Trans. Systems, Man and Cybernetics 9(1), pp. 6266, 1979.
 
-static uint16_t CalculateOtsuThresholdFromHistogram( double* histogram, double meanValue );
+static uint16_t FindOtsuThreshold( double* histogram, double meanValue );
 
 // Calculate optimal threshold for grayscale image using Otsu algorithm
 XErrorCode CalculateOtsuThreshold( const ximage* src, uint16_t* threshold )
 {
-    XErrorCode ret = SuccessCode;
+    uint32_t   values[256];
+    xhistogram histogram = { values, 256 };
+    XErrorCode ret       = SuccessCode;
 
     if ( ( src == 0 ) || ( threshold == 0 ) )
     {
         ret = ErrorNullParameter;
     }
-    else if ( src->format != XPixelFormatGrayscale8 )
-    {
-        ret = ErrorUnsupportedPixelFormat;
-    }
     else
     {
-        int integerHistogram[256];
-        double histogram[256];
-        double imageMean = 0;
-
-        int width  = src->width;
-        int height = src->height;
-        int offset = src->stride - width;
-        int y, x, i;
+        ret = GetGrayscaleImageHistogram( src, &histogram );
 
-        int pixelCount = width * height;
+        if ( ret == SuccessCode )
+        {
+            ret = CalculateOtsuThresholdFromHistogram( &histogram, threshold );
+        }
+    }
 
-        uint8_t* ptr = src->data;
+    return ret;
+}
 
-        // initialize histogram to zeros
-        memset( (void*) integerHistogram, 0, sizeof( integerHistogram ) );
+// Calculate optimal threshold using Otsu algorithm from already calculated histogram of grayscale image
+XErrorCode CalculateOtsuThresholdFromHistogram( const xhistogram* grayHistogram, uint16_t* threshold )
+{
+    XErrorCode ret = SuccessCode;
 
-        // calculate histogram first
-        for ( y = 0; y < height; y++, ptr += offset )
-        {
-            for ( x = 0; x < width; x++, ptr++ )
-            {
-                integerHistogram[*ptr]++;
-            }
-        }
+    if ( ( grayHistogram == 0 ) || ( grayHistogram->values == 0 ) || ( threshold == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( grayHistogram->length != 256 )
+    {
+        ret = ErrorInvalidArgument;
+    }
+    else
+    {
+        double   histogram[256];
+        double   imageMean  = 0;
+        uint32_t pixelCount = grayHistogram->total;
+        int      i;
 
-        // convert histogram to doubles and calculate intensitys mean value
+        // convert histogram to doubles and calculate intensity's mean value
         for ( i = 0; i < 256; i++ )
         {
-            histogram[i] = (double) integerHistogram[i] / pixelCount;
+            histogram[i] = (double) grayHistogram->values[i] / pixelCount;
             imageMean += histogram[i] * i;
         }
 
-        *threshold = CalculateOtsuThresholdFromHistogram( histogram, imageMean );
+        *threshold = FindOtsuThreshold( histogram, imageMean );
     }
 
     return ret;
@@ -94,8 +97,35 @@ XErrorCode OtsuThresholding( ximage* image )
     return ret;
 }
 
-// Calculate value of the Otsu threshold based on image's histogram
-static uint16_t CalculateOtsuThresholdFromHistogram( double* histogram, double meanValue )
+// Apply Otsu thresholding to an image using its already calculated histogram
+XErrorCode OtsuThresholdingUsingHistogram( ximage* image, const xhistogram* grayHistogram )
+{
+    uint16_t   threshold = 0;
+    XErrorCode ret       = SuccessCode;
+
+    if ( image == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( image->format != XPixelFormatGrayscale8 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        ret = CalculateOtsuThresholdFromHistogram( grayHistogram, &threshold );
+
+        if ( ret == SuccessCode )
+        {
+            ret = ThresholdImage( image, threshold );
+        }
+    }
+
+    return ret;
+}
+
+// Calculate value of the Otsu threshold based on image's normalized histogram
+static uint16_t FindOtsuThreshold( double* histogram, double meanValue )
 {
     uint16_t calculatedThreshold = 0;
     double max = 0;
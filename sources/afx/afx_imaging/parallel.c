@@ -0,0 +1,47 @@
+/*
+    Imaging library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "ximaging.h"
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+// Set number of threads used by image processing routines called from the current thread (0 - one per CPU)
+void XImagingSetThreadsCount( uint32_t threadsCount )
+{
+#ifdef _OPENMP
+    // the setting is kept per thread, so it affects only parallel regions started by the calling one
+    omp_set_num_threads( ( threadsCount == 0 ) ? omp_get_num_procs( ) : (int) threadsCount );
+#else
+    XUNREFERENCED_PARAMETER( threadsCount )
+#endif
+}
+
+// Get number of threads used by image processing routines called from the current thread
+uint32_t XImagingGetThreadsCount( void )
+{
+#ifdef _OPENMP
+    return (uint32_t) omp_get_max_threads( );
+#else
+    return 1;
+#endif
+}
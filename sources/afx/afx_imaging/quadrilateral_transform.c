@@ -105,140 +105,6 @@ static int MapQuadToQuad( const xpoint* targetQuadrilateral, const xpoint* sourc
     return ret;
 }
 
-// Perform quadrilateral transformation using the specified matrix
-static void TransformQuadrilateral( const ximage* source, ximage* target, xmatrix3* transformMatrix, int tx1, int ty1, int tx2, int ty2, bool interpolate, bool fillSpaces )
-{
-    xmatrix3 transMatrix = *transformMatrix;
-
-    int dstStride = target->stride;
-    int srcWidth  = source->width;
-    int srcHeight = source->height;
-    int srcStride = source->stride;
-    int pixelSize = ( target->format == XPixelFormatGrayscale8 ) ? 1 : ( target->format == XPixelFormatRGB24 ) ? 3 : 4;
-    int y;
-
-    uint8_t* srcPtr = source->data;
-    uint8_t* dstPtr = target->data;
-
-    if ( interpolate == false )
-    {
-        #pragma omp parallel for schedule(static) shared( transMatrix, srcWidth, srcHeight, srcStride, tx1, tx2, ty1, ty2, dstStride, pixelSize, srcPtr, dstPtr )
-        for ( y = ty1; y <= ty2; y++ )
-        {
-            float factor;
-            int   x, i, srcX, srcY;
-
-            uint8_t* dstRow = dstPtr + y * dstStride + tx1 * pixelSize;
-            uint8_t* p;
-
-            for ( x = tx1; x <= tx2; x++ )
-            {
-                factor =           transMatrix.m31 * x + transMatrix.m32 * y + transMatrix.m33;
-                srcX   = (int) ( ( transMatrix.m11 * x + transMatrix.m12 * y + transMatrix.m13 ) / factor );
-                srcY   = (int) ( ( transMatrix.m21 * x + transMatrix.m22 * y + transMatrix.m23 ) / factor );
-
-                if ( ( srcX >= 0 ) && ( srcY >= 0 ) && ( srcX < srcWidth ) && ( srcY < srcHeight ) )
-                {
-                    // get pointer to the pixel in the source image
-                    p = srcPtr + srcY * srcStride + srcX * pixelSize;
-                    // copy pixel's values
-                    for ( i = 0; i < pixelSize; i++, dstRow++, p++ )
-                    {
-                        *dstRow = *p;
-                    }
-                }
-                else
-                {
-                    if ( fillSpaces == true )
-                    {
-                        for ( i = 0; i < pixelSize; i++, dstRow++ )
-                        {
-                            *dstRow = 0;
-                        }
-                    }
-                    else
-                    {
-                        dstRow += pixelSize;
-                    }
-                }
-            }
-        }
-    }
-    else
-    {
-        int srcWidthM1  = source->width - 1;
-        int srcHeightM1 = source->height - 1;
-
-        #pragma omp parallel for schedule(static) shared( transMatrix, srcWidth, srcHeight, srcWidthM1, srcHeightM1, srcStride, tx1, tx2, ty1, ty2, dstStride, pixelSize, srcPtr, dstPtr )
-        for( y = ty1; y <= ty2; y++ )
-        {
-            float factor, srcX, srcY;
-            float dx1, dy1, dx2, dy2;
-            int   sx1, sy1, sx2, sy2;
-            int   x, i;
-
-            uint8_t* dstRow = dstPtr + y * dstStride + tx1 * pixelSize;
-            uint8_t  *p1, *p2, *p3, *p4;
-
-            for ( x = tx1; x <= tx2; x++ )
-            {
-                factor =  transMatrix.m31 * x + transMatrix.m32 * y + transMatrix.m33;
-                srcX  = ( transMatrix.m11 * x + transMatrix.m12 * y + transMatrix.m13 ) / factor;
-                srcY  = ( transMatrix.m21 * x + transMatrix.m22 * y + transMatrix.m23 ) / factor;
-
-                sx1 = (int) srcX;
-                sy1 = (int) srcY;
-
-                if ( ( sx1 >= 0 ) && ( sy1 >= 0 ) && ( sx1 < srcWidth ) && ( sy1 < srcHeight ) )
-                {
-                    // get rid of possible negative fractions
-                    if ( srcX < 0 ) srcX = 0.0f;
-                    if ( srcY < 0 ) srcY = 0.0f;
-
-                    sx2 = ( sx1 == srcWidthM1 ) ? sx1 : sx1 + 1;
-                    dx1 = srcX - sx1;
-                    dx2 = 1.0f - dx1;
-
-                    sy2 = ( sy1 == srcHeightM1 ) ? sy1 : sy1 + 1;
-                    dy1 = srcY - sy1;
-                    dy2 = 1.0f - dy1;
-
-                    // get four points
-                    p1 = p2 = srcPtr + sy1 * srcStride;
-                    p1 += sx1 * pixelSize;
-                    p2 += sx2 * pixelSize;
-
-                    p3 = p4 = srcPtr + sy2 * srcStride;
-                    p3 += sx1 * pixelSize;
-                    p4 += sx2 * pixelSize;
-
-                    // interpolate using 4 points
-                    for ( i = 0; i < pixelSize; i++, dstRow++, p1++, p2++, p3++, p4++ )
-                    {
-                        *dstRow = (uint8_t) (
-                            dy2 * ( dx2 * ( *p1 ) + dx1 * ( *p2 ) ) +
-                            dy1 * ( dx2 * ( *p3 ) + dx1 * ( *p4 ) ) );
-                    }
-                }
-                else
-                {
-                    if ( fillSpaces == true )
-                    {
-                        for ( i = 0; i < pixelSize; i++, dstRow++ )
-                        {
-                            *dstRow = 0;
-                        }
-                    }
-                    else
-                    {
-                        dstRow += pixelSize;
-                    }
-                }
-            }
-        }
-    }
-}
-
 // Embed source image into target using the specified 4 quadrilateral points
 XErrorCode EmbedQuadrilateral( ximage* target, const ximage* source, const xpoint* targetQuadrilateral, bool interpolate )
 {
@@ -299,7 +165,10 @@ XErrorCode EmbedQuadrilateral( ximage* target, const ximage* source, const xpoin
             }
             else
             {
-                TransformQuadrilateral( source, target, &transMatrix, minX, minY, maxX, maxY, interpolate, false );
+                xrect targetRect = { minX, minY, maxX, maxY };
+
+                // pixels outside of the quadrilateral are mapped outside of source image, so left untouched
+                ret = WarpImage( source, target, &transMatrix, targetRect, interpolate, 0 );
             }
         }
     }
@@ -342,7 +211,10 @@ XErrorCode ExtractQuadrilateral( const ximage* source, ximage* target, const xpo
         }
         else
         {
-            TransformQuadrilateral( source, target, &transMatrix, 0, 0, target->width - 1, target->height - 1, interpolate, true );
+            xrect targetRect = { 0, 0, target->width - 1, target->height - 1 };
+            xargb fillColor  = { 0 };
+
+            ret = WarpImage( source, target, &transMatrix, targetRect, interpolate, &fillColor );
         }
     }
 
@@ -20,9 +20,51 @@
 */
 
 #include "ximaging.h"
+#include "xcpuid.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif
+
+/*
+ * Rotation is done by tiles of destination image. Reading a column of source image touches
+ * one cache line per pixel, so keeping tiles small lets those cache lines to be reused for
+ * all the pixels of a tile row instead of being evicted before next destination row needs them.
+ * Inside tiles, 8 bpp and 32 bpp images are transposed by blocks in SSE registers.
+ *
+ * For both rotations, source pixel of the destination pixel (x, y) is found as:
+ *   srcOrigin + x * srcXStep + y * srcYStep
+ */
+
+// Size of destination tiles in pixels
+#define TILE_SIZE (64)
+
+// forward declaration ----
+static XErrorCode RotateImage( const ximage* src, ximage* dst, bool clockwise );
+static void RotateTile( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride,
+                        int pixelSize, int x0, int y0, int x1, int y1, bool useSimd );
+static void RotateRectangle( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride,
+                             int pixelSize, int x0, int y0, int x1, int y1 );
+static void TransposeBlock8( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride, int x, int y );
+static void TransposeBlock32( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride, int x, int y );
+// ------------------------
 
 // Rotate image counter clockwise by 90 degrees
 XErrorCode RotateImage90( const ximage* src, ximage* dst )
+{
+    return RotateImage( src, dst, false );
+}
+
+// Rotate image clockwise by 90 degrees
+XErrorCode RotateImage270( const ximage* src, ximage* dst )
+{
+    return RotateImage( src, dst, true );
+}
+
+// Rotate image by 90 degrees in the specified direction
+static XErrorCode RotateImage( const ximage* src, ximage* dst, bool clockwise )
 {
     XErrorCode ret = SuccessCode;
 
@@ -31,8 +73,11 @@ XErrorCode RotateImage90( const ximage* src, ximage* dst )
         ret = ErrorNullParameter;
     }
     else if ( ( src->format != XPixelFormatGrayscale8 ) &&
+              ( src->format != XPixelFormatGrayscale16 ) &&
               ( src->format != XPixelFormatRGB24 ) &&
-              ( src->format != XPixelFormatRGBA32 ) )
+              ( src->format != XPixelFormatRGBA32 ) &&
+              ( src->format != XPixelFormatRGB48 ) &&
+              ( src->format != XPixelFormatRGBA64 ) )
     {
         ret = ErrorUnsupportedPixelFormat;
     }
@@ -44,34 +89,47 @@ XErrorCode RotateImage90( const ximage* src, ximage* dst )
     }
     else
     {
-        int      dstWidth  = dst->width;
-        int      dstHeight = dst->height;
-        int      pixelSize = ( dst->format == XPixelFormatGrayscale8 ) ? 1 :
-                             ( dst->format == XPixelFormatRGB24 ) ? 3 : 4;
-        int      srcStride = src->stride;
-        int      dstStride = dst->stride;
-        int      y;
-
-        uint8_t* srcPtr    = src->data;
-        uint8_t* dstPtr    = dst->data;
-
-        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, dstWidth, dstHeight, srcStride, dstStride, pixelSize )
-        for ( y = 0; y < dstHeight; y++ )
+        int      dstWidth   = dst->width;
+        int      dstHeight  = dst->height;
+        int      pixelSize  = (int) XImageBitsPerPixel( dst->format ) / 8;
+        int      srcStride  = src->stride;
+        int      dstStride  = dst->stride;
+        int      tilesCount = ( dstHeight + TILE_SIZE - 1 ) / TILE_SIZE;
+        bool     useSimd    = IsSSE2( );
+        int      tileY;
+
+        const uint8_t* srcOrigin;
+        int            srcXStep;
+        int            srcYStep;
+
+        uint8_t* dstPtr = dst->data;
+
+        if ( clockwise )
+        {
+            // destination rows start at the bottom of source columns
+            srcOrigin = src->data + ( dstWidth - 1 ) * srcStride;
+            srcXStep  = -srcStride;
+            srcYStep  = pixelSize;
+        }
+        else
         {
-            uint8_t* dstRow = dstPtr + y * dstStride;
-            uint8_t* srcRow = srcPtr + ( dstHeight - 1 - y ) * pixelSize;
-            int      x, i;
+            // destination rows start at the top of source columns, going from right to left
+            srcOrigin = src->data + ( dstHeight - 1 ) * pixelSize;
+            srcXStep  = srcStride;
+            srcYStep  = -pixelSize;
+        }
 
-            for ( x = 0; x < dstWidth; x++ )
-            {
-                for ( i = 0; i < pixelSize; i++ )
-                {
-                    *dstRow = *srcRow;
-                    dstRow++;
-                    srcRow++;
-                }
+        #pragma omp parallel for schedule(static) shared( srcOrigin, srcXStep, srcYStep, dstPtr, dstWidth, dstHeight, dstStride, pixelSize, useSimd )
+        for ( tileY = 0; tileY < tilesCount; tileY++ )
+        {
+            int y0 = tileY * TILE_SIZE;
+            int y1 = XMIN( y0 + TILE_SIZE, dstHeight );
+            int x0;
 
-                srcRow += ( srcStride - pixelSize );
+            for ( x0 = 0; x0 < dstWidth; x0 += TILE_SIZE )
+            {
+                RotateTile( srcOrigin, srcXStep, srcYStep, dstPtr, dstStride, pixelSize,
+                            x0, y0, XMIN( x0 + TILE_SIZE, dstWidth ), y1, useSimd );
             }
         }
     }
@@ -79,60 +137,188 @@ XErrorCode RotateImage90( const ximage* src, ximage* dst )
     return ret;
 }
 
-// Rotate image clockwise by 90 degrees
-XErrorCode RotateImage270( const ximage* src, ximage* dst )
+// Fill the specified tile of destination image, using SIMD transposes for the part covered by whole blocks
+static void RotateTile( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride,
+                        int pixelSize, int x0, int y0, int x1, int y1, bool useSimd )
 {
-    XErrorCode ret = SuccessCode;
+    int simdX1 = x0;
+    int simdY1 = y0;
+    int x, y;
 
-    if ( ( src == 0 ) || ( dst == 0 ) )
-    {
-        ret = ErrorNullParameter;
-    }
-    else if ( ( src->format != XPixelFormatGrayscale8 ) &&
-              ( src->format != XPixelFormatRGB24 ) &&
-              ( src->format != XPixelFormatRGBA32 ) )
-    {
-        ret = ErrorUnsupportedPixelFormat;
-    }
-    else if ( ( src->format != dst->format ) ||
-              ( src->width  != dst->height ) ||
-              ( src->height != dst->width  ) )
+    if ( ( useSimd ) && ( ( pixelSize == 1 ) || ( pixelSize == 4 ) ) )
     {
-        ret = ErrorImageParametersMismatch;
+        int blockSize = ( pixelSize == 1 ) ? 8 : 4;
+
+        simdX1 = x0 + ( x1 - x0 ) / blockSize * blockSize;
+        simdY1 = y0 + ( y1 - y0 ) / blockSize * blockSize;
+
+        for ( y = y0; y < simdY1; y += blockSize )
+        {
+            for ( x = x0; x < simdX1; x += blockSize )
+            {
+                if ( pixelSize == 1 )
+                {
+                    TransposeBlock8( srcOrigin, srcXStep, srcYStep, dstPtr, dstStride, x, y );
+                }
+                else
+                {
+                    TransposeBlock32( srcOrigin, srcXStep, srcYStep, dstPtr, dstStride, x, y );
+                }
+            }
+        }
     }
-    else
+
+    // right side of the tile not covered by blocks
+    RotateRectangle( srcOrigin, srcXStep, srcYStep, dstPtr, dstStride, pixelSize, simdX1, y0, x1, simdY1 );
+    // bottom side of the tile not covered by blocks
+    RotateRectangle( srcOrigin, srcXStep, srcYStep, dstPtr, dstStride, pixelSize, x0, simdY1, x1, y1 );
+}
+
+// Fill the specified rectangle of destination image pixel by pixel
+static void RotateRectangle( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride,
+                             int pixelSize, int x0, int y0, int x1, int y1 )
+{
+    int x, y, i;
+
+    for ( y = y0; y < y1; y++ )
     {
-        int      dstWidth  = dst->width;
-        int      dstHeight = dst->height;
-        int      pixelSize = ( dst->format == XPixelFormatGrayscale8 ) ? 1 :
-                             ( dst->format == XPixelFormatRGB24 ) ? 3 : 4;
-        int      srcStride = src->stride;
-        int      dstStride = dst->stride;
-        int      y;
-
-        uint8_t* srcPtr    = src->data;
-        uint8_t* dstPtr    = dst->data;
-
-        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, dstWidth, srcStride, dstStride, pixelSize )
-        for ( y = 0; y < dstHeight; y++ )
+        uint8_t*       dstRow = dstPtr + y * dstStride + x0 * pixelSize;
+        const uint8_t* srcPix = srcOrigin + x0 * srcXStep + y * srcYStep;
+
+        switch ( pixelSize )
         {
-            uint8_t* dstRow = dstPtr + y * dstStride;
-            uint8_t* srcRow = srcPtr + ( dstWidth - 1 ) * srcStride + y * pixelSize;
-            int      x, i;
+        case 1:
+            for ( x = x0; x < x1; x++, dstRow++, srcPix += srcXStep )
+            {
+                *dstRow = *srcPix;
+            }
+            break;
+
+        case 2:
+            for ( x = x0; x < x1; x++, dstRow += 2, srcPix += srcXStep )
+            {
+                *( (uint16_t*) dstRow ) = *( (const uint16_t*) srcPix );
+            }
+            break;
+
+        case 3:
+            for ( x = x0; x < x1; x++, dstRow += 3, srcPix += srcXStep )
+            {
+                *( (uint16_t*) dstRow ) = *( (const uint16_t*) srcPix );
+                dstRow[2] = srcPix[2];
+            }
+            break;
+
+        case 4:
+            for ( x = x0; x < x1; x++, dstRow += 4, srcPix += srcXStep )
+            {
+                *( (uint32_t*) dstRow ) = *( (const uint32_t*) srcPix );
+            }
+            break;
+
+        case 8:
+            for ( x = x0; x < x1; x++, dstRow += 8, srcPix += srcXStep )
+            {
+                *( (uint64_t*) dstRow ) = *( (const uint64_t*) srcPix );
+            }
+            break;
 
-            for ( x = 0; x < dstWidth; x++ )
+        default:
+            for ( x = x0; x < x1; x++, dstRow += pixelSize, srcPix += srcXStep )
             {
                 for ( i = 0; i < pixelSize; i++ )
                 {
-                    *dstRow = *srcRow;
-                    dstRow++;
-                    srcRow++;
+                    dstRow[i] = srcPix[i];
                 }
-
-                srcRow -= ( pixelSize + srcStride );
             }
+            break;
         }
     }
+}
 
-    return ret;
+/*
+ * Each source row of a block is read with a single load from its lowest address. When source
+ * pixels go backward (srcYStep is negative), the first transposed row belongs to the last
+ * destination row of the block.
+ */
+
+// Fill 8x8 block of 8 bpp destination image starting at (x, y)
+static void TransposeBlock8( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride, int x, int y )
+{
+    const uint8_t* srcPix   = srcOrigin + x * srcXStep + ( ( srcYStep > 0 ) ? y : y + 7 ) * srcYStep;
+    uint8_t*       dstRow   = dstPtr + y * dstStride + x;
+    int            dstStep  = dstStride;
+    __m128i        r0, r1, r2, r3, r4, r5, r6, r7;
+    __m128i        a0, a1, a2, a3, b0, b1, b2, b3;
+
+    if ( srcYStep < 0 )
+    {
+        dstRow += 7 * dstStride;
+        dstStep = -dstStride;
+    }
+
+    r0 = _mm_loadl_epi64( (const __m128i*) ( srcPix ) );
+    r1 = _mm_loadl_epi64( (const __m128i*) ( srcPix +     srcXStep ) );
+    r2 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 2 * srcXStep ) );
+    r3 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 3 * srcXStep ) );
+    r4 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 4 * srcXStep ) );
+    r5 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 5 * srcXStep ) );
+    r6 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 6 * srcXStep ) );
+    r7 = _mm_loadl_epi64( (const __m128i*) ( srcPix + 7 * srcXStep ) );
+
+    // interleave bytes, words and double words of row pairs
+    a0 = _mm_unpacklo_epi8( r0, r1 );
+    a1 = _mm_unpacklo_epi8( r2, r3 );
+    a2 = _mm_unpacklo_epi8( r4, r5 );
+    a3 = _mm_unpacklo_epi8( r6, r7 );
+
+    b0 = _mm_unpacklo_epi16( a0, a1 );
+    b1 = _mm_unpackhi_epi16( a0, a1 );
+    b2 = _mm_unpacklo_epi16( a2, a3 );
+    b3 = _mm_unpackhi_epi16( a2, a3 );
+
+    // each register now keeps two columns of the block
+    a0 = _mm_unpacklo_epi32( b0, b2 );
+    a1 = _mm_unpackhi_epi32( b0, b2 );
+    a2 = _mm_unpacklo_epi32( b1, b3 );
+    a3 = _mm_unpackhi_epi32( b1, b3 );
+
+    _mm_storel_epi64( (__m128i*) ( dstRow               ), a0 );
+    _mm_storel_epi64( (__m128i*) ( dstRow +     dstStep ), _mm_unpackhi_epi64( a0, a0 ) );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 2 * dstStep ), a1 );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 3 * dstStep ), _mm_unpackhi_epi64( a1, a1 ) );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 4 * dstStep ), a2 );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 5 * dstStep ), _mm_unpackhi_epi64( a2, a2 ) );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 6 * dstStep ), a3 );
+    _mm_storel_epi64( (__m128i*) ( dstRow + 7 * dstStep ), _mm_unpackhi_epi64( a3, a3 ) );
+}
+
+// Fill 4x4 block of 32 bpp destination image starting at (x, y)
+static void TransposeBlock32( const uint8_t* srcOrigin, int srcXStep, int srcYStep, uint8_t* dstPtr, int dstStride, int x, int y )
+{
+    const uint8_t* srcPix   = srcOrigin + x * srcXStep + ( ( srcYStep > 0 ) ? y : y + 3 ) * srcYStep;
+    uint8_t*       dstRow   = dstPtr + y * dstStride + x * 4;
+    int            dstStep  = dstStride;
+    __m128i        r0, r1, r2, r3, t0, t1, t2, t3;
+
+    if ( srcYStep < 0 )
+    {
+        dstRow += 3 * dstStride;
+        dstStep = -dstStride;
+    }
+
+    r0 = _mm_loadu_si128( (const __m128i*) ( srcPix ) );
+    r1 = _mm_loadu_si128( (const __m128i*) ( srcPix +     srcXStep ) );
+    r2 = _mm_loadu_si128( (const __m128i*) ( srcPix + 2 * srcXStep ) );
+    r3 = _mm_loadu_si128( (const __m128i*) ( srcPix + 3 * srcXStep ) );
+
+    t0 = _mm_unpacklo_epi32( r0, r1 );
+    t1 = _mm_unpacklo_epi32( r2, r3 );
+    t2 = _mm_unpackhi_epi32( r0, r1 );
+    t3 = _mm_unpackhi_epi32( r2, r3 );
+
+    _mm_storeu_si128( (__m128i*) ( dstRow               ), _mm_unpacklo_epi64( t0, t1 ) );
+    _mm_storeu_si128( (__m128i*) ( dstRow +     dstStep ), _mm_unpackhi_epi64( t0, t1 ) );
+    _mm_storeu_si128( (__m128i*) ( dstRow + 2 * dstStep ), _mm_unpacklo_epi64( t2, t3 ) );
+    _mm_storeu_si128( (__m128i*) ( dstRow + 3 * dstStep ), _mm_unpackhi_epi64( t2, t3 ) );
 }
@@ -22,12 +22,6 @@
 #include "ximaging.h"
 #include <math.h>
 
-// forward declaration ----
-static void RotateImageBilinear8 ( const ximage* src, ximage* dst, float angle, xargb fillColor );
-static void RotateImageBilinear24( const ximage* src, ximage* dst, float angle, xargb fillColor );
-static void RotateImageBilinear32( const ximage* src, ximage* dst, float angle, xargb fillColor );
-// ------------------------
-
 // Resize image using bilinear interpolation
 XErrorCode RotateImageBilinear( const ximage* src, ximage* dst, float angle, xargb fillColor )
 {
@@ -53,367 +47,35 @@ XErrorCode RotateImageBilinear( const ximage* src, ximage* dst, float angle, xar
     }
     else
     {
-        if ( src->format == XPixelFormatGrayscale8 )
-        {
-            RotateImageBilinear8( src, dst, angle, fillColor );
-        }
-        else if ( src->format == XPixelFormatRGB24 )
-        {
-            RotateImageBilinear24( src, dst, angle, fillColor );
-        }
-        else
-        {
-            RotateImageBilinear32( src, dst, angle, fillColor );
-        }
-    }
-
-    return ret;
-}
-
-// Rotate grayscale 8 bpp image
-void RotateImageBilinear8( const ximage* src, ximage* dst, float angle, xargb fillColor )
-{
-    int      srcWidth    = src->width;
-    int      srcHeight   = src->height;
-    int      srcWidthM1  = src->width - 1;
-    int      srcHeightM1 = src->height - 1;
-    int      dstWidth    = dst->width;
-    int      dstHeight   = dst->height;
-    int      srcStride   = src->stride;
-    int      dstStride   = dst->stride;
-    uint8_t* srcPtr      = src->data;
-    uint8_t* dstPtr      = dst->data;
-    int      y;
-
-    // images' radiuses
-    double srcXradius = (double) ( srcWidth  - 1 ) / 2;
-    double srcYradius = (double) ( srcHeight - 1 ) / 2;
-    double dstXradius = (double) ( dstWidth  - 1 ) / 2;
-    double dstYradius = (double) ( dstHeight - 1 ) / 2;
-
-    // angle's sine and cosine
-    double angleRad = -angle * XPI / 180;
-    double angleCos = cos( angleRad );
-    double angleSin = sin( angleRad );
-
-    // fill values
-    uint8_t fillValue = (uint8_t) ( RGB_TO_GRAY( fillColor.components.r, fillColor.components.g, fillColor.components.b ) * fillColor.components.a / 255 );
-
-    #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, srcWidth, srcHeight, dstWidth, srcWidthM1, srcHeightM1, srcStride, dstStride, \
-                                                      angleCos, angleSin, fillValue, srcXradius, srcYradius, dstXradius, dstYradius )
-    for ( y = 0; y < dstHeight; y++ )
-    {
-        int         x;
-        double      ox, oy, dx1, dy1, dx2, dy2;  // source point coordinates
-        int         ox1, oy1, ox2, oy2;
-        uint8_t*    dstRow = dstPtr + y * dstStride;
-        uint8_t*    p1;
-        uint8_t*    p2;
-        uint8_t*    p3;
-        uint8_t*    p4;
-
-        // destination pixel's coordinate relative to image center
-        double cx = -dstXradius;
-        double cy = -dstYradius + y;
-
-        // do some pre-calculations of source points' coordinates
-        // (calculate the part which depends on y-loop, but does not depend on x-loop)
-        double tx = angleSin * cy + srcXradius;
-        double ty = angleCos * cy + srcYradius;
-
-        for ( x = 0; x < dstWidth; x++ )
-        {
-            // get the source point coordinates
-            ox = tx + angleCos * cx;
-            oy = ty - angleSin * cx;
-
-            // top-left coordinate
-            ox1 = (int) ox;
-            oy1 = (int) oy;
-
-            // validate source pixel's coordinates
-            if ( ( ox1 < 0 ) || ( oy1 < 0 ) || ( ox1 >= srcWidth ) || ( oy1 >= srcHeight ) )
-            {
-                // fill destination image with filler
-                *dstRow = fillValue;
-            }
-            else
-            {
-                // bottom-right coordinate
-                ox2 = ( ox1 == srcWidthM1 )  ? ox1 : ox1 + 1;
-                oy2 = ( oy1 == srcHeightM1 ) ? oy1 : oy1 + 1;
-
-                if ( ( dx1 = ox - ox1 ) < 0 )
-                    dx1 = 0;
-                dx2 = 1.0f - dx1;
-
-                if ( ( dy1 = oy - oy1 ) < 0 )
-                    dy1 = 0;
-                dy2 = 1.0f - dy1;
-
-                // get four points
-                p1 = p2 = srcPtr + oy1 * srcStride;
-                p1 += ox1;
-                p2 += ox2;
-
-                p3 = p4 = srcPtr + oy2 * srcStride;
-                p3 += ox1;
-                p4 += ox2;
-
-                // interpolate using 4 points
-
-                *dstRow = (uint8_t) (
-                    dy2 * ( dx2 * *p1 + dx1 * *p2 ) +
-                    dy1 * ( dx2 * *p3 + dx1 * *p4 ) );
-            }
-
-            cx++;
-            dstRow++;
-        }
-    }
-}
-
-// Rotate color 24 bpp RGB image
-void RotateImageBilinear24( const ximage* src, ximage* dst, float angle, xargb fillColor )
-{
-    int      srcWidth    = src->width;
-    int      srcHeight   = src->height;
-    int      srcWidthM1  = src->width - 1;
-    int      srcHeightM1 = src->height - 1;
-    int      dstWidth    = dst->width;
-    int      dstHeight   = dst->height;
-    int      srcStride   = src->stride;
-    int      dstStride   = dst->stride;
-    uint8_t* srcPtr      = src->data;
-    uint8_t* dstPtr      = dst->data;
-    int      y;
-
-    // images' radiuses
-    double srcXradius = (double) ( srcWidth  - 1 ) / 2;
-    double srcYradius = (double) ( srcHeight - 1 ) / 2;
-    double dstXradius = (double) ( dstWidth  - 1 ) / 2;
-    double dstYradius = (double) ( dstHeight - 1 ) / 2;
-
-    // angle's sine and cosine
-    double angleRad = -angle * XPI / 180;
-    double angleCos = cos( angleRad );
-    double angleSin = sin( angleRad );
-
-    // fill values
-    uint8_t fillR = (uint8_t) ( fillColor.components.r * fillColor.components.a / 255 );
-    uint8_t fillG = (uint8_t) ( fillColor.components.g * fillColor.components.a / 255 );
-    uint8_t fillB = (uint8_t) ( fillColor.components.b * fillColor.components.a / 255 );
-
-    #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, srcWidth, srcHeight, dstWidth, srcWidthM1, srcHeightM1, srcStride, dstStride, \
-                                                      angleCos, angleSin, fillR, fillG, fillB, srcXradius, srcYradius, dstXradius, dstYradius )
-    for ( y = 0; y < dstHeight; y++ )
-    {
-        int         x;
-        double      ox, oy, dx1, dy1, dx2, dy2;  // source point coordinates
-        int         ox1, oy1, ox2, oy2;
-        uint8_t*    dstRow = dstPtr + y * dstStride;
-        uint8_t*    p1;
-        uint8_t*    p2;
-        uint8_t*    p3;
-        uint8_t*    p4;
-
-        // destination pixel's coordinate relative to image center
-        double cx = -dstXradius;
-        double cy = -dstYradius + y;
-
-        // do some pre-calculations of source points' coordinates
-        // (calculate the part which depends on y-loop, but does not depend on x-loop)
-        double tx = angleSin * cy + srcXradius;
-        double ty = angleCos * cy + srcYradius;
-
-        for ( x = 0; x < dstWidth; x++ )
-        {
-            // get the source point coordinates
-            ox = tx + angleCos * cx;
-            oy = ty - angleSin * cx;
-
-            // top-left coordinate
-            ox1 = (int) ox;
-            oy1 = (int) oy;
+        // images' radiuses
+        double srcXradius = (double) ( src->width  - 1 ) / 2;
+        double srcYradius = (double) ( src->height - 1 ) / 2;
+        double dstXradius = (double) ( dst->width  - 1 ) / 2;
+        double dstYradius = (double) ( dst->height - 1 ) / 2;
 
-            // validate source pixel's coordinates
-            if ( ( ox1 < 0 ) || ( oy1 < 0 ) || ( ox1 >= srcWidth ) || ( oy1 >= srcHeight ) )
-            {
-                // fill destination image with filler
-                dstRow[RedIndex]   = fillR;
-                dstRow[GreenIndex] = fillG;
-                dstRow[BlueIndex]  = fillB;
-            }
-            else
-            {
-                // bottom-right coordinate
-                ox2 = ( ox1 == srcWidthM1 )  ? ox1 : ox1 + 1;
-                oy2 = ( oy1 == srcHeightM1 ) ? oy1 : oy1 + 1;
-
-                if ( ( dx1 = ox - ox1 ) < 0 )
-                    dx1 = 0;
-                dx2 = 1.0f - dx1;
-
-                if ( ( dy1 = oy - oy1 ) < 0 )
-                    dy1 = 0;
-                dy2 = 1.0f - dy1;
-
-                // get four points
-                p1 = p2 = srcPtr + oy1 * srcStride;
-                p1 += ox1 * 3;
-                p2 += ox2 * 3;
-
-                p3 = p4 = srcPtr + oy2 * srcStride;
-                p3 += ox1 * 3;
-                p4 += ox2 * 3;
-
-                // interpolate using 4 points
-
-                // red
-                dstRow[RedIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[RedIndex] + dx1 * p2[RedIndex] ) +
-                    dy1 * ( dx2 * p3[RedIndex] + dx1 * p4[RedIndex] ) );
-
-                // green
-                dstRow[GreenIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[GreenIndex] + dx1 * p2[GreenIndex] ) +
-                    dy1 * ( dx2 * p3[GreenIndex] + dx1 * p4[GreenIndex] ) );
-
-                // blue
-                dstRow[BlueIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[BlueIndex] + dx1 * p2[BlueIndex] ) +
-                    dy1 * ( dx2 * p3[BlueIndex] + dx1 * p4[BlueIndex] ) );
-            }
+        // angle's sine and cosine
+        double angleRad = -angle * XPI / 180;
+        double angleCos = cos( angleRad );
+        double angleSin = sin( angleRad );
 
-            cx++;
-            dstRow += 3;
-        }
+        // rotation around destination image's center, which maps it into source image's center
+        xmatrix3 transform;
+        xrect    dstRect = { 0, 0, dst->width - 1, dst->height - 1 };
+
+        transform.m11 = (float) angleCos;
+        transform.m12 = (float) angleSin;
+        transform.m13 = (float) ( srcXradius - angleCos * dstXradius - angleSin * dstYradius );
+        transform.m21 = (float) -angleSin;
+        transform.m22 = (float) angleCos;
+        transform.m23 = (float) ( srcYradius + angleSin * dstXradius - angleCos * dstYradius );
+        transform.m31 = 0.0f;
+        transform.m32 = 0.0f;
+        transform.m33 = 1.0f;
+
+        ret = WarpImage( src, dst, &transform, dstRect, true, &fillColor );
     }
-}
-
-// Rotate color 32 bpp RGBA image
-void RotateImageBilinear32( const ximage* src, ximage* dst, float angle, xargb fillColor )
-{
-    int      srcWidth    = src->width;
-    int      srcHeight   = src->height;
-    int      srcWidthM1  = src->width - 1;
-    int      srcHeightM1 = src->height - 1;
-    int      dstWidth    = dst->width;
-    int      dstHeight   = dst->height;
-    int      srcStride   = src->stride;
-    int      dstStride   = dst->stride;
-    uint8_t* srcPtr      = src->data;
-    uint8_t* dstPtr      = dst->data;
-    int      y;
-
-    // images' radiuses
-    double srcXradius = (double) ( srcWidth  - 1 ) / 2;
-    double srcYradius = (double) ( srcHeight - 1 ) / 2;
-    double dstXradius = (double) ( dstWidth  - 1 ) / 2;
-    double dstYradius = (double) ( dstHeight - 1 ) / 2;
-
-    // angle's sine and cosine
-    double angleRad = -angle * XPI / 180;
-    double angleCos = cos( angleRad );
-    double angleSin = sin( angleRad );
-
-    // fill values
-    uint8_t fillR = fillColor.components.r;
-    uint8_t fillG = fillColor.components.g;
-    uint8_t fillB = fillColor.components.b;
-    uint8_t fillA = fillColor.components.a;
 
-    #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, srcWidth, srcHeight, dstWidth, srcWidthM1, srcHeightM1, srcStride, dstStride, \
-                                                      angleCos, angleSin, fillR, fillG, fillB, fillA, srcXradius, srcYradius, dstXradius, dstYradius )
-    for ( y = 0; y < dstHeight; y++ )
-    {
-        int         x;
-        double      ox, oy, dx1, dy1, dx2, dy2;  // source point coordinates
-        int         ox1, oy1, ox2, oy2;
-        uint8_t*    dstRow = dstPtr + y * dstStride;
-        uint8_t*    p1;
-        uint8_t*    p2;
-        uint8_t*    p3;
-        uint8_t*    p4;
-
-        // destination pixel's coordinate relative to image center
-        double cx = -dstXradius;
-        double cy = -dstYradius + y;
-
-        // do some pre-calculations of source points' coordinates
-        // (calculate the part which depends on y-loop, but does not depend on x-loop)
-        double tx = angleSin * cy + srcXradius;
-        double ty = angleCos * cy + srcYradius;
-
-        for ( x = 0; x < dstWidth; x++ )
-        {
-            // get the source point coordinates
-            ox = tx + angleCos * cx;
-            oy = ty - angleSin * cx;
-
-            // top-left coordinate
-            ox1 = (int) ox;
-            oy1 = (int) oy;
-
-            // validate source pixel's coordinates
-            if ( ( ox1 < 0 ) || ( oy1 < 0 ) || ( ox1 >= srcWidth ) || ( oy1 >= srcHeight ) )
-            {
-                // fill destination image with filler
-                dstRow[RedIndex]   = fillR;
-                dstRow[GreenIndex] = fillG;
-                dstRow[BlueIndex]  = fillB;
-                dstRow[AlphaIndex] = fillA;
-            }
-            else
-            {
-                // bottom-right coordinate
-                ox2 = ( ox1 == srcWidthM1 )  ? ox1 : ox1 + 1;
-                oy2 = ( oy1 == srcHeightM1 ) ? oy1 : oy1 + 1;
-
-                if ( ( dx1 = ox - ox1 ) < 0 )
-                    dx1 = 0;
-                dx2 = 1.0f - dx1;
-
-                if ( ( dy1 = oy - oy1 ) < 0 )
-                    dy1 = 0;
-                dy2 = 1.0f - dy1;
-
-                // get four points
-                p1 = p2 = srcPtr + oy1 * srcStride;
-                p1 += ox1 * 4;
-                p2 += ox2 * 4;
-
-                p3 = p4 = srcPtr + oy2 * srcStride;
-                p3 += ox1 * 4;
-                p4 += ox2 * 4;
-
-                // interpolate using 4 points
-
-                // red
-                dstRow[RedIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[RedIndex] + dx1 * p2[RedIndex] ) +
-                    dy1 * ( dx2 * p3[RedIndex] + dx1 * p4[RedIndex] ) );
-
-                // green
-                dstRow[GreenIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[GreenIndex] + dx1 * p2[GreenIndex] ) +
-                    dy1 * ( dx2 * p3[GreenIndex] + dx1 * p4[GreenIndex] ) );
-
-                // blue
-                dstRow[BlueIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[BlueIndex] + dx1 * p2[BlueIndex] ) +
-                    dy1 * ( dx2 * p3[BlueIndex] + dx1 * p4[BlueIndex] ) );
-
-                // alpha
-                dstRow[AlphaIndex] = (uint8_t) (
-                    dy2 * ( dx2 * p1[AlphaIndex] + dx1 * p2[AlphaIndex] ) +
-                    dy1 * ( dx2 * p3[AlphaIndex] + dx1 * p4[AlphaIndex] ) );
-            }
-
-            cx++;
-            dstRow += 4;
-        }
-    }
+    return ret;
 }
 
 // Calculate image size for a rotated image, so it fit into the new size
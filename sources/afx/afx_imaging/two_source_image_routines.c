@@ -58,11 +58,12 @@ XErrorCode MaskImage( ximage* image, const ximage* mask, xargb fillColor, bool f
     }
     else if ( ( image->format != XPixelFormatGrayscale8 ) &&
               ( image->format != XPixelFormatRGB24 ) &&
-              ( image->format != XPixelFormatRGBA32 ) )
+              ( image->format != XPixelFormatRGBA32 ) &&
+              ( image->format != XPixelFormatBinary1 ) )
     {
         ret = ErrorUnsupportedPixelFormat;
     }
-    else if ( mask->format != XPixelFormatGrayscale8 )
+    else if ( mask->format != ( ( image->format == XPixelFormatBinary1 ) ? XPixelFormatBinary1 : XPixelFormatGrayscale8 ) )
     {
         ret = ErrorUnsupportedPixelFormat;
     }
@@ -82,7 +83,34 @@ XErrorCode MaskImage( ximage* image, const ximage* mask, xargb fillColor, bool f
         uint8_t* imagePtr = image->data;
         uint8_t* maskPtr  = mask->data;
 
-        if ( image->format == XPixelFormatGrayscale8 )
+        if ( image->format == XPixelFormatBinary1 )
+        {
+            // fill with white if fill color is closer to white than to black
+            uint8_t fillBits     = (uint8_t) ( ( RGB_TO_GRAY( fillColor.components.r, fillColor.components.g, fillColor.components.b ) *
+                                             fillColor.components.a / 255 >= 128 ) ? 0xFF : 0x00 );
+            uint8_t invertMask   = (uint8_t) ( ( fillOnZero == true ) ? 0x00 : 0xFF );
+            int     bytesPerLine = ( width + 7 ) >> 3;
+            uint8_t lastByteMask = (uint8_t) ( ( width & 7 ) == 0 ? 0xFF : ( 0xFF00 >> ( width & 7 ) ) );
+
+            #pragma omp parallel for schedule(static) shared( imagePtr, maskPtr, bytesPerLine, imageStride, maskStride, fillBits, invertMask, lastByteMask )
+            for ( y = 0; y < height; y++ )
+            {
+                uint8_t* imageRow = imagePtr + y * imageStride;
+                uint8_t* maskRow  = maskPtr  + y * maskStride;
+                int x;
+
+                // 8 pixels at a time - keep pixels selected by the mask and fill the rest
+                for ( x = 0; x < bytesPerLine; x++ )
+                {
+                    uint8_t keepMask = (uint8_t) ( maskRow[x] ^ invertMask );
+
+                    imageRow[x] = (uint8_t) ( ( imageRow[x] & keepMask ) | ( fillBits & ~keepMask ) );
+                }
+
+                imageRow[bytesPerLine - 1] &= lastByteMask;
+            }
+        }
+        else if ( image->format == XPixelFormatGrayscale8 )
         {
             uint8_t fillValue = (uint8_t) ( RGB_TO_GRAY( fillColor.components.r, fillColor.components.g, fillColor.components.b ) * fillColor.components.a / 255 );
 
@@ -225,9 +253,15 @@ XErrorCode MaskImage( ximage* image, const ximage* mask, xargb fillColor, bool f
 // Merge two images by applying MAX operator for every pair of pixels (result is put back to image1)
 XErrorCode MergeImages( ximage* image1, const ximage* image2 )
 {
-    XErrorCode ret = CheckImages( image1, image2 );
+    // binary images are checked by logic operation itself
+    XErrorCode ret = ( ( image1 != 0 ) && ( image1->format == XPixelFormatBinary1 ) ) ? SuccessCode : CheckImages( image1, image2 );
 
-    if ( ret == SuccessCode )
+    if ( ( ret == SuccessCode ) && ( image1->format == XPixelFormatBinary1 ) )
+    {
+        // MAX of binary pixels is logic OR
+        ret = BinaryImageOr( image1, image2 );
+    }
+    else if ( ret == SuccessCode )
     {
         int height    = image1->height;
         int stride1   = image1->stride;
@@ -268,9 +302,15 @@ XErrorCode MergeImages( ximage* image1, const ximage* image2 )
 // Intersect two images by applying MIN operator for every pair of pixels (result is put back to image1)
 XErrorCode IntersectImages( ximage* image1, const ximage* image2 )
 {
-    XErrorCode ret = CheckImages( image1, image2 );
+    // binary images are checked by logic operation itself
+    XErrorCode ret = ( ( image1 != 0 ) && ( image1->format == XPixelFormatBinary1 ) ) ? SuccessCode : CheckImages( image1, image2 );
 
-    if ( ret == SuccessCode )
+    if ( ( ret == SuccessCode ) && ( image1->format == XPixelFormatBinary1 ) )
+    {
+        // MIN of binary pixels is logic AND
+        ret = BinaryImageAnd( image1, image2 );
+    }
+    else if ( ret == SuccessCode )
     {
         int height    = image1->height;
         int stride1   = image1->stride;
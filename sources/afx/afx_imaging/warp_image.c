@@ -0,0 +1,574 @@
+/*
+    Imaging library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "ximaging.h"
+#include <math.h>
+#include "xcpuid.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif
+
+// Number of destination pixels, which source coordinates are calculated in one go
+#define BLOCK_SIZE (64)
+
+// Number of fraction bits of fixed point coordinates used by affine transformation
+#define FIXED_SHIFT (16)
+#define FIXED_ONE   (1 << FIXED_SHIFT)
+#define FIXED_BIAS  (FIXED_ONE >> 10)
+
+// Parameters of warping shared by all rows of destination image
+typedef struct _warpParams
+{
+    // transformation mapping destination coordinates into source image
+    double          M11, M12, M13;
+    double          M21, M22, M23;
+    double          M31, M32, M33;
+    bool            IsAffine;
+    bool            UseSse;
+    bool            Interpolate;
+
+    const uint8_t*  SrcPtr;
+    int32_t         SrcWidth;
+    int32_t         SrcHeight;
+    int32_t         SrcStride;
+    int32_t         PixelSize;
+    // max coordinates of the top-left pixel used for interpolation
+    int32_t         MaxX;
+    int32_t         MaxY;
+    // offsets of the right/bottom neighbours used for interpolation (0 for single pixel wide/high images)
+    int32_t         XStep;
+    int32_t         YStep;
+
+    // values to fill unmapped pixels with or NULL to leave them untouched
+    const uint8_t*  FillValues;
+}
+WarpParams;
+
+// Source coordinates of a block of destination pixels
+typedef struct _warpBlock
+{
+    // coordinates of the top-left pixel to interpolate from
+    int32_t X[BLOCK_SIZE];
+    int32_t Y[BLOCK_SIZE];
+    // weights of the right/bottom pixels, [0, 256]
+    int32_t Wx[BLOCK_SIZE];
+    int32_t Wy[BLOCK_SIZE];
+}
+WarpBlock;
+
+// forward declaration ----
+static void WarpRow( const WarpParams* params, uint8_t* dstRow, int y, int x1, int x2 );
+// ------------------------
+
+// Warp source image into the specified rectangle of destination image
+XErrorCode WarpImage( const ximage* src, ximage* dst, const xmatrix3* transform, xrect dstRect, bool interpolate, const xargb* fillColor )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) || ( transform == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( src->format != XPixelFormatGrayscale8 ) &&
+              ( src->format != XPixelFormatRGB24 ) &&
+              ( src->format != XPixelFormatRGBA32 ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( src->format != dst->format )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        WarpParams params;
+        uint8_t    fillValues[4] = { 0 };
+        uint8_t*   dstPtr        = dst->data;
+        int        dstStride     = dst->stride;
+        int        x1            = XMAX( dstRect.x1, 0 );
+        int        y1            = XMAX( dstRect.y1, 0 );
+        int        x2            = XMIN( dstRect.x2, dst->width  - 1 );
+        int        y2            = XMIN( dstRect.y2, dst->height - 1 );
+        int        y;
+
+        params.M11 = transform->m11; params.M12 = transform->m12; params.M13 = transform->m13;
+        params.M21 = transform->m21; params.M22 = transform->m22; params.M23 = transform->m23;
+        params.M31 = transform->m31; params.M32 = transform->m32; params.M33 = transform->m33;
+
+        // affine transformation is handled by incremental fixed point coordinates
+        params.IsAffine = ( ( transform->m31 == 0 ) && ( transform->m32 == 0 ) && ( transform->m33 != 0 ) );
+
+        if ( params.IsAffine )
+        {
+            params.M11 /= params.M33; params.M12 /= params.M33; params.M13 /= params.M33;
+            params.M21 /= params.M33; params.M22 /= params.M33; params.M23 /= params.M33;
+            params.M33 = 1.0;
+        }
+
+        params.UseSse      = IsSSE2( );
+        params.Interpolate = interpolate;
+        params.SrcPtr      = src->data;
+        params.SrcWidth    = src->width;
+        params.SrcHeight   = src->height;
+        params.SrcStride   = src->stride;
+        params.PixelSize   = ( src->format == XPixelFormatGrayscale8 ) ? 1 : ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+        params.MaxX        = XMAX( src->width  - 2, 0 );
+        params.MaxY        = XMAX( src->height - 2, 0 );
+        params.XStep       = ( src->width  > 1 ) ? params.PixelSize : 0;
+        params.YStep       = ( src->height > 1 ) ? src->stride : 0;
+        params.FillValues  = 0;
+
+        if ( fillColor != 0 )
+        {
+            if ( src->format == XPixelFormatGrayscale8 )
+            {
+                fillValues[0] = (uint8_t) ( RGB_TO_GRAY( fillColor->components.r, fillColor->components.g, fillColor->components.b ) * fillColor->components.a / 255 );
+            }
+            else if ( src->format == XPixelFormatRGB24 )
+            {
+                fillValues[RedIndex]   = (uint8_t) ( fillColor->components.r * fillColor->components.a / 255 );
+                fillValues[GreenIndex] = (uint8_t) ( fillColor->components.g * fillColor->components.a / 255 );
+                fillValues[BlueIndex]  = (uint8_t) ( fillColor->components.b * fillColor->components.a / 255 );
+            }
+            else
+            {
+                fillValues[RedIndex]   = fillColor->components.r;
+                fillValues[GreenIndex] = fillColor->components.g;
+                fillValues[BlueIndex]  = fillColor->components.b;
+                fillValues[AlphaIndex] = fillColor->components.a;
+            }
+
+            params.FillValues = fillValues;
+        }
+
+        #pragma omp parallel for schedule(static) shared( params, dstPtr, dstStride, x1, x2 )
+        for ( y = y1; y <= y2; y++ )
+        {
+            WarpRow( &params, dstPtr + y * dstStride, y, x1, x2 );
+        }
+    }
+
+    return ret;
+}
+
+// Narrow the [first, last] range of X coordinates to those, for which p + q * x is positive
+static void ClipSpan( double p, double q, int* first, int* last )
+{
+    if ( q == 0 )
+    {
+        if ( p <= 0 )
+        {
+            *last = *first - 1;
+        }
+    }
+    else
+    {
+        double root = -p / q;
+
+        if ( q > 0 )
+        {
+            // x > root
+            if ( root >= *last )
+            {
+                *last = *first - 1;
+            }
+            else if ( root >= *first )
+            {
+                *first = (int) floor( root ) + 1;
+            }
+        }
+        else
+        {
+            // x < root
+            if ( root <= *first )
+            {
+                *last = *first - 1;
+            }
+            else if ( root <= *last )
+            {
+                *last = (int) ceil( root ) - 1;
+            }
+        }
+    }
+}
+
+// Find span of destination row's pixels, which are mapped inside of source image, while the transformation's
+// denominator has the specified sign. Source X/Y coordinates are linear functions of destination X coordinate within
+// a row, so the (-1, width) and (-1, height) ranges give linear inequalities after multiplying by the denominator.
+static void FindRowSpan( const WarpParams* params, int y, double sign, int* first, int* last )
+{
+    double uc = params->M12 * y + params->M13, uk = params->M11;
+    double vc = params->M22 * y + params->M23, vk = params->M21;
+    double wc = params->M32 * y + params->M33, wk = params->M31;
+
+    // denominator > 0
+    ClipSpan( sign * wc, sign * wk, first, last );
+    // u / w > -1
+    ClipSpan( sign * ( uc + wc ), sign * ( uk + wk ), first, last );
+    // u / w < width
+    ClipSpan( sign * ( params->SrcWidth * wc - uc ), sign * ( params->SrcWidth * wk - uk ), first, last );
+    // v / w > -1
+    ClipSpan( sign * ( vc + wc ), sign * ( vk + wk ), first, last );
+    // v / w < height
+    ClipSpan( sign * ( params->SrcHeight * wc - vc ), sign * ( params->SrcHeight * wk - vk ), first, last );
+}
+
+// Calculate source coordinates for a block of pixels using affine transformation
+static void CalculateAffineBlock( const WarpParams* params, int y, int x0, int count, WarpBlock* block )
+{
+    // the block's start is calculated directly and the rest is walked incrementally; the start is biased by 1/1024
+    // of a pixel, so accumulated rounding errors do not push integer coordinates just below their value
+    double  u      = params->M11 * x0 + params->M12 * y + params->M13;
+    double  v      = params->M21 * x0 + params->M22 * y + params->M23;
+    int32_t maxU   = ( params->SrcWidth  - 1 ) << FIXED_SHIFT;
+    int32_t maxV   = ( params->SrcHeight - 1 ) << FIXED_SHIFT;
+    int32_t fixedU = (int32_t) floor( XINRANGE( u, -1.0, (double) params->SrcWidth  ) * FIXED_ONE ) + FIXED_BIAS;
+    int32_t fixedV = (int32_t) floor( XINRANGE( v, -1.0, (double) params->SrcHeight ) * FIXED_ONE ) + FIXED_BIAS;
+    int32_t stepU  = (int32_t) floor( params->M11 * FIXED_ONE + 0.5 );
+    int32_t stepV  = (int32_t) floor( params->M21 * FIXED_ONE + 0.5 );
+    int32_t maxX   = params->MaxX;
+    int32_t maxY   = params->MaxY;
+    int     i      = 0;
+
+    // coordinates in the (-1, 0) range are snapped to 0, while the last column/row is
+    // interpolated as the previous one with full weight of the next pixel
+    if ( params->UseSse )
+    {
+        __m128i u4     = _mm_setr_epi32( fixedU, fixedU + stepU, fixedU + 2 * stepU, fixedU + 3 * stepU );
+        __m128i v4     = _mm_setr_epi32( fixedV, fixedV + stepV, fixedV + 2 * stepV, fixedV + 3 * stepV );
+        __m128i stepU4 = _mm_set1_epi32( stepU * 4 );
+        __m128i stepV4 = _mm_set1_epi32( stepV * 4 );
+        __m128i maxU4  = _mm_set1_epi32( maxU );
+        __m128i maxV4  = _mm_set1_epi32( maxV );
+        __m128i maxX4  = _mm_set1_epi32( maxX );
+        __m128i maxY4  = _mm_set1_epi32( maxY );
+        __m128i one4   = _mm_set1_epi32( 1 );
+        __m128i cu, cv, ix, iy, mask;
+
+        // the block arrays are big enough to calculate the last incomplete group of 4 pixels as well
+        for ( ; i < count; i += 4 )
+        {
+            // clamp to [0, max] - negative values are cleared using their sign bits
+            cu   = _mm_andnot_si128( _mm_srai_epi32( u4, 31 ), u4 );
+            cv   = _mm_andnot_si128( _mm_srai_epi32( v4, 31 ), v4 );
+            mask = _mm_cmpgt_epi32( cu, maxU4 );
+            cu   = _mm_or_si128( _mm_and_si128( mask, maxU4 ), _mm_andnot_si128( mask, cu ) );
+            mask = _mm_cmpgt_epi32( cv, maxV4 );
+            cv   = _mm_or_si128( _mm_and_si128( mask, maxV4 ), _mm_andnot_si128( mask, cv ) );
+
+            ix   = _mm_srai_epi32( cu, FIXED_SHIFT );
+            iy   = _mm_srai_epi32( cv, FIXED_SHIFT );
+            ix   = _mm_sub_epi32( ix, _mm_and_si128( _mm_cmpgt_epi32( ix, maxX4 ), one4 ) );
+            iy   = _mm_sub_epi32( iy, _mm_and_si128( _mm_cmpgt_epi32( iy, maxY4 ), one4 ) );
+
+            _mm_storeu_si128( (__m128i*) &block->X[i], ix );
+            _mm_storeu_si128( (__m128i*) &block->Y[i], iy );
+            _mm_storeu_si128( (__m128i*) &block->Wx[i], _mm_srai_epi32( _mm_sub_epi32( cu, _mm_slli_epi32( ix, FIXED_SHIFT ) ), FIXED_SHIFT - 8 ) );
+            _mm_storeu_si128( (__m128i*) &block->Wy[i], _mm_srai_epi32( _mm_sub_epi32( cv, _mm_slli_epi32( iy, FIXED_SHIFT ) ), FIXED_SHIFT - 8 ) );
+
+            u4 = _mm_add_epi32( u4, stepU4 );
+            v4 = _mm_add_epi32( v4, stepV4 );
+        }
+    }
+    else
+    {
+        for ( ; i < count; i++ )
+        {
+            int32_t cu = XINRANGE( fixedU, 0, maxU );
+            int32_t cv = XINRANGE( fixedV, 0, maxV );
+            int32_t ix = XMIN( cu >> FIXED_SHIFT, maxX );
+            int32_t iy = XMIN( cv >> FIXED_SHIFT, maxY );
+
+            block->X[i]  = ix;
+            block->Y[i]  = iy;
+            block->Wx[i] = ( cu - ( ix << FIXED_SHIFT ) ) >> ( FIXED_SHIFT - 8 );
+            block->Wy[i] = ( cv - ( iy << FIXED_SHIFT ) ) >> ( FIXED_SHIFT - 8 );
+
+            fixedU += stepU;
+            fixedV += stepV;
+        }
+    }
+}
+
+// Calculate source coordinates for a block of pixels using projective transformation
+static void CalculateProjectiveBlock( const WarpParams* params, int y, int x0, int count, WarpBlock* block )
+{
+    float uc   = (float) ( params->M12 * y + params->M13 ), uk = (float) params->M11;
+    float vc   = (float) ( params->M22 * y + params->M23 ), vk = (float) params->M21;
+    float wc   = (float) ( params->M32 * y + params->M33 ), wk = (float) params->M31;
+    float maxU = (float) ( params->SrcWidth  - 1 );
+    float maxV = (float) ( params->SrcHeight - 1 );
+    int   i    = 0;
+
+    if ( params->UseSse )
+    {
+        __m128  xs     = _mm_setr_ps( (float) x0, (float) ( x0 + 1 ), (float) ( x0 + 2 ), (float) ( x0 + 3 ) );
+        __m128  four   = _mm_set1_ps( 4.0f );
+        __m128  zero   = _mm_setzero_ps( );
+        __m128  scale  = _mm_set1_ps( 256.0f );
+        __m128  uc4    = _mm_set1_ps( uc ), uk4 = _mm_set1_ps( uk );
+        __m128  vc4    = _mm_set1_ps( vc ), vk4 = _mm_set1_ps( vk );
+        __m128  wc4    = _mm_set1_ps( wc ), wk4 = _mm_set1_ps( wk );
+        __m128  maxU4  = _mm_set1_ps( maxU );
+        __m128  maxV4  = _mm_set1_ps( maxV );
+        __m128i maxX4  = _mm_set1_epi32( params->MaxX );
+        __m128i maxY4  = _mm_set1_epi32( params->MaxY );
+        __m128i one4   = _mm_set1_epi32( 1 );
+        __m128  w, u, v;
+        __m128i ix, iy;
+
+        // the block arrays are big enough to calculate the last incomplete group of 4 pixels as well
+        for ( ; i < count; i += 4 )
+        {
+            w = _mm_add_ps( wc4, _mm_mul_ps( wk4, xs ) );
+            u = _mm_div_ps( _mm_add_ps( uc4, _mm_mul_ps( uk4, xs ) ), w );
+            v = _mm_div_ps( _mm_add_ps( vc4, _mm_mul_ps( vk4, xs ) ), w );
+
+            // clamp coordinates to the image (NaNs turn into zeros, since the second operand is returned for them)
+            u = _mm_min_ps( _mm_max_ps( u, zero ), maxU4 );
+            v = _mm_min_ps( _mm_max_ps( v, zero ), maxV4 );
+
+            // the last column/row is interpolated as the previous one with full weight of the next pixel
+            ix = _mm_cvttps_epi32( u );
+            iy = _mm_cvttps_epi32( v );
+            ix = _mm_sub_epi32( ix, _mm_and_si128( _mm_cmpgt_epi32( ix, maxX4 ), one4 ) );
+            iy = _mm_sub_epi32( iy, _mm_and_si128( _mm_cmpgt_epi32( iy, maxY4 ), one4 ) );
+
+            _mm_storeu_si128( (__m128i*) &block->X[i], ix );
+            _mm_storeu_si128( (__m128i*) &block->Y[i], iy );
+            _mm_storeu_si128( (__m128i*) &block->Wx[i], _mm_cvttps_epi32( _mm_mul_ps( _mm_sub_ps( u, _mm_cvtepi32_ps( ix ) ), scale ) ) );
+            _mm_storeu_si128( (__m128i*) &block->Wy[i], _mm_cvttps_epi32( _mm_mul_ps( _mm_sub_ps( v, _mm_cvtepi32_ps( iy ) ), scale ) ) );
+
+            xs = _mm_add_ps( xs, four );
+        }
+    }
+    else
+    {
+        for ( ; i < count; i++ )
+        {
+            float x = (float) ( x0 + i );
+            float w = wc + wk * x;
+            float u = ( uc + uk * x ) / w;
+            float v = ( vc + vk * x ) / w;
+            int   ix, iy;
+
+            u = ( u > 0 ) ? XMIN( u, maxU ) : 0.0f;
+            v = ( v > 0 ) ? XMIN( v, maxV ) : 0.0f;
+
+            ix = XMIN( (int) u, params->MaxX );
+            iy = XMIN( (int) v, params->MaxY );
+
+            block->X[i]  = ix;
+            block->Y[i]  = iy;
+            block->Wx[i] = (int) ( ( u - ix ) * 256 );
+            block->Wy[i] = (int) ( ( v - iy ) * 256 );
+        }
+    }
+}
+
+// Copy nearest source pixels for a block of destination pixels
+static void SampleBlockNearest( const WarpParams* params, const WarpBlock* block, int count, uint8_t* dstPtr )
+{
+    const uint8_t* srcPtr    = params->SrcPtr;
+    int            srcStride = params->SrcStride;
+    int            pixelSize = params->PixelSize;
+    int            i;
+
+    // weight of 256 means the right/bottom pixel is the nearest one
+    if ( pixelSize == 1 )
+    {
+        for ( i = 0; i < count; i++ )
+        {
+            dstPtr[i] = srcPtr[( block->Y[i] + ( block->Wy[i] >> 8 ) ) * srcStride + block->X[i] + ( block->Wx[i] >> 8 )];
+        }
+    }
+    else if ( pixelSize == 3 )
+    {
+        for ( i = 0; i < count; i++, dstPtr += 3 )
+        {
+            const uint8_t* p = srcPtr + ( block->Y[i] + ( block->Wy[i] >> 8 ) ) * srcStride + ( block->X[i] + ( block->Wx[i] >> 8 ) ) * 3;
+
+            dstPtr[0] = p[0];
+            dstPtr[1] = p[1];
+            dstPtr[2] = p[2];
+        }
+    }
+    else
+    {
+        for ( i = 0; i < count; i++, dstPtr += 4 )
+        {
+            *( (uint32_t*) dstPtr ) = *( (const uint32_t*) ( srcPtr + ( block->Y[i] + ( block->Wy[i] >> 8 ) ) * srcStride + ( block->X[i] + ( block->Wx[i] >> 8 ) ) * 4 ) );
+        }
+    }
+}
+
+// Interpolate single channel of a pixel
+#define INTERPOLATE( p1, p3, c ) \
+    (uint8_t) ( ( ( p1[c] * wx1 + p1[c + xStep] * wx ) * wy1 + ( p3[c] * wx1 + p3[c + xStep] * wx ) * wy ) >> 16 )
+
+// Interpolate source pixels for a block of destination pixels
+static void SampleBlockBilinear( const WarpParams* params, const WarpBlock* block, int count, uint8_t* dstPtr )
+{
+    const uint8_t* srcPtr    = params->SrcPtr;
+    int            srcStride = params->SrcStride;
+    int            pixelSize = params->PixelSize;
+    int            xStep     = params->XStep;
+    int            yStep     = params->YStep;
+    int            i;
+
+    if ( ( params->UseSse ) && ( pixelSize == 4 ) && ( xStep == 4 ) )
+    {
+        __m128i zero = _mm_setzero_si128( );
+
+        // both pixels of a row are loaded at once, interpolated vertically with 16 bit precision
+        // and then horizontally using multiply-add of the left/right channel values' pairs
+        for ( i = 0; i < count; i++, dstPtr += 4 )
+        {
+            const uint8_t* p1     = srcPtr + block->Y[i] * srcStride + block->X[i] * 4;
+            uint32_t       wx     = (uint32_t) block->Wx[i];
+            uint32_t       wy     = (uint32_t) block->Wy[i];
+            __m128i        top    = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i*) p1 ), zero );
+            __m128i        bottom = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i*) ( p1 + yStep ) ), zero );
+            __m128i        v;
+
+            v = _mm_add_epi16( _mm_mullo_epi16( top,    _mm_set1_epi16( (short) ( 256 - wy ) ) ),
+                               _mm_mullo_epi16( bottom, _mm_set1_epi16( (short) wy ) ) );
+            v = _mm_srli_epi16( v, 1 );
+            v = _mm_unpacklo_epi16( v, _mm_srli_si128( v, 8 ) );
+            v = _mm_srli_epi32( _mm_madd_epi16( v, _mm_set1_epi32( (int) ( ( 256 - wx ) | ( wx << 16 ) ) ) ), 15 );
+            v = _mm_packus_epi16( _mm_packs_epi32( v, v ), v );
+
+            *( (uint32_t*) dstPtr ) = (uint32_t) _mm_cvtsi128_si32( v );
+        }
+    }
+    else
+    {
+        for ( i = 0; i < count; i++, dstPtr += pixelSize )
+        {
+            const uint8_t* p1  = srcPtr + block->Y[i] * srcStride + block->X[i] * pixelSize;
+            const uint8_t* p3  = p1 + yStep;
+            uint32_t       wx  = (uint32_t) block->Wx[i];
+            uint32_t       wy  = (uint32_t) block->Wy[i];
+            uint32_t       wx1 = 256 - wx;
+            uint32_t       wy1 = 256 - wy;
+
+            dstPtr[0] = INTERPOLATE( p1, p3, 0 );
+
+            if ( pixelSize != 1 )
+            {
+                dstPtr[1] = INTERPOLATE( p1, p3, 1 );
+                dstPtr[2] = INTERPOLATE( p1, p3, 2 );
+
+                if ( pixelSize == 4 )
+                {
+                    dstPtr[3] = INTERPOLATE( p1, p3, 3 );
+                }
+            }
+        }
+    }
+}
+
+#undef INTERPOLATE
+
+// Warp single row of destination image
+static void WarpRow( const WarpParams* params, uint8_t* dstRow, int y, int x1, int x2 )
+{
+    const uint8_t* fillValues = params->FillValues;
+    int            pixelSize  = params->PixelSize;
+    int            spans[3][2];
+    int            spansCount = 0;
+    int            fillFrom   = x1;
+    int            s, x, i;
+    WarpBlock      block;
+
+    // pixels mapped inside of source image make at most one span for each sign of the transformation's denominator
+    for ( s = 0; s < ( ( params->IsAffine ) ? 1 : 2 ); s++ )
+    {
+        int first = x1, last = x2;
+
+        FindRowSpan( params, y, ( s == 0 ) ? 1.0 : -1.0, &first, &last );
+
+        if ( first <= last )
+        {
+            spans[spansCount][0] = first;
+            spans[spansCount][1] = last;
+            spansCount++;
+        }
+    }
+
+    if ( ( spansCount == 2 ) && ( spans[1][0] < spans[0][0] ) )
+    {
+        int t0 = spans[0][0], t1 = spans[0][1];
+
+        spans[0][0] = spans[1][0]; spans[0][1] = spans[1][1];
+        spans[1][0] = t0;          spans[1][1] = t1;
+    }
+
+    // add a zero length span after the row, so the remaining pixels get filled
+    spans[spansCount][0] = x2 + 1;
+    spans[spansCount][1] = x2;
+
+    for ( s = 0; s <= spansCount; s++ )
+    {
+        // fill pixels before the span
+        if ( fillValues != 0 )
+        {
+            uint8_t* dstPtr = dstRow + fillFrom * pixelSize;
+
+            for ( x = fillFrom; x < spans[s][0]; x++ )
+            {
+                for ( i = 0; i < pixelSize; i++, dstPtr++ )
+                {
+                    *dstPtr = fillValues[i];
+                }
+            }
+        }
+
+        // warp the span block by block
+        for ( x = spans[s][0]; x <= spans[s][1]; x += BLOCK_SIZE )
+        {
+            int count = XMIN( BLOCK_SIZE, spans[s][1] - x + 1 );
+
+            if ( params->IsAffine )
+            {
+                CalculateAffineBlock( params, y, x, count, &block );
+            }
+            else
+            {
+                CalculateProjectiveBlock( params, y, x, count, &block );
+            }
+
+            if ( params->Interpolate )
+            {
+                SampleBlockBilinear( params, &block, count, dstRow + x * pixelSize );
+            }
+            else
+            {
+                SampleBlockNearest( params, &block, count, dstRow + x * pixelSize );
+            }
+        }
+
+        fillFrom = spans[s][1] + 1;
+    }
+}
@@ -31,6 +31,7 @@ extern "C" {
 #include <xtypes.h>
 #include <ximage.h>
 #include <xhistogram.h>
+#include <xmath.h>
 
 // Structure defining HSL components
 typedef struct _hsl
@@ -107,8 +108,18 @@ XErrorCode GrayscaleToColor( const ximage* src, ximage* dst );
 XErrorCode DesaturateColorImage( ximage* src );
 // Converts source 1 bpp binary image into grayscale
 XErrorCode BinaryToGrayscale( const ximage* src, ximage* dst );
+// Converts grayscale image into 1 bpp binary image (non zero pixels are set to 1)
+XErrorCode GrayscaleToBinary( const ximage* src, ximage* dst );
 // Converts source indexed image to color 32 bpp image
 XErrorCode IndexedToColor( const ximage* src, ximage* dst );
+// Converts planar YUV 4:2:0 image (YUV420/NV12) to 24/32 bpp color image
+XErrorCode YUVToColor( const ximage* src, ximage* dst );
+// Converts 24/32 bpp color image to planar YUV 4:2:0 image (YUV420/NV12)
+XErrorCode ColorToYUV( const ximage* src, ximage* dst );
+// Copies luminance plane of planar YUV 4:2:0 image (YUV420/NV12) into 8 bpp grayscale image
+XErrorCode YUVToGrayscale( const ximage* src, ximage* dst );
+// Sets chroma planes of planar YUV 4:2:0 image (YUV420/NV12) to neutral value, so the image becomes grayscale
+XErrorCode DesaturateYUVImage( ximage* src );
 // Applies threshold to the image's data (>= threshold)
 XErrorCode ThresholdImage( ximage* src, uint16_t threshold );
 // Inverts the specified image
@@ -128,10 +139,21 @@ XErrorCode SwapRedBlueCopy( const ximage* src, ximage* dst );
 // Performs gray world normalization filter. It calculate first mean values of each RGB channel and a global mean.
 // The it updates all pixel value multiplying them with next coefficients: mean/redMean, mean/greenMean, mean/blueMean
 XErrorCode GrayWorldNormalization( ximage* src );
+// Performs gray world normalization filter using already calculated RGB histograms of the image
+XErrorCode GrayWorldNormalizationUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                                  const xhistogram* greenHistogram, const xhistogram* blueHistogram );
 // Contrast stretching image processing filter
 XErrorCode ContrastStretching( ximage* src );
+// Contrast stretching image processing filter, which uses already calculated histograms of the image
+// (for grayscale images only the first histogram is used)
+XErrorCode ContrastStretchingUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                              const xhistogram* greenHistogram, const xhistogram* blueHistogram );
 // Histogram equalization image processing filter
 XErrorCode HistogramEqualization( ximage* src );
+// Histogram equalization image processing filter, which uses already calculated histograms of the image
+// (for grayscale images only the first histogram is used)
+XErrorCode HistogramEqualizationUsingHistograms( ximage* src, const xhistogram* redHistogram,
+                                                 const xhistogram* greenHistogram, const xhistogram* blueHistogram );
 // Re-color 8bpp grayscale image into 24 bpp color image by mapping grayscale values to gradient between the specified two colors
 XErrorCode GradientGrayscaleReColoring( const ximage* src, ximage* dst, xargb startColor, xargb endColor );
 // Re-color 8bpp grayscale image into 24 bpp color image by mapping grayscale values to two gradients between the specified three colors
@@ -169,10 +191,21 @@ XErrorCode HslColorFiltering( ximage* src, xhsl minValues, xhsl maxValues, bool
 // Remove colors outside/inside of the specified HSV range
 XErrorCode HsvColorFiltering( ximage* src, xhsv minValues, xhsv maxValues, bool fillOutside, xargb fillColor );
 
+// Size (in bytes) of color classification map - one bit for each 24 bpp RGB color telling if it belongs to a class
+#define XCOLOR_CLASS_MAP_SIZE ( ( 1 << 24 ) / 8 )
+
+// Build color classification map for the specified HSL range
+XErrorCode BuildHslColorClassMap( uint8_t* colorClassMap, xhsl minValues, xhsl maxValues );
+// Build color classification map for the specified HSV range
+XErrorCode BuildHsvColorClassMap( uint8_t* colorClassMap, xhsv minValues, xhsv maxValues );
+// Remove colors outside/inside of the class defined by color classification map (doing no color space conversion per pixel)
+XErrorCode ColorClassFiltering( ximage* src, const uint8_t* colorClassMap, bool fillOutside, xargb fillColor );
+
 // ===== 2 source image processing routines =====
 
 // Apply mask to an image by setting its pixels to fill color if corresponding pixels of the mask have 0 value
 // and fillOnZero is set to xtrue. If fillOnZero is set to xfalse, then filling happens if mask has non zero value.
+// 8 bpp grayscale mask is used for grayscale/color images, 1 bpp binary mask is used for 1 bpp binary images.
 XErrorCode MaskImage( ximage* image, const ximage* mask, xargb fillColor, bool fillOnZero );
 // Merge two images by applying MAX operator for every pair of pixels (result is put back to image1)
 XErrorCode MergeImages( ximage* image1, const ximage* image2 );
@@ -227,11 +260,11 @@ enum
 };
 typedef uint8_t XHitAndMissMode;
 
-// 3x3 erosion filter for grayscale images containing only black (0) and white (255) pixels
+// 3x3 erosion filter for grayscale images containing only black (0) and white (255) pixels (or 1 bpp binary images)
 XErrorCode BinaryErosion3x3( const ximage* src, ximage* dst );
 // 3x3 erosion filter with square structuring element
 XErrorCode Erosion3x3( const ximage* src, ximage* dst );
-// 3x3 dilatation filter for grayscale images containing only black (0) and white (255) pixels
+// 3x3 dilatation filter for grayscale images containing only black (0) and white (255) pixels (or 1 bpp binary images)
 XErrorCode BinaryDilatation3x3( const ximage* src, ximage* dst );
 // 3x3 dilatation filter with square structuring element
 XErrorCode Dilatation3x3( const ximage* src, ximage* dst );
@@ -256,6 +289,8 @@ XErrorCode Dilatation( const ximage* src, ximage* dst, int8_t* se, uint32_t seSi
 // se (structuring element) is array of seSize*seSize (1 is for foreground/object, 0 - background, -1 - to ignore)
 // mode is the Hit-and-Miss to use
 //
+// Supports 8 bpp grayscale images containing only black (0) and white (255) pixels and 1 bpp binary images.
+//
 XErrorCode HitAndMiss( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize, XHitAndMissMode mode );
 
 // Erode horizontal edges in grayscale images - pixels, which are not connected to 3 neighbours above or below
@@ -264,15 +299,47 @@ XErrorCode ErodeHorizontalEdges( const ximage* src, ximage* dst );
 // Erode vertical edges in grayscale images - pixels, which are not connected to 3 neighbours on the left or right
 XErrorCode ErodeVerticalEdges( const ximage* src, ximage* dst );
 
+// ===== Bit-packed binary images (XPixelFormatBinary1), processing 64 pixels at a time =====
+
+// 3x3 erosion filter for binary images (edge pixels are set to 0)
+XErrorCode BinaryImageErosion3x3( const ximage* src, ximage* dst );
+// 3x3 dilatation filter for binary images
+XErrorCode BinaryImageDilatation3x3( const ximage* src, ximage* dst );
+// Applies hit-and-miss morphological operator to binary image (see HitAndMiss() for parameters)
+XErrorCode BinaryImageHitAndMiss( const ximage* src, ximage* dst, int8_t* se, uint32_t seSize, XHitAndMissMode mode );
+// Perform logic AND of two binary images (result is put back to image1)
+XErrorCode BinaryImageAnd( ximage* image1, const ximage* image2 );
+// Perform logic OR of two binary images (result is put back to image1)
+XErrorCode BinaryImageOr( ximage* image1, const ximage* image2 );
+// Perform logic XOR of two binary images (result is put back to image1)
+XErrorCode BinaryImageXor( ximage* image1, const ximage* image2 );
+// Invert binary image
+XErrorCode BinaryImageNot( ximage* image );
+// Count number of set pixels in binary image
+XErrorCode BinaryImagePopulationCount( const ximage* image, uint32_t* count );
+
 // Prepare structuring element of the specified type
 XErrorCode FillMorphologicalStructuringElement( int8_t* se, uint32_t seSize, XStructuringElementType type );
 
+// Calculates exact Euclidean distance transformation of a binary image. If backgroundDistance is false, the distance map
+// contains distance from every object (non zero) pixel to the nearest background pixel (pixels outside of image are treated
+// as background). Otherwise it contains distance from every background pixel to the nearest object pixel.
+//
+// The dst map can be 16 bpp grayscale image (rounded distance), 32 bpp grayscale image (squared distance) or
+// GrayscaleR4 image (distance as float). If there are no pixels to measure distance to, the map is set to max(width, height)
+// (or 0xFFFFFFFF for squared distance).
+//
+// The optional nearestFeatures is 32 bpp grayscale image receiving index (y * width + x) of the nearest pixel the
+// distance is measured to, or 0xFFFFFFFF if it is outside of image or there is none.
+//
+XErrorCode EuclideanDistanceTransformation( const ximage* src, ximage* dst, ximage* nearestFeatures, bool backgroundDistance );
+
 // Calculates distance transformation of a binary image, which represents a distance map -
-// shortest distance from non-background pixel to object's edge.
+// shortest distance from non-background pixel to object's edge (16 bpp map of rounded Euclidean distances).
 XErrorCode DistanceTransformation( const ximage* src, ximage* dst );
 
 // Calculates distance transformation of background in a binary image, which represents a distance map -
-// shortest distance from background pixel to an object.
+// shortest distance from background pixel to an object (16 bpp map of rounded Euclidean distances).
 XErrorCode BackgroundDistanceTransformation( const ximage* src, ximage* dst );
 
 // Removes specified amount of objects' edges in a segmented grayscale image
@@ -335,8 +402,12 @@ XErrorCode ConvolutionEx( const ximage* src, ximage* dst, const float* kernel, u
 
 // Calculate optimal threshold for grayscale image using Otsu algorithm
 XErrorCode CalculateOtsuThreshold( const ximage* src, uint16_t* threshold );
+// Calculate optimal threshold using Otsu algorithm from already calculated histogram of grayscale image
+XErrorCode CalculateOtsuThresholdFromHistogram( const xhistogram* grayHistogram, uint16_t* threshold );
 // Apply Otsu thresholding to an image
 XErrorCode OtsuThresholding( ximage* image );
+// Apply Otsu thresholding to an image using its already calculated histogram
+XErrorCode OtsuThresholdingUsingHistogram( ximage* image, const xhistogram* grayHistogram );
 
 // ===== Color reduction =====
 
@@ -433,6 +504,10 @@ XErrorCode RotateImageBilinear( const ximage* src, ximage* dst, float angle, xar
 // Calculate image size for a rotated image, so it fit into the new size
 XErrorCode CalculateRotatedImageSize( int32_t width, int32_t height, float angle, int32_t* newWidth, int32_t* newHeight );
 
+// Warp source image into the specified rectangle of destination image using projective transformation, which maps destination
+// coordinates into source image. Pixels mapped outside of source image are filled with the specified color or left untouched if it is NULL.
+XErrorCode WarpImage( const ximage* src, ximage* dst, const xmatrix3* transform, xrect dstRect, bool interpolate, const xargb* fillColor );
+
 // Embed source image into target using the specified 4 quadrilateral points
 XErrorCode EmbedQuadrilateral( ximage* target, const ximage* source, const xpoint* targetQuadrilateral, bool interpolate );
 // Extract specified quadrilateral from source image into target (the target's image size specifies the result size)
@@ -495,6 +570,8 @@ XErrorCode CalculateHeatGradientColorMap( uint8_t* redMap, uint8_t* greenMap, ui
 XErrorCode GetColorImageHistograms( const ximage* image, xhistogram* redHistogram, xhistogram* greenHistogram, xhistogram* blueHistogram );
 // Calculate intensity histogram for 8 bpp grayscale image
 XErrorCode GetGrayscaleImageHistogram( const ximage* image, xhistogram* histogram );
+// Calculate histograms of 8 bpp grayscale image (one histogram) or 24/32 bpp color image (red, green and blue histograms)
+XErrorCode GetImageHistograms( const ximage* image, xhistogram* histograms );
 
 // ===== Blob counting/processing functions =====
 
@@ -613,6 +690,14 @@ XErrorCode Rgb2Hsv( const xargb* rgb, xhsv* hsv );
 // Convert HSV color to RGB
 XErrorCode Hsv2Rgb( const xhsv* hsv, xargb* rgb );
 
+// ===== Parallel processing =====
+
+// Set number of threads used by image processing routines called from the current thread (0 - one per CPU).
+// Allows several threads doing image processing at the same time to share CPUs instead of each using all of them.
+void XImagingSetThreadsCount( uint32_t threadsCount );
+// Get number of threads used by image processing routines called from the current thread
+uint32_t XImagingGetThreadsCount( void );
+
 
 #ifdef __cplusplus
 }
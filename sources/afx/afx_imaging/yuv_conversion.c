@@ -0,0 +1,276 @@
+/*
+    Imaging library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <string.h>
+#include "ximaging.h"
+
+// Conversion uses ITU-R BT.601 coefficients with limited range YUV (Y in [16, 235], U/V in [16, 240]),
+// which is what most cameras and video decoders provide. Coefficients are pre-multiplied by 256.
+
+// forward declaration ----
+static void GetChromaPlanes( const ximage* image, uint8_t** uPlane, uint8_t** vPlane, int* chromaStride, int* chromaStep );
+// ------------------------
+
+// Clamp value to [0, 255] range
+static uint8_t ClampToByte( int value )
+{
+    return (uint8_t) ( ( value < 0 ) ? 0 : ( ( value > 255 ) ? 255 : value ) );
+}
+
+// Converts planar YUV 4:2:0 image (YUV420/NV12) to 24/32 bpp color image
+XErrorCode YUVToColor( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( XImageIsPixelFormatPlanar( src->format ) == false ) ||
+              ( ( dst->format != XPixelFormatRGB24 ) && ( dst->format != XPixelFormatRGBA32 ) ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width != dst->width ) || ( src->height != dst->height ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int width        = src->width;
+        int height       = src->height;
+        int srcStride    = src->stride;
+        int dstStride    = dst->stride;
+        int pixelSize    = ( dst->format == XPixelFormatRGB24 ) ? 3 : 4;
+        uint8_t* srcPtr  = src->data;
+        uint8_t* dstPtr  = dst->data;
+        uint8_t* uPlane;
+        uint8_t* vPlane;
+        int chromaStride, chromaStep;
+        int y;
+
+        GetChromaPlanes( src, &uPlane, &vPlane, &chromaStride, &chromaStep );
+
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, uPlane, vPlane, width, srcStride, dstStride, pixelSize, chromaStride, chromaStep )
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* yRow = srcPtr + y * srcStride;
+            const uint8_t* uRow = uPlane + ( y >> 1 ) * chromaStride;
+            const uint8_t* vRow = vPlane + ( y >> 1 ) * chromaStride;
+            uint8_t*       dstRow = dstPtr + y * dstStride;
+            int x;
+
+            for ( x = 0; x < width; x++, dstRow += pixelSize )
+            {
+                int cy = ( yRow[x] - 16 ) * 298;
+                int cu = uRow[( x >> 1 ) * chromaStep] - 128;
+                int cv = vRow[( x >> 1 ) * chromaStep] - 128;
+
+                dstRow[RedIndex]   = ClampToByte( ( cy + 409 * cv + 128 ) >> 8 );
+                dstRow[GreenIndex] = ClampToByte( ( cy - 100 * cu - 208 * cv + 128 ) >> 8 );
+                dstRow[BlueIndex]  = ClampToByte( ( cy + 516 * cu + 128 ) >> 8 );
+            }
+
+            if ( pixelSize == 4 )
+            {
+                dstRow = dstPtr + y * dstStride;
+
+                for ( x = 0; x < width; x++, dstRow += 4 )
+                {
+                    dstRow[AlphaIndex] = NotTransparent8bpp;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Converts 24/32 bpp color image to planar YUV 4:2:0 image (YUV420/NV12)
+XErrorCode ColorToYUV( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( ( src->format != XPixelFormatRGB24 ) && ( src->format != XPixelFormatRGBA32 ) ) ||
+              ( XImageIsPixelFormatPlanar( dst->format ) == false ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width != dst->width ) || ( src->height != dst->height ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int width        = src->width;
+        int height       = src->height;
+        int chromaWidth  = ( width  + 1 ) / 2;
+        int chromaHeight = ( height + 1 ) / 2;
+        int srcStride    = src->stride;
+        int dstStride    = dst->stride;
+        int pixelSize    = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+        uint8_t* srcPtr  = src->data;
+        uint8_t* dstPtr  = dst->data;
+        uint8_t* uPlane;
+        uint8_t* vPlane;
+        int chromaStride, chromaStep;
+        int cy;
+
+        GetChromaPlanes( dst, &uPlane, &vPlane, &chromaStride, &chromaStep );
+
+        // each iteration handles two lines of luminance and one line of chroma
+        #pragma omp parallel for schedule(static) shared( srcPtr, dstPtr, uPlane, vPlane, width, height, chromaWidth, srcStride, dstStride, pixelSize, chromaStride, chromaStep )
+        for ( cy = 0; cy < chromaHeight; cy++ )
+        {
+            int      y1     = cy * 2;
+            int      y2     = ( y1 + 1 < height ) ? y1 + 1 : y1;
+            uint8_t* srcRow1 = srcPtr + y1 * srcStride;
+            uint8_t* srcRow2 = srcPtr + y2 * srcStride;
+            uint8_t* yRow1   = dstPtr + y1 * dstStride;
+            uint8_t* yRow2   = dstPtr + y2 * dstStride;
+            uint8_t* uRow    = uPlane + cy * chromaStride;
+            uint8_t* vRow    = vPlane + cy * chromaStride;
+            int      x;
+
+            for ( x = 0; x < width; x++ )
+            {
+                uint8_t* p1 = srcRow1 + x * pixelSize;
+                uint8_t* p2 = srcRow2 + x * pixelSize;
+
+                yRow1[x] = (uint8_t) ( ( ( 66 * p1[RedIndex] + 129 * p1[GreenIndex] + 25 * p1[BlueIndex] + 128 ) >> 8 ) + 16 );
+                yRow2[x] = (uint8_t) ( ( ( 66 * p2[RedIndex] + 129 * p2[GreenIndex] + 25 * p2[BlueIndex] + 128 ) >> 8 ) + 16 );
+            }
+
+            for ( x = 0; x < chromaWidth; x++ )
+            {
+                int x1 = x * 2;
+                int x2 = ( x1 + 1 < width ) ? x1 + 1 : x1;
+                // average color of 2x2 block
+                int r  = ( srcRow1[x1 * pixelSize + RedIndex]   + srcRow1[x2 * pixelSize + RedIndex] +
+                           srcRow2[x1 * pixelSize + RedIndex]   + srcRow2[x2 * pixelSize + RedIndex]   + 2 ) >> 2;
+                int g  = ( srcRow1[x1 * pixelSize + GreenIndex] + srcRow1[x2 * pixelSize + GreenIndex] +
+                           srcRow2[x1 * pixelSize + GreenIndex] + srcRow2[x2 * pixelSize + GreenIndex] + 2 ) >> 2;
+                int b  = ( srcRow1[x1 * pixelSize + BlueIndex]  + srcRow1[x2 * pixelSize + BlueIndex] +
+                           srcRow2[x1 * pixelSize + BlueIndex]  + srcRow2[x2 * pixelSize + BlueIndex]  + 2 ) >> 2;
+
+                uRow[x * chromaStep] = (uint8_t) ( ( ( -38 * r -  74 * g + 112 * b + 128 ) >> 8 ) + 128 );
+                vRow[x * chromaStep] = (uint8_t) ( ( ( 112 * r -  94 * g -  18 * b + 128 ) >> 8 ) + 128 );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Copies luminance plane of planar YUV 4:2:0 image (YUV420/NV12) into 8 bpp grayscale image
+XErrorCode YUVToGrayscale( const ximage* src, ximage* dst )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( XImageIsPixelFormatPlanar( src->format ) == false ) || ( dst->format != XPixelFormatGrayscale8 ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        ximage* lumaPlane = 0;
+
+        ret = XImageGetPlane( src, &lumaPlane, 0 );
+
+        if ( ret == SuccessCode )
+        {
+            ret = XImageCopyData( lumaPlane, dst );
+        }
+
+        XImageFree( &lumaPlane );
+    }
+
+    return ret;
+}
+
+// Sets chroma planes of planar YUV 4:2:0 image (YUV420/NV12) to neutral value, so the image becomes grayscale
+XErrorCode DesaturateYUVImage( ximage* src )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( src == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( XImageIsPixelFormatPlanar( src->format ) == false )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        uint32_t planesCount = XImageGetPlanesCount( src->format );
+        uint32_t plane;
+
+        for ( plane = 1; ( plane < planesCount ) && ( ret == SuccessCode ); plane++ )
+        {
+            ximage* chromaPlane = 0;
+            int     y;
+
+            ret = XImageGetPlane( src, &chromaPlane, plane );
+
+            if ( ret == SuccessCode )
+            {
+                for ( y = 0; y < chromaPlane->height; y++ )
+                {
+                    memset( chromaPlane->data + y * chromaPlane->stride, 128, chromaPlane->width );
+                }
+            }
+
+            XImageFree( &chromaPlane );
+        }
+    }
+
+    return ret;
+}
+
+// Get pointers to chroma planes of YUV420/NV12 image, their stride and distance between chroma samples of a line
+void GetChromaPlanes( const ximage* image, uint8_t** uPlane, uint8_t** vPlane, int* chromaStride, int* chromaStep )
+{
+    uint8_t* chroma = image->data + image->height * image->stride;
+
+    if ( image->format == XPixelFormatYUV420 )
+    {
+        *chromaStride = image->stride / 2;
+        *chromaStep   = 1;
+        *uPlane       = chroma;
+        *vPlane       = chroma + ( ( image->height + 1 ) / 2 ) * ( *chromaStride );
+    }
+    else
+    {
+        *chromaStride = image->stride;
+        *chromaStep   = 2;
+        *uPlane       = chroma;
+        *vPlane       = chroma + 1;
+    }
+}
@@ -33,8 +33,20 @@ XErrorCode XImageAllocateTextureRaw( int32_t width, int32_t height, ximage** tex
     return XImageAllocateRaw( width, height, XPixelFormatGrayscale8, texture );
 }
 
+// Build table of 16.16 fixed point multipliers for every texture value
+static void BuildTextureMultipliers( uint32_t* multipliers, float amountToKeep, uint8_t textureBaseLevel )
+{
+    float amountToUse = 1.0f - amountToKeep;
+    int   i;
+
+    for ( i = 0; i < 256; i++ )
+    {
+        multipliers[i] = (uint32_t) ( ( amountToKeep + amountToUse * ( (float) i / textureBaseLevel ) ) * 65536.0f + 0.5f );
+    }
+}
+
 // Apply the specified texture to the 8 bpp grayscale image
-static void XImageApplyTexture8( const ximage* texture, ximage* image, float amountToKeep, uint8_t textureBaseLevel )
+static void XImageApplyTexture8( const ximage* texture, ximage* image, const uint32_t* multipliers )
 {
     int         width       = image->width;
     int         height      = image->height;
@@ -43,34 +55,25 @@ static void XImageApplyTexture8( const ximage* texture, ximage* image, float amo
     uint8_t*    imgPtr      = image->data;
     uint8_t*    txtPtr      = texture->data;
     int         y;
-    float       anoutToUse  = 1.0f - amountToKeep;
-    float       textureBase = (float) textureBaseLevel;
 
-    #pragma omp parallel for schedule(static) shared( imgPtr, txtPtr, width, imgStride, txtStride, amountToKeep, anoutToUse, textureBase )
+    #pragma omp parallel for schedule(static) shared( imgPtr, txtPtr, width, imgStride, txtStride, multipliers )
     for ( y = 0; y < height; y++ )
     {
         uint8_t* imgRow = imgPtr + y * imgStride;
         uint8_t* txtRow = txtPtr + y * txtStride;
-        float    value;
+        uint32_t value;
         int      x;
 
         for ( x = 0; x < width; x++ )
         {
-            value = ( amountToKeep * *imgRow ) + ( anoutToUse * *imgRow ) * ( (float) *txtRow / textureBase );
-            if ( value > 255 )
-            {
-                value = 255;
-            }
-            *imgRow = (uint8_t) value;
-
-            imgRow++;
-            txtRow++;
+            value = ( imgRow[x] * multipliers[txtRow[x]] ) >> 16;
+            imgRow[x] = (uint8_t) XMIN( value, 255 );
         }
     }
 }
 
 // Apply the specified texture to the 24/32 bpp color image
-static void XImageApplyTexture24( const ximage* texture, ximage* image, float amountToKeep, uint8_t textureBaseLevel )
+static void XImageApplyTexture24( const ximage* texture, ximage* image, const uint32_t* multipliers )
 {
     int         width       = image->width;
     int         height      = image->height;
@@ -80,51 +83,30 @@ static void XImageApplyTexture24( const ximage* texture, ximage* image, float am
     uint8_t*    imgPtr      = image->data;
     uint8_t*    txtPtr      = texture->data;
     int         y;
-    float       anoutToUse  = 1.0f - amountToKeep;
-    float       textureBase = (float) textureBaseLevel;
 
-    #pragma omp parallel for schedule(static) shared( imgPtr, txtPtr, width, imgStride, txtStride, pixelSize, amountToKeep, anoutToUse, textureBase )
+    #pragma omp parallel for schedule(static) shared( imgPtr, txtPtr, width, imgStride, txtStride, pixelSize, multipliers )
     for ( y = 0; y < height; y++ )
     {
         uint8_t* imgRow = imgPtr + y * imgStride;
         uint8_t* txtRow = txtPtr + y * txtStride;
         int      x;
-        float    txtCoef;
-        float    value;
+        uint32_t multiplier;
+        uint32_t value;
 
         for ( x = 0; x < width; x++ )
         {
-            txtCoef = (float) *txtRow / textureBase;
-
-            // red
-            value = ( amountToKeep * imgRow[RedIndex] ) +
-                    ( anoutToUse * imgRow[RedIndex] * txtCoef );
-            if ( value > 255 )
-            {
-                value = 255;
-            }
-            imgRow[RedIndex] = (uint8_t) value;
-
-            // green
-            value = ( amountToKeep * imgRow[GreenIndex] ) +
-                    ( anoutToUse * imgRow[GreenIndex] * txtCoef );
-            if ( value > 255 )
-            {
-                value = 255;
-            }
-            imgRow[GreenIndex] = (uint8_t) value;
-
-            // blue
-            value = ( amountToKeep * imgRow[BlueIndex] ) +
-                    ( anoutToUse * imgRow[BlueIndex] * txtCoef );
-            if ( value > 255 )
-            {
-                value = 255;
-            }
-            imgRow[BlueIndex] = (uint8_t) value;
+            multiplier = multipliers[txtRow[x]];
+
+            value = ( imgRow[RedIndex] * multiplier ) >> 16;
+            imgRow[RedIndex] = (uint8_t) XMIN( value, 255 );
+
+            value = ( imgRow[GreenIndex] * multiplier ) >> 16;
+            imgRow[GreenIndex] = (uint8_t) XMIN( value, 255 );
+
+            value = ( imgRow[BlueIndex] * multiplier ) >> 16;
+            imgRow[BlueIndex] = (uint8_t) XMIN( value, 255 );
 
             imgRow += pixelSize;
-            txtRow++;
         }
     }
 }
@@ -152,15 +134,19 @@ XErrorCode XImageApplyTexture( const ximage* texture, ximage* image, float amoun
     }
     else
     {
+        uint32_t multipliers[256];
+
+        BuildTextureMultipliers( multipliers, amountToKeep, textureBaseLevel );
+
         switch ( image->format )
         {
         case XPixelFormatGrayscale8:
-            XImageApplyTexture8( texture, image, amountToKeep, textureBaseLevel );
+            XImageApplyTexture8( texture, image, multipliers );
             break;
 
         case XPixelFormatRGB24:
         case XPixelFormatRGBA32:
-            XImageApplyTexture24( texture, image, amountToKeep, textureBaseLevel );
+            XImageApplyTexture24( texture, image, multipliers );
             break;
 
         default:
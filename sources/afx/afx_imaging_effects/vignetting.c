@@ -22,10 +22,13 @@
 #include <math.h>
 #include "ximaging_effects.h"
 
+// Mask value, which corresponds to keeping pixel as is
+#define MASK_KEEP_ALL (0xFFFF)
+
 // forward declaration ----
-static void MakeVignetteImage8( const ximage* src, float startWidthFactor, float endWidthFactor );
-static void MakeVignetteImage24BrightnessOnly( const ximage* src, float startWidthFactor, float endWidthFactor );
-static void MakeVignetteImage24IncludingSaturation( const ximage* src, float startWidthFactor, float endWidthFactor, bool decreaseBrightness );
+static void ApplyVignetteMask8( ximage* src, const ximage* mask );
+static void ApplyVignetteMask24BrightnessOnly( ximage* src, const ximage* mask );
+static void ApplyVignetteMask24IncludingSaturation( ximage* src, const ximage* mask, bool decreaseBrightness );
 // ------------------------
 
 // Create vignetting effect on the specified image
@@ -33,223 +36,253 @@ XErrorCode MakeVignetteImage( ximage* src, float startWidthFactor, float endWidt
 {
     XErrorCode ret = SuccessCode;
 
+    if ( src == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( decreaseBrightness ) || ( decreaseSaturation ) )
+    {
+        ximage* mask = 0;
+
+        ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &mask );
+
+        if ( ret == SuccessCode )
+        {
+            ret = BuildVignetteMask( mask, startWidthFactor, endWidthFactor );
+
+            if ( ret == SuccessCode )
+            {
+                ret = ApplyVignetteMask( src, mask, decreaseBrightness, decreaseSaturation );
+            }
+
+            XImageFree( &mask );
+        }
+    }
+
+    return ret;
+}
+
+// Build vignetting mask for images of the mask's size
+XErrorCode BuildVignetteMask( ximage* mask, float startWidthFactor, float endWidthFactor )
+{
+    XErrorCode ret = SuccessCode;
+
     if ( startWidthFactor > endWidthFactor )
     {
         endWidthFactor = startWidthFactor;
     }
 
-    if ( src == 0 )
+    if ( mask == 0 )
     {
         ret = ErrorNullParameter;
     }
+    else if ( mask->format != XPixelFormatGrayscale16 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
     else
     {
-        if ( ( decreaseBrightness ) || ( decreaseSaturation ) )
+        int   width         = mask->width;
+        int   height        = mask->height;
+        int   maskStride    = mask->stride;
+        float halfWidth     = (float) ( width  - 1 ) / 2;
+        float halfHeight    = (float) ( height - 1 ) / 2;
+        float startRadius   = halfWidth * startWidthFactor;
+        float startRadiusSq = startRadius * startRadius;
+        float endRadius     = halfWidth * endWidthFactor;
+        float endRadiusSq   = endRadius * endRadius;
+        float radiusDelta   = endRadius - startRadius;
+        int   y;
+
+        uint8_t* maskPtr = mask->data;
+
+        #pragma omp parallel for schedule(static) shared( maskPtr, width, maskStride, halfWidth, halfHeight, startRadiusSq, endRadiusSq, startRadius, radiusDelta )
+        for ( y = 0; y < height; y++ )
         {
-            if ( src->format == XPixelFormatGrayscale8 )
+            uint16_t* maskRow = (uint16_t*) ( maskPtr + y * maskStride );
+            float     dy      = (float) y - halfHeight;
+            float     dy2     = dy * dy;
+
+            float     dx, distance, distanceSq;
+            int       x;
+
+            for ( x = 0; x < width; x++ )
             {
-                // we care only about light in grayscale images, since those are desaturated by definition
-                if ( decreaseBrightness )
+                dx = (float) x - halfWidth;
+                distanceSq = dx * dx + dy2;
+
+                if ( distanceSq <= startRadiusSq )
                 {
-                    MakeVignetteImage8( src, startWidthFactor, endWidthFactor );
+                    maskRow[x] = MASK_KEEP_ALL;
                 }
-            }
-            else if ( ( src->format == XPixelFormatRGB24 ) ||
-                      ( src->format == XPixelFormatRGBA32 ) )
-            {
-                if ( decreaseSaturation )
+                else if ( distanceSq > endRadiusSq )
                 {
-                    // use the version which does RGB<->HSL conversion
-                    MakeVignetteImage24IncludingSaturation( src, startWidthFactor, endWidthFactor, decreaseBrightness );
+                    maskRow[x] = 0;
                 }
                 else
                 {
-                    // since saturation is not affected, use RGB version
-                    MakeVignetteImage24BrightnessOnly( src, startWidthFactor, endWidthFactor );
+                    distance = (float) sqrt( distanceSq );
+
+                    maskRow[x] = (uint16_t) ( ( 1.0f - ( distance - startRadius ) / radiusDelta ) * MASK_KEEP_ALL + 0.5f );
                 }
             }
+        }
+    }
+
+    return ret;
+}
+
+// Apply vignetting mask to the specified image
+XErrorCode ApplyVignetteMask( ximage* src, const ximage* mask, bool decreaseBrightness, bool decreaseSaturation )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( mask == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( mask->format != XPixelFormatGrayscale16 )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( src->width != mask->width ) || ( src->height != mask->height ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else if ( ( decreaseBrightness ) || ( decreaseSaturation ) )
+    {
+        if ( src->format == XPixelFormatGrayscale8 )
+        {
+            // we care only about light in grayscale images, since those are desaturated by definition
+            if ( decreaseBrightness )
+            {
+                ApplyVignetteMask8( src, mask );
+            }
+        }
+        else if ( ( src->format == XPixelFormatRGB24 ) ||
+                  ( src->format == XPixelFormatRGBA32 ) )
+        {
+            if ( decreaseSaturation )
+            {
+                // use the version which does RGB<->HSL conversion
+                ApplyVignetteMask24IncludingSaturation( src, mask, decreaseBrightness );
+            }
             else
             {
-                ret = ErrorUnsupportedPixelFormat;
+                // since saturation is not affected, use RGB version
+                ApplyVignetteMask24BrightnessOnly( src, mask );
             }
         }
+        else
+        {
+            ret = ErrorUnsupportedPixelFormat;
+        }
     }
 
     return ret;
 }
 
-// Create vignetting effect on the specified 8bpp grayscale image
-void MakeVignetteImage8( const ximage* src, float startWidthFactor, float endWidthFactor )
+// Apply vignetting mask to the specified 8bpp grayscale image
+void ApplyVignetteMask8( ximage* src, const ximage* mask )
 {
-    int   width         = src->width;
-    int   height        = src->height;
-    int   srcStride     = src->stride;
-    float halfWidth     = (float) ( width  - 1 ) / 2;
-    float halfHeight    = (float) ( height - 1 ) / 2;
-    float startRadius   = halfWidth * startWidthFactor;
-    float startRadiusSq = startRadius * startRadius;
-    float endRadius     = halfWidth * endWidthFactor;
-    float endRadiusSq   = endRadius * endRadius;
-    float radiusDelta   = endRadius - startRadius;
-    int   y;
+    int width      = src->width;
+    int height     = src->height;
+    int srcStride  = src->stride;
+    int maskStride = mask->stride;
+    int y;
 
     uint8_t* srcPtr  = src->data;
+    uint8_t* maskPtr = mask->data;
 
-    #pragma omp parallel for schedule(static) shared( srcPtr, width, srcStride, halfWidth, halfHeight, startRadiusSq, endRadiusSq, startRadius, radiusDelta )
+    #pragma omp parallel for schedule(static) shared( srcPtr, maskPtr, width, srcStride, maskStride )
     for ( y = 0; y < height; y++ )
     {
-        uint8_t* srcRow = srcPtr + y * srcStride;
-        float    dy     = (float) y - halfHeight;
-        float    dy2    = dy * dy;
-
-        float    dx, distance, distanceSq;
-        int      x;
+        uint8_t*        srcRow  = srcPtr + y * srcStride;
+        const uint16_t* maskRow = (const uint16_t*) ( maskPtr + y * maskStride );
+        int             x;
 
         for ( x = 0; x < width; x++ )
         {
-            dx = (float) x - halfWidth;
-            distanceSq = dx * dx + dy2;
-
-            if ( distanceSq > startRadiusSq )
-            {
-                if ( distanceSq > endRadiusSq )
-                {
-                    *srcRow = 0;
-                }
-                else
-                {
-                    distance = (float) sqrt( distanceSq );
-
-                    *srcRow = (uint8_t) ( ( 1.0f - ( distance - startRadius ) / radiusDelta ) * *srcRow );
-                }
-            }
-
-            srcRow++;
+            srcRow[x] = (uint8_t) ( ( srcRow[x] * maskRow[x] + 0x8000 ) >> 16 );
         }
     }
 }
 
-// Create vignetting effect on the specified 24/32 color image - decrease light only
-void MakeVignetteImage24BrightnessOnly( const ximage* src, float startWidthFactor, float endWidthFactor )
+// Apply vignetting mask to the specified 24/32 color image - decrease light only
+void ApplyVignetteMask24BrightnessOnly( ximage* src, const ximage* mask )
 {
-    int   width         = src->width;
-    int   height        = src->height;
-    int   srcStride     = src->stride;
-    int   pixelSize     = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
-    float halfWidth     = (float) ( width  - 1 ) / 2;
-    float halfHeight    = (float) ( height - 1 ) / 2;
-    float startRadius   = halfWidth * startWidthFactor;
-    float startRadiusSq = startRadius * startRadius;
-    float endRadius     = halfWidth * endWidthFactor;
-    float endRadiusSq   = endRadius * endRadius;
-    float radiusDelta   = endRadius - startRadius;
-    int   y;
+    int width      = src->width;
+    int height     = src->height;
+    int srcStride  = src->stride;
+    int maskStride = mask->stride;
+    int pixelSize  = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+    int y;
 
     uint8_t* srcPtr  = src->data;
+    uint8_t* maskPtr = mask->data;
 
-    #pragma omp parallel for schedule(static) shared( srcPtr, width, srcStride, halfWidth, halfHeight, startRadiusSq, endRadiusSq, startRadius, radiusDelta )
+    #pragma omp parallel for schedule(static) shared( srcPtr, maskPtr, width, srcStride, maskStride, pixelSize )
     for ( y = 0; y < height; y++ )
     {
-        uint8_t* srcRow = srcPtr + y * srcStride;
-        float    dy     = (float) y - halfHeight;
-        float    dy2    = dy * dy;
-
-        float    dx, distance, distanceSq, changeFactor;
-        int      x;
+        uint8_t*        srcRow  = srcPtr + y * srcStride;
+        const uint16_t* maskRow = (const uint16_t*) ( maskPtr + y * maskStride );
+        uint32_t        factor;
+        int             x;
 
-        for ( x = 0; x < width; x++ )
+        for ( x = 0; x < width; x++, srcRow += pixelSize )
         {
-            dx = (float) x - halfWidth;
-            distanceSq = dx * dx + dy2;
+            factor = maskRow[x];
 
-            if ( distanceSq > startRadiusSq )
+            if ( factor != MASK_KEEP_ALL )
             {
-                if ( distanceSq > endRadiusSq )
-                {
-                    srcRow[RedIndex]   = 0;
-                    srcRow[GreenIndex] = 0;
-                    srcRow[BlueIndex]  = 0;
-                }
-                else
-                {
-                    distance = (float) sqrt( distanceSq );
-
-                    changeFactor = 1.0f - ( distance - startRadius ) / radiusDelta;
-
-                    srcRow[RedIndex]   = (uint8_t) ( changeFactor * srcRow[RedIndex]   );
-                    srcRow[GreenIndex] = (uint8_t) ( changeFactor * srcRow[GreenIndex] );
-                    srcRow[BlueIndex]  = (uint8_t) ( changeFactor * srcRow[BlueIndex]  );
-                }
+                srcRow[RedIndex]   = (uint8_t) ( ( srcRow[RedIndex]   * factor + 0x8000 ) >> 16 );
+                srcRow[GreenIndex] = (uint8_t) ( ( srcRow[GreenIndex] * factor + 0x8000 ) >> 16 );
+                srcRow[BlueIndex]  = (uint8_t) ( ( srcRow[BlueIndex]  * factor + 0x8000 ) >> 16 );
             }
-
-            srcRow += pixelSize;
         }
     }
 }
 
-// Create vignetting effect on the specified 24/32 color image - saturation is always decreased
-void MakeVignetteImage24IncludingSaturation( const ximage* src, float startWidthFactor, float endWidthFactor, bool decreaseBrightness )
+// Apply vignetting mask to the specified 24/32 color image - saturation is always decreased
+void ApplyVignetteMask24IncludingSaturation( ximage* src, const ximage* mask, bool decreaseBrightness )
 {
-    int   width         = src->width;
-    int   height        = src->height;
-    int   srcStride     = src->stride;
-    int   pixelSize     = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
-    float halfWidth     = (float) ( width  - 1 ) / 2;
-    float halfHeight    = (float) ( height - 1 ) / 2;
-    float startRadius   = halfWidth * startWidthFactor;
-    float startRadiusSq = startRadius * startRadius;
-    float endRadius     = halfWidth * endWidthFactor;
-    float endRadiusSq   = endRadius * endRadius;
-    float radiusDelta   = endRadius - startRadius;
-    int   y;
+    int width      = src->width;
+    int height     = src->height;
+    int srcStride  = src->stride;
+    int maskStride = mask->stride;
+    int pixelSize  = ( src->format == XPixelFormatRGB24 ) ? 3 : 4;
+    int y;
 
     uint8_t* srcPtr  = src->data;
+    uint8_t* maskPtr = mask->data;
 
-    #pragma omp parallel for schedule(static) shared( srcPtr, width, srcStride, halfWidth, halfHeight, startRadiusSq, endRadiusSq, startRadius, radiusDelta, decreaseBrightness )
+    #pragma omp parallel for schedule(static) shared( srcPtr, maskPtr, width, srcStride, maskStride, pixelSize, decreaseBrightness )
     for ( y = 0; y < height; y++ )
     {
-        uint8_t* srcRow = srcPtr + y * srcStride;
-        float    dy     = (float) y - halfHeight;
-        float    dy2    = dy * dy;
-
-        float    dx, distance, distanceSq, changeFactor;
-        int      x;
-        xargb    rgb;
-        xhsv     hsv;
-
-        for ( x = 0; x < width; x++ )
+        uint8_t*        srcRow  = srcPtr + y * srcStride;
+        const uint16_t* maskRow = (const uint16_t*) ( maskPtr + y * maskStride );
+        float           changeFactor;
+        int             x;
+        xargb           rgb;
+        xhsv            hsv;
+
+        for ( x = 0; x < width; x++, srcRow += pixelSize )
         {
-            dx = (float) x - halfWidth;
-            distanceSq = dx * dx + dy2;
-
-            if ( distanceSq > startRadiusSq )
+            if ( maskRow[x] != MASK_KEEP_ALL )
             {
+                changeFactor = (float) maskRow[x] / MASK_KEEP_ALL;
+
                 rgb.components.r = srcRow[RedIndex];
                 rgb.components.g = srcRow[GreenIndex];
                 rgb.components.b = srcRow[BlueIndex];
 
                 Rgb2Hsv( &rgb, &hsv );
 
-                if ( distanceSq > endRadiusSq )
-                {
-                    if ( decreaseBrightness )
-                    {
-                        hsv.Value = 0.0f;
-                    }
-                    hsv.Saturation = 0.0f;
-                }
-                else
+                if ( decreaseBrightness )
                 {
-                    distance = (float) sqrt( distanceSq );
-
-                    changeFactor = 1.0f - ( distance - startRadius ) / radiusDelta;
-
-                    if ( decreaseBrightness )
-                    {
-                        hsv.Value *= changeFactor;
-                    }
-                    hsv.Saturation *= changeFactor;
+                    hsv.Value *= changeFactor;
                 }
+                hsv.Saturation *= changeFactor;
 
                 Hsv2Rgb( &hsv, &rgb );
 
@@ -257,8 +290,6 @@ void MakeVignetteImage24IncludingSaturation( const ximage* src, float startWidth
                 srcRow[GreenIndex] = rgb.components.g;
                 srcRow[BlueIndex]  = rgb.components.b;
             }
-
-            srcRow += pixelSize;
         }
     }
 }
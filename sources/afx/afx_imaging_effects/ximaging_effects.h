@@ -52,6 +52,10 @@ XErrorCode RotateImageHue( ximage* src, uint16_t hueAngle );
 XErrorCode OilPainting( const ximage* src, ximage* dst, uint8_t radius );
 // Create vignetting effect on the specified image
 XErrorCode MakeVignetteImage( ximage* src, float startWidthFactor, float endWidthFactor, bool decreaseBrightness, bool decreaseSaturation );
+// Build vignetting mask (16 bpp grayscale image of the target image's size) keeping fall-off factors for every pixel
+XErrorCode BuildVignetteMask( ximage* mask, float startWidthFactor, float endWidthFactor );
+// Apply vignetting mask built by BuildVignetteMask() to the specified image
+XErrorCode ApplyVignetteMask( ximage* src, const ximage* mask, bool decreaseBrightness, bool decreaseSaturation );
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,85 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XAutoResetEvent.hpp"
+#include "internal/XAutoResetEventImpl.hpp"
+#include <assert.h>
+
+namespace CVSandbox { namespace Threading {
+
+XAutoResetEvent::XAutoResetEvent( ) : pimpl( new Private::XAutoResetEventImpl( ) ), isValid( false )
+{
+    isValid = pimpl->Create( );
+    assert( isValid );
+}
+
+XAutoResetEvent::~XAutoResetEvent( )
+{
+    pimpl->Destroy( );
+    delete pimpl;
+}
+
+// Set event to signalled state
+void XAutoResetEvent::Signal( )
+{
+    pimpl->Signal( );
+}
+
+// Wait till the event gets into signalled state
+void XAutoResetEvent::Wait( )
+{
+    pimpl->Wait( );
+}
+
+// Wait the specified amount of time (milliseconds) till the event gets signalled
+bool XAutoResetEvent::Wait( uint32_t msec )
+{
+    return pimpl->Wait( msec );
+}
+
+// Wait till any of the specified events gets signalled - returns its index (only that event is reset)
+uint32_t XAutoResetEvent::WaitAny( XAutoResetEvent** events, uint32_t count )
+{
+    return static_cast<uint32_t>( WaitAny( events, count, Private::XAutoResetEventImpl::Infinite ) );
+}
+
+// Wait the specified amount of time till any of the events gets signalled - returns its index or -1 on timeout
+int32_t XAutoResetEvent::WaitAny( XAutoResetEvent** events, uint32_t count, uint32_t msec )
+{
+    Private::XAutoResetEventImpl* impls[Private::XAutoResetEventImpl::MaxWaitAnyCount];
+    int32_t                       ret = -1;
+
+    assert( ( events != nullptr ) && ( count != 0 ) && ( count <= Private::XAutoResetEventImpl::MaxWaitAnyCount ) );
+
+    if ( ( events != nullptr ) && ( count != 0 ) && ( count <= Private::XAutoResetEventImpl::MaxWaitAnyCount ) )
+    {
+        for ( uint32_t i = 0; i < count; i++ )
+        {
+            impls[i] = events[i]->pimpl;
+        }
+
+        ret = Private::XAutoResetEventImpl::WaitAny( impls, count, msec );
+    }
+
+    return ret;
+}
+
+} } // namespace CVSandbox::Threading
@@ -0,0 +1,61 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XSemaphore.hpp"
+#include "internal/XSemaphoreImpl.hpp"
+#include <assert.h>
+
+namespace CVSandbox { namespace Threading {
+
+XSemaphore::XSemaphore( uint32_t initialCount ) : pimpl( new Private::XSemaphoreImpl( ) ), isValid( false )
+{
+    isValid = pimpl->Create( initialCount );
+    assert( isValid );
+}
+
+XSemaphore::~XSemaphore( )
+{
+    pimpl->Destroy( );
+    delete pimpl;
+}
+
+// Increase semaphore's count by the specified value, releasing that many waiting threads
+void XSemaphore::Release( uint32_t count )
+{
+    if ( count != 0 )
+    {
+        pimpl->Release( count );
+    }
+}
+
+// Wait till semaphore's count gets greater than zero and decrease it
+void XSemaphore::Wait( )
+{
+    pimpl->Wait( );
+}
+
+// Wait the specified amount of time (milliseconds) till semaphore's count can be decreased
+bool XSemaphore::Wait( uint32_t msec )
+{
+    return pimpl->Wait( msec );
+}
+
+} } // namespace CVSandbox::Threading
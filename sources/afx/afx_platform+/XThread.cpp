@@ -21,6 +21,32 @@
 
 #include "XThread.hpp"
 #include "internal/XThreadImpl.hpp"
+#include <algorithm>
+
+using namespace std;
+
+// Maximum CPU number accepted in CPU lists
+static const uint32_t MAX_CPU_NUMBER = 4095;
+
+// Parse CPU number moving the pointer past it
+static bool ParseCpuNumber( const char** ptr, uint32_t* number )
+{
+    const char* p     = *ptr;
+    uint32_t    value = 0;
+
+    while ( ( *p >= '0' ) && ( *p <= '9' ) && ( value <= MAX_CPU_NUMBER ) )
+    {
+        value = value * 10 + ( *p - '0' );
+        p++;
+    }
+
+    *number = value;
+
+    bool ret = ( ( p != *ptr ) && ( value <= MAX_CPU_NUMBER ) );
+    *ptr = p;
+
+    return ret;
+}
 
 namespace CVSandbox { namespace Threading {
 
@@ -81,4 +107,136 @@ uint32_t XThread::ThreadId( )
     return Private::XThreadImpl::ThreadId( );
 }
 
+// Set scheduling priority of the current thread (real time priority usually requires extra privileges)
+bool XThread::SetCurrentThreadPriority( XThreadPriority priority )
+{
+    return Private::XThreadImpl::SetCurrentThreadPriority( priority );
+}
+
+// Set CPUs the current thread is allowed to run on
+bool XThread::SetCurrentThreadAffinity( const vector<uint32_t>& cpus )
+{
+    return ( ( !cpus.empty( ) ) && ( Private::XThreadImpl::SetCurrentThreadAffinity( cpus ) ) );
+}
+
+// Bind current thread to CPUs of the NUMA node and allocate its memory from the node
+bool XThread::SetCurrentThreadNumaNode( uint32_t node )
+{
+    return Private::XThreadImpl::SetCurrentThreadNumaNode( node );
+}
+
+// Apply scheduling options to the current thread - returns false if any of them failed
+bool XThread::ApplySchedulingOptions( const XThreadSchedulingOptions& options )
+{
+    vector<uint32_t> cpus = options.Cpus;
+    bool             ret  = true;
+
+    // NUMA node is set first, so explicitly specified CPUs could narrow its CPUs down
+    if ( options.NumaNode >= 0 )
+    {
+        ret &= SetCurrentThreadNumaNode( static_cast<uint32_t>( options.NumaNode ) );
+
+        if ( !cpus.empty( ) )
+        {
+            vector<uint32_t> nodeCpus;
+
+            // keep only those CPUs, which belong to the node
+            if ( Private::XThreadImpl::GetNumaNodeCpus( static_cast<uint32_t>( options.NumaNode ), nodeCpus ) )
+            {
+                cpus.erase( remove_if( cpus.begin( ), cpus.end( ), [&nodeCpus]( uint32_t cpu )
+                    { return find( nodeCpus.begin( ), nodeCpus.end( ), cpu ) == nodeCpus.end( ); } ), cpus.end( ) );
+
+                // none of the CPUs is on the node, so thread stays on CPUs of the node and failure is reported
+                if ( cpus.empty( ) )
+                {
+                    ret = false;
+                }
+            }
+        }
+    }
+    if ( !cpus.empty( ) )
+    {
+        ret &= SetCurrentThreadAffinity( cpus );
+    }
+    if ( options.Priority != XThreadPriority::Normal )
+    {
+        ret &= SetCurrentThreadPriority( options.Priority );
+    }
+
+    return ret;
+}
+
+// Set name of the current thread, which is shown by debuggers and system tools (may get truncated)
+bool XThread::SetCurrentThreadName( const string& name )
+{
+    return Private::XThreadImpl::SetCurrentThreadName( name );
+}
+
+// Get number of CPUs available in the system
+uint32_t XThread::CpuCount( )
+{
+    return Private::XThreadImpl::CpuCount( );
+}
+
+// Parse list of CPUs in "0-3,8,10-11" format
+bool XThread::ParseCpuList( const string& list, vector<uint32_t>& cpus )
+{
+    const char* ptr = list.c_str( );
+    bool        ret = true;
+
+    cpus.clear( );
+
+    do
+    {
+        uint32_t first = 0;
+        uint32_t last  = 0;
+
+        ret  = ParseCpuNumber( &ptr, &first );
+        last = first;
+
+        if ( ( ret ) && ( *ptr == '-' ) )
+        {
+            ptr++;
+            ret = ( ( ParseCpuNumber( &ptr, &last ) ) && ( last >= first ) );
+        }
+
+        for ( uint32_t cpu = first; ( ret ) && ( cpu <= last ); cpu++ )
+        {
+            cpus.push_back( cpu );
+        }
+    }
+    while ( ( ret ) && ( *ptr++ == ',' ) );
+
+    // allow new line at the end, like in the lists provided by Linux
+    if ( ( ret ) && ( ptr[-1] != '\0' ) )
+    {
+        ret = ( ( ptr[-1] == '\n' ) && ( *ptr == '\0' ) );
+    }
+
+    if ( !ret )
+    {
+        cpus.clear( );
+    }
+
+    return ret;
+}
+
+// Parse thread priority's name - "idle", "lowest", "below-normal", "normal", "above-normal", "highest" or "realtime"
+bool XThread::ParsePriority( const string& name, XThreadPriority* priority )
+{
+    static const char* names[] = { "idle", "lowest", "below-normal", "normal", "above-normal", "highest", "realtime" };
+    bool ret = false;
+
+    for ( int i = 0; ( i < static_cast<int>( sizeof( names ) / sizeof( names[0] ) ) ) && ( !ret ); i++ )
+    {
+        if ( name == names[i] )
+        {
+            *priority = static_cast<XThreadPriority>( i );
+            ret = true;
+        }
+    }
+
+    return ret;
+}
+
 } } // namespace CVSandbox::Threading
@@ -24,6 +24,8 @@
 #define CVS_XTHREAD_HPP
 
 #include <stdint.h>
+#include <string>
+#include <vector>
 #include <XInterfaces.hpp>
 
 namespace CVSandbox { namespace Threading {
@@ -36,6 +38,34 @@ namespace Private
 // Thread function's type
 typedef void (*XThreadFunction)( void* );
 
+// Scheduling priority of a thread
+enum class XThreadPriority
+{
+    Idle = 0,
+    Lowest,
+    BelowNormal,
+    Normal,
+    AboveNormal,
+    Highest,
+    RealTime
+};
+
+// Scheduling options to apply to a thread
+struct XThreadSchedulingOptions
+{
+    XThreadPriority       Priority;     // thread's priority (Normal - priority is not changed)
+    std::vector<uint32_t> Cpus;         // CPUs the thread is allowed to run on (empty - any)
+    int32_t               NumaNode;     // NUMA node to run the thread on and allocate its memory from (-1 - any)
+
+    XThreadSchedulingOptions( ) : Priority( XThreadPriority::Normal ), Cpus( ), NumaNode( -1 ) { }
+
+    // Check if the options don't change anything
+    bool IsDefault( ) const
+    {
+        return ( ( Priority == XThreadPriority::Normal ) && ( Cpus.empty( ) ) && ( NumaNode < 0 ) );
+    }
+};
+
 // Thread managing class
 class XThread : public Uncopyable
 {
@@ -63,6 +93,24 @@ public:
     // Get ID of the current thread
     static uint32_t ThreadId( );
 
+    // Set scheduling priority of the current thread (real time priority usually requires extra privileges)
+    static bool SetCurrentThreadPriority( XThreadPriority priority );
+    // Set CPUs the current thread is allowed to run on
+    static bool SetCurrentThreadAffinity( const std::vector<uint32_t>& cpus );
+    // Bind current thread to CPUs of the NUMA node and allocate its memory from the node
+    static bool SetCurrentThreadNumaNode( uint32_t node );
+    // Apply scheduling options to the current thread - returns false if any of them failed
+    static bool ApplySchedulingOptions( const XThreadSchedulingOptions& options );
+    // Set name of the current thread, which is shown by debuggers and system tools (may get truncated)
+    static bool SetCurrentThreadName( const std::string& name );
+
+    // Get number of CPUs available in the system
+    static uint32_t CpuCount( );
+    // Parse list of CPUs in "0-3,8,10-11" format
+    static bool ParseCpuList( const std::string& list, std::vector<uint32_t>& cpus );
+    // Parse thread priority's name - "idle", "lowest", "below-normal", "normal", "above-normal", "highest" or "realtime"
+    static bool ParsePriority( const std::string& name, XThreadPriority* priority );
+
 private:
     Private::XThreadImpl* pimpl;
 };
@@ -0,0 +1,224 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XAutoResetEventImpl.hpp"
+#include "XFutex.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// Auto reset synchronization object implementation using Linux futex. Signalling an event nobody waits for
+// and waiting for an already signalled event are done with atomic operations only, without system calls.
+
+using namespace std;
+
+namespace CVSandbox { namespace Threading { namespace Private {
+
+class XAutoResetEventImplData
+{
+public:
+    atomic<uint32_t>            State;              // 1 if the event is signalled
+    atomic<uint32_t>            WaitersCount;       // number of threads sleeping on the state
+    atomic<uint32_t>            AnyWaitersCount;    // number of WaitAny() calls the event takes part in
+    mutex                       AnyWaitersSync;
+    vector<atomic<uint32_t>*>   AnyWaiters;         // values WaitAny() calls sleep on
+
+public:
+    XAutoResetEventImplData( ) :
+        State( 0 ), WaitersCount( 0 ), AnyWaitersCount( 0 ), AnyWaitersSync( ), AnyWaiters( )
+    {
+    }
+
+    // Reset the event if it is signalled - returns true on success
+    bool TryConsume( )
+    {
+        uint32_t expected = 1;
+        return ( ( State.load( memory_order_relaxed ) == 1 ) && ( State.compare_exchange_strong( expected, 0 ) ) );
+    }
+
+    void AddAnyWaiter( atomic<uint32_t>* waiter )
+    {
+        lock_guard<mutex> lock( AnyWaitersSync );
+        AnyWaiters.push_back( waiter );
+        AnyWaitersCount++;
+    }
+
+    void RemoveAnyWaiter( atomic<uint32_t>* waiter )
+    {
+        lock_guard<mutex> lock( AnyWaitersSync );
+        AnyWaiters.erase( find( AnyWaiters.begin( ), AnyWaiters.end( ), waiter ) );
+        AnyWaitersCount--;
+    }
+};
+
+XAutoResetEventImpl::XAutoResetEventImpl( ) :
+    mData( new XAutoResetEventImplData( ) )
+{
+}
+
+XAutoResetEventImpl::~XAutoResetEventImpl( )
+{
+    delete mData;
+}
+
+// Create system's synchronization object
+bool XAutoResetEventImpl::Create( )
+{
+    return true;
+}
+
+// Destroy system's synchronization object
+void XAutoResetEventImpl::Destroy( )
+{
+}
+
+// Set event to signalled state
+void XAutoResetEventImpl::Signal( )
+{
+    if ( mData->State.exchange( 1 ) == 0 )
+    {
+        if ( mData->WaitersCount.load( ) != 0 )
+        {
+            FutexWake( &mData->State, 1 );
+        }
+
+        if ( mData->AnyWaitersCount.load( ) != 0 )
+        {
+            lock_guard<mutex> lock( mData->AnyWaitersSync );
+
+            for ( atomic<uint32_t>* waiter : mData->AnyWaiters )
+            {
+                waiter->fetch_add( 1 );
+                FutexWake( waiter, 1 );
+            }
+        }
+    }
+}
+
+// Wait till the event gets into signalled state
+void XAutoResetEventImpl::Wait( )
+{
+    Wait( Infinite );
+}
+
+// Wait the specified amount of time (milliseconds) till the event gets signalled
+bool XAutoResetEventImpl::Wait( uint32_t msec )
+{
+    bool ret = mData->TryConsume( );
+
+    if ( ( !ret ) && ( msec != 0 ) )
+    {
+        struct timespec deadline = FutexDeadline( msec );
+        struct timespec timeLeft;
+
+        // signalling thread checks number of waiters after setting the state,
+        // so either it sees us or we see the state it has set
+        mData->WaitersCount++;
+
+        while ( !( ret = mData->TryConsume( ) ) )
+        {
+            if ( msec == Infinite )
+            {
+                FutexWait( &mData->State, 0, nullptr );
+            }
+            else if ( FutexTimeLeft( deadline, &timeLeft ) )
+            {
+                FutexWait( &mData->State, 0, &timeLeft );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        mData->WaitersCount--;
+    }
+
+    return ret;
+}
+
+// Wait the specified amount of time till any of the events gets signalled - returns its index or -1 on timeout
+int32_t XAutoResetEventImpl::WaitAny( XAutoResetEventImpl** events, uint32_t count, uint32_t msec )
+{
+    int32_t  ret = -1;
+    uint32_t i;
+
+    for ( i = 0; ( i < count ) && ( ret == -1 ); i++ )
+    {
+        if ( events[i]->mData->TryConsume( ) )
+        {
+            ret = static_cast<int32_t>( i );
+        }
+    }
+
+    if ( ( ret == -1 ) && ( msec != 0 ) )
+    {
+        struct timespec  deadline = FutexDeadline( msec );
+        struct timespec  timeLeft;
+        atomic<uint32_t> wakeCounter( 0 );
+
+        // let all events know they need to wake us as well
+        for ( i = 0; i < count; i++ )
+        {
+            events[i]->mData->AddAnyWaiter( &wakeCounter );
+        }
+
+        for ( ; ; )
+        {
+            uint32_t lastWakeCounter = wakeCounter.load( );
+
+            for ( i = 0; ( i < count ) && ( ret == -1 ); i++ )
+            {
+                if ( events[i]->mData->TryConsume( ) )
+                {
+                    ret = static_cast<int32_t>( i );
+                }
+            }
+
+            if ( ret != -1 )
+            {
+                break;
+            }
+
+            if ( msec == Infinite )
+            {
+                FutexWait( &wakeCounter, lastWakeCounter, nullptr );
+            }
+            else if ( FutexTimeLeft( deadline, &timeLeft ) )
+            {
+                FutexWait( &wakeCounter, lastWakeCounter, &timeLeft );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        for ( i = 0; i < count; i++ )
+        {
+            events[i]->mData->RemoveAnyWaiter( &wakeCounter );
+        }
+    }
+
+    return ret;
+}
+
+} } } // namespace CVSandbox::Threading::Private
@@ -0,0 +1,115 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XAutoResetEventImpl.hpp"
+
+// Auto reset synchronization object implementation using Win32 API
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+namespace CVSandbox { namespace Threading { namespace Private {
+
+class XAutoResetEventImplData
+{
+public:
+    HANDLE Event;
+};
+
+XAutoResetEventImpl::XAutoResetEventImpl( ) :
+    mData( new XAutoResetEventImplData( ) )
+{
+}
+
+XAutoResetEventImpl::~XAutoResetEventImpl( )
+{
+    delete mData;
+}
+
+// Create system's synchronization object
+bool XAutoResetEventImpl::Create( )
+{
+    mData->Event = CreateEvent( NULL, FALSE, FALSE, NULL );
+    return ( mData->Event != 0 );
+}
+
+// Destroy system's synchronization object
+void XAutoResetEventImpl::Destroy( )
+{
+    if ( mData->Event != 0 )
+    {
+        CloseHandle( mData->Event );
+    }
+}
+
+// Set event to signalled state
+void XAutoResetEventImpl::Signal( )
+{
+    if ( mData->Event != 0 )
+    {
+        SetEvent( mData->Event );
+    }
+}
+
+// Wait till the event gets into signalled state
+void XAutoResetEventImpl::Wait( )
+{
+    if ( mData->Event != 0 )
+    {
+        WaitForSingleObject( mData->Event, INFINITE );
+    }
+}
+
+// Wait the specified amount of time (milliseconds) till the event gets signalled
+bool XAutoResetEventImpl::Wait( uint32_t msec )
+{
+    bool ret = true;
+
+    if ( mData->Event != 0 )
+    {
+        ret = ( WaitForSingleObject( mData->Event, msec ) == WAIT_OBJECT_0 );
+    }
+
+    return ret;
+}
+
+// Wait the specified amount of time till any of the events gets signalled - returns its index or -1 on timeout
+int32_t XAutoResetEventImpl::WaitAny( XAutoResetEventImpl** events, uint32_t count, uint32_t msec )
+{
+    HANDLE  handles[MaxWaitAnyCount];
+    int32_t ret = -1;
+    DWORD   waitResult;
+
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        handles[i] = events[i]->mData->Event;
+    }
+
+    waitResult = WaitForMultipleObjects( count, handles, FALSE, ( msec == Infinite ) ? INFINITE : msec );
+
+    if ( waitResult < WAIT_OBJECT_0 + count )
+    {
+        ret = static_cast<int32_t>( waitResult - WAIT_OBJECT_0 );
+    }
+
+    return ret;
+}
+
+} } } // namespace CVSandbox::Threading::Private
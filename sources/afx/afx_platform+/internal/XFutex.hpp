@@ -0,0 +1,91 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XFUTEX_HPP
+#define CVS_XFUTEX_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Helpers for synchronization objects implemented on top of Linux futex
+
+namespace CVSandbox { namespace Threading { namespace Private {
+
+static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "Atomic integers must be usable as futex words" );
+
+// Sleep till the value gets different from the expected one, somebody wakes us or timeout expires (null timeout means infinite)
+inline void FutexWait( std::atomic<uint32_t>* value, uint32_t expected, const struct timespec* timeout )
+{
+    syscall( SYS_futex, reinterpret_cast<uint32_t*>( value ), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0 );
+}
+
+// Wake up to the specified number of threads sleeping on the value
+inline void FutexWake( std::atomic<uint32_t>* value, uint32_t count )
+{
+    syscall( SYS_futex, reinterpret_cast<uint32_t*>( value ), FUTEX_WAKE_PRIVATE, static_cast<int>( count ), nullptr, nullptr, 0 );
+}
+
+// Get time point the specified number of milliseconds ahead of now
+inline struct timespec FutexDeadline( uint32_t msec )
+{
+    struct timespec deadline;
+
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
+
+    deadline.tv_sec  += msec / 1000;
+    deadline.tv_nsec += static_cast<long>( msec % 1000 ) * 1000000;
+
+    if ( deadline.tv_nsec >= 1000000000 )
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    return deadline;
+}
+
+// Get time left till the deadline - returns false if it has passed already
+inline bool FutexTimeLeft( const struct timespec& deadline, struct timespec* timeLeft )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    timeLeft->tv_sec  = deadline.tv_sec  - now.tv_sec;
+    timeLeft->tv_nsec = deadline.tv_nsec - now.tv_nsec;
+
+    if ( timeLeft->tv_nsec < 0 )
+    {
+        timeLeft->tv_sec--;
+        timeLeft->tv_nsec += 1000000000;
+    }
+
+    return ( ( timeLeft->tv_sec > 0 ) || ( ( timeLeft->tv_sec == 0 ) && ( timeLeft->tv_nsec > 0 ) ) );
+}
+
+} } } // namespace CVSandbox::Threading::Private
+
+#endif // CVS_XFUTEX_HPP
@@ -50,7 +50,7 @@ bool XMutexImpl::Create( )
                  ( pthread_mutexattr_settype( &mutexAttr, PTHREAD_MUTEX_RECURSIVE ) == 0 ) &&
                  ( pthread_mutex_init( &mData->Mutex, &mutexAttr ) == 0 ) );
 
-    pthread_mutexattr_destroy( &mData->MutexAttr );
+    pthread_mutexattr_destroy( &mutexAttr );
 
     return ret;
 }
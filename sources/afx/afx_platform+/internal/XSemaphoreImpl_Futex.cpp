@@ -0,0 +1,130 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XSemaphoreImpl.hpp"
+#include "XFutex.hpp"
+
+// Counting semaphore implementation using Linux futex. Releasing semaphore nobody waits for and
+// decreasing non zero count are done with atomic operations only, without system calls.
+
+using namespace std;
+
+namespace CVSandbox { namespace Threading { namespace Private {
+
+class XSemaphoreImplData
+{
+public:
+    atomic<uint32_t> Count;
+    atomic<uint32_t> WaitersCount;      // number of threads sleeping on the count
+
+public:
+    XSemaphoreImplData( ) :
+        Count( 0 ), WaitersCount( 0 )
+    {
+    }
+
+    // Decrease count if it is not zero - returns true on success
+    bool TryAcquire( )
+    {
+        uint32_t count = Count.load( memory_order_relaxed );
+
+        while ( ( count != 0 ) && ( !Count.compare_exchange_weak( count, count - 1 ) ) )
+        {
+        }
+
+        return ( count != 0 );
+    }
+};
+
+XSemaphoreImpl::XSemaphoreImpl( ) :
+    mData( new XSemaphoreImplData( ) )
+{
+}
+
+XSemaphoreImpl::~XSemaphoreImpl( )
+{
+    delete mData;
+}
+
+// Create system's synchronization object
+bool XSemaphoreImpl::Create( uint32_t initialCount )
+{
+    mData->Count = initialCount;
+    return true;
+}
+
+// Destroy system's synchronization object
+void XSemaphoreImpl::Destroy( )
+{
+}
+
+// Increase semaphore's count by the specified value
+void XSemaphoreImpl::Release( uint32_t count )
+{
+    mData->Count.fetch_add( count );
+
+    if ( mData->WaitersCount.load( ) != 0 )
+    {
+        FutexWake( &mData->Count, count );
+    }
+}
+
+// Wait till semaphore's count gets greater than zero and decrease it
+void XSemaphoreImpl::Wait( )
+{
+    Wait( 0xFFFFFFFF );
+}
+
+// Wait the specified amount of time (milliseconds) till semaphore's count can be decreased
+bool XSemaphoreImpl::Wait( uint32_t msec )
+{
+    bool ret = mData->TryAcquire( );
+
+    if ( ( !ret ) && ( msec != 0 ) )
+    {
+        struct timespec deadline = FutexDeadline( msec );
+        struct timespec timeLeft;
+
+        mData->WaitersCount++;
+
+        while ( !( ret = mData->TryAcquire( ) ) )
+        {
+            if ( msec == 0xFFFFFFFF )
+            {
+                FutexWait( &mData->Count, 0, nullptr );
+            }
+            else if ( FutexTimeLeft( deadline, &timeLeft ) )
+            {
+                FutexWait( &mData->Count, 0, &timeLeft );
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        mData->WaitersCount--;
+    }
+
+    return ret;
+}
+
+} } } // namespace CVSandbox::Threading::Private
@@ -0,0 +1,93 @@
+/*
+    Library to wrap some platform specific code of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XSemaphoreImpl.hpp"
+
+// Counting semaphore implementation using Win32 API
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+namespace CVSandbox { namespace Threading { namespace Private {
+
+class XSemaphoreImplData
+{
+public:
+    HANDLE Semaphore;
+};
+
+XSemaphoreImpl::XSemaphoreImpl( ) :
+    mData( new XSemaphoreImplData( ) )
+{
+}
+
+XSemaphoreImpl::~XSemaphoreImpl( )
+{
+    delete mData;
+}
+
+// Create system's synchronization object
+bool XSemaphoreImpl::Create( uint32_t initialCount )
+{
+    mData->Semaphore = CreateSemaphore( NULL, static_cast<LONG>( initialCount ), 0x7FFFFFFF, NULL );
+    return ( mData->Semaphore != 0 );
+}
+
+// Destroy system's synchronization object
+void XSemaphoreImpl::Destroy( )
+{
+    if ( mData->Semaphore != 0 )
+    {
+        CloseHandle( mData->Semaphore );
+    }
+}
+
+// Increase semaphore's count by the specified value
+void XSemaphoreImpl::Release( uint32_t count )
+{
+    if ( mData->Semaphore != 0 )
+    {
+        ReleaseSemaphore( mData->Semaphore, static_cast<LONG>( count ), NULL );
+    }
+}
+
+// Wait till semaphore's count gets greater than zero and decrease it
+void XSemaphoreImpl::Wait( )
+{
+    if ( mData->Semaphore != 0 )
+    {
+        WaitForSingleObject( mData->Semaphore, INFINITE );
+    }
+}
+
+// Wait the specified amount of time (milliseconds) till semaphore's count can be decreased
+bool XSemaphoreImpl::Wait( uint32_t msec )
+{
+    bool ret = true;
+
+    if ( mData->Semaphore != 0 )
+    {
+        ret = ( WaitForSingleObject( mData->Semaphore, msec ) == WAIT_OBJECT_0 );
+    }
+
+    return ret;
+}
+
+} } } // namespace CVSandbox::Threading::Private
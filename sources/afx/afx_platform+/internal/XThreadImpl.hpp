@@ -56,6 +56,19 @@ public:
     // Get ID of the current thread
     static uint32_t ThreadId( );
 
+    // Set scheduling priority of the current thread
+    static bool SetCurrentThreadPriority( CVSandbox::Threading::XThreadPriority priority );
+    // Set CPUs the current thread is allowed to run on
+    static bool SetCurrentThreadAffinity( const std::vector<uint32_t>& cpus );
+    // Bind current thread to CPUs of the NUMA node and allocate its memory from the node
+    static bool SetCurrentThreadNumaNode( uint32_t node );
+    // Get CPUs of the NUMA node
+    static bool GetNumaNodeCpus( uint32_t node, std::vector<uint32_t>& cpus );
+    // Set name of the current thread
+    static bool SetCurrentThreadName( const std::string& name );
+    // Get number of CPUs available in the system
+    static uint32_t CpuCount( );
+
 private:
     XThreadImplData* mData;
 };
@@ -26,9 +26,16 @@
 #include <assert.h>
 
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <time.h>
 
+#ifdef __linux__
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <linux/mempolicy.h>
+#endif
+
 // Thread management implementation using POSIX PThreads (thread + mutex + condition variable)
 
 namespace CVSandbox { namespace Threading { namespace Private {
@@ -198,6 +205,8 @@ void* XThreadImplData::WorkerThread( void* param )
     pthread_cond_broadcast( &myData->Cond );
 
     pthread_mutex_unlock( &myData->Mutex );
+
+    return nullptr;
 }
 
 // Put current thread into sleep state for the specified amount of time
@@ -218,4 +227,154 @@ uint32_t XThreadImpl::ThreadId( )
     return static_cast<uint32_t>( pthread_self( ) );
 }
 
+// Set scheduling priority of the current thread
+bool XThreadImpl::SetCurrentThreadPriority( XThreadPriority priority )
+{
+    bool ret = false;
+
+    if ( priority == XThreadPriority::RealTime )
+    {
+        struct sched_param param;
+
+        param.sched_priority = ( sched_get_priority_min( SCHED_FIFO ) + sched_get_priority_max( SCHED_FIFO ) ) / 2;
+        ret = ( pthread_setschedparam( pthread_self( ), SCHED_FIFO, &param ) == 0 );
+    }
+    else
+    {
+#ifdef __linux__
+        // nice values matching priorities from idle to highest
+        static const int niceValues[] = { 19, 10, 5, 0, -5, -10 };
+        struct sched_param param;
+
+        // make sure the thread is not real time any more
+        param.sched_priority = 0;
+        pthread_setschedparam( pthread_self( ), SCHED_OTHER, &param );
+
+        // on Linux nice value is set per thread, not for entire process
+        ret = ( setpriority( PRIO_PROCESS, static_cast<id_t>( syscall( SYS_gettid ) ),
+                             niceValues[static_cast<int>( priority )] ) == 0 );
+#endif
+    }
+
+    return ret;
+}
+
+// Set CPUs the current thread is allowed to run on
+bool XThreadImpl::SetCurrentThreadAffinity( const std::vector<uint32_t>& cpus )
+{
+    bool ret = false;
+
+#ifdef __linux__
+    uint32_t maxCpu = 0;
+
+    for ( uint32_t cpu : cpus )
+    {
+        maxCpu = ( cpu > maxCpu ) ? cpu : maxCpu;
+    }
+
+    // allocate CPU set dynamically, since there can be more CPUs than fixed size set can keep
+    cpu_set_t* cpuSet  = CPU_ALLOC( maxCpu + 1 );
+    size_t     setSize = CPU_ALLOC_SIZE( maxCpu + 1 );
+
+    if ( cpuSet != nullptr )
+    {
+        CPU_ZERO_S( setSize, cpuSet );
+
+        for ( uint32_t cpu : cpus )
+        {
+            CPU_SET_S( cpu, setSize, cpuSet );
+        }
+
+        ret = ( pthread_setaffinity_np( pthread_self( ), setSize, cpuSet ) == 0 );
+
+        CPU_FREE( cpuSet );
+    }
+#else
+    (void) cpus;
+#endif
+
+    return ret;
+}
+
+// Bind current thread to CPUs of the NUMA node and allocate its memory from the node
+bool XThreadImpl::SetCurrentThreadNumaNode( uint32_t node )
+{
+    bool ret = false;
+
+#ifdef __linux__
+    std::vector<uint32_t> cpus;
+
+    if ( ( GetNumaNodeCpus( node, cpus ) ) && ( SetCurrentThreadAffinity( cpus ) ) )
+    {
+        // memory is taken from the node as long as it has some, but can come from others when it has not
+        unsigned long nodeMask[16] = { 0 };
+        unsigned long maxNode      = sizeof( nodeMask ) * 8;
+
+        if ( node < maxNode )
+        {
+            nodeMask[node / ( sizeof( unsigned long ) * 8 )] = 1ul << ( node % ( sizeof( unsigned long ) * 8 ) );
+            ret = ( syscall( SYS_set_mempolicy, MPOL_PREFERRED, nodeMask, maxNode ) == 0 );
+        }
+    }
+#else
+    (void) node;
+#endif
+
+    return ret;
+}
+
+// Get CPUs of the NUMA node
+bool XThreadImpl::GetNumaNodeCpus( uint32_t node, std::vector<uint32_t>& cpus )
+{
+    bool ret = false;
+
+    cpus.clear( );
+
+#ifdef __linux__
+    char  fileName[64];
+    char  cpuList[1024];
+    FILE* file;
+
+    sprintf( fileName, "/sys/devices/system/node/node%u/cpulist", node );
+
+    file = fopen( fileName, "r" );
+
+    if ( file != nullptr )
+    {
+        size_t read = fread( cpuList, 1, sizeof( cpuList ) - 1, file );
+
+        fclose( file );
+        cpuList[read] = '\0';
+
+        ret = ( ( XThread::ParseCpuList( cpuList, cpus ) ) && ( !cpus.empty( ) ) );
+    }
+#else
+    (void) node;
+#endif
+
+    return ret;
+}
+
+// Set name of the current thread
+bool XThreadImpl::SetCurrentThreadName( const std::string& name )
+{
+    bool ret = false;
+
+#ifdef __linux__
+    // Linux limits thread names to 15 characters
+    ret = ( pthread_setname_np( pthread_self( ), name.substr( 0, 15 ).c_str( ) ) == 0 );
+#else
+    (void) name;
+#endif
+
+    return ret;
+}
+
+// Get number of CPUs available in the system
+uint32_t XThreadImpl::CpuCount( )
+{
+    long count = sysconf( _SC_NPROCESSORS_ONLN );
+    return ( count > 0 ) ? static_cast<uint32_t>( count ) : 1;
+}
+
 } } } // namespace CVSandbox::Threading::Private
@@ -184,4 +184,121 @@ uint32_t XThreadImpl::ThreadId( )
     return static_cast<uint32_t>( GetCurrentThreadId( ) );
 }
 
+// Set scheduling priority of the current thread
+bool XThreadImpl::SetCurrentThreadPriority( XThreadPriority priority )
+{
+    static const int priorities[] =
+    {
+        THREAD_PRIORITY_IDLE, THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_BELOW_NORMAL, THREAD_PRIORITY_NORMAL,
+        THREAD_PRIORITY_ABOVE_NORMAL, THREAD_PRIORITY_HIGHEST, THREAD_PRIORITY_TIME_CRITICAL
+    };
+
+    return ( SetThreadPriority( GetCurrentThread( ), priorities[static_cast<int>( priority )] ) != FALSE );
+}
+
+// Set CPUs the current thread is allowed to run on
+bool XThreadImpl::SetCurrentThreadAffinity( const std::vector<uint32_t>& cpus )
+{
+    DWORD_PTR mask = 0;
+    bool      ret  = true;
+
+    // only CPUs of the first processor group can be used
+    for ( uint32_t cpu : cpus )
+    {
+        if ( cpu >= sizeof( DWORD_PTR ) * 8 )
+        {
+            ret = false;
+        }
+        else
+        {
+            mask |= static_cast<DWORD_PTR>( 1 ) << cpu;
+        }
+    }
+
+    if ( ret )
+    {
+        ret = ( SetThreadAffinityMask( GetCurrentThread( ), mask ) != 0 );
+    }
+
+    return ret;
+}
+
+// Bind current thread to CPUs of the NUMA node and allocate its memory from the node
+bool XThreadImpl::SetCurrentThreadNumaNode( uint32_t node )
+{
+    ULONGLONG mask = 0;
+    bool      ret  = false;
+
+    // system allocates memory from the node of the CPU thread runs on, so setting affinity is enough
+    if ( ( node <= 0xFF ) && ( GetNumaNodeProcessorMask( static_cast<UCHAR>( node ), &mask ) ) && ( mask != 0 ) )
+    {
+        ret = ( SetThreadAffinityMask( GetCurrentThread( ), static_cast<DWORD_PTR>( mask ) ) != 0 );
+    }
+
+    return ret;
+}
+
+// Get CPUs of the NUMA node
+bool XThreadImpl::GetNumaNodeCpus( uint32_t node, std::vector<uint32_t>& cpus )
+{
+    ULONGLONG mask = 0;
+    bool      ret  = false;
+
+    cpus.clear( );
+
+    if ( ( node <= 0xFF ) && ( GetNumaNodeProcessorMask( static_cast<UCHAR>( node ), &mask ) ) )
+    {
+        for ( uint32_t cpu = 0; cpu < sizeof( mask ) * 8; cpu++ )
+        {
+            if ( ( mask & ( static_cast<ULONGLONG>( 1 ) << cpu ) ) != 0 )
+            {
+                cpus.push_back( cpu );
+            }
+        }
+
+        ret = ( !cpus.empty( ) );
+    }
+
+    return ret;
+}
+
+// Set name of the current thread
+bool XThreadImpl::SetCurrentThreadName( const std::string& name )
+{
+    typedef HRESULT ( WINAPI *SetThreadDescriptionProc )( HANDLE, PCWSTR );
+
+    // the API is available starting from Windows 10 only, so it is resolved dynamically
+    static SetThreadDescriptionProc setThreadDescription = reinterpret_cast<SetThreadDescriptionProc>(
+        GetProcAddress( GetModuleHandleW( L"kernel32.dll" ), "SetThreadDescription" ) );
+
+    bool ret = false;
+
+    if ( setThreadDescription != nullptr )
+    {
+        int charsRequired = MultiByteToWideChar( CP_UTF8, 0, name.c_str( ), -1, NULL, 0 );
+
+        if ( charsRequired > 0 )
+        {
+            std::vector<wchar_t> wName( charsRequired );
+
+            if ( MultiByteToWideChar( CP_UTF8, 0, name.c_str( ), -1, wName.data( ), charsRequired ) > 0 )
+            {
+                ret = SUCCEEDED( setThreadDescription( GetCurrentThread( ), wName.data( ) ) );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Get number of CPUs available in the system
+uint32_t XThreadImpl::CpuCount( )
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo( &info );
+
+    return static_cast<uint32_t>( info.dwNumberOfProcessors );
+}
+
 } } } // namespace CVSandbox::Threading::Private
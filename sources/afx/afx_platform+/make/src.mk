@@ -4,8 +4,9 @@
 VPATH = ../../ ../../internal
 
 # source files
-SRC =  XMutex.cpp XThread.cpp XManualResetEvent.cpp XTimer.cpp \
-       XMutexImpl_Win32.cpp XThreadImpl_Win32.cpp XManualResetEventImpl_Win32.cpp XTimerImpl_Win32.cpp
+SRC =  XMutex.cpp XThread.cpp XManualResetEvent.cpp XAutoResetEvent.cpp XSemaphore.cpp XTimer.cpp \
+       XMutexImpl_Win32.cpp XThreadImpl_Win32.cpp XManualResetEventImpl_Win32.cpp XAutoResetEventImpl_Win32.cpp \
+       XSemaphoreImpl_Win32.cpp XTimerImpl_Win32.cpp
 
 # additional include folders
 INCLUDES += -I../../../afx_types -I../../../afx_types+
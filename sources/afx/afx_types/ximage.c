@@ -42,7 +42,9 @@ static char* pixelFormatNames[] =
     "32bpp Grayscale",
     "64bpp Grayscale",
     "R4 Grayscale",
-    "JPEG encoded"
+    "JPEG encoded",
+    "12bpp YUV 4:2:0",
+    "12bpp NV12"
 };
 
 // Pixel format short names (suitable for serialization, scripting, etc.)
@@ -63,7 +65,9 @@ static char* pixelFormatShortNames[] =
     "Gray32",
     "Gray64",
     "GrayR4",
-    "JPEG"
+    "JPEG",
+    "YUV420",
+    "NV12"
 };
 
 // Supported image size names
@@ -75,10 +79,10 @@ static char* supportedImageSizeNames[] =
     "Equal or Smaller"
 };
 
-// Returns number of bits required for pixel in certain format
+// Returns number of bits required for pixel in certain format (for planar YUV formats it is size of luminance pixel)
 uint32_t XImageBitsPerPixel( XPixelFormat format )
 {
-    static int sizes[] = { 0, 8, 24, 32, 16, 48, 64, 1, 1, 2, 4, 8, 32, 64, sizeof( float ) * 8, 8 };
+    static int sizes[] = { 0, 8, 24, 32, 16, 48, 64, 1, 1, 2, 4, 8, 32, 64, sizeof( float ) * 8, 8, 8, 8 };
 
     return ( format >= XARRAY_SIZE( sizes ) ) ? 0 : sizes[format];
 }
@@ -104,6 +108,90 @@ bool XImageIsPixelFormatIndexed( XPixelFormat format )
              ( format == XPixelFormatIndexed8 ) ) ? true : false;
 }
 
+// Check if the specified pixel format is planar YUV (luminance plane followed by chroma planes) or not
+bool XImageIsPixelFormatPlanar( XPixelFormat format )
+{
+    return ( ( format == XPixelFormatYUV420 ) ||
+             ( format == XPixelFormatNV12 ) ) ? true : false;
+}
+
+// Get number of planes kept by images of the specified pixel format (1 for all non planar formats)
+uint32_t XImageGetPlanesCount( XPixelFormat format )
+{
+    uint32_t ret = 1;
+
+    if ( format == XPixelFormatYUV420 )
+    {
+        ret = 3;
+    }
+    else if ( format == XPixelFormatNV12 )
+    {
+        ret = 2;
+    }
+
+    return ret;
+}
+
+// Get size of memory buffer required to keep image of the specified height/stride/format (all planes included)
+uint32_t XImageGetBufferSize( int32_t height, int32_t stride, XPixelFormat format )
+{
+    uint32_t ret = (uint32_t) height * stride;
+
+    if ( format == XPixelFormatYUV420 )
+    {
+        ret += (uint32_t) ( ( height + 1 ) / 2 ) * ( stride / 2 ) * 2;
+    }
+    else if ( format == XPixelFormatNV12 )
+    {
+        ret += (uint32_t) ( ( height + 1 ) / 2 ) * stride;
+    }
+
+    return ret;
+}
+
+// Get location and size of the specified plane of an image
+static bool XImageGetPlaneLayout( const ximage* image, uint32_t planeIndex, uint8_t** data,
+                                  int32_t* width, int32_t* height, int32_t* stride )
+{
+    bool ret = true;
+
+    if ( planeIndex == 0 )
+    {
+        *data   = image->data;
+        *width  = image->width;
+        *height = image->height;
+        *stride = image->stride;
+    }
+    else if ( planeIndex >= XImageGetPlanesCount( image->format ) )
+    {
+        ret = false;
+    }
+    else
+    {
+        int32_t chromaWidth  = ( image->width  + 1 ) / 2;
+        int32_t chromaHeight = ( image->height + 1 ) / 2;
+
+        *data   = image->data + image->height * image->stride;
+        *height = chromaHeight;
+
+        if ( image->format == XPixelFormatYUV420 )
+        {
+            // U plane goes first, then V plane
+            *width  = chromaWidth;
+            *stride = image->stride / 2;
+            *data  += ( planeIndex - 1 ) * chromaHeight * ( *stride );
+        }
+        else
+        {
+            // interleaved U/V samples
+            *width  = chromaWidth * 2;
+            *stride = image->stride;
+        }
+    }
+
+    return ret;
+}
+
 // Get name of the pixel format
 xstring XImageGetPixelFormatName( XPixelFormat format )
 {
@@ -209,6 +297,11 @@ XErrorCode XImageCreate( uint8_t* data, int32_t width, int32_t height, int32_t s
     {
         ret = ErrorUnsupportedPixelFormat;
     }
+    else if ( ( XImageIsPixelFormatPlanar( format ) ) && ( ( ( stride & 1 ) != 0 ) || ( stride < ( ( width + 1 ) & ~1 ) ) ) )
+    {
+        // chroma planes must fit into half of the stride
+        ret = ErrorInvalidArgument;
+    }
     else
     {
         ximage* temp = (ximage*) XMAlloc( sizeof( ximage ) );
@@ -269,14 +362,21 @@ static XErrorCode XImageAllocate_Internal( int32_t width, int32_t height, XPixel
 
                 if ( initBuffer == true )
                 {
-                    int32_t  stride   = temp->stride;
-                    int32_t  lineSize = XImageBytesPerLine( XImageBitsPerPixel( format ) * width );
-                    int32_t  y;
-                    uint8_t* ptr      = temp->data;
+                    uint32_t planesCount = XImageGetPlanesCount( format );
+                    uint32_t plane;
 
-                    for ( y = 0; y < height; y++ )
+                    for ( plane = 0; plane < planesCount; plane++ )
                     {
-                        memset( ptr + y * stride, 0, lineSize );
+                        int32_t  planeWidth, planeHeight, stride, lineSize, y;
+                        uint8_t* ptr;
+
+                        XImageGetPlaneLayout( temp, plane, &ptr, &planeWidth, &planeHeight, &stride );
+                        lineSize = XImageBytesPerLine( XImageBitsPerPixel( format ) * planeWidth );
+
+                        for ( y = 0; y < planeHeight; y++ )
+                        {
+                            memset( ptr + y * stride, 0, lineSize );
+                        }
                     }
                 }
             }
@@ -307,11 +407,11 @@ static XErrorCode XImageAllocate_Internal( int32_t width, int32_t height, XPixel
 
                 if ( initBuffer == true )
                 {
-                    temp->data = (uint8_t*) XCAlloc( 1, height * temp->stride );
+                    temp->data = (uint8_t*) XCAlloc( 1, XImageGetBufferSize( height, temp->stride, format ) );
                 }
                 else
                 {
-                    temp->data = (uint8_t*) XMAlloc( height * temp->stride );
+                    temp->data = (uint8_t*) XMAlloc( XImageGetBufferSize( height, temp->stride, format ) );
                 }
 
                 if ( temp->data == 0 )
@@ -373,8 +473,8 @@ XErrorCode XImageCopyData( const ximage* src, ximage* dst )
     {
         ret = ErrorImageParametersMismatch;
     }
-    else if ( ( ( src->format != XPixelFormatJPEG ) && ( src->width != dst->width ) ) ||
-              ( ( src->format != XPixelFormatJPEG ) && ( src->stride > dst->stride ) ) )
+    // strides may differ though, since only content of image lines is copied (allows copying sub-image views)
+    else if ( ( src->format != XPixelFormatJPEG ) && ( src->width != dst->width ) )
     {
         ret = ErrorImageParametersMismatch;
     }
@@ -450,8 +550,32 @@ XErrorCode XImageCopyData( const ximage* src, ximage* dst )
             }
         }
 
+        // copy chroma planes of planar YUV images
+        if ( XImageIsPixelFormatPlanar( src->format ) )
+        {
+            uint32_t planesCount = XImageGetPlanesCount( src->format );
+            uint32_t plane;
+
+            for ( plane = 1; plane < planesCount; plane++ )
+            {
+                int32_t planeWidth, srcPlaneStride, dstPlaneStride;
+
+                XImageGetPlaneLayout( src, plane, &srcPtr, &planeWidth, &height, &srcPlaneStride );
+                XImageGetPlaneLayout( dst, plane, &dstPtr, &planeWidth, &height, &dstPlaneStride );
+
+                while ( height != 0 )
+                {
+                    memcpy( dstPtr, srcPtr, planeWidth );
+
+                    srcPtr += srcPlaneStride;
+                    dstPtr += dstPlaneStride;
+                    height--;
+                }
+            }
+        }
+
         // copy palette for indexed images
-        if ( ( src->format >= XPixelFormatIndexed1 ) && ( src->palette != 0 ) )
+        if ( ( XImageIsPixelFormatIndexed( src->format ) ) && ( src->palette != 0 ) )
         {
             XPalleteClone( src->palette, &(dst->palette) );
         }
@@ -521,6 +645,37 @@ XErrorCode XImageGetSubImage( const ximage* src, ximage** dst, int32_t x, int32_
     return ret;
 }
 
+// Get the specified plane of a planar YUV image as 8 bpp grayscale image (source image must stay alive because image data is not copied)
+XErrorCode XImageGetPlane( const ximage* src, ximage** dst, uint32_t planeIndex )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( dst == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( !XImageIsPixelFormatPlanar( src->format ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        uint8_t* data;
+        int32_t  width, height, stride;
+
+        if ( !XImageGetPlaneLayout( src, planeIndex, &data, &width, &height, &stride ) )
+        {
+            ret = ErrorArgumentOutOfRange;
+        }
+        else
+        {
+            ret = XImageCreate( data, width, height, stride, XPixelFormatGrayscale8, dst );
+        }
+    }
+
+    return ret;
+}
+
 // Put source image data into the target at the specified location (images must of same pixel format)
 XErrorCode XImagePutImage( ximage* dst, const ximage* src, int32_t x, int32_t y )
 {
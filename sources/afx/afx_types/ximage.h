@@ -78,6 +78,15 @@ enum
                                 // Width of an image is the size of JPEG encoded image. Height is always set to 1.
                                 // Stride is set to the size of allocated buffer.
 
+    XPixelFormatYUV420,         // 12 bpp planar YUV 4:2:0 (I420) image. All planes are kept in a single buffer: 8 bpp Y plane of
+                                // height lines of stride bytes, followed by U and then V plane - each of (height+1)/2 lines of
+                                // stride/2 bytes. Stride must be even and big enough to keep (width+1)/2 chroma samples per line.
+                                //
+                                // Since data/stride describe the Y plane, it can be accessed as 8 bpp grayscale image.
+    XPixelFormatNV12,           // 12 bpp semi-planar YUV 4:2:0 image. Same as above, but the Y plane is followed by a single
+                                // plane of interleaved U/V samples - (height+1)/2 lines of stride bytes.
+
+
     XPixelFormatLastValue       // Last value in the enum
 };
 typedef uint32_t XPixelFormat;
@@ -143,6 +152,12 @@ uint32_t XImageBytesPerStride( uint32_t bitsPerLine );
 uint32_t XImageBytesPerLine( uint32_t bitsPerLine );
 // Check if the specified pixel format is indexed (requires palette) or not
 bool XImageIsPixelFormatIndexed( XPixelFormat format );
+// Check if the specified pixel format is planar YUV (luminance plane followed by chroma planes) or not
+bool XImageIsPixelFormatPlanar( XPixelFormat format );
+// Get number of planes kept by images of the specified pixel format (1 for all non planar formats)
+uint32_t XImageGetPlanesCount( XPixelFormat format );
+// Get size of memory buffer required to keep image of the specified height/stride/format (all planes included)
+uint32_t XImageGetBufferSize( int32_t height, int32_t stride, XPixelFormat format );
 // Get name of the pixel format
 xstring XImageGetPixelFormatName( XPixelFormat format );
 // Get short name of the pixel format
@@ -178,6 +193,9 @@ XErrorCode XImageCopyData( const ximage* src, ximage* dst );
 XErrorCode XImageClone( const ximage* src, ximage** dst );
 // Get sub image of the specified source image (source image must stay alive because image data is not copied)
 XErrorCode XImageGetSubImage( const ximage* src, ximage** dst, int32_t x, int32_t y, int32_t width, int32_t height );
+// Get the specified plane of a planar YUV image as 8 bpp grayscale image (source image must stay alive because image data is not copied).
+// Plane 0 is luminance; then U and V planes for YUV420 or interleaved U/V plane for NV12 (width is twice the number of chroma samples)
+XErrorCode XImageGetPlane( const ximage* src, ximage** dst, uint32_t planeIndex );
 // Put source image data into the target at the specified location (images must of same pixel format)
 XErrorCode XImagePutImage( ximage* dst, const ximage* src, int32_t x, int32_t y );
 
@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include "xvision.h"
 
 // Build integral image for the specified image (RGB channel must be specified for color images)
@@ -215,3 +216,140 @@ XErrorCode BuildIntegralImage2( const ximage* image, ximage* integralImage, xima
 
     return ret;
 }
+
+// Number of columns processed by a thread while accumulating integral image vertically
+#define INTEGRAL_COLUMNS_BLOCK (256)
+
+// Build 64 bit integral image and optionally squared integral image (RGB channel must be specified for color images)
+XErrorCode BuildIntegralImage64( const ximage* image, ximage* integralImage, ximage* sqIntegralImage, XRGBComponent rgbChannel )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image == 0 ) || ( integralImage == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( ( image->format != XPixelFormatGrayscale8 ) &&
+                ( image->format != XPixelFormatRGB24 ) &&
+                ( image->format != XPixelFormatRGBA32 ) ) ||
+                ( integralImage->format != XPixelFormatGrayscale64 ) ||
+              ( ( sqIntegralImage != 0 ) && ( sqIntegralImage->format != XPixelFormatGrayscale64 ) ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( image->format != XPixelFormatGrayscale8 ) && ( rgbChannel >= AlphaIndex ) )
+    {
+        ret = ErrorInvalidArgument;
+    }
+    else if ( ( image->width  + 1 != integralImage->width  ) ||
+              ( image->height + 1 != integralImage->height ) ||
+              ( ( sqIntegralImage != 0 ) &&
+                ( ( integralImage->width  != sqIntegralImage->width  ) ||
+                  ( integralImage->height != sqIntegralImage->height ) ) ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+    else
+    {
+        int pixelSize   = ( image->format == XPixelFormatGrayscale8 ) ? 1 :
+                          ( image->format == XPixelFormatRGB24 ) ? 3 : 4;
+        int width       = image->width;
+        int height      = image->height;
+        int stride      = image->stride;
+        int intStride   = integralImage->stride;
+        int sqIntStride = ( sqIntegralImage != 0 ) ? sqIntegralImage->stride : 0;
+        int blocksCount = ( width + 1 + INTEGRAL_COLUMNS_BLOCK - 1 ) / INTEGRAL_COLUMNS_BLOCK;
+        int y, block;
+
+        uint8_t*  src       = image->data;
+        uint8_t*  intData   = integralImage->data;
+        uint8_t*  sqIntData = ( sqIntegralImage != 0 ) ? sqIntegralImage->data : 0;
+
+        // align to required RGB channel for color images
+        if ( image->format != XPixelFormatGrayscale8 )
+        {
+            src += rgbChannel;
+        }
+
+        // fill the first row of integral images with 0
+        memset( intData, 0, ( width + 1 ) * sizeof( uint64_t ) );
+        if ( sqIntData != 0 )
+        {
+            memset( sqIntData, 0, ( width + 1 ) * sizeof( uint64_t ) );
+        }
+
+        // 1st pass - prefix sums of each row, which are independent of each other
+        #pragma omp parallel for schedule(static) shared( src, intData, sqIntData, width, stride, intStride, sqIntStride, pixelSize )
+        for ( y = 0; y < height; y++ )
+        {
+            const uint8_t* srcRow = src + y * stride;
+            uint64_t*      intRow = (uint64_t*) ( intData + ( y + 1 ) * intStride );
+            uint64_t       rowSum = 0;
+            int            i;
+
+            intRow[0] = 0;
+
+            if ( sqIntData == 0 )
+            {
+                for ( i = 1; i <= width; i++, srcRow += pixelSize )
+                {
+                    rowSum   += *srcRow;
+                    intRow[i] = rowSum;
+                }
+            }
+            else
+            {
+                uint64_t* sqIntRow = (uint64_t*) ( sqIntData + ( y + 1 ) * sqIntStride );
+                uint64_t  sqRowSum = 0;
+
+                sqIntRow[0] = 0;
+
+                for ( i = 1; i <= width; i++, srcRow += pixelSize )
+                {
+                    rowSum     += *srcRow;
+                    sqRowSum   += (uint32_t) *srcRow * *srcRow;
+                    intRow[i]   = rowSum;
+                    sqIntRow[i] = sqRowSum;
+                }
+            }
+        }
+
+        // 2nd pass - accumulate rows top to bottom; each thread takes a block of columns, so it goes through memory sequentially
+        #pragma omp parallel for schedule(static) shared( intData, sqIntData, width, height, intStride, sqIntStride )
+        for ( block = 0; block < blocksCount; block++ )
+        {
+            int xStart = block * INTEGRAL_COLUMNS_BLOCK;
+            int xEnd   = xStart + INTEGRAL_COLUMNS_BLOCK;
+            int i, j;
+
+            if ( xEnd > width + 1 )
+            {
+                xEnd = width + 1;
+            }
+
+            for ( j = 2; j <= height; j++ )
+            {
+                const uint64_t* prevRow = (const uint64_t*) ( intData + ( j - 1 ) * intStride );
+                uint64_t*       intRow  = (uint64_t*) ( intData + j * intStride );
+
+                for ( i = xStart; i < xEnd; i++ )
+                {
+                    intRow[i] += prevRow[i];
+                }
+
+                if ( sqIntData != 0 )
+                {
+                    const uint64_t* sqPrevRow = (const uint64_t*) ( sqIntData + ( j - 1 ) * sqIntStride );
+                    uint64_t*       sqIntRow  = (uint64_t*) ( sqIntData + j * sqIntStride );
+
+                    for ( i = xStart; i < xEnd; i++ )
+                    {
+                        sqIntRow[i] += sqPrevRow[i];
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
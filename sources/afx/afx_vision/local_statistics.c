@@ -0,0 +1,216 @@
+/*
+    Computer vision library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <math.h>
+#include "xvision.h"
+
+// Get sum (and optionally squared sum) of pixels in the window of the specified radius around pixel (x, y),
+// which is clipped by image boundaries. Returns number of pixels in the clipped window.
+static uint32_t GetWindowSums( const uint8_t* intData, int intStride, const uint8_t* sqIntData, int sqIntStride,
+                               int width, int height, int x, int y, int radius, uint64_t* sum, uint64_t* sqSum )
+{
+    int x1 = ( x - radius < 0 ) ? 0 : x - radius;
+    int y1 = ( y - radius < 0 ) ? 0 : y - radius;
+    int x2 = ( x + radius >= width  ) ? width  : x + radius + 1;
+    int y2 = ( y + radius >= height ) ? height : y + radius + 1;
+
+    const uint64_t* top    = (const uint64_t*) ( intData + y1 * intStride );
+    const uint64_t* bottom = (const uint64_t*) ( intData + y2 * intStride );
+
+    *sum = bottom[x2] - bottom[x1] - top[x2] + top[x1];
+
+    if ( sqIntData != 0 )
+    {
+        top    = (const uint64_t*) ( sqIntData + y1 * sqIntStride );
+        bottom = (const uint64_t*) ( sqIntData + y2 * sqIntStride );
+
+        *sqSum = bottom[x2] - bottom[x1] - top[x2] + top[x1];
+    }
+
+    return (uint32_t) ( ( x2 - x1 ) * ( y2 - y1 ) );
+}
+
+// Check arguments common for all local statistics routines
+static XErrorCode CheckLocalStatisticsArguments( const ximage* image, const ximage* integralImage, const ximage* sqIntegralImage, bool needSquared )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image == 0 ) || ( integralImage == 0 ) || ( ( needSquared ) && ( sqIntegralImage == 0 ) ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( image->format != XPixelFormatGrayscale8 ) ||
+              ( integralImage->format != XPixelFormatGrayscale64 ) ||
+              ( ( needSquared ) && ( sqIntegralImage->format != XPixelFormatGrayscale64 ) ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( ( image->width  + 1 != integralImage->width  ) ||
+              ( image->height + 1 != integralImage->height ) ||
+              ( ( needSquared ) &&
+                ( ( integralImage->width  != sqIntegralImage->width  ) ||
+                  ( integralImage->height != sqIntegralImage->height ) ) ) )
+    {
+        ret = ErrorImageParametersMismatch;
+    }
+
+    return ret;
+}
+
+// Apply Bradley local thresholding to a grayscale image using its 64 bit integral image
+XErrorCode BradleyLocalThresholding( ximage* image, const ximage* integralImage, uint32_t windowRadius, float brightnessDifferenceLimit )
+{
+    XErrorCode ret = CheckLocalStatisticsArguments( image, integralImage, 0, false );
+
+    if ( ret == SuccessCode )
+    {
+        int      width     = image->width;
+        int      height    = image->height;
+        int      stride    = image->stride;
+        int      intStride = integralImage->stride;
+        int      radius    = (int) windowRadius;
+        uint8_t* ptr       = image->data;
+        uint8_t* intData   = integralImage->data;
+        // pixel is set to black if it is darker than local mean by the specified limit; keep the limit in 1/1024 fixed point
+        uint64_t avgBrightnessPart = (uint64_t) ( ( 1.0f - brightnessDifferenceLimit ) * 1024 );
+        int      y;
+
+        #pragma omp parallel for schedule(static) shared( ptr, intData, width, height, stride, intStride, radius, avgBrightnessPart )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row = ptr + y * stride;
+            uint64_t sum, sqSum;
+            int      x;
+
+            for ( x = 0; x < width; x++ )
+            {
+                uint32_t count = GetWindowSums( intData, intStride, 0, 0, width, height, x, y, radius, &sum, &sqSum );
+
+                row[x] = ( (uint64_t) row[x] * count * 1024 < sum * avgBrightnessPart ) ? 0 : 255;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Apply Sauvola local thresholding to a grayscale image using its 64 bit integral and squared integral images
+XErrorCode SauvolaLocalThresholding( ximage* image, const ximage* integralImage, const ximage* sqIntegralImage,
+                                     uint32_t windowRadius, float k, float dynamicRange )
+{
+    XErrorCode ret = CheckLocalStatisticsArguments( image, integralImage, sqIntegralImage, true );
+
+    if ( ret == SuccessCode )
+    {
+        int      width       = image->width;
+        int      height      = image->height;
+        int      stride      = image->stride;
+        int      intStride   = integralImage->stride;
+        int      sqIntStride = sqIntegralImage->stride;
+        int      radius      = (int) windowRadius;
+        uint8_t* ptr         = image->data;
+        uint8_t* intData     = integralImage->data;
+        uint8_t* sqIntData   = sqIntegralImage->data;
+        int      y;
+
+        if ( dynamicRange <= 0.0f )
+        {
+            dynamicRange = 128.0f;
+        }
+
+        #pragma omp parallel for schedule(static) shared( ptr, intData, sqIntData, width, height, stride, intStride, sqIntStride, radius, k, dynamicRange )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row = ptr + y * stride;
+            uint64_t sum, sqSum;
+            int      x;
+
+            for ( x = 0; x < width; x++ )
+            {
+                uint32_t count    = GetWindowSums( intData, intStride, sqIntData, sqIntStride, width, height, x, y, radius, &sum, &sqSum );
+                double   mean     = (double) sum / count;
+                double   variance = (double) sqSum / count - mean * mean;
+                double   stdDev   = ( variance > 0.0 ) ? sqrt( variance ) : 0.0;
+                double   threshold = mean * ( 1.0 + k * ( stdDev / dynamicRange - 1.0 ) );
+
+                row[x] = ( row[x] <= threshold ) ? 0 : 255;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Replace each pixel of a grayscale image with the specified statistics of its local window using 64 bit integral images
+XErrorCode LocalWindowStatistics( ximage* image, const ximage* integralImage, const ximage* sqIntegralImage,
+                                  uint32_t windowRadius, XLocalStatistics statistics )
+{
+    bool       needSquared = ( statistics != LocalStatistics_Mean );
+    XErrorCode ret         = CheckLocalStatisticsArguments( image, integralImage, sqIntegralImage, needSquared );
+
+    if ( ( ret == SuccessCode ) && ( statistics > LocalStatistics_Variance ) )
+    {
+        ret = ErrorInvalidArgument;
+    }
+
+    if ( ret == SuccessCode )
+    {
+        int      width       = image->width;
+        int      height      = image->height;
+        int      stride      = image->stride;
+        int      intStride   = integralImage->stride;
+        int      sqIntStride = ( needSquared ) ? sqIntegralImage->stride : 0;
+        int      radius      = (int) windowRadius;
+        uint8_t* ptr         = image->data;
+        uint8_t* intData     = integralImage->data;
+        uint8_t* sqIntData   = ( needSquared ) ? sqIntegralImage->data : 0;
+        int      y;
+
+        #pragma omp parallel for schedule(static) shared( ptr, intData, sqIntData, width, height, stride, intStride, sqIntStride, radius, statistics )
+        for ( y = 0; y < height; y++ )
+        {
+            uint8_t* row = ptr + y * stride;
+            uint64_t sum, sqSum;
+            int      x;
+
+            for ( x = 0; x < width; x++ )
+            {
+                uint32_t count = GetWindowSums( intData, intStride, sqIntData, sqIntStride, width, height, x, y, radius, &sum, &sqSum );
+
+                if ( statistics == LocalStatistics_Mean )
+                {
+                    row[x] = (uint8_t) ( ( sum + count / 2 ) / count );
+                }
+                else
+                {
+                    // count^2 * variance = count * sqSum - sum^2, which is exact in integer arithmetic
+                    uint64_t scaledVariance = (uint64_t) count * sqSum - sum * sum;
+                    double   variance       = (double) scaledVariance / ( (double) count * count );
+                    double   value          = ( statistics == LocalStatistics_Variance ) ? variance : sqrt( variance );
+
+                    row[x] = ( value >= 255.0 ) ? 255 : (uint8_t) ( value + 0.5 );
+                }
+            }
+        }
+    }
+
+    return ret;
+}
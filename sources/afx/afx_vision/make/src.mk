@@ -4,7 +4,7 @@
 VPATH = ../../
 
 # source files
-SRC = barcode_detector.c glyph_detector.c integral_image.c
+SRC = barcode_detector.c glyph_detector.c integral_image.c local_statistics.c
 
 # additional include folders
 INCLUDES = -I../../../afx_types -I../../../afx_imaging
@@ -35,6 +35,32 @@ extern "C" {
 XErrorCode BuildIntegralImage( const ximage* image, ximage* integralImage, XRGBComponent rgbChannel );
 // Build integral and squared integral images for the specified image (RGB channel must be specified for color images)
 XErrorCode BuildIntegralImage2( const ximage* image, ximage* integralImage, ximage* sqIntegralImage, XRGBComponent rgbChannel );
+// Build 64 bit integral image and optionally squared integral image (RGB channel must be specified for color images).
+// Both integral images must be 64 bpp grayscale and one pixel wider/higher than the source image, squared one can be NULL.
+XErrorCode BuildIntegralImage64( const ximage* image, ximage* integralImage, ximage* sqIntegralImage, XRGBComponent rgbChannel );
+
+// ===== Local window statistics (constant time per pixel, using 64 bit integral images) =====
+
+// ===== Type of local window statistics =====
+enum
+{
+    LocalStatistics_Mean     = 0,
+    LocalStatistics_StdDev   = 1,
+    LocalStatistics_Variance = 2
+};
+typedef uint8_t XLocalStatistics;
+
+// Apply Bradley local thresholding to a grayscale image using its 64 bit integral image.
+// Pixels, which are darker than mean of the (windowRadius * 2 + 1) window by more than brightnessDifferenceLimit (fraction), are set to black.
+XErrorCode BradleyLocalThresholding( ximage* image, const ximage* integralImage, uint32_t windowRadius, float brightnessDifferenceLimit );
+// Apply Sauvola local thresholding to a grayscale image using its 64 bit integral and squared integral images.
+// Threshold is calculated as: mean * ( 1 + k * ( stdDev / dynamicRange - 1 ) )
+XErrorCode SauvolaLocalThresholding( ximage* image, const ximage* integralImage, const ximage* sqIntegralImage,
+                                     uint32_t windowRadius, float k, float dynamicRange );
+// Replace each pixel of a grayscale image with the specified statistics of its local window (values above 255 are clipped).
+// Squared integral image is not required for mean calculation.
+XErrorCode LocalWindowStatistics( ximage* image, const ximage* integralImage, const ximage* sqIntegralImage,
+                                  uint32_t windowRadius, XLocalStatistics statistics );
 
 // ===== Detection and tracking of square binary glyphs =====
 
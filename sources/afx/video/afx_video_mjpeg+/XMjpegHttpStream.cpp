@@ -27,6 +27,8 @@
 #include <XTimer.hpp>
 #include <ximaging_formats.h>
 
+#include <cstring>
+
 #include <curl/curl.h>
 #include "base64.hpp"
 #include "tools.hpp"
@@ -43,6 +45,18 @@ namespace CVSandbox { namespace Video { namespace MJpeg
 // Namespace with some private stuff to hide
 namespace Private
 {
+    // Number of buffers in the ring of received (but not yet decoded) JPEG frames. One is
+    // being decoded, one keeps the latest received frame and one is being filled by receiver.
+    static const int FrameBuffersCount = 3;
+
+    // Buffer keeping a single received JPEG frame
+    struct XJpegFrameBuffer
+    {
+        uint8_t*    Data;
+        uint32_t    Size;
+        uint32_t    Capacity;
+    };
+
     // Internal class which hides private parts of the XMjpegHttpStream class,
     // so those are not exposed in the main class
     class XMjpegHttpStreamData
@@ -54,8 +68,10 @@ namespace Private
             Sync( ), ExitEvent( ), BackgroundThread( ), FramesCounter( 0 ),
             TimeToSleepBeforeNextTry( 0 ), CommunicationBuffer( 0 ), CommunicationBufferSize( 0 ), DecodedImage( 0 ),
             ReadSoFar( 0 ), FailureDetected( false ), IsContentTypeChecked( false ), IsBoundaryChecked( false ),
-            JpegBoundaryLength( 0 ), JpegBoundary( 0 ), SearchStartIndex( 0 ), JpegImageStart( -1 )
+            JpegBoundaryLength( 0 ), JpegBoundary( 0 ), SearchStartIndex( 0 ), JpegImageStart( -1 ), JpegImageLength( -1 ),
+            FramesSync( ), NewFrameEvent( ), DecodingThread( ), LatestFrame( -1 ), DecodingFrame( -1 ), StopDecoding( false )
         {
+            memset( FrameBuffers, 0, sizeof( FrameBuffers ) );
         }
 
         ~XMjpegHttpStreamData( )
@@ -73,6 +89,7 @@ namespace Private
             JpegBoundaryLength   = 0;
             SearchStartIndex     = 0;
             JpegImageStart       = -1;
+            JpegImageLength      = -1;
 
             delete [] JpegBoundary;
             JpegBoundary         = nullptr;
@@ -81,9 +98,23 @@ namespace Private
         // Run video loop in a background worker thread
         static void WorkerThreadHandler( void* param );
 
+        // Decode received JPEG frames in a background thread
+        static void DecodingThreadHandler( void* param );
+
         // Notify about error in the video source
         void NotifyError( const string& errorMessage );
 
+        // Start/stop the thread decoding received frames
+        bool StartDecodingThread( );
+        void StopDecodingThread( );
+
+        // Queue JPEG image found in the communication buffer and remove it from there
+        void CompleteJpegImage( int jpegEnd );
+        // Put complete JPEG frame into the ring of buffers, so it is picked by decoding thread
+        bool QueueJpegFrame( const uint8_t* jpegData, uint32_t jpegSize );
+        // Decode queued JPEG frames and provide them to listener
+        void DecodeFrames( );
+
     public:
         string                MjpegUrl;
         string                UserName;
@@ -111,6 +142,16 @@ namespace Private
         uint8_t*              JpegBoundary;
         int                   SearchStartIndex;
         int                   JpegImageStart;
+        int                   JpegImageLength;
+
+        // receiving thread only frames JPEG images and the decoding one turns them into images
+        XMutex                FramesSync;
+        XManualResetEvent     NewFrameEvent;
+        XThread               DecodingThread;
+        XJpegFrameBuffer      FrameBuffers[FrameBuffersCount];
+        int                   LatestFrame;
+        int                   DecodingFrame;
+        bool                  StopDecoding;
 
 #ifdef DEBUG_MJPEG_STREAM
         FILE*                 DebugFile;
@@ -122,6 +163,8 @@ namespace Private
     // Magic word of JPEG image
     static const uint8_t JpegMagic[3]  = { 0xFF, 0xD8, 0xFF };
     static const int     JpegMagicSize = sizeof( JpegMagic );
+    // End of image marker
+    static const uint8_t JpegEndMagic[2] = { 0xFF, 0xD9 };
 
     // Initial/Maxim sizes of internal read buffer
     static const int InitialBufferSize = 512 * 1024;
@@ -133,6 +176,9 @@ namespace Private
     // Connection timeout value (in milliseconds)
     static const uint32_t ConnectionTimeoutMs = 10000;
 
+    // Time given to decoding thread to exit when video source is terminated
+    static const uint32_t DecodingThreadExitTimeoutMs = 1000;
+
     static size_t CurlReceiveHeadersCallback( void* buffer, size_t size, size_t nmemb, void* userp );
     // Callback function called by libcurl when data arrives
     static size_t CurlWriteMemoryCallback( void* contents, size_t size, size_t nmemb, void* userp );
@@ -217,18 +263,36 @@ bool XMjpegHttpStream::IsRunning( )
 // Terminate video source (call it ONLY as the last action of stopping video source, when nothing else helps)
 void XMjpegHttpStream::Terminate( )
 {
-    XScopedLock lock( &mData->Sync );
+    {
+        XScopedLock lock( &mData->Sync );
 
-    if ( IsRunning( ) )
+        if ( IsRunning( ) )
+        {
+            mData->BackgroundThread.Terminate( );
+        }
+    }
+
+    // the decoding thread is not stopped by the killed background thread, so ask it to exit
+    // and kill it as well only if it does not (it may be stuck in the listener)
+    if ( mData->DecodingThread.IsRunning( ) )
     {
-        mData->BackgroundThread.Terminate( );
+        {
+            XScopedLock lock( &mData->FramesSync );
+            mData->StopDecoding = true;
+            mData->NewFrameEvent.Signal( );
+        }
+
+        if ( !mData->DecodingThread.Join( Private::DecodingThreadExitTimeoutMs ) )
+        {
+            mData->DecodingThread.Terminate( );
+        }
     }
 }
 
 // Get number of frames received since the the start of the video source
 uint32_t XMjpegHttpStream::FramesReceived( )
 {
-    XScopedLock lock( &mData->Sync );
+    XScopedLock lock( &mData->FramesSync );
     return mData->FramesCounter;
 }
 
@@ -305,7 +369,15 @@ void XMjpegHttpStream::RunVideo( )
 {
     mData->CommunicationBuffer = (uint8_t*) malloc( Private::InitialBufferSize );
 
-    if ( mData->CommunicationBuffer != nullptr )
+    if ( mData->CommunicationBuffer == nullptr )
+    {
+        mData->NotifyError( "Fatal: Failed allocating communication buffer" );
+    }
+    else if ( !mData->StartDecodingThread( ) )
+    {
+        mData->NotifyError( "Fatal: Failed starting decoding thread" );
+    }
+    else
     {
         // initialize libcurl session
         CURL*           curl        = curl_easy_init( );
@@ -545,16 +617,13 @@ void XMjpegHttpStream::RunVideo( )
             curl_easy_cleanup( curl );
         }
 
-        free( mData->CommunicationBuffer );
+        mData->StopDecodingThread( );
+    }
 
-        mData->CommunicationBuffer     = nullptr;
-        mData->CommunicationBufferSize = 0;
+    free( mData->CommunicationBuffer );
 
-    }
-    else
-    {
-        mData->NotifyError( "Fatal: Failed allocating communication buffer" );
-    }
+    mData->CommunicationBuffer     = nullptr;
+    mData->CommunicationBufferSize = 0;
 
     XImageFree( &mData->DecodedImage );
 }
@@ -567,6 +636,170 @@ namespace Private
         static_cast<XMjpegHttpStream*>( param )->RunVideo( );
     }
 
+    // Decode received JPEG frames in a background thread
+    void XMjpegHttpStreamData::DecodingThreadHandler( void* param )
+    {
+        static_cast<XMjpegHttpStreamData*>( param )->DecodeFrames( );
+    }
+
+    // Start the thread decoding received frames
+    bool XMjpegHttpStreamData::StartDecodingThread( )
+    {
+        LatestFrame   = -1;
+        DecodingFrame = -1;
+        StopDecoding  = false;
+        NewFrameEvent.Reset( );
+
+        return DecodingThread.Create( DecodingThreadHandler, this );
+    }
+
+    // Stop the thread decoding received frames and release frame buffers
+    void XMjpegHttpStreamData::StopDecodingThread( )
+    {
+        {
+            XScopedLock lock( &FramesSync );
+            StopDecoding = true;
+            NewFrameEvent.Signal( );
+        }
+
+        DecodingThread.Join( );
+
+        for ( int i = 0; i < FrameBuffersCount; i++ )
+        {
+            free( FrameBuffers[i].Data );
+            FrameBuffers[i].Data     = nullptr;
+            FrameBuffers[i].Size     = 0;
+            FrameBuffers[i].Capacity = 0;
+        }
+    }
+
+    // Put complete JPEG frame into the ring of buffers, so it is picked by decoding thread
+    bool XMjpegHttpStreamData::QueueJpegFrame( const uint8_t* jpegData, uint32_t jpegSize )
+    {
+        int  bufferIndex = 0;
+        bool ret         = true;
+
+        {
+            XScopedLock lock( &FramesSync );
+
+            FramesCounter++;
+
+            // find a buffer which is neither being decoded, nor keeps the latest frame
+            while ( ( bufferIndex == LatestFrame ) || ( bufferIndex == DecodingFrame ) )
+            {
+                bufferIndex++;
+            }
+        }
+
+        // the buffer is not accessed by decoding thread, so can fill it without holding the lock
+        XJpegFrameBuffer* buffer = &FrameBuffers[bufferIndex];
+
+        if ( buffer->Capacity < jpegSize )
+        {
+            uint8_t* newData = (uint8_t*) realloc( buffer->Data, jpegSize );
+
+            if ( newData == nullptr )
+            {
+                ret = false;
+            }
+            else
+            {
+                buffer->Data     = newData;
+                buffer->Capacity = jpegSize;
+            }
+        }
+
+        if ( ret )
+        {
+            memcpy( buffer->Data, jpegData, jpegSize );
+            buffer->Size = jpegSize;
+
+            {
+                XScopedLock lock( &FramesSync );
+
+                // if decoder did not pick the previous frame yet, then it is just replaced with the newer one
+                LatestFrame = bufferIndex;
+                NewFrameEvent.Signal( );
+            }
+        }
+
+        return ret;
+    }
+
+    // Decode queued JPEG frames and provide them to listener
+    void XMjpegHttpStreamData::DecodeFrames( )
+    {
+        for ( ; ; )
+        {
+            int bufferIndex = -1;
+
+            NewFrameEvent.Wait( );
+
+            {
+                XScopedLock lock( &FramesSync );
+
+                if ( StopDecoding )
+                {
+                    break;
+                }
+
+                NewFrameEvent.Reset( );
+
+                // take the latest frame only - older ones were already overwritten
+                bufferIndex   = LatestFrame;
+                LatestFrame   = -1;
+                DecodingFrame = bufferIndex;
+            }
+
+            if ( bufferIndex != -1 )
+            {
+                XScopedLock lock( &Sync );
+
+                if ( Listener != nullptr )
+                {
+                    // decode image only if someone needs it
+                    XErrorCode ret = XDecodeJpegFromMemory( FrameBuffers[bufferIndex].Data,
+                                                            FrameBuffers[bufferIndex].Size, &DecodedImage );
+
+                    if ( ( ret == SuccessCode ) && ( !ExitEvent.IsSignaled( ) ) )
+                    {
+                        shared_ptr<const XImage> guardedImage = XImage::Create( DecodedImage );
+
+                        if ( guardedImage )
+                        {
+                            Listener->OnNewImage( guardedImage );
+                        }
+                    }
+                    else if ( ret != SuccessCode )
+                    {
+                        NotifyError( "Failed decoding JPEG image" );
+                    }
+                }
+            }
+
+            {
+                XScopedLock lock( &FramesSync );
+                DecodingFrame = -1;
+            }
+        }
+    }
+
+    // Queue JPEG image found in the communication buffer and remove it from there
+    void XMjpegHttpStreamData::CompleteJpegImage( int jpegEnd )
+    {
+        if ( !QueueJpegFrame( &( CommunicationBuffer[JpegImageStart] ), static_cast<uint32_t>( jpegEnd - JpegImageStart ) ) )
+        {
+            NotifyError( STR_MEMORY_ALLOCATION_ERROR );
+        }
+
+        memmove( CommunicationBuffer, &( CommunicationBuffer[jpegEnd] ), ReadSoFar - jpegEnd );
+
+        JpegImageStart   = -1;
+        JpegImageLength  = -1;
+        SearchStartIndex = 0;
+        ReadSoFar       -= jpegEnd;
+    }
+
     // Notify about error in the video source
     void XMjpegHttpStreamData::NotifyError( const string& errorMessage )
     {
@@ -717,89 +950,96 @@ namespace Private
                     }
                 }
 
-                // search for image start
-                if ( ( data->JpegImageStart == -1 ) && ( data->ReadSoFar - data->SearchStartIndex >= Private::JpegMagicSize ) )
-                {
-                    int index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
-                                         data->ReadSoFar - data->SearchStartIndex, Private::JpegMagic, Private::JpegMagicSize );
-
-                    if ( index != -1 )
-                    {
-                        data->JpegImageStart   = data->SearchStartIndex + index;
-                        data->SearchStartIndex = data->JpegImageStart + Private::JpegMagicSize;
-                    }
-                    else
-                    {
-                        data->SearchStartIndex = data->ReadSoFar - Private::JpegMagicSize + 1;
-                    }
-                }
+                // the received chunk may contain several complete frames, so keep
+                // extracting them until only incomplete one is left in the buffer
+                bool frameCompleted;
 
-                // search for image end (boundary start)
-                if ( ( data->JpegImageStart >= 0 ) && ( data->ReadSoFar - data->SearchStartIndex >= data->JpegBoundaryLength ) )
+                do
                 {
-                    int index = -1;
-
-                    if ( data->JpegBoundaryLength )
-                    {
-                        // search for the next boundary
-                        index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
-                                         data->ReadSoFar - data->SearchStartIndex, data->JpegBoundary, data->JpegBoundaryLength );
-                    }
-                    else
-                    {
-                        // if boundary between JPEG images is not known, then search for MAGIC of another JPEG
-                        index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
-                                         data->ReadSoFar - data->SearchStartIndex, Private::JpegMagic, Private::JpegMagicSize );
-                    }
+                    frameCompleted = false;
 
-                    if ( index != -1 )
+                    // search for image start
+                    if ( ( data->JpegImageStart == -1 ) && ( data->ReadSoFar - data->SearchStartIndex >= Private::JpegMagicSize ) )
                     {
-                        int jpegEnd = data->SearchStartIndex + index;
+                        int index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
+                                             data->ReadSoFar - data->SearchStartIndex, Private::JpegMagic, Private::JpegMagicSize );
 
+                        if ( index != -1 )
                         {
-                            XScopedLock lock( &data->Sync );
+                            data->JpegImageStart   = data->SearchStartIndex + index;
+                            data->SearchStartIndex = data->JpegImageStart + Private::JpegMagicSize;
 
-                            data->FramesCounter++;
+                            // if part's headers tell image size, then there is no need to search for its end
+                            data->JpegImageLength  = FindContentLength( data->CommunicationBuffer, data->JpegImageStart );
 
-                            if ( data->Listener != 0 )
+                            if ( data->JpegImageLength > MaxBufferSize )
                             {
-                                // decode image only if someone needs it
-                                XErrorCode ret = XDecodeJpegFromMemory( &( data->CommunicationBuffer[data->JpegImageStart] ),
-                                                                        jpegEnd - data->JpegImageStart, &data->DecodedImage );
-
-                                if ( ( ret == SuccessCode ) && ( !data->ExitEvent.IsSignaled( ) ) )
-                                {
-                                    shared_ptr<const XImage> guardedImage = XImage::Create( data->DecodedImage );
-
-                                    if ( guardedImage )
-                                    {
-                                        data->Listener->OnNewImage( guardedImage );
-                                    }
-                                }
-                                else
-                                {
-                                    data->NotifyError( "Failed decoding JPEG image" );
-                                }
+                                data->JpegImageLength = -1;
                             }
                         }
+                        else
+                        {
+                            data->SearchStartIndex = data->ReadSoFar - Private::JpegMagicSize + 1;
+                        }
+                    }
 
-                        memcpy( data->CommunicationBuffer, &( data->CommunicationBuffer[jpegEnd] ), data->ReadSoFar - jpegEnd );
+                    // check if image of known length was received completely
+                    if ( ( data->JpegImageStart >= 0 ) && ( data->JpegImageLength > JpegMagicSize ) &&
+                         ( data->ReadSoFar >= static_cast<uint32_t>( data->JpegImageStart + data->JpegImageLength ) ) )
+                    {
+                        int jpegEnd = data->JpegImageStart + data->JpegImageLength;
 
-                        data->JpegImageStart   = -1;
-                        data->SearchStartIndex = 0;
-                        data->ReadSoFar -= jpegEnd;
+                        // some cameras don't report the length correctly, so make sure the image ends with EOI marker
+                        if ( ( data->CommunicationBuffer[jpegEnd - 2] == JpegEndMagic[0] ) &&
+                             ( data->CommunicationBuffer[jpegEnd - 1] == JpegEndMagic[1] ) )
+                        {
+                            data->CompleteJpegImage( jpegEnd );
+                            frameCompleted = true;
+                        }
+                        else
+                        {
+                            // fall back to searching for the boundary
+                            data->JpegImageLength = -1;
+                        }
                     }
-                    else
+
+                    // search for image end (boundary start)
+                    if ( ( data->JpegImageStart >= 0 ) && ( data->JpegImageLength == -1 ) &&
+                         ( data->ReadSoFar - data->SearchStartIndex >= data->JpegBoundaryLength ) )
                     {
-                        // end of JPEG image was not found, so shift seach index
-                        data->SearchStartIndex = data->ReadSoFar;
+                        int index = -1;
 
-                        if ( data->JpegBoundaryLength != 0 )
+                        if ( data->JpegBoundaryLength )
                         {
-                            data->SearchStartIndex -= ( data->JpegBoundaryLength - 1 );
+                            // search for the next boundary
+                            index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
+                                             data->ReadSoFar - data->SearchStartIndex, data->JpegBoundary, data->JpegBoundaryLength );
+                        }
+                        else
+                        {
+                            // if boundary between JPEG images is not known, then search for MAGIC of another JPEG
+                            index = MemFind( &( data->CommunicationBuffer[data->SearchStartIndex] ),
+                                             data->ReadSoFar - data->SearchStartIndex, Private::JpegMagic, Private::JpegMagicSize );
+                        }
+
+                        if ( index != -1 )
+                        {
+                            data->CompleteJpegImage( data->SearchStartIndex + index );
+                            frameCompleted = true;
+                        }
+                        else
+                        {
+                            // end of JPEG image was not found, so shift seach index
+                            data->SearchStartIndex = data->ReadSoFar;
+
+                            if ( data->JpegBoundaryLength != 0 )
+                            {
+                                data->SearchStartIndex -= ( data->JpegBoundaryLength - 1 );
+                            }
                         }
                     }
                 }
+                while ( frameCompleted );
             }
         }
 
@@ -20,15 +20,40 @@
 */
 
 #include <string.h>
+#include <ctype.h>
+#include <xcpuid.h>
 #include "tools.hpp"
 
+// SSE intrinsics (the SIMD search is built only if the compiler targets SSE2)
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+    #include <intrin.h>
+    #define MEMFIND_SSE2
+#elif defined( __GNUC__ ) && defined( __SSE2__ )
+    #include <x86intrin.h>
+    #define MEMFIND_SSE2
+#endif
+
 using namespace std;
 
 namespace CVSandbox { namespace Video { namespace MJpeg { namespace Private
 {
 
-// Search buffer for specified sequence
-int MemFind( const uint8_t* buffer, int bufferSize, const uint8_t* searchFor, int searchSize )
+#ifdef MEMFIND_SSE2
+// Get index of the lowest set bit of a non zero mask
+static inline int LowestBitIndex( uint32_t mask )
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward( &index, mask );
+    return static_cast<int>( index );
+#else
+    return __builtin_ctz( mask );
+#endif
+}
+#endif
+
+// Search buffer for specified sequence using memchr() to find candidates
+static int MemFindScalar( const uint8_t* buffer, int bufferSize, const uint8_t* searchFor, int searchSize )
 {
     uint8_t* ptr;
     uint8_t* searchIn   = const_cast<uint8_t*>( buffer );
@@ -58,6 +83,105 @@ int MemFind( const uint8_t* buffer, int bufferSize, const uint8_t* searchFor, in
     return ret;
 }
 
+// Search buffer for specified sequence
+int MemFind( const uint8_t* buffer, int bufferSize, const uint8_t* searchFor, int searchSize )
+{
+    int ret   = -1;
+    int start = 0;
+
+#ifdef MEMFIND_SSE2
+    if ( ( searchSize > 1 ) && ( bufferSize >= searchSize ) && ( IsSSE2( ) ) )
+    {
+        // check first and last bytes of the sequence for 16 candidate positions at once,
+        // then compare the rest only for those positions where both match
+        __m128i firstByte  = _mm_set1_epi8( static_cast<char>( searchFor[0] ) );
+        __m128i lastByte   = _mm_set1_epi8( static_cast<char>( searchFor[searchSize - 1] ) );
+        int     candidates = bufferSize - searchSize + 1;
+
+        for ( ; ( ret == -1 ) && ( start + 16 <= candidates ); start += 16 )
+        {
+            __m128i  blockFirst = _mm_loadu_si128( (const __m128i*) ( buffer + start ) );
+            __m128i  blockLast  = _mm_loadu_si128( (const __m128i*) ( buffer + start + searchSize - 1 ) );
+            uint32_t mask       = static_cast<uint32_t>( _mm_movemask_epi8( _mm_and_si128(
+                                    _mm_cmpeq_epi8( blockFirst, firstByte ), _mm_cmpeq_epi8( blockLast, lastByte ) ) ) );
+
+            while ( mask != 0 )
+            {
+                int index = start + LowestBitIndex( mask );
+
+                if ( memcmp( buffer + index + 1, searchFor + 1, searchSize - 2 ) == 0 )
+                {
+                    ret = index;
+                    break;
+                }
+
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    // check whatever is left (or everything, if SSE2 is not available)
+    if ( ( ret == -1 ) && ( bufferSize - start >= searchSize ) )
+    {
+        ret = MemFindScalar( buffer + start, bufferSize - start, searchFor, searchSize );
+
+        if ( ret != -1 )
+        {
+            ret += start;
+        }
+    }
+
+    return ret;
+}
+
+// Search headers' block for "Content-Length:" field and return its value (-1 if not found)
+int FindContentLength( const uint8_t* buffer, int bufferSize )
+{
+    static const char* ContentLength       = "content-length:";
+    static const int   ContentLengthLength = 15;
+
+    int ret = -1;
+    int i, j;
+
+    for ( i = 0; i <= bufferSize - ContentLengthLength; i++ )
+    {
+        // header's name must start at the beginning of a line
+        if ( ( i != 0 ) && ( buffer[i - 1] != '\n' ) )
+        {
+            continue;
+        }
+
+        for ( j = 0; j < ContentLengthLength; j++ )
+        {
+            if ( tolower( buffer[i + j] ) != ContentLength[j] )
+            {
+                break;
+            }
+        }
+
+        if ( j == ContentLengthLength )
+        {
+            int value = 0;
+
+            for ( j = i + ContentLengthLength; ( j < bufferSize ) && ( ( buffer[j] == ' ' ) || ( buffer[j] == '\t' ) ); j++ );
+
+            if ( ( j < bufferSize ) && ( isdigit( buffer[j] ) ) )
+            {
+                for ( ; ( j < bufferSize ) && ( isdigit( buffer[j] ) ) && ( value < 100000000 ); j++ )
+                {
+                    value = value * 10 + ( buffer[j] - '0' );
+                }
+
+                ret = value;
+            }
+            break;
+        }
+    }
+
+    return ret;
+}
+
 // Extract title of HTTP document
 string ExtractTitle( const char* szHtml, bool* pIsHtml )
 {
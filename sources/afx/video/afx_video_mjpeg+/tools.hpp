@@ -32,6 +32,9 @@ namespace CVSandbox { namespace Video { namespace MJpeg { namespace Private
 // Search buffer for specified sequence
 int MemFind( const uint8_t* buffer, int bufferSize, const uint8_t* searchFor, int searchSize );
 
+// Search headers' block for "Content-Length:" field and return its value (-1 if not found)
+int FindContentLength( const uint8_t* buffer, int bufferSize );
+
 // Extract title of HTTP document
 std::string ExtractTitle( const char* szHtml, bool* pIsHtml );
 
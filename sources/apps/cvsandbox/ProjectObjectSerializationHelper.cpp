@@ -22,22 +22,28 @@
 #include "ProjectObjectSerializationHelper.hpp"
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
+#include <QStringList>
 #include "XGuidGenerator.hpp"
 
 using namespace std;
 using namespace CVSandbox;
 using namespace CVSandbox::Automation;
 
-static const QString STR_ID          = QString::fromUtf8( "Id" );
-static const QString STR_PROPERTY    = QString::fromUtf8( "Property" );
-static const QString STR_NAME        = QString::fromUtf8( "Name" );
-static const QString STR_DESCRIPTION = QString::fromUtf8( "Description" );
-static const QString STR_TYPE        = QString::fromUtf8( "Type" );
-static const QString STR_GRAPH       = QString::fromUtf8( "Graph" );
-static const QString STR_STEP        = QString::fromUtf8( "Step" );
-static const QString STR_PLUGIN      = QString::fromUtf8( "Plugin" );
-static const QString STR_THREAD      = QString::fromUtf8( "Thread" );
-static const QString STR_INTERVAL    = QString::fromUtf8( "Interval" );
+static const QString STR_ID             = QString::fromUtf8( "Id" );
+static const QString STR_PROPERTY       = QString::fromUtf8( "Property" );
+static const QString STR_NAME           = QString::fromUtf8( "Name" );
+static const QString STR_DESCRIPTION    = QString::fromUtf8( "Description" );
+static const QString STR_TYPE           = QString::fromUtf8( "Type" );
+static const QString STR_GRAPH          = QString::fromUtf8( "Graph" );
+static const QString STR_STEP           = QString::fromUtf8( "Step" );
+static const QString STR_PLUGIN         = QString::fromUtf8( "Plugin" );
+static const QString STR_THREAD         = QString::fromUtf8( "Thread" );
+static const QString STR_INTERVAL       = QString::fromUtf8( "Interval" );
+static const QString STR_REGION         = QString::fromUtf8( "Region" );
+static const QString STR_FRAME_INTERVAL = QString::fromUtf8( "FrameInterval" );
+static const QString STR_MAX_RATE       = QString::fromUtf8( "MaxRate" );
+static const QString STR_SKIP_ON_BUDGET = QString::fromUtf8( "SkipWhenOverBudget" );
+static const QString STR_TIME_BUDGET    = QString::fromUtf8( "TimeBudget" );
 
 // Find end element with the specified name (returns true if reader was at this element already)
 bool ProjectObjectSerializationHelper::FindEndElement( QXmlStreamReader& xmlReader, const QString& elementName )
@@ -164,6 +170,28 @@ void ProjectObjectSerializationHelper::SaveVideoProcessingStep(
     xmlWriter.writeStartElement( STR_STEP );
     xmlWriter.writeAttribute( STR_NAME, QString::fromUtf8( step.Name( ).c_str( ) ) );
 
+    // region of interest is saved only if set, so projects stay compatible with previous versions
+    if ( step.HasRegion( ) )
+    {
+        const xrect& region = step.Region( );
+
+        xmlWriter.writeAttribute( STR_REGION, QString( "%1,%2,%3,%4" ).arg( region.x1 ).arg( region.y1 ).arg( region.x2 ).arg( region.y2 ) );
+    }
+
+    // same about scheduling attributes
+    if ( step.FrameInterval( ) > 1 )
+    {
+        xmlWriter.writeAttribute( STR_FRAME_INTERVAL, QString::number( step.FrameInterval( ) ) );
+    }
+    if ( step.MaxRate( ) > 0.0f )
+    {
+        xmlWriter.writeAttribute( STR_MAX_RATE, QString::number( step.MaxRate( ) ) );
+    }
+    if ( step.SkipWhenOverBudget( ) )
+    {
+        xmlWriter.writeAttribute( STR_SKIP_ON_BUDGET, QString::fromUtf8( "true" ) );
+    }
+
     xmlWriter.writeStartElement( STR_PLUGIN );
     SavePluginConfiguration( xmlWriter, step.PluginId( ), step.PluginConfiguration( ) );
     xmlWriter.writeEndElement( );
@@ -180,7 +208,9 @@ bool ProjectObjectSerializationHelper::LoadVideoProcessingStep(
 
     if ( xmlReader.name( ) == STR_STEP )
     {
-        string stepName = xmlReader.attributes( ).value( STR_NAME ).toString( ).toUtf8( ).data( );
+        QXmlStreamAttributes xmlAttrs   = xmlReader.attributes( );
+        string               stepName   = xmlAttrs.value( STR_NAME ).toString( ).toUtf8( ).data( );
+        QStringList          regionList = xmlAttrs.value( STR_REGION ).toString( ).split( ',' );
 
         // read plug-in
         if ( ( xmlReader.readNextStartElement( ) ) && ( xmlReader.name( ) == STR_PLUGIN ) )
@@ -194,6 +224,17 @@ bool ProjectObjectSerializationHelper::LoadVideoProcessingStep(
             step = XVideoSourceProcessingStep( stepName, pluginId );
             step.SetPluginConfiguration( pluginConfiguration );
 
+            if ( regionList.size( ) == 4 )
+            {
+                xrect region = { regionList[0].toInt( ), regionList[1].toInt( ), regionList[2].toInt( ), regionList[3].toInt( ) };
+
+                step.SetRegion( region );
+            }
+
+            step.SetFrameInterval( xmlAttrs.value( STR_FRAME_INTERVAL ).toString( ).toUInt( ) );
+            step.SetMaxRate( xmlAttrs.value( STR_MAX_RATE ).toString( ).toFloat( ) );
+            step.SetSkipWhenOverBudget( xmlAttrs.value( STR_SKIP_ON_BUDGET ) == QString::fromUtf8( "true" ) );
+
             FindEndElement( xmlReader, STR_PLUGIN );
         }
 
@@ -210,6 +251,11 @@ void ProjectObjectSerializationHelper::SaveVideoProcessingGraph(
 {
     xmlWriter.writeStartElement( STR_GRAPH );
 
+    if ( graph.FrameTimeBudget( ) != 0 )
+    {
+        xmlWriter.writeAttribute( STR_TIME_BUDGET, QString::number( graph.FrameTimeBudget( ) ) );
+    }
+
     for ( XVideoSourceProcessingGraph::ConstIterator stepIt = graph.begin( ); stepIt != graph.end( ); ++stepIt )
     {
         SaveVideoProcessingStep( xmlWriter, *stepIt );
@@ -227,6 +273,8 @@ bool ProjectObjectSerializationHelper::LoadVideoProcessingGraph(
 
     if ( xmlReader.name( ) == STR_GRAPH )
     {
+        graph.SetFrameTimeBudget( xmlReader.attributes( ).value( STR_TIME_BUDGET ).toString( ).toUInt( ) );
+
         // read steps
         while ( xmlReader.readNextStartElement( ) )
         {
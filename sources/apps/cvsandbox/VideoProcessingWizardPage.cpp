@@ -221,7 +221,8 @@ VideoProcessingWizardPage::VideoProcessingWizardPage( QWidget* parent ) :
                                                          PluginType_ImageProcessingFilter |
                                                          PluginType_VideoProcessing |
                                                          PluginType_ScriptingEngine |
-                                                         PluginType_Detection );
+                                                         PluginType_Detection |
+                                                         PluginType_ImageProcessing );
 
     // attach context menus to the tree of available plug-in
     ui->availablePluginsListFrame->SetPluginsContextMenu( mData->AvailablePluginsContextMenu,
@@ -683,6 +684,7 @@ void VideoProcessingWizardPageData::ConfigureSelectedProcessingStep( )
                     case PluginType_ImageProcessingFilter:
                     case PluginType_VideoProcessing:
                     case PluginType_Detection:
+                    case PluginType_ImageProcessing:
                     case PluginType_ScriptingEngine:
 
                         ConfigurePluginPropertiesDialog configureForm( pluginDesc, plugin, false, UITools::GetParentDialog( Parent ) );
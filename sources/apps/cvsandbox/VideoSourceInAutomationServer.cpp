@@ -21,6 +21,10 @@
 
 #include <assert.h>
 #include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <XVideoFrameMailbox.hpp>
 #include "VideoSourceInAutomationServer.hpp"
 
 using namespace std;
@@ -28,9 +32,89 @@ using namespace CVSandbox;
 using namespace CVSandbox::Video;
 using namespace CVSandbox::Automation;
 
+namespace Private
+{
+    // Thread which takes the latest video frame from automation server's mailbox, when woken up,
+    // and passes it to video source listener
+    class VideoFrameDeliveryThread : public QThread
+    {
+    public:
+        VideoFrameDeliveryThread( const shared_ptr<const XVideoFrameMailbox>& mailbox, IVideoSourceListener* listener ) :
+            Mailbox( mailbox ), Listener( listener ), Sync( ), WakeUpCondition( ),
+            NewFrameNotified( true ), NeedToExit( false )
+        {
+        }
+
+        // Let the thread know there is a new frame in the mailbox
+        void NotifyNewFrame( )
+        {
+            QMutexLocker locker( &Sync );
+            NewFrameNotified = true;
+            WakeUpCondition.wakeOne( );
+        }
+
+        // Signal the thread to exit and wait till it is done
+        void Stop( )
+        {
+            {
+                QMutexLocker locker( &Sync );
+                NeedToExit = true;
+                WakeUpCondition.wakeOne( );
+            }
+
+            wait( );
+        }
+
+    protected:
+        virtual void run( )
+        {
+            shared_ptr<const XImage> frame;
+            uint32_t                 frameNumber = 0;
+
+            Sync.lock( );
+
+            while ( !NeedToExit )
+            {
+                if ( !NewFrameNotified )
+                {
+                    WakeUpCondition.wait( &Sync );
+                    continue;
+                }
+
+                NewFrameNotified = false;
+                Sync.unlock( );
+
+                // frames put into the mailbox while listener was busy are skipped, only the latest one is taken
+                if ( Mailbox->GetLatestFrame( &frameNumber, frame ) )
+                {
+                    Listener->OnNewImage( frame );
+                    frame.reset( );
+                }
+
+                Sync.lock( );
+            }
+
+            Sync.unlock( );
+        }
+
+    private:
+        const shared_ptr<const XVideoFrameMailbox> Mailbox;
+        IVideoSourceListener* const                Listener;
+        QMutex                                     Sync;
+        QWaitCondition                             WakeUpCondition;
+        bool                                       NewFrameNotified;
+        bool                                       NeedToExit;
+    };
+}
+
 VideoSourceInAutomationServer::VideoSourceInAutomationServer( const shared_ptr<XAutomationServer>& server, uint32_t videoSourceId ) :
-    mServer( server ), mVideoSourceId( videoSourceId ), mListener( 0 )
+    mServer( server ), mVideoSourceId( videoSourceId ), mListener( 0 ), mDeliveryThread( 0 )
+{
+}
+
+VideoSourceInAutomationServer::~VideoSourceInAutomationServer( )
 {
+    SetListener( 0 );
 }
 
 shared_ptr<VideoSourceInAutomationServer> VideoSourceInAutomationServer::Create(
@@ -77,23 +161,40 @@ void VideoSourceInAutomationServer::SetListener( IVideoSourceListener* listener
 {
     mServer->RemoveVideoSourceListener( mVideoSourceId, static_cast<IAutomationVideoSourceListener*>( this ) ) ;
 
+    if ( mDeliveryThread != 0 )
+    {
+        // stopping the thread also releases the mailbox, unsubscribing from it
+        mDeliveryThread->Stop( );
+        delete mDeliveryThread;
+        mDeliveryThread = 0;
+    }
+
     mListener = listener;
 
     if ( mListener != 0 )
     {
+        shared_ptr<const XVideoFrameMailbox> mailbox = mServer->GetVideoFrameMailbox( mVideoSourceId );
+
+        if ( mailbox )
+        {
+            mDeliveryThread = new ::Private::VideoFrameDeliveryThread( mailbox, mListener );
+            mDeliveryThread->start( );
+        }
+
+        // still need to listen for new frame notifications and errors
         mServer->AddVideoSourceListener( mVideoSourceId, static_cast<IAutomationVideoSourceListener*>( this ) ) ;
     }
 }
 
 
-// New image is received from automation server - pass it to user
-void VideoSourceInAutomationServer::OnNewVideoFrame( uint32_t videoSourceId, const shared_ptr<const XImage>& image )
+// New image is available in the mailbox - wake up the thread delivering it to user
+void VideoSourceInAutomationServer::OnNewVideoFrame( uint32_t videoSourceId, const shared_ptr<const XImage>& )
 {
     assert( mVideoSourceId == videoSourceId );
 
-    if ( ( mVideoSourceId == videoSourceId ) && ( mListener != 0 ) )
+    if ( ( mVideoSourceId == videoSourceId ) && ( mDeliveryThread != 0 ) )
     {
-        mListener->OnNewImage( image );
+        mDeliveryThread->NotifyNewFrame( );
     }
 }
 
@@ -28,6 +28,13 @@
 #include <XInterfaces.hpp>
 #include <XAutomationServer.hpp>
 
+namespace Private
+{
+    class VideoFrameDeliveryThread;
+}
+
+// Video source running in automation server. New frames are pulled from the video source's mailbox on
+// a separate thread and passed to listener from there, so slow listeners never block video processing.
 class VideoSourceInAutomationServer : public CVSandbox::Video::IVideoSource,
                                       public CVSandbox::Automation::IAutomationVideoSourceListener,
                                       private CVSandbox::Uncopyable
@@ -38,6 +45,8 @@ private:
             uint32_t videoSourceId );
 
 public:
+    ~VideoSourceInAutomationServer( );
+
     static std::shared_ptr<VideoSourceInAutomationServer> Create(
             const std::shared_ptr<CVSandbox::Automation::XAutomationServer>& server,
             uint32_t videoSourceId );
@@ -70,6 +79,7 @@ private:
     const std::shared_ptr<CVSandbox::Automation::XAutomationServer> mServer;
     uint32_t                                                        mVideoSourceId;
     CVSandbox::Video::IVideoSourceListener*                         mListener;
+    Private::VideoFrameDeliveryThread*                              mDeliveryThread;
 };
 
 #endif // CVS_VIDEO_SOURCE_IN_AUTOMATION_SERVER_HPP
@@ -8,6 +8,7 @@ DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
 
 INCLUDEPATH += ../../afx/afx_types/ \
                ../../afx/afx_types+/ \
+               ../../afx/afx_platform+/ \
                ../../afx/afx_imaging/ \
                ../../afx/afx_video+/ \
                ../../core/iplugin/ \
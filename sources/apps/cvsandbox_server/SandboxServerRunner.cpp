@@ -0,0 +1,377 @@
+/*
+    Computer Vision Sandbox Server - headless automation server application
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <map>
+#include <set>
+#include <chrono>
+#include <XMutex.hpp>
+#include <XVideoSourceFrameInfo.hpp>
+#include <XVideoSourceProcessingGraph.hpp>
+
+#include "SandboxServerRunner.hpp"
+#include "IProjectManager.hpp"
+#include "CameraProjectObject.hpp"
+#include "SandboxProjectObject.hpp"
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox;
+using namespace CVSandbox::Automation;
+using namespace CVSandbox::Threading;
+
+namespace Private
+{
+    // Information about video source running in automation server
+    struct VideoSourceInfo
+    {
+        uint32_t                 Id;
+        string                   Name;
+        vector<string>           StepNames;
+        uint32_t                 LastFramesReceived;
+        steady_clock::time_point LastReportTime;
+    };
+
+    class SandboxServerRunnerData : public IAutomationVideoSourceListener
+    {
+    public:
+        SandboxServerRunnerData( const shared_ptr<const XPluginsEngine>& pluginsEngine,
+                                 const shared_ptr<XAutomationServer>& server ) :
+            PluginsEngine( pluginsEngine ), Server( server ), VideoSources( ), ThreadIds( ),
+            StartTime( ), CameraThreadOptions( ), ErrorsSync( ), LastErrors( )
+        {
+        }
+
+        bool CreateVideoSources( const shared_ptr<const IProjectManager>& projectManager,
+                                 const shared_ptr<const SandboxProjectObject>& sandbox );
+        bool CreateScriptingThreads( const shared_ptr<const SandboxProjectObject>& sandbox );
+
+    public: // IAutomationVideoSourceListener implementation
+        virtual void OnNewVideoFrame( uint32_t videoSourceId, const shared_ptr<const XImage>& image );
+        virtual void OnErrorMessage( uint32_t videoSourceId, const string& errorMessage );
+
+    public:
+        shared_ptr<const XPluginsEngine> PluginsEngine;
+        shared_ptr<XAutomationServer>    Server;
+        vector<VideoSourceInfo>          VideoSources;
+        vector<uint32_t>                 ThreadIds;
+        steady_clock::time_point         StartTime;
+
+        // Options of threads set for particular cameras - for video source and video processing roles
+        map<string, XAutomationThreadOptions> CameraThreadOptions[static_cast<int>( XAutomationThreadRole::Count )];
+
+        XMutex                           ErrorsSync;
+        map<uint32_t, string>            LastErrors;
+    };
+}
+
+SandboxServerRunner::SandboxServerRunner( const shared_ptr<const XPluginsEngine>& pluginsEngine,
+                                          const shared_ptr<XAutomationServer>& server ) :
+    mData( new ::Private::SandboxServerRunnerData( pluginsEngine, server ) )
+{
+}
+
+SandboxServerRunner::~SandboxServerRunner( )
+{
+    Stop( );
+    delete mData;
+}
+
+// Print latency statistics of a video processing step
+static void PrintLatency( const char* name, const XLatencyStatistics& latency )
+{
+    printf( "      %s: %.3f / %.3f / %.3f / %.3f / %.3f \n", name, latency.Average, latency.Median,
+            latency.Percentile95, latency.Percentile99, latency.Max );
+}
+
+// Set options of video source's or video processing thread for the camera with the specified name (before starting)
+void SandboxServerRunner::SetCameraThreadOptions( const string& cameraName, XAutomationThreadRole role,
+                                                  const XAutomationThreadOptions& options )
+{
+    if ( ( role == XAutomationThreadRole::VideoSource ) || ( role == XAutomationThreadRole::VideoProcessing ) )
+    {
+        mData->CameraThreadOptions[static_cast<int>( role )][cameraName] = options;
+    }
+}
+
+// Create all objects of the sandbox in the automation server and start them
+bool SandboxServerRunner::Start( const shared_ptr<const IProjectManager>& projectManager,
+                                 const shared_ptr<const SandboxProjectObject>& sandbox )
+{
+    bool devicesAreFine = mData->CreateVideoSources( projectManager, sandbox );
+    bool threadsAreFine = mData->CreateScriptingThreads( sandbox );
+
+    // start all threads and cameras
+    mData->Server->StartAllThreads( );
+    mData->Server->StartAllVideoSources( );
+
+    mData->StartTime = steady_clock::now( );
+
+    for ( auto& vsInfo : mData->VideoSources )
+    {
+        // check if video frames should be dropped on slow processing
+        if ( sandbox->Settings( ).DropFramesOnSlowProcessing( ) )
+        {
+            mData->Server->EnableVideoFrameDropping( vsInfo.Id, true );
+        }
+
+        mData->Server->EnableVideoProcessingPerformanceMonitor( vsInfo.Id, true );
+        mData->Server->AddVideoSourceListener( vsInfo.Id, mData, false );
+
+        vsInfo.LastReportTime = mData->StartTime;
+    }
+
+    if ( !devicesAreFine )
+    {
+        printf( "Warning: Failed creating some video sources of the sandbox. \n" );
+    }
+    if ( !threadsAreFine )
+    {
+        printf( "Warning: Failed creating some scripting threads of the sandbox. \n" );
+    }
+
+    return ( !mData->VideoSources.empty( ) ) || ( !mData->ThreadIds.empty( ) );
+}
+
+// Finalize all video sources and scripting threads created for the sandbox
+void SandboxServerRunner::Stop( )
+{
+    for ( const auto& vsInfo : mData->VideoSources )
+    {
+        mData->Server->RemoveVideoSourceListener( vsInfo.Id, mData );
+        mData->Server->FinalizeVideoSource( vsInfo.Id );
+    }
+
+    for ( uint32_t threadId : mData->ThreadIds )
+    {
+        mData->Server->FinalizeThread( threadId );
+    }
+
+    mData->VideoSources.clear( );
+    mData->ThreadIds.clear( );
+}
+
+// Print frame rate, drop counts and processing graphs' timing for all video sources
+void SandboxServerRunner::PrintReport( )
+{
+    steady_clock::time_point now    = steady_clock::now( );
+    uint32_t                 uptime = static_cast<uint32_t>( duration_cast<seconds>( now - mData->StartTime ).count( ) );
+
+    printf( "[%02u:%02u:%02u] \n", uptime / 3600, ( uptime / 60 ) % 60, uptime % 60 );
+
+    for ( auto& vsInfo : mData->VideoSources )
+    {
+        XVideoSourceFrameInfo frameInfo;
+
+        if ( mData->Server->GetVideoSourceFrameInfo( vsInfo.Id, &frameInfo ) )
+        {
+            float msElapsed = static_cast<float>( duration_cast<milliseconds>( now - vsInfo.LastReportTime ).count( ) );
+            float fps       = 0.0f;
+
+            if ( ( msElapsed > 0 ) && ( frameInfo.FramesReceived >= vsInfo.LastFramesReceived ) )
+            {
+                fps = ( frameInfo.FramesReceived - vsInfo.LastFramesReceived ) * 1000.0f / msElapsed;
+            }
+
+            vsInfo.LastFramesReceived = frameInfo.FramesReceived;
+            vsInfo.LastReportTime     = now;
+
+            printf( "  %s: %.2f fps, %dx%d, received: %u, dropped: %u, blocked: %u \n", vsInfo.Name.c_str( ), fps,
+                    frameInfo.ProcessedFrameWidth, frameInfo.ProcessedFrameHeight,
+                    frameInfo.FramesReceived, frameInfo.FramesDropped, frameInfo.FramesBlocked );
+
+            vector<XLatencyStatistics> stepsLatency;
+            XLatencyStatistics         graphLatency;
+            XLatencyStatistics         queueWaitLatency;
+
+            if ( mData->Server->GetVideoProcessingGraphLatency( vsInfo.Id, stepsLatency, &graphLatency, &queueWaitLatency ) )
+            {
+                printf( "    latency, ms (avg / p50 / p95 / p99 / max): \n" );
+                PrintLatency( "queue wait", queueWaitLatency );
+
+                if ( !vsInfo.StepNames.empty( ) )
+                {
+                    PrintLatency( "graph", graphLatency );
+
+                    for ( size_t i = 0, n = min( stepsLatency.size( ), vsInfo.StepNames.size( ) ); i < n; i++ )
+                    {
+                        PrintLatency( vsInfo.StepNames[i].c_str( ), stepsLatency[i] );
+                    }
+                }
+            }
+        }
+    }
+
+    fflush( stdout );
+}
+
+namespace Private
+{
+
+// Create video sources of the sandbox in automation server (not starting them)
+bool SandboxServerRunnerData::CreateVideoSources( const shared_ptr<const IProjectManager>& projectManager,
+                                                  const shared_ptr<const SandboxProjectObject>& sandbox )
+{
+    vector<XGuid>                                 sandboxDevices        = sandbox->GetSandboxDevices( );
+    const map<XGuid, XVideoSourceProcessingGraph> videoProcessingGraphs = sandbox->GetCamerasProcessingGraphs( );
+    bool                                          devicesAreFine        = true;
+    set<string>                                   configuredCameras;
+
+    for ( const XGuid& deviceId : sandboxDevices )
+    {
+        const shared_ptr<ProjectObject>& deviceObject  = projectManager->GetProjectObject( deviceId );
+        bool                             pluginCreated = false;
+
+        if ( ( deviceObject ) && ( deviceObject->Type( ) == ProjectObjectType::Camera ) )
+        {
+            const shared_ptr<CameraProjectObject>& cameraObject = static_pointer_cast<CameraProjectObject>( deviceObject );
+            shared_ptr<const XPluginDescriptor>    pluginDesc   = PluginsEngine->GetPlugin( cameraObject->PluginId( ) );
+
+            if ( ( pluginDesc ) && ( pluginDesc->Type( ) == PluginType_VideoSource ) )
+            {
+                // create instance of the plug-in
+                shared_ptr<XPlugin> plugin = pluginDesc->CreateInstance( );
+
+                if ( plugin )
+                {
+                    VideoSourceInfo vsInfo;
+
+                    vsInfo.Id                 = Server->AddVideoSource( pluginDesc, static_pointer_cast<XVideoSourcePlugin>( plugin ) );
+                    vsInfo.Name               = cameraObject->Name( );
+                    vsInfo.LastFramesReceived = 0;
+
+                    // check if there is any video processing graph for this device
+                    auto graphIt = videoProcessingGraphs.find( cameraObject->Id( ) );
+                    if ( graphIt != videoProcessingGraphs.end( ) )
+                    {
+                        Server->SetVideoProcessingGraph( vsInfo.Id, graphIt->second );
+
+                        for ( const auto& step : graphIt->second )
+                        {
+                            vsInfo.StepNames.push_back( step.Name( ) );
+                        }
+                    }
+
+                    // set options of the camera's threads, if any were provided for it
+                    for ( int role = 0; role < static_cast<int>( XAutomationThreadRole::Count ); role++ )
+                    {
+                        auto optionsIt = CameraThreadOptions[role].find( vsInfo.Name );
+
+                        if ( optionsIt != CameraThreadOptions[role].end( ) )
+                        {
+                            Server->SetVideoSourceThreadOptions( vsInfo.Id, static_cast<XAutomationThreadRole>( role ), optionsIt->second );
+                            configuredCameras.insert( vsInfo.Name );
+                        }
+                    }
+
+                    // set confguration of the plugin
+                    pluginDesc->SetPluginConfiguration( plugin, cameraObject->PluginProperties( ) );
+
+                    VideoSources.push_back( vsInfo );
+                    pluginCreated = true;
+                }
+            }
+
+            if ( !pluginCreated )
+            {
+                printf( "Error: Failed creating video source for the [%s] camera. \n", cameraObject->Name( ).c_str( ) );
+            }
+        }
+
+        devicesAreFine &= pluginCreated;
+    }
+
+    // let user know about options which were not used, since there is no such camera
+    for ( int role = 0; role < static_cast<int>( XAutomationThreadRole::Count ); role++ )
+    {
+        for ( const auto& kvp : CameraThreadOptions[role] )
+        {
+            if ( configuredCameras.insert( kvp.first ).second )
+            {
+                printf( "Warning: Thread options are set for the [%s] camera, which is not running in the sandbox. \n", kvp.first.c_str( ) );
+            }
+        }
+    }
+
+    return devicesAreFine;
+}
+
+// Create scripting threads of the sandbox in automation server (not starting them)
+bool SandboxServerRunnerData::CreateScriptingThreads( const shared_ptr<const SandboxProjectObject>& sandbox )
+{
+    map<XGuid, ScriptingThreadDesc> sandboxThreads = sandbox->GetScriptingThreads( );
+    bool                            threadsAreFine = true;
+
+    for ( const auto& kvp : sandboxThreads )
+    {
+        const ScriptingThreadDesc&          threadDesc = kvp.second;
+        shared_ptr<const XPluginDescriptor> pluginDesc = PluginsEngine->GetPlugin( threadDesc.PluginId( ) );
+        shared_ptr<XPlugin>                 plugin;
+
+        if ( pluginDesc )
+        {
+            plugin = pluginDesc->CreateInstance( );
+        }
+
+        if ( plugin )
+        {
+            // set configuration of the thread
+            pluginDesc->SetPluginConfiguration( plugin, threadDesc.PluginConfiguration( ) );
+
+            ThreadIds.push_back( Server->AddThread( static_pointer_cast<XScriptingEnginePlugin>( plugin ), threadDesc.Interval( ) ) );
+        }
+        else
+        {
+            printf( "Error: Failed creating the [%s] scripting thread. \n", threadDesc.Name( ).c_str( ) );
+            threadsAreFine = false;
+        }
+    }
+
+    return threadsAreFine;
+}
+
+// Video frames are not needed - automation server does all the processing
+void SandboxServerRunnerData::OnNewVideoFrame( uint32_t, const shared_ptr<const XImage>& )
+{
+}
+
+// Print error messages from video sources, but only when they change
+void SandboxServerRunnerData::OnErrorMessage( uint32_t videoSourceId, const string& errorMessage )
+{
+    XScopedLock lock( &ErrorsSync );
+    string&     lastError = LastErrors[videoSourceId];
+
+    if ( lastError != errorMessage )
+    {
+        lastError = errorMessage;
+
+        for ( const auto& vsInfo : VideoSources )
+        {
+            if ( vsInfo.Id == videoSourceId )
+            {
+                printf( "Error in [%s]: %s \n", vsInfo.Name.c_str( ), errorMessage.c_str( ) );
+                break;
+            }
+        }
+    }
+}
+
+} // namespace Private
@@ -0,0 +1,66 @@
+/*
+    Computer Vision Sandbox Server - headless automation server application
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_SANDBOX_SERVER_RUNNER_HPP
+#define CVS_SANDBOX_SERVER_RUNNER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <XInterfaces.hpp>
+#include <XAutomationServer.hpp>
+
+class IProjectManager;
+class SandboxProjectObject;
+
+namespace Private
+{
+    class SandboxServerRunnerData;
+}
+
+// Class which runs sandbox's video sources, processing graphs and scripting threads in automation
+// server without any UI, periodically reporting performance of the video sources
+class SandboxServerRunner : private CVSandbox::Uncopyable
+{
+public:
+    SandboxServerRunner( const std::shared_ptr<const XPluginsEngine>& pluginsEngine,
+                         const std::shared_ptr<CVSandbox::Automation::XAutomationServer>& server );
+    ~SandboxServerRunner( );
+
+    // Set options of video source's or video processing thread for the camera with the specified name (before starting)
+    void SetCameraThreadOptions( const std::string& cameraName, CVSandbox::Automation::XAutomationThreadRole role,
+                                 const CVSandbox::Automation::XAutomationThreadOptions& options );
+
+    // Create all objects of the sandbox in the automation server and start them
+    bool Start( const std::shared_ptr<const IProjectManager>& projectManager,
+                const std::shared_ptr<const SandboxProjectObject>& sandbox );
+    // Finalize all video sources and scripting threads created for the sandbox
+    void Stop( );
+
+    // Print frame rate, drop counts and processing graphs' timing for all video sources
+    void PrintReport( );
+
+private:
+    Private::SandboxServerRunnerData* mData;
+};
+
+#endif // CVS_SANDBOX_SERVER_RUNNER_HPP
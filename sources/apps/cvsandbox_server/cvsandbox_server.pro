@@ -0,0 +1,133 @@
+TARGET = cvsandbox-server
+TEMPLATE = app
+
+# headless application - Qt Core is used only to load project files
+CONFIG += qt console
+CONFIG -= app_bundle
+QT = core
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
+
+INCLUDEPATH += ../../afx/afx_types/ \
+               ../../afx/afx_types+/ \
+               ../../afx/afx_platform+/ \
+               ../../core/iplugin/ \
+               ../../core/pluginmgr/ \
+               ../../core/automationserver/ \
+               ../cvsandbox
+
+message( $$MAKEFILE_GENERATOR )
+
+contains(QMAKE_TARGET.arch, x86_64) {
+    message("64-bit build")
+    CONFIG (debug, debug|release) {
+        message( "Debug build" )
+        OUTDIR = debug64
+    } else {
+        message( "Release build" )
+        OUTDIR = release64
+    }
+} else {
+    message("32-bit build")
+    CONFIG (debug, debug|release) {
+        message( "Debug build" )
+        OUTDIR = debug
+    } else {
+        message( "Release build" )
+        OUTDIR = release
+    }
+}
+
+contains(MAKEFILE_GENERATOR, "MSBUILD") || contains(MAKEFILE_GENERATOR, "MSVC.NET") {
+    message( "MSVC build" )
+
+    MSVC_LIBS_DIR = $$PWD/../../../build/msvc/$$OUTDIR/lib
+
+    DESTDIR = $${MSVC_LIBS_DIR}/../bin
+
+    LIBS += $$MSVC_LIBS_DIR/automationserver.lib \
+            $$MSVC_LIBS_DIR/pluginmgr.lib \
+            $$MSVC_LIBS_DIR/iplugin.lib \
+            $$MSVC_LIBS_DIR/afx_platform+.lib \
+            $$MSVC_LIBS_DIR/afx_imaging.lib \
+            $$MSVC_LIBS_DIR/afx_types+.lib \
+            $$MSVC_LIBS_DIR/afx_types.lib
+
+    QMAKE_CXXFLAGS += /D "_CRT_SECURE_NO_WARNINGS"
+    QMAKE_CXXFLAGS += /FS
+    QMAKE_LFLAGS += /INCREMENTAL:NO
+
+    LIBS += -lWinmm
+}
+
+contains(MAKEFILE_GENERATOR, "MINGW") {
+    message( "MinGW build" )
+
+    MINGW_LIBS_DIR = $$PWD/../../../build/mingw/$$OUTDIR/lib
+
+    DESTDIR = $${MINGW_LIBS_DIR}/../bin
+
+    LIBS += -L$${MINGW_LIBS_DIR} \
+            -lautomationserver \
+            -lpluginmgr \
+            -liplugin \
+            -lafx_platform+ \
+            -lafx_imaging \
+            -lafx_types+ \
+            -lafx_types
+
+    QMAKE_CXXFLAGS += -std=c++0x
+    LIBS += -fopenmp
+
+    LIBS += -lWinmm
+}
+
+unix {
+    message( "Unix build" )
+
+    UNIX_LIBS_DIR = $$PWD/../../../build/unix/$$OUTDIR/lib
+
+    DESTDIR = $${UNIX_LIBS_DIR}/../bin
+
+    LIBS += -L$${UNIX_LIBS_DIR} \
+            -lautomationserver \
+            -lpluginmgr \
+            -liplugin \
+            -lafx_platform+ \
+            -lafx_imaging \
+            -lafx_types+ \
+            -lafx_types
+
+    QMAKE_CXXFLAGS += -std=c++0x
+    LIBS += -fopenmp -ldl -lpthread -lrt
+}
+
+message( "Out: " $$DESTDIR )
+
+SOURCES += main.cpp \
+    SandboxServerRunner.cpp \
+    ../cvsandbox/XGuidGenerator.cpp \
+    ../cvsandbox/ProjectManager.cpp \
+    ../cvsandbox/IProjectManager.cpp \
+    ../cvsandbox/ProjectObject.cpp \
+    ../cvsandbox/ProjectObjectFactory.cpp \
+    ../cvsandbox/FolderProjectObject.cpp \
+    ../cvsandbox/CameraProjectObject.cpp \
+    ../cvsandbox/SandboxProjectObject.cpp \
+    ../cvsandbox/SandboxSettings.cpp \
+    ../cvsandbox/CamerasViewConfiguration.cpp \
+    ../cvsandbox/ProjectObjectSerializationHelper.cpp
+
+HEADERS += SandboxServerRunner.hpp \
+    ../cvsandbox/XGuidGenerator.hpp \
+    ../cvsandbox/IProjectManager.hpp \
+    ../cvsandbox/ProjectManager.hpp \
+    ../cvsandbox/ProjectObject.hpp \
+    ../cvsandbox/ProjectObjectFactory.hpp \
+    ../cvsandbox/FolderProjectObject.hpp \
+    ../cvsandbox/CameraProjectObject.hpp \
+    ../cvsandbox/SandboxProjectObject.hpp \
+    ../cvsandbox/SandboxSettings.hpp \
+    ../cvsandbox/CamerasViewConfiguration.hpp \
+    ../cvsandbox/ProjectObjectSerializationHelper.hpp \
+    ../cvsandbox/ScriptingThreadDesc.hpp
@@ -0,0 +1,457 @@
+/*
+    Computer Vision Sandbox Server - headless automation server application
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string>
+#include <map>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <XThread.hpp>
+#include <XPluginsEngine.hpp>
+#include <XAutomationServer.hpp>
+
+#include "ProjectManager.hpp"
+#include "SandboxProjectObject.hpp"
+#include "SandboxServerRunner.hpp"
+
+using namespace std;
+using namespace CVSandbox;
+using namespace CVSandbox::Threading;
+using namespace CVSandbox::Automation;
+
+// Application's name and version
+const char* APP_NAME    =  "Computer Vision Sandbox Server";
+xversion    APP_VERSION = { 1, 0, 0 };
+
+// Some error code the app may return
+enum
+{
+    Error_NoArguments           = -1,
+    Error_InvalidArgument       = -2,
+    Error_FailedLoadingProject  = -3,
+    Error_SandboxNotFound       = -4,
+    Error_FailedStartingSandbox = -5
+};
+
+// Types of plug-ins to be loaded by the application
+static const PluginType PLUGIN_TYPES_TO_LOAD =
+        PluginType_VideoSource              |
+        PluginType_ImageProcessingFilter    |
+        PluginType_ImageProcessingFilter2   |
+        PluginType_ImageProcessing          |
+        PluginType_VideoProcessing          |
+        PluginType_ScriptingEngine          |
+        PluginType_Device                   |
+        PluginType_CommunicationDevice      |
+        PluginType_ImageImporter            |
+        PluginType_ImageExporter            |
+        PluginType_ScriptingApi             |
+        PluginType_Detection;
+
+// Application's options
+struct ServerOptions
+{
+    string   ProjectFileName;
+    string   SandboxPath;
+    string   PluginsFolder;
+    string   TraceFileName;
+    string   ManifestCacheFileName;
+    uint32_t ReportInterval;
+    uint32_t RunTime;
+
+    // Options of automation server's threads for each role
+    XAutomationThreadOptions ThreadOptions[static_cast<int>( XAutomationThreadRole::Count )];
+    // Options of threads of particular cameras for each role (overriding options of the role)
+    map<string, XAutomationThreadOptions> CameraThreadOptions[static_cast<int>( XAutomationThreadRole::Count )];
+
+    ServerOptions( ) : ProjectFileName( ), SandboxPath( ), PluginsFolder( ), TraceFileName( ), ManifestCacheFileName( ), ReportInterval( 5 ), RunTime( 0 ), ThreadOptions( ), CameraThreadOptions( ) { }
+};
+
+// Set when application gets termination request
+static volatile sig_atomic_t NeedToStop = 0;
+
+// Some forward declarations -------
+static int CheckArgument( int argc, char* argv[], ServerOptions& options );
+static void SignalHandler( int signalNumber );
+static XAutomationThreadOptions MergeThreadOptions( const XAutomationThreadOptions& roleOptions, const XAutomationThreadOptions& cameraOptions );
+// ---------------------------------
+
+// Let's finally start here
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+    ServerOptions    options;
+    int              rc = CheckArgument( argc, argv, options );
+
+    if ( rc == 0 )
+    {
+        shared_ptr<XPluginsEngine>    pluginsEngine = XPluginsEngine::Create( );
+        shared_ptr<XAutomationServer> server        = XAutomationServer::Create( pluginsEngine, APP_NAME, APP_VERSION );
+        shared_ptr<ProjectManager>    pm            = ProjectManager::Create( QString::fromUtf8( options.ProjectFileName.c_str( ) ) );
+
+        // use manifest cache, so plug-in modules are not loaded until they are needed
+        if ( !options.ManifestCacheFileName.empty( ) )
+        {
+            if ( pluginsEngine->SetManifestCache( options.ManifestCacheFileName ) != SuccessCode )
+            {
+                printf( "Warning: Failed reading plug-ins' manifest cache, it will be rebuilt. \n\n" );
+            }
+        }
+
+        // collect plug-ins from their folder
+        if ( options.PluginsFolder.empty( ) )
+        {
+            QString pluginsPath      = QFileInfo( QCoreApplication::applicationDirPath( ), "cvsplugins/" ).filePath( );
+            QString pluginsExtraPath = QFileInfo( QCoreApplication::applicationDirPath( ), "cvsplugins-extra/" ).filePath( );
+
+            pluginsEngine->CollectModules( pluginsPath.toUtf8( ).data( ), PLUGIN_TYPES_TO_LOAD );
+            pluginsEngine->CollectModules( pluginsExtraPath.toUtf8( ).data( ), PLUGIN_TYPES_TO_LOAD );
+        }
+        else
+        {
+            pluginsEngine->CollectModules( options.PluginsFolder, PLUGIN_TYPES_TO_LOAD );
+        }
+
+        if ( !pm->Load( ) )
+        {
+            rc = Error_FailedLoadingProject;
+            printf( "Error: Failed loading the project file. \n\n" );
+        }
+        else
+        {
+            shared_ptr<ProjectObject> po = pm->GetProjectObject( options.SandboxPath );
+
+            if ( ( !po ) || ( po->Type( ) != ProjectObjectType::Sandbox ) )
+            {
+                rc = Error_SandboxNotFound;
+                printf( "Error: The project does not contain sandbox with the specified path. \n\n" );
+            }
+            else
+            {
+                SandboxServerRunner runner( pluginsEngine, server );
+
+                for ( int role = 0; role < static_cast<int>( XAutomationThreadRole::Count ); role++ )
+                {
+                    server->SetThreadOptions( static_cast<XAutomationThreadRole>( role ), options.ThreadOptions[role] );
+
+                    for ( const auto& kvp : options.CameraThreadOptions[role] )
+                    {
+                        runner.SetCameraThreadOptions( kvp.first, static_cast<XAutomationThreadRole>( role ),
+                                                       MergeThreadOptions( options.ThreadOptions[role], kvp.second ) );
+                    }
+                }
+
+                server->Start( );
+
+                if ( !runner.Start( pm, static_pointer_cast<SandboxProjectObject>( po ) ) )
+                {
+                    rc = Error_FailedStartingSandbox;
+                    printf( "Error: Failed starting any of the sandbox's video sources or threads. \n\n" );
+                }
+                else
+                {
+                    uint32_t timeRunning     = 0;
+                    uint32_t timeSinceReport = 0;
+
+                    signal( SIGINT,  SignalHandler );
+                    signal( SIGTERM, SignalHandler );
+
+                    if ( !options.TraceFileName.empty( ) )
+                    {
+                        server->StartVideoProcessingTrace( );
+                    }
+
+                    printf( "Running [%s] sandbox. Press Ctrl+C to stop. \n\n", po->Name( ).c_str( ) );
+                    fflush( stdout );
+
+                    while ( ( NeedToStop == 0 ) && ( ( options.RunTime == 0 ) || ( timeRunning < options.RunTime * 1000 ) ) )
+                    {
+                        XThread::Sleep( 100 );
+                        timeRunning     += 100;
+                        timeSinceReport += 100;
+
+                        if ( ( options.ReportInterval != 0 ) && ( timeSinceReport >= options.ReportInterval * 1000 ) )
+                        {
+                            runner.PrintReport( );
+                            timeSinceReport = 0;
+                        }
+                    }
+
+                    if ( !options.TraceFileName.empty( ) )
+                    {
+                        server->StopVideoProcessingTrace( );
+
+                        if ( server->SaveVideoProcessingTrace( options.TraceFileName ) != SuccessCode )
+                        {
+                            printf( "Error: Failed saving video processing trace. \n\n" );
+                        }
+                    }
+                }
+
+                runner.Stop( );
+                server->SignalToStop( );
+                server->WaitForStop( );
+            }
+        }
+    }
+
+    return rc;
+}
+
+// Request the main loop to stop
+void SignalHandler( int )
+{
+    NeedToStop = 1;
+}
+
+// Get options of camera's thread, taking those not set for the camera from options of the role
+XAutomationThreadOptions MergeThreadOptions( const XAutomationThreadOptions& roleOptions, const XAutomationThreadOptions& cameraOptions )
+{
+    XAutomationThreadOptions options = cameraOptions;
+
+    if ( options.Scheduling.Priority == XThreadPriority::Normal )
+    {
+        options.Scheduling.Priority = roleOptions.Scheduling.Priority;
+    }
+    if ( options.Scheduling.Cpus.empty( ) )
+    {
+        options.Scheduling.Cpus = roleOptions.Scheduling.Cpus;
+    }
+    if ( options.Scheduling.NumaNode < 0 )
+    {
+        options.Scheduling.NumaNode = roleOptions.Scheduling.NumaNode;
+    }
+    if ( options.ImagingThreadsCount == 0 )
+    {
+        options.ImagingThreadsCount = roleOptions.ImagingThreadsCount;
+    }
+
+    return options;
+}
+
+// Print application's help and usage info
+static void ShowHelp( )
+{
+    printf( "%s v%d.%d.%d \n", APP_NAME, APP_VERSION.major, APP_VERSION.minor, APP_VERSION.revision );
+    printf( "\n" );
+    printf( "Usage: cvsandbox-server <project_file.cvsproj> <sandbox path> [options]\n" );
+    printf( "\n" );
+    printf( "Runs the specified sandbox of the project without UI, using automation server only. \n" );
+    printf( "Sandbox path is its location in the project tree, like 'Folder/Sandbox name'. \n" );
+    printf( "\n" );
+    printf( "Options: \n" );
+    printf( "  -i <seconds> - interval between performance reports, 0 to disable (default is 5); \n" );
+    printf( "  -t <seconds> - time to run the sandbox for, 0 to run until Ctrl+C (default is 0); \n" );
+    printf( "  -p <folder>  - folder to load plug-ins from (default is 'cvsplugins' next to the application); \n" );
+    printf( "  -r <file>    - record trace of video processing into the file (Chrome trace event format); \n" );
+    printf( "  -c <file>    - cache plug-ins' manifests in the file, so modules are loaded only when needed; \n" );
+    printf( "  -a <role>:<cpus>     - run threads of the role on the specified CPUs only, like 'processing:0-3,8'; \n" );
+    printf( "  -y <role>:<priority> - set priority of the role's threads (idle, lowest, below-normal, normal, \n" );
+    printf( "                         above-normal, highest, realtime); \n" );
+    printf( "  -n <role>:<node>     - run threads of the role on CPUs of the NUMA node and prefer its memory; \n" );
+    printf( "  -o <role>:<count>    - number of threads image processing routines use, when called from \n" );
+    printf( "                         threads of the role (default is one per CPU). \n" );
+    printf( "\n" );
+    printf( "Roles of threads: source (video sources), processing (video processing graphs), script (scripting threads). \n" );
+    printf( "Options of source and processing threads can be set for a single camera as <role>@<camera name>, like \n" );
+    printf( "'processing@Front door:4-7' - options not set for the camera are taken from those of the role. \n" );
+    printf( "\n" );
+}
+
+// Parse unsigned integer option's value
+static int ParseUnsignedOption( const char* option, const char* value, uint32_t* pResult )
+{
+    char* endPtr = nullptr;
+    long  parsed = strtol( value, &endPtr, 10 );
+    int   ret    = 0;
+
+    if ( ( endPtr == value ) || ( *endPtr != '\0' ) || ( parsed < 0 ) )
+    {
+        ret = Error_InvalidArgument;
+        printf( "Error: Invalid value specified for the %s option - \"%s\". \n\n", option, value );
+    }
+    else
+    {
+        *pResult = static_cast<uint32_t>( parsed );
+    }
+
+    return ret;
+}
+
+// Parse "<role>[@<camera name>]:<value>" option's value - provides options of the role (or camera's role) and the value
+static int ParseThreadOption( const char* option, const char* value, ServerOptions& options,
+                              XAutomationThreadOptions** pThreadOptions, string& roleValue )
+{
+    static const char* roleNames[] = { "source", "processing", "script" };
+
+    string optionValue = value;
+    size_t separator   = optionValue.rfind( ':' );
+    int    ret         = Error_InvalidArgument;
+
+    if ( separator != string::npos )
+    {
+        string roleName   = optionValue.substr( 0, separator );
+        string cameraName;
+        size_t at         = roleName.find( '@' );
+
+        if ( at != string::npos )
+        {
+            cameraName = roleName.substr( at + 1 );
+            roleName   = roleName.substr( 0, at );
+        }
+
+        for ( int role = 0; role < static_cast<int>( XAutomationThreadRole::Count ); role++ )
+        {
+            if ( roleName == roleNames[role] )
+            {
+                if ( at == string::npos )
+                {
+                    *pThreadOptions = &options.ThreadOptions[role];
+                    ret             = 0;
+                }
+                else if ( ( !cameraName.empty( ) ) && ( static_cast<XAutomationThreadRole>( role ) != XAutomationThreadRole::Scripting ) )
+                {
+                    *pThreadOptions = &options.CameraThreadOptions[role][cameraName];
+                    ret             = 0;
+                }
+
+                roleValue = optionValue.substr( separator + 1 );
+                break;
+            }
+        }
+    }
+
+    if ( ret != 0 )
+    {
+        printf( "Error: Invalid thread role specified for the %s option - \"%s\". \n\n", option, value );
+    }
+
+    return ret;
+}
+
+// Parse one of the options of automation server's threads
+static int ParseThreadOptions( const string& option, const char* value, ServerOptions& options )
+{
+    XAutomationThreadOptions* threadOptions = nullptr;
+    string                    roleValue;
+    int                       ret = ParseThreadOption( option.c_str( ), value, options, &threadOptions, roleValue );
+
+    if ( ret == 0 )
+    {
+        bool isValid = true;
+
+        if ( option == "-a" )
+        {
+            isValid = XThread::ParseCpuList( roleValue, threadOptions->Scheduling.Cpus );
+        }
+        else if ( option == "-y" )
+        {
+            isValid = XThread::ParsePriority( roleValue, &threadOptions->Scheduling.Priority );
+        }
+        else
+        {
+            uint32_t number = 0;
+
+            ret = ParseUnsignedOption( option.c_str( ), roleValue.c_str( ), &number );
+
+            if ( ret == 0 )
+            {
+                if ( option == "-n" )
+                {
+                    threadOptions->Scheduling.NumaNode = static_cast<int32_t>( number );
+                }
+                else
+                {
+                    threadOptions->ImagingThreadsCount = number;
+                }
+            }
+        }
+
+        if ( !isValid )
+        {
+            ret = Error_InvalidArgument;
+            printf( "Error: Invalid value specified for the %s option - \"%s\". \n\n", option.c_str( ), value );
+        }
+    }
+
+    return ret;
+}
+
+// Check/process application's arguments
+int CheckArgument( int argc, char* argv[], ServerOptions& options )
+{
+    int ret = 0;
+
+    if ( argc <= 2 )
+    {
+        ret = Error_NoArguments;
+        ShowHelp( );
+    }
+    else
+    {
+        options.ProjectFileName = argv[1];
+        options.SandboxPath     = argv[2];
+
+        for ( int i = 3; ( i < argc ) && ( ret == 0 ); i += 2 )
+        {
+            string option = argv[i];
+
+            if ( i + 1 >= argc )
+            {
+                printf( "Error: Missing value for the %s option. \n\n", argv[i] );
+                ret = Error_InvalidArgument;
+            }
+            else if ( option == "-i" )
+            {
+                ret = ParseUnsignedOption( argv[i], argv[i + 1], &options.ReportInterval );
+            }
+            else if ( option == "-t" )
+            {
+                ret = ParseUnsignedOption( argv[i], argv[i + 1], &options.RunTime );
+            }
+            else if ( option == "-p" )
+            {
+                options.PluginsFolder = argv[i + 1];
+            }
+            else if ( option == "-r" )
+            {
+                options.TraceFileName = argv[i + 1];
+            }
+            else if ( option == "-c" )
+            {
+                options.ManifestCacheFileName = argv[i + 1];
+            }
+            else if ( ( option == "-a" ) || ( option == "-y" ) || ( option == "-n" ) || ( option == "-o" ) )
+            {
+                ret = ParseThreadOptions( option, argv[i + 1], options );
+            }
+            else
+            {
+                printf( "Error: Don't know what to do with \"%s\". \n\n", argv[i] );
+                ret = Error_InvalidArgument;
+            }
+        }
+    }
+
+    return ret;
+}
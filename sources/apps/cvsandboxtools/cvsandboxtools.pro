@@ -10,6 +10,7 @@ DEFINES += QT_QTPROPERTYBROWSER_IMPORT
 
 INCLUDEPATH += ../../afx/afx_types/ \
                ../../afx/afx_types+/ \
+               ../../afx/afx_platform+/ \
                ../../afx/afx_imaging/ \
                ../../core/iplugin/ \
                ../../core/pluginmgr/ \
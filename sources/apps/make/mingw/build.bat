@@ -2,6 +2,7 @@
 
 set BUILD_FOLDERS=..\..\cvsandboxtools\make\mingw ^
                   ..\..\cvsandbox\make\mingw ^
+                  ..\..\cvsandbox_server\make\mingw ^
                   ..\..\cvssr\make\mingw
 
 set MY_FOLDER=%cd%
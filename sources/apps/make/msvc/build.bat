@@ -2,6 +2,7 @@
 
 set BUILD_FOLDERS=..\..\cvsandboxtools\make\msvc ^
                   ..\..\cvsandbox\make\msvc ^
+                  ..\..\cvsandbox_server\make\msvc ^
                   ..\..\cvssr\make\msvc ^
                   ..\..\cvs_vcam\make\msvc
 
@@ -22,22 +22,30 @@
 #include "XAutomationServer.hpp"
 #include "XVideoSourceProcessingGraph.hpp"
 #include "XVideoSourceFrameInfo.hpp"
+#include "XVideoFrameMailbox.hpp"
+#include "XLatencyHistogram.hpp"
+#include "XVideoProcessingTrace.hpp"
+#include "XImageStatisticsCache.hpp"
 #include <stdio.h>
 #include <map>
 #include <list>
 #include <algorithm>
 #include <numeric>
+#include <functional>
 #include <chrono>
 
 #include <XMutex.hpp>
 #include <XManualResetEvent.hpp>
+#include <XAutoResetEvent.hpp>
 #include <XThread.hpp>
 #include <XError.hpp>
 
 #include <XImageProcessingFilterPlugin.hpp>
 #include <XVideoProcessingPlugin.hpp>
 #include <XDetectionPlugin.hpp>
+#include <XImageProcessingPlugin.hpp>
 #include <XScriptingEnginePlugin.hpp>
+#include <ximaging.h>
 
 using namespace std;
 using namespace std::chrono;
@@ -50,11 +58,39 @@ namespace CVSandbox { namespace Automation
 
 // Number of performance measurements to average
 #define PERFORMANCE_HISTORY_LENGTH (40)
+// Time taken value marking steps skipped for the current frame
+#define SKIPPED_STEP_TIME (0xFFFFFFFF)
+// Number of independently locked parts host variables are split into
+#define VARIABLES_SHARDS_COUNT (16)
 
 namespace Private
 {
     typedef list<IAutomationVideoSourceListener*> ListenersList;
 
+    // Names given to threads of each role, so those could be told apart by system tools and performance monitors
+    static const char* ThreadRoleNames[] = { "cvs-source", "cvs-processing", "cvs-script" };
+
+    // Name the calling thread after its role and apply scheduling options and imaging threads count to it.
+    // Returns false if scheduling options could not be applied (the thread keeps running with default ones).
+    static bool ApplyThreadOptions( XAutomationThreadRole role, const XAutomationThreadOptions& options )
+    {
+        bool ret = true;
+
+        XThread::SetCurrentThreadName( ThreadRoleNames[static_cast<int>( role )] );
+
+        if ( !options.Scheduling.IsDefault( ) )
+        {
+            ret = XThread::ApplySchedulingOptions( options.Scheduling );
+        }
+
+        if ( options.ImagingThreadsCount != 0 )
+        {
+            XImagingSetThreadsCount( options.ImagingThreadsCount );
+        }
+
+        return ret;
+    }
+
     class XAutomationServerData;
 
     // Internal class to group some data/functions related to video source
@@ -67,13 +103,18 @@ namespace Private
                          XAutomationServerData* server ) :
             VideoSourceId( videoSourceId ), VideoSourceDescriptor( pluginDescriptor), VideoSource( videoSource ),
             Server( server ), Listeners( ), ListenerSync( ),
+            FrameMailbox( make_shared<XVideoFrameMailbox>( ) ),
             LastImage( ), LastError( ), ProcessingGraph( ), ProcessingGraphBuffer( ),
             VideoProcessingSync( ), NewFrameIsAvailableEvent( ), ProcessingThreadIsFreeEvent( ),
             NeedToExitProcessingThread( false ), VideoProcessingThread( ), FrameInfo( ),
+            NewFrameArrivalTime( ), NewFrameNumber( 0 ),
             NeedToRunPerformanceMonitor( false ), IsPerformanceMonitroRunning( false ),
+            StepLatency( ), GraphLatency( ), QueueWaitLatency( ), FrameStepTimeTaken( ), TraceEvents( ),
             StepFailedInitialization( -1 ), StepFailedMessage( ),
             DropVideoFramesWhenBusy( false ), FramesDropped( 0 ), FramesBlocked( 0 ),
-            UpdatedVideoProcessingConfig( )
+            UpdatedVideoProcessingConfig( ), StatisticsCache( ), StepAcceptsHistograms( ), ImageAccessedByScript( false ),
+            StepAcceptsRegion( ), StepFramesToSkip( ), StepNextRunTime( ), StepIsDue( ),
+            SourceThreadOptions( ), ProcessingThreadOptions( ), SourceThreadOptionsApplied( false )
         {
         }
 
@@ -104,14 +145,24 @@ namespace Private
 
     public:
         void ReportError( const string& errorMessage );
+        void PublishNewFrame( );
 
     private:
         void PreparePlugins( );
         void NotifyNewFrame( );
         void PerformNewFrameProcessing( );
-        XErrorCode DoImageProcessingFilterPlugin( const shared_ptr<XImageProcessingFilterPlugin>& plugin, size_t& currrentGraphBufferIndex );
+        XErrorCode DoImageProcessingFilterPlugin( const shared_ptr<XImageProcessingFilterPlugin>& plugin, const XVideoSourceProcessingStep& step,
+                                                  int stepIndex, size_t& currrentGraphBufferIndex );
+        bool GetStepRegion( const XVideoSourceProcessingStep& step, xrect& region ) const;
+        bool IsStepSchedulable( const XVideoSourceProcessingStep& step ) const;
+        void UpdateStepsSchedule( );
+        bool ShouldRunStep( const XVideoSourceProcessingStep& step, int stepIndex ) const;
+        void MarkStepRun( const XVideoSourceProcessingStep& step, int stepIndex );
+        bool GetStepPointOperationMaps( const XVideoSourceProcessingStep& step, int stepIndex, uint8_t* maps );
+        XErrorCode ApplyPointOperationMaps( const uint8_t* maps );
         XErrorCode DoVideoProcessingPlugin( const shared_ptr<XVideoProcessingPlugin>& plugin );
-        XErrorCode DoDetectionPlugin( const shared_ptr<XDetectionPlugin>& plugin );
+        XErrorCode DoDetectionPlugin( const shared_ptr<XDetectionPlugin>& plugin, const XVideoSourceProcessingStep& step );
+        XErrorCode DoImageProcessingPlugin( const shared_ptr<XImageProcessingPlugin>& plugin, const XVideoSourceProcessingStep& step, int stepIndex );
         XErrorCode DoScriptingEnginePlugin( const shared_ptr<XScriptingEnginePlugin>& plugin );
 
     private:
@@ -124,9 +175,12 @@ namespace Private
         static XErrorCode ScriptingEnginePluginCallback_SetVariable( void* userParam, xstring name, const xvariant* value );
         static XErrorCode ScriptingEnginePluginCallback_GetImageVariable( void* userParam, xstring name, ximage** value );
         static XErrorCode ScriptingEnginePluginCallback_SetImageVariable( void* userParam, xstring name, const ximage* value );
+        static XErrorCode ScriptingEnginePluginCallback_GetSharedImageVariable( void* userParam, xstring name, const ximage** value, void** handle );
+        static void ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* userParam, void* handle );
         static XErrorCode ScriptingEnginePluginCallback_GetImage( void* userParam, ximage** image );
         static XErrorCode ScriptingEnginePluginCallback_SetImage( void* userParam, ximage* image );
         static XErrorCode ScriptingEnginePluginCallback_GetVideoSource( void* userParam, PluginDescriptor** pDescriptor, void** pPlugin );
+        static XErrorCode ScriptingEnginePluginCallback_GetImageHistograms( void* userParam, xhistogram* histograms, int32_t* count );
 
     public:
         uint32_t                            VideoSourceId;
@@ -135,6 +189,7 @@ namespace Private
         XAutomationServerData*              Server;
         ListenersList                       Listeners;                      // list of listeners to notify (new frames, error, etc.)
         XMutex                              ListenerSync;                   // mutex to protect listener list
+        shared_ptr<XVideoFrameMailbox>      FrameMailbox;                   // latest frame mailbox for those who pull frames at their pace
         shared_ptr<XImage>                  LastImage;                      // image given to client -last image arrived from video source
                                                                             // (if processing graph is empty) - or result video processing -
         string                              LastError;
@@ -143,12 +198,14 @@ namespace Private
 
         XMutex                              VideoProcessingSync;            // mutex used to guard LastImage
         XMutex                              VideoFrameInfoSync;             // mutex used to guard frame information
-        XManualResetEvent                   NewFrameIsAvailableEvent;       // event to signal if there is new frame to process
+        XAutoResetEvent                     NewFrameIsAvailableEvent;       // event to signal if there is new frame to process
         XManualResetEvent                   ProcessingThreadIsFreeEvent;    // event to signal if video processing thread is free or not
         volatile bool                       NeedToExitProcessingThread;     // a flag to signal thread to video processing thread to exit
                                                                             // NewFrameIsAvailableEvent must be also signalled)
         XThread                             VideoProcessingThread;
         struct XVideoSourceFrameInfo        FrameInfo;
+        steady_clock::time_point            NewFrameArrivalTime;            // time when the frame to process came from video source
+        uint32_t                            NewFrameNumber;
 
         bool                                NeedToRunPerformanceMonitor;    // request to enable/disable performance monitor
         bool                                IsPerformanceMonitroRunning;    // actual current state of performance monitor
@@ -158,6 +215,11 @@ namespace Private
         vector<float>                       TotalGraphTime;
         float                               TotalAverageGraphTime;
         int                                 GraphTimeIndex;
+        vector<XLatencyHistogram>           StepLatency;                    // latency histograms of graph's steps, the entire graph
+        XLatencyHistogram                   GraphLatency;                   // and the time new frames wait before their processing starts
+        XLatencyHistogram                   QueueWaitLatency;
+        vector<uint32_t>                    FrameStepTimeTaken;             // time (microseconds) taken by steps for the current frame
+        vector<XVideoProcessingTraceEvent>  TraceEvents;                    // trace events of the current frame
 
         int                                 StepFailedInitialization;
         string                              StepFailedMessage;
@@ -167,6 +229,22 @@ namespace Private
         uint32_t                            FramesBlocked;
 
         map<int32_t, map<string, XVariant>> UpdatedVideoProcessingConfig;
+
+        uint8_t                             CombinedPointMaps[3 * 256];     // look-up tables of consecutive point-wise steps combined so far
+        uint8_t                             StepPointMaps[3 * 256];         // look-up tables of the next point-wise step to combine
+
+        XImageStatisticsCache               StatisticsCache;                // histograms of the current frame shared by processing steps
+        vector<bool>                        StepAcceptsHistograms;          // steps which were not found to refuse pre-calculated histograms
+        bool                                ImageAccessedByScript;          // current script step obtained/replaced the image, so may change it
+        vector<bool>                        StepAcceptsRegion;              // steps which were not found to refuse processing region of interest
+
+        vector<uint32_t>                    StepFramesToSkip;               // frames left to skip by steps running for every Nth frame
+        vector<steady_clock::time_point>    StepNextRunTime;                // time when steps with limited rate can run again
+        vector<bool>                        StepIsDue;                      // steps, which are due to run for the current frame
+
+        XAutomationThreadOptions            SourceThreadOptions;            // options of the thread video source notifies from
+        XAutomationThreadOptions            ProcessingThreadOptions;        // options of the video processing thread
+        bool                                SourceThreadOptionsApplied;     // options were applied to video source's thread
     };
 
     // Internal class to group some data/functions related to scripting threads
@@ -175,7 +253,7 @@ namespace Private
     private:
         ScriptingThreadData( uint32_t threadId, uint32_t msecInterval, shared_ptr<XScriptingEnginePlugin> scriptingEngine, XAutomationServerData* server ) :
             ThreadId( threadId ), MsecInterval( msecInterval ), ScriptingEngine( scriptingEngine ), Server( server ),
-            ScriptProcessingThread( ), NeedToExit( )
+            ScriptProcessingThread( ), NeedToExit( ), ThreadOptions( )
         {
         }
 
@@ -203,9 +281,12 @@ namespace Private
         static XErrorCode ScriptingEnginePluginCallback_SetVariable( void* userParam, xstring name, const xvariant* value );
         static XErrorCode ScriptingEnginePluginCallback_GetImageVariable( void* userParam, xstring name, ximage** value );
         static XErrorCode ScriptingEnginePluginCallback_SetImageVariable( void* userParam, xstring name, const ximage* value );
+        static XErrorCode ScriptingEnginePluginCallback_GetSharedImageVariable( void* userParam, xstring name, const ximage** value, void** handle );
+        static void ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* userParam, void* handle );
         static XErrorCode ScriptingEnginePluginCallback_GetImage( void* userParam, ximage** image );
         static XErrorCode ScriptingEnginePluginCallback_SetImage( void* userParam, ximage* image );
         static XErrorCode ScriptingEnginePluginCallback_GetVideoSource( void* userParam, PluginDescriptor** pDescriptor, void** pPlugin );
+        static XErrorCode ScriptingEnginePluginCallback_GetImageHistograms( void* userParam, xhistogram* histograms, int32_t* count );
 
     public:
         uint32_t                           ThreadId;
@@ -215,11 +296,32 @@ namespace Private
 
         XThread                            ScriptProcessingThread;
         XManualResetEvent                  NeedToExit;
+        XAutomationThreadOptions           ThreadOptions;
     };
 
     typedef map<uint32_t, shared_ptr<VideoSourceData>>     VsdMap;
     typedef map<uint32_t, shared_ptr<ScriptingThreadData>> ThreadMap;
 
+    // Image variable shared between scripts - the image is never changed once stored, so it is given
+    // to readers by reference. Previously stored image is kept to reuse its memory for the next copy.
+    struct HostImageVariable
+    {
+        shared_ptr<const XImage> Image;
+        shared_ptr<const XImage> SpareImage;
+    };
+
+    // Part of host variables guarded by its own lock - variable goes into a shard based on its name's hash
+    class HostVariablesShard : private Uncopyable
+    {
+    public:
+        HostVariablesShard( ) : Sync( ), Variables( ), ImageVariables( ) { }
+
+    public:
+        XMutex                          Sync;
+        map<string, XVariant>           Variables;
+        map<string, HostImageVariable>  ImageVariables;
+    };
+
     // Internal class to hide server's data
     class XAutomationServerData
     {
@@ -243,11 +345,15 @@ namespace Private
         ThreadMap           RunningThreads;
         ThreadMap           FinalizingThreads;
 
+        XVideoProcessingTrace ProcessingTrace;
+
+        // Default options of threads for each role
+        XAutomationThreadOptions ThreadOptions[static_cast<int>( XAutomationThreadRole::Count )];
+
     private:
         // Variables to share between scripts executed by scripting plug-ins
-        XMutex                           VariablesSync;
-        map<string, XVariant>            HostVariables;
-        map<string, shared_ptr<XImage> > HostImageVariables;
+        HostVariablesShard               VariablesShards[VARIABLES_SHARDS_COUNT];
+        XMutex                           VariablesListenerSync;
         IAutomationVariablesListener*    VariablesListener;
 
     public:
@@ -257,7 +363,7 @@ namespace Private
             ServerSync( ), ExitEvent( ), ServerThread( ),
             AddedVideoSources( ), RunningVideoSources( ), FinalizingVideoSources( ),
             AddedThreads( ), RunningThreads( ), FinalizingThreads( ),
-            VariablesSync( ), HostVariables( ), HostImageVariables( ), VariablesListener( nullptr )
+            ProcessingTrace( ), VariablesListenerSync( ), VariablesListener( nullptr )
 
         {
         }
@@ -277,10 +383,12 @@ namespace Private
         XErrorCode GetHostVariable( const string& name, XVariant& value );
         // Set host variant variable into common storage
         XErrorCode SetHostVariable( const string& name, const XVariant& value );
-        // Get host image variable from common storage
-        XErrorCode GetHostVariable( const string& name, shared_ptr<XImage>& value );
-        // Set host image variable into common storage
+        // Get host image variable from common storage (reference to the stored image, not a copy)
+        XErrorCode GetHostVariable( const string& name, shared_ptr<const XImage>& value );
+        // Set host image variable into common storage (the image is shared, so must not be changed afterwards)
         XErrorCode SetHostVariable( const string& name, const shared_ptr<const XImage>& value );
+        // Set copy of the image as host variable into common storage
+        XErrorCode SetHostVariableCopy( const string& name, const shared_ptr<const XImage>& value );
         // Clear all variables
         void ClearAllVariables( );
         // Set listener to monitor for variables changes
@@ -288,6 +396,12 @@ namespace Private
         // Clear variables listener, so no more change notifications are sent
         void ClearVariablesListener( );
 
+    private:
+        HostVariablesShard& GetVariablesShard( const string& name );
+        void LockAllVariablesShards( );
+        void UnlockAllVariablesShards( );
+        void StoreHostImageVariable( HostVariablesShard& shard, const string& name, const shared_ptr<const XImage>& value );
+
     public:
         // Implementation of common scripting engine callbacks
         xstring ScriptingEnginePluginCallback_GetHostName( );
@@ -298,6 +412,8 @@ namespace Private
         XErrorCode ScriptingEnginePluginCallback_SetVariable( xstring name, const xvariant* value );
         XErrorCode ScriptingEnginePluginCallback_GetImageVariable( xstring name, ximage** value );
         XErrorCode ScriptingEnginePluginCallback_SetImageVariable( xstring name, const ximage* value );
+        XErrorCode ScriptingEnginePluginCallback_GetSharedImageVariable( xstring name, const ximage** value, void** handle );
+        void ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* handle );
     };
 }
 
@@ -384,7 +500,50 @@ uint32_t XAutomationServer::AddVideoSource( const shared_ptr<const XPluginDescri
     XScopedLock lock( &mData->ServerSync );
     uint32_t    ret = ++mData->DeviceCounter;
 
-    mData->AddedVideoSources.insert( VsdMap::value_type( ret, VideoSourceData::Create( ret, descriptor, videoSource, mData.get( ) ) ) );
+    shared_ptr<VideoSourceData> videoSourceData = VideoSourceData::Create( ret, descriptor, videoSource, mData.get( ) );
+
+    if ( videoSourceData )
+    {
+        videoSourceData->SourceThreadOptions     = mData->ThreadOptions[static_cast<int>( XAutomationThreadRole::VideoSource )];
+        videoSourceData->ProcessingThreadOptions = mData->ThreadOptions[static_cast<int>( XAutomationThreadRole::VideoProcessing )];
+    }
+
+    mData->AddedVideoSources.insert( VsdMap::value_type( ret, videoSourceData ) );
+
+    return ret;
+}
+
+// Set default options of threads of the specified role, which are used for video sources and scripting threads added after that
+void XAutomationServer::SetThreadOptions( XAutomationThreadRole role, const XAutomationThreadOptions& options )
+{
+    XScopedLock lock( &mData->ServerSync );
+
+    if ( ( role >= XAutomationThreadRole::VideoSource ) && ( role < XAutomationThreadRole::Count ) )
+    {
+        mData->ThreadOptions[static_cast<int>( role )] = options;
+    }
+}
+
+// Set options of video source's or video processing thread for the specified video source (not started yet)
+bool XAutomationServer::SetVideoSourceThreadOptions( uint32_t videoSourceId, XAutomationThreadRole role, const XAutomationThreadOptions& options )
+{
+    XScopedLock         lock( &mData->ServerSync );
+    bool                ret = false;
+    VsdMap::iterator    itVideoSource = mData->AddedVideoSources.find( videoSourceId );
+
+    if ( itVideoSource != mData->AddedVideoSources.end( ) )
+    {
+        if ( role == XAutomationThreadRole::VideoSource )
+        {
+            itVideoSource->second->SourceThreadOptions = options;
+            ret = true;
+        }
+        else if ( role == XAutomationThreadRole::VideoProcessing )
+        {
+            itVideoSource->second->ProcessingThreadOptions = options;
+            ret = true;
+        }
+    }
 
     return ret;
 }
@@ -577,6 +736,85 @@ vector<float> XAutomationServer::GetVideoProcessingGraphTiming( uint32_t videoSo
     return timing;
 }
 
+// Get latency statistics of video processing graph's steps, complete graph and waiting of new frames for processing
+bool XAutomationServer::GetVideoProcessingGraphLatency( uint32_t videoSourceId, vector<XLatencyStatistics>& stepsLatency,
+                                                        XLatencyStatistics* graphLatency, XLatencyStatistics* queueWaitLatency )
+{
+    XScopedLock         lock( &mData->ServerSync );
+    VsdMap::iterator    vsDataIt = mData->RunningVideoSources.find( videoSourceId );
+    bool                ret      = false;
+
+    stepsLatency.clear( );
+
+    if ( vsDataIt != mData->RunningVideoSources.end( ) )
+    {
+        shared_ptr<VideoSourceData> vsData = vsDataIt->second;
+        XScopedLock                 infoLock( &vsData->VideoFrameInfoSync );
+
+        for ( const XLatencyHistogram& histogram : vsData->StepLatency )
+        {
+            stepsLatency.push_back( histogram.Statistics( ) );
+        }
+
+        if ( graphLatency != nullptr )
+        {
+            *graphLatency = vsData->GraphLatency.Statistics( );
+        }
+        if ( queueWaitLatency != nullptr )
+        {
+            *queueWaitLatency = vsData->QueueWaitLatency.Statistics( );
+        }
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+// Reset latency statistics collected for the specified video source
+bool XAutomationServer::ResetVideoProcessingGraphLatency( uint32_t videoSourceId )
+{
+    XScopedLock         lock( &mData->ServerSync );
+    VsdMap::iterator    vsDataIt = mData->RunningVideoSources.find( videoSourceId );
+    bool                ret      = false;
+
+    if ( vsDataIt != mData->RunningVideoSources.end( ) )
+    {
+        shared_ptr<VideoSourceData> vsData = vsDataIt->second;
+        XScopedLock                 infoLock( &vsData->VideoFrameInfoSync );
+
+        for ( XLatencyHistogram& histogram : vsData->StepLatency )
+        {
+            histogram.Reset( );
+        }
+
+        vsData->GraphLatency.Reset( );
+        vsData->QueueWaitLatency.Reset( );
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+// Start recording trace of video processing done for all video sources
+void XAutomationServer::StartVideoProcessingTrace( uint32_t maxEventsCount )
+{
+    mData->ProcessingTrace.Start( maxEventsCount );
+}
+
+// Stop recording trace of video processing
+void XAutomationServer::StopVideoProcessingTrace( )
+{
+    mData->ProcessingTrace.Stop( );
+}
+
+// Save recorded video processing trace into a JSON file in Chrome's trace event format
+XErrorCode XAutomationServer::SaveVideoProcessingTrace( const string& fileName )
+{
+    return mData->ProcessingTrace.Save( fileName );
+}
+
 // Start all video sources
 void XAutomationServer::StartAllVideoSources( )
 {
@@ -665,6 +903,39 @@ bool XAutomationServer::AddVideoSourceListener( uint32_t videoSourceId, IAutomat
     return ret;
 }
 
+// Get mailbox providing the latest video frame of the specified video source
+shared_ptr<const XVideoFrameMailbox> XAutomationServer::GetVideoFrameMailbox( uint32_t videoSourceId )
+{
+    XScopedLock                          lock( &mData->ServerSync );
+    VsdMap::iterator                     itAddVideoSource     = mData->AddedVideoSources.find( videoSourceId );
+    VsdMap::iterator                     itRunningVideoSource = mData->RunningVideoSources.find( videoSourceId );
+    shared_ptr<const XVideoFrameMailbox> ret;
+
+    if ( itAddVideoSource != mData->AddedVideoSources.end( ) )
+    {
+        ret = itAddVideoSource->second->FrameMailbox;
+    }
+    else if ( itRunningVideoSource != mData->RunningVideoSources.end( ) )
+    {
+        shared_ptr<VideoSourceData> vsData = itRunningVideoSource->second;
+
+        ret = vsData->FrameMailbox;
+
+        // put the most recent frame into the mailbox, so new subscriber does not wait for the next one
+        if ( vsData->VideoProcessingSync.TryLock( ) )
+        {
+            if ( vsData->LastImage )
+            {
+                vsData->PublishNewFrame( );
+            }
+
+            vsData->VideoProcessingSync.Unlock( );
+        }
+    }
+
+    return ret;
+}
+
 // Remove listener from the specified video source
 void XAutomationServer::RemoveVideoSourceListener( uint32_t videoSourceId, IAutomationVideoSourceListener* listener )
 {
@@ -691,7 +962,14 @@ uint32_t XAutomationServer::AddThread( const std::shared_ptr<XScriptingEnginePlu
     XScopedLock lock( &mData->ServerSync );
     uint32_t    ret = ++mData->DeviceCounter;
 
-    mData->AddedThreads.insert( ThreadMap::value_type( ret, ScriptingThreadData::Create( ret, msecInterval, scriptToRun, mData.get( ) ) ) );
+    shared_ptr<ScriptingThreadData> threadData = ScriptingThreadData::Create( ret, msecInterval, scriptToRun, mData.get( ) );
+
+    if ( threadData )
+    {
+        threadData->ThreadOptions = mData->ThreadOptions[static_cast<int>( XAutomationThreadRole::Scripting )];
+    }
+
+    mData->AddedThreads.insert( ThreadMap::value_type( ret, threadData ) );
 
     return ret;
 }
@@ -774,6 +1052,18 @@ XErrorCode XAutomationServer::SetVariable( const string& name, const XVariant& v
     return mData->SetHostVariable( name, value );
 }
 
+// Get image variable from common storage
+XErrorCode XAutomationServer::GetImageVariable( const string& name, shared_ptr<const XImage>& image )
+{
+    return mData->GetHostVariable( name, image );
+}
+
+// Set image variable into common storage
+XErrorCode XAutomationServer::SetImageVariable( const string& name, const shared_ptr<const XImage>& image )
+{
+    return mData->SetHostVariable( name, image );
+}
+
 // Set listener to monitor for variables changes
 void XAutomationServer::SetVariablesListener( IAutomationVariablesListener* listener, bool notifyExistingVariables )
 {
@@ -927,16 +1217,42 @@ void XAutomationServerData::CleanAlreadyFinalized( )
     }
 }
 
+// Get shard of host variables, which keeps variable with the specified name
+HostVariablesShard& XAutomationServerData::GetVariablesShard( const string& name )
+{
+    return VariablesShards[hash<string>( )( name ) % VARIABLES_SHARDS_COUNT];
+}
+
+// Lock all shards of host variables - always in the same order to avoid dead locks
+void XAutomationServerData::LockAllVariablesShards( )
+{
+    for ( int i = 0; i < VARIABLES_SHARDS_COUNT; i++ )
+    {
+        VariablesShards[i].Sync.Lock( );
+    }
+}
+
+// Unlock all shards of host variables
+void XAutomationServerData::UnlockAllVariablesShards( )
+{
+    for ( int i = VARIABLES_SHARDS_COUNT - 1; i >= 0; i-- )
+    {
+        VariablesShards[i].Sync.Unlock( );
+    }
+}
+
 // Get host variable from common storage
 XErrorCode XAutomationServerData::GetHostVariable( const string& name, XVariant& value )
 {
+    HostVariablesShard& shard = GetVariablesShard( name );
+
     value.SetEmpty( );
 
-    XScopedLock lock( &VariablesSync );
+    XScopedLock lock( &shard.Sync );
 
-    map<string, XVariant>::const_iterator it = HostVariables.find( name );
+    map<string, XVariant>::const_iterator it = shard.Variables.find( name );
 
-    if ( it != HostVariables.end( ) )
+    if ( it != shard.Variables.end( ) )
     {
         value = it->second;
     }
@@ -947,119 +1263,199 @@ XErrorCode XAutomationServerData::GetHostVariable( const string& name, XVariant&
 // Set host variable into common storage
 XErrorCode XAutomationServerData::SetHostVariable( const string& name, const XVariant& value )
 {
-    XScopedLock lock( &VariablesSync );
+    HostVariablesShard& shard = GetVariablesShard( name );
+    XScopedLock         lock( &shard.Sync );
 
     if ( value.IsNullOrEmpty( ) )
     {
-        HostVariables.erase( name );
+        shard.Variables.erase( name );
     }
     else
     {
-        HostVariables[name] = value;
+        shard.Variables[name] = value;
     }
 
     // remove any image variable with such name
-    HostImageVariables.erase( name );
+    shard.ImageVariables.erase( name );
 
-    // notify listener if it was set
+    // notify listener if it was set (while shard is still locked, so notifications come in the order of changes);
+    // the listener is only changed with all shards locked, so it can be checked without taking its lock
     if ( VariablesListener != nullptr )
     {
+        XScopedLock listenerLock( &VariablesListenerSync );
+
         VariablesListener->OnVariableSet( name, value );
     }
 
     return SuccessCode;
 }
 
-// Get host image variable from common storage
-XErrorCode XAutomationServerData::GetHostVariable( const string& name, shared_ptr<XImage>& value )
+// Get host image variable from common storage (reference to the stored image, not a copy)
+XErrorCode XAutomationServerData::GetHostVariable( const string& name, shared_ptr<const XImage>& value )
 {
+    HostVariablesShard& shard = GetVariablesShard( name );
+
     value.reset( );
 
-    XScopedLock lock( &VariablesSync );
+    XScopedLock lock( &shard.Sync );
 
-    map<string, shared_ptr<XImage> >::const_iterator it = HostImageVariables.find( name );
+    map<string, HostImageVariable>::const_iterator it = shard.ImageVariables.find( name );
 
-    if ( it != HostImageVariables.end( ) )
+    if ( it != shard.ImageVariables.end( ) )
     {
-        value = it->second->Clone( );
+        value = it->second.Image;
     }
 
     return SuccessCode;
 }
 
-// Set host image variable into common storage
+// Set host image variable into common storage (the image is shared, so must not be changed afterwards)
 XErrorCode XAutomationServerData::SetHostVariable( const string& name, const shared_ptr<const XImage>& value )
 {
-    XScopedLock lock( &VariablesSync );
+    HostVariablesShard& shard = GetVariablesShard( name );
+    XScopedLock         lock( &shard.Sync );
+
+    StoreHostImageVariable( shard, name, value );
+
+    return SuccessCode;
+}
+
+// Set copy of the image as host variable into common storage
+XErrorCode XAutomationServerData::SetHostVariableCopy( const string& name, const shared_ptr<const XImage>& value )
+{
+    HostVariablesShard& shard = GetVariablesShard( name );
+    shared_ptr<XImage>  imageCopy;
+    XErrorCode          ret = SuccessCode;
+
+    if ( value )
+    {
+        // take previously replaced image of the variable, if nobody uses it any more - it is not
+        // reachable through the variables map, so nobody can get new reference to it
+        {
+            XScopedLock lock( &shard.Sync );
+
+            map<string, HostImageVariable>::iterator it = shard.ImageVariables.find( name );
+
+            if ( ( it != shard.ImageVariables.end( ) ) && ( it->second.SpareImage ) )
+            {
+                if ( it->second.SpareImage.use_count( ) == 1 )
+                {
+                    imageCopy = const_pointer_cast<XImage>( it->second.SpareImage );
+                }
+                it->second.SpareImage.reset( );
+            }
+        }
+
+        // copy image without holding any locks
+        if ( !value->CopyDataOrClone( imageCopy ) )
+        {
+            ret = ErrorOutOfMemory;
+        }
+    }
+
+    if ( ret == SuccessCode )
+    {
+        XScopedLock lock( &shard.Sync );
+
+        StoreHostImageVariable( shard, name, imageCopy );
+    }
+
+    return ret;
+}
 
+// Put image variable into the shard of host variables, which must be locked by caller
+void XAutomationServerData::StoreHostImageVariable( HostVariablesShard& shard, const string& name, const shared_ptr<const XImage>& value )
+{
     if ( !value )
     {
-        HostImageVariables.erase( name );
+        shard.ImageVariables.erase( name );
     }
     else
     {
-        map<string, shared_ptr<XImage> >::iterator it = HostImageVariables.find( name );
+        HostImageVariable& variable = shard.ImageVariables[name];
 
-        if ( it == HostImageVariables.end( ) )
-        {
-            HostImageVariables.insert( pair<string, shared_ptr<XImage> >( name, value->Clone( ) ) );
-        }
-        else
-        {
-            value->CopyDataOrClone( it->second );
-        }
+        variable.SpareImage = variable.Image;
+        variable.Image      = value;
     }
 
     // remove any variant variable with such name
-    HostVariables.erase( name );
-
-    return SuccessCode;
+    shard.Variables.erase( name );
 }
 
 // Clear all variables
 void XAutomationServerData::ClearAllVariables( )
 {
-    XScopedLock lock( &VariablesSync );
+    LockAllVariablesShards( );
 
-    HostVariables.clear( );
-    HostImageVariables.clear( );
+    for ( int i = 0; i < VARIABLES_SHARDS_COUNT; i++ )
+    {
+        VariablesShards[i].Variables.clear( );
+        VariablesShards[i].ImageVariables.clear( );
+    }
 
     // notify listener if it was set
     if ( VariablesListener != nullptr )
     {
+        XScopedLock listenerLock( &VariablesListenerSync );
+
         VariablesListener->OnClearAllVariables( );
     }
+
+    UnlockAllVariablesShards( );
 }
 
 // Set listener to monitor for variables changes
 void XAutomationServerData::SetVariablesListener( IAutomationVariablesListener* listener, bool notifyExistingVariables )
 {
-    XScopedLock lock( &VariablesSync );
-
-    VariablesListener = listener;
+    // shards are locked first, as it is done when variables are set
+    LockAllVariablesShards( );
 
-    if ( ( notifyExistingVariables ) && ( VariablesListener != nullptr ) )
     {
-        for ( auto& kvp : HostVariables )
+        XScopedLock listenerLock( &VariablesListenerSync );
+
+        VariablesListener = listener;
+
+        if ( ( notifyExistingVariables ) && ( VariablesListener != nullptr ) )
         {
-            VariablesListener->OnVariableSet( kvp.first, kvp.second );
-        }
+            for ( int i = 0; i < VARIABLES_SHARDS_COUNT; i++ )
+            {
+                for ( auto& kvp : VariablesShards[i].Variables )
+                {
+                    VariablesListener->OnVariableSet( kvp.first, kvp.second );
+                }
+            }
 
-        // map<string, shared_ptr<XImage> > HostImageVariables;
+            // image variables are not reported
+        }
     }
+
+    UnlockAllVariablesShards( );
 }
 
 // Clear variables listener, so no more change notifications are sent
 void XAutomationServerData::ClearVariablesListener( )
 {
-    XScopedLock lock( &VariablesSync );
+    // shards are locked, so that the listener does not change while any variable is being set
+    LockAllVariablesShards( );
+
+    {
+        XScopedLock listenerLock( &VariablesListenerSync );
+
+        VariablesListener = nullptr;
+    }
 
-    VariablesListener = nullptr;
+    UnlockAllVariablesShards( );
 }
 
 // Prepares plug-ins of the video processing graph, so those are ready to be used for new frame processing
 void VideoSourceData::PreparePlugins( )
 {
+    StepAcceptsHistograms.assign( ProcessingGraph.StepsCount( ), true );
+    StepAcceptsRegion.assign( ProcessingGraph.StepsCount( ), true );
+    StepFramesToSkip.assign( ProcessingGraph.StepsCount( ), 0 );
+    StepNextRunTime.assign( ProcessingGraph.StepsCount( ), steady_clock::time_point( ) );
+    StepIsDue.assign( ProcessingGraph.StepsCount( ), true );
+
     if ( ( ProcessingGraph.StepsCount( ) != 0 ) && ( Server->PluginsEngine ) )
     {
         int    stepCounter = 0;
@@ -1085,17 +1481,20 @@ void VideoSourceData::PreparePlugins( )
                         XErrorCode                         errorCode;
                         ScriptingEnginePluginCallbacks     callbacks;
 
-                        callbacks.GetHostName          = ScriptingEnginePluginCallback_GetHostName;
-                        callbacks.GetHostVersion       = ScriptingEnginePluginCallback_GetHostVersion;
-                        callbacks.PrintString          = ScriptingEnginePluginCallback_PrintString;
-                        callbacks.CreatePluginInstance = ScriptingEnginePluginCallback_CreatePluginInstance;
-                        callbacks.GetImage             = ScriptingEnginePluginCallback_GetImage;
-                        callbacks.SetImage             = ScriptingEnginePluginCallback_SetImage;
-                        callbacks.GetVariable          = ScriptingEnginePluginCallback_GetVariable;
-                        callbacks.SetVariable          = ScriptingEnginePluginCallback_SetVariable;
-                        callbacks.GetImageVariable     = ScriptingEnginePluginCallback_GetImageVariable;
-                        callbacks.SetImageVariable     = ScriptingEnginePluginCallback_SetImageVariable;
-                        callbacks.GetVideoSource       = ScriptingEnginePluginCallback_GetVideoSource;
+                        callbacks.GetHostName                = ScriptingEnginePluginCallback_GetHostName;
+                        callbacks.GetHostVersion             = ScriptingEnginePluginCallback_GetHostVersion;
+                        callbacks.PrintString                = ScriptingEnginePluginCallback_PrintString;
+                        callbacks.CreatePluginInstance       = ScriptingEnginePluginCallback_CreatePluginInstance;
+                        callbacks.GetImage                   = ScriptingEnginePluginCallback_GetImage;
+                        callbacks.SetImage                   = ScriptingEnginePluginCallback_SetImage;
+                        callbacks.GetVariable                = ScriptingEnginePluginCallback_GetVariable;
+                        callbacks.SetVariable                = ScriptingEnginePluginCallback_SetVariable;
+                        callbacks.GetImageVariable           = ScriptingEnginePluginCallback_GetImageVariable;
+                        callbacks.SetImageVariable           = ScriptingEnginePluginCallback_SetImageVariable;
+                        callbacks.GetVideoSource             = ScriptingEnginePluginCallback_GetVideoSource;
+                        callbacks.GetImageHistograms         = ScriptingEnginePluginCallback_GetImageHistograms;
+                        callbacks.GetSharedImageVariable     = ScriptingEnginePluginCallback_GetSharedImageVariable;
+                        callbacks.ReleaseSharedImageVariable = ScriptingEnginePluginCallback_ReleaseSharedImageVariable;
 
                         // set callback first to allow script interface with the host
                         scriptingEngine->SetCallbacks( &callbacks, this );
@@ -1145,9 +1544,17 @@ void VideoSourceData::VideoProcessingThreadHandler( void* param )
     VideoSourceData* self = static_cast<VideoSourceData*>( param );
     XErrorCode       ecode;
 
+    if ( !ApplyThreadOptions( XAutomationThreadRole::VideoProcessing, self->ProcessingThreadOptions ) )
+    {
+        self->ReportError( "Failed applying scheduling options to video processing thread" );
+    }
+
     // prepare plug-ins for the video processing graph
     self->PreparePlugins( );
 
+    // video source may notify from a new thread each time it is started, so options get applied to it again
+    self->SourceThreadOptionsApplied = false;
+
     // finally start the video source
     ecode = self->VideoSource->Start( );
     if ( ecode != SuccessCode )
@@ -1163,9 +1570,7 @@ void VideoSourceData::VideoProcessingThreadHandler( void* param )
 
         while ( !self->NeedToExitProcessingThread )
         {
-            // TODO: better have auto reset event here
             self->NewFrameIsAvailableEvent.Wait( );
-            self->NewFrameIsAvailableEvent.Reset( );
 
             if ( !self->NeedToExitProcessingThread )
             {
@@ -1186,8 +1591,20 @@ void VideoSourceData::OnNewImage( const shared_ptr<const XImage>& image )
 {
     if ( !NeedToExitProcessingThread )
     {
-        bool dropIfBusy = this->DropVideoFramesWhenBusy;
-        bool dropIt     = false;
+        // video source's thread is known only once it provides the first frame, so apply options to it
+        // before making the first copy of its frame - memory of that copy gets allocated on its NUMA node
+        if ( !SourceThreadOptionsApplied )
+        {
+            if ( !ApplyThreadOptions( XAutomationThreadRole::VideoSource, SourceThreadOptions ) )
+            {
+                ReportError( "Failed applying scheduling options to video source thread" );
+            }
+            SourceThreadOptionsApplied = true;
+        }
+
+        steady_clock::time_point arrivalTime = steady_clock::now( );
+        bool                     dropIfBusy  = this->DropVideoFramesWhenBusy;
+        bool                     dropIt      = false;
 
         // check if processing thread is still busy
         if ( !ProcessingThreadIsFreeEvent.IsSignaled( ) )
@@ -1241,6 +1658,9 @@ void VideoSourceData::OnNewImage( const shared_ptr<const XImage>& image )
                 // clear any error if the video source is active
                 LastError.clear( );
 
+                NewFrameArrivalTime = arrivalTime;
+                NewFrameNumber      = FrameInfo.FramesReceived;
+
                 // update image in the processing buffer
                 if ( ProcessingGraphBuffer.empty( ) )
                 {
@@ -1285,6 +1705,8 @@ void VideoSourceData::ReportError( const string& errorMessage )
 // Notify listeners of the new video frame available
 void VideoSourceData::NotifyNewFrame( )
 {
+    PublishNewFrame( );
+
     XScopedLock lock( &ListenerSync );
 
     for ( ListenersList::iterator it = Listeners.begin( ); it != Listeners.end( ); )
@@ -1298,6 +1720,33 @@ void VideoSourceData::NotifyNewFrame( )
     }
 }
 
+// Hand the new video frame over to the mailbox, if anyone has subscribed to it
+void VideoSourceData::PublishNewFrame( )
+{
+    // the mailbox is shared with subscribers, so nobody needs new frames if the server is its only owner
+    if ( ( FrameMailbox.use_count( ) > 1 ) && ( FrameMailbox->GetLatestFrame( ) != LastImage ) )
+    {
+        // the frame is not copied, so the server must never write into it again - its place in the processing
+        // buffer is taken by the image returned from the mailbox, but only if none of the subscribers hold it
+        // any more (it is not in the mailbox already, so nobody can get new reference to it meanwhile)
+        shared_ptr<XImage> spareImage = const_pointer_cast<XImage>( FrameMailbox->PutFrame( LastImage ) );
+
+        if ( spareImage.use_count( ) != 1 )
+        {
+            spareImage.reset( );
+        }
+
+        for ( size_t i = 0; i < ProcessingGraphBuffer.size( ); i++ )
+        {
+            if ( ProcessingGraphBuffer[i] == LastImage )
+            {
+                ProcessingGraphBuffer[i] = spareImage;
+                break;
+            }
+        }
+    }
+}
+
 // Do processing of the new video frame and then notify listeners
 void VideoSourceData::PerformNewFrameProcessing( )
 {
@@ -1312,17 +1761,42 @@ void VideoSourceData::PerformNewFrameProcessing( )
     XPixelFormat    originalPixelFormat = LastImage->Format( );
     int32_t         videoProcessingStepsDone = 0;
     float           graphTimeTaken      = 0.0f;
+    bool            fusingPointOperations    = false;
+
+    // time needs to be measured if performance monitor is running or trace is being recorded
+    bool                     isTraceRunning      = Server->ProcessingTrace.IsRunning( );
+    bool                     measureTime         = ( ( IsPerformanceMonitroRunning ) || ( isTraceRunning ) );
+    steady_clock::time_point processingStartTime;
+
+    if ( measureTime )
+    {
+        processingStartTime = steady_clock::now( );
+
+        FrameStepTimeTaken.clear( );
+        TraceEvents.clear( );
+
+        if ( isTraceRunning )
+        {
+            XVideoProcessingTraceEvent event = { "Queue wait", NewFrameNumber, NewFrameArrivalTime, processingStartTime };
+            TraceEvents.push_back( event );
+        }
+    }
+
+    // new frame has arrived, so any statistics collected so far are outdated
+    StatisticsCache.Invalidate( );
 
     // apply video processing graph if any
     if ( ProcessingGraph.StepsCount( ) != 0 )
     {
         steady_clock::time_point    processingGraphStartTime;
 
-        if ( IsPerformanceMonitroRunning )
+        if ( measureTime )
         {
             processingGraphStartTime = steady_clock::now( );
         }
 
+        UpdateStepsSchedule( );
+
         for ( XVideoSourceProcessingGraph::ConstIterator stepIt = ProcessingGraph.begin( ), endIt = ProcessingGraph.end( );
               ( stepIt != endIt ) && ( errorMessage.empty( ) ); ++stepIt )
         {
@@ -1339,11 +1813,22 @@ void VideoSourceData::PerformNewFrameProcessing( )
                 {
                     errorMessage = string( "Failed getting plug-in instance for step \"" + stepIt->Name( ) + "\"." );
                 }
+                else if ( !ShouldRunStep( *stepIt, currentStepIndex ) )
+                {
+                    // skipped step keeps results of its last run - plug-in's state or variables set by script
+                    videoProcessingStepsDone++;
+
+                    if ( ( measureTime ) && ( IsPerformanceMonitroRunning ) )
+                    {
+                        FrameStepTimeTaken.push_back( SKIPPED_STEP_TIME );
+                    }
+                }
                 else
                 {
                     steady_clock::time_point    processingStepStartTime;
+                    bool                        imageChanged = false;
 
-                    if ( IsPerformanceMonitroRunning )
+                    if ( measureTime )
                     {
                         processingStepStartTime = steady_clock::now( );
                     }
@@ -1351,19 +1836,64 @@ void VideoSourceData::PerformNewFrameProcessing( )
                     switch ( stepIt->GetPluginType( ) )
                     {
                     case PluginType_ImageProcessingFilter:
-                        errorCode = DoImageProcessingFilterPlugin( static_pointer_cast<XImageProcessingFilterPlugin>( plugin ), currentImageIndex );
-                        break;
+                        {
+                            // consecutive point-wise steps are combined into single look-up table, which is
+                            // applied once by the last step of the run - saves a pass over the image per step
+                            XVideoSourceProcessingGraph::ConstIterator nextStepIt = stepIt + 1;
+                            bool nextIsPointOperation = false;
 
-                    case PluginType_VideoProcessing:
-                        errorCode = DoVideoProcessingPlugin( static_pointer_cast<XVideoProcessingPlugin>( plugin ) );
-                        break;
+                            if ( fusingPointOperations )
+                            {
+                                // maps of this step were collected when looking ahead from the previous one
+                                for ( int i = 0; i < 3 * 256; i++ )
+                                {
+                                    CombinedPointMaps[i] = StepPointMaps[( i & ~255 ) + CombinedPointMaps[i]];
+                                }
+
+                                nextIsPointOperation = ( nextStepIt != endIt ) &&
+                                    ( GetStepPointOperationMaps( *nextStepIt, currentStepIndex + 1, StepPointMaps ) );
+
+                                if ( !nextIsPointOperation )
+                                {
+                                    fusingPointOperations = false;
+                                    errorCode = ApplyPointOperationMaps( CombinedPointMaps );
+                                }
+                            }
+                            else
+                            {
+                                fusingPointOperations = ( nextStepIt != endIt ) &&
+                                    ( GetStepPointOperationMaps( *stepIt, currentStepIndex, CombinedPointMaps ) ) &&
+                                    ( GetStepPointOperationMaps( *nextStepIt, currentStepIndex + 1, StepPointMaps ) );
+
+                                errorCode = ( fusingPointOperations ) ? SuccessCode :
+                                    DoImageProcessingFilterPlugin( static_pointer_cast<XImageProcessingFilterPlugin>( plugin ), *stepIt, currentStepIndex, currentImageIndex );
+                            }
+
+                            // the image is not touched while point operations are only being combined
+                            imageChanged = !fusingPointOperations;
+                        }
+                        break;
+
+                    case PluginType_VideoProcessing:
+                        errorCode    = DoVideoProcessingPlugin( static_pointer_cast<XVideoProcessingPlugin>( plugin ) );
+                        imageChanged = true;
+                        break;
 
                     case PluginType_Detection:
-                        errorCode = DoDetectionPlugin( static_pointer_cast<XDetectionPlugin>( plugin ) );
+                        errorCode    = DoDetectionPlugin( static_pointer_cast<XDetectionPlugin>( plugin ), *stepIt );
+                        // detection plug-ins may highlight what they found, unless they run in read-only mode
+                        imageChanged = !static_pointer_cast<XDetectionPlugin>( plugin )->IsReadOnlyMode( );
+                        break;
+
+                    case PluginType_ImageProcessing:
+                        errorCode = DoImageProcessingPlugin( static_pointer_cast<XImageProcessingPlugin>( plugin ), *stepIt, currentStepIndex );
                         break;
 
                     case PluginType_ScriptingEngine:
-                        errorCode = DoScriptingEnginePlugin( static_pointer_cast<XScriptingEnginePlugin>( plugin ) );
+                        ImageAccessedByScript = false;
+                        errorCode    = DoScriptingEnginePlugin( static_pointer_cast<XScriptingEnginePlugin>( plugin ) );
+                        // scripts could change the image only if they accessed it
+                        imageChanged = ImageAccessedByScript;
                         break;
 
                     default:
@@ -1371,22 +1901,42 @@ void VideoSourceData::PerformNewFrameProcessing( )
                         break;
                     }
 
-                    // get time taken by the video processing step if performance monitor is enabled
-                    if ( IsPerformanceMonitroRunning )
+                    MarkStepRun( *stepIt, currentStepIndex );
+
+                    // cached statistics are kept for the next step, unless this one wrote into the image
+                    if ( imageChanged )
                     {
-                        float timeTaken = static_cast<float>(
-                            duration_cast<std::chrono::microseconds>(
-                            steady_clock::now( ) - processingStepStartTime ).count( ) ) / 1000.0f;
+                        StatisticsCache.Invalidate( );
+                    }
 
+                    // get time taken by the video processing step if performance monitor is enabled
+                    if ( measureTime )
+                    {
+                        steady_clock::time_point processingStepEndTime = steady_clock::now( );
+                        uint32_t                 microsecondsTaken     = static_cast<uint32_t>(
+                            duration_cast<std::chrono::microseconds>( processingStepEndTime - processingStepStartTime ).count( ) );
 
-                        if ( ProcessingStepTimeTaken[currentStepIndex].size( ) < PERFORMANCE_HISTORY_LENGTH )
+                        if ( IsPerformanceMonitroRunning )
                         {
-                            ProcessingStepTimeTaken[currentStepIndex].push_back( timeTaken );
+                            float timeTaken = static_cast<float>( microsecondsTaken ) / 1000.0f;
+
+                            if ( ProcessingStepTimeTaken[currentStepIndex].size( ) < PERFORMANCE_HISTORY_LENGTH )
+                            {
+                                ProcessingStepTimeTaken[currentStepIndex].push_back( timeTaken );
+                            }
+                            else
+                            {
+                                ProcessingStepTimeTaken[currentStepIndex][NextTimeIndex[currentStepIndex]++] = timeTaken;
+                                NextTimeIndex[currentStepIndex] %= PERFORMANCE_HISTORY_LENGTH;
+                            }
+
+                            FrameStepTimeTaken.push_back( microsecondsTaken );
                         }
-                        else
+
+                        if ( isTraceRunning )
                         {
-                            ProcessingStepTimeTaken[currentStepIndex][NextTimeIndex[currentStepIndex]++] = timeTaken;
-                            NextTimeIndex[currentStepIndex] %= PERFORMANCE_HISTORY_LENGTH;
+                            XVideoProcessingTraceEvent event = { stepIt->Name( ), NewFrameNumber, processingStepStartTime, processingStepEndTime };
+                            TraceEvents.push_back( event );
                         }
                     }
 
@@ -1427,11 +1977,19 @@ void VideoSourceData::PerformNewFrameProcessing( )
         }
 
         // get total time taken by the processing graph
-        if ( IsPerformanceMonitroRunning )
+        if ( measureTime )
         {
+            steady_clock::time_point processingGraphEndTime = steady_clock::now( );
+
             graphTimeTaken = static_cast<float>(
                 duration_cast<std::chrono::microseconds>(
-                steady_clock::now( ) - processingGraphStartTime ).count( ) ) / 1000.0f;
+                processingGraphEndTime - processingGraphStartTime ).count( ) ) / 1000.0f;
+
+            if ( isTraceRunning )
+            {
+                XVideoProcessingTraceEvent event = { "Processing graph", NewFrameNumber, processingGraphStartTime, processingGraphEndTime };
+                TraceEvents.push_back( event );
+            }
         }
     }
 
@@ -1457,8 +2015,11 @@ void VideoSourceData::PerformNewFrameProcessing( )
             ProcessingStepAverageTime = vector<float>( stepsCount );
             TotalGraphTime            = vector<float>( );
             GraphTimeIndex            = 0;
+            StepLatency               = vector<XLatencyHistogram>( stepsCount );
 
             TotalGraphTime.reserve( PERFORMANCE_HISTORY_LENGTH );
+            GraphLatency.Reset( );
+            QueueWaitLatency.Reset( );
         }
 
         if ( IsPerformanceMonitroRunning )
@@ -1479,6 +2040,22 @@ void VideoSourceData::PerformNewFrameProcessing( )
             }
 
             TotalAverageGraphTime = ( TotalGraphTime.size( ) == 0 ) ? 0.0f : std::accumulate( TotalGraphTime.begin( ), TotalGraphTime.end( ), 0.0f ) / TotalGraphTime.size( );
+
+            // update latency histograms (steps, which did not run due to an error or were skipped, are not accounted)
+            for ( size_t i = 0, n = std::min( FrameStepTimeTaken.size( ), StepLatency.size( ) ); i < n; i++ )
+            {
+                if ( FrameStepTimeTaken[i] != SKIPPED_STEP_TIME )
+                {
+                    StepLatency[i].Add( FrameStepTimeTaken[i] );
+                }
+            }
+
+            if ( ProcessingGraph.StepsCount( ) != 0 )
+            {
+                GraphLatency.Add( static_cast<uint32_t>( graphTimeTaken * 1000.0f ) );
+            }
+
+            QueueWaitLatency.Add( static_cast<uint32_t>( duration_cast<std::chrono::microseconds>( processingStartTime - NewFrameArrivalTime ).count( ) ) );
         }
 
         // done at the end to minimize number of locks at the cost of extra "bool"
@@ -1501,7 +2078,21 @@ void VideoSourceData::PerformNewFrameProcessing( )
     }
 
     // we provide the new video frame even if processing graph is not complete
-    NotifyNewFrame( );
+    if ( isTraceRunning )
+    {
+        steady_clock::time_point notificationStartTime = steady_clock::now( );
+
+        NotifyNewFrame( );
+
+        XVideoProcessingTraceEvent event = { "Listeners notification", NewFrameNumber, notificationStartTime, steady_clock::now( ) };
+        TraceEvents.push_back( event );
+
+        Server->ProcessingTrace.AddEvents( VideoSourceId, VideoSourceDescriptor->Name( ), TraceEvents );
+    }
+    else
+    {
+        NotifyNewFrame( );
+    }
 
     if ( !errorMessage.empty( ) )
     {
@@ -1510,45 +2101,250 @@ void VideoSourceData::PerformNewFrameProcessing( )
 }
 
 // Run image processing filter plug-in on the current image
-XErrorCode VideoSourceData::DoImageProcessingFilterPlugin( const shared_ptr<XImageProcessingFilterPlugin>& plugin, size_t& currrentGraphBufferIndex )
+XErrorCode VideoSourceData::DoImageProcessingFilterPlugin( const shared_ptr<XImageProcessingFilterPlugin>& plugin, const XVideoSourceProcessingStep& step,
+                                                           int stepIndex, size_t& currrentGraphBufferIndex )
 {
     XErrorCode ret = ErrorUnsupportedPixelFormat;
 
     if ( plugin->IsPixelFormatSupported( LastImage->Format( ) ) )
     {
-        if ( plugin->CanProcessInPlace( ) )
+        xrect region;
+        bool  useRegion = GetStepRegion( step, region );
+
+        if ( ( useRegion ) && ( ( region.x1 > region.x2 ) || ( region.y1 > region.y2 ) ) )
         {
-            ret = plugin->ProcessImage( LastImage );
+            // region is out of the image, so nothing to process
+            ret = SuccessCode;
         }
-        else
+        else if ( useRegion )
         {
-            shared_ptr<XImage> nextImage;
+            ret = ErrorUnsupportedInterface;
 
-            currrentGraphBufferIndex++;
+            if ( StepAcceptsRegion[stepIndex] )
+            {
+                ret = plugin->ProcessImageRegion( LastImage, region );
+
+                if ( ret == ErrorUnsupportedInterface )
+                {
+                    StepAcceptsRegion[stepIndex] = false;
+                }
+            }
 
-            // get image from the buffer, so we could try reusing memory
-            if ( ProcessingGraphBuffer.size( ) > currrentGraphBufferIndex )
+            // in-place filters not aware of regions are given a view of the region, so only pixels'
+            // neighbourhood at its edges differs; other filters may change image size, so process entire image
+            if ( ( ret == ErrorUnsupportedInterface ) && ( plugin->CanProcessInPlace( ) ) )
             {
-                nextImage = ProcessingGraphBuffer[currrentGraphBufferIndex];
+                shared_ptr<XImage> regionView = LastImage->GetSubImage( region.x1, region.y1,
+                    region.x2 - region.x1 + 1, region.y2 - region.y1 + 1 );
+
+                ret = ( regionView ) ? plugin->ProcessImage( regionView ) : ErrorOutOfMemory;
             }
 
-            ret = plugin->ProcessImage( LastImage, nextImage );
+            useRegion = ( ret != ErrorUnsupportedInterface );
+        }
+
+        if ( !useRegion )
+        {
+            if ( plugin->CanProcessInPlace( ) )
+            {
+                ret = ErrorUnsupportedInterface;
+
+                // give the filter histograms shared with other steps, unless it is known not to use them
+                if ( ( StepAcceptsHistograms[stepIndex] ) && ( XImageStatisticsCache::IsFormatSupported( LastImage->Format( ) ) ) )
+                {
+                    const xhistogram* histograms[3];
+
+                    if ( StatisticsCache.GetHistograms( LastImage, histograms ) == SuccessCode )
+                    {
+                        ret = plugin->ProcessImageWithHistograms( LastImage, histograms[0], histograms[1], histograms[2] );
+                    }
 
-            if ( ret == SuccessCode )
+                    if ( ret == ErrorUnsupportedInterface )
+                    {
+                        StepAcceptsHistograms[stepIndex] = false;
+                    }
+                }
+
+                if ( ret == ErrorUnsupportedInterface )
+                {
+                    ret = plugin->ProcessImage( LastImage );
+                }
+            }
+            else
             {
-                // update processing buffer
-                if ( ProcessingGraphBuffer.size( ) <= currrentGraphBufferIndex )
+                shared_ptr<XImage> nextImage;
+
+                currrentGraphBufferIndex++;
+
+                // get image from the buffer, so we could try reusing memory
+                if ( ProcessingGraphBuffer.size( ) > currrentGraphBufferIndex )
                 {
-                    ProcessingGraphBuffer.push_back( nextImage );
+                    nextImage = ProcessingGraphBuffer[currrentGraphBufferIndex];
                 }
-                else
+
+                ret = plugin->ProcessImage( LastImage, nextImage );
+
+                if ( ret == SuccessCode )
                 {
-                    ProcessingGraphBuffer[currrentGraphBufferIndex] = nextImage;
+                    // update processing buffer
+                    if ( ProcessingGraphBuffer.size( ) <= currrentGraphBufferIndex )
+                    {
+                        ProcessingGraphBuffer.push_back( nextImage );
+                    }
+                    else
+                    {
+                        ProcessingGraphBuffer[currrentGraphBufferIndex] = nextImage;
+                    }
+
+                    LastImage = nextImage;
                 }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Get region of interest of the step clipped to the current image (it becomes empty if it is out of the image). False is
+// returned if the step needs to process entire image - no region is set, it covers entire image or the image can not be cut.
+bool VideoSourceData::GetStepRegion( const XVideoSourceProcessingStep& step, xrect& region ) const
+{
+    XPixelFormat format = LastImage->Format( );
+    bool         ret    = false;
+
+    // sub-images are not available for bit-packed and planar images
+    if ( ( step.HasRegion( ) ) && ( format != XPixelFormatUnknown ) && ( format < XPixelFormatBinary1 ) )
+    {
+        const xrect& stepRegion = step.Region( );
+        int32_t      width      = LastImage->Width( );
+        int32_t      height     = LastImage->Height( );
+
+        region.x1 = XMAX( stepRegion.x1, 0 );
+        region.y1 = XMAX( stepRegion.y1, 0 );
+        region.x2 = XMIN( stepRegion.x2, width  - 1 );
+        region.y2 = XMIN( stepRegion.y2, height - 1 );
+
+        ret = ( ( region.x1 != 0 ) || ( region.y1 != 0 ) || ( region.x2 != width - 1 ) || ( region.y2 != height - 1 ) );
+    }
+
+    return ret;
+}
+
+// Check if scheduling attributes of the step can be applied to it - image processing filters, which produce new image,
+// must run for every frame, since following steps expect an image of the size/format they provide
+bool VideoSourceData::IsStepSchedulable( const XVideoSourceProcessingStep& step ) const
+{
+    bool ret = true;
+
+    if ( step.GetPluginType( ) == PluginType_ImageProcessingFilter )
+    {
+        shared_ptr<XImageProcessingFilterPlugin> plugin = static_pointer_cast<XImageProcessingFilterPlugin>( step.GetPluginInstance( ) );
+
+        ret = ( ( plugin ) && ( plugin->CanProcessInPlace( ) ) );
+    }
+
+    return ret;
+}
+
+// Find steps, which are due to run for the new frame according to their frame interval and rate limit
+void VideoSourceData::UpdateStepsSchedule( )
+{
+    int stepIndex = 0;
+
+    for ( auto stepIt = ProcessingGraph.begin( ), endIt = ProcessingGraph.end( ); stepIt != endIt; ++stepIt, ++stepIndex )
+    {
+        bool isDue = true;
 
-                LastImage = nextImage;
+        if ( IsStepSchedulable( *stepIt ) )
+        {
+            if ( StepFramesToSkip[stepIndex] != 0 )
+            {
+                StepFramesToSkip[stepIndex]--;
+                isDue = false;
+            }
+            else if ( ( stepIt->MaxRate( ) > 0.0f ) && ( NewFrameArrivalTime < StepNextRunTime[stepIndex] ) )
+            {
+                isDue = false;
             }
         }
+
+        StepIsDue[stepIndex] = isDue;
+    }
+}
+
+// Check if the step needs to run for the current frame - it must be due and time budget
+// of the frame must not be exhausted yet (if the step can be skipped because of that)
+bool VideoSourceData::ShouldRunStep( const XVideoSourceProcessingStep& step, int stepIndex ) const
+{
+    uint32_t budget = ProcessingGraph.FrameTimeBudget( );
+    bool     ret    = StepIsDue[stepIndex];
+
+    if ( ( ret ) && ( budget != 0 ) && ( step.SkipWhenOverBudget( ) ) && ( IsStepSchedulable( step ) ) )
+    {
+        ret = ( steady_clock::now( ) - NewFrameArrivalTime < std::chrono::milliseconds( budget ) );
+    }
+
+    return ret;
+}
+
+// Update schedule of the step, which was run for the current frame
+void VideoSourceData::MarkStepRun( const XVideoSourceProcessingStep& step, int stepIndex )
+{
+    StepFramesToSkip[stepIndex] = step.FrameInterval( ) - 1;
+
+    if ( step.MaxRate( ) > 0.0f )
+    {
+        steady_clock::duration period = duration_cast<steady_clock::duration>( std::chrono::duration<float>( 1.0f / step.MaxRate( ) ) );
+
+        // next run time is advanced by the period, so the rate is kept on average even if frames do not come exactly
+        // in time; but it is not caught up if the step did not run for longer (or it runs the first time)
+        StepNextRunTime[stepIndex] += period;
+
+        if ( StepNextRunTime[stepIndex] <= NewFrameArrivalTime )
+        {
+            StepNextRunTime[stepIndex] = NewFrameArrivalTime + period;
+        }
+    }
+}
+
+// Check if the step is a point-wise image processing filter, which can provide look-up tables
+// for the current image format - 3 tables for red/green/blue or only the first one for grayscale
+bool VideoSourceData::GetStepPointOperationMaps( const XVideoSourceProcessingStep& step, int stepIndex, uint8_t* maps )
+{
+    XPixelFormat format = LastImage->Format( );
+    bool         ret    = false;
+
+    // steps processing region of interest are not combined, since their tables apply only to part of the image;
+    // neither are those, which may not run for the current frame
+    if ( ( stepIndex != StepFailedInitialization ) && ( !step.HasRegion( ) ) && ( StepIsDue[stepIndex] ) &&
+         ( ( !step.SkipWhenOverBudget( ) ) || ( ProcessingGraph.FrameTimeBudget( ) == 0 ) ) &&
+         ( step.GetPluginType( ) == PluginType_ImageProcessingFilter ) &&
+         ( ( format == XPixelFormatGrayscale8 ) || ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) ) )
+    {
+        shared_ptr<XImageProcessingFilterPlugin> plugin = static_pointer_cast<XImageProcessingFilterPlugin>( step.GetPluginInstance( ) );
+
+        if ( ( plugin ) && ( plugin->CanProcessInPlace( ) ) && ( plugin->IsPixelFormatSupported( format ) ) )
+        {
+            ret = ( plugin->GetPointOperationMaps( format, maps ) == SuccessCode );
+        }
+    }
+
+    return ret;
+}
+
+// Apply combined look-up tables of point-wise steps to the current image
+XErrorCode VideoSourceData::ApplyPointOperationMaps( const uint8_t* maps )
+{
+    ximage*    image = LastImage->ImageData( );
+    XErrorCode ret;
+
+    if ( image->format == XPixelFormatGrayscale8 )
+    {
+        ret = GrayscaleRemapping( image, maps );
+    }
+    else
+    {
+        ret = ColorRemapping( image, maps, maps + 256, maps + 512 );
     }
 
     return ret;
@@ -1568,13 +2364,83 @@ XErrorCode VideoSourceData::DoVideoProcessingPlugin( const shared_ptr<XVideoProc
 }
 
 // Run detection plug-in on the current image
-XErrorCode VideoSourceData::DoDetectionPlugin( const shared_ptr<XDetectionPlugin>& plugin )
+XErrorCode VideoSourceData::DoDetectionPlugin( const shared_ptr<XDetectionPlugin>& plugin, const XVideoSourceProcessingStep& step )
 {
     XErrorCode ret = ErrorUnsupportedPixelFormat;
 
     if ( plugin->IsPixelFormatSupported( LastImage->Format( ) ) )
     {
-        ret = plugin->ProcessImage( LastImage );
+        xrect region;
+
+        if ( !GetStepRegion( step, region ) )
+        {
+            ret = plugin->ProcessImage( LastImage );
+        }
+        else if ( ( region.x1 > region.x2 ) || ( region.y1 > region.y2 ) )
+        {
+            // region is out of the image, so nothing to inspect
+            ret = SuccessCode;
+        }
+        else
+        {
+            // the plug-in is given a view of the region, so anything it highlights stays at its place in the frame
+            shared_ptr<XImage> regionView = LastImage->GetSubImage( region.x1, region.y1,
+                region.x2 - region.x1 + 1, region.y2 - region.y1 + 1 );
+
+            ret = ( regionView ) ? plugin->ProcessImage( regionView ) : ErrorOutOfMemory;
+        }
+    }
+
+    return ret;
+}
+
+// Run image processing plug-in, which only inspects the image (histograms calculated for other steps are reused)
+XErrorCode VideoSourceData::DoImageProcessingPlugin( const shared_ptr<XImageProcessingPlugin>& plugin, const XVideoSourceProcessingStep& step, int stepIndex )
+{
+    XErrorCode ret = ErrorUnsupportedPixelFormat;
+
+    if ( plugin->IsPixelFormatSupported( LastImage->Format( ) ) )
+    {
+        xrect region;
+
+        if ( !GetStepRegion( step, region ) )
+        {
+            ret = ErrorUnsupportedInterface;
+
+            // histograms are put into the cache, so following steps don't need to calculate them again
+            if ( ( StepAcceptsHistograms[stepIndex] ) && ( XImageStatisticsCache::IsFormatSupported( LastImage->Format( ) ) ) )
+            {
+                const xhistogram* histograms[3];
+
+                if ( StatisticsCache.GetHistograms( LastImage, histograms ) == SuccessCode )
+                {
+                    ret = plugin->ProcessImageWithHistograms( LastImage, histograms[0], histograms[1], histograms[2] );
+                }
+
+                if ( ret == ErrorUnsupportedInterface )
+                {
+                    StepAcceptsHistograms[stepIndex] = false;
+                }
+            }
+
+            if ( ret == ErrorUnsupportedInterface )
+            {
+                ret = plugin->ProcessImage( LastImage );
+            }
+        }
+        else if ( ( region.x1 > region.x2 ) || ( region.y1 > region.y2 ) )
+        {
+            // region is out of the image, so nothing to inspect
+            ret = SuccessCode;
+        }
+        else
+        {
+            // histograms of the entire image don't describe the region, so the plug-in calculates its own
+            shared_ptr<XImage> regionView = LastImage->GetSubImage( region.x1, region.y1,
+                region.x2 - region.x1 + 1, region.y2 - region.y1 + 1 );
+
+            ret = ( regionView ) ? plugin->ProcessImage( regionView ) : ErrorOutOfMemory;
+        }
     }
 
     return ret;
@@ -1698,7 +2564,7 @@ XErrorCode XAutomationServerData::ScriptingEnginePluginCallback_SetVariable( xst
         if ( value->type == XVT_Image )
         {
             // still store it as image, not variant
-            ret = SetHostVariable( name, XImage::Create( value->value.imageVal ) );
+            ret = SetHostVariableCopy( name, XImage::Create( value->value.imageVal ) );
         }
         else
         {
@@ -1716,9 +2582,21 @@ XErrorCode XAutomationServerData::ScriptingEnginePluginCallback_GetImageVariable
 
     if ( ( name != nullptr ) && ( value != nullptr ) )
     {
-        shared_ptr<XImage> image;
+        shared_ptr<const XImage> sharedImage;
+        shared_ptr<XImage>       image;
 
-        ret = GetHostVariable( name, image );
+        ret = GetHostVariable( name, sharedImage );
+
+        // plug-in becomes owner of the provided image, so it gets own copy (made without holding any locks)
+        if ( ( ret == SuccessCode ) && ( sharedImage ) )
+        {
+            image = sharedImage->Clone( );
+
+            if ( !image )
+            {
+                ret = ErrorOutOfMemory;
+            }
+        }
 
         if ( ( ret == SuccessCode ) && ( image ) )
         {
@@ -1742,12 +2620,53 @@ XErrorCode XAutomationServerData::ScriptingEnginePluginCallback_SetImageVariable
 
     if ( ( name != nullptr ) && ( value != nullptr ) )
     {
-        ret = SetHostVariable( name, XImage::Create( value ) );
+        // image belongs to plug-in, so need to keep a copy
+        ret = SetHostVariableCopy( name, XImage::Create( value ) );
     }
 
     return ret;
 }
 
+// Callback to get image variable from the host side without copying it
+XErrorCode XAutomationServerData::ScriptingEnginePluginCallback_GetSharedImageVariable( xstring name, const ximage** value, void** handle )
+{
+    XErrorCode ret = ErrorNullParameter;
+
+    if ( ( name != nullptr ) && ( value != nullptr ) && ( handle != nullptr ) )
+    {
+        shared_ptr<const XImage> sharedImage;
+
+        *value  = nullptr;
+        *handle = nullptr;
+
+        ret = GetHostVariable( name, sharedImage );
+
+        // plug-in keeps a reference to the stored image, so it stays alive even if the variable is replaced
+        if ( ( ret == SuccessCode ) && ( sharedImage ) )
+        {
+            shared_ptr<const XImage>* imageReference = new (nothrow) shared_ptr<const XImage>( sharedImage );
+
+            if ( imageReference == nullptr )
+            {
+                ret = ErrorOutOfMemory;
+            }
+            else
+            {
+                *value  = sharedImage->ImageData( );
+                *handle = imageReference;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Callback to release image variable previously provided without copying
+void XAutomationServerData::ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* handle )
+{
+    delete static_cast<shared_ptr<const XImage>*>( handle );
+}
+
 // ==================== Video source specific callbacks ====================
 
 // Callback to get name of the host running scripting engine plug-in
@@ -1798,6 +2717,18 @@ XErrorCode VideoSourceData::ScriptingEnginePluginCallback_SetImageVariable( void
     return static_cast<VideoSourceData*>( userParam )->Server->ScriptingEnginePluginCallback_SetImageVariable( name, value );
 }
 
+// Callback to get image variable from the host side without copying it
+XErrorCode VideoSourceData::ScriptingEnginePluginCallback_GetSharedImageVariable( void* userParam, xstring name, const ximage** value, void** handle )
+{
+    return static_cast<VideoSourceData*>( userParam )->Server->ScriptingEnginePluginCallback_GetSharedImageVariable( name, value, handle );
+}
+
+// Callback to release image variable previously provided without copying
+void VideoSourceData::ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* userParam, void* handle )
+{
+    static_cast<VideoSourceData*>( userParam )->Server->ScriptingEnginePluginCallback_ReleaseSharedImageVariable( handle );
+}
+
 // Callback to get current image available on the host side
 XErrorCode VideoSourceData::ScriptingEnginePluginCallback_GetImage( void* userParam, ximage** image )
 {
@@ -1808,6 +2739,9 @@ XErrorCode VideoSourceData::ScriptingEnginePluginCallback_GetImage( void* userPa
     {
         ximage* hostImage = self->LastImage->ImageData( );
 
+        // script can modify the image in place now, so cached statistics can not be trusted any more
+        self->ImageAccessedByScript = true;
+
         ret = XImageCreate( hostImage->data, hostImage->width, hostImage->height, hostImage->stride, hostImage->format, image );
     }
 
@@ -1823,6 +2757,7 @@ XErrorCode VideoSourceData::ScriptingEnginePluginCallback_SetImage( void* userPa
     if ( self->LastImage )
     {
         ret = SuccessCode;
+        self->ImageAccessedByScript = true;
 
         if ( self->LastImage->Data( ) != image->data )
         {
@@ -1837,6 +2772,42 @@ XErrorCode VideoSourceData::ScriptingEnginePluginCallback_SetImage( void* userPa
     return ret;
 }
 
+// Callback to get histograms of the current image - shared with other processing steps, unless the script has got
+// access to the image, which it could change since then
+XErrorCode VideoSourceData::ScriptingEnginePluginCallback_GetImageHistograms( void* userParam, xhistogram* histograms, int32_t* count )
+{
+    VideoSourceData* self = static_cast<VideoSourceData*>( userParam );
+    XErrorCode       ret  = ErrorFailed;
+
+    if ( ( histograms == nullptr ) || ( count == nullptr ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( self->LastImage )
+    {
+        const xhistogram* imageHistograms[3];
+
+        if ( self->ImageAccessedByScript )
+        {
+            self->StatisticsCache.Invalidate( );
+        }
+
+        ret = self->StatisticsCache.GetHistograms( self->LastImage, imageHistograms );
+
+        if ( ret == SuccessCode )
+        {
+            *count = ( imageHistograms[1] == nullptr ) ? 1 : 3;
+
+            for ( int32_t i = 0; ( i < *count ) && ( ret == SuccessCode ); i++ )
+            {
+                ret = XHistogramCopy( imageHistograms[i], &histograms[i] );
+            }
+        }
+    }
+
+    return ret;
+}
+
 // Callback to get video source associated with the running script
 XErrorCode VideoSourceData::ScriptingEnginePluginCallback_GetVideoSource( void* userParam, PluginDescriptor** pDescriptor, void** pPlugin )
 {
@@ -1915,6 +2886,18 @@ XErrorCode ScriptingThreadData::ScriptingEnginePluginCallback_SetImageVariable(
     return static_cast<ScriptingThreadData*>( userParam )->Server->ScriptingEnginePluginCallback_SetImageVariable( name, value );
 }
 
+// Callback to get image variable from the host side without copying it
+XErrorCode ScriptingThreadData::ScriptingEnginePluginCallback_GetSharedImageVariable( void* userParam, xstring name, const ximage** value, void** handle )
+{
+    return static_cast<ScriptingThreadData*>( userParam )->Server->ScriptingEnginePluginCallback_GetSharedImageVariable( name, value, handle );
+}
+
+// Callback to release image variable previously provided without copying
+void ScriptingThreadData::ScriptingEnginePluginCallback_ReleaseSharedImageVariable( void* userParam, void* handle )
+{
+    static_cast<ScriptingThreadData*>( userParam )->Server->ScriptingEnginePluginCallback_ReleaseSharedImageVariable( handle );
+}
+
 // Callback to get current image available on the host side
 XErrorCode ScriptingThreadData::ScriptingEnginePluginCallback_GetImage( void* userParam, ximage** image )
 {
@@ -1940,6 +2923,15 @@ XErrorCode ScriptingThreadData::ScriptingEnginePluginCallback_GetVideoSource( vo
     return ErrorNotImplemented;
 }
 
+// Callback to get histograms of the current image - not supported for threads, since they don't have image
+XErrorCode ScriptingThreadData::ScriptingEnginePluginCallback_GetImageHistograms( void* userParam, xhistogram* histograms, int32_t* count )
+{
+    XUNREFERENCED_PARAMETER( userParam )
+    XUNREFERENCED_PARAMETER( histograms )
+    XUNREFERENCED_PARAMETER( count )
+    return ErrorNotImplemented;
+}
+
 // =========================================================================
 
 // Handler of script processing thread
@@ -1948,19 +2940,25 @@ void ScriptingThreadData::ScriptProcessingThreadHandler( void* param )
     ScriptingThreadData* self = static_cast<ScriptingThreadData*>( param );
     uint32_t             scriptInterval = self->MsecInterval;
 
+    // scripting threads have no listeners to report to, so they just run with default scheduling if it fails
+    ApplyThreadOptions( XAutomationThreadRole::Scripting, self->ThreadOptions );
+
     ScriptingEnginePluginCallbacks     callbacks;
 
-    callbacks.GetHostName          = ScriptingEnginePluginCallback_GetHostName;
-    callbacks.GetHostVersion       = ScriptingEnginePluginCallback_GetHostVersion;
-    callbacks.PrintString          = ScriptingEnginePluginCallback_PrintString;
-    callbacks.CreatePluginInstance = ScriptingEnginePluginCallback_CreatePluginInstance;
-    callbacks.GetImage             = ScriptingEnginePluginCallback_GetImage;
-    callbacks.SetImage             = ScriptingEnginePluginCallback_SetImage;
-    callbacks.GetVariable          = ScriptingEnginePluginCallback_GetVariable;
-    callbacks.SetVariable          = ScriptingEnginePluginCallback_SetVariable;
-    callbacks.GetImageVariable     = ScriptingEnginePluginCallback_GetImageVariable;
-    callbacks.SetImageVariable     = ScriptingEnginePluginCallback_SetImageVariable;
-    callbacks.GetVideoSource       = ScriptingEnginePluginCallback_GetVideoSource;
+    callbacks.GetHostName                = ScriptingEnginePluginCallback_GetHostName;
+    callbacks.GetHostVersion             = ScriptingEnginePluginCallback_GetHostVersion;
+    callbacks.PrintString                = ScriptingEnginePluginCallback_PrintString;
+    callbacks.CreatePluginInstance       = ScriptingEnginePluginCallback_CreatePluginInstance;
+    callbacks.GetImage                   = ScriptingEnginePluginCallback_GetImage;
+    callbacks.SetImage                   = ScriptingEnginePluginCallback_SetImage;
+    callbacks.GetVariable                = ScriptingEnginePluginCallback_GetVariable;
+    callbacks.SetVariable                = ScriptingEnginePluginCallback_SetVariable;
+    callbacks.GetImageVariable           = ScriptingEnginePluginCallback_GetImageVariable;
+    callbacks.SetImageVariable           = ScriptingEnginePluginCallback_SetImageVariable;
+    callbacks.GetVideoSource             = ScriptingEnginePluginCallback_GetVideoSource;
+    callbacks.GetImageHistograms         = ScriptingEnginePluginCallback_GetImageHistograms;
+    callbacks.GetSharedImageVariable     = ScriptingEnginePluginCallback_GetSharedImageVariable;
+    callbacks.ReleaseSharedImageVariable = ScriptingEnginePluginCallback_ReleaseSharedImageVariable;
 
     // set callback first to allow script interface with the host
     self->ScriptingEngine->SetCallbacks( &callbacks, self );
@@ -33,11 +33,14 @@
 
 #include "IAutomationVideoSourceListener.hpp"
 #include "IAutomationVariablesListener.hpp"
+#include "XLatencyHistogram.hpp"
+#include "XAutomationThreadOptions.hpp"
 
 namespace CVSandbox { namespace Automation
 {
 
 class XVideoSourceProcessingGraph;
+class XVideoFrameMailbox;
 struct XVideoSourceFrameInfo;
 
 namespace Private
@@ -71,6 +74,10 @@ public:
     // Add video source (not starting it) into the server - returns its ID
     uint32_t AddVideoSource( const std::shared_ptr<const XPluginDescriptor>& descriptor,
                              const std::shared_ptr<XVideoSourcePlugin>& videoSource );
+    // Set default options of threads of the specified role - applied to video sources and scripting threads added afterwards
+    void SetThreadOptions( XAutomationThreadRole role, const XAutomationThreadOptions& options );
+    // Set options of video source's or video processing thread for the specified video source, which is not started yet
+    bool SetVideoSourceThreadOptions( uint32_t videoSourceId, XAutomationThreadRole role, const XAutomationThreadOptions& options );
     // Set video processing graph for the specified video source
     bool SetVideoProcessingGraph( uint32_t videoSourceId, const XVideoSourceProcessingGraph& graph );
 
@@ -91,6 +98,17 @@ public:
     bool EnableVideoFrameDropping( uint32_t videoSourceId, bool enable );
     // Get average time (ms) taken by the steps of video processing graph
     std::vector<float> GetVideoProcessingGraphTiming( uint32_t videoSourceId, float* totalTime = nullptr );
+    // Get latency statistics of video processing graph's steps, complete graph and waiting of new frames for processing
+    // (collected since performance monitor was enabled)
+    bool GetVideoProcessingGraphLatency( uint32_t videoSourceId, std::vector<XLatencyStatistics>& stepsLatency,
+                                         XLatencyStatistics* graphLatency = nullptr, XLatencyStatistics* queueWaitLatency = nullptr );
+    // Reset latency statistics collected for the specified video source
+    bool ResetVideoProcessingGraphLatency( uint32_t videoSourceId );
+    // Start/stop recording trace of video processing done for all video sources
+    void StartVideoProcessingTrace( uint32_t maxEventsCount = 1000000 );
+    void StopVideoProcessingTrace( );
+    // Save recorded video processing trace into a JSON file in Chrome's trace event format
+    XErrorCode SaveVideoProcessingTrace( const std::string& fileName );
     // Start all video sources
     void StartAllVideoSources( );
     // Move the specified video source into finalization queue
@@ -100,6 +118,10 @@ public:
     bool AddVideoSourceListener( uint32_t videoSourceId, IAutomationVideoSourceListener* listener, bool notifyWithRecent = true );
     // Remove listener from the specified video source
     void RemoveVideoSourceListener( uint32_t videoSourceId, IAutomationVideoSourceListener* listener );
+    // Get mailbox providing the latest video frame of the specified video source. Unlike listeners, the mailbox
+    // never blocks video processing - frames are put into it while anyone holds it; release it to unsubscribe.
+    // Mailbox of a running video source is provided with its most recent frame.
+    std::shared_ptr<const XVideoFrameMailbox> GetVideoFrameMailbox( uint32_t videoSourceId );
 
     // Add a thread, which will run the specified script at the specified time intervals (milliseconds)
     uint32_t AddThread( const std::shared_ptr<XScriptingEnginePlugin>& scriptToRun, uint32_t msecInterval );
@@ -116,6 +138,11 @@ public:
     // Set host variable into common storage
     XErrorCode SetVariable( const std::string& name, const CVSandbox::XVariant& value );
 
+    // Get image variable from common storage - provides the stored image itself, which must not be changed
+    XErrorCode GetImageVariable( const std::string& name, std::shared_ptr<const XImage>& image );
+    // Set image variable into common storage - the image is shared (not copied), so must not be changed afterwards
+    XErrorCode SetImageVariable( const std::string& name, const std::shared_ptr<const XImage>& image );
+
     // Set listener to monitor for variables changes
     void SetVariablesListener( IAutomationVariablesListener* listener, bool notifyExistingVariables = false );
     // Clear variables listener, so no more change notifications are sent
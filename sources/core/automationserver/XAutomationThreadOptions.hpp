@@ -0,0 +1,61 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XAUTOMATION_THREAD_OPTIONS_HPP
+#define CVS_XAUTOMATION_THREAD_OPTIONS_HPP
+
+#include <stdint.h>
+#include <XThread.hpp>
+
+namespace CVSandbox { namespace Automation
+{
+
+// Roles of threads automation server runs or gets notifications from
+enum class XAutomationThreadRole
+{
+    VideoSource = 0,    // video source's thread providing new frames
+    VideoProcessing,    // thread running video processing graph of a video source
+    Scripting,          // thread running script at certain time intervals
+
+    Count
+};
+
+// Options of threads running in automation server
+struct XAutomationThreadOptions
+{
+    CVSandbox::Threading::XThreadSchedulingOptions Scheduling;
+
+    // Number of threads image processing routines can use when called from the thread (0 - one per CPU)
+    uint32_t ImagingThreadsCount;
+
+    XAutomationThreadOptions( ) : Scheduling( ), ImagingThreadsCount( 0 ) { }
+
+    // Check if the options don't change anything
+    bool IsDefault( ) const
+    {
+        return ( ( Scheduling.IsDefault( ) ) && ( ImagingThreadsCount == 0 ) );
+    }
+};
+
+} } // namespace CVSandbox::Automation
+
+#endif // CVS_XAUTOMATION_THREAD_OPTIONS_HPP
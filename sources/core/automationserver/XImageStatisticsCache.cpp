@@ -0,0 +1,90 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <ximaging.h>
+#include "XImageStatisticsCache.hpp"
+
+using namespace std;
+
+namespace CVSandbox { namespace Automation
+{
+
+XImageStatisticsCache::XImageStatisticsCache( ) :
+    mIsValid( false ), mImage( nullptr )
+{
+    for ( int i = 0; i < 3; i++ )
+    {
+        mHistograms[i]        = xhistogram( );
+        mHistograms[i].values = mValues[i];
+        mHistograms[i].length = 256;
+    }
+}
+
+// Mark cached histograms as outdated
+void XImageStatisticsCache::Invalidate( )
+{
+    mIsValid = false;
+    mImage   = nullptr;
+}
+
+// Get histograms of 8 bpp grayscale or 24/32 bpp color image, calculating them only if not done yet
+XErrorCode XImageStatisticsCache::GetHistograms( const shared_ptr<const XImage>& image, const xhistogram** histograms )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( !image ) || ( histograms == nullptr ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( !IsFormatSupported( image->Format( ) ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        // the image could be re-allocated without the cache being invalidated, so make sure it is the same one
+        if ( ( !mIsValid ) || ( mImage != image->ImageData( ) ) )
+        {
+            ret      = GetImageHistograms( image->ImageData( ), mHistograms );
+            mIsValid = ( ret == SuccessCode );
+            mImage   = ( mIsValid ) ? image->ImageData( ) : nullptr;
+        }
+
+        if ( ret == SuccessCode )
+        {
+            bool isGrayscale = ( image->Format( ) == XPixelFormatGrayscale8 );
+
+            histograms[0] = &mHistograms[0];
+            histograms[1] = ( isGrayscale ) ? nullptr : &mHistograms[1];
+            histograms[2] = ( isGrayscale ) ? nullptr : &mHistograms[2];
+        }
+    }
+
+    return ret;
+}
+
+// Check if the cache can provide histograms for the pixel format
+bool XImageStatisticsCache::IsFormatSupported( XPixelFormat format )
+{
+    return ( ( format == XPixelFormatGrayscale8 ) || ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) );
+}
+
+} } // namespace CVSandbox::Automation
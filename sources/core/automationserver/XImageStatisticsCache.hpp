@@ -0,0 +1,63 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XIMAGE_STATISTICS_CACHE_HPP
+#define CVS_XIMAGE_STATISTICS_CACHE_HPP
+
+#include <stdint.h>
+#include <memory>
+#include <xhistogram.h>
+#include <XImage.hpp>
+#include <XInterfaces.hpp>
+
+namespace CVSandbox { namespace Automation
+{
+
+// Histograms of the video frame currently being processed. Calculated on the first request and then
+// shared by all processing steps (and scripts) needing them, until the frame gets modified and the
+// cache is invalidated.
+class XImageStatisticsCache : private Uncopyable
+{
+public:
+    XImageStatisticsCache( );
+
+    // Mark cached histograms as outdated - must be called when the image is changed or replaced
+    void Invalidate( );
+    // Check if histograms of the current image are already available
+    bool IsValid( ) const { return mIsValid; }
+
+    // Get histograms of 8 bpp grayscale (only the first one is set) or 24/32 bpp color image (red, green and blue)
+    XErrorCode GetHistograms( const std::shared_ptr<const CVSandbox::XImage>& image, const xhistogram** histograms );
+
+    // Check if the cache can provide histograms for the pixel format
+    static bool IsFormatSupported( XPixelFormat format );
+
+private:
+    bool            mIsValid;
+    const ximage*   mImage;
+    uint32_t        mValues[3][256];
+    xhistogram      mHistograms[3];
+};
+
+} } // namespace CVSandbox::Automation
+
+#endif // CVS_XIMAGE_STATISTICS_CACHE_HPP
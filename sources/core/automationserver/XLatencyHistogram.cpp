@@ -0,0 +1,159 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XLatencyHistogram.hpp"
+
+using namespace std;
+
+namespace CVSandbox { namespace Automation
+{
+
+// Number of bits used for linear sub-buckets within each power of two range
+#define SUB_BUCKET_BITS  (4)
+#define SUB_BUCKET_COUNT (1 << SUB_BUCKET_BITS)
+// Total number of buckets to cover full range of 32 bit values
+#define BUCKETS_COUNT    ( SUB_BUCKET_COUNT + ( 32 - SUB_BUCKET_BITS ) * SUB_BUCKET_COUNT )
+
+XLatencyHistogram::XLatencyHistogram( ) :
+    mBuckets( BUCKETS_COUNT ), mCount( 0 ), mSum( 0 ), mMax( 0 )
+{
+}
+
+// Clear all collected values
+void XLatencyHistogram::Reset( )
+{
+    mBuckets.assign( BUCKETS_COUNT, 0 );
+    mCount = 0;
+    mSum   = 0;
+    mMax   = 0;
+}
+
+// Add new latency value (microseconds)
+void XLatencyHistogram::Add( uint32_t microseconds )
+{
+    mBuckets[BucketIndex( microseconds )]++;
+    mCount++;
+    mSum += microseconds;
+
+    if ( microseconds > mMax )
+    {
+        mMax = microseconds;
+    }
+}
+
+// Get value (milliseconds) below which the specified percent of values fall
+float XLatencyHistogram::Percentile( float percent ) const
+{
+    uint32_t value = 0;
+
+    if ( mCount != 0 )
+    {
+        // number of values, which must be at or below the percentile
+        uint64_t countToReach = static_cast<uint64_t>( static_cast<double>( percent ) / 100.0 * mCount + 0.5 );
+        uint64_t countSoFar   = 0;
+        uint32_t index        = 0;
+
+        if ( countToReach == 0 )
+        {
+            countToReach = 1;
+        }
+
+        for ( ; index < BUCKETS_COUNT; index++ )
+        {
+            countSoFar += mBuckets[index];
+
+            if ( countSoFar >= countToReach )
+            {
+                break;
+            }
+        }
+
+        // report the highest value of the bucket, but never above the maximum seen
+        value = ( index < BUCKETS_COUNT ) ? BucketHighestValue( index ) : mMax;
+
+        if ( value > mMax )
+        {
+            value = mMax;
+        }
+    }
+
+    return static_cast<float>( value ) / 1000.0f;
+}
+
+// Get summary of the collected latencies
+XLatencyStatistics XLatencyHistogram::Statistics( ) const
+{
+    XLatencyStatistics stats;
+
+    if ( mCount != 0 )
+    {
+        stats.Count        = mCount;
+        stats.Average      = static_cast<float>( static_cast<double>( mSum ) / mCount / 1000.0 );
+        stats.Median       = Percentile( 50.0f );
+        stats.Percentile95 = Percentile( 95.0f );
+        stats.Percentile99 = Percentile( 99.0f );
+        stats.Max          = static_cast<float>( mMax ) / 1000.0f;
+    }
+
+    return stats;
+}
+
+// Get index of the bucket to keep the specified value
+uint32_t XLatencyHistogram::BucketIndex( uint32_t value )
+{
+    uint32_t ret = value;
+
+    if ( value >= SUB_BUCKET_COUNT )
+    {
+        uint32_t highestBit = SUB_BUCKET_BITS;
+
+        while ( ( highestBit < 31 ) && ( ( value >> ( highestBit + 1 ) ) != 0 ) )
+        {
+            highestBit++;
+        }
+
+        // bits below the highest one select linear sub-bucket
+        uint32_t shift = highestBit - SUB_BUCKET_BITS;
+
+        ret = SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + ( ( value >> shift ) & ( SUB_BUCKET_COUNT - 1 ) );
+    }
+
+    return ret;
+}
+
+// Get the highest value which goes into the specified bucket
+uint32_t XLatencyHistogram::BucketHighestValue( uint32_t index )
+{
+    uint32_t ret = index;
+
+    if ( index >= SUB_BUCKET_COUNT )
+    {
+        uint32_t shift     = ( index - SUB_BUCKET_COUNT ) / SUB_BUCKET_COUNT;
+        uint32_t subBucket = ( index - SUB_BUCKET_COUNT ) % SUB_BUCKET_COUNT;
+        uint64_t lowest    = static_cast<uint64_t>( SUB_BUCKET_COUNT + subBucket ) << shift;
+
+        ret = static_cast<uint32_t>( lowest + ( static_cast<uint64_t>( 1 ) << shift ) - 1 );
+    }
+
+    return ret;
+}
+
+} } // namespace CVSandbox::Automation
@@ -0,0 +1,81 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XLATENCY_HISTOGRAM_HPP
+#define CVS_XLATENCY_HISTOGRAM_HPP
+
+#include <stdint.h>
+#include <vector>
+
+namespace CVSandbox { namespace Automation
+{
+
+// Latency statistics collected by histogram (all times are in milliseconds)
+struct XLatencyStatistics
+{
+    uint32_t Count;
+    float    Average;
+    float    Median;
+    float    Percentile95;
+    float    Percentile99;
+    float    Max;
+
+    XLatencyStatistics( ) :
+        Count( 0 ), Average( 0.0f ), Median( 0.0f ), Percentile95( 0.0f ), Percentile99( 0.0f ), Max( 0.0f )
+    {
+    }
+};
+
+// Histogram of latencies measured in microseconds. Buckets grow exponentially with 16 linear sub-buckets
+// for each power of two, so percentiles are reported with at most 1/16 relative error, while memory is
+// fixed no matter how many values are added or how large they are.
+class XLatencyHistogram
+{
+public:
+    XLatencyHistogram( );
+
+    // Clear all collected values
+    void Reset( );
+    // Add new latency value (microseconds)
+    void Add( uint32_t microseconds );
+
+    // Get number of values added to the histogram
+    uint32_t Count( ) const { return mCount; }
+    // Get value (milliseconds) below which the specified percent of values fall
+    float Percentile( float percent ) const;
+    // Get summary of the collected latencies
+    XLatencyStatistics Statistics( ) const;
+
+private:
+    static uint32_t BucketIndex( uint32_t value );
+    static uint32_t BucketHighestValue( uint32_t index );
+
+private:
+    std::vector<uint32_t> mBuckets;
+    uint32_t              mCount;
+    uint64_t              mSum;
+    uint32_t              mMax;
+};
+
+} } // namespace CVSandbox::Automation
+
+#endif // CVS_XLATENCY_HISTOGRAM_HPP
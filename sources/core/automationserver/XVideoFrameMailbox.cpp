@@ -0,0 +1,78 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "XVideoFrameMailbox.hpp"
+
+using namespace std;
+
+namespace CVSandbox { namespace Automation
+{
+
+XVideoFrameMailbox::XVideoFrameMailbox( ) :
+    mFrame( ), mFrameNumber( 0 )
+{
+}
+
+// Get the latest video frame (or empty pointer if nothing was received yet)
+shared_ptr<const XImage> XVideoFrameMailbox::GetLatestFrame( ) const
+{
+    return atomic_load( &mFrame );
+}
+
+// Get the latest video frame if it is newer than the one seen last time - updates frame number on success
+bool XVideoFrameMailbox::GetLatestFrame( uint32_t* lastFrameNumber, shared_ptr<const XImage>& frame ) const
+{
+    // frame number is read first, so in the worst case a newer frame is returned with older
+    // number and then provided once again on the next call - but never an older frame twice
+    uint32_t frameNumber = mFrameNumber.load( memory_order_acquire );
+    bool     ret         = false;
+
+    if ( ( lastFrameNumber != nullptr ) && ( frameNumber != *lastFrameNumber ) )
+    {
+        frame = atomic_load( &mFrame );
+
+        if ( frame )
+        {
+            *lastFrameNumber = frameNumber;
+            ret = true;
+        }
+    }
+
+    return ret;
+}
+
+// Get number of the latest frame (number of frames put into the mailbox)
+uint32_t XVideoFrameMailbox::LatestFrameNumber( ) const
+{
+    return mFrameNumber.load( memory_order_acquire );
+}
+
+// Put new frame into the mailbox - returns the frame it replaced, so its image could be recycled
+shared_ptr<const XImage> XVideoFrameMailbox::PutFrame( const shared_ptr<const XImage>& frame )
+{
+    shared_ptr<const XImage> ret = atomic_exchange( &mFrame, frame );
+
+    mFrameNumber.fetch_add( 1, memory_order_release );
+
+    return ret;
+}
+
+} } // namespace CVSandbox::Automation
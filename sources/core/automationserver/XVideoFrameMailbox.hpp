@@ -0,0 +1,62 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XVIDEO_FRAME_MAILBOX_HPP
+#define CVS_XVIDEO_FRAME_MAILBOX_HPP
+
+#include <memory>
+#include <atomic>
+#include <XInterfaces.hpp>
+#include <XImage.hpp>
+
+namespace CVSandbox { namespace Automation
+{
+
+// Single slot mailbox keeping the latest video frame of a video source running in automation server.
+// Processing thread puts new frames into it without waiting for consumers, while those pull
+// the most recent frame at their own pace. Frames put into mailbox are never modified afterwards.
+// NOTE: the slot is accessed with atomic_load()/atomic_exchange() for shared_ptr, which standard
+// libraries implement with a (global) pool of mutexes - so the mailbox is lock-based, although only
+// pointer swap and reference count update are done while the lock is held, never a frame copy.
+class XVideoFrameMailbox : private CVSandbox::Uncopyable
+{
+public:
+    XVideoFrameMailbox( );
+
+    // Get the latest video frame (or empty pointer if nothing was received yet)
+    std::shared_ptr<const XImage> GetLatestFrame( ) const;
+    // Get the latest video frame if it is newer than the one seen last time - updates frame number on success
+    bool GetLatestFrame( uint32_t* lastFrameNumber, std::shared_ptr<const XImage>& frame ) const;
+    // Get number of the latest frame (number of frames put into the mailbox)
+    uint32_t LatestFrameNumber( ) const;
+
+    // Put new frame into the mailbox - returns the frame it replaced, so its image could be recycled
+    std::shared_ptr<const XImage> PutFrame( const std::shared_ptr<const XImage>& frame );
+
+private:
+    std::shared_ptr<const XImage> mFrame;
+    std::atomic<uint32_t>         mFrameNumber;
+};
+
+} } // namespace CVSandbox::Automation
+
+#endif // CVS_XVIDEO_FRAME_MAILBOX_HPP
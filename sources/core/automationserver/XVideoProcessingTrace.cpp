@@ -0,0 +1,193 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include "XVideoProcessingTrace.hpp"
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox::Threading;
+
+namespace CVSandbox { namespace Automation
+{
+
+// Escape string to be put into JSON
+static string JsonEscape( const string& str )
+{
+    string ret;
+
+    ret.reserve( str.length( ) );
+
+    for ( char c : str )
+    {
+        if ( ( c == '"' ) || ( c == '\\' ) )
+        {
+            ret.push_back( '\\' );
+            ret.push_back( c );
+        }
+        else if ( static_cast<unsigned char>( c ) < 0x20 )
+        {
+            char buffer[8];
+
+            sprintf( buffer, "\\u%04X", static_cast<unsigned int>( c ) );
+            ret.append( buffer );
+        }
+        else
+        {
+            ret.push_back( c );
+        }
+    }
+
+    return ret;
+}
+
+XVideoProcessingTrace::XVideoProcessingTrace( ) :
+    mSync( ), mIsRunning( false ), mMaxEventsCount( 0 ), mEventsDropped( 0 ),
+    mStartTime( ), mEvents( ), mVideoSourceNames( )
+{
+}
+
+// Start recording new trace (previous events are discarded)
+void XVideoProcessingTrace::Start( uint32_t maxEventsCount )
+{
+    XScopedLock lock( &mSync );
+
+    mEvents.clear( );
+    mVideoSourceNames.clear( );
+
+    mMaxEventsCount = maxEventsCount;
+    mEventsDropped  = 0;
+    mStartTime      = steady_clock::now( );
+    mIsRunning      = true;
+}
+
+// Stop recording (recorded events are kept)
+void XVideoProcessingTrace::Stop( )
+{
+    XScopedLock lock( &mSync );
+
+    mIsRunning = false;
+}
+
+// Add events of a video source
+void XVideoProcessingTrace::AddEvents( uint32_t videoSourceId, const string& videoSourceName, const vector<XVideoProcessingTraceEvent>& events )
+{
+    XScopedLock lock( &mSync );
+
+    if ( mIsRunning )
+    {
+        if ( mVideoSourceNames.find( videoSourceId ) == mVideoSourceNames.end( ) )
+        {
+            mVideoSourceNames.insert( pair<uint32_t, string>( videoSourceId, videoSourceName ) );
+        }
+
+        for ( const XVideoProcessingTraceEvent& event : events )
+        {
+            // skip anything which happened before the trace was started
+            if ( event.StartTime < mStartTime )
+            {
+                continue;
+            }
+
+            if ( mEvents.size( ) >= mMaxEventsCount )
+            {
+                mEventsDropped++;
+            }
+            else
+            {
+                TraceEvent traceEvent;
+
+                traceEvent.Name          = event.Name;
+                traceEvent.VideoSourceId = videoSourceId;
+                traceEvent.FrameNumber   = event.FrameNumber;
+                traceEvent.StartTime     = duration_cast<microseconds>( event.StartTime - mStartTime ).count( );
+                traceEvent.Duration      = duration_cast<microseconds>( event.EndTime - event.StartTime ).count( );
+
+                mEvents.push_back( traceEvent );
+            }
+        }
+    }
+}
+
+// Get recorded trace in JSON format
+string XVideoProcessingTrace::ToJson( )
+{
+    XScopedLock lock( &mSync );
+    string      json;
+    char        buffer[128];
+    bool        first = true;
+
+    json.reserve( mEvents.size( ) * 128 + 256 );
+    json.append( "{\"traceEvents\":[" );
+
+    // name every video source's track
+    for ( const auto& kvp : mVideoSourceNames )
+    {
+        sprintf( buffer, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", ( first ) ? "" : ",", kvp.first );
+        json.append( buffer );
+        json.append( JsonEscape( kvp.second ) );
+        json.append( "\"}}" );
+        first = false;
+    }
+
+    for ( const TraceEvent& event : mEvents )
+    {
+        sprintf( buffer, "%s\n{\"name\":\"", ( first ) ? "" : "," );
+        json.append( buffer );
+        json.append( JsonEscape( event.Name ) );
+        sprintf( buffer, "\",\"cat\":\"video\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld,\"args\":{\"frame\":%u}}",
+                 event.VideoSourceId, static_cast<long long>( event.StartTime ), static_cast<long long>( event.Duration ), event.FrameNumber );
+        json.append( buffer );
+        first = false;
+    }
+
+    sprintf( buffer, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"eventsDropped\":%u}}\n", mEventsDropped );
+    json.append( buffer );
+
+    return json;
+}
+
+// Save recorded trace into the specified file
+XErrorCode XVideoProcessingTrace::Save( const string& fileName )
+{
+    XErrorCode ret  = SuccessCode;
+    FILE*      file = fopen( fileName.c_str( ), "wb" );
+
+    if ( file == nullptr )
+    {
+        ret = ErrorIOFailure;
+    }
+    else
+    {
+        string json = ToJson( );
+
+        if ( fwrite( json.c_str( ), 1, json.length( ), file ) != json.length( ) )
+        {
+            ret = ErrorIOFailure;
+        }
+
+        fclose( file );
+    }
+
+    return ret;
+}
+
+} } // namespace CVSandbox::Automation
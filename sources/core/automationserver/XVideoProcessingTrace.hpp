@@ -0,0 +1,92 @@
+/*
+    Automation server library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XVIDEO_PROCESSING_TRACE_HPP
+#define CVS_XVIDEO_PROCESSING_TRACE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <XInterfaces.hpp>
+#include <XMutex.hpp>
+#include <XError.hpp>
+
+namespace CVSandbox { namespace Automation
+{
+
+// Span of time spent by video source on processing a frame (or waiting for it)
+struct XVideoProcessingTraceEvent
+{
+    std::string                           Name;
+    uint32_t                              FrameNumber;
+    std::chrono::steady_clock::time_point StartTime;
+    std::chrono::steady_clock::time_point EndTime;
+};
+
+// Recorder of video processing spans for all video sources, which can be saved in Chrome's trace
+// event format (JSON) to be opened with chrome://tracing or similar trace viewers
+class XVideoProcessingTrace : private CVSandbox::Uncopyable
+{
+public:
+    XVideoProcessingTrace( );
+
+    // Start recording new trace (previous events are discarded)
+    void Start( uint32_t maxEventsCount );
+    // Stop recording (recorded events are kept)
+    void Stop( );
+    // Check if recording is active
+    bool IsRunning( ) const { return mIsRunning; }
+
+    // Add events of a video source
+    void AddEvents( uint32_t videoSourceId, const std::string& videoSourceName, const std::vector<XVideoProcessingTraceEvent>& events );
+
+    // Get recorded trace in JSON format
+    std::string ToJson( );
+    // Save recorded trace into the specified file
+    XErrorCode Save( const std::string& fileName );
+
+private:
+    // Event as it is kept by the recorder
+    struct TraceEvent
+    {
+        std::string Name;
+        uint32_t    VideoSourceId;
+        uint32_t    FrameNumber;
+        int64_t     StartTime;
+        int64_t     Duration;
+    };
+
+private:
+    CVSandbox::Threading::XMutex          mSync;
+    volatile bool                         mIsRunning;
+    uint32_t                              mMaxEventsCount;
+    uint32_t                              mEventsDropped;
+    std::chrono::steady_clock::time_point mStartTime;
+    std::vector<TraceEvent>               mEvents;
+    std::map<uint32_t, std::string>       mVideoSourceNames;
+};
+
+} } // namespace CVSandbox::Automation
+
+#endif // CVS_XVIDEO_PROCESSING_TRACE_HPP
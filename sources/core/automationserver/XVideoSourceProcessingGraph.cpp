@@ -28,7 +28,7 @@ namespace CVSandbox { namespace Automation
 {
 
 XVideoSourceProcessingGraph::XVideoSourceProcessingGraph( ) :
-    mProcessingSteps( )
+    mProcessingSteps( ), mFrameTimeBudget( 0 )
 {
 
 }
@@ -36,7 +36,7 @@ XVideoSourceProcessingGraph::XVideoSourceProcessingGraph( ) :
 // Check if two processing graphs are equal
 bool XVideoSourceProcessingGraph::operator==( const XVideoSourceProcessingGraph& rhs ) const
 {
-    return ( mProcessingSteps == rhs.mProcessingSteps );
+    return ( ( mProcessingSteps == rhs.mProcessingSteps ) && ( mFrameTimeBudget == rhs.mFrameTimeBudget ) );
 }
 
 // Get steps count
@@ -103,4 +103,14 @@ void XVideoSourceProcessingGraph::SetStep( int32_t stepIndex, const XVideoSource
     }
 }
 
+// Get/Set time budget for processing a frame
+uint32_t XVideoSourceProcessingGraph::FrameTimeBudget( ) const
+{
+    return mFrameTimeBudget;
+}
+void XVideoSourceProcessingGraph::SetFrameTimeBudget( uint32_t budget )
+{
+    mFrameTimeBudget = budget;
+}
+
 } } // namespace CVSandbox::Automation
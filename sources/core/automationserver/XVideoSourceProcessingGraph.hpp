@@ -61,6 +61,11 @@ public:
     const XVideoSourceProcessingStep GetStep( int32_t stepIndex ) const;
     void SetStep( int32_t stepIndex, const XVideoSourceProcessingStep& processingStep );
 
+    // Get/Set time budget (milliseconds) for processing a frame, counted from its arrival - steps allowing it are
+    // skipped once the budget is exhausted; 0 means no budget
+    uint32_t FrameTimeBudget( ) const;
+    void SetFrameTimeBudget( uint32_t budget );
+
     // Enumeration API
     typedef std::vector<XVideoSourceProcessingStep>::const_iterator ConstIterator;
     typedef std::vector<XVideoSourceProcessingStep>::iterator Iterator;
@@ -71,6 +76,7 @@ public:
 
 private:
     std::vector<XVideoSourceProcessingStep> mProcessingSteps;
+    uint32_t                                mFrameTimeBudget;
 };
 
 } } // namespace CVSandbox::Automation
@@ -28,7 +28,8 @@ namespace CVSandbox { namespace Automation
 {
 
 XVideoSourceProcessingStep::XVideoSourceProcessingStep( const string& name, const XGuid& pluginId ) :
-    mName( name ), mPluginId( pluginId )
+    mName( name ), mPluginId( pluginId ), mRegion( { 0, 0, -1, -1 } ),
+    mFrameInterval( 1 ), mMaxRate( 0.0f ), mSkipWhenOverBudget( false )
 {
 }
 
@@ -41,7 +42,11 @@ bool XVideoSourceProcessingStep::IsValid( ) const
 // Check if two processing steps are equal
 bool XVideoSourceProcessingStep::operator==( const XVideoSourceProcessingStep& rhs ) const
 {
-    return ( ( mName == rhs.mName ) && ( mPluginId == rhs.mPluginId ) && ( mPluginConfiguration == rhs.mPluginConfiguration ) );
+    return ( ( mName == rhs.mName ) && ( mPluginId == rhs.mPluginId ) && ( mPluginConfiguration == rhs.mPluginConfiguration ) &&
+             ( mRegion.x1 == rhs.mRegion.x1 ) && ( mRegion.y1 == rhs.mRegion.y1 ) &&
+             ( mRegion.x2 == rhs.mRegion.x2 ) && ( mRegion.y2 == rhs.mRegion.y2 ) &&
+             ( mFrameInterval == rhs.mFrameInterval ) && ( mMaxRate == rhs.mMaxRate ) &&
+             ( mSkipWhenOverBudget == rhs.mSkipWhenOverBudget ) );
 }
 
 // Get/Set the name of the video processing step
@@ -70,6 +75,52 @@ void XVideoSourceProcessingStep::SetPluginConfiguration( const map<string, XVari
     mPluginConfiguration = configuration;
 }
 
+// Get/Set region of interest processed by the step
+const xrect& XVideoSourceProcessingStep::Region( ) const
+{
+    return mRegion;
+}
+void XVideoSourceProcessingStep::SetRegion( const xrect& region )
+{
+    mRegion = region;
+}
+
+// Check if the step has region of interest set
+bool XVideoSourceProcessingStep::HasRegion( ) const
+{
+    return ( ( mRegion.x2 >= mRegion.x1 ) && ( mRegion.y2 >= mRegion.y1 ) );
+}
+
+// Get/Set interval of frames the step runs for
+uint32_t XVideoSourceProcessingStep::FrameInterval( ) const
+{
+    return mFrameInterval;
+}
+void XVideoSourceProcessingStep::SetFrameInterval( uint32_t interval )
+{
+    mFrameInterval = ( interval == 0 ) ? 1 : interval;
+}
+
+// Get/Set maximum rate of running the step
+float XVideoSourceProcessingStep::MaxRate( ) const
+{
+    return mMaxRate;
+}
+void XVideoSourceProcessingStep::SetMaxRate( float rate )
+{
+    mMaxRate = ( rate < 0.0f ) ? 0.0f : rate;
+}
+
+// Get/Set if the step is skipped when time budget of the graph is exhausted
+bool XVideoSourceProcessingStep::SkipWhenOverBudget( ) const
+{
+    return mSkipWhenOverBudget;
+}
+void XVideoSourceProcessingStep::SetSkipWhenOverBudget( bool skip )
+{
+    mSkipWhenOverBudget = skip;
+}
+
 // Create plug-in's instance for the video processing step
 bool XVideoSourceProcessingStep::CreatePluginInstance( const std::shared_ptr<const XPluginsEngine>& pluginsEngine )
 {
@@ -67,6 +67,23 @@ public:
     const std::map<std::string, CVSandbox::XVariant>& PluginConfiguration( ) const;
     void SetPluginConfiguration( const std::map<std::string, CVSandbox::XVariant>& configuration );
 
+    // Get/Set region of interest (inclusive coordinates) processed by image processing filter or detection step.
+    // Empty region (default) means entire video frame, while a region going out of frame is clipped to it.
+    const xrect& Region( ) const;
+    void SetRegion( const xrect& region );
+    // Check if the step has region of interest set
+    bool HasRegion( ) const;
+
+    // Get/Set interval of frames the step runs for - 0 or 1 means every frame, N means every Nth frame
+    uint32_t FrameInterval( ) const;
+    void SetFrameInterval( uint32_t interval );
+    // Get/Set maximum rate of running the step (times per second) - 0 means no limit
+    float MaxRate( ) const;
+    void SetMaxRate( float rate );
+    // Get/Set if the step is skipped when time budget of the video processing graph is exhausted for the current frame
+    bool SkipWhenOverBudget( ) const;
+    void SetSkipWhenOverBudget( bool skip );
+
 private:
     friend class XAutomationServer;
     friend class Private::VideoSourceData;
@@ -83,6 +100,10 @@ private:
     std::string                              mName;
     CVSandbox::XGuid                           mPluginId;
     std::map<std::string, CVSandbox::XVariant> mPluginConfiguration;
+    xrect                                      mRegion;
+    uint32_t                                   mFrameInterval;
+    float                                      mMaxRate;
+    bool                                       mSkipWhenOverBudget;
 
     std::shared_ptr<const XPluginDescriptor> mPluginDesc;
     std::shared_ptr<XPlugin>                 mPlugin;
@@ -4,7 +4,9 @@
 VPATH = ../../
 
 # source files
-SRC =  XAutomationServer.cpp XVideoSourceProcessingGraph.cpp XVideoSourceProcessingStep.cpp
+SRC =  XAutomationServer.cpp XVideoSourceProcessingGraph.cpp XVideoSourceProcessingStep.cpp \
+	XVideoFrameMailbox.cpp XLatencyHistogram.cpp XVideoProcessingTrace.cpp \
+	XImageStatisticsCache.cpp
 
 # additional include folders
 INCLUDES = -I../../../../afx/afx_types -I../../../../afx/afx_types+ \
@@ -93,6 +93,14 @@ private:
         return reinterpret_cast<CppImageProcessingWrapper*>( me )->PluginObject->ProcessImage( image );
     }
 
+    // Wrapper for ProcessImageWithHistograms() method
+    static XErrorCode Wrapper_ProcessImageWithHistograms( SImageProcessingPlugin* me, const ximage* image,
+        const xhistogram* redHistogram, const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+    {
+        return reinterpret_cast<CppImageProcessingWrapper*>( me )->PluginObject->ProcessImageWithHistograms( image,
+            redHistogram, greenHistogram, blueHistogram );
+    }
+
 public:
     PluginRegister_PluginType_ImageProcessing( xguid id, xguid family,
         PluginType type, xversion version,
@@ -129,8 +137,9 @@ public:
         wrapper->Api.Base.UpdateDescription   = Wrapper_UpdateDescription;
 
         // set image processing plug-in's methods
-        wrapper->Api.GetSupportedPixelFormats = Wrapper_GetSupportedPixelFormats;
-        wrapper->Api.ProcessImage             = Wrapper_ProcessImage;
+        wrapper->Api.GetSupportedPixelFormats   = Wrapper_GetSupportedPixelFormats;
+        wrapper->Api.ProcessImage               = Wrapper_ProcessImage;
+        wrapper->Api.ProcessImageWithHistograms = Wrapper_ProcessImageWithHistograms;
 
         return reinterpret_cast<SImageProcessingPlugin*>( wrapper );
     }
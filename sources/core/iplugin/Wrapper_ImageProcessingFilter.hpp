@@ -106,6 +106,26 @@ private:
         return reinterpret_cast<CppImageProcessingFilterWrapper*>( me )->PluginObject->ProcessImageInPlace( src );
     }
 
+    // Wrapper for GetPointOperationMaps() method
+    static XErrorCode Wrapper_GetPointOperationMaps( SImageProcessingFilterPlugin* me, XPixelFormat format, uint8_t* maps )
+    {
+        return reinterpret_cast<CppImageProcessingFilterWrapper*>( me )->PluginObject->GetPointOperationMaps( format, maps );
+    }
+
+    // Wrapper for ProcessImageWithHistograms() method
+    static XErrorCode Wrapper_ProcessImageWithHistograms( SImageProcessingFilterPlugin* me, ximage* src,
+        const xhistogram* redHistogram, const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+    {
+        return reinterpret_cast<CppImageProcessingFilterWrapper*>( me )->PluginObject->ProcessImageWithHistograms( src,
+            redHistogram, greenHistogram, blueHistogram );
+    }
+
+    // Wrapper for ProcessImageRegion() method
+    static XErrorCode Wrapper_ProcessImageRegion( SImageProcessingFilterPlugin* me, ximage* src, const xrect* region )
+    {
+        return reinterpret_cast<CppImageProcessingFilterWrapper*>( me )->PluginObject->ProcessImageRegion( src, region );
+    }
+
 public:
     PluginRegister_PluginType_ImageProcessingFilter( xguid id, xguid family,
         PluginType type, xversion version,
@@ -146,6 +166,9 @@ public:
         wrapper->Api.GetPixelFormatTranslations = Wrapper_GetPixelFormatTranslations;
         wrapper->Api.ProcessImage               = Wrapper_ProcessImage;
         wrapper->Api.ProcessImageInPlace        = Wrapper_ProcessImageInPlace;
+        wrapper->Api.GetPointOperationMaps      = Wrapper_GetPointOperationMaps;
+        wrapper->Api.ProcessImageWithHistograms = Wrapper_ProcessImageWithHistograms;
+        wrapper->Api.ProcessImageRegion         = Wrapper_ProcessImageRegion;
 
         return reinterpret_cast<SImageProcessingFilterPlugin*>( wrapper );
     }
@@ -22,6 +22,8 @@
 #include "imodule.h"
 
 // Names of module's export symbols
-const char* ModuleInitializeFuncName = "ModuleInitialize";
-const char* GetDescriptorFuncName    = "GetDescriptor";
-const char* ModuleCleanupFuncName    = "ModuleCleanup";
+const char* ModuleInitializeFuncName         = "ModuleInitialize";
+const char* GetDescriptorFuncName            = "GetDescriptor";
+const char* ModuleCleanupFuncName            = "ModuleCleanup";
+const char* GetPluginsApiVersionFuncName     = "GetPluginsApiVersion";
+const char* SetHostPluginsApiVersionFuncName = "SetHostPluginsApiVersion";
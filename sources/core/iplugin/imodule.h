@@ -67,6 +67,16 @@ extern const char* GetDescriptorFuncName;
 typedef void (*ModuleCleanupFunc)( );
 extern const char* ModuleCleanupFuncName;
 
+// --- Optional functions, which are exported by modules linked with iplugin library (see registry.c) ---
+
+// Function to provide version of plug-ins' API the module was built with
+typedef uint32_t (*GetPluginsApiVersionFunc)( );
+extern const char* GetPluginsApiVersionFuncName;
+
+// Function to tell module version of plug-ins' API the host was built with
+typedef void (*SetHostPluginsApiVersionFunc)( uint32_t version );
+extern const char* SetHostPluginsApiVersionFuncName;
+
 // --- Define shared module export attributes
 #if defined _WIN32 || defined __CYGWIN__
     #ifdef __GNUC__
@@ -53,6 +53,15 @@ static const PluginType PluginType_CommunicationDevice      = 0x0800;
 static const PluginType PluginType_Detection                = 0x1000;
 static const PluginType PluginType_All                      = 0xFFFFFFFF;
 
+// Versions of plug-ins' API modules are built with. Structures of plug-ins can get new members appended
+// only along with new API version, so host never touches members which are not provided by older modules.
+static const uint32_t PluginsApiVersion_Initial             = 1;   // modules not reporting API version
+static const uint32_t PluginsApiVersion_PointOperationMaps  = 2;   // image processing filters provide point operation maps
+static const uint32_t PluginsApiVersion_ImageHistograms     = 3;   // filters process images with histograms, scripting hosts provide them
+static const uint32_t PluginsApiVersion_ImageRegions        = 4;   // filters process regions of images
+static const uint32_t PluginsApiVersion_ImageStatistics     = 5;   // image processing plug-ins take pre-calculated histograms
+static const uint32_t PluginsApiVersion_SharedImages        = 6;   // scripting hosts share image variables without copying
+static const uint32_t PluginsApiVersion                     = 6;   // current version
 
 struct _PluginDescriptor;
 
@@ -98,6 +107,9 @@ int32_t GetPluginsCount( );
 // Get descriptor for the specified plugin's index
 PluginDescriptor* GetPluginDescriptor( int32_t plugin );
 
+// Get version of plug-ins' API the host, which loaded the module, was built with
+uint32_t GetHostPluginsApiVersion( );
+
 // Free memory taken by the specified plugin descriptor
 void FreePluginDescriptor( PluginDescriptor** pDescriptor );
 // Create a copy of the specified plugin descriptor
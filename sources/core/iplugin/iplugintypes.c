@@ -170,3 +170,72 @@ XErrorCode GetSupportedPixelFormatsImpl( const XPixelFormat* supportedPixelForma
 
     return ret;
 }
+
+// Helper function which provides implementation for the "ProcessImageRegion" method of image processing filter plug-in
+//
+XErrorCode ProcessImageRegionImpl( ximage* src, const xrect* region, int32_t borderSize,
+                                   ImageRegionProcessingHandler handler, void* userParam )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src == 0 ) || ( region == 0 ) || ( handler == 0 ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( region->x1 < 0 ) || ( region->y1 < 0 ) || ( region->x1 > region->x2 ) || ( region->y1 > region->y2 ) ||
+              ( region->x2 >= src->width ) || ( region->y2 >= src->height ) || ( borderSize < 0 ) )
+    {
+        ret = ErrorArgumentOutOfRange;
+    }
+    else
+    {
+        // region extended by the border, but still within the image
+        int32_t x1   = XMAX( region->x1 - borderSize, 0 );
+        int32_t y1   = XMAX( region->y1 - borderSize, 0 );
+        int32_t x2   = XMIN( region->x2 + borderSize, src->width  - 1 );
+        int32_t y2   = XMIN( region->y2 + borderSize, src->height - 1 );
+        ximage* view = 0;
+        ximage* copy = 0;
+
+        ret = XImageGetSubImage( src, &view, x1, y1, x2 - x1 + 1, y2 - y1 + 1 );
+
+        if ( ret == SuccessCode )
+        {
+            if ( ( x1 == region->x1 ) && ( y1 == region->y1 ) && ( x2 == region->x2 ) && ( y2 == region->y2 ) )
+            {
+                // nothing around the region to keep unchanged, so process it directly
+                ret = handler( userParam, view );
+            }
+            else
+            {
+                ret = XImageClone( view, &copy );
+
+                if ( ret == SuccessCode )
+                {
+                    ret = handler( userParam, copy );
+                }
+
+                if ( ret == SuccessCode )
+                {
+                    ximage* inner = 0;
+
+                    // put back only the region, leaving its border unchanged
+                    ret = XImageGetSubImage( copy, &inner, region->x1 - x1, region->y1 - y1,
+                                             region->x2 - region->x1 + 1, region->y2 - region->y1 + 1 );
+
+                    if ( ret == SuccessCode )
+                    {
+                        ret = XImagePutImage( src, inner, region->x1, region->y1 );
+                    }
+
+                    XImageFree( &inner );
+                }
+            }
+        }
+
+        XImageFree( &copy );
+        XImageFree( &view );
+    }
+
+    return ret;
+}
@@ -29,6 +29,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <ximage.h>
+#include <xhistogram.h>
 #include "iplugin.h"
 
 // ===== Some helper functions which may help in implementation of different plug-ins =====
@@ -51,6 +52,16 @@ XErrorCode GetSupportedExtensionsImpl( const char** supportedExtensionsIn, int32
 XErrorCode GetSupportedPixelFormatsImpl( const XPixelFormat* supportedPixelFormatsIn, int32_t inCount,
                                          XPixelFormat* supportedPixelFormatsOut, int32_t* outCount );
 
+// Handler used by ProcessImageRegionImpl() to process an image in place
+typedef XErrorCode (*ImageRegionProcessingHandler)( void* userParam, ximage* image );
+
+// Helper function which provides implementation for the "ProcessImageRegion" method of image processing filter plug-in.
+// The handler is given the region extended by the specified border size (and clipped to the source image). With zero border
+// it gets a view of the source image, otherwise a temporary copy, which inner part is then put back into the source image -
+// pixels of the border serve as neighbours for pixels of the region, but stay unchanged.
+XErrorCode ProcessImageRegionImpl( ximage* src, const xrect* region, int32_t borderSize,
+                                   ImageRegionProcessingHandler handler, void* userParam );
+
 
 // ===== Base plug-in interface =====
 struct SPluginBase_;
@@ -94,6 +105,19 @@ typedef XErrorCode (*IPFPlugin_GetPixelFormatTranslations)( struct SImageProcess
 typedef XErrorCode (*IPFPlugin_ProcessImage)( struct SImageProcessingFilterPlugin_* me, const ximage* src, ximage** dst );
 // Process specified image in place (change it)
 typedef XErrorCode (*IPFPlugin_ProcessImageInPlace)( struct SImageProcessingFilterPlugin_* me, ximage* src );
+// Get look-up tables fully describing the filter, if it is a point-wise operation on 8 bpp grayscale or 24/32 bpp color image
+// (optional - ErrorUnsupportedInterface is returned otherwise). The maps buffer keeps 3 tables of 256 values each - red, green
+// and blue maps for color images; only the first one is used for grayscale images. Alpha channel is never changed.
+typedef XErrorCode (*IPFPlugin_GetPointOperationMaps)( struct SImageProcessingFilterPlugin_* me, XPixelFormat format, uint8_t* maps );
+// Process specified image in place using its already calculated histograms, so the filter does not need to calculate them
+// (optional - ErrorUnsupportedInterface is returned otherwise). Red, green and blue histograms are provided for color images,
+// while for grayscale images only the first histogram is set.
+typedef XErrorCode (*IPFPlugin_ProcessImageWithHistograms)( struct SImageProcessingFilterPlugin_* me, ximage* src,
+                    const xhistogram* redHistogram, const xhistogram* greenHistogram, const xhistogram* blueHistogram );
+// Process specified rectangular region of an image in place, leaving pixels outside of it unchanged (optional - ErrorUnsupportedInterface
+// is returned otherwise). Coordinates of the region are inclusive and must be within the image. Filters using pixels' neighbourhood
+// take neighbours from outside of the region, so the region is processed same as it would be while processing entire image.
+typedef XErrorCode (*IPFPlugin_ProcessImageRegion)( struct SImageProcessingFilterPlugin_* me, ximage* src, const xrect* region );
 
 typedef struct SImageProcessingFilterPlugin_
 {
@@ -102,6 +126,9 @@ typedef struct SImageProcessingFilterPlugin_
     IPFPlugin_GetPixelFormatTranslations GetPixelFormatTranslations;
     IPFPlugin_ProcessImage               ProcessImage;
     IPFPlugin_ProcessImageInPlace        ProcessImageInPlace;
+    IPFPlugin_GetPointOperationMaps      GetPointOperationMaps;         // since PluginsApiVersion_PointOperationMaps
+    IPFPlugin_ProcessImageWithHistograms ProcessImageWithHistograms;    // since PluginsApiVersion_ImageHistograms
+    IPFPlugin_ProcessImageRegion         ProcessImageRegion;            // since PluginsApiVersion_ImageRegions
 }
 SImageProcessingFilterPlugin;
 
@@ -146,12 +173,17 @@ struct SImageProcessingPlugin_;
 typedef XErrorCode( *IPPlugin_GetSupportedPixelFormats )( struct SImageProcessingPlugin_* me, XPixelFormat* pixelFormats, int32_t* count );
 // Process specified source image calculating whatever it needs to
 typedef XErrorCode( *IPPlugin_ProcessImage )( struct SImageProcessingPlugin_* me, const ximage* image );
+// Process specified source image using its already calculated histograms (optional - ErrorUnsupportedInterface is returned
+// otherwise). Red, green and blue histograms are provided for color images, while for grayscale images only the first one is set.
+typedef XErrorCode( *IPPlugin_ProcessImageWithHistograms )( struct SImageProcessingPlugin_* me, const ximage* image,
+                    const xhistogram* redHistogram, const xhistogram* greenHistogram, const xhistogram* blueHistogram );
 
 typedef struct SImageProcessingPlugin_
 {
     SPluginBase Base;
-    IPPlugin_GetSupportedPixelFormats GetSupportedPixelFormats;
-    IPPlugin_ProcessImage             ProcessImage;
+    IPPlugin_GetSupportedPixelFormats    GetSupportedPixelFormats;
+    IPPlugin_ProcessImage                ProcessImage;
+    IPPlugin_ProcessImageWithHistograms  ProcessImageWithHistograms;    // since PluginsApiVersion_ImageStatistics
 }
 SImageProcessingPlugin;
 
@@ -383,20 +415,32 @@ typedef XErrorCode( *ScriptingEnginePluginCallback_SetImageVariable )( void* use
 typedef XErrorCode( *ScriptingEnginePluginCallback_GetVideoSource )( void* userParam,
                                                                      PluginDescriptor** pDescriptor,
                                                                      void** pPlugin );
+// Callback type to get histograms of the current image available on the host side. Histograms array must have
+// 3 histograms of 256 values allocated - red, green and blue ones are set for color images, while only the first
+// one is set for grayscale images (count tells the number of histograms set).
+typedef XErrorCode( *ScriptingEnginePluginCallback_GetImageHistograms )( void* userParam, xhistogram* histograms, int32_t* count );
+// Callback type to get image variable from the host side without copying it. The image is shared with the host and
+// other scripts, so it must not be changed. It stays valid until the provided handle is released.
+typedef XErrorCode( *ScriptingEnginePluginCallback_GetSharedImageVariable )( void* userParam, xstring name, const ximage** value, void** handle );
+// Callback type to release image variable previously provided by the host without copying
+typedef void( *ScriptingEnginePluginCallback_ReleaseSharedImageVariable )( void* userParam, void* handle );
 
 typedef struct ScriptingEnginePluginCallbacks_
 {
-    ScriptingEnginePluginCallback_GetHostName           GetHostName;
-    ScriptingEnginePluginCallback_GetHostVersion        GetHostVersion;
-    ScriptingEnginePluginCallback_PrintString           PrintString;
-    ScriptingEnginePluginCallback_CreatePluginInstance  CreatePluginInstance;
-    ScriptingEnginePluginCallback_GetImage              GetImage;
-    ScriptingEnginePluginCallback_SetImage              SetImage;
-    ScriptingEnginePluginCallback_GetVariable           GetVariable;
-    ScriptingEnginePluginCallback_SetVariable           SetVariable;
-    ScriptingEnginePluginCallback_GetImageVariable      GetImageVariable;
-    ScriptingEnginePluginCallback_SetImageVariable      SetImageVariable;
-    ScriptingEnginePluginCallback_GetVideoSource        GetVideoSource;
+    ScriptingEnginePluginCallback_GetHostName                   GetHostName;
+    ScriptingEnginePluginCallback_GetHostVersion                GetHostVersion;
+    ScriptingEnginePluginCallback_PrintString                   PrintString;
+    ScriptingEnginePluginCallback_CreatePluginInstance          CreatePluginInstance;
+    ScriptingEnginePluginCallback_GetImage                      GetImage;
+    ScriptingEnginePluginCallback_SetImage                      SetImage;
+    ScriptingEnginePluginCallback_GetVariable                   GetVariable;
+    ScriptingEnginePluginCallback_SetVariable                   SetVariable;
+    ScriptingEnginePluginCallback_GetImageVariable              GetImageVariable;
+    ScriptingEnginePluginCallback_SetImageVariable              SetImageVariable;
+    ScriptingEnginePluginCallback_GetVideoSource                GetVideoSource;
+    ScriptingEnginePluginCallback_GetImageHistograms            GetImageHistograms;             // since PluginsApiVersion_ImageHistograms
+    ScriptingEnginePluginCallback_GetSharedImageVariable        GetSharedImageVariable;         // since PluginsApiVersion_SharedImages
+    ScriptingEnginePluginCallback_ReleaseSharedImageVariable    ReleaseSharedImageVariable;     // since PluginsApiVersion_SharedImages
 }
 ScriptingEnginePluginCallbacks;
 
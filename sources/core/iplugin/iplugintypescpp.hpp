@@ -85,6 +85,71 @@ public:
     virtual XErrorCode ProcessImage( const ximage* src, ximage** dst ) = 0;
     // Process specified image in place (change it)
     virtual XErrorCode ProcessImageInPlace( ximage* src ) = 0;
+
+    // Get look-up tables describing the filter if it is a point-wise operation - not supported by default,
+    // only those in-place filters, which simply re-map pixel values, can provide them (see IPFPlugin_GetPointOperationMaps)
+    virtual XErrorCode GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+    {
+        XUNREFERENCED_PARAMETER( format )
+        XUNREFERENCED_PARAMETER( maps )
+        return ErrorUnsupportedInterface;
+    }
+
+    // Process specified image in place using its already calculated histograms - not supported by default,
+    // only filters, which start with calculating image histograms, may benefit from it (see IPFPlugin_ProcessImageWithHistograms)
+    virtual XErrorCode ProcessImageWithHistograms( ximage* src, const xhistogram* redHistogram,
+                                                   const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+    {
+        XUNREFERENCED_PARAMETER( src )
+        XUNREFERENCED_PARAMETER( redHistogram )
+        XUNREFERENCED_PARAMETER( greenHistogram )
+        XUNREFERENCED_PARAMETER( blueHistogram )
+        return ErrorUnsupportedInterface;
+    }
+
+    // Process specified region of an image in place - not supported by default, filters implement it usually
+    // with the help of ProcessImageRegionHelper() (see IPFPlugin_ProcessImageRegion)
+    virtual XErrorCode ProcessImageRegion( ximage* src, const xrect* region )
+    {
+        XUNREFERENCED_PARAMETER( src )
+        XUNREFERENCED_PARAMETER( region )
+        return ErrorUnsupportedInterface;
+    }
+
+protected:
+    // Process region of an image extended by the specified border using ProcessImageInPlace() or ProcessImage(),
+    // depending on what the filter can do. The latter is possible only if filter does not change image size/format.
+    XErrorCode ProcessImageRegionHelper( ximage* src, const xrect* region, int32_t borderSize )
+    {
+        return ProcessImageRegionImpl( src, region, borderSize, ProcessImageRegionHandler, this );
+    }
+
+private:
+    static XErrorCode ProcessImageRegionHandler( void* userParam, ximage* image )
+    {
+        IImageProcessingFilterPlugin* me  = static_cast<IImageProcessingFilterPlugin*>( userParam );
+        XErrorCode                    ret = SuccessCode;
+
+        if ( me->CanProcessInPlace( ) )
+        {
+            ret = me->ProcessImageInPlace( image );
+        }
+        else
+        {
+            ximage* result = nullptr;
+
+            ret = me->ProcessImage( image, &result );
+
+            if ( ret == SuccessCode )
+            {
+                ret = XImageCopyData( result, image );
+            }
+
+            XImageFree( &result );
+        }
+
+        return ret;
+    }
 };
 
 // ===== Interface for image processing filter plug-in which uses 2 images to produce one =====
@@ -115,6 +180,18 @@ public:
     virtual XErrorCode GetSupportedPixelFormats( XPixelFormat* pixelFormats, int32_t* count ) = 0;
     // Process the specified image
     virtual XErrorCode ProcessImage( const ximage* image ) = 0;
+
+    // Process the specified image using its already calculated histograms - not supported by default,
+    // only plug-ins, which start with calculating image histograms, may benefit from it
+    virtual XErrorCode ProcessImageWithHistograms( const ximage* image, const xhistogram* redHistogram,
+                                                   const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+    {
+        XUNREFERENCED_PARAMETER( image )
+        XUNREFERENCED_PARAMETER( redHistogram )
+        XUNREFERENCED_PARAMETER( greenHistogram )
+        XUNREFERENCED_PARAMETER( blueHistogram )
+        return ErrorUnsupportedInterface;
+    }
 };
 
 // ===== Interface for image importing plug-in =====
@@ -21,8 +21,11 @@
 
 #include <xlist.h>
 #include "iplugin.h"
+#include "imodule.h"
 
-static xlist* pluginStore;
+static xlist*   pluginStore;
+// hosts built before API versioning never tell their version, so PluginsApiVersion_Initial is assumed
+static uint32_t hostApiVersion = 1;
 
 // Register plugin with the provided description
 void RegisterPlugin( const PluginDescriptor* desc )
@@ -90,3 +93,21 @@ PluginDescriptor* GetPluginDescriptor( int32_t plugin )
     }
     return desc;
 }
+
+// Get version of plug-ins' API the module was built with (exported by every module linked with this library)
+MODULE_PUBLIC uint32_t GetPluginsApiVersion( )
+{
+    return PluginsApiVersion;
+}
+
+// Set version of plug-ins' API the host was built with (exported by every module linked with this library)
+MODULE_PUBLIC void SetHostPluginsApiVersion( uint32_t version )
+{
+    hostApiVersion = version;
+}
+
+// Get version of plug-ins' API the host, which loaded the module, was built with
+uint32_t GetHostPluginsApiVersion( )
+{
+    return hostApiVersion;
+}
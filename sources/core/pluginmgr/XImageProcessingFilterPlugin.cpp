@@ -26,10 +26,11 @@
 using namespace std;
 using namespace CVSandbox;
 
-XImageProcessingFilterPlugin::XImageProcessingFilterPlugin( void* plugin, bool ownIt ) :
+XImageProcessingFilterPlugin::XImageProcessingFilterPlugin( void* plugin, bool ownIt, uint32_t apiVersion ) :
     XPlugin( plugin, PluginType_ImageProcessingFilter, ownIt ),
     mSupportedInputFormats( ),
-    mSupportedOutputFormats( )
+    mSupportedOutputFormats( ),
+    mApiVersion( apiVersion )
 {
     int32_t pixelFormatsCount = 0;
 
@@ -60,9 +61,9 @@ XImageProcessingFilterPlugin::~XImageProcessingFilterPlugin( )
 }
 
 // Create plug-in wrapper
-const shared_ptr<XImageProcessingFilterPlugin> XImageProcessingFilterPlugin::Create( void* plugin, bool ownIt )
+const shared_ptr<XImageProcessingFilterPlugin> XImageProcessingFilterPlugin::Create( void* plugin, bool ownIt, uint32_t apiVersion )
 {
-    return shared_ptr<XImageProcessingFilterPlugin>( new XImageProcessingFilterPlugin( plugin, ownIt ) );
+    return shared_ptr<XImageProcessingFilterPlugin>( new XImageProcessingFilterPlugin( plugin, ownIt, apiVersion ) );
 }
 
 // Check if the image processing filter can process images by modifying them
@@ -145,3 +146,59 @@ XErrorCode XImageProcessingFilterPlugin::ProcessImage( const shared_ptr<const XI
 
     return ret;
 }
+
+// Get look-up tables describing the filter if it is a point-wise operation for the specified pixel format
+XErrorCode XImageProcessingFilterPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps ) const
+{
+    SImageProcessingFilterPlugin* ipf = static_cast<SImageProcessingFilterPlugin*>( mPlugin );
+    XErrorCode                    ret = ErrorUnsupportedInterface;
+
+    if ( maps == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    // modules built with older API don't have the member in plug-in's structure at all
+    else if ( ( mApiVersion >= PluginsApiVersion_PointOperationMaps ) && ( ipf->GetPointOperationMaps != nullptr ) )
+    {
+        ret = ipf->GetPointOperationMaps( ipf, format, maps );
+    }
+
+    return ret;
+}
+
+// Process image in place using its already calculated histograms (only the first one is used for grayscale images)
+XErrorCode XImageProcessingFilterPlugin::ProcessImageWithHistograms( const shared_ptr<XImage>& src, const xhistogram* redHistogram,
+                                                                     const xhistogram* greenHistogram, const xhistogram* blueHistogram ) const
+{
+    SImageProcessingFilterPlugin* ipf = static_cast<SImageProcessingFilterPlugin*>( mPlugin );
+    XErrorCode                    ret = ErrorUnsupportedInterface;
+
+    if ( ( !src ) || ( redHistogram == nullptr ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( mApiVersion >= PluginsApiVersion_ImageHistograms ) && ( ipf->ProcessImageWithHistograms != nullptr ) )
+    {
+        ret = ipf->ProcessImageWithHistograms( ipf, src->ImageData( ), redHistogram, greenHistogram, blueHistogram );
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place (coordinates are inclusive)
+XErrorCode XImageProcessingFilterPlugin::ProcessImageRegion( const shared_ptr<XImage>& src, const xrect& region ) const
+{
+    SImageProcessingFilterPlugin* ipf = static_cast<SImageProcessingFilterPlugin*>( mPlugin );
+    XErrorCode                    ret = ErrorUnsupportedInterface;
+
+    if ( !src )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( mApiVersion >= PluginsApiVersion_ImageRegions ) && ( ipf->ProcessImageRegion != nullptr ) )
+    {
+        ret = ipf->ProcessImageRegion( ipf, src->ImageData( ), &region );
+    }
+
+    return ret;
+}
@@ -30,13 +30,14 @@
 class XImageProcessingFilterPlugin : public XPlugin
 {
 private:
-    XImageProcessingFilterPlugin( void* plugin, bool ownIt );
+    XImageProcessingFilterPlugin( void* plugin, bool ownIt, uint32_t apiVersion );
 
 public:
     virtual ~XImageProcessingFilterPlugin( );
 
-    // Create plug-in wrapper
-    static const std::shared_ptr<XImageProcessingFilterPlugin> Create( void* plugin, bool ownIt = true );
+    // Create plug-in wrapper (API version tells which members of plug-in's structure are provided by its module)
+    static const std::shared_ptr<XImageProcessingFilterPlugin> Create( void* plugin, bool ownIt = true,
+                                                                        uint32_t apiVersion = PluginsApiVersion_Initial );
 
     // Check if the image processing filter can process images by modifying them
     // (without creating new image as a result)
@@ -54,9 +55,21 @@ public:
     // Process image and create new image as a result
     XErrorCode ProcessImage( const std::shared_ptr<const CVSandbox::XImage>& src, std::shared_ptr<CVSandbox::XImage>& dst ) const;
 
+    // Get look-up tables describing the filter if it is a point-wise operation for the specified pixel format
+    // (3 tables of 256 values - red, green, blue; only the first one is used for grayscale images)
+    XErrorCode GetPointOperationMaps( XPixelFormat format, uint8_t* maps ) const;
+
+    // Process image in place using its already calculated histograms (only the first one is used for grayscale images)
+    XErrorCode ProcessImageWithHistograms( const std::shared_ptr<CVSandbox::XImage>& src, const xhistogram* redHistogram,
+                                           const xhistogram* greenHistogram, const xhistogram* blueHistogram ) const;
+
+    // Process the specified region of an image in place (coordinates are inclusive)
+    XErrorCode ProcessImageRegion( const std::shared_ptr<CVSandbox::XImage>& src, const xrect& region ) const;
+
 private:
     std::vector<XPixelFormat> mSupportedInputFormats;
     std::vector<XPixelFormat> mSupportedOutputFormats;
+    uint32_t                  mApiVersion;
 };
 
 #endif // CVS_XIMAGE_PROCESSING_FILTER_PLUGIN_HPP
@@ -25,9 +25,10 @@
 using namespace std;
 using namespace CVSandbox;
 
-XImageProcessingPlugin::XImageProcessingPlugin( void* plugin, bool ownIt ) :
+XImageProcessingPlugin::XImageProcessingPlugin( void* plugin, bool ownIt, uint32_t apiVersion ) :
     XPlugin( plugin, PluginType_ImageProcessing, ownIt ),
-    mSupportedFormats( )
+    mSupportedFormats( ),
+    mApiVersion( apiVersion )
 {
     int32_t pixelFormatsCount = 0;
 
@@ -54,9 +55,9 @@ XImageProcessingPlugin::~XImageProcessingPlugin( )
 }
 
 // Create plug-in wrapper
-const shared_ptr<XImageProcessingPlugin> XImageProcessingPlugin::Create( void* plugin, bool ownIt )
+const shared_ptr<XImageProcessingPlugin> XImageProcessingPlugin::Create( void* plugin, bool ownIt, uint32_t apiVersion )
 {
-    return shared_ptr<XImageProcessingPlugin>( new XImageProcessingPlugin( plugin, ownIt ) );
+    return shared_ptr<XImageProcessingPlugin>( new XImageProcessingPlugin( plugin, ownIt, apiVersion ) );
 }
 
 // Check if certain pixel format is supported by the filter
@@ -77,3 +78,23 @@ XErrorCode XImageProcessingPlugin::ProcessImage( const shared_ptr<XImage>& image
     SImageProcessingPlugin* ip = static_cast<SImageProcessingPlugin*>( mPlugin );
     return ip->ProcessImage( ip, image->ImageData( ) );
 }
+
+// Process the specified image using its already calculated histograms (only the first one is used for grayscale images)
+XErrorCode XImageProcessingPlugin::ProcessImageWithHistograms( const shared_ptr<XImage>& image, const xhistogram* redHistogram,
+                                                               const xhistogram* greenHistogram, const xhistogram* blueHistogram ) const
+{
+    SImageProcessingPlugin* ip  = static_cast<SImageProcessingPlugin*>( mPlugin );
+    XErrorCode              ret = ErrorUnsupportedInterface;
+
+    if ( ( !image ) || ( redHistogram == nullptr ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    // modules built with older API don't have the member in plug-in's structure at all
+    else if ( ( mApiVersion >= PluginsApiVersion_ImageStatistics ) && ( ip->ProcessImageWithHistograms != nullptr ) )
+    {
+        ret = ip->ProcessImageWithHistograms( ip, image->ImageData( ), redHistogram, greenHistogram, blueHistogram );
+    }
+
+    return ret;
+}
@@ -30,13 +30,14 @@
 class XImageProcessingPlugin : public XPlugin
 {
 private:
-    XImageProcessingPlugin( void* plugin, bool ownIt );
+    XImageProcessingPlugin( void* plugin, bool ownIt, uint32_t apiVersion );
 
 public:
     virtual ~XImageProcessingPlugin( );
 
-    // Create plug-in wrapper
-    static const std::shared_ptr<XImageProcessingPlugin> Create( void* plugin, bool ownIt = true );
+    // Create plug-in wrapper (API version tells which members of plug-in's structure are provided by its module)
+    static const std::shared_ptr<XImageProcessingPlugin> Create( void* plugin, bool ownIt = true,
+                                                                  uint32_t apiVersion = PluginsApiVersion_Initial );
 
     // Check if certain pixel format is supported by the filter
     bool IsPixelFormatSupported( XPixelFormat pixelFormat ) const;
@@ -45,9 +46,13 @@ public:
 
     // Process the specified image
     XErrorCode ProcessImage( const std::shared_ptr<CVSandbox::XImage>& image ) const;
+    // Process the specified image using its already calculated histograms (only the first one is used for grayscale images)
+    XErrorCode ProcessImageWithHistograms( const std::shared_ptr<CVSandbox::XImage>& image, const xhistogram* redHistogram,
+                                           const xhistogram* greenHistogram, const xhistogram* blueHistogram ) const;
 
 private:
     std::vector<XPixelFormat> mSupportedFormats;
+    uint32_t                  mApiVersion;
 };
 
 #endif // CVS_XIMAGE_PROCESSING_PLUGIN_HPP
@@ -127,5 +127,5 @@ XErrorCode XPlugin::UpdateDescription( shared_ptr<XPluginDescriptor> descriptor
 {
     SPluginBase* plugin = static_cast<SPluginBase*>( mPlugin );
 
-    return plugin->UpdateDescription( plugin, descriptor->mDescriptor );
+    return plugin->UpdateDescription( plugin, descriptor->LoadedDescriptor( ) );
 }
@@ -22,12 +22,16 @@
 #include <assert.h>
 #include "XPluginDescriptor.hpp"
 #include "XPluginWrapperFactory.hpp"
+#include "XPluginsModule.hpp"
+#include "XPluginsManifestCache.hpp"
 
 using namespace std;
 using namespace CVSandbox;
 
-XPluginDescriptor::XPluginDescriptor( PluginDescriptor* desc ) :
-    mDescriptor( desc ), mProperties( ), mFunctions( )
+XPluginDescriptor::XPluginDescriptor( PluginDescriptor* desc, const shared_ptr<const XManifestIcons>& icons,
+                                      bool isDynamic, XPluginsModule* module, uint32_t apiVersion ) :
+    mDescriptor( desc ), mLoadedDescriptor( ( module == nullptr ) ? desc : nullptr ), mModule( module ), mApiVersion( apiVersion ),
+    mIcons( icons ), mIsDynamic( isDynamic ), mProperties( ), mFunctions( )
 {
     // collect properties
     if ( ( mDescriptor->PropertiesCount != 0 ) && ( mDescriptor->Properties != 0 ) )
@@ -54,18 +58,62 @@ XPluginDescriptor::XPluginDescriptor( PluginDescriptor* desc ) :
 
 XPluginDescriptor::~XPluginDescriptor( )
 {
+    if ( mLoadedDescriptor != mDescriptor )
+    {
+        FreePluginDescriptor( &mLoadedDescriptor );
+    }
+
     FreePluginDescriptor( &mDescriptor );
 }
 
-shared_ptr<XPluginDescriptor> XPluginDescriptor::Create( PluginDescriptor* desc )
+shared_ptr<XPluginDescriptor> XPluginDescriptor::Create( PluginDescriptor* desc, uint32_t apiVersion )
 {
     assert( desc );
-    return shared_ptr<XPluginDescriptor>( ( desc == 0 ) ? 0 : new XPluginDescriptor( desc ) );
+    return shared_ptr<XPluginDescriptor>( ( desc == 0 ) ? 0 : new XPluginDescriptor( desc, nullptr, false, nullptr, apiVersion ) );
 }
 
+shared_ptr<XPluginDescriptor> XPluginDescriptor::CreateFromManifest( PluginDescriptor* desc, const shared_ptr<const XManifestIcons>& icons,
+                                                                     bool isDynamic, XPluginsModule* module )
+{
+    assert( desc );
+    return shared_ptr<XPluginDescriptor>( ( desc == 0 ) ? 0 : new XPluginDescriptor( desc, icons, isDynamic, module, PluginsApiVersion_Initial ) );
+}
+
+// Clone is made from the descriptor provided by module, so it can be updated
 shared_ptr<XPluginDescriptor> XPluginDescriptor::Clone( ) const
 {
-    return shared_ptr<XPluginDescriptor>( new XPluginDescriptor( CopyPluginDescriptor( mDescriptor ) ) );
+    PluginDescriptor* desc = LoadedDescriptor( );
+
+    return shared_ptr<XPluginDescriptor>( ( desc == nullptr ) ? nullptr :
+        new XPluginDescriptor( CopyPluginDescriptor( desc ), nullptr, false, nullptr, mApiVersion ) );
+}
+
+// Get descriptor provided by the plug-in's module, loading the module if it is not loaded yet
+PluginDescriptor* XPluginDescriptor::LoadedDescriptor( ) const
+{
+    if ( mModule != nullptr )
+    {
+        mModule->LoadOnDemand( );
+    }
+
+    return mLoadedDescriptor;
+}
+
+// Attach descriptor provided by the plug-in's module, which got loaded (called by module with its lock held)
+void XPluginDescriptor::AttachLoadedDescriptor( PluginDescriptor* desc, uint32_t apiVersion ) const
+{
+    mLoadedDescriptor = desc;
+    mApiVersion       = apiVersion;
+
+    // description of dynamic plug-in's properties is updated by its module, so property descriptors
+    // are switched to the module's version (cached one is kept alive for anyone still reading it)
+    if ( ( mIsDynamic ) && ( desc->PropertiesCount == mDescriptor->PropertiesCount ) && ( desc->Properties != nullptr ) )
+    {
+        for ( int32_t i = 0, n = static_cast<int32_t>( mProperties.size( ) ); i < n; i++ )
+        {
+            const_cast<XPropertyDescriptor*>( mProperties[i].get( ) )->mDescriptor = desc->Properties[i];
+        }
+    }
 }
 
 // Plug-in ID
@@ -107,8 +155,19 @@ string XPluginDescriptor::Help( ) const
 
 shared_ptr<const XImage> XPluginDescriptor::Icon( bool getSmall ) const
 {
-    return XImage::Create( const_cast<const ximage*>(
-        ( getSmall ) ? mDescriptor->SmallIcon : mDescriptor->Icon ) );
+    shared_ptr<const XImage> icon;
+
+    if ( mIcons )
+    {
+        icon = mIcons->Icon( getSmall );
+    }
+    else
+    {
+        icon = XImage::Create( const_cast<const ximage*>(
+            ( getSmall ) ? mDescriptor->SmallIcon : mDescriptor->Icon ) );
+    }
+
+    return icon;
 }
 
 // Number of properties which are not read-only
@@ -153,9 +212,12 @@ const shared_ptr<const XPropertyDescriptor> XPluginDescriptor::GetPropertyDescri
 
     if ( ( id >= 0 ) && ( id < mDescriptor->PropertiesCount ) )
     {
-        if ( mDescriptor->PropertyUpdater != 0 )
+        // only dynamic plug-ins need their module to provide description of properties
+        PluginDescriptor* desc = ( mIsDynamic ) ? LoadedDescriptor( ) : mDescriptor;
+
+        if ( ( desc != nullptr ) && ( desc->PropertyUpdater != 0 ) )
         {
-            mDescriptor->PropertyUpdater( mDescriptor );
+            desc->PropertyUpdater( desc );
         }
 
         prop = mProperties[id];
@@ -227,7 +289,15 @@ int32_t XPluginDescriptor::GetFunctionIndexByName( const string& name ) const
 // Create instance of the plug-in
 const shared_ptr<XPlugin> XPluginDescriptor::CreateInstance( ) const
 {
-    return XPluginWrapperFactory::CreateWrapper( mDescriptor->Creator( ), mDescriptor->Type );
+    PluginDescriptor* desc = LoadedDescriptor( );
+    shared_ptr<XPlugin> plugin;
+
+    if ( ( desc != nullptr ) && ( desc->Creator != nullptr ) )
+    {
+        plugin = XPluginWrapperFactory::CreateWrapper( desc->Creator( ), desc->Type, true, mApiVersion );
+    }
+
+    return plugin;
 }
 
 // Helper function to get plug-in's configuration
@@ -292,5 +362,7 @@ XErrorCode XPluginDescriptor::SetPluginConfiguration( const shared_ptr<XPlugin>
 // Get copy of the wrapped C plug-in descriptor
 PluginDescriptor* XPluginDescriptor::GetPluginDescriptorCopy( ) const
 {
-    return CopyPluginDescriptor( mDescriptor );
+    PluginDescriptor* desc = LoadedDescriptor( );
+
+    return ( desc == nullptr ) ? nullptr : CopyPluginDescriptor( desc );
 }
@@ -37,18 +37,27 @@
 #include "XPropertyDescriptor.hpp"
 #include "XFunctionDescriptor.hpp"
 
+class XPluginsModule;
+class XManifestIcons;
+
 // Class which wraps description of a plug-in
 class XPluginDescriptor : private CVSandbox::Uncopyable
 {
 friend class XPlugin;
+friend class XPluginsModule;
 
 private:
-    XPluginDescriptor( PluginDescriptor* desc );
+    XPluginDescriptor( PluginDescriptor* desc, const std::shared_ptr<const XManifestIcons>& icons,
+                       bool isDynamic, XPluginsModule* module, uint32_t apiVersion );
 
 public:
     ~XPluginDescriptor( );
 
-    static std::shared_ptr<XPluginDescriptor> Create( PluginDescriptor* desc );
+    // Create descriptor of a plug-in provided by a module built with the specified version of plug-ins' API
+    static std::shared_ptr<XPluginDescriptor> Create( PluginDescriptor* desc, uint32_t apiVersion = PluginsApiVersion_Initial );
+    // Create descriptor restored from manifest cache - the plug-in's module gets loaded only when it is needed
+    static std::shared_ptr<XPluginDescriptor> CreateFromManifest( PluginDescriptor* desc, const std::shared_ptr<const XManifestIcons>& icons,
+                                                                  bool isDynamic, XPluginsModule* module );
     std::shared_ptr<XPluginDescriptor> Clone( ) const;
 
     // Description of the plug-in
@@ -110,8 +119,19 @@ public:
     // Get copy of the wrapped C plug-in descriptor
     PluginDescriptor* GetPluginDescriptorCopy( ) const;
 
+private:
+    // Get descriptor provided by the plug-in's module, loading the module if it is not loaded yet
+    PluginDescriptor* LoadedDescriptor( ) const;
+    // Attach descriptor provided by the plug-in's module, which got loaded
+    void AttachLoadedDescriptor( PluginDescriptor* desc, uint32_t apiVersion ) const;
+
 private:
     PluginDescriptor*                                        mDescriptor;
+    mutable PluginDescriptor*                                mLoadedDescriptor;
+    mutable XPluginsModule*                                  mModule;
+    mutable uint32_t                                         mApiVersion;
+    std::shared_ptr<const XManifestIcons>                    mIcons;
+    bool                                                     mIsDynamic;
     std::vector<std::shared_ptr<const XPropertyDescriptor> > mProperties;
     std::vector<std::shared_ptr<const XFunctionDescriptor> > mFunctions;
 };
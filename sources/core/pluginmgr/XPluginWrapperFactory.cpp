@@ -35,7 +35,7 @@
 
 using namespace std;
 
-shared_ptr<XPlugin> XPluginWrapperFactory::CreateWrapper( void* pluginObject, PluginType type, bool ownIt )
+shared_ptr<XPlugin> XPluginWrapperFactory::CreateWrapper( void* pluginObject, PluginType type, bool ownIt, uint32_t apiVersion )
 {
     shared_ptr<XPlugin> pluginInstance;
 
@@ -44,7 +44,7 @@ shared_ptr<XPlugin> XPluginWrapperFactory::CreateWrapper( void* pluginObject, Pl
         switch ( type )
         {
         case PluginType_ImageProcessingFilter:
-            pluginInstance = XImageProcessingFilterPlugin::Create( pluginObject, ownIt );
+            pluginInstance = XImageProcessingFilterPlugin::Create( pluginObject, ownIt, apiVersion );
             break;
 
         case PluginType_ImageProcessingFilter2:
@@ -84,7 +84,7 @@ shared_ptr<XPlugin> XPluginWrapperFactory::CreateWrapper( void* pluginObject, Pl
             break;
 
         case PluginType_ImageProcessing:
-            pluginInstance = XImageProcessingPlugin::Create( pluginObject, ownIt );
+            pluginInstance = XImageProcessingPlugin::Create( pluginObject, ownIt, apiVersion );
             break;
 
         default:
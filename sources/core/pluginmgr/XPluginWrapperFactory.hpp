@@ -32,7 +32,9 @@ private:
     XPluginWrapperFactory( ) { }
 
 public:
-    static std::shared_ptr<XPlugin> CreateWrapper( void* pluginObject, PluginType type, bool ownIt = true );
+    // Create wrapper for a plug-in object (API version tells which version of plug-ins' API its module was built with)
+    static std::shared_ptr<XPlugin> CreateWrapper( void* pluginObject, PluginType type, bool ownIt = true,
+                                                   uint32_t apiVersion = PluginsApiVersion_Initial );
 };
 
 #endif // CVS_XPLUGIN_WRAPPER_FACTORY_HPP
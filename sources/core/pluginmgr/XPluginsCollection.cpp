@@ -45,7 +45,7 @@ void XPluginsCollection::Clear( )
 }
 
 // Collect plug-ins given a pointer to a function which provides plug-in descriptors
-size_t XPluginsCollection::CollectPlugins( GetDescriptorFunc pluginsNest, int32_t count, PluginType typesToCollec )
+size_t XPluginsCollection::CollectPlugins( GetDescriptorFunc pluginsNest, int32_t count, PluginType typesToCollec, uint32_t apiVersion )
 {
     Clear( );
 
@@ -55,7 +55,7 @@ size_t XPluginsCollection::CollectPlugins( GetDescriptorFunc pluginsNest, int32_
 
         if ( desc != 0 )
         {
-            shared_ptr<const XPluginDescriptor> descriptor = XPluginDescriptor::Create( desc );
+            shared_ptr<const XPluginDescriptor> descriptor = XPluginDescriptor::Create( desc, apiVersion );
 
             if ( descriptor->Type( ) & typesToCollec )
             {
@@ -45,7 +45,9 @@ public:
     // Create empty collection
     static const std::shared_ptr<XPluginsCollection> Create( );
     // Collect plug-ins given a pointer to a function which provides plug-in descriptors
-    size_t CollectPlugins( GetDescriptorFunc pluginsNest, int32_t count, PluginType typesToCollec = PluginType_All );
+    // (API version tells which version of plug-ins' API the providing module was built with)
+    size_t CollectPlugins( GetDescriptorFunc pluginsNest, int32_t count, PluginType typesToCollec = PluginType_All,
+                           uint32_t apiVersion = PluginsApiVersion_Initial );
     // Create copy of the collection
     const std::shared_ptr<XPluginsCollection> Copy( ) const;
 
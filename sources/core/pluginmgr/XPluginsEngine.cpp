@@ -21,6 +21,8 @@
 
 #include <string>
 #include <queue>
+#include <algorithm>
+#include <XThread.hpp>
 #include "XPluginsEngine.hpp"
 
 #ifdef WIN32
@@ -28,14 +30,55 @@
 #else
     #include <sys/types.h>
     #include <dirent.h>
+    #include <string.h>
 #endif
 
 using namespace std;
 using namespace CVSandbox;
+using namespace CVSandbox::Threading;
+
+namespace
+{
+    // Modules to load by a group of threads
+    struct ModulesLoadingContext
+    {
+        vector<shared_ptr<XPluginsModule>> Modules;
+        vector<XErrorCode>                 Results;
+        size_t                             NextModule;
+        PluginType                         TypesToCollect;
+        XPluginsManifestCache*             ManifestCache;
+        XMutex                             Sync;
+    };
+
+    // Keep loading modules until all are taken
+    void ModulesLoadingThread( void* param )
+    {
+        ModulesLoadingContext* context = static_cast<ModulesLoadingContext*>( param );
+
+        for ( ; ; )
+        {
+            size_t moduleIndex;
+
+            {
+                XScopedLock lock( &context->Sync );
+
+                if ( context->NextModule == context->Modules.size( ) )
+                {
+                    break;
+                }
+
+                moduleIndex = context->NextModule++;
+            }
+
+            context->Results[moduleIndex] = context->Modules[moduleIndex]->Load( context->TypesToCollect, context->ManifestCache );
+        }
+    }
+}
 
 XPluginsEngine::XPluginsEngine( ) :
     mFamilies( XFamiliesCollection::GetBuiltInFamilies( ) ),
-    mModules( XModulesCollection::Create( ) )
+    mModules( XModulesCollection::Create( ) ),
+    mManifestCache( )
 {
 }
 
@@ -73,10 +116,19 @@ const shared_ptr<XPluginsEngine> XPluginsEngine::Create( )
     return shared_ptr<XPluginsEngine>( new XPluginsEngine( ) );
 }
 
+// Set file to cache manifests of modules in
+XErrorCode XPluginsEngine::SetManifestCache( const string& fileName )
+{
+    mManifestCache = XPluginsManifestCache::Create( fileName );
+
+    return mManifestCache->Load( );
+}
+
 // Collect modules containing plug-ins of the specified types
 size_t XPluginsEngine::CollectModules( const string& startPath, PluginType typesToCollect )
 {
-    bool rootIsDone = false;
+    vector<string> moduleFileNames;
+    bool           rootIsDone = false;
 
 #ifdef WIN32
     const wchar_t* moduleExtension = XModuleDefaultExtensionW( );
@@ -129,7 +181,7 @@ size_t XPluginsEngine::CollectModules( const string& startPath, PluginType types
                                     {
                                         if ( WideCharToMultiByte( CP_UTF8, 0, wMoulePath.c_str( ), -1, modulePath, bytesRequired, NULL, NULL ) > 0 )
                                         {
-                                            LoadMoadule( string( modulePath ), typesToCollect );
+                                            moduleFileNames.push_back( string( modulePath ) );
                                         }
 
                                         free( modulePath );
@@ -174,7 +226,7 @@ size_t XPluginsEngine::CollectModules( const string& startPath, PluginType types
                 if ( ( fileNameLen > extLen ) &&
                      ( strcmp( &dirEntry->d_name[fileNameLen - extLen], moduleExtension ) == 0 ) )
                 {
-                    LoadMoadule( path + dirEntry->d_name, typesToCollect );
+                    moduleFileNames.push_back( path + dirEntry->d_name );
                 }
             }
 
@@ -186,17 +238,82 @@ size_t XPluginsEngine::CollectModules( const string& startPath, PluginType types
     }
 #endif
 
+    LoadModules( moduleFileNames, typesToCollect );
+
     return mModules->Count( );
 }
 
-// Load module with the specified file name
-void XPluginsEngine::LoadMoadule( const string& fileName, PluginType typesToCollect )
+// Load modules with the specified file names
+void XPluginsEngine::LoadModules( const vector<string>& fileNames, PluginType typesToCollect )
 {
-    shared_ptr<XPluginsModule> module = XPluginsModule::Create( fileName );
+    vector<shared_ptr<XPluginsModule>> modules;
+    vector<bool>                       isModuleReady;
+    ModulesLoadingContext              context;
+
+    context.NextModule     = 0;
+    context.TypesToCollect = typesToCollect;
+    context.ManifestCache  = mManifestCache.get( );
+
+    // take description of modules from cache when possible, the rest need to be loaded
+    for ( vector<string>::const_iterator it = fileNames.begin( ); it != fileNames.end( ); ++it )
+    {
+        shared_ptr<XPluginsModule> module  = XPluginsModule::Create( *it );
+        XErrorCode                 ecode   = ( mManifestCache ) ? module->LoadManifest( *mManifestCache, typesToCollect ) : ErrorFailed;
+
+        // skip files known not to be modules
+        if ( ecode != ErrorUnsupportedInterface )
+        {
+            if ( ecode != SuccessCode )
+            {
+                context.Modules.push_back( module );
+            }
+
+            modules.push_back( module );
+            isModuleReady.push_back( ecode == SuccessCode );
+        }
+    }
+
+    if ( !context.Modules.empty( ) )
+    {
+        // load modules in parallel, so slow storage and their initialization don't add up
+        size_t          threadsCount = min( static_cast<size_t>( XThread::CpuCount( ) ), context.Modules.size( ) );
+        vector<XThread> threads( ( threadsCount > 1 ) ? threadsCount - 1 : 0 );
+
+        context.Results.resize( context.Modules.size( ), ErrorFailed );
+
+        for ( size_t i = 0; i < threads.size( ); i++ )
+        {
+            threads[i].Create( ModulesLoadingThread, &context );
+        }
+
+        ModulesLoadingThread( &context );
+
+        for ( size_t i = 0; i < threads.size( ); i++ )
+        {
+            threads[i].Join( );
+        }
+
+        for ( size_t i = 0, j = 0; i < modules.size( ); i++ )
+        {
+            if ( !isModuleReady[i] )
+            {
+                isModuleReady[i] = ( context.Results[j++] == SuccessCode );
+            }
+        }
+    }
+
+    // add modules in the order they were found, so it does not depend on loading order
+    for ( size_t i = 0; i < modules.size( ); i++ )
+    {
+        if ( ( isModuleReady[i] ) && ( modules[i]->Count( ) != 0 ) )
+        {
+            mModules->Add( modules[i] );
+        }
+    }
 
-    if ( ( module->Load( typesToCollect ) == SuccessCode ) && ( module->Count( ) != 0 ) )
+    if ( mManifestCache )
     {
-        mModules->Add( module );
+        mManifestCache->Save( );
     }
 }
 
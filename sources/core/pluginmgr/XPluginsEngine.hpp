@@ -26,10 +26,12 @@
 #include <stdint.h>
 #include <string>
 #include <memory>
+#include <vector>
 #include <XInterfaces.hpp>
 
 #include "XModulesCollection.hpp"
 #include "XFamiliesCollection.hpp"
+#include "XPluginsManifestCache.hpp"
 
 class XPluginsEngine : private CVSandbox::Uncopyable
 {
@@ -41,6 +43,10 @@ public:
 
     static const std::shared_ptr<XPluginsEngine> Create( );
 
+    // Set file to cache manifests of modules in. If set before collecting modules, their description is taken
+    // from the cache and they are loaded only when needed. Modules, which are not in the cache yet, are added to it.
+    XErrorCode SetManifestCache( const std::string& fileName );
+
     // Collect modules containing plug-ins of the specified types
     size_t CollectModules( const std::string& path, PluginType typesToCollect = PluginType_All );
 
@@ -75,12 +81,13 @@ public:
     const std::shared_ptr<const XPluginsModule> GetModule( const CVSandbox::XGuid& id ) const;
 
 private:
-    // Load module with the specified file name
-    void LoadMoadule( const std::string& fileName, PluginType typesToCollect );
+    // Load modules with the specified file names
+    void LoadModules( const std::vector<std::string>& fileNames, PluginType typesToCollect );
 
 private:
-    std::shared_ptr<XFamiliesCollection> mFamilies;
-    std::shared_ptr<XModulesCollection>  mModules;
+    std::shared_ptr<XFamiliesCollection>   mFamilies;
+    std::shared_ptr<XModulesCollection>    mModules;
+    std::shared_ptr<XPluginsManifestCache> mManifestCache;
 };
 
 #endif // CVS_XPLUGINS_ENGINE_HPP
@@ -0,0 +1,892 @@
+/*
+    Plug-ins' management library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "XPluginsManifestCache.hpp"
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace CVSandbox;
+using namespace CVSandbox::Threading;
+
+// Signature and version of the manifest cache file's format (cache of other version is ignored)
+static const uint32_t MANIFEST_CACHE_SIGNATURE = 0x4D505643; // "CVPM"
+static const uint32_t MANIFEST_CACHE_VERSION   = 1;
+
+// Flags telling plug-in's descriptor uses updater functions
+static const uint8_t PLUGIN_FLAG_PROPERTY_UPDATER     = 1;
+static const uint8_t PLUGIN_FLAG_DEPENDENT_PROPERTIES = 2;
+
+namespace
+{
+    // Helper class to serialize descriptors into a manifest
+    class ManifestWriter
+    {
+    public:
+        ManifestWriter( vector<uint8_t>& buffer ) : Buffer( buffer ), IsValid( true ) { }
+
+        void Write( const void* data, size_t size )
+        {
+            const uint8_t* ptr = static_cast<const uint8_t*>( data );
+            Buffer.insert( Buffer.end( ), ptr, ptr + size );
+        }
+
+        template <typename T> void WriteValue( T value )
+        {
+            Write( &value, sizeof( T ) );
+        }
+
+        void WriteString( xstring str )
+        {
+            if ( str == nullptr )
+            {
+                WriteValue<uint32_t>( 0xFFFFFFFF );
+            }
+            else
+            {
+                uint32_t length = static_cast<uint32_t>( strlen( str ) );
+
+                WriteValue<uint32_t>( length );
+                Write( str, length );
+            }
+        }
+
+        // Images are written as size of their record followed by it, so they can be extracted without decoding
+        void WriteImage( const ximage* image )
+        {
+            if ( image == nullptr )
+            {
+                WriteValue<uint32_t>( 0 );
+            }
+            else if ( ( image->palette != nullptr ) || ( XImageIsPixelFormatPlanar( image->format ) ) )
+            {
+                IsValid = false;
+            }
+            else
+            {
+                uint32_t lineSize = XImageBytesPerLine( image->width * XImageBitsPerPixel( image->format ) );
+
+                WriteValue<uint32_t>( static_cast<uint32_t>( sizeof( int32_t ) * 3 + lineSize * image->height ) );
+                WriteValue<int32_t>( image->width );
+                WriteValue<int32_t>( image->height );
+                WriteValue<int32_t>( image->format );
+
+                for ( int32_t y = 0; y < image->height; y++ )
+                {
+                    Write( image->data + y * image->stride, lineSize );
+                }
+            }
+        }
+
+        void WriteVariant( const xvariant& var )
+        {
+            WriteValue<XVarType>( var.type );
+
+            if ( IS_ARRAY_TYPE( var.type ) )
+            {
+                // only one dimensional arrays are expected to be used for default values/choices
+                if ( ( ( var.type & XVT_Array2d ) != 0 ) || ( ( var.type & XVT_ArrayJagged ) != 0 ) || ( var.value.arrayVal == nullptr ) )
+                {
+                    IsValid = false;
+                }
+                else
+                {
+                    WriteValue<uint32_t>( var.value.arrayVal->length );
+
+                    for ( uint32_t i = 0; i < var.value.arrayVal->length; i++ )
+                    {
+                        WriteVariant( var.value.arrayVal->elements[i] );
+                    }
+                }
+            }
+            else if ( var.type == XVT_String )
+            {
+                WriteString( var.value.strVal );
+            }
+            else if ( var.type == XVT_Image )
+            {
+                IsValid = false;
+            }
+            else if ( ( var.type != XVT_Empty ) && ( var.type != XVT_Null ) )
+            {
+                WriteValue( var.value );
+            }
+        }
+
+    public:
+        vector<uint8_t>& Buffer;
+        bool             IsValid;
+    };
+
+    // Helper class to restore descriptors from a manifest
+    class ManifestReader
+    {
+    public:
+        ManifestReader( const uint8_t* data, size_t size ) : Data( data ), Size( size ), Position( 0 ), IsValid( true ) { }
+
+        bool Read( void* data, size_t size )
+        {
+            if ( ( !IsValid ) || ( size > Size - Position ) )
+            {
+                IsValid = false;
+                memset( data, 0, size );
+            }
+            else
+            {
+                memcpy( data, Data + Position, size );
+                Position += size;
+            }
+
+            return IsValid;
+        }
+
+        template <typename T> T ReadValue( )
+        {
+            T value;
+            Read( &value, sizeof( T ) );
+            return value;
+        }
+
+        // Read count of items following it - each takes at least one byte
+        int32_t ReadCount( )
+        {
+            int32_t count = ReadValue<int32_t>( );
+
+            if ( ( count < 0 ) || ( static_cast<size_t>( count ) > Size - Position ) )
+            {
+                IsValid = false;
+                count   = 0;
+            }
+
+            return count;
+        }
+
+        xstring ReadString( )
+        {
+            uint32_t length = ReadValue<uint32_t>( );
+            xstring  str    = nullptr;
+
+            if ( ( IsValid ) && ( length != 0xFFFFFFFF ) )
+            {
+                if ( length > Size - Position )
+                {
+                    IsValid = false;
+                }
+                else
+                {
+                    string temp( reinterpret_cast<const char*>( Data + Position ), length );
+
+                    str       = XStringAlloc( temp.c_str( ) );
+                    Position += length;
+                }
+            }
+
+            return str;
+        }
+
+        // Take image record as it is, so it is decoded only when needed
+        void ReadImageRecord( vector<uint8_t>& record )
+        {
+            uint32_t recordSize = ReadValue<uint32_t>( );
+
+            record.clear( );
+
+            if ( ( IsValid ) && ( recordSize != 0 ) )
+            {
+                if ( recordSize > Size - Position )
+                {
+                    IsValid = false;
+                }
+                else
+                {
+                    record.assign( Data + Position, Data + Position + recordSize );
+                    Position += recordSize;
+                }
+            }
+        }
+
+        void ReadVariant( xvariant* var )
+        {
+            XVariantInit( var );
+
+            var->type = ReadValue<XVarType>( );
+
+            if ( IS_ARRAY_TYPE( var->type ) )
+            {
+                XVarType elementType = var->type & XVT_Any;
+                uint32_t length      = ReadValue<uint32_t>( );
+                xarray*  array       = nullptr;
+
+                var->type = XVT_Empty;
+
+                // each element takes at least its type
+                if ( ( !IsValid ) || ( length > ( Size - Position ) / sizeof( XVarType ) ) ||
+                     ( XArrayAllocate( &array, elementType, length ) != SuccessCode ) )
+                {
+                    IsValid = false;
+                }
+                else
+                {
+                    for ( uint32_t i = 0; ( i < length ) && ( IsValid ); i++ )
+                    {
+                        xvariant element;
+
+                        ReadVariant( &element );
+
+                        if ( ( IsValid ) && ( XArrayMove( array, i, &element ) != SuccessCode ) )
+                        {
+                            IsValid = false;
+                        }
+
+                        XVariantClear( &element );
+                    }
+
+                    var->type           = XVT_Array | ( array->type );
+                    var->value.arrayVal = array;
+                }
+            }
+            else if ( var->type == XVT_String )
+            {
+                var->value.strVal = ReadString( );
+
+                if ( var->value.strVal == nullptr )
+                {
+                    var->type = XVT_Empty;
+                }
+            }
+            else if ( ( var->type != XVT_Empty ) && ( var->type != XVT_Null ) )
+            {
+                if ( var->type > XVT_Size )
+                {
+                    var->type = XVT_Empty;
+                    IsValid   = false;
+                }
+                else
+                {
+                    Read( &var->value, sizeof( var->value ) );
+                }
+            }
+        }
+
+    public:
+        const uint8_t* Data;
+        size_t         Size;
+        size_t         Position;
+        bool           IsValid;
+    };
+
+    // Get size and modification time of the specified file
+    bool GetFileInfo( const string& fileName, uint64_t* pSize, int64_t* pModificationTime )
+    {
+        bool ret = false;
+
+#ifdef WIN32
+        int charsRequired = MultiByteToWideChar( CP_UTF8, 0, fileName.c_str( ), -1, NULL, 0 );
+
+        if ( charsRequired > 0 )
+        {
+            wstring                   wFileName( charsRequired, L'\0' );
+            WIN32_FILE_ATTRIBUTE_DATA fileData;
+
+            if ( ( MultiByteToWideChar( CP_UTF8, 0, fileName.c_str( ), -1, &wFileName[0], charsRequired ) > 0 ) &&
+                 ( GetFileAttributesExW( wFileName.c_str( ), GetFileExInfoStandard, &fileData ) ) )
+            {
+                *pSize             = ( static_cast<uint64_t>( fileData.nFileSizeHigh ) << 32 ) | fileData.nFileSizeLow;
+                *pModificationTime = ( static_cast<int64_t>( fileData.ftLastWriteTime.dwHighDateTime ) << 32 ) | fileData.ftLastWriteTime.dwLowDateTime;
+                ret = true;
+            }
+        }
+#else
+        struct stat fileStat;
+
+        if ( stat( fileName.c_str( ), &fileStat ) == 0 )
+        {
+            *pSize             = static_cast<uint64_t>( fileStat.st_size );
+            *pModificationTime = static_cast<int64_t>( fileStat.st_mtim.tv_sec ) * 1000000000 + fileStat.st_mtim.tv_nsec;
+            ret = true;
+        }
+#endif
+
+        return ret;
+    }
+
+    // Decode image from its record in a manifest
+    shared_ptr<const XImage> DecodeImageRecord( const vector<uint8_t>& record )
+    {
+        shared_ptr<const XImage> ret;
+        ManifestReader           reader( record.data( ), record.size( ) );
+        int32_t                  width  = reader.ReadValue<int32_t>( );
+        int32_t                  height = reader.ReadValue<int32_t>( );
+        XPixelFormat             format = static_cast<XPixelFormat>( reader.ReadValue<int32_t>( ) );
+        ximage*                  image  = nullptr;
+
+        if ( ( reader.IsValid ) && ( width > 0 ) && ( height > 0 ) &&
+             ( XImageAllocateRaw( width, height, format, &image ) == SuccessCode ) )
+        {
+            uint32_t lineSize = XImageBytesPerLine( width * XImageBitsPerPixel( format ) );
+
+            for ( int32_t y = 0; y < height; y++ )
+            {
+                reader.Read( image->data + y * image->stride, lineSize );
+            }
+
+            if ( reader.IsValid )
+            {
+                ret = XImage::Create( &image, true );
+            }
+
+            XImageFree( &image );
+        }
+
+        return ret;
+    }
+}
+
+// ==========================================================================
+
+XManifestIcons::XManifestIcons( vector<uint8_t>& smallIcon, vector<uint8_t>& icon ) :
+    mSync( ), mData( ), mIcons( )
+{
+    mData[0].swap( smallIcon );
+    mData[1].swap( icon );
+}
+
+// Get icon decoding it on the first request
+const shared_ptr<const XImage> XManifestIcons::Icon( bool getSmall ) const
+{
+    XScopedLock lock( &mSync );
+    int         index = ( getSmall ) ? 0 : 1;
+
+    if ( ( !mIcons[index] ) && ( !mData[index].empty( ) ) )
+    {
+        mIcons[index] = DecodeImageRecord( mData[index] );
+    }
+
+    return mIcons[index];
+}
+
+// ==========================================================================
+
+XPluginsManifestCache::XPluginsManifestCache( const string& fileName ) :
+    mFileName( fileName ), mSync( ), mModules( ), mIsModified( false )
+{
+}
+
+XPluginsManifestCache::~XPluginsManifestCache( )
+{
+}
+
+const shared_ptr<XPluginsManifestCache> XPluginsManifestCache::Create( const string& fileName )
+{
+    return shared_ptr<XPluginsManifestCache>( new XPluginsManifestCache( fileName ) );
+}
+
+// Load cached manifests from the file
+XErrorCode XPluginsManifestCache::Load( )
+{
+    XScopedLock lock( &mSync );
+    XErrorCode  ret  = SuccessCode;
+    FILE*       file = fopen( mFileName.c_str( ), "rb" );
+
+    mModules.clear( );
+    mIsModified = false;
+
+    if ( file != nullptr )
+    {
+        vector<uint8_t> buffer;
+        uint8_t         block[64 * 1024];
+        size_t          read;
+
+        while ( ( read = fread( block, 1, sizeof( block ), file ) ) != 0 )
+        {
+            buffer.insert( buffer.end( ), block, block + read );
+        }
+
+        fclose( file );
+
+        ManifestReader reader( buffer.data( ), buffer.size( ) );
+
+        // cache of some other version is not an error - it will be overwritten
+        if ( ( reader.ReadValue<uint32_t>( ) == MANIFEST_CACHE_SIGNATURE ) &&
+             ( reader.ReadValue<uint32_t>( ) == MANIFEST_CACHE_VERSION ) )
+        {
+            uint32_t modulesCount = reader.ReadValue<uint32_t>( );
+
+            for ( uint32_t i = 0; ( i < modulesCount ) && ( reader.IsValid ); i++ )
+            {
+                xstring     moduleFileName = reader.ReadString( );
+                ModuleEntry entry;
+                uint32_t    manifestSize;
+
+                entry.FileSize         = reader.ReadValue<uint64_t>( );
+                entry.ModificationTime = reader.ReadValue<int64_t>( );
+                manifestSize           = reader.ReadValue<uint32_t>( );
+
+                if ( ( reader.IsValid ) && ( moduleFileName != nullptr ) && ( manifestSize <= reader.Size - reader.Position ) )
+                {
+                    entry.Manifest.assign( reader.Data + reader.Position, reader.Data + reader.Position + manifestSize );
+                    reader.Position += manifestSize;
+
+                    mModules[moduleFileName] = entry;
+                }
+                else
+                {
+                    reader.IsValid = false;
+                }
+
+                XStringFree( &moduleFileName );
+            }
+
+            if ( !reader.IsValid )
+            {
+                mModules.clear( );
+                ret = ErrorInvalidFormat;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Save manifests into the file
+XErrorCode XPluginsManifestCache::Save( )
+{
+    XScopedLock lock( &mSync );
+    XErrorCode  ret = SuccessCode;
+
+    if ( mIsModified )
+    {
+        vector<uint8_t> buffer;
+        ManifestWriter  writer( buffer );
+        uint32_t        modulesCount = 0;
+
+        writer.WriteValue<uint32_t>( MANIFEST_CACHE_SIGNATURE );
+        writer.WriteValue<uint32_t>( MANIFEST_CACHE_VERSION );
+        writer.WriteValue<uint32_t>( modulesCount );
+
+        for ( map<string, ModuleEntry>::const_iterator it = mModules.begin( ); it != mModules.end( ); ++it )
+        {
+            uint64_t fileSize;
+            int64_t  modificationTime;
+
+            // don't keep modules, which were removed or changed
+            if ( ( GetFileInfo( it->first, &fileSize, &modificationTime ) ) &&
+                 ( fileSize == it->second.FileSize ) && ( modificationTime == it->second.ModificationTime ) )
+            {
+                writer.WriteString( it->first.c_str( ) );
+                writer.WriteValue<uint64_t>( it->second.FileSize );
+                writer.WriteValue<int64_t>( it->second.ModificationTime );
+                writer.WriteValue<uint32_t>( static_cast<uint32_t>( it->second.Manifest.size( ) ) );
+                writer.Write( it->second.Manifest.data( ), it->second.Manifest.size( ) );
+
+                modulesCount++;
+            }
+        }
+
+        memcpy( &buffer[sizeof( uint32_t ) * 2], &modulesCount, sizeof( modulesCount ) );
+
+        // write into temporary file first, so that readers never see partially written cache
+        string tempFileName = mFileName + ".tmp";
+        FILE*  file         = fopen( tempFileName.c_str( ), "wb" );
+
+        if ( file == nullptr )
+        {
+            ret = ErrorIOFailure;
+        }
+        else
+        {
+            bool written = ( fwrite( buffer.data( ), 1, buffer.size( ), file ) == buffer.size( ) );
+
+            if ( ( fclose( file ) != 0 ) || ( !written ) )
+            {
+                ret = ErrorIOFailure;
+            }
+            else
+            {
+#ifdef WIN32
+                remove( mFileName.c_str( ) );
+#endif
+                if ( rename( tempFileName.c_str( ), mFileName.c_str( ) ) != 0 )
+                {
+                    ret = ErrorIOFailure;
+                }
+            }
+
+            if ( ret != SuccessCode )
+            {
+                remove( tempFileName.c_str( ) );
+            }
+        }
+
+        if ( ret == SuccessCode )
+        {
+            mIsModified = false;
+        }
+    }
+
+    return ret;
+}
+
+// Get manifest of the specified module
+bool XPluginsManifestCache::GetModuleManifest( const string& moduleFileName, ModuleDescriptor** pModuleDescriptor,
+                                               shared_ptr<const XManifestIcons>* pModuleIcons, vector<XPluginManifest>& plugins ) const
+{
+    XScopedLock                               lock( &mSync );
+    map<string, ModuleEntry>::const_iterator  it = mModules.find( moduleFileName );
+    uint64_t                                  fileSize;
+    int64_t                                   modificationTime;
+    bool                                      ret = false;
+
+    plugins.clear( );
+
+    if ( ( it == mModules.end( ) ) ||
+         ( !GetFileInfo( moduleFileName, &fileSize, &modificationTime ) ) ||
+         ( fileSize != it->second.FileSize ) || ( modificationTime != it->second.ModificationTime ) )
+    {
+        // not cached or was changed
+    }
+    else if ( it->second.Manifest.empty( ) )
+    {
+        // not a module
+        *pModuleDescriptor = nullptr;
+        ret = true;
+    }
+    else
+    {
+        ManifestReader    reader( it->second.Manifest.data( ), it->second.Manifest.size( ) );
+        ModuleDescriptor* moduleDesc = static_cast<ModuleDescriptor*>( XCAlloc( 1, sizeof( ModuleDescriptor ) ) );
+        vector<uint8_t>   smallIcon, icon;
+
+        if ( moduleDesc != nullptr )
+        {
+            reader.Read( &moduleDesc->ID, sizeof( moduleDesc->ID ) );
+            reader.Read( &moduleDesc->Version, sizeof( moduleDesc->Version ) );
+            moduleDesc->Name         = reader.ReadString( );
+            moduleDesc->ShortName    = reader.ReadString( );
+            moduleDesc->Description  = reader.ReadString( );
+            moduleDesc->Vendor       = reader.ReadString( );
+            moduleDesc->Copyright    = reader.ReadString( );
+            moduleDesc->Website      = reader.ReadString( );
+            reader.ReadImageRecord( smallIcon );
+            reader.ReadImageRecord( icon );
+            moduleDesc->PluginsCount = reader.ReadValue<int32_t>( );
+
+            *pModuleIcons = make_shared<XManifestIcons>( smallIcon, icon );
+
+            uint32_t pluginsCount = reader.ReadValue<uint32_t>( );
+
+            for ( uint32_t i = 0; ( i < pluginsCount ) && ( reader.IsValid ); i++ )
+            {
+                PluginDescriptor* desc = static_cast<PluginDescriptor*>( XCAlloc( 1, sizeof( PluginDescriptor ) ) );
+                XPluginManifest   manifest;
+
+                if ( desc == nullptr )
+                {
+                    reader.IsValid = false;
+                    break;
+                }
+
+                reader.Read( &desc->ID, sizeof( desc->ID ) );
+                reader.Read( &desc->Family, sizeof( desc->Family ) );
+                desc->Type        = static_cast<PluginType>( reader.ReadValue<uint32_t>( ) );
+                reader.Read( &desc->Version, sizeof( desc->Version ) );
+                desc->Name        = reader.ReadString( );
+                desc->ShortName   = reader.ReadString( );
+                desc->Description = reader.ReadString( );
+                desc->Help        = reader.ReadString( );
+                reader.ReadImageRecord( smallIcon );
+                reader.ReadImageRecord( icon );
+
+                manifest.Descriptor = desc;
+                manifest.Icons      = make_shared<XManifestIcons>( smallIcon, icon );
+                manifest.IsDynamic  = ( reader.ReadValue<uint8_t>( ) != 0 );
+
+                int32_t propertiesCount = reader.ReadCount( );
+
+                if ( propertiesCount > 0 )
+                {
+                    desc->Properties = static_cast<PropertyDescriptor**>( XCAlloc( propertiesCount, sizeof( PropertyDescriptor* ) ) );
+
+                    if ( desc->Properties != nullptr )
+                    {
+                        desc->PropertiesCount = propertiesCount;
+
+                        for ( int32_t j = 0; ( j < propertiesCount ) && ( reader.IsValid ); j++ )
+                        {
+                            PropertyDescriptor* prop = static_cast<PropertyDescriptor*>( XCAlloc( 1, sizeof( PropertyDescriptor ) ) );
+
+                            if ( prop == nullptr )
+                            {
+                                reader.IsValid = false;
+                                break;
+                            }
+
+                            desc->Properties[j] = prop;
+
+                            prop->Type        = reader.ReadValue<XVarType>( );
+                            prop->Name        = reader.ReadString( );
+                            prop->ShortName   = reader.ReadString( );
+                            prop->Description = reader.ReadString( );
+                            prop->Flags       = static_cast<PropertyFlags>( reader.ReadValue<uint32_t>( ) );
+                            reader.ReadVariant( &prop->DefaultValue );
+                            reader.ReadVariant( &prop->MinValue );
+                            reader.ReadVariant( &prop->MaxValue );
+
+                            int32_t choicesCount = reader.ReadCount( );
+
+                            if ( choicesCount > 0 )
+                            {
+                                prop->Choices = static_cast<xvariant*>( XCAlloc( choicesCount, sizeof( xvariant ) ) );
+
+                                if ( prop->Choices == nullptr )
+                                {
+                                    reader.IsValid = false;
+                                }
+                                else
+                                {
+                                    prop->ChoicesCount = static_cast<int16_t>( choicesCount );
+
+                                    for ( int32_t k = 0; k < choicesCount; k++ )
+                                    {
+                                        reader.ReadVariant( &prop->Choices[k] );
+                                    }
+                                }
+                            }
+
+                            prop->ParentProperty = reader.ReadValue<int16_t>( );
+                        }
+                    }
+                    else
+                    {
+                        reader.IsValid = false;
+                    }
+                }
+
+                int32_t functionsCount = reader.ReadCount( );
+
+                if ( functionsCount > 0 )
+                {
+                    desc->Functions = static_cast<FunctionDescriptor**>( XCAlloc( functionsCount, sizeof( FunctionDescriptor* ) ) );
+
+                    if ( desc->Functions != nullptr )
+                    {
+                        desc->FunctionsCount = functionsCount;
+
+                        for ( int32_t j = 0; ( j < functionsCount ) && ( reader.IsValid ); j++ )
+                        {
+                            FunctionDescriptor* func = static_cast<FunctionDescriptor*>( XCAlloc( 1, sizeof( FunctionDescriptor ) ) );
+
+                            if ( func == nullptr )
+                            {
+                                reader.IsValid = false;
+                                break;
+                            }
+
+                            desc->Functions[j] = func;
+
+                            func->ReturnType  = reader.ReadValue<XVarType>( );
+                            func->Name        = reader.ReadString( );
+                            func->Description = reader.ReadString( );
+
+                            int32_t argumentsCount = reader.ReadCount( );
+
+                            if ( argumentsCount > 0 )
+                            {
+                                func->Arguments = static_cast<ArgumentDescriptor**>( XCAlloc( argumentsCount, sizeof( ArgumentDescriptor* ) ) );
+
+                                if ( func->Arguments == nullptr )
+                                {
+                                    reader.IsValid = false;
+                                }
+                                else
+                                {
+                                    func->ArgumentsCount = argumentsCount;
+
+                                    for ( int32_t k = 0; ( k < argumentsCount ) && ( reader.IsValid ); k++ )
+                                    {
+                                        ArgumentDescriptor* arg = static_cast<ArgumentDescriptor*>( XCAlloc( 1, sizeof( ArgumentDescriptor ) ) );
+
+                                        if ( arg == nullptr )
+                                        {
+                                            reader.IsValid = false;
+                                            break;
+                                        }
+
+                                        func->Arguments[k] = arg;
+
+                                        arg->Type        = reader.ReadValue<XVarType>( );
+                                        arg->Name        = reader.ReadString( );
+                                        arg->Description = reader.ReadString( );
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        reader.IsValid = false;
+                    }
+                }
+
+                plugins.push_back( manifest );
+            }
+
+            ret = reader.IsValid;
+        }
+
+        if ( ret )
+        {
+            *pModuleDescriptor = moduleDesc;
+        }
+        else
+        {
+            FreeModuleDescriptor( &moduleDesc );
+
+            for ( vector<XPluginManifest>::iterator pit = plugins.begin( ); pit != plugins.end( ); ++pit )
+            {
+                FreePluginDescriptor( &pit->Descriptor );
+            }
+
+            plugins.clear( );
+        }
+    }
+
+    return ret;
+}
+
+// Put manifest of the specified module into the cache
+bool XPluginsManifestCache::PutModuleManifest( const string& moduleFileName, const ModuleDescriptor* moduleDesc,
+                                               const vector<const PluginDescriptor*>& plugins )
+{
+    ModuleEntry    entry;
+    ManifestWriter writer( entry.Manifest );
+    bool           ret = false;
+
+    if ( !GetFileInfo( moduleFileName, &entry.FileSize, &entry.ModificationTime ) )
+    {
+        writer.IsValid = false;
+    }
+    else if ( moduleDesc != nullptr )
+    {
+        writer.Write( &moduleDesc->ID, sizeof( moduleDesc->ID ) );
+        writer.Write( &moduleDesc->Version, sizeof( moduleDesc->Version ) );
+        writer.WriteString( moduleDesc->Name );
+        writer.WriteString( moduleDesc->ShortName );
+        writer.WriteString( moduleDesc->Description );
+        writer.WriteString( moduleDesc->Vendor );
+        writer.WriteString( moduleDesc->Copyright );
+        writer.WriteString( moduleDesc->Website );
+        writer.WriteImage( moduleDesc->SmallIcon );
+        writer.WriteImage( moduleDesc->Icon );
+        writer.WriteValue<int32_t>( moduleDesc->PluginsCount );
+
+        writer.WriteValue<uint32_t>( static_cast<uint32_t>( plugins.size( ) ) );
+
+        for ( vector<const PluginDescriptor*>::const_iterator it = plugins.begin( ); it != plugins.end( ); ++it )
+        {
+            const PluginDescriptor* desc  = *it;
+            uint8_t                 flags = ( desc->PropertyUpdater != nullptr ) ? PLUGIN_FLAG_PROPERTY_UPDATER : 0;
+
+            writer.Write( &desc->ID, sizeof( desc->ID ) );
+            writer.Write( &desc->Family, sizeof( desc->Family ) );
+            writer.WriteValue<uint32_t>( desc->Type );
+            writer.Write( &desc->Version, sizeof( desc->Version ) );
+            writer.WriteString( desc->Name );
+            writer.WriteString( desc->ShortName );
+            writer.WriteString( desc->Description );
+            writer.WriteString( desc->Help );
+            writer.WriteImage( desc->SmallIcon );
+            writer.WriteImage( desc->Icon );
+
+            for ( int32_t j = 0; ( desc->Properties != nullptr ) && ( j < desc->PropertiesCount ); j++ )
+            {
+                if ( desc->Properties[j]->Updater != nullptr )
+                {
+                    flags |= PLUGIN_FLAG_DEPENDENT_PROPERTIES;
+                }
+            }
+
+            writer.WriteValue<uint8_t>( flags );
+
+            writer.WriteValue<int32_t>( ( desc->Properties != nullptr ) ? desc->PropertiesCount : 0 );
+
+            for ( int32_t j = 0; ( desc->Properties != nullptr ) && ( j < desc->PropertiesCount ); j++ )
+            {
+                const PropertyDescriptor* prop = desc->Properties[j];
+
+                writer.WriteValue<XVarType>( prop->Type );
+                writer.WriteString( prop->Name );
+                writer.WriteString( prop->ShortName );
+                writer.WriteString( prop->Description );
+                writer.WriteValue<uint32_t>( prop->Flags );
+                writer.WriteVariant( prop->DefaultValue );
+                writer.WriteVariant( prop->MinValue );
+                writer.WriteVariant( prop->MaxValue );
+                writer.WriteValue<int32_t>( ( prop->Choices != nullptr ) ? prop->ChoicesCount : 0 );
+
+                for ( int16_t k = 0; ( prop->Choices != nullptr ) && ( k < prop->ChoicesCount ); k++ )
+                {
+                    writer.WriteVariant( prop->Choices[k] );
+                }
+
+                writer.WriteValue<int16_t>( prop->ParentProperty );
+            }
+
+            writer.WriteValue<int32_t>( ( desc->Functions != nullptr ) ? desc->FunctionsCount : 0 );
+
+            for ( int32_t j = 0; ( desc->Functions != nullptr ) && ( j < desc->FunctionsCount ); j++ )
+            {
+                const FunctionDescriptor* func = desc->Functions[j];
+
+                writer.WriteValue<XVarType>( func->ReturnType );
+                writer.WriteString( func->Name );
+                writer.WriteString( func->Description );
+                writer.WriteValue<int32_t>( ( func->Arguments != nullptr ) ? func->ArgumentsCount : 0 );
+
+                for ( int32_t k = 0; ( func->Arguments != nullptr ) && ( k < func->ArgumentsCount ); k++ )
+                {
+                    writer.WriteValue<XVarType>( func->Arguments[k]->Type );
+                    writer.WriteString( func->Arguments[k]->Name );
+                    writer.WriteString( func->Arguments[k]->Description );
+                }
+            }
+        }
+    }
+
+    // modules with descriptions, which cannot be cached, are always loaded
+    if ( writer.IsValid )
+    {
+        XScopedLock lock( &mSync );
+
+        mModules[moduleFileName] = entry;
+        mIsModified = true;
+        ret         = true;
+    }
+
+    return ret;
+}
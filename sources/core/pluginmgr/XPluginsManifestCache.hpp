@@ -0,0 +1,99 @@
+/*
+    Plug-ins' management library of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_XPLUGINS_MANIFEST_CACHE_HPP
+#define CVS_XPLUGINS_MANIFEST_CACHE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
+#include <XInterfaces.hpp>
+#include <XImage.hpp>
+#include <XMutex.hpp>
+#include <imodule.h>
+
+// Icons of a module or a plug-in, which are kept serialized until they are requested
+class XManifestIcons : private CVSandbox::Uncopyable
+{
+public:
+    XManifestIcons( std::vector<uint8_t>& smallIcon, std::vector<uint8_t>& icon );
+
+    const std::shared_ptr<const CVSandbox::XImage> Icon( bool getSmall = true ) const;
+
+private:
+    mutable CVSandbox::Threading::XMutex                     mSync;
+    std::vector<uint8_t>                                     mData[2];
+    mutable std::shared_ptr<const CVSandbox::XImage>         mIcons[2];
+};
+
+// Description of a plug-in restored from manifest cache
+struct XPluginManifest
+{
+    PluginDescriptor*                      Descriptor;     // descriptor without any function pointers
+    std::shared_ptr<const XManifestIcons>  Icons;
+    bool                                   IsDynamic;      // the plug-in updates description of its properties
+};
+
+// Cache of plug-in modules' manifests, which allows collecting modules' and plug-ins' descriptions
+// without loading their shared libraries. Modules are identified by their path, size and modification time.
+class XPluginsManifestCache : private CVSandbox::Uncopyable
+{
+private:
+    XPluginsManifestCache( const std::string& fileName );
+
+public:
+    ~XPluginsManifestCache( );
+
+    static const std::shared_ptr<XPluginsManifestCache> Create( const std::string& fileName );
+
+    // Load cached manifests from the file (missing file is not an error)
+    XErrorCode Load( );
+    // Save manifests into the file, if any of them were changed
+    XErrorCode Save( );
+
+    // Get manifest of the specified module. Fails if the module is not cached or it was changed since then.
+    // Caller owns the provided module and plug-in descriptors. Module descriptor is set to null for files,
+    // which are known not to be plug-in modules.
+    bool GetModuleManifest( const std::string& moduleFileName, ModuleDescriptor** pModuleDescriptor,
+                            std::shared_ptr<const XManifestIcons>* pModuleIcons, std::vector<XPluginManifest>& plugins ) const;
+    // Put manifest of the specified module into the cache. Returns false if any of the descriptors cannot be cached.
+    // Null module descriptor marks the file as not a plug-ins' module, so it is not loaded again.
+    bool PutModuleManifest( const std::string& moduleFileName, const ModuleDescriptor* moduleDescriptor,
+                            const std::vector<const PluginDescriptor*>& plugins );
+
+private:
+    struct ModuleEntry
+    {
+        uint64_t             FileSize;
+        int64_t              ModificationTime;
+        std::vector<uint8_t> Manifest;
+    };
+
+    const std::string                    mFileName;
+    mutable CVSandbox::Threading::XMutex mSync;
+    std::map<std::string, ModuleEntry>   mModules;
+    bool                                 mIsModified;
+};
+
+#endif // CVS_XPLUGINS_MANIFEST_CACHE_HPP
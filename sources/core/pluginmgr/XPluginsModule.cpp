@@ -19,10 +19,13 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <vector>
 #include "XPluginsModule.hpp"
+#include "XPluginsManifestCache.hpp"
 
 using namespace std;
 using namespace CVSandbox;
+using namespace CVSandbox::Threading;
 
 const ModuleDescriptor XPluginsModule::BlankModuleDescriptor =
 {
@@ -35,7 +38,8 @@ XPluginsModule::XPluginsModule( const std::string& fileName ) :
     mModule( 0 ), mFileName( fileName ),
     mPlugins( XPluginsCollection::Create( ) ),
     // a bit of a hack, but we'll trust it since we are not going (not supposed) to change the descriptor anyway
-    mDescriptor( const_cast<ModuleDescriptor*>( &BlankModuleDescriptor ) )
+    mDescriptor( const_cast<ModuleDescriptor*>( &BlankModuleDescriptor ) ),
+    mIcons( ), mIsRestored( false ), mFailedLoading( false ), mLoadSync( )
 {
 }
 
@@ -44,13 +48,30 @@ XPluginsModule::~XPluginsModule( )
     Unload( );
 }
 
+// Tell the loaded module version of plug-ins' API the host was built with and get the version module was built with
+static uint32_t ExchangeApiVersions( xmodule module )
+{
+    SetHostPluginsApiVersionFunc hostApiVersionSetter = (SetHostPluginsApiVersionFunc)
+        XModuleGetSymbol( module, SetHostPluginsApiVersionFuncName );
+    GetPluginsApiVersionFunc     apiVersionProvider   = (GetPluginsApiVersionFunc)
+        XModuleGetSymbol( module, GetPluginsApiVersionFuncName );
+
+    if ( hostApiVersionSetter != 0 )
+    {
+        hostApiVersionSetter( PluginsApiVersion );
+    }
+
+    // modules built before API versioning don't export the function
+    return ( apiVersionProvider == 0 ) ? PluginsApiVersion_Initial : apiVersionProvider( );
+}
+
 const shared_ptr<XPluginsModule> XPluginsModule::Create( const std::string& fileName )
 {
     return shared_ptr<XPluginsModule>( new XPluginsModule( fileName ) );
 }
 
 // Load the module
-XErrorCode XPluginsModule::Load( PluginType typesToCollect )
+XErrorCode XPluginsModule::Load( PluginType typesToCollect, XPluginsManifestCache* manifestCache )
 {
     XErrorCode retCode = SuccessCode;
 
@@ -72,19 +93,54 @@ XErrorCode XPluginsModule::Load( PluginType typesToCollect )
         {
             // failed getting required API - wrong interface
             retCode = ErrorUnsupportedInterface;
+
+            if ( manifestCache != nullptr )
+            {
+                manifestCache->PutModuleManifest( mFileName, nullptr, vector<const PluginDescriptor*>( ) );
+            }
         }
         else
         {
-            ModuleDescriptor* desc = moduleInitilizer( );
+            uint32_t          apiVersion = ExchangeApiVersions( mModule );
+            ModuleDescriptor* desc       = moduleInitilizer( );
 
             if ( desc == 0 )
             {
                 return ErrorInitializationFailed;
             }
+            else if ( manifestCache == nullptr )
+            {
+                mDescriptor = desc;
+                mPlugins->CollectPlugins( pluginDescProvider, mDescriptor->PluginsCount, typesToCollect, apiVersion );
+            }
             else
             {
+                vector<shared_ptr<const XPluginDescriptor>> plugins;
+                vector<const PluginDescriptor*>             pluginDescriptors;
+
                 mDescriptor = desc;
-                mPlugins->CollectPlugins( pluginDescProvider, mDescriptor->PluginsCount, typesToCollect );
+
+                // all plug-ins are put into cache, no matter which types are collected now
+                for ( int32_t i = 0; i < mDescriptor->PluginsCount; i++ )
+                {
+                    PluginDescriptor* pluginDesc = pluginDescProvider( i );
+
+                    if ( pluginDesc != 0 )
+                    {
+                        pluginDescriptors.push_back( pluginDesc );
+                        plugins.push_back( XPluginDescriptor::Create( pluginDesc, apiVersion ) );
+                    }
+                }
+
+                manifestCache->PutModuleManifest( mFileName, mDescriptor, pluginDescriptors );
+
+                for ( size_t i = 0; i < plugins.size( ); i++ )
+                {
+                    if ( ( plugins[i]->Type( ) & typesToCollect ) != 0 )
+                    {
+                        mPlugins->Add( plugins[i] );
+                    }
+                }
             }
         }
     }
@@ -92,6 +148,98 @@ XErrorCode XPluginsModule::Load( PluginType typesToCollect )
     return retCode;
 }
 
+// Restore description of the module from manifest cache without loading it
+XErrorCode XPluginsModule::LoadManifest( const XPluginsManifestCache& manifestCache, PluginType typesToCollect )
+{
+    XErrorCode                       retCode = ErrorFailed;
+    ModuleDescriptor*                desc    = nullptr;
+    shared_ptr<const XManifestIcons> icons;
+    vector<XPluginManifest>          plugins;
+
+    if ( !manifestCache.GetModuleManifest( mFileName, &desc, &icons, plugins ) )
+    {
+        // not in the cache
+    }
+    else if ( desc == nullptr )
+    {
+        retCode = ErrorUnsupportedInterface;
+    }
+    else
+    {
+        mDescriptor = desc;
+        mIcons      = icons;
+        mIsRestored = true;
+
+        for ( vector<XPluginManifest>::iterator it = plugins.begin( ); it != plugins.end( ); ++it )
+        {
+            if ( ( it->Descriptor->Type & typesToCollect ) != 0 )
+            {
+                mPlugins->Add( XPluginDescriptor::CreateFromManifest( it->Descriptor, it->Icons, it->IsDynamic, this ) );
+            }
+            else
+            {
+                FreePluginDescriptor( &it->Descriptor );
+            }
+        }
+
+        retCode = SuccessCode;
+    }
+
+    return retCode;
+}
+
+// Load module restored from manifest cache, if it is not loaded yet
+void XPluginsModule::LoadOnDemand( )
+{
+    XScopedLock lock( &mLoadSync );
+
+    if ( ( mIsRestored ) && ( mModule == 0 ) && ( !mFailedLoading ) )
+    {
+        ModuleInitializeFunc moduleInitilizer   = 0;
+        GetDescriptorFunc    pluginDescProvider = 0;
+        ModuleDescriptor*    desc               = 0;
+        uint32_t             apiVersion         = PluginsApiVersion_Initial;
+
+        mModule = XModuleLoad( mFileName.c_str( ) );
+
+        if ( mModule != 0 )
+        {
+            moduleInitilizer   = (ModuleInitializeFunc) XModuleGetSymbol( mModule, ModuleInitializeFuncName );
+            pluginDescProvider = (GetDescriptorFunc) XModuleGetSymbol( mModule, GetDescriptorFuncName );
+            apiVersion         = ExchangeApiVersions( mModule );
+        }
+
+        if ( ( moduleInitilizer == 0 ) || ( pluginDescProvider == 0 ) || ( ( desc = moduleInitilizer( ) ) == 0 ) )
+        {
+            mFailedLoading = true;
+        }
+        else
+        {
+            for ( int32_t i = 0; i < desc->PluginsCount; i++ )
+            {
+                PluginDescriptor* pluginDesc = pluginDescProvider( i );
+
+                if ( pluginDesc != 0 )
+                {
+                    shared_ptr<const XPluginDescriptor> plugin = mPlugins->GetPlugin( XGuid( pluginDesc->ID ) );
+
+                    if ( ( plugin ) && ( plugin->mLoadedDescriptor == nullptr ) )
+                    {
+                        plugin->AttachLoadedDescriptor( pluginDesc, apiVersion );
+                    }
+                    else
+                    {
+                        FreePluginDescriptor( &pluginDesc );
+                    }
+                }
+            }
+
+            // description restored from the cache is kept, since it was already given out
+            FreeModuleDescriptor( &desc );
+        }
+    }
+}
+
 // Unload the module
 // TODO ?: For now module can be unloaded when its plug-ins are still in use, which will cause bad
 //         things to happen. Something may need to be done to avoid this from happening, if we want to
@@ -99,6 +247,17 @@ XErrorCode XPluginsModule::Load( PluginType typesToCollect )
 //
 void XPluginsModule::Unload( )
 {
+    if ( mIsRestored )
+    {
+        XScopedLock lock( &mLoadSync );
+
+        // plug-in descriptors may be still referenced by someone, so don't let them load the module after this point
+        for ( XPluginsCollection::ConstIterator it = mPlugins->begin( ); it != mPlugins->end( ); it++ )
+        {
+            ( *it )->mModule = nullptr;
+        }
+    }
+
     mPlugins->Clear( );
 
     if ( mDescriptor != &BlankModuleDescriptor )
@@ -164,8 +323,19 @@ const string XPluginsModule::Website( ) const
 
 const shared_ptr<const XImage> XPluginsModule::Icon( bool getSmall ) const
 {
-    return XImage::Create( const_cast<const ximage*>(
-        ( getSmall ) ? mDescriptor->SmallIcon : mDescriptor->Icon ) );
+    shared_ptr<const XImage> icon;
+
+    if ( mIcons )
+    {
+        icon = mIcons->Icon( getSmall );
+    }
+    else
+    {
+        icon = XImage::Create( const_cast<const ximage*>(
+            ( getSmall ) ? mDescriptor->SmallIcon : mDescriptor->Icon ) );
+    }
+
+    return icon;
 }
 
 // Get plug-in descriptor by its short name
@@ -32,13 +32,18 @@
 #include <XImage.hpp>
 #include <imodule.h>
 #include <xmodule.h>
+#include <XMutex.hpp>
 
 #include "XPluginsCollection.hpp"
 #include "XPluginDescriptor.hpp"
 
+class XPluginsManifestCache;
+
 // Class providing description of module containing plug-ins
 class XPluginsModule : private CVSandbox::Uncopyable
 {
+friend class XPluginDescriptor;
+
 private:
     XPluginsModule( const std::string& fileName );
 
@@ -48,8 +53,12 @@ public:
     // Create empty module descriptor without loading the specified module
     static const std::shared_ptr<XPluginsModule> Create( const std::string& fileName );
 
-    // Load the module
-    XErrorCode Load( PluginType typesToCollect = PluginType_All );
+    // Load the module. If manifest cache is given, description of all module's plug-ins is put into it.
+    XErrorCode Load( PluginType typesToCollect = PluginType_All, XPluginsManifestCache* manifestCache = nullptr );
+    // Restore description of the module from manifest cache without loading it. The module
+    // gets loaded when any of its plug-ins is instantiated or its dynamic properties are needed.
+    // Fails with ErrorUnsupportedInterface if the file is known not to be a plug-ins' module.
+    XErrorCode LoadManifest( const XPluginsManifestCache& manifestCache, PluginType typesToCollect = PluginType_All );
     // Unload the module
     void Unload( );
     // Check if the module is loaded
@@ -84,6 +93,10 @@ public:
     // Number of plug-in descriptors of the specified type
     size_t CountType( PluginType typeMask ) const;
 
+private:
+    // Load module restored from manifest cache, if it is not loaded yet
+    void LoadOnDemand( );
+
 private:
     static const ModuleDescriptor       BlankModuleDescriptor;
 
@@ -91,6 +104,11 @@ private:
     const std::string                   mFileName;
     std::shared_ptr<XPluginsCollection> mPlugins;
     ModuleDescriptor*                   mDescriptor;
+
+    std::shared_ptr<const XManifestIcons> mIcons;           // icons of module restored from manifest cache
+    bool                                  mIsRestored;      // module's description was restored from manifest cache
+    bool                                  mFailedLoading;   // failed loading module on demand, so don't try again
+    CVSandbox::Threading::XMutex          mLoadSync;
 };
 
 
@@ -32,6 +32,8 @@
 // Class which wraps description of a property
 class XPropertyDescriptor : private CVSandbox::Uncopyable
 {
+friend class XPluginDescriptor;
+
 private:
     XPropertyDescriptor( int32_t id, PropertyDescriptor* desc );
 
@@ -12,7 +12,7 @@ SRC = XCommunicationDevicePlugin.cpp \
 	XImageProcessingFilterPlugin.cpp XImageProcessingFilterPlugin2.cpp \
 	XImageProcessingPlugin.cpp \
 	XModulesCollection.cpp XPlugin.cpp XPluginWrapperFactory.cpp XPluginDescriptor.cpp \
-	XPluginsCollection.cpp XPluginsEngine.cpp XPluginsModule.cpp \
+	XPluginsCollection.cpp XPluginsEngine.cpp XPluginsManifestCache.cpp XPluginsModule.cpp \
 	XPropertyDescriptor.cpp \
 	XScriptingEnginePlugin.cpp \
 	XVideoProcessingPlugin.cpp XVideoSourcePlugin.cpp
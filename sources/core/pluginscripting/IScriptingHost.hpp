@@ -25,6 +25,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <xtypes.h>
 #include <XVersion.hpp>
 #include <XVariant.hpp>
@@ -52,11 +53,14 @@ public:
     virtual XErrorCode GetVariable( const std::string& name, CVSandbox::XVariant& value ) const = 0;
     virtual XErrorCode SetVariable( const std::string& name, const CVSandbox::XVariant& value ) = 0;
 
-    virtual XErrorCode GetVariable( const std::string& name, std::shared_ptr<CVSandbox::XImage>& value ) const = 0;
-    virtual XErrorCode SetVariable( const std::string& name, const std::shared_ptr<CVSandbox::XImage>& value ) = 0;
+    virtual XErrorCode GetVariable( const std::string& name, std::shared_ptr<const CVSandbox::XImage>& value ) const = 0;
+    virtual XErrorCode SetVariable( const std::string& name, const std::shared_ptr<const CVSandbox::XImage>& value ) = 0;
 
     virtual XErrorCode GetVideoSource( std::shared_ptr<const XPluginDescriptor>& descriptor,
                                        std::shared_ptr<XPlugin>& plugin ) const = 0;
+
+    // Get histograms of the current image as arrays of 256 values (1 for grayscale image or 3 for color image)
+    virtual XErrorCode GetImageHistograms( std::vector<CVSandbox::XVariant>& histograms ) const = 0;
 };
 
 #endif // CVS_ISCRIPTING_HOST_HPP
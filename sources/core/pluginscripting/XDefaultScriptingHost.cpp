@@ -263,7 +263,8 @@ XErrorCode XDefaultScriptingHost::SetVariable( const string& name, const XVarian
     return SuccessCode;
 }
 
-XErrorCode XDefaultScriptingHost::GetVariable( const string& name, shared_ptr<XImage>& value ) const
+// Stored image is given by reference - the caller must not change it
+XErrorCode XDefaultScriptingHost::GetVariable( const string& name, shared_ptr<const XImage>& value ) const
 {
     value.reset( );
 
@@ -271,13 +272,13 @@ XErrorCode XDefaultScriptingHost::GetVariable( const string& name, shared_ptr<XI
 
     if ( it != mData->ImageVariables.end( ) )
     {
-        value = it->second->Clone( );
+        value = it->second;
     }
 
     return SuccessCode;
 }
 
-XErrorCode XDefaultScriptingHost::SetVariable( const string& name, const shared_ptr<XImage>& value )
+XErrorCode XDefaultScriptingHost::SetVariable( const string& name, const shared_ptr<const XImage>& value )
 {
     if ( !value )
     {
@@ -291,10 +292,15 @@ XErrorCode XDefaultScriptingHost::SetVariable( const string& name, const shared_
         {
             mData->ImageVariables.insert( pair<string, shared_ptr<XImage> >( name, value->Clone( ) ) );
         }
-        else
+        else if ( it->second.use_count( ) == 1 )
         {
             value->CopyDataOrClone( it->second );
         }
+        else
+        {
+            // previous image is still referenced by someone, so it is replaced instead of being overwritten
+            it->second = value->Clone( );
+        }
     }
 
     // remove any variant variable with such name
@@ -311,3 +317,11 @@ XErrorCode XDefaultScriptingHost::GetVideoSource( shared_ptr<const XPluginDescri
 
     return ErrorNotImplemented;
 }
+
+// Get histograms of the current image - not supported, since the image is loaded from file on every request
+XErrorCode XDefaultScriptingHost::GetImageHistograms( vector<XVariant>& histograms ) const
+{
+    histograms.clear( );
+
+    return ErrorNotImplemented;
+}
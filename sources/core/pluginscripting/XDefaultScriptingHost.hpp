@@ -58,12 +58,14 @@ public:
     virtual XErrorCode GetVariable( const std::string& name, CVSandbox::XVariant& value ) const;
     virtual XErrorCode SetVariable( const std::string& name, const CVSandbox::XVariant& value );
 
-    virtual XErrorCode GetVariable( const std::string& name, std::shared_ptr<CVSandbox::XImage>& value ) const;
-    virtual XErrorCode SetVariable( const std::string& name, const std::shared_ptr<CVSandbox::XImage>& value );
+    virtual XErrorCode GetVariable( const std::string& name, std::shared_ptr<const CVSandbox::XImage>& value ) const;
+    virtual XErrorCode SetVariable( const std::string& name, const std::shared_ptr<const CVSandbox::XImage>& value );
 
     virtual XErrorCode GetVideoSource( std::shared_ptr<const XPluginDescriptor>& descriptor,
                                        std::shared_ptr<XPlugin>& plugin ) const;
 
+    virtual XErrorCode GetImageHistograms( std::vector<CVSandbox::XVariant>& histograms ) const;
+
 private:
     Private::XDefaultScriptingHostData* mData;
 };
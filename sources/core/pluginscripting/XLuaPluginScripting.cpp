@@ -37,7 +37,7 @@ using namespace CVSandbox;
 namespace Private
 {
     static const char   LuaRegistryKey       = 'k';
-    static const int    LuaScriptingRevision = 8;
+    static const int    LuaScriptingRevision = 9;
 
     class XLuaPluginScriptingData
     {
@@ -303,7 +303,7 @@ namespace Private
             }
             else
             {
-                shared_ptr<XImage> imageValue;
+                shared_ptr<const XImage> imageValue;
 
                 // try getting image with the specified name
                 ret = host->GetVariable( variableName, imageValue );
@@ -320,7 +320,7 @@ namespace Private
                     }
                     else
                     {
-                        PutImageOnLuaStack( luaState, imageValue );
+                        PutSharedImageOnLuaStack( luaState, imageValue );
                     }
                 }
             }
@@ -338,7 +338,7 @@ namespace Private
 
         if ( IsImageOnLuaStack( luaState, 2 ) )
         {
-            XErrorCode ret = host->SetVariable( variableName, GetImageFromLuaStack( luaState, 2 ) );
+            XErrorCode ret = host->SetVariable( variableName, GetConstImageFromLuaStack( luaState, 2 ) );
 
             if ( ret != SuccessCode )
             {
@@ -396,6 +396,32 @@ namespace Private
         return ret;
     }
 
+    static int HostGetImageHistograms( lua_State* luaState )
+    {
+        CheckArgumentsCount( luaState, 0 );
+
+        vector<XVariant> histograms;
+        XErrorCode       errorCode = GetHostFromLuaRegistry( luaState )->GetImageHistograms( histograms );
+        int              ret       = 0;
+
+        if ( errorCode != SuccessCode )
+        {
+            ReportXError( luaState, errorCode );
+        }
+        else
+        {
+            // one histogram for grayscale image, or red/green/blue histograms for color image
+            for ( const XVariant& histogram : histograms )
+            {
+                PushXVariantToLuaStack( luaState, histogram );
+            }
+
+            ret = static_cast<int>( histograms.size( ) );
+        }
+
+        return ret;
+    }
+
     static const struct luaL_Reg HostLibrary[] =
     {
         { "Name",                   HostName                 },
@@ -407,6 +433,7 @@ namespace Private
         { "GetVariable",            HostGetVariable          },
         { "SetVariable",            HostSetVariable          },
         { "GetVideoSource",         HostGetVideoSource       },
+        { "GetImageHistograms",     HostGetImageHistograms   },
         { nullptr,                  nullptr                  }
     };
 
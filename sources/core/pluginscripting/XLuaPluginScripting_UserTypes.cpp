@@ -98,21 +98,30 @@ class ImageShell
 {
 public:
     ImageShell( const std::shared_ptr<XImage>& image ) :
-        Image( image )
+        Image( image ), SharedImage( )
+    {
+    }
+
+    ImageShell( const std::shared_ptr<const XImage>& sharedImage ) :
+        Image( ), SharedImage( sharedImage )
     {
     }
 
     void Release( )
     {
         Image.reset( );
+        SharedImage.reset( );
     }
 
     bool IsReleased( )
     {
-        return ( !Image );
+        return ( ( !Image ) && ( !SharedImage ) );
     }
 
-    std::shared_ptr<XImage> Image;
+    // Image owned by script
+    std::shared_ptr<XImage>         Image;
+    // Image shared with host, which is copied only when script needs to change it
+    std::shared_ptr<const XImage>   SharedImage;
 };
 
 // ===== Internal helper API =====
@@ -1509,10 +1518,10 @@ static int PluginImageProcessingFilter_ProcessImage( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 2 );
 
-    PluginShell*        pluginShell = GetPluginShellFromLuaStack( luaState, 1, METATABLE_IMAGE_PROCESSING_FILTER_PLUGIN );
-    shared_ptr<XImage>  image       = GetImageFromLuaStack( luaState, 2 );
-    shared_ptr<XImage>  outputImage;
-    XErrorCode          errorCode   = static_pointer_cast<XImageProcessingFilterPlugin>( pluginShell->Plugin )->ProcessImage( image, outputImage );
+    PluginShell*             pluginShell = GetPluginShellFromLuaStack( luaState, 1, METATABLE_IMAGE_PROCESSING_FILTER_PLUGIN );
+    shared_ptr<const XImage> image       = GetConstImageFromLuaStack( luaState, 2 );
+    shared_ptr<XImage>       outputImage;
+    XErrorCode               errorCode   = static_pointer_cast<XImageProcessingFilterPlugin>( pluginShell->Plugin )->ProcessImage( image, outputImage );
 
     if ( errorCode != SuccessCode )
     {
@@ -2201,7 +2210,18 @@ void PutImageOnLuaStack( lua_State* luaState, const shared_ptr<XImage>& image )
     *imageShell = new ImageShell( image );
 }
 
-// Get image from Lua stack
+// Put image shared with host on Lua stack - it is copied on the first attempt to change it
+void PutSharedImageOnLuaStack( lua_State* luaState, const shared_ptr<const XImage>& image )
+{
+    ImageShell** imageShell = (ImageShell**) lua_newuserdata( luaState, sizeof( ImageShell* ) );
+
+    luaL_getmetatable( luaState, METATABLE_IMAGE );
+    lua_setmetatable( luaState, -2 );
+
+    *imageShell = new ImageShell( image );
+}
+
+// Get image from Lua stack (image shared with host is replaced with its copy, so it can be changed)
 const shared_ptr<XImage> GetImageFromLuaStack( lua_State* luaState, int stackIndex )
 {
     ImageShell*  imageShell = *(ImageShell**) luaL_checkudata( luaState, stackIndex, METATABLE_IMAGE );
@@ -2211,9 +2231,34 @@ const shared_ptr<XImage> GetImageFromLuaStack( lua_State* luaState, int stackInd
         ReportError( luaState, STR_ERROR_RELEASED_OBJECT );
     }
 
+    if ( !imageShell->Image )
+    {
+        imageShell->Image = imageShell->SharedImage->Clone( );
+
+        if ( !imageShell->Image )
+        {
+            ReportXError( luaState, ErrorOutOfMemory );
+        }
+
+        imageShell->SharedImage.reset( );
+    }
+
     return imageShell->Image;
 }
 
+// Get image from Lua stack for reading only (image shared with host is not copied)
+const shared_ptr<const XImage> GetConstImageFromLuaStack( lua_State* luaState, int stackIndex )
+{
+    ImageShell*  imageShell = *(ImageShell**) luaL_checkudata( luaState, stackIndex, METATABLE_IMAGE );
+
+    if ( imageShell->IsReleased( ) )
+    {
+        ReportError( luaState, STR_ERROR_RELEASED_OBJECT );
+    }
+
+    return ( imageShell->Image ) ? imageShell->Image : imageShell->SharedImage;
+}
+
 // Check if Lua stack contains image at the specified index
 bool IsImageOnLuaStack( lua_State* luaState, int stackIndex )
 {
@@ -2256,7 +2301,7 @@ static int Image_Width( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 1 );
 
-    shared_ptr<XImage> image = GetImageFromLuaStack( luaState, 1 );
+    shared_ptr<const XImage> image = GetConstImageFromLuaStack( luaState, 1 );
 
     lua_pushinteger( luaState, image->Width( ) );
 
@@ -2268,7 +2313,7 @@ static int Image_Height( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 1 );
 
-    shared_ptr<XImage> image = GetImageFromLuaStack( luaState, 1 );
+    shared_ptr<const XImage> image = GetConstImageFromLuaStack( luaState, 1 );
 
     lua_pushinteger( luaState, image->Height( ) );
 
@@ -2280,8 +2325,8 @@ static int Image_PixelFormat( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 1 );
 
-    shared_ptr<XImage> image          = GetImageFromLuaStack( luaState, 1 );
-    xstring            strPixelFormat = XImageGetPixelFormatShortName( image->Format( ) );
+    shared_ptr<const XImage> image          = GetConstImageFromLuaStack( luaState, 1 );
+    xstring                  strPixelFormat = XImageGetPixelFormatShortName( image->Format( ) );
 
     if ( strPixelFormat == nullptr )
     {
@@ -2301,7 +2346,7 @@ static int Image_BitsPerPixel( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 1 );
 
-    shared_ptr<XImage> image = GetImageFromLuaStack( luaState, 1 );
+    shared_ptr<const XImage> image = GetConstImageFromLuaStack( luaState, 1 );
 
     lua_pushinteger( luaState, XImageBitsPerPixel( image->Format( ) ) );
 
@@ -2313,8 +2358,8 @@ static int Image_Clone( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 1 );
 
-    shared_ptr<XImage> image       = GetImageFromLuaStack( luaState, 1 );
-    shared_ptr<XImage> clonedImage = image->Clone( );
+    shared_ptr<const XImage> image       = GetConstImageFromLuaStack( luaState, 1 );
+    shared_ptr<XImage>       clonedImage = image->Clone( );
 
     if ( !clonedImage )
     {
@@ -2370,10 +2415,10 @@ static int Image_PutImage( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 4 );
 
-    shared_ptr<XImage> dstImage = GetImageFromLuaStack( luaState, 1 );
-    shared_ptr<XImage> srcImage = GetImageFromLuaStack( luaState, 2 );
-    int                x        = static_cast<int>( luaL_checkinteger( luaState, 3 ) );
-    int                y        = static_cast<int>( luaL_checkinteger( luaState, 4 ) );
+    shared_ptr<XImage>       dstImage = GetImageFromLuaStack( luaState, 1 );
+    shared_ptr<const XImage> srcImage = GetConstImageFromLuaStack( luaState, 2 );
+    int                      x        = static_cast<int>( luaL_checkinteger( luaState, 3 ) );
+    int                      y        = static_cast<int>( luaL_checkinteger( luaState, 4 ) );
 
     XErrorCode  ec = dstImage->PutImage( srcImage, x, y );
 
@@ -2390,11 +2435,11 @@ static int Image_GetPixel( lua_State* luaState )
 {
     CheckArgumentsCount( luaState, 3 );
 
-    shared_ptr<XImage> srcImage = GetImageFromLuaStack( luaState, 1 );
-    int                x        = static_cast<int>( luaL_checkinteger( luaState, 2 ) );
-    int                y        = static_cast<int>( luaL_checkinteger( luaState, 3 ) );
-    int                ret      = 0;
-    xargb              color;
+    shared_ptr<const XImage> srcImage = GetConstImageFromLuaStack( luaState, 1 );
+    int                      x        = static_cast<int>( luaL_checkinteger( luaState, 2 ) );
+    int                      y        = static_cast<int>( luaL_checkinteger( luaState, 3 ) );
+    int                      ret      = 0;
+    xargb                    color;
 
     XErrorCode ec = XImageGetPixelColor( srcImage->ImageData( ), x, y, &color );
 
@@ -41,8 +41,12 @@ void RegisterLuaUserDataTypes( lua_State* luaState );
 
 // Put image on Lua stack
 void PutImageOnLuaStack( lua_State* luaState, const std::shared_ptr<CVSandbox::XImage>& image );
+// Put image shared with host on Lua stack
+void PutSharedImageOnLuaStack( lua_State* luaState, const std::shared_ptr<const CVSandbox::XImage>& image );
 // Get image from Lua stack
 const std::shared_ptr<CVSandbox::XImage> GetImageFromLuaStack( lua_State* luaState, int stackIndex );
+// Get image from Lua stack for reading only
+const std::shared_ptr<const CVSandbox::XImage> GetConstImageFromLuaStack( lua_State* luaState, int stackIndex );
 // Check if Lua stack contains image at the specified index
 bool IsImageOnLuaStack( lua_State* luaState, int stackIndex );
 
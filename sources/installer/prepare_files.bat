@@ -33,7 +33,7 @@ xcopy "%QT_MINGW_BIN%\..\plugins\platforms\qwindows.dll" .\Files\platforms
 @rem  3 - Copy main plug-ins
 set TO_COPY=cv_bar_codes cv_glyphs dev_com dev_sysinfo fmt_jpeg fmt_png ip_blobs_processing ^
             ip_effects ip_stdimaging ip_tools vp_ffmpeg_io vs_dshow vs_ffmpeg ^
-            vs_image_folder vs_mjpeg vs_repeater vs_screen_cap
+            vs_image_folder vs_mjpeg vs_raw_frames vs_repeater vs_screen_cap
 mkdir .\Files\cvsplugins
 for %%F in (%TO_COPY%) do (
     mkdir ".\Files\cvsplugins\%%F"
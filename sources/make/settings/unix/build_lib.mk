@@ -0,0 +1,26 @@
+# Static library build steps valid for Unix (Linux + GCC) environment
+
+SELF_DIR := $(dir $(lastword $(MAKEFILE_LIST)))
+
+OUT_FOLDER = $(SELF_DIR)../../../../build/$(TARGET)/$(BUILD_TYPE)/lib/
+
+CFLAGS += $(INCLUDES)
+
+all: build
+
+debug: build
+
+%.o: $(SRC_FILE_EXT)
+	$(COMPILER) $(CFLAGS) -c $< -o $@
+
+$(OUT): $(OBJ)
+	$(ARCHIVER) rcs $(OUT) $(OBJ)
+
+build: $(OUT)
+	mkdir -p $(OUT_FOLDER)
+	cp $(OUT) $(OUT_FOLDER)
+
+clean:
+	rm -f $(OBJ) $(OUT)
+
+.PHONY: all debug build clean
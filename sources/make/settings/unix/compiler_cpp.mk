@@ -0,0 +1,25 @@
+# Unix (Linux + GCC) compiler common settings
+
+TARGET = unix
+SRC_FILE_EXT = %.cpp
+
+OBJ = $(SRC:.cpp=.o)
+
+# compiler
+COMPILER ?= g++
+# lib archiver
+ARCHIVER ?= ar
+
+# position independent code, so the libraries could be linked into plug-in modules as well
+CFLAGS += -Wall -fPIC -std=gnu++0x -fno-rtti
+
+# compiler options
+ifneq "$(findstring debug, $(MAKECMDGOALS))" ""
+# "Debug" build - no optimization, and debugging symbols 
+CFLAGS += -O0 -g
+BUILD_TYPE = debug
+else 
+# "Release" build - optimization, and no debug symbols 
+CFLAGS += -O3 -s -DNDEBUG
+BUILD_TYPE = release
+endif
@@ -0,0 +1,15 @@
+#!/bin/sh
+
+# Build CVSandbox headless server and the libraries it depends on
+set -e
+
+MY_FOLDER=$(cd "$(dirname "$0")" && pwd)
+
+for FOLDER in ../../afx/make/unix ../../core/make/unix
+do
+    make -C "$MY_FOLDER/$FOLDER"
+done
+
+cd "$MY_FOLDER/../../apps/cvsandbox_server"
+qmake CONFIG+=release cvsandbox_server.pro
+make
@@ -27,7 +27,7 @@ using namespace std;
 // List of supported pixel formats
 const XPixelFormat TwoFramesDifferenceDetectionPlugin::supportedPixelFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatYUV420, XPixelFormatNV12
 };
 
 namespace Private
@@ -182,16 +182,28 @@ XErrorCode TwoFramesDifferenceDetectionPlugin::GetSupportedPixelFormats( XPixelF
 }
 
 // Process the specified video frame
-XErrorCode TwoFramesDifferenceDetectionPlugin::ProcessImage( ximage* src )
+XErrorCode TwoFramesDifferenceDetectionPlugin::ProcessImage( ximage* image )
 {
-    XErrorCode ret = ErrorFailed;
+    XErrorCode ret     = ErrorFailed;
+    ximage*    src     = image;
+    ximage*    ownView = nullptr;
 
     // reset previous detected motion level
     mData->MotionLevel = 0.0f;
 
+    // for planar YUV images only luminance plane is used, which is a grayscale image already
+    if ( ( image != nullptr ) && ( XImageIsPixelFormatPlanar( image->format ) ) )
+    {
+        ret = XImageGetPlane( image, &ownView, 0 );
+        src = ownView;
+    }
+
     if ( src == nullptr )
     {
-        ret = ErrorNullParameter;
+        if ( image == nullptr )
+        {
+            ret = ErrorNullParameter;
+        }
     }
     else
     {
@@ -240,6 +252,8 @@ XErrorCode TwoFramesDifferenceDetectionPlugin::ProcessImage( ximage* src )
         }
     }
 
+    XImageFree( &ownView );
+
     return ret;
 }
 
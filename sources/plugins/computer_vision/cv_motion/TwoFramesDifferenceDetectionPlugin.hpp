@@ -49,7 +49,7 @@ public:
     // Get pixel formats supported by the plug-in
     XErrorCode GetSupportedPixelFormats( XPixelFormat* pixelFormats, int32_t* count );
     // Process the specified image
-    XErrorCode ProcessImage( ximage* src );
+    XErrorCode ProcessImage( ximage* image );
     // Check if the plug-in triggered detection on the last processed image
     bool Detected( );
     // Reset run time state of the plug-in
@@ -19,6 +19,9 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+// The plug-in uses keyboard state provided by Windows API, so it is not available on other platforms
+#ifdef WIN32
+
 #include <windows.h>
 #include "LedKeysPlugin.hpp"
 
@@ -98,3 +101,5 @@ XErrorCode LedKeysPlugin::SetProperty( int32_t id, const xvariant* value )
 
     return ret;
 }
+
+#endif // WIN32
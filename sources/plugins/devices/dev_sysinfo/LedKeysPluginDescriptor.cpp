@@ -19,6 +19,9 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+// The plug-in is registered on Windows only (see LedKeysPlugin.cpp)
+#ifdef WIN32
+
 #include <iplugincpp.hpp>
 #include "LedKeysPlugin.hpp"
 
@@ -73,3 +76,5 @@ REGISTER_CPP_PLUGIN_WITH_PROPS
     0, // no clean-up
     0  // no dynamic properties update
 );
+
+#endif // WIN32
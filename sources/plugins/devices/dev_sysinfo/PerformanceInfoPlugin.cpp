@@ -19,11 +19,18 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+// Windows implementation of the plug-in, which is based on PDH counters (see PerformanceInfoPlugin_Linux.cpp for Linux)
+#ifdef WIN32
+
 #include <windows.h>
 #include <pdh.h>
 #include <pdhmsg.h>
+#include <psapi.h>
 #include "PerformanceInfoPlugin.hpp"
 
+// Number of the plug-in's properties
+#define PROPERTIES_COUNT (12)
+
 namespace Private
 {
     class PerformanceInfoPluginData
@@ -32,15 +39,23 @@ namespace Private
         PerformanceInfoPluginData( ) :
             ProcessorsCount( 0 ),
             PerformanceQuery( INVALID_HANDLE_VALUE ),
-            SystemLoadCounter( INVALID_HANDLE_VALUE )
+            SystemLoadCounter( INVALID_HANDLE_VALUE ),
+            LastProcessTime( 0 ),
+            LastSystemTime( 0 )
         {
         }
 
+        // Get CPU time used by the current process and the system time it was measured at
+        void GetProcessTimes( ULONGLONG* processTime, ULONGLONG* systemTime );
+
     public:
         DWORD       ProcessorsCount;
 
         HQUERY      PerformanceQuery;
         HCOUNTER    SystemLoadCounter;
+
+        ULONGLONG   LastProcessTime;
+        ULONGLONG   LastSystemTime;
     };
 }
 
@@ -80,6 +95,7 @@ XErrorCode PerformanceInfoPlugin::Connect( )
 
         // do initial query
         PdhCollectQueryData( data->PerformanceQuery );
+        data->GetProcessTimes( &data->LastProcessTime, &data->LastSystemTime );
 
         isConnected = true;
         ret = SuccessCode;
@@ -124,13 +140,17 @@ XErrorCode PerformanceInfoPlugin::GetProperty( int32_t id, xvariant* value ) con
     {
         ret = ErrorNotConnected;
     }
-    else if ( ( id < 0 ) || ( id > 1 ) )
+    else if ( ( id < 0 ) || ( id >= PROPERTIES_COUNT ) )
     {
         ret = ErrorInvalidProperty;
     }
     else
     {
         PDH_FMT_COUNTERVALUE    counterValue;
+        MEMORYSTATUSEX          memoryStatus = { sizeof( MEMORYSTATUSEX ) };
+        PROCESS_MEMORY_COUNTERS processMemory = { sizeof( PROCESS_MEMORY_COUNTERS ) };
+        ULONGLONG               processTime, systemTime;
+        DWORD_PTR               processMask, systemMask;
 
         if ( id == 1 )
         {
@@ -160,6 +180,69 @@ XErrorCode PerformanceInfoPlugin::GetProperty( int32_t id, xvariant* value ) con
                     value->value.fVal = static_cast<float>( counterValue.doubleValue );
                 }
                 break;
+
+            case 3:
+                data->GetProcessTimes( &processTime, &systemTime );
+
+                value->type = XVT_R4;
+                value->value.fVal = 0;
+
+                if ( systemTime > data->LastSystemTime )
+                {
+                    value->value.fVal = static_cast<float>( 100.0 * ( processTime - data->LastProcessTime ) /
+                                                            ( systemTime - data->LastSystemTime ) / data->ProcessorsCount );
+                }
+
+                data->LastProcessTime = processTime;
+                data->LastSystemTime  = systemTime;
+                break;
+
+            case 4:
+                value->type = XVT_R4;
+                value->value.fVal = static_cast<float>( data->ProcessorsCount );
+
+                if ( GetProcessAffinityMask( GetCurrentProcess( ), &processMask, &systemMask ) )
+                {
+                    uint32_t cpus = 0;
+
+                    for ( ; processMask != 0; processMask &= processMask - 1 )
+                    {
+                        cpus++;
+                    }
+
+                    value->value.fVal = static_cast<float>( cpus );
+                }
+                break;
+
+            case 5:
+            case 6:
+                if ( !GlobalMemoryStatusEx( &memoryStatus ) )
+                {
+                    ret = ErrorFailed;
+                }
+                else
+                {
+                    value->type = XVT_U4;
+                    value->value.uiVal = static_cast<uint32_t>( ( ( id == 5 ) ? memoryStatus.ullTotalPhys : memoryStatus.ullAvailPhys ) >> 20 );
+                }
+                break;
+
+            case 7:
+                if ( !GetProcessMemoryInfo( GetCurrentProcess( ), &processMemory, sizeof( processMemory ) ) )
+                {
+                    ret = ErrorFailed;
+                }
+                else
+                {
+                    value->type = XVT_U4;
+                    value->value.uiVal = static_cast<uint32_t>( processMemory.WorkingSetSize >> 20 );
+                }
+                break;
+
+            default:
+                // per core, context switches and threads' counters are not provided on Windows yet
+                ret = ErrorNotImplemented;
+                break;
             }
         }
     }
@@ -179,7 +262,7 @@ XErrorCode PerformanceInfoPlugin::SetProperty( int32_t id, const xvariant* value
     {
         ret = ErrorNotConnected;
     }
-    else if ( ( id < 0 ) || ( id > 1 ) )
+    else if ( ( id < 0 ) || ( id >= PROPERTIES_COUNT ) )
     {
         ret = ErrorInvalidProperty;
     }
@@ -190,3 +273,24 @@ XErrorCode PerformanceInfoPlugin::SetProperty( int32_t id, const xvariant* value
 
     return ret;
 }
+
+namespace Private
+{
+    // Get CPU time used by the current process and the system time it was measured at (both in 100ns units)
+    void PerformanceInfoPluginData::GetProcessTimes( ULONGLONG* processTime, ULONGLONG* systemTime )
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime, nowTime;
+
+        GetSystemTimeAsFileTime( &nowTime );
+        *systemTime  = ( static_cast<ULONGLONG>( nowTime.dwHighDateTime ) << 32 ) | nowTime.dwLowDateTime;
+        *processTime = 0;
+
+        if ( ::GetProcessTimes( GetCurrentProcess( ), &creationTime, &exitTime, &kernelTime, &userTime ) )
+        {
+            *processTime = ( ( static_cast<ULONGLONG>( kernelTime.dwHighDateTime ) << 32 ) | kernelTime.dwLowDateTime ) +
+                           ( ( static_cast<ULONGLONG>( userTime.dwHighDateTime ) << 32 ) | userTime.dwLowDateTime );
+        }
+    }
+}
+
+#endif // WIN32
@@ -25,7 +25,7 @@
 static void PluginInitializer( );
 
 // Version of the plug-in
-static xversion PluginVersion = { 1, 0, 0 };
+static xversion PluginVersion = { 1, 1, 0 };
 
 // ID of the plug-in
 static xguid PluginID = { 0xAF000003, 0x00000000, 0x0000000A, 0x00000003 };
@@ -36,11 +36,43 @@ static PropertyDescriptor processorsCountProperty =
 // System Load property
 static PropertyDescriptor systemLoadProperty =
 { XVT_R4, "System Load", "systemLoad", "Total CPU(s) load, %.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Cores Load property
+static PropertyDescriptor coresLoadProperty =
+{ XVT_R4 | XVT_Array, "Cores Load", "coresLoad", "Load of each CPU/core, %.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Process Load property
+static PropertyDescriptor processLoadProperty =
+{ XVT_R4, "Process Load", "processLoad", "CPU load caused by the current process, % of all CPU(s).", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// CPU Limit property
+static PropertyDescriptor cpuLimitProperty =
+{ XVT_R4, "CPU Limit", "cpuLimit", "Number of CPUs the process is allowed to use (affinity and container limits are taken into account).", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Total Memory property
+static PropertyDescriptor totalMemoryProperty =
+{ XVT_U4, "Total Memory", "totalMemory", "Total physical memory, MB.", PropertyFlag_ReadOnly };
+// Available Memory property
+static PropertyDescriptor availableMemoryProperty =
+{ XVT_U4, "Available Memory", "availableMemory", "Physical memory available for starting new applications, MB.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Process Memory property
+static PropertyDescriptor processMemoryProperty =
+{ XVT_U4, "Process Memory", "processMemory", "Physical memory used by the current process, MB.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Context Switches property
+static PropertyDescriptor contextSwitchesProperty =
+{ XVT_R4, "Context Switches", "contextSwitches", "Number of context switches per second in the system.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Process Context Switches property
+static PropertyDescriptor processContextSwitchesProperty =
+{ XVT_R4, "Process Context Switches", "processContextSwitches", "Number of context switches per second of the current process's threads.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Thread Names property
+static PropertyDescriptor threadNamesProperty =
+{ XVT_String | XVT_Array, "Thread Names", "threadNames", "Names of the current process's threads.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Threads Load property
+static PropertyDescriptor threadsLoadProperty =
+{ XVT_R4 | XVT_Array, "Threads Load", "threadsLoad", "CPU load of the current process's threads (in the order of their names), % of a single CPU.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
 
 // Array of available properties
 static PropertyDescriptor* pluginProperties[] =
 {
-    &processorsCountProperty, &systemLoadProperty
+    &processorsCountProperty, &systemLoadProperty, &coresLoadProperty, &processLoadProperty, &cpuLimitProperty,
+    &totalMemoryProperty, &availableMemoryProperty, &processMemoryProperty,
+    &contextSwitchesProperty, &processContextSwitchesProperty, &threadNamesProperty, &threadsLoadProperty
 };
 
 // Let the class itself know description of its properties
@@ -58,8 +90,13 @@ REGISTER_CPP_PLUGIN_WITH_PROPS
     "PerformanceInfo",
     "Provides information about system performance.",
 
-    "The plug-in provides system's performance information, like number of CPU/cores available in the system "
-    "and total CPU load.",
+    "The plug-in provides system's performance information, like number of CPU/cores available in the system, "
+    "total and per core CPU load, CPU load of the current process and its threads, memory usage and rate of context switches. "
+    "Loads are calculated for the time passed since the previous reading of the same counter, so it is best to read them "
+    "at regular intervals.<br><br>"
+    "Threads of automation server are named after their role: <b>cvs-source</b> (video sources), <b>cvs-processing</b> "
+    "(video processing graphs) and <b>cvs-script</b> (scripting threads). Per core load, context switches and threads' "
+    "information are available on Linux only.",
     0,
     0,
     PerformanceInfoPlugin,
@@ -80,4 +117,10 @@ static void PluginInitializer( )
 
     systemLoadProperty.MaxValue.type = XVT_R4;
     systemLoadProperty.MaxValue.value.fVal = 100;
+
+    processLoadProperty.MinValue.type = XVT_R4;
+    processLoadProperty.MinValue.value.fVal = 0;
+
+    processLoadProperty.MaxValue.type = XVT_R4;
+    processLoadProperty.MaxValue.value.fVal = 100;
 }
@@ -0,0 +1,846 @@
+/*
+    System Info plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+// Linux implementation of the plug-in, which reads counters from /proc and cgroup file systems
+#ifdef __linux__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "PerformanceInfoPlugin.hpp"
+#include "ProcStatParser.hpp"
+
+using namespace std;
+
+// Number of the plug-in's properties
+#define PROPERTIES_COUNT (12)
+// Minimum time between two samples of the same counters, ns (reading related properties in a row gives consistent values)
+#define MIN_SAMPLE_INTERVAL (100000000ull)
+
+namespace Private
+{
+    // Location of cgroup the process belongs to
+    struct CgroupLocation
+    {
+        string MountPoint;
+        string Path;
+        bool   IsV2;
+
+        CgroupLocation( const string& mountPoint, const string& path, bool isV2 ) :
+            MountPoint( mountPoint ), Path( path ), IsV2( isV2 ) { }
+    };
+
+    // CPU time spent by a CPU/core, in clock ticks
+    struct CpuTimes
+    {
+        uint64_t Total;
+        uint64_t Idle;
+
+        CpuTimes( ) : Total( 0 ), Idle( 0 ) { }
+    };
+
+    class PerformanceInfoPluginData
+    {
+    public:
+        PerformanceInfoPluginData( ) :
+            ProcessorsCount( 0 ), TicksPerSecond( 100 ),
+            SystemStatFile( -1 ), MemoryInfoFile( -1 ), ProcessStatFile( -1 ), ProcessMemoryFile( -1 ),
+            Buffer( 4096 ),
+            SystemSampleTime( 0 ), SystemTimes( ), ContextSwitches( 0 ),
+            SystemLoad( 0 ), CoresLoad( ), ContextSwitchesRate( 0 ),
+            ProcessSampleTime( 0 ), ProcessTicks( 0 ), ProcessContextSwitches( 0 ),
+            ProcessLoad( 0 ), ProcessContextSwitchesRate( 0 ),
+            ThreadsSampleTime( 0 ), ThreadsTicks( ), ThreadNames( ), ThreadsLoad( ),
+            CgroupCpuLimit( 0 )
+        {
+            // cgroup of the process is not expected to change, so its files are read only once
+            CgroupCpuLimit = GetCgroupCpuLimit( );
+        }
+
+        bool Open( );
+        void Close( );
+
+        // Update system wide CPU load and context switches rate
+        bool UpdateSystemCounters( bool force = false );
+        // Update CPU load and context switches rate of the current process
+        bool UpdateProcessCounters( bool force = false );
+        // Update names and CPU load of the current process's threads
+        bool UpdateThreadsCounters( bool force = false );
+
+        // Get total/available physical memory, MB
+        bool GetSystemMemory( uint32_t* totalMemory, uint32_t* availableMemory );
+        // Get physical memory used by the current process, MB
+        bool GetProcessMemory( uint32_t* processMemory );
+        // Get number of CPUs the process can use
+        float GetCpuLimit( );
+
+    private:
+        // Read content of an opened /proc file as zero terminated string
+        bool ReadFile( int file );
+        // Open, read and close the specified file
+        bool ReadFile( const char* fileName );
+        // Get CPU limit set by cgroup the process belongs to (0 if no limit)
+        float GetCgroupCpuLimit( );
+        // Read CPU limit of the specified cgroup (0 if no limit)
+        float ReadCgroupCpuLimit( const string& dir, bool isV2 );
+
+    public:
+        uint32_t            ProcessorsCount;
+        long                TicksPerSecond;
+
+    private:
+        int                 SystemStatFile;
+        int                 MemoryInfoFile;
+        int                 ProcessStatFile;
+        int                 ProcessMemoryFile;
+        vector<char>        Buffer;
+
+        uint64_t            SystemSampleTime;
+        vector<CpuTimes>    SystemTimes;        // total CPU times followed by times of each core
+        uint64_t            ContextSwitches;
+
+    public:
+        float               SystemLoad;
+        vector<float>       CoresLoad;
+        float               ContextSwitchesRate;
+
+    private:
+        uint64_t            ProcessSampleTime;
+        uint64_t            ProcessTicks;
+        uint64_t            ProcessContextSwitches;
+
+    public:
+        float               ProcessLoad;
+        float               ProcessContextSwitchesRate;
+
+    private:
+        uint64_t            ThreadsSampleTime;
+        map<long, uint64_t> ThreadsTicks;
+
+    public:
+        vector<string>      ThreadNames;
+        vector<float>       ThreadsLoad;
+
+    private:
+        float               CgroupCpuLimit;     // CPU limit set by cgroup of the process (0 if no limit)
+    };
+}
+
+// Get current time of monotonic clock in nanoseconds
+static uint64_t GetTimeNs( )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return static_cast<uint64_t>( ts.tv_sec ) * 1000000000ull + static_cast<uint64_t>( ts.tv_nsec );
+}
+
+PerformanceInfoPlugin::PerformanceInfoPlugin( ) :
+    data( new Private::PerformanceInfoPluginData( ) ),
+    isConnected( false )
+{
+}
+
+void PerformanceInfoPlugin::Dispose( )
+{
+    Disconnect( );
+    delete data;
+    delete this;
+}
+
+// Open /proc files and take initial samples of the counters
+XErrorCode PerformanceInfoPlugin::Connect( )
+{
+    XErrorCode ret = ErrorConnectionFailed;
+
+    if ( isConnected )
+    {
+        ret = SuccessCode;
+    }
+    else if ( data->Open( ) )
+    {
+        isConnected = true;
+        ret = SuccessCode;
+    }
+
+    return ret;
+}
+
+// Close /proc files
+void PerformanceInfoPlugin::Disconnect( )
+{
+    if ( isConnected )
+    {
+        data->Close( );
+        isConnected = false;
+    }
+}
+
+// Check connection status
+bool PerformanceInfoPlugin::IsConnected( )
+{
+    return isConnected;
+}
+
+// Get specified property value of the plug-in
+XErrorCode PerformanceInfoPlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode ret = SuccessCode;
+
+    // although connection is not required, we still follow the common way
+    if ( !isConnected )
+    {
+        ret = ErrorNotConnected;
+    }
+    else if ( ( id < 0 ) || ( id >= PROPERTIES_COUNT ) )
+    {
+        ret = ErrorInvalidProperty;
+    }
+    else
+    {
+        xarray*  array = nullptr;
+        xvariant v;
+        uint32_t totalMemory, availableMemory, i;
+
+        switch ( id )
+        {
+        case 0:
+            value->type = XVT_U2;
+            value->value.uiVal = data->ProcessorsCount;
+            break;
+
+        case 1:
+        case 2:
+        case 8:
+            if ( !data->UpdateSystemCounters( ) )
+            {
+                ret = ErrorFailed;
+            }
+            else if ( id == 1 )
+            {
+                value->type = XVT_R4;
+                value->value.fVal = data->SystemLoad;
+            }
+            else if ( id == 8 )
+            {
+                value->type = XVT_R4;
+                value->value.fVal = data->ContextSwitchesRate;
+            }
+            else
+            {
+                ret = XArrayAllocate( &array, XVT_R4, static_cast<uint32_t>( data->CoresLoad.size( ) ) );
+                if ( ret == SuccessCode )
+                {
+                    v.type = XVT_R4;
+
+                    for ( i = 0; i < data->CoresLoad.size( ); i++ )
+                    {
+                        v.value.fVal = data->CoresLoad[i];
+                        XArraySet( array, i, &v );
+                    }
+
+                    value->type = XVT_R4 | XVT_Array;
+                    value->value.arrayVal = array;
+                }
+            }
+            break;
+
+        case 3:
+        case 9:
+            if ( !data->UpdateProcessCounters( ) )
+            {
+                ret = ErrorFailed;
+            }
+            else
+            {
+                value->type = XVT_R4;
+                value->value.fVal = ( id == 3 ) ? data->ProcessLoad : data->ProcessContextSwitchesRate;
+            }
+            break;
+
+        case 4:
+            value->type = XVT_R4;
+            value->value.fVal = data->GetCpuLimit( );
+            break;
+
+        case 5:
+        case 6:
+            if ( !data->GetSystemMemory( &totalMemory, &availableMemory ) )
+            {
+                ret = ErrorFailed;
+            }
+            else
+            {
+                value->type = XVT_U4;
+                value->value.uiVal = ( id == 5 ) ? totalMemory : availableMemory;
+            }
+            break;
+
+        case 7:
+            value->type = XVT_U4;
+
+            if ( !data->GetProcessMemory( &value->value.uiVal ) )
+            {
+                value->type = XVT_Empty;
+                ret = ErrorFailed;
+            }
+            break;
+
+        case 10:
+        case 11:
+            if ( !data->UpdateThreadsCounters( ) )
+            {
+                ret = ErrorFailed;
+            }
+            else if ( id == 10 )
+            {
+                ret = XArrayAllocate( &array, XVT_String, static_cast<uint32_t>( data->ThreadNames.size( ) ) );
+                if ( ret == SuccessCode )
+                {
+                    for ( i = 0; i < data->ThreadNames.size( ); i++ )
+                    {
+                        v.type         = XVT_String;
+                        v.value.strVal = XStringAlloc( data->ThreadNames[i].c_str( ) );
+
+                        XArrayMove( array, i, &v );
+                    }
+
+                    value->type = XVT_String | XVT_Array;
+                    value->value.arrayVal = array;
+                }
+            }
+            else
+            {
+                ret = XArrayAllocate( &array, XVT_R4, static_cast<uint32_t>( data->ThreadsLoad.size( ) ) );
+                if ( ret == SuccessCode )
+                {
+                    v.type = XVT_R4;
+
+                    for ( i = 0; i < data->ThreadsLoad.size( ); i++ )
+                    {
+                        v.value.fVal = data->ThreadsLoad[i];
+                        XArraySet( array, i, &v );
+                    }
+
+                    value->type = XVT_R4 | XVT_Array;
+                    value->value.arrayVal = array;
+                }
+            }
+            break;
+        }
+    }
+
+    return ret;
+}
+
+// Set specified property value of the plug-in
+XErrorCode PerformanceInfoPlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode ret = SuccessCode;
+
+    XUNREFERENCED_PARAMETER( id )
+    XUNREFERENCED_PARAMETER( value )
+
+    if ( !isConnected )
+    {
+        ret = ErrorNotConnected;
+    }
+    else if ( ( id < 0 ) || ( id >= PROPERTIES_COUNT ) )
+    {
+        ret = ErrorInvalidProperty;
+    }
+    else
+    {
+        ret = ErrorReadOnlyProperty;
+    }
+
+    return ret;
+}
+
+namespace Private
+{
+    // Open /proc files, which are read frequently, and take initial samples
+    bool PerformanceInfoPluginData::Open( )
+    {
+        long processorsCount = sysconf( _SC_NPROCESSORS_ONLN );
+        long ticksPerSecond  = sysconf( _SC_CLK_TCK );
+
+        ProcessorsCount = ( processorsCount > 0 ) ? static_cast<uint32_t>( processorsCount ) : 1;
+        TicksPerSecond  = ( ticksPerSecond > 0 ) ? ticksPerSecond : 100;
+
+        // the files are kept opened and re-read from the start, which generates their content again
+        SystemStatFile    = open( "/proc/stat", O_RDONLY | O_CLOEXEC );
+        MemoryInfoFile    = open( "/proc/meminfo", O_RDONLY | O_CLOEXEC );
+        ProcessStatFile   = open( "/proc/self/stat", O_RDONLY | O_CLOEXEC );
+        ProcessMemoryFile = open( "/proc/self/statm", O_RDONLY | O_CLOEXEC );
+
+        SystemTimes.clear( );
+        ThreadsTicks.clear( );
+        SystemSampleTime  = 0;
+        ProcessSampleTime = 0;
+        ThreadsSampleTime = 0;
+
+        bool ret = ( ( SystemStatFile != -1 ) && ( MemoryInfoFile != -1 ) && ( ProcessStatFile != -1 ) && ( ProcessMemoryFile != -1 ) &&
+                     ( UpdateSystemCounters( true ) ) && ( UpdateProcessCounters( true ) ) && ( UpdateThreadsCounters( true ) ) );
+
+        if ( !ret )
+        {
+            Close( );
+        }
+
+        return ret;
+    }
+
+    // Close all opened files
+    void PerformanceInfoPluginData::Close( )
+    {
+        int* files[] = { &SystemStatFile, &MemoryInfoFile, &ProcessStatFile, &ProcessMemoryFile };
+
+        for ( int* file : files )
+        {
+            if ( *file != -1 )
+            {
+                close( *file );
+                *file = -1;
+            }
+        }
+    }
+
+    // Read content of an opened /proc file as zero terminated string
+    bool PerformanceInfoPluginData::ReadFile( int file )
+    {
+        size_t  totalRead = 0;
+        ssize_t bytesRead;
+
+        // /proc files report zero size, so buffer grows until the whole content fits into it
+        while ( ( bytesRead = pread( file, Buffer.data( ) + totalRead, Buffer.size( ) - totalRead - 1, totalRead ) ) > 0 )
+        {
+            totalRead += static_cast<size_t>( bytesRead );
+
+            if ( totalRead == Buffer.size( ) - 1 )
+            {
+                Buffer.resize( Buffer.size( ) * 2 );
+            }
+        }
+
+        Buffer[totalRead] = '\0';
+
+        return ( ( bytesRead == 0 ) && ( totalRead != 0 ) );
+    }
+
+    // Open, read and close the specified file
+    bool PerformanceInfoPluginData::ReadFile( const char* fileName )
+    {
+        int  file = open( fileName, O_RDONLY | O_CLOEXEC );
+        bool ret  = false;
+
+        if ( file != -1 )
+        {
+            ret = ReadFile( file );
+            close( file );
+        }
+
+        return ret;
+    }
+
+    // Update system wide CPU load and context switches rate
+    bool PerformanceInfoPluginData::UpdateSystemCounters( bool force )
+    {
+        uint64_t now = GetTimeNs( );
+        bool     ret = true;
+
+        if ( ( force ) || ( now - SystemSampleTime >= MIN_SAMPLE_INTERVAL ) )
+        {
+            ret = ReadFile( SystemStatFile );
+
+            if ( ret )
+            {
+                vector<CpuTimes> times( SystemTimes.size( ) );
+                uint64_t         contextSwitches = ContextSwitches;
+                const char*      line            = Buffer.data( );
+
+                while ( line != nullptr )
+                {
+                    if ( strncmp( line, "cpu", 3 ) == 0 )
+                    {
+                        uint64_t    values[8] = { 0 };
+                        char*       end;
+                        const char* ptr   = line + 3;
+                        size_t      index = 0;
+
+                        // the first line is total for all CPUs, followed by line for each online CPU
+                        if ( *ptr != ' ' )
+                        {
+                            index = static_cast<size_t>( strtoul( ptr, &end, 10 ) ) + 1;
+                            ptr   = end;
+                        }
+
+                        // user, nice, system, idle, iowait, irq, softirq, steal (guest time is included into user time)
+                        for ( int i = 0; i < 8; i++ )
+                        {
+                            values[i] = strtoull( ptr, &end, 10 );
+                            ptr       = end;
+                        }
+
+                        if ( index >= times.size( ) )
+                        {
+                            times.resize( index + 1 );
+                        }
+
+                        times[index].Idle  = values[3] + values[4];
+                        times[index].Total = values[0] + values[1] + values[2] + values[3] + values[4] + values[5] + values[6] + values[7];
+                    }
+                    else if ( strncmp( line, "ctxt ", 5 ) == 0 )
+                    {
+                        contextSwitches = strtoull( line + 5, nullptr, 10 );
+                    }
+
+                    line = strchr( line, '\n' );
+                    if ( line != nullptr )
+                    {
+                        line++;
+                    }
+                }
+
+                if ( !times.empty( ) )
+                {
+                    // loads are calculated only for CPUs which were online in both samples
+                    CoresLoad.resize( times.size( ) - 1 );
+
+                    for ( size_t i = 0; i < times.size( ); i++ )
+                    {
+                        float load = 0;
+
+                        if ( ( i < SystemTimes.size( ) ) && ( times[i].Total > SystemTimes[i].Total ) )
+                        {
+                            uint64_t totalDiff = times[i].Total - SystemTimes[i].Total;
+                            uint64_t idleDiff  = times[i].Idle - SystemTimes[i].Idle;
+
+                            load = ( idleDiff >= totalDiff ) ? 0.0f :
+                                   static_cast<float>( 100.0 * ( totalDiff - idleDiff ) / totalDiff );
+                        }
+
+                        if ( i == 0 )
+                        {
+                            SystemLoad = load;
+                        }
+                        else
+                        {
+                            CoresLoad[i - 1] = load;
+                        }
+                    }
+                }
+
+                ContextSwitchesRate = ( ( SystemSampleTime == 0 ) || ( now == SystemSampleTime ) ) ? 0.0f :
+                    static_cast<float>( ( contextSwitches - ContextSwitches ) * 1000000000.0 / ( now - SystemSampleTime ) );
+
+                SystemTimes.swap( times );
+                ContextSwitches  = contextSwitches;
+                SystemSampleTime = now;
+            }
+        }
+
+        return ret;
+    }
+
+    // Update CPU load and context switches rate of the current process
+    bool PerformanceInfoPluginData::UpdateProcessCounters( bool force )
+    {
+        uint64_t now = GetTimeNs( );
+        bool     ret = true;
+
+        if ( ( force ) || ( now - ProcessSampleTime >= MIN_SAMPLE_INTERVAL ) )
+        {
+            uint64_t      ticks = 0;
+            struct rusage usage;
+
+            ret = ( ( ReadFile( ProcessStatFile ) ) && ( ParseProcStatTicks( Buffer.data( ), &ticks ) ) &&
+                    ( getrusage( RUSAGE_SELF, &usage ) == 0 ) );
+
+            if ( ret )
+            {
+                uint64_t contextSwitches = static_cast<uint64_t>( usage.ru_nvcsw ) + static_cast<uint64_t>( usage.ru_nivcsw );
+
+                if ( ( ProcessSampleTime == 0 ) || ( now == ProcessSampleTime ) )
+                {
+                    ProcessLoad                = 0;
+                    ProcessContextSwitchesRate = 0;
+                }
+                else
+                {
+                    double interval = ( now - ProcessSampleTime ) / 1000000000.0;
+
+                    ProcessLoad = static_cast<float>( 100.0 * ( ticks - ProcessTicks ) / TicksPerSecond / interval / ProcessorsCount );
+                    ProcessLoad = ( ProcessLoad > 100.0f ) ? 100.0f : ProcessLoad;
+
+                    ProcessContextSwitchesRate = static_cast<float>( ( contextSwitches - ProcessContextSwitches ) / interval );
+                }
+
+                ProcessTicks           = ticks;
+                ProcessContextSwitches = contextSwitches;
+                ProcessSampleTime      = now;
+            }
+        }
+
+        return ret;
+    }
+
+    // Update names and CPU load of the current process's threads
+    bool PerformanceInfoPluginData::UpdateThreadsCounters( bool force )
+    {
+        uint64_t now = GetTimeNs( );
+        bool     ret = true;
+
+        if ( ( force ) || ( now - ThreadsSampleTime >= MIN_SAMPLE_INTERVAL ) )
+        {
+            DIR* dir = opendir( "/proc/self/task" );
+
+            ret = ( dir != nullptr );
+
+            if ( ret )
+            {
+                double              interval = ( ThreadsSampleTime == 0 ) ? 0.0 : ( now - ThreadsSampleTime ) / 1000000000.0;
+                map<long, uint64_t> threadsTicks;
+                struct dirent*      entry;
+                char                fileName[64];
+                string              name;
+                uint64_t            ticks;
+
+                ThreadNames.clear( );
+                ThreadsLoad.clear( );
+
+                while ( ( entry = readdir( dir ) ) != nullptr )
+                {
+                    char* end;
+                    long  threadId = strtol( entry->d_name, &end, 10 );
+
+                    if ( ( *end != '\0' ) || ( end == entry->d_name ) )
+                    {
+                        continue;
+                    }
+
+                    sprintf( fileName, "/proc/self/task/%ld/stat", threadId );
+
+                    // thread could exit since the directory was listed
+                    if ( ( ReadFile( fileName ) ) && ( ParseProcStatTicks( Buffer.data( ), &ticks, &name ) ) )
+                    {
+                        map<long, uint64_t>::const_iterator it   = ThreadsTicks.find( threadId );
+                        float                                load = 0;
+
+                        // threads started since the previous sample have all their time spent within the interval
+                        if ( interval > 0 )
+                        {
+                            uint64_t previousTicks = ( it == ThreadsTicks.end( ) ) ? 0 : it->second;
+
+                            load = ( ticks < previousTicks ) ? 0.0f :
+                                   static_cast<float>( 100.0 * ( ticks - previousTicks ) / TicksPerSecond / interval );
+                            load = ( load > 100.0f ) ? 100.0f : load;
+                        }
+
+                        threadsTicks[threadId] = ticks;
+                        ThreadNames.push_back( name );
+                        ThreadsLoad.push_back( load );
+                    }
+                }
+
+                closedir( dir );
+
+                ThreadsTicks.swap( threadsTicks );
+                ThreadsSampleTime = now;
+            }
+        }
+
+        return ret;
+    }
+
+    // Get total/available physical memory, MB
+    bool PerformanceInfoPluginData::GetSystemMemory( uint32_t* totalMemory, uint32_t* availableMemory )
+    {
+        bool ret = ReadFile( MemoryInfoFile );
+
+        if ( ret )
+        {
+            const char* total     = strstr( Buffer.data( ), "MemTotal:" );
+            const char* available = strstr( Buffer.data( ), "MemAvailable:" );
+
+            // values are in kB
+            ret = ( ( total != nullptr ) && ( available != nullptr ) );
+
+            if ( ret )
+            {
+                *totalMemory     = static_cast<uint32_t>( strtoull( total + 9, nullptr, 10 ) >> 10 );
+                *availableMemory = static_cast<uint32_t>( strtoull( available + 13, nullptr, 10 ) >> 10 );
+            }
+        }
+
+        return ret;
+    }
+
+    // Get physical memory used by the current process, MB
+    bool PerformanceInfoPluginData::GetProcessMemory( uint32_t* processMemory )
+    {
+        bool ret = ReadFile( ProcessMemoryFile );
+
+        if ( ret )
+        {
+            char*    end;
+            // total program size is followed by resident set size, both in pages
+            uint64_t residentPages = strtoull( Buffer.data( ), &end, 10 );
+
+            residentPages  = strtoull( end, nullptr, 10 );
+            *processMemory = static_cast<uint32_t>( ( residentPages * static_cast<uint64_t>( sysconf( _SC_PAGESIZE ) ) ) >> 20 );
+        }
+
+        return ret;
+    }
+
+    // Get number of CPUs the process can use
+    float PerformanceInfoPluginData::GetCpuLimit( )
+    {
+        float     ret    = static_cast<float>( ProcessorsCount );
+        cpu_set_t cpuSet;
+
+        CPU_ZERO( &cpuSet );
+
+        if ( sched_getaffinity( 0, sizeof( cpuSet ), &cpuSet ) == 0 )
+        {
+            ret = static_cast<float>( CPU_COUNT( &cpuSet ) );
+        }
+
+        if ( ( CgroupCpuLimit > 0 ) && ( CgroupCpuLimit < ret ) )
+        {
+            ret = CgroupCpuLimit;
+        }
+
+        return ret;
+    }
+
+    // Get CPU limit set by cgroup the process belongs to (0 if no limit)
+    float PerformanceInfoPluginData::GetCgroupCpuLimit( )
+    {
+        float ret = 0;
+
+        if ( ReadFile( "/proc/self/cgroup" ) )
+        {
+            vector<CgroupLocation> locations;
+            const char*            line = Buffer.data( );
+
+            // lines are in "hierarchy-ID:controllers:path" format
+            while ( ( line != nullptr ) && ( *line != '\0' ) )
+            {
+                const char* controllers = strchr( line, ':' );
+                const char* path        = ( controllers != nullptr ) ? strchr( controllers + 1, ':' ) : nullptr;
+                const char* lineEnd     = strchr( line, '\n' );
+
+                if ( ( path != nullptr ) && ( ( lineEnd == nullptr ) || ( path < lineEnd ) ) )
+                {
+                    string controllersList( controllers + 1, path );
+                    string cgroupPath( path + 1, ( lineEnd != nullptr ) ? lineEnd : path + strlen( path ) );
+
+                    if ( controllersList.empty( ) )
+                    {
+                        locations.push_back( CgroupLocation( "/sys/fs/cgroup", cgroupPath, true ) );
+                    }
+                    else if ( ( "," + controllersList + "," ).find( ",cpu," ) != string::npos )
+                    {
+                        // cgroup v1 hierarchy is usually mounted under the list of its controllers
+                        locations.push_back( CgroupLocation( "/sys/fs/cgroup/" + controllersList, cgroupPath, false ) );
+                        locations.push_back( CgroupLocation( "/sys/fs/cgroup/cpu", cgroupPath, false ) );
+                    }
+                }
+
+                line = ( lineEnd != nullptr ) ? lineEnd + 1 : nullptr;
+            }
+
+            // limit can be set at any level of the hierarchy, so the most restrictive one is taken; when running
+            // in a container the path may not exist in its namespace, but the levels above it still do
+            for ( CgroupLocation& location : locations )
+            {
+                string path = location.Path;
+
+                for ( ; ; )
+                {
+                    float limit = ReadCgroupCpuLimit( location.MountPoint + path, location.IsV2 );
+
+                    if ( ( limit > 0 ) && ( ( ret == 0 ) || ( limit < ret ) ) )
+                    {
+                        ret = limit;
+                    }
+
+                    size_t separator = path.find_last_of( '/' );
+
+                    if ( ( path.size( ) <= 1 ) || ( separator == string::npos ) )
+                    {
+                        break;
+                    }
+
+                    path.erase( ( separator == 0 ) ? 1 : separator );
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    // Read CPU limit of the specified cgroup (0 if no limit)
+    float PerformanceInfoPluginData::ReadCgroupCpuLimit( const string& dir, bool isV2 )
+    {
+        string prefix = dir + ( ( dir.back( ) == '/' ) ? "" : "/" );
+        double quota  = 0;
+        double period = 0;
+
+        if ( isV2 )
+        {
+            // "max <period>" or "<quota> <period>"
+            if ( ( ReadFile( ( prefix + "cpu.max" ).c_str( ) ) ) && ( strncmp( Buffer.data( ), "max", 3 ) != 0 ) )
+            {
+                char* end;
+
+                quota  = strtod( Buffer.data( ), &end );
+                period = strtod( end, nullptr );
+            }
+        }
+        else if ( ReadFile( ( prefix + "cpu.cfs_quota_us" ).c_str( ) ) )
+        {
+            // quota is -1 when there is no limit
+            quota = strtod( Buffer.data( ), nullptr );
+
+            if ( ( quota > 0 ) && ( ReadFile( ( prefix + "cpu.cfs_period_us" ).c_str( ) ) ) )
+            {
+                period = strtod( Buffer.data( ), nullptr );
+            }
+        }
+
+        return ( ( quota > 0 ) && ( period > 0 ) ) ? static_cast<float>( quota / period ) : 0.0f;
+    }
+}
+
+#endif // __linux__
@@ -19,6 +19,9 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+// The plug-in uses power status provided by Windows API, so it is not available on other platforms
+#ifdef WIN32
+
 #include <windows.h>
 #include "PowerInfoPlugin.hpp"
 
@@ -118,3 +121,5 @@ XErrorCode PowerInfoPlugin::SetProperty( int32_t id, const xvariant* value )
 
     return ret;
 }
+
+#endif // WIN32
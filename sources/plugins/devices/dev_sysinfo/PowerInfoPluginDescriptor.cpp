@@ -19,6 +19,9 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+// The plug-in is registered on Windows only (see PowerInfoPlugin.cpp)
+#ifdef WIN32
+
 #include <iplugincpp.hpp>
 #include "PowerInfoPlugin.hpp"
 
@@ -84,3 +87,5 @@ static void PluginInitializer( )
     batteryChargeProperty.MaxValue.type = XVT_U1;
     batteryChargeProperty.MaxValue.value.ubVal = 100;
 }
+
+#endif // WIN32
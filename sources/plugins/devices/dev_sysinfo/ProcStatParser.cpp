@@ -0,0 +1,69 @@
+/*
+    System Info plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "ProcStatParser.hpp"
+
+using namespace std;
+
+// Parse user and system times (14th and 15th fields) from content of /proc/*/stat file and provide their sum in clock ticks
+bool ParseProcStatTicks( const char* stat, uint64_t* ticks, string* name )
+{
+    const char* nameStart = strchr( stat, '(' );
+    const char* nameEnd   = strrchr( stat, ')' );
+    bool        ret       = false;
+
+    // name of the task can contain spaces and brackets, so fields are counted from the last bracket
+    if ( ( nameStart != nullptr ) && ( nameEnd != nullptr ) && ( nameEnd > nameStart ) )
+    {
+        const char* ptr   = nameEnd + 1;
+        int         field = 2;
+
+        if ( name != nullptr )
+        {
+            name->assign( nameStart + 1, nameEnd );
+        }
+
+        // each space starts the next field, so stop at the start of user time field
+        while ( ( *ptr != '\0' ) && ( field < 14 ) )
+        {
+            if ( *ptr == ' ' )
+            {
+                field++;
+            }
+            ptr++;
+        }
+
+        if ( field == 14 )
+        {
+            char* end;
+            uint64_t userTime   = strtoull( ptr, &end, 10 );
+            uint64_t systemTime = strtoull( end, &end, 10 );
+
+            *ticks = userTime + systemTime;
+            ret    = ( end != ptr );
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,33 @@
+/*
+    System Info plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#pragma once
+#ifndef CVS_PROC_STAT_PARSER_HPP
+#define CVS_PROC_STAT_PARSER_HPP
+
+#include <stdint.h>
+#include <string>
+
+// Parse user and system times (14th and 15th fields) from content of /proc/*/stat file and provide their sum in clock ticks
+bool ParseProcStatTicks( const char* stat, uint64_t* ticks, std::string* name = nullptr );
+
+#endif // CVS_PROC_STAT_PARSER_HPP
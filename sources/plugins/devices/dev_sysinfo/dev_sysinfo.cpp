@@ -25,7 +25,7 @@
 ModuleDescriptor moduleInfo =
 {
     { 0xAF000001, 0x00000000, 0x00000000, 0x0000000A },
-    { 1, 0, 0 },
+    { 1, 0, 1 },
     "System Information Tools",
     "dev_sysinfo",
     "The module contains plug-ins, which allow getting some system related information.",
@@ -6,12 +6,18 @@ VPATH = ../../
 # source files
 SRC = dev_sysinfo.cpp \
     LedKeysPlugin.cpp LedKeysPluginDescriptor.cpp \
-    PerformanceInfoPlugin.cpp PerformanceInfoPluginDescriptor.cpp \
-    PowerInfoPlugin.cpp PowerInfoPluginDescriptor.cpp
+    PerformanceInfoPlugin.cpp PerformanceInfoPlugin_Linux.cpp PerformanceInfoPluginDescriptor.cpp \
+    PowerInfoPlugin.cpp PowerInfoPluginDescriptor.cpp \
+    ProcStatParser.cpp
 
 # additional include folders
 INCLUDES = -I../../../../../afx/afx_types \
 	-I../../../../../core/iplugin -I../../../../../images
 
 # libraries to use
-LIBS = -lwinmm -lpdh -liplugin -lafx_types
+LIBS = -liplugin -lafx_types
+
+# LED Keys, Power Info and Windows version of Performance Info plug-ins need Windows libraries
+ifeq ($(OS),Windows_NT)
+LIBS += -lwinmm -lpdh -lpsapi
+endif
@@ -24,7 +24,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat FindBlobsBySizePlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32, XPixelFormatYUV420, XPixelFormatNV12
 };
 
 FindBlobsBySizePlugin::FindBlobsBySizePlugin( )
@@ -52,7 +52,28 @@ XErrorCode FindBlobsBySizePlugin::GetSupportedPixelFormats( XPixelFormat* format
 // Process the specified source image by changing it
 XErrorCode FindBlobsBySizePlugin::ProcessImage( const ximage* image )
 {
-    return filterPlugin.ProcessImageInPlace( const_cast<ximage*>( image ) );
+    XErrorCode ret = SuccessCode;
+
+    if ( ( image != nullptr ) && ( XImageIsPixelFormatPlanar( image->format ) ) )
+    {
+        // blobs are searched on luminance plane of planar YUV images
+        ximage* lumaPlane = nullptr;
+
+        ret = XImageGetPlane( image, &lumaPlane, 0 );
+
+        if ( ret == SuccessCode )
+        {
+            ret = filterPlugin.ProcessImageInPlace( lumaPlane );
+        }
+
+        XImageFree( &lumaPlane );
+    }
+    else
+    {
+        ret = filterPlugin.ProcessImageInPlace( const_cast<ximage*>( image ) );
+    }
+
+    return ret;
 }
 
 // Get the specified property value of the plug-in
@@ -30,10 +30,16 @@ const XPixelFormat TextileTexturePlugin::supportedFormats[] =
 };
 
 TextileTexturePlugin::TextileTexturePlugin( ) :
-    stitchSize( 7 ), stitchOffset( 0 ), amountToKeep( 0.5f ), randValue( (uint16_t) ( rand( ) % 10000 ) )
+    stitchSize( 7 ), stitchOffset( 0 ), amountToKeep( 0.5f ), randValue( (uint16_t) ( rand( ) % 10000 ) ),
+    textureImage( nullptr )
 {
 }
 
+TextileTexturePlugin::~TextileTexturePlugin( )
+{
+    XImageFree( &textureImage );
+}
+
 void TextileTexturePlugin::Dispose( )
 {
     delete this;
@@ -81,18 +87,32 @@ XErrorCode TextileTexturePlugin::ProcessImageInPlace( ximage* src )
     }
     else
     {
-        ximage* texture = 0;
-        
-        ret = XImageAllocateTexture( src->width, src->height, &texture );
+        // free old texture if its size does not match
+        if ( ( textureImage != nullptr ) && (
+             ( textureImage->width != src->width ) || ( textureImage->height != src->height ) ) )
+        {
+            XImageFree( &textureImage );
+        }
 
-        if ( ret == SuccessCode )
+        // generate new texture
+        if ( textureImage == nullptr )
         {
-            if ( GenerateTextileTexture( texture, randValue, stitchSize, stitchOffset ) == SuccessCode )
+            ret = XImageAllocateTexture( src->width, src->height, &textureImage );
+
+            if ( ret == SuccessCode )
             {
-                ret = XImageApplyTexture( texture, src, amountToKeep, 255 );
+                ret = GenerateTextileTexture( textureImage, randValue, stitchSize, stitchOffset );
+
+                if ( ret != SuccessCode )
+                {
+                    XImageFree( &textureImage );
+                }
             }
+        }
 
-            XImageFree( &texture );
+        if ( ret == SuccessCode )
+        {
+            ret = XImageApplyTexture( textureImage, src, amountToKeep, 255 );
         }
     }
 
@@ -155,6 +175,11 @@ XErrorCode TextileTexturePlugin::SetProperty( int32_t id, const xvariant* value
             amountToKeep = convertedValue.value.fVal;
 			break;
 		}
+
+        if ( ( id == 0 ) || ( id == 1 ) )
+        {
+            XImageFree( &textureImage );
+        }
 	}
 
     XVariantClear( &convertedValue );
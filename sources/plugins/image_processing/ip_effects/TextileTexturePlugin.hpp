@@ -27,6 +27,9 @@
 
 class TextileTexturePlugin : public IImageProcessingFilterPlugin
 {
+private:
+    ~TextileTexturePlugin( );
+
 public:
     TextileTexturePlugin( );
 
@@ -50,7 +53,7 @@ private:
     uint8_t     stitchOffset;
     float       amountToKeep;
     uint16_t    randValue;
-
+    ximage*     textureImage;
 };
 
 #endif // CVS_TEXTILE_TEXTURE_PLUGIN_HPP
@@ -29,10 +29,16 @@ const XPixelFormat VignettingPlugin::supportedFormats[] =
 };
 
 VignettingPlugin::VignettingPlugin( ) :
-    startWidthFactor( 90.0f ), endWidthFactor( 150.0f ), decreaseBrightness( true ), decreaseSaturation( false )
+    startWidthFactor( 90.0f ), endWidthFactor( 150.0f ), decreaseBrightness( true ), decreaseSaturation( false ),
+    vignetteMask( nullptr )
 {
 }
 
+VignettingPlugin::~VignettingPlugin( )
+{
+    XImageFree( &vignetteMask );
+}
+
 void VignettingPlugin::Dispose( )
 {
     delete this;
@@ -72,7 +78,44 @@ XErrorCode VignettingPlugin::ProcessImage( const ximage* src, ximage** dst )
 // Process the specified source image by changing it
 XErrorCode VignettingPlugin::ProcessImageInPlace( ximage* src )
 {
-    return MakeVignetteImage( src, startWidthFactor / 100.0f, endWidthFactor / 100.0f, decreaseBrightness, decreaseSaturation );
+    XErrorCode ret = SuccessCode;
+
+    if ( src == 0 )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        // free old mask if its size does not match
+        if ( ( vignetteMask != nullptr ) && (
+             ( vignetteMask->width != src->width ) || ( vignetteMask->height != src->height ) ) )
+        {
+            XImageFree( &vignetteMask );
+        }
+
+        // build new mask
+        if ( vignetteMask == nullptr )
+        {
+            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &vignetteMask );
+
+            if ( ret == SuccessCode )
+            {
+                ret = BuildVignetteMask( vignetteMask, startWidthFactor / 100.0f, endWidthFactor / 100.0f );
+
+                if ( ret != SuccessCode )
+                {
+                    XImageFree( &vignetteMask );
+                }
+            }
+        }
+
+        if ( ret == SuccessCode )
+        {
+            ret = ApplyVignetteMask( src, vignetteMask, decreaseBrightness, decreaseSaturation );
+        }
+    }
+
+    return ret;
 }
 
 // Get specified property value of the plug-in
@@ -140,6 +183,11 @@ XErrorCode VignettingPlugin::SetProperty( int32_t id, const xvariant* value )
             decreaseSaturation = convertedValue.value.boolVal;
             break;
         }
+
+        if ( ( id == 0 ) || ( id == 1 ) )
+        {
+            XImageFree( &vignetteMask );
+        }
     }
 
     XVariantClear( &convertedValue );
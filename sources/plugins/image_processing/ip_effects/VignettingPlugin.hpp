@@ -27,6 +27,9 @@
 
 class VignettingPlugin : public IImageProcessingFilterPlugin
 {
+private:
+    ~VignettingPlugin( );
+
 public:
     VignettingPlugin( );
 
@@ -49,6 +52,7 @@ private:
     float endWidthFactor;
     bool decreaseBrightness;
     bool decreaseSaturation;
+    ximage* vignetteMask;
 };
 
 #endif // CVS_VIGNETTING_PLUGIN_HPP
@@ -26,7 +26,7 @@
 ModuleDescriptor moduleInfo =
 {
     { 0xAF000001, 0x00000000, 0x00000000, 0x00000006 },
-    { 1, 0, 1 },
+    { 1, 0, 2 },
     "Image Processing Effects",
     "ip_effects",
     "The module contains set of artistic effects used in image processing.",
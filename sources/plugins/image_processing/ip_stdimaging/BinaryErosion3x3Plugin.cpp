@@ -25,7 +25,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat BinaryErosion3x3Plugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8,
+    XPixelFormatGrayscale8, XPixelFormatBinary1
 };
 
 BinaryErosion3x3Plugin::BinaryErosion3x3Plugin( )
@@ -62,9 +62,9 @@ XErrorCode BinaryErosion3x3Plugin::ProcessImage( const ximage* src, ximage** dst
     else
     {
         // create output image of required format
-        if ( src->format == XPixelFormatGrayscale8 )
+        if ( ( src->format == XPixelFormatGrayscale8 ) || ( src->format == XPixelFormatBinary1 ) )
         {
-            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale8, dst );
+            ret = XImageAllocateRaw( src->width, src->height, src->format, dst );
         }
         else
         {
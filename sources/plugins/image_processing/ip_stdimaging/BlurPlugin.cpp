@@ -95,6 +95,12 @@ XErrorCode BlurPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode BlurPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 2 );
+}
+
 // No properties to get/set
 XErrorCode BlurPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -0,0 +1,158 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <xvision.h>
+#include "BradleyThresholdPlugin.hpp"
+
+// Supported pixel formats of input/output images
+const XPixelFormat BradleyThresholdPlugin::supportedFormats[] =
+{
+    XPixelFormatGrayscale8
+};
+
+BradleyThresholdPlugin::BradleyThresholdPlugin( ) :
+    windowRadius( 20 ), brightnessDifference( 15.0f ), integralImage( nullptr )
+{
+}
+
+void BradleyThresholdPlugin::Dispose( )
+{
+    XImageFree( &integralImage );
+    delete this;
+}
+
+// The plug-in can process image in-place without creating new image as a result
+bool BradleyThresholdPlugin::CanProcessInPlace( )
+{
+    return true;
+}
+
+// Provide supported pixel formats
+XErrorCode BradleyThresholdPlugin::GetPixelFormatTranslations( XPixelFormat* inputFormats, XPixelFormat* outputFormats, int32_t* count )
+{
+    return GetPixelFormatTranslationsImpl( inputFormats, outputFormats, count, supportedFormats, supportedFormats,
+        XARRAY_SIZE( supportedFormats ) );
+}
+
+// Process the specified source image and return new as a result
+XErrorCode BradleyThresholdPlugin::ProcessImage( const ximage* src, ximage** dst )
+{
+    XErrorCode ret = XImageClone( src, dst );
+
+    if ( ret == SuccessCode )
+    {
+        ret = ProcessImageInPlace( *dst );
+
+        if ( ret != SuccessCode )
+        {
+            XImageFree( dst );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified source image by changing it
+XErrorCode BradleyThresholdPlugin::ProcessImageInPlace( ximage* src )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( src == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        // integral image is kept between calls, so it is not reallocated for every video frame
+        ret = XImageAllocateRaw( src->width + 1, src->height + 1, XPixelFormatGrayscale64, &integralImage );
+
+        if ( ret == SuccessCode )
+        {
+            ret = BuildIntegralImage64( src, integralImage, nullptr, 0 );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = BradleyLocalThresholding( src, integralImage, windowRadius, brightnessDifference / 100.0f );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode BradleyThresholdPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, windowRadius );
+}
+
+// Get the specified property value of the plug-in
+XErrorCode BradleyThresholdPlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode ret = SuccessCode;
+
+    switch ( id )
+    {
+    case 0:
+        value->type = XVT_U2;
+        value->value.usVal = windowRadius;
+        break;
+
+    case 1:
+        value->type = XVT_R4;
+        value->value.fVal = brightnessDifference;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+    }
+
+    return ret;
+}
+
+// Set the specified property value of the plug-in
+XErrorCode BradleyThresholdPlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode ret = SuccessCode;
+
+    xvariant convertedValue;
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 2, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            windowRadius = XINRANGE( convertedValue.value.usVal, 1, 500 );
+            break;
+
+        case 1:
+            brightnessDifference = XINRANGE( convertedValue.value.fVal, 0.0f, 100.0f );
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
+}
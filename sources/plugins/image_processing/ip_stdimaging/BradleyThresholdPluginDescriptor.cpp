@@ -0,0 +1,106 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <iplugincpp.hpp>
+#include <image_thresholding_plugin_16x16.h>
+#include "BradleyThresholdPlugin.hpp"
+
+static void PluginInitializer( );
+
+// Version of the plug-in
+static xversion PluginVersion = { 1, 0, 0 };
+
+// ID of the plug-in
+static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000001, 0x0000003D };
+
+// Window radius property
+static PropertyDescriptor windowRadiusProperty =
+{ XVT_U2, "Window radius", "windowRadius", "Radius of the window used to calculate local mean brightness.", PropertyFlag_None };
+// Brightness difference property
+static PropertyDescriptor brightnessDifferenceProperty =
+{ XVT_R4, "Brightness difference", "brightnessDifference", "Brightness difference limit (percents) between a pixel and its local mean.", PropertyFlag_None };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &windowRadiusProperty, &brightnessDifferenceProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** BradleyThresholdPlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
+// Register the plug-in
+REGISTER_CPP_PLUGIN_WITH_PROPS
+(
+    PluginID,
+    PluginFamilyID_Thresholding,
+
+    PluginType_ImageProcessingFilter,
+    PluginVersion,
+    "Bradley Local Threshold",
+    "BradleyThreshold",
+    "Performs adaptive thresholding of grayscale image using local mean brightness.",
+
+    /* Long description */
+    "The plug-in implements the adaptive thresholding technique described by Derek Bradley and Gerhard Roth in "
+    "\"Adaptive Thresholding Using the Integral Image\". For every pixel it calculates mean brightness of the "
+    "surrounding window, which has <b>radius * 2 + 1</b> size. The pixel is set to black if its value is smaller "
+    "than the mean brightness by more than the specified <b>brightness difference</b> percents. Otherwise it is set "
+    "to white.<br><br>"
+
+    "The mean values are calculated using integral image, so the time required to process an image does not depend "
+    "on the window size."
+    ,
+    &image_thresholding_plugin_16x16,
+    0,
+    BradleyThresholdPlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    0, // no clean-up
+    0  // no dynamic properties update
+);
+
+// Complete properties description by initializing those parts, which were not 
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    // Window radius property
+    windowRadiusProperty.DefaultValue.type = XVT_U2;
+    windowRadiusProperty.DefaultValue.value.usVal = 20;
+
+    windowRadiusProperty.MinValue.type = XVT_U2;
+    windowRadiusProperty.MinValue.value.usVal = 1;
+
+    windowRadiusProperty.MaxValue.type = XVT_U2;
+    windowRadiusProperty.MaxValue.value.usVal = 500;
+
+    // Brightness difference property
+    brightnessDifferenceProperty.DefaultValue.type = XVT_R4;
+    brightnessDifferenceProperty.DefaultValue.value.fVal = 15.0f;
+
+    brightnessDifferenceProperty.MinValue.type = XVT_R4;
+    brightnessDifferenceProperty.MinValue.value.fVal = 0.0f;
+
+    brightnessDifferenceProperty.MaxValue.type = XVT_R4;
+    brightnessDifferenceProperty.MaxValue.value.fVal = 100.0f;
+}
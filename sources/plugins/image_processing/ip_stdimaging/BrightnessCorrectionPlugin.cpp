@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include <ximaging.h>
 #include "BrightnessCorrectionPlugin.hpp"
 
@@ -73,15 +74,7 @@ XErrorCode BrightnessCorrectionPlugin::ProcessImage( const ximage* src, ximage**
 // Process the specified source image by changing it
 XErrorCode BrightnessCorrectionPlugin::ProcessImageInPlace( ximage* src )
 {
-    XErrorCode ret = SuccessCode;
-
-    if ( needUpdate )
-    {
-        bool inverseGammaFilter = ( factor > 0.0f );
-        float gamma             = ( inverseGammaFilter ) ? factor + 1 : -factor + 1;
-
-        ret = CalculateGammaCorrectionMap( gammaMap, gamma, inverseGammaFilter );
-    }
+    XErrorCode ret = UpdateMap( );
 
     if ( ret == SuccessCode )
     {
@@ -106,6 +99,56 @@ XErrorCode BrightnessCorrectionPlugin::ProcessImageInPlace( ximage* src )
     return ret;
 }
 
+// Process the specified region of an image in place
+XErrorCode BrightnessCorrectionPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up tables doing the same as the filter, so it could be combined with other point-wise operations
+XErrorCode BrightnessCorrectionPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+    XErrorCode ret = UpdateMap( );
+
+    if ( ret == SuccessCode )
+    {
+        if ( format == XPixelFormatGrayscale8 )
+        {
+            memcpy( maps, gammaMap, 256 );
+        }
+        else if ( ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) )
+        {
+            memcpy( maps,       ( processRed )   ? gammaMap : identityMap, 256 );
+            memcpy( maps + 256, ( processGreen ) ? gammaMap : identityMap, 256 );
+            memcpy( maps + 512, ( processBlue )  ? gammaMap : identityMap, 256 );
+        }
+        else
+        {
+            ret = ErrorUnsupportedPixelFormat;
+        }
+    }
+
+    return ret;
+}
+
+// Re-calculate gamma correction map if the factor has changed
+XErrorCode BrightnessCorrectionPlugin::UpdateMap( )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( needUpdate )
+    {
+        bool inverseGammaFilter = ( factor > 0.0f );
+        float gamma             = ( inverseGammaFilter ) ? factor + 1 : -factor + 1;
+
+        needUpdate = false;
+
+        ret = CalculateGammaCorrectionMap( gammaMap, gamma, inverseGammaFilter );
+    }
+
+    return ret;
+}
+
 // Get the specified property value of the plug-in
 XErrorCode BrightnessCorrectionPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
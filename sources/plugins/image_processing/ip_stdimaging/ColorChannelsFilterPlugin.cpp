@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include <ximaging.h>
 #include "ColorChannelsFilterPlugin.hpp"
 
@@ -80,6 +81,31 @@ XErrorCode ColorChannelsFilterPlugin::ProcessImageInPlace( ximage* src )
     return ColorRemapping( src, redMap, greenMap, blueMap );
 }
 
+// Process the specified region of an image in place
+XErrorCode ColorChannelsFilterPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up tables doing the same as the filter, so it could be combined with other point-wise operations
+XErrorCode ColorChannelsFilterPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) )
+    {
+        memcpy( maps,       redMap,   256 );
+        memcpy( maps + 256, greenMap, 256 );
+        memcpy( maps + 512, blueMap,  256 );
+    }
+    else
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+
+    return ret;
+}
+
 // Get specified property value of the plug-in
 XErrorCode ColorChannelsFilterPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
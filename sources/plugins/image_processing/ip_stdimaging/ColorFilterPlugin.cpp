@@ -77,6 +77,12 @@ XErrorCode ColorFilterPlugin::ProcessImageInPlace( ximage* src )
     return ColorFiltering( src, minRed, maxRed, minGreen, maxGreen, minBlue, maxBlue, fillOutside, fillColor );
 }
 
+// Process the specified region of an image in place
+XErrorCode ColorFilterPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
 // Get specified property value of the plug-in
 XErrorCode ColorFilterPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
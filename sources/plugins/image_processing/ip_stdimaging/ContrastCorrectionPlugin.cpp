@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include <ximaging.h>
 #include "ContrastCorrectionPlugin.hpp"
 
@@ -73,17 +74,7 @@ XErrorCode ContrastCorrectionPlugin::ProcessImage( const ximage* src, ximage** d
 // Process the specified source image by changing it
 XErrorCode ContrastCorrectionPlugin::ProcessImageInPlace( ximage* src )
 {
-    XErrorCode ret = SuccessCode;
-
-    if ( needUpdate )
-    {
-        bool inverseGammaFilter = ( factor < 0.0f );
-        float sCurveFactor      = ( inverseGammaFilter ) ? -factor + 1 : factor + 1;
-
-        needUpdate = false;
-
-        ret = CalculateSCurveMap( gammaMap, sCurveFactor, inverseGammaFilter );
-    }
+    XErrorCode ret = UpdateMap( );
 
     if ( ret == SuccessCode )
     {
@@ -108,6 +99,56 @@ XErrorCode ContrastCorrectionPlugin::ProcessImageInPlace( ximage* src )
     return ret;
 }
 
+// Process the specified region of an image in place
+XErrorCode ContrastCorrectionPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up tables doing the same as the filter, so it could be combined with other point-wise operations
+XErrorCode ContrastCorrectionPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+    XErrorCode ret = UpdateMap( );
+
+    if ( ret == SuccessCode )
+    {
+        if ( format == XPixelFormatGrayscale8 )
+        {
+            memcpy( maps, gammaMap, 256 );
+        }
+        else if ( ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) )
+        {
+            memcpy( maps,       ( processRed )   ? gammaMap : identityMap, 256 );
+            memcpy( maps + 256, ( processGreen ) ? gammaMap : identityMap, 256 );
+            memcpy( maps + 512, ( processBlue )  ? gammaMap : identityMap, 256 );
+        }
+        else
+        {
+            ret = ErrorUnsupportedPixelFormat;
+        }
+    }
+
+    return ret;
+}
+
+// Re-calculate S-curve map if the factor has changed
+XErrorCode ContrastCorrectionPlugin::UpdateMap( )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( needUpdate )
+    {
+        bool inverseGammaFilter = ( factor < 0.0f );
+        float sCurveFactor      = ( inverseGammaFilter ) ? -factor + 1 : factor + 1;
+
+        needUpdate = false;
+
+        ret = CalculateSCurveMap( gammaMap, sCurveFactor, inverseGammaFilter );
+    }
+
+    return ret;
+}
+
 // Get the specified property value of the plug-in
 XErrorCode ContrastCorrectionPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
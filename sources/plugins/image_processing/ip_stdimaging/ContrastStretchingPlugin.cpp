@@ -74,6 +74,19 @@ XErrorCode ContrastStretchingPlugin::ProcessImageInPlace( ximage* src )
     return ContrastStretching( src );
 }
 
+// Process the specified region of an image in place
+XErrorCode ContrastStretchingPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Process the specified source image by changing it, using its already calculated histograms
+XErrorCode ContrastStretchingPlugin::ProcessImageWithHistograms( ximage* src, const xhistogram* redHistogram,
+                                                                 const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    return ContrastStretchingUsingHistograms( src, redHistogram, greenHistogram, blueHistogram );
+}
+
 // No properties to get/set
 XErrorCode ContrastStretchingPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -125,6 +125,12 @@ XErrorCode ConvolutionPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode ConvolutionPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, static_cast<int32_t>( kernelSize / 2 ) );
+}
+
 // Get specified property value of the plug-in
 XErrorCode ConvolutionPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
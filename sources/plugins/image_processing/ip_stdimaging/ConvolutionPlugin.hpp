@@ -46,6 +46,7 @@ public:
     XErrorCode GetPixelFormatTranslations( XPixelFormat* inputFormats, XPixelFormat* outputFormats, int32_t* count );
     XErrorCode ProcessImage( const ximage* src, ximage** dst );
     XErrorCode ProcessImageInPlace( ximage* src );
+    XErrorCode ProcessImageRegion( ximage* src, const xrect* region );
 
 private:
     static const PropertyDescriptor** propertiesDescription;
@@ -125,6 +125,12 @@ XErrorCode DilatationPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode DilatationPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, radius );
+}
+
 // Get the specified property value of the plug-in
 XErrorCode DilatationPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -76,6 +76,12 @@ XErrorCode DistanceColorFilterPlugin::ProcessImageInPlace( ximage* src )
     return ColorFilteringByDistance( src, sampleColor, maxDistance, distanceType, fillOutside, fillColor );
 }
 
+// Process the specified region of an image in place
+XErrorCode DistanceColorFilterPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
 // Get specified property value of the plug-in
 XErrorCode DistanceColorFilterPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -28,10 +28,16 @@ const XPixelFormat DistanceTransformationPlugin::supportedFormats[] =
     XPixelFormatGrayscale8,
 };
 
-DistanceTransformationPlugin::DistanceTransformationPlugin( )
+DistanceTransformationPlugin::DistanceTransformationPlugin( ) :
+    distanceTo( 0 ), outputMode( 0 ), tempDistanceMap( nullptr )
 {
 }
 
+DistanceTransformationPlugin::~DistanceTransformationPlugin( )
+{
+    XImageFree( &tempDistanceMap );
+}
+
 void DistanceTransformationPlugin::Dispose( )
 {
     delete this;
@@ -40,7 +46,7 @@ void DistanceTransformationPlugin::Dispose( )
 // The plug-in can process image in-place without creating new image as a result
 bool DistanceTransformationPlugin::CanProcessInPlace( )
 {
-    return false;
+    return true;
 }
 
 // Provide supported pixel formats
@@ -52,32 +58,78 @@ XErrorCode DistanceTransformationPlugin::GetPixelFormatTranslations( XPixelForma
 
 // Process the specified source image and return new as a result
 XErrorCode DistanceTransformationPlugin::ProcessImage( const ximage* src, ximage** dst )
+{
+    XErrorCode ret = XImageClone( src, dst );
+
+    if ( ret == SuccessCode )
+    {
+        ret = ProcessImageInPlace( *dst );
+
+        if ( ret != SuccessCode )
+        {
+            XImageFree( dst );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified source image by changing it
+XErrorCode DistanceTransformationPlugin::ProcessImageInPlace( ximage* src )
 {
     XErrorCode ret = SuccessCode;
 
-    if ( ( src == 0 ) || ( dst == 0 ) )
+    if ( src == nullptr )
     {
         ret = ErrorNullParameter;
     }
     else
     {
-        // create output image of required format
-        if ( src->format == XPixelFormatGrayscale8 )
-        {
-            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale8, dst );
-        }
-        else
+        ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscaleR4, &tempDistanceMap );
+
+        if ( ret == SuccessCode )
         {
-            ret = ErrorUnsupportedPixelFormat;
+            ret = EuclideanDistanceTransformation( src, tempDistanceMap, nullptr, ( distanceTo == 1 ) );
         }
 
         if ( ret == SuccessCode )
         {
-            ret = DistanceTransformation( src, *dst );
+            int   width  = src->width;
+            int   height = src->height;
+            float factor = 1.0f;
+            float maxDistance;
+            int   x, y;
+
+            // find max distance to normalize the map
+            if ( outputMode == 1 )
+            {
+                maxDistance = 0.0f;
+
+                for ( y = 0; y < height; y++ )
+                {
+                    const float* mapRow = reinterpret_cast<const float*>( tempDistanceMap->data + y * tempDistanceMap->stride );
+
+                    for ( x = 0; x < width; x++ )
+                    {
+                        maxDistance = XMAX( maxDistance, mapRow[x] );
+                    }
+                }
+
+                if ( maxDistance > 0.0f )
+                {
+                    factor = 255.0f / maxDistance;
+                }
+            }
 
-            if ( ret != SuccessCode )
+            for ( y = 0; y < height; y++ )
             {
-                XImageFree( dst );
+                const float* mapRow = reinterpret_cast<const float*>( tempDistanceMap->data + y * tempDistanceMap->stride );
+                uint8_t*     srcRow = src->data + y * src->stride;
+
+                for ( x = 0; x < width; x++ )
+                {
+                    srcRow[x] = static_cast<uint8_t>( XMIN( 255.0f, mapRow[x] * factor + 0.5f ) );
+                }
             }
         }
     }
@@ -85,26 +137,57 @@ XErrorCode DistanceTransformationPlugin::ProcessImage( const ximage* src, ximage
     return ret;
 }
 
-// Process the specified source image by changing it
-XErrorCode DistanceTransformationPlugin::ProcessImageInPlace( ximage* src )
-{
-    XUNREFERENCED_PARAMETER( src )
-
-    return ErrorNotImplemented;
-}
-
-// No properties to get/set
+// Get specified property value of the plug-in
 XErrorCode DistanceTransformationPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
-    XUNREFERENCED_PARAMETER( id )
-    XUNREFERENCED_PARAMETER( value )
+    XErrorCode ret = SuccessCode;
+
+    switch ( id )
+    {
+    case 0:
+        value->type = XVT_U1;
+        value->value.ubVal = distanceTo;
+        break;
+
+    case 1:
+        value->type = XVT_U1;
+        value->value.ubVal = outputMode;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+        break;
+    }
 
-    return ErrorInvalidProperty;
+    return ret;
 }
+
+// Set specified property value of the plug-in
 XErrorCode DistanceTransformationPlugin::SetProperty( int32_t id, const xvariant* value )
 {
-    XUNREFERENCED_PARAMETER( id )
-    XUNREFERENCED_PARAMETER( value )
+    XErrorCode ret = SuccessCode;
+
+    xvariant convertedValue;
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 2, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            distanceTo = XINRANGE( convertedValue.value.ubVal, 0, 1 );
+            break;
 
-    return ErrorInvalidProperty;
+        case 1:
+            outputMode = XINRANGE( convertedValue.value.ubVal, 0, 1 );
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
 }
@@ -29,6 +29,7 @@ class DistanceTransformationPlugin : public IImageProcessingFilterPlugin
 {
 public:
     DistanceTransformationPlugin( );
+    ~DistanceTransformationPlugin( );
 
     // IPluginBase interface
     void Dispose( );
@@ -43,7 +44,12 @@ public:
     XErrorCode ProcessImageInPlace( ximage* src );
 
 private:
+    static const PropertyDescriptor** propertiesDescription;
     static const XPixelFormat supportedFormats[];
+
+    uint8_t distanceTo;
+    uint8_t outputMode;
+    ximage* tempDistanceMap;
 };
 
 #endif // CVS_DISTANCE_TRANSFORMATION_PLUGIN_HPP
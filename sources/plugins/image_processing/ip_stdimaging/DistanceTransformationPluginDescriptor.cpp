@@ -20,18 +20,36 @@
 */
 
 #include <iplugincpp.hpp>
-//#include <image_binary_erosion_16x16.h>
+#include <image_objects_thinning_16x16.h>
 #include "DistanceTransformationPlugin.hpp"
 
+static void PluginInitializer( );
+static void PluginCleaner( );
+
 // Version of the plug-in
 static xversion PluginVersion = { 1, 0, 0 };
 
 // ID of the plug-in
 static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000001, 0x0000001E };
 
-/*
+// Distance to property
+static PropertyDescriptor distanceToProperty =
+{ XVT_U1, "Distance to", "distanceTo", "Specifies pixels to calculate distance to.", PropertyFlag_SelectionByIndex };
+// Output mode property
+static PropertyDescriptor outputModeProperty =
+{ XVT_U1, "Output", "output", "Specifies how distance is represented in the result image.", PropertyFlag_SelectionByIndex };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &distanceToProperty, &outputModeProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** DistanceTransformationPlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
 // Register the plug-in
-REGISTER_CPP_PLUGIN
+REGISTER_CPP_PLUGIN_WITH_PROPS
 (
     PluginID,
     PluginFamilyID_Morphology,
@@ -40,10 +58,91 @@ REGISTER_CPP_PLUGIN
     PluginVersion,
     "Distance Transformation",
     "DistanceTransformation",
-    "Calculates distance transformation for a binary image showing objects' thickness.",
-    "Some help about this routine.",
-    0, //&image_binary_erosion_16x16,
+    "Calculates exact Euclidean distance transformation for a binary image showing objects' thickness.",
+
+    /* Long description */
+    "The plug-in calculates distance map for a binary image - each object pixel (non zero) is set to its Euclidean "
+    "distance to the nearest background pixel (pixels outside of image are treated as background). If <b>distance to</b> "
+    "is set to <b>Objects</b>, then each background pixel is set to its distance to the nearest object pixel instead, "
+    "while object pixels are set to 0.<br><br>"
+
+    "The <b>Distance</b> output keeps distance values as is, clipping them at 255. The <b>Normalized distance</b> "
+    "output scales the map so the largest distance becomes 255.<br><br>"
+
+    "The distance transformation is exact and takes linear time, so its performance does not depend on objects' size. "
+    "Squared distances, real valued distances and map of the nearest pixels are available for scripting through the "
+    "imaging library."
+    ,
+    &image_objects_thinning_16x16,
     0,
-    DistanceTransformationPlugin
+    DistanceTransformationPlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    PluginCleaner,
+    nullptr  // no dynamic properties update
 );
-*/
+
+// Complete properties description by initializing those parts, which were not 
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    static const char* distanceToNames[] = { "Background", "Objects" };
+    static const char* outputModeNames[] = { "Distance", "Normalized distance" };
+
+    // Distance to property
+    distanceToProperty.DefaultValue.type = XVT_U1;
+    distanceToProperty.DefaultValue.value.ubVal = 0;
+
+    distanceToProperty.MinValue.type = XVT_U1;
+    distanceToProperty.MinValue.value.ubVal = 0;
+
+    distanceToProperty.MaxValue.type = XVT_U1;
+    distanceToProperty.MaxValue.value.ubVal = XARRAY_SIZE( distanceToNames ) - 1;
+
+    distanceToProperty.ChoicesCount = XARRAY_SIZE( distanceToNames );
+    distanceToProperty.Choices = new xvariant[distanceToProperty.ChoicesCount];
+
+    for ( int i = 0; i < distanceToProperty.ChoicesCount; i++ )
+    {
+        distanceToProperty.Choices[i].type = XVT_String;
+        distanceToProperty.Choices[i].value.strVal = XStringAlloc( distanceToNames[i] );
+    }
+
+    // Output mode property
+    outputModeProperty.DefaultValue.type = XVT_U1;
+    outputModeProperty.DefaultValue.value.ubVal = 0;
+
+    outputModeProperty.MinValue.type = XVT_U1;
+    outputModeProperty.MinValue.value.ubVal = 0;
+
+    outputModeProperty.MaxValue.type = XVT_U1;
+    outputModeProperty.MaxValue.value.ubVal = XARRAY_SIZE( outputModeNames ) - 1;
+
+    outputModeProperty.ChoicesCount = XARRAY_SIZE( outputModeNames );
+    outputModeProperty.Choices = new xvariant[outputModeProperty.ChoicesCount];
+
+    for ( int i = 0; i < outputModeProperty.ChoicesCount; i++ )
+    {
+        outputModeProperty.Choices[i].type = XVT_String;
+        outputModeProperty.Choices[i].value.strVal = XStringAlloc( outputModeNames[i] );
+    }
+}
+
+// Clean-up plug-in - deallocate strings
+static void PluginCleaner( )
+{
+    for ( int i = 0; i < distanceToProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &distanceToProperty.Choices[i] );
+    }
+
+    for ( int i = 0; i < outputModeProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &outputModeProperty.Choices[i] );
+    }
+
+    delete[] distanceToProperty.Choices;
+    delete[] outputModeProperty.Choices;
+}
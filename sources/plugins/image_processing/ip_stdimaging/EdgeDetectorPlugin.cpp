@@ -94,6 +94,12 @@ XErrorCode EdgeDetectorPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode EdgeDetectorPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 1 );
+}
+
 // Get specified property value of the plug-in
 XErrorCode EdgeDetectorPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -95,6 +95,12 @@ XErrorCode Erosion3x3Plugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode Erosion3x3Plugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 1 );
+}
+
 // No properties to get/set
 XErrorCode Erosion3x3Plugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -124,6 +124,12 @@ XErrorCode ErosionPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode ErosionPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, radius );
+}
+
 // Get the specified property value of the plug-in
 XErrorCode ErosionPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -129,6 +129,12 @@ XErrorCode GaussianBlurPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode GaussianBlurPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, radius );
+}
+
 // Get the specified property value of the plug-in
 XErrorCode GaussianBlurPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -74,6 +74,19 @@ XErrorCode GrayWorldNormalizationPlugin::ProcessImageInPlace( ximage* src )
     return GrayWorldNormalization( src );
 }
 
+// Process the specified region of an image in place
+XErrorCode GrayWorldNormalizationPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Process the specified source image by changing it, using its already calculated histograms
+XErrorCode GrayWorldNormalizationPlugin::ProcessImageWithHistograms( ximage* src, const xhistogram* redHistogram,
+                                                                     const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    return GrayWorldNormalizationUsingHistograms( src, redHistogram, greenHistogram, blueHistogram );
+}
+
 // No properties to get/set
 XErrorCode GrayWorldNormalizationPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -74,6 +74,19 @@ XErrorCode HistogramEqualizationPlugin::ProcessImageInPlace( ximage* src )
     return HistogramEqualization( src );
 }
 
+// Process the specified region of an image in place
+XErrorCode HistogramEqualizationPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Process the specified source image by changing it, using its already calculated histograms
+XErrorCode HistogramEqualizationPlugin::ProcessImageWithHistograms( ximage* src, const xhistogram* redHistogram,
+                                                                    const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    return HistogramEqualizationUsingHistograms( src, redHistogram, greenHistogram, blueHistogram );
+}
+
 // No properties to get/set
 XErrorCode HistogramEqualizationPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
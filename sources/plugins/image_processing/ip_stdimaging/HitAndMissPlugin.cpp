@@ -26,7 +26,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat HitAndMissPlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8
+    XPixelFormatGrayscale8, XPixelFormatBinary1
 };
 
 HitAndMissPlugin::HitAndMissPlugin( ) :
@@ -75,7 +75,7 @@ XErrorCode HitAndMissPlugin::ProcessImage( const ximage* src, ximage** dst )
     else
     {
         // create output image of required format
-        if ( src->format == XPixelFormatGrayscale8 )
+        if ( ( src->format == XPixelFormatGrayscale8 ) || ( src->format == XPixelFormatBinary1 ) )
         {
             ret = XImageAllocateRaw( src->width, src->height, src->format, dst );
         }
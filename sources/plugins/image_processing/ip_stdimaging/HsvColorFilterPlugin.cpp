@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <new>
 #include <ximaging.h>
 #include "HsvColorFilterPlugin.hpp"
 
@@ -32,11 +33,23 @@ namespace Private
         bool  FillOutside;
         xargb FillColor;
 
+        // map telling which RGB colors are in the HSV range - rebuilt only when the range changes
+        uint8_t* ColorClassMap;
+        bool     IsColorClassMapValid;
+        // number of pixels filtered without the map since the range was changed
+        uint32_t PixelsFilteredWithoutMap;
+
     public:
         HsvColorFilterPluginData( ) :
             MinValues( { 0, 0.0f, 0.0f } ), MaxValues( { 359, 1.0f, 1.0f } ), 
-            FillOutside( true ), FillColor( { 0xFF000000 }  )
+            FillOutside( true ), FillColor( { 0xFF000000 }  ),
+            ColorClassMap( nullptr ), IsColorClassMapValid( false ), PixelsFilteredWithoutMap( 0 )
+        {
+        }
+
+        ~HsvColorFilterPluginData( )
         {
+            delete [] ColorClassMap;
         }
     };
 
@@ -97,7 +110,53 @@ XErrorCode HsvColorFilterPlugin::ProcessImage( const ximage* src, ximage** dst )
 // Process the specified source image by changing it
 XErrorCode HsvColorFilterPlugin::ProcessImageInPlace( ximage* src )
 {
-    return HsvColorFiltering( src, mData->MinValues, mData->MaxValues, mData->FillOutside, mData->FillColor );
+    XErrorCode ret = SuccessCode;
+
+    if ( ( !mData->IsColorClassMapValid ) && ( mData->PixelsFilteredWithoutMap < XCOLOR_CLASS_MAP_SIZE * 8 ) )
+    {
+        // building the map costs as much as converting one pixel of each RGB color, so it is not done until
+        // as many pixels are filtered with the same range - changing the range every frame never pays for it
+        ret = HsvColorFiltering( src, mData->MinValues, mData->MaxValues, mData->FillOutside, mData->FillColor );
+
+        if ( ret == SuccessCode )
+        {
+            mData->PixelsFilteredWithoutMap += static_cast<uint32_t>( src->width ) * src->height;
+        }
+    }
+    else
+    {
+        if ( mData->ColorClassMap == nullptr )
+        {
+            mData->ColorClassMap = new (std::nothrow) uint8_t[XCOLOR_CLASS_MAP_SIZE];
+        }
+
+        if ( mData->ColorClassMap == nullptr )
+        {
+            // not enough memory for the map, so do color space conversion for every pixel
+            ret = HsvColorFiltering( src, mData->MinValues, mData->MaxValues, mData->FillOutside, mData->FillColor );
+        }
+        else
+        {
+            if ( !mData->IsColorClassMapValid )
+            {
+                ret = BuildHsvColorClassMap( mData->ColorClassMap, mData->MinValues, mData->MaxValues );
+                mData->IsColorClassMapValid = ( ret == SuccessCode );
+            }
+
+            if ( ret == SuccessCode )
+            {
+                ret = ColorClassFiltering( src, mData->ColorClassMap, mData->FillOutside, mData->FillColor );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place
+XErrorCode HsvColorFilterPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
 }
 
 // Get specified property value of the plug-in
@@ -162,20 +221,38 @@ XErrorCode HsvColorFilterPlugin::SetProperty( int32_t id, const xvariant* value
         {
             case 0:
                 XRangeIntersect( &convertedValue.value.rangeVal, &validHueRange );
-                mData->MinValues.Hue = static_cast<uint16_t>( convertedValue.value.rangeVal.min );
-                mData->MaxValues.Hue = static_cast<uint16_t>( convertedValue.value.rangeVal.max );
+                if ( ( mData->MinValues.Hue != static_cast<uint16_t>( convertedValue.value.rangeVal.min ) ) ||
+                     ( mData->MaxValues.Hue != static_cast<uint16_t>( convertedValue.value.rangeVal.max ) ) )
+                {
+                    mData->MinValues.Hue = static_cast<uint16_t>( convertedValue.value.rangeVal.min );
+                    mData->MaxValues.Hue = static_cast<uint16_t>( convertedValue.value.rangeVal.max );
+                    mData->IsColorClassMapValid     = false;
+                    mData->PixelsFilteredWithoutMap = 0;
+                }
                 break;
 
             case 1: 
                 XRangeIntersectF( &convertedValue.value.frangeVal, &validSLRange );
-                mData->MinValues.Saturation = convertedValue.value.frangeVal.min;
-                mData->MaxValues.Saturation = convertedValue.value.frangeVal.max;
+                if ( ( mData->MinValues.Saturation != convertedValue.value.frangeVal.min ) ||
+                     ( mData->MaxValues.Saturation != convertedValue.value.frangeVal.max ) )
+                {
+                    mData->MinValues.Saturation = convertedValue.value.frangeVal.min;
+                    mData->MaxValues.Saturation = convertedValue.value.frangeVal.max;
+                    mData->IsColorClassMapValid     = false;
+                    mData->PixelsFilteredWithoutMap = 0;
+                }
                 break;
 
             case 2: 
                 XRangeIntersectF( &convertedValue.value.frangeVal, &validSLRange );
-                mData->MinValues.Value = convertedValue.value.frangeVal.min;
-                mData->MaxValues.Value = convertedValue.value.frangeVal.max;
+                if ( ( mData->MinValues.Value != convertedValue.value.frangeVal.min ) ||
+                     ( mData->MaxValues.Value != convertedValue.value.frangeVal.max ) )
+                {
+                    mData->MinValues.Value = convertedValue.value.frangeVal.min;
+                    mData->MaxValues.Value = convertedValue.value.frangeVal.max;
+                    mData->IsColorClassMapValid     = false;
+                    mData->PixelsFilteredWithoutMap = 0;
+                }
                 break;
 
             case 3:
@@ -136,6 +136,28 @@ static uint32_t CalculateRange( const xhistogram* hist, float range, xrange* ran
 
 // Process the specified source image and return new as a result
 XErrorCode ImageStatisticsPlugin::ProcessImage( const ximage* image )
+{
+    return CollectStatistics( image, nullptr, nullptr, nullptr );
+}
+
+// Process the specified source image using its already calculated histograms
+XErrorCode ImageStatisticsPlugin::ProcessImageWithHistograms( const ximage* image, const xhistogram* redHistogram,
+                                                              const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    XErrorCode ret = ErrorNullParameter;
+
+    if ( ( image != nullptr ) && ( redHistogram != nullptr ) &&
+         ( ( image->format == XPixelFormatGrayscale8 ) || ( ( greenHistogram != nullptr ) && ( blueHistogram != nullptr ) ) ) )
+    {
+        ret = CollectStatistics( image, redHistogram, greenHistogram, blueHistogram );
+    }
+
+    return ret;
+}
+
+// Collect statistics of the image - histograms are calculated if they are not provided
+XErrorCode ImageStatisticsPlugin::CollectStatistics( const ximage* image, const xhistogram* redHistogram,
+                                                     const xhistogram* greenHistogram, const xhistogram* blueHistogram )
 {
     XErrorCode ret = SuccessCode;
 
@@ -153,7 +175,15 @@ XErrorCode ImageStatisticsPlugin::ProcessImage( const ximage* image )
     }
     else if ( ( image->format == XPixelFormatRGB24 ) || ( image->format == XPixelFormatRGBA32 ) )
     {
-        ret = GetColorImageHistograms( image, mData->RedHistogram, mData->GreenHistogram, mData->BlueHistogram );
+        if ( redHistogram == nullptr )
+        {
+            ret = GetColorImageHistograms( image, mData->RedHistogram, mData->GreenHistogram, mData->BlueHistogram );
+        }
+        else if ( ( ( ret = XHistogramCopy( redHistogram,   mData->RedHistogram   ) ) == SuccessCode ) &&
+                  ( ( ret = XHistogramCopy( greenHistogram, mData->GreenHistogram ) ) == SuccessCode ) )
+        {
+            ret = XHistogramCopy( blueHistogram, mData->BlueHistogram );
+        }
 
         if ( ret == SuccessCode )
         {
@@ -164,8 +194,8 @@ XErrorCode ImageStatisticsPlugin::ProcessImage( const ximage* image )
     }
     else if ( image->format == XPixelFormatGrayscale8 )
     {
-
-        ret = GetGrayscaleImageHistogram( image, mData->GrayHistogram );
+        ret = ( redHistogram == nullptr ) ? GetGrayscaleImageHistogram( image, mData->GrayHistogram ) :
+                                            XHistogramCopy( redHistogram, mData->GrayHistogram );
 
         if ( ret == SuccessCode )
         {
@@ -46,6 +46,12 @@ public:
     // IImageProcessingPlugin interface
     XErrorCode GetSupportedPixelFormats( XPixelFormat* formats, int32_t* count );
     XErrorCode ProcessImage( const ximage* image );
+    XErrorCode ProcessImageWithHistograms( const ximage* image, const xhistogram* redHistogram,
+                                           const xhistogram* greenHistogram, const xhistogram* blueHistogram );
+
+private:
+    XErrorCode CollectStatistics( const ximage* image, const xhistogram* redHistogram,
+                                  const xhistogram* greenHistogram, const xhistogram* blueHistogram );
 
 private:
     static const XPixelFormat supportedFormats[];
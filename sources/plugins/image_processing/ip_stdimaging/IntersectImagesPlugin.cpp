@@ -26,7 +26,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat IntersectImagesPlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32, XPixelFormatBinary1
 };
 
 void IntersectImagesPlugin::Dispose( )
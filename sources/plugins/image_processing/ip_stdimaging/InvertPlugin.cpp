@@ -75,6 +75,12 @@ XErrorCode InvertPlugin::ProcessImageInPlace( ximage* src )
     return InvertImage( src );
 }
 
+// Process the specified region of an image in place
+XErrorCode InvertPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
 // No properties to get/set
 XErrorCode InvertPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -90,3 +96,24 @@ XErrorCode InvertPlugin::SetProperty( int32_t id, const xvariant* value )
 
     return ErrorInvalidProperty;
 }
+
+// Provide look-up tables doing the same as the filter for 8 bpp grayscale and 24/32 bpp color images,
+// so it could be combined with other point-wise operations
+XErrorCode InvertPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( format == XPixelFormatGrayscale8 ) || ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) )
+    {
+        for ( int i = 0; i < 256; i++ )
+        {
+            maps[i] = maps[i + 256] = maps[i + 512] = static_cast<uint8_t>( 255 - i );
+        }
+    }
+    else
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+
+    return ret;
+}
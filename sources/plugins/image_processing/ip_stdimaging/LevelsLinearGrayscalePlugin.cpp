@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include <ximaging.h>
 #include "LevelsLinearGrayscalePlugin.hpp"
 
@@ -87,6 +88,29 @@ XErrorCode LevelsLinearGrayscalePlugin::ProcessImageInPlace( ximage* src )
     return ret;
 }
 
+// Process the specified region of an image in place
+XErrorCode LevelsLinearGrayscalePlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+	return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up table doing the same as the filter, so it could be combined with other point-wise operations
+XErrorCode LevelsLinearGrayscalePlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+	XErrorCode ret = SuccessCode;
+
+	if ( format == XPixelFormatGrayscale8 )
+	{
+		memcpy( maps, grayMap, 256 );
+	}
+	else
+	{
+		ret = ErrorUnsupportedPixelFormat;
+	}
+
+	return ret;
+}
+
 // Get specified property value of the plug-in
 XErrorCode LevelsLinearGrayscalePlugin::GetProperty( int32_t id, xvariant* value ) const
 {
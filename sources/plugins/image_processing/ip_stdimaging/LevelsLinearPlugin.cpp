@@ -19,6 +19,7 @@
     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
 */
 
+#include <string.h>
 #include <ximaging.h>
 #include "LevelsLinearPlugin.hpp"
 
@@ -91,6 +92,31 @@ XErrorCode LevelsLinearPlugin::ProcessImageInPlace( ximage* src )
     return ret;
 }
 
+// Process the specified region of an image in place
+XErrorCode LevelsLinearPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+	return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up tables doing the same as the filter, so it could be combined with other point-wise operations
+XErrorCode LevelsLinearPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+	XErrorCode ret = SuccessCode;
+
+	if ( ( format == XPixelFormatRGB24 ) || ( format == XPixelFormatRGBA32 ) )
+	{
+		memcpy( maps,       redMap,   256 );
+		memcpy( maps + 256, greenMap, 256 );
+		memcpy( maps + 512, blueMap,  256 );
+	}
+	else
+	{
+		ret = ErrorUnsupportedPixelFormat;
+	}
+
+	return ret;
+}
+
 // Get specified property value of the plug-in
 XErrorCode LevelsLinearPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
@@ -0,0 +1,165 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <xvision.h>
+#include "LocalStatisticsPlugin.hpp"
+
+// Supported pixel formats of input/output images
+const XPixelFormat LocalStatisticsPlugin::supportedFormats[] =
+{
+    XPixelFormatGrayscale8
+};
+
+LocalStatisticsPlugin::LocalStatisticsPlugin( ) :
+    windowRadius( 5 ), statistics( LocalStatistics_Mean ), integralImage( nullptr ), sqIntegralImage( nullptr )
+{
+}
+
+void LocalStatisticsPlugin::Dispose( )
+{
+    XImageFree( &integralImage );
+    XImageFree( &sqIntegralImage );
+    delete this;
+}
+
+// The plug-in can process image in-place without creating new image as a result
+bool LocalStatisticsPlugin::CanProcessInPlace( )
+{
+    return true;
+}
+
+// Provide supported pixel formats
+XErrorCode LocalStatisticsPlugin::GetPixelFormatTranslations( XPixelFormat* inputFormats, XPixelFormat* outputFormats, int32_t* count )
+{
+    return GetPixelFormatTranslationsImpl( inputFormats, outputFormats, count, supportedFormats, supportedFormats,
+        XARRAY_SIZE( supportedFormats ) );
+}
+
+// Process the specified source image and return new as a result
+XErrorCode LocalStatisticsPlugin::ProcessImage( const ximage* src, ximage** dst )
+{
+    XErrorCode ret = XImageClone( src, dst );
+
+    if ( ret == SuccessCode )
+    {
+        ret = ProcessImageInPlace( *dst );
+
+        if ( ret != SuccessCode )
+        {
+            XImageFree( dst );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified source image by changing it
+XErrorCode LocalStatisticsPlugin::ProcessImageInPlace( ximage* src )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( src == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        // squared integral image is needed only for variance/deviation
+        bool needSquared = ( statistics != LocalStatistics_Mean );
+
+        ret = XImageAllocateRaw( src->width + 1, src->height + 1, XPixelFormatGrayscale64, &integralImage );
+
+        if ( ( ret == SuccessCode ) && ( needSquared ) )
+        {
+            ret = XImageAllocateRaw( src->width + 1, src->height + 1, XPixelFormatGrayscale64, &sqIntegralImage );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = BuildIntegralImage64( src, integralImage, ( needSquared ) ? sqIntegralImage : nullptr, 0 );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = LocalWindowStatistics( src, integralImage, sqIntegralImage, windowRadius, statistics );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode LocalStatisticsPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, windowRadius );
+}
+
+// Get the specified property value of the plug-in
+XErrorCode LocalStatisticsPlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode ret = SuccessCode;
+
+    switch ( id )
+    {
+    case 0:
+        value->type = XVT_U2;
+        value->value.usVal = windowRadius;
+        break;
+
+    case 1:
+        value->type = XVT_U1;
+        value->value.ubVal = statistics;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+    }
+
+    return ret;
+}
+
+// Set the specified property value of the plug-in
+XErrorCode LocalStatisticsPlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode ret = SuccessCode;
+
+    xvariant convertedValue;
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 2, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            windowRadius = XINRANGE( convertedValue.value.usVal, 1, 500 );
+            break;
+
+        case 1:
+            statistics = XINRANGE( convertedValue.value.ubVal, LocalStatistics_Mean, LocalStatistics_Variance );
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
+}
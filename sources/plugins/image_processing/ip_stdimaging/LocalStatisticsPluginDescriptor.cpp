@@ -0,0 +1,128 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <iplugincpp.hpp>
+#include <image_mean_3s_16x16.h>
+#include "LocalStatisticsPlugin.hpp"
+
+static void PluginInitializer( );
+static void PluginCleaner( );
+
+// Version of the plug-in
+static xversion PluginVersion = { 1, 0, 0 };
+
+// ID of the plug-in
+static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000001, 0x0000003F };
+
+// Window radius property
+static PropertyDescriptor windowRadiusProperty =
+{ XVT_U2, "Window radius", "windowRadius", "Radius of the window to calculate statistics for.", PropertyFlag_None };
+// Statistics property
+static PropertyDescriptor statisticsProperty =
+{ XVT_U1, "Statistics", "statistics", "Statistics value to calculate for each pixel.", PropertyFlag_SelectionByIndex };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &windowRadiusProperty, &statisticsProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** LocalStatisticsPlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
+// Register the plug-in
+REGISTER_CPP_PLUGIN_WITH_PROPS
+(
+    PluginID,
+    PluginFamilyID_ImageSmoothing,
+
+    PluginType_ImageProcessingFilter,
+    PluginVersion,
+    "Local Statistics",
+    "LocalStatistics",
+    "Replaces each pixel with mean, standard deviation or variance of its local window.",
+
+    /* Long description */
+    "The plug-in calculates the selected <b>statistics</b> value of the window surrounding each pixel, which has "
+    "<b>radius * 2 + 1</b> size, and puts it into the result image. Windows of pixels close to image edges are "
+    "cropped by image boundaries. <b>Mean</b> statistics results in box blur of the image, while <b>standard "
+    "deviation</b> and <b>variance</b> provide maps of local contrast. Variance values above 255 are clipped.<br><br>"
+
+    "The statistics are calculated using integral images, so the time required to process an image does not "
+    "depend on the window size."
+    ,
+    &image_mean_3s_16x16,
+    0,
+    LocalStatisticsPlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    PluginCleaner,
+    nullptr  // no dynamic properties update
+);
+
+// Complete properties description by initializing those parts, which were not 
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    static const char* statisticsNames[] = { "Mean", "Standard deviation", "Variance" };
+
+    // Window radius property
+    windowRadiusProperty.DefaultValue.type = XVT_U2;
+    windowRadiusProperty.DefaultValue.value.usVal = 5;
+
+    windowRadiusProperty.MinValue.type = XVT_U2;
+    windowRadiusProperty.MinValue.value.usVal = 1;
+
+    windowRadiusProperty.MaxValue.type = XVT_U2;
+    windowRadiusProperty.MaxValue.value.usVal = 500;
+
+    // Statistics property
+    statisticsProperty.DefaultValue.type = XVT_U1;
+    statisticsProperty.DefaultValue.value.ubVal = 0;
+
+    statisticsProperty.MinValue.type = XVT_U1;
+    statisticsProperty.MinValue.value.ubVal = 0;
+
+    statisticsProperty.MaxValue.type = XVT_U1;
+    statisticsProperty.MaxValue.value.ubVal = XARRAY_SIZE( statisticsNames ) - 1;
+
+    statisticsProperty.ChoicesCount = XARRAY_SIZE( statisticsNames );
+    statisticsProperty.Choices = new xvariant[statisticsProperty.ChoicesCount];
+
+    for ( int i = 0; i < statisticsProperty.ChoicesCount; i++ )
+    {
+        statisticsProperty.Choices[i].type = XVT_String;
+        statisticsProperty.Choices[i].value.strVal = XStringAlloc( statisticsNames[i] );
+    }
+}
+
+// Clean-up plug-in - deallocate strings
+static void PluginCleaner( )
+{
+    for ( int i = 0; i < statisticsProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &statisticsProperty.Choices[i] );
+    }
+
+    delete[] statisticsProperty.Choices;
+}
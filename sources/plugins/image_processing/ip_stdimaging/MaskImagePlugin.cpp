@@ -26,7 +26,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat MaskImagePlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32, XPixelFormatBinary1
 };
 
 MaskImagePlugin::MaskImagePlugin( ) :
@@ -63,8 +63,9 @@ XSupportedImageSize MaskImagePlugin::GetSecondImageSupportedSize( )
 
 XPixelFormat MaskImagePlugin::GetSecondImageSupportedFormat( XPixelFormat inputPixelFormat )
 {
-    return ( IsPixelFormatSupportedImpl( supportedFormats, XARRAY_SIZE( supportedFormats ), inputPixelFormat ) ) ?
-             XPixelFormatGrayscale8 : XPixelFormatUnknown;
+    // binary images are masked with binary mask, so the two stay packed
+    return ( !IsPixelFormatSupportedImpl( supportedFormats, XARRAY_SIZE( supportedFormats ), inputPixelFormat ) ) ? XPixelFormatUnknown :
+           ( inputPixelFormat == XPixelFormatBinary1 ) ? XPixelFormatBinary1 : XPixelFormatGrayscale8;
 }
 
 // Process the specified source image and return new as a result
@@ -97,6 +97,12 @@ XErrorCode MeanShiftPlugin::ProcessImageInPlace( ximage* src )
     return ErrorNotImplemented;
 }
 
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode MeanShiftPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, radius );
+}
+
 // Get the specified property value of the plug-in
 XErrorCode MeanShiftPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
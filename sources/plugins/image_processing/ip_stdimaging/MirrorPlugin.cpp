@@ -25,7 +25,8 @@
 // Supported pixel formats of input/output images
 const XPixelFormat MirrorPlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32,
+    XPixelFormatGrayscale16, XPixelFormatRGB48, XPixelFormatRGBA64
 };
 
 MirrorPlugin::MirrorPlugin( ) :
@@ -25,17 +25,18 @@
 // Supported pixel formats of input/output images
 const XPixelFormat ObjectsOutlinePlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8
+    XPixelFormatGrayscale8, XPixelFormatBinary1
 };
 
 ObjectsOutlinePlugin::ObjectsOutlinePlugin( ) :
-    outlineThickness( 3 ), outlineGap( 0 ), tempDistanceMap( nullptr )
+    outlineThickness( 3 ), outlineGap( 0 ), tempDistanceMap( nullptr ), tempGrayImage( nullptr )
 {
 }
 
 ObjectsOutlinePlugin::~ObjectsOutlinePlugin( )
 {
     XImageFree( &tempDistanceMap );
+    XImageFree( &tempGrayImage );
 }
 
 void ObjectsOutlinePlugin::Dispose( )
@@ -85,11 +86,34 @@ XErrorCode ObjectsOutlinePlugin::ProcessImageInPlace( ximage* src )
     }
     else
     {
-        ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &tempDistanceMap );
+        // binary images are unpacked into temporary grayscale image and then packed back,
+        // so the result keeps being 1 bpp binary image for the next steps
+        ximage* image = src;
+
+        if ( src->format == XPixelFormatBinary1 )
+        {
+            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale8, &tempGrayImage );
+
+            if ( ret == SuccessCode )
+            {
+                ret   = BinaryToGrayscale( src, tempGrayImage );
+                image = tempGrayImage;
+            }
+        }
 
         if ( ret == SuccessCode )
         {
-            ret = ObjectsOutline( src, tempDistanceMap, outlineThickness, outlineGap );
+            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &tempDistanceMap );
+        }
+
+        if ( ret == SuccessCode )
+        {
+            ret = ObjectsOutline( image, tempDistanceMap, outlineThickness, outlineGap );
+        }
+
+        if ( ( ret == SuccessCode ) && ( image != src ) )
+        {
+            ret = GrayscaleToBinary( image, src );
         }
     }
 
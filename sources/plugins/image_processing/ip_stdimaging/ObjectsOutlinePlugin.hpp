@@ -50,6 +50,7 @@ private:
     uint16_t outlineThickness;
     uint16_t outlineGap;
     ximage*  tempDistanceMap;
+    ximage*  tempGrayImage;
 };
 
 #endif // CVS_OBJECTS_OUTLINE_PLUGIN_HPP
@@ -25,17 +25,18 @@
 // Supported pixel formats of input/output images
 const XPixelFormat ObjectsThinningPlugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8
+    XPixelFormatGrayscale8, XPixelFormatBinary1
 };
 
 ObjectsThinningPlugin::ObjectsThinningPlugin( ) :
-    thinningAmount( 3 ), tempDistanceMap( nullptr )
+    thinningAmount( 3 ), tempDistanceMap( nullptr ), tempGrayImage( nullptr )
 {
 }
 
 ObjectsThinningPlugin::~ObjectsThinningPlugin( )
 {
     XImageFree( &tempDistanceMap );
+    XImageFree( &tempGrayImage );
 }
 
 void ObjectsThinningPlugin::Dispose( )
@@ -85,11 +86,34 @@ XErrorCode ObjectsThinningPlugin::ProcessImageInPlace( ximage* src )
     }
     else
     {
-        ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &tempDistanceMap );
+        // binary images are unpacked into temporary grayscale image and then packed back,
+        // so the result keeps being 1 bpp binary image for the next steps
+        ximage* image = src;
+
+        if ( src->format == XPixelFormatBinary1 )
+        {
+            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale8, &tempGrayImage );
+
+            if ( ret == SuccessCode )
+            {
+                ret   = BinaryToGrayscale( src, tempGrayImage );
+                image = tempGrayImage;
+            }
+        }
 
         if ( ret == SuccessCode )
         {
-            ret = ObjectsThinning( src, tempDistanceMap, thinningAmount );
+            ret = XImageAllocateRaw( src->width, src->height, XPixelFormatGrayscale16, &tempDistanceMap );
+        }
+
+        if ( ret == SuccessCode )
+        {
+            ret = ObjectsThinning( image, tempDistanceMap, thinningAmount );
+        }
+
+        if ( ( ret == SuccessCode ) && ( image != src ) )
+        {
+            ret = GrayscaleToBinary( image, src );
         }
     }
 
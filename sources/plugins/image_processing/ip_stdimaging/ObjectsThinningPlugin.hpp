@@ -49,6 +49,7 @@ private:
 
     uint16_t thinningAmount;
     ximage*  tempDistanceMap;
+    ximage*  tempGrayImage;
 };
 
 #endif // CVS_OBJECTS_THINNING_PLUGIN_HPP
@@ -87,6 +87,22 @@ XErrorCode OtsuThresholdPlugin::ProcessImageInPlace( ximage* src )
     return ret;
 }
 
+// Process the specified region of an image in place
+XErrorCode OtsuThresholdPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+	return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Process the specified source image by changing it, using its already calculated histogram
+XErrorCode OtsuThresholdPlugin::ProcessImageWithHistograms( ximage* src, const xhistogram* redHistogram,
+                                                            const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+{
+    XUNREFERENCED_PARAMETER( greenHistogram )
+    XUNREFERENCED_PARAMETER( blueHistogram )
+
+    return OtsuThresholdingUsingHistogram( src, redHistogram );
+}
+
 // Get specified property value of the plug-in
 XErrorCode OtsuThresholdPlugin::GetProperty( int32_t id, xvariant* value ) const
 {
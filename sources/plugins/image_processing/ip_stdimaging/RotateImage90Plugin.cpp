@@ -25,7 +25,8 @@
 // Supported pixel formats of input/output images
 const XPixelFormat RotateImage90Plugin::supportedFormats[] =
 {
-    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32,
+    XPixelFormatGrayscale16, XPixelFormatRGB48, XPixelFormatRGBA64
 };
 
 RotateImage90Plugin::RotateImage90Plugin( ) :
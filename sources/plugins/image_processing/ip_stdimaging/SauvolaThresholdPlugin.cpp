@@ -0,0 +1,172 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <xvision.h>
+#include "SauvolaThresholdPlugin.hpp"
+
+// Supported pixel formats of input/output images
+const XPixelFormat SauvolaThresholdPlugin::supportedFormats[] =
+{
+    XPixelFormatGrayscale8
+};
+
+SauvolaThresholdPlugin::SauvolaThresholdPlugin( ) :
+    windowRadius( 20 ), k( 0.2f ), dynamicRange( 128.0f ), integralImage( nullptr ), sqIntegralImage( nullptr )
+{
+}
+
+void SauvolaThresholdPlugin::Dispose( )
+{
+    XImageFree( &integralImage );
+    XImageFree( &sqIntegralImage );
+    delete this;
+}
+
+// The plug-in can process image in-place without creating new image as a result
+bool SauvolaThresholdPlugin::CanProcessInPlace( )
+{
+    return true;
+}
+
+// Provide supported pixel formats
+XErrorCode SauvolaThresholdPlugin::GetPixelFormatTranslations( XPixelFormat* inputFormats, XPixelFormat* outputFormats, int32_t* count )
+{
+    return GetPixelFormatTranslationsImpl( inputFormats, outputFormats, count, supportedFormats, supportedFormats,
+        XARRAY_SIZE( supportedFormats ) );
+}
+
+// Process the specified source image and return new as a result
+XErrorCode SauvolaThresholdPlugin::ProcessImage( const ximage* src, ximage** dst )
+{
+    XErrorCode ret = XImageClone( src, dst );
+
+    if ( ret == SuccessCode )
+    {
+        ret = ProcessImageInPlace( *dst );
+
+        if ( ret != SuccessCode )
+        {
+            XImageFree( dst );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified source image by changing it
+XErrorCode SauvolaThresholdPlugin::ProcessImageInPlace( ximage* src )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( src == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        // integral images are kept between calls, so those are not reallocated for every video frame
+        ret = XImageAllocateRaw( src->width + 1, src->height + 1, XPixelFormatGrayscale64, &integralImage );
+
+        if ( ret == SuccessCode )
+        {
+            ret = XImageAllocateRaw( src->width + 1, src->height + 1, XPixelFormatGrayscale64, &sqIntegralImage );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = BuildIntegralImage64( src, integralImage, sqIntegralImage, 0 );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = SauvolaLocalThresholding( src, integralImage, sqIntegralImage, windowRadius, k, dynamicRange );
+        }
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place, using pixels around it as neighbours of its edge pixels
+XErrorCode SauvolaThresholdPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, windowRadius );
+}
+
+// Get the specified property value of the plug-in
+XErrorCode SauvolaThresholdPlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode ret = SuccessCode;
+
+    switch ( id )
+    {
+    case 0:
+        value->type = XVT_U2;
+        value->value.usVal = windowRadius;
+        break;
+
+    case 1:
+        value->type = XVT_R4;
+        value->value.fVal = k;
+        break;
+
+    case 2:
+        value->type = XVT_R4;
+        value->value.fVal = dynamicRange;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+    }
+
+    return ret;
+}
+
+// Set the specified property value of the plug-in
+XErrorCode SauvolaThresholdPlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode ret = SuccessCode;
+
+    xvariant convertedValue;
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 3, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            windowRadius = XINRANGE( convertedValue.value.usVal, 1, 500 );
+            break;
+
+        case 1:
+            k = XINRANGE( convertedValue.value.fVal, 0.0f, 1.0f );
+            break;
+
+        case 2:
+            dynamicRange = XINRANGE( convertedValue.value.fVal, 1.0f, 255.0f );
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
+}
@@ -0,0 +1,120 @@
+/*
+    Standard image processing plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <iplugincpp.hpp>
+#include <image_thresholding_plugin_16x16.h>
+#include "SauvolaThresholdPlugin.hpp"
+
+static void PluginInitializer( );
+
+// Version of the plug-in
+static xversion PluginVersion = { 1, 0, 0 };
+
+// ID of the plug-in
+static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000001, 0x0000003E };
+
+// Window radius property
+static PropertyDescriptor windowRadiusProperty =
+{ XVT_U2, "Window radius", "windowRadius", "Radius of the window used to calculate local mean and standard deviation.", PropertyFlag_None };
+// K property
+static PropertyDescriptor kProperty =
+{ XVT_R4, "K", "k", "Sensitivity to local standard deviation.", PropertyFlag_None };
+// Dynamic range property
+static PropertyDescriptor dynamicRangeProperty =
+{ XVT_R4, "Dynamic range", "dynamicRange", "Dynamic range of standard deviation.", PropertyFlag_None };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &windowRadiusProperty, &kProperty, &dynamicRangeProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** SauvolaThresholdPlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
+// Register the plug-in
+REGISTER_CPP_PLUGIN_WITH_PROPS
+(
+    PluginID,
+    PluginFamilyID_Thresholding,
+
+    PluginType_ImageProcessingFilter,
+    PluginVersion,
+    "Sauvola Local Threshold",
+    "SauvolaThreshold",
+    "Performs adaptive thresholding of grayscale image using local mean and standard deviation.",
+
+    /* Long description */
+    "The plug-in implements the adaptive thresholding technique described by J. Sauvola and M. Pietikainen in "
+    "\"Adaptive document image binarization\", Pattern Recognition 33(2), pp. 225-236, 2000. For every pixel it "
+    "calculates mean (<b>m</b>) and standard deviation (<b>s</b>) of the surrounding window, which has "
+    "<b>radius * 2 + 1</b> size. The pixel is set to black if its value is not greater than the local threshold "
+    "calculated as <b>m * ( 1 + k * ( s / R - 1 ) )</b>, where <b>R</b> is the <b>dynamic range</b> of "
+    "standard deviation. Otherwise it is set to white.<br><br>"
+
+    "The local statistics are calculated using integral images, so the time required to process an image does not "
+    "depend on the window size."
+    ,
+    &image_thresholding_plugin_16x16,
+    0,
+    SauvolaThresholdPlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    0, // no clean-up
+    0  // no dynamic properties update
+);
+
+// Complete properties description by initializing those parts, which were not 
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    // Window radius property
+    windowRadiusProperty.DefaultValue.type = XVT_U2;
+    windowRadiusProperty.DefaultValue.value.usVal = 20;
+
+    windowRadiusProperty.MinValue.type = XVT_U2;
+    windowRadiusProperty.MinValue.value.usVal = 1;
+
+    windowRadiusProperty.MaxValue.type = XVT_U2;
+    windowRadiusProperty.MaxValue.value.usVal = 500;
+
+    // K property
+    kProperty.DefaultValue.type = XVT_R4;
+    kProperty.DefaultValue.value.fVal = 0.2f;
+
+    kProperty.MinValue.type = XVT_R4;
+    kProperty.MinValue.value.fVal = 0.0f;
+
+    kProperty.MaxValue.type = XVT_R4;
+    kProperty.MaxValue.value.fVal = 1.0f;
+
+    // Dynamic range property
+    dynamicRangeProperty.DefaultValue.type = XVT_R4;
+    dynamicRangeProperty.DefaultValue.value.fVal = 128.0f;
+
+    dynamicRangeProperty.MinValue.type = XVT_R4;
+    dynamicRangeProperty.MinValue.value.fVal = 1.0f;
+
+    dynamicRangeProperty.MaxValue.type = XVT_R4;
+    dynamicRangeProperty.MaxValue.value.fVal = 255.0f;
+}
@@ -25,7 +25,7 @@
 // Supported pixel formats of input/output images
 const XPixelFormat ThresholdPlugin::supportedFormats[] =
 {
-	XPixelFormatGrayscale8, XPixelFormatGrayscale16
+	XPixelFormatGrayscale8, XPixelFormatGrayscale16, XPixelFormatYUV420, XPixelFormatNV12
 };
 
 ThresholdPlugin::ThresholdPlugin( ) :
@@ -58,7 +58,7 @@ XErrorCode ThresholdPlugin::ProcessImage( const ximage* src, ximage** dst )
 
 	if ( ret == SuccessCode )
 	{
-		ret = ThresholdImage( *dst, static_cast<uint16_t>( threshold ) );
+		ret = ProcessImageInPlace( *dst );
 
 		if ( ret != SuccessCode )
 		{
@@ -72,7 +72,58 @@ XErrorCode ThresholdPlugin::ProcessImage( const ximage* src, ximage** dst )
 // Process the specified source image by changing it
 XErrorCode ThresholdPlugin::ProcessImageInPlace( ximage* src )
 {
-    return ThresholdImage( src, static_cast<uint16_t>( threshold ) );
+    XErrorCode ret = SuccessCode;
+
+    if ( ( src != nullptr ) && ( XImageIsPixelFormatPlanar( src->format ) ) )
+    {
+        // threshold luminance plane and make chroma neutral, so the result is black and white
+        ximage* lumaPlane = nullptr;
+
+        ret = XImageGetPlane( src, &lumaPlane, 0 );
+
+        if ( ret == SuccessCode )
+        {
+            ret = ThresholdImage( lumaPlane, static_cast<uint16_t>( threshold ) );
+        }
+        if ( ret == SuccessCode )
+        {
+            ret = DesaturateYUVImage( src );
+        }
+
+        XImageFree( &lumaPlane );
+    }
+    else
+    {
+        ret = ThresholdImage( src, static_cast<uint16_t>( threshold ) );
+    }
+
+    return ret;
+}
+
+// Process the specified region of an image in place
+XErrorCode ThresholdPlugin::ProcessImageRegion( ximage* src, const xrect* region )
+{
+    return ProcessImageRegionHelper( src, region, 0 );
+}
+
+// Provide look-up table doing the same as the filter for 8 bpp grayscale images, so it could be combined with other point-wise operations
+XErrorCode ThresholdPlugin::GetPointOperationMaps( XPixelFormat format, uint8_t* maps )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( format == XPixelFormatGrayscale8 )
+    {
+        for ( uint32_t i = 0; i < 256; i++ )
+        {
+            maps[i] = ( i >= threshold ) ? 255 : 0;
+        }
+    }
+    else
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+
+    return ret;
 }
 
 // Get specified property value of the plug-in
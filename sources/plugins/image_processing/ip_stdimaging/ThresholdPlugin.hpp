@@ -41,6 +41,8 @@ public:
 	XErrorCode GetPixelFormatTranslations( XPixelFormat* inputFormats, XPixelFormat* outputFormats, int32_t* count );
     XErrorCode ProcessImage( const ximage* src, ximage** dst );
     XErrorCode ProcessImageInPlace( ximage* src );
+    XErrorCode GetPointOperationMaps( XPixelFormat format, uint8_t* maps );
+    XErrorCode ProcessImageRegion( ximage* src, const xrect* region );
 
 private:
 	static const PropertyDescriptor** propertiesDescription;
@@ -26,7 +26,7 @@
 ModuleDescriptor moduleInfo =
 {
     { 0xAF000001, 0x00000000, 0x00000000, 0x00000001 },
-    { 1, 0, 9 },
+    { 1, 0, 10 },
     "Standard Image Processing",
     "ip_stdimaging",
     "The module contains set of common image processing routines.",
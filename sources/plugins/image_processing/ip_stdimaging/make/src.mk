@@ -11,6 +11,7 @@ SRC = ip_stdimaging.cpp \
 	BinaryDilatation3x3Plugin.cpp BinaryDilatation3x3PluginDescriptor.cpp \
 	BinaryErosion3x3Plugin.cpp BinaryErosion3x3PluginDescriptor.cpp \
 	BlurPlugin.cpp BlurPluginDescriptor.cpp \
+	BradleyThresholdPlugin.cpp BradleyThresholdPluginDescriptor.cpp \
 	CannyEdgeDetectorPlugin.cpp CannyEdgeDetectorPluginDescriptor.cpp \
 	BrightnessCorrectionPlugin.cpp BrightnessCorrectionPluginDescriptor.cpp \
 	ColorChannelsFilterPlugin.cpp ColorChannelsFilterPluginDescriptor.cpp \
@@ -24,6 +25,7 @@ SRC = ip_stdimaging.cpp \
 	Dilatation3x3Plugin.cpp Dilatation3x3PluginDescriptor.cpp \
 	DilatationPlugin.cpp DilatationPluginDescriptor.cpp \
 	DistanceColorFilterPlugin.cpp DistanceColorFilterPluginDescriptor.cpp \
+	DistanceTransformationPlugin.cpp DistanceTransformationPluginDescriptor.cpp \
 	EdgeDetectorPlugin.cpp EdgeDetectorPluginDescriptor.cpp \
 	EmbedQuadrilateralPlugin.cpp EmbedQuadrilateralPluginDescriptor.cpp \
 	ErodeEdgesPlugin.cpp ErodeEdgesPluginDescriptor.cpp \
@@ -46,6 +48,7 @@ SRC = ip_stdimaging.cpp \
 	InvertPlugin.cpp InvertPluginDescriptor.cpp \
 	LevelsLinearPlugin.cpp LevelsLinearPluginDescriptor.cpp \
 	LevelsLinearGrayscalePlugin.cpp LevelsLinearGrayscalePluginDescriptor.cpp \
+	LocalStatisticsPlugin.cpp LocalStatisticsPluginDescriptor.cpp \
 	MaskImagePlugin.cpp MaskImagePluginDescriptor.cpp \
 	Mean3x3Plugin.cpp Mean3x3PluginDescriptor.cpp \
 	MeanShiftPlugin.cpp MeanShiftPluginDescriptor.cpp \
@@ -63,13 +66,15 @@ SRC = ip_stdimaging.cpp \
 	RotateImagePlugin.cpp RotateImagePluginDescriptor.cpp \
 	RotateImage90Plugin.cpp RotateImage90PluginDescriptor.cpp \
 	RunLengthSmoothingPlugin.cpp RunLengthSmoothingPluginDescriptor.cpp \
+	SauvolaThresholdPlugin.cpp SauvolaThresholdPluginDescriptor.cpp \
 	ShiftImagePlugin.cpp ShiftImagePluginDescriptor.cpp \
 	SubtractImagesPlugin.cpp SubtractImagesPluginDescriptor.cpp \
 	ThresholdPlugin.cpp ThresholdPluginDescriptor.cpp 
 
 # additional include folders
 INCLUDES = -I../../../../../afx/afx_types -I../../../../../afx/afx_imaging \
+	-I../../../../../afx/afx_vision \
 	-I../../../../../core/iplugin -I../../../../../images
 
 # libraries to use
-LIBS = -liplugin -lafx_imaging -lafx_types
+LIBS = -liplugin -lafx_vision -lafx_imaging -lafx_types
@@ -23,6 +23,9 @@
 #include <XLuaPluginScripting.hpp>
 #include <IScriptingHost.hpp>
 #include <XPluginWrapperFactory.hpp>
+#include <XVariantArray.hpp>
+#include <stddef.h>
+#include <string.h>
 
 using namespace std;
 using namespace CVSandbox;
@@ -40,7 +43,23 @@ namespace Private
 
         void SetCallbacks( const ScriptingEnginePluginCallbacks* callbacks, void* userParam )
         {
-            mCallbacks = *callbacks;
+            uint32_t hostApiVersion = GetHostPluginsApiVersion( );
+
+            if ( hostApiVersion >= PluginsApiVersion_SharedImages )
+            {
+                mCallbacks = *callbacks;
+            }
+            else
+            {
+                // older hosts provide shorter structure, so only callbacks they know about are taken
+                size_t knownSize = ( hostApiVersion >= PluginsApiVersion_ImageHistograms ) ?
+                                   offsetof( ScriptingEnginePluginCallbacks, GetSharedImageVariable ) :
+                                   offsetof( ScriptingEnginePluginCallbacks, GetImageHistograms );
+
+                mCallbacks = ScriptingEnginePluginCallbacks( { 0 } );
+                memcpy( &mCallbacks, callbacks, knownSize );
+            }
+
             mUserParam = userParam;
         }
 
@@ -187,15 +206,43 @@ namespace Private
             return ecode;
         }
 
-        XErrorCode GetVariable( const string& name, shared_ptr<XImage>& value ) const
+        XErrorCode GetVariable( const string& name, shared_ptr<const XImage>& value ) const
         {
             XErrorCode ecode = ErrorInvalidConfiguration;
 
-            if ( mCallbacks.GetImageVariable != nullptr )
+            value.reset( );
+
+            if ( ( mCallbacks.GetSharedImageVariable != nullptr ) && ( mCallbacks.ReleaseSharedImageVariable != nullptr ) )
             {
-                ximage* ximage = nullptr;
+                const ximage* ximage = nullptr;
+                void*         handle = nullptr;
+
+                ecode = mCallbacks.GetSharedImageVariable( mUserParam, name.c_str( ), &ximage, &handle );
 
-                value.reset( );
+                if ( ( ecode == SuccessCode ) && ( ximage != nullptr ) )
+                {
+                    // the image is wrapped without copying and released on the host side once nobody uses it
+                    shared_ptr<const XImage>                                 image     = XImage::Create( ximage );
+                    ScriptingEnginePluginCallback_ReleaseSharedImageVariable release   = mCallbacks.ReleaseSharedImageVariable;
+                    void*                                                    userParam = mUserParam;
+
+                    if ( !image )
+                    {
+                        release( userParam, handle );
+                        ecode = ErrorOutOfMemory;
+                    }
+                    else
+                    {
+                        value = shared_ptr<const XImage>( image.get( ), [image, release, userParam, handle]( const XImage* )
+                        {
+                            release( userParam, handle );
+                        } );
+                    }
+                }
+            }
+            else if ( mCallbacks.GetImageVariable != nullptr )
+            {
+                ximage* ximage = nullptr;
 
                 ecode = mCallbacks.GetImageVariable( mUserParam, name.c_str( ), &ximage );
 
@@ -208,7 +255,7 @@ namespace Private
             return ecode;
         }
 
-        XErrorCode SetVariable( const string& name, const shared_ptr<XImage>& value )
+        XErrorCode SetVariable( const string& name, const shared_ptr<const XImage>& value )
         {
             XErrorCode ecode = ErrorInvalidConfiguration;
 
@@ -241,6 +288,45 @@ namespace Private
             return ecode;
         }
 
+        XErrorCode GetImageHistograms( vector<XVariant>& histograms ) const
+        {
+            XErrorCode ecode = ErrorInvalidConfiguration;
+
+            histograms.clear( );
+
+            if ( mCallbacks.GetImageHistograms != nullptr )
+            {
+                uint32_t   values[3][256];
+                xhistogram xhistograms[3] = { xhistogram( ), xhistogram( ), xhistogram( ) };
+                int32_t    count = 0;
+
+                for ( int i = 0; i < 3; i++ )
+                {
+                    xhistograms[i].values = values[i];
+                    xhistograms[i].length = 256;
+                }
+
+                ecode = mCallbacks.GetImageHistograms( mUserParam, xhistograms, &count );
+
+                if ( ecode == SuccessCode )
+                {
+                    for ( int32_t i = 0; i < count; i++ )
+                    {
+                        XVariantArray array( XVT_U4, 256 );
+
+                        for ( uint32_t j = 0; j < 256; j++ )
+                        {
+                            array.Set( j, XVariant( values[i][j] ) );
+                        }
+
+                        histograms.push_back( XVariant( array ) );
+                    }
+                }
+            }
+
+            return ecode;
+        }
+
     private:
         ScriptingEnginePluginCallbacks  mCallbacks;
         void*                           mUserParam;
@@ -0,0 +1,262 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "RawFramesCodec.hpp"
+#include <memory.h>
+
+using namespace std;
+
+namespace Private
+{
+    static const size_t   MIN_MATCH     = 4;
+    static const size_t   LAST_LITERALS = 5;     // last bytes of a block are always literals
+    static const size_t   MATCH_LIMIT   = 12;    // last match must start at least this number of bytes before the end
+    static const size_t   MAX_DISTANCE  = 65535;
+    static const uint32_t HASH_BITS     = 14;
+    static const uint32_t NO_POSITION   = 0xFFFFFFFF;
+
+    static inline uint32_t Read32( const uint8_t* ptr )
+    {
+        uint32_t value;
+        memcpy( &value, ptr, sizeof( value ) );
+        return value;
+    }
+
+    static inline uint32_t Hash( uint32_t sequence )
+    {
+        return ( sequence * 2654435761u ) >> ( 32 - HASH_BITS );
+    }
+
+    // Write length of literals/match exceeding the 15 which fits into token
+    static inline uint8_t* WriteLength( uint8_t* op, size_t length )
+    {
+        for ( ; length >= 255; length -= 255 )
+        {
+            *op++ = 255;
+        }
+        *op++ = static_cast<uint8_t>( length );
+
+        return op;
+    }
+
+    // Read length extension of literals/match
+    static inline bool ReadLength( const uint8_t** ip, const uint8_t* srcEnd, size_t* length )
+    {
+        uint8_t byte;
+
+        do
+        {
+            if ( *ip >= srcEnd )
+            {
+                return false;
+            }
+
+            byte     = *(*ip)++;
+            *length += byte;
+        }
+        while ( byte == 255 );
+
+        return true;
+    }
+
+    // Write sequence of literals followed by a match (match length is 0 for the last sequence)
+    static inline uint8_t* WriteSequence( uint8_t* op, uint8_t* opEnd, const uint8_t* literals, size_t literalsLength,
+                                          size_t offset, size_t matchLength )
+    {
+        // worst case - token, literals' length, literals, offset and match length
+        if ( static_cast<size_t>( opEnd - op ) < 1 + literalsLength / 255 + 1 + literalsLength + 2 + matchLength / 255 + 1 )
+        {
+            return nullptr;
+        }
+
+        uint8_t* token = op++;
+
+        *token = static_cast<uint8_t>( ( ( literalsLength >= 15 ) ? 15 : literalsLength ) << 4 );
+
+        if ( literalsLength >= 15 )
+        {
+            op = WriteLength( op, literalsLength - 15 );
+        }
+
+        if ( literalsLength != 0 )
+        {
+            memcpy( op, literals, literalsLength );
+            op += literalsLength;
+        }
+
+        if ( matchLength != 0 )
+        {
+            size_t length = matchLength - MIN_MATCH;
+
+            *op++ = static_cast<uint8_t>( offset & 0xFF );
+            *op++ = static_cast<uint8_t>( offset >> 8 );
+
+            *token |= static_cast<uint8_t>( ( length >= 15 ) ? 15 : length );
+
+            if ( length >= 15 )
+            {
+                op = WriteLength( op, length - 15 );
+            }
+        }
+
+        return op;
+    }
+}
+
+using namespace ::Private;
+
+// Compress the source buffer into the destination one
+size_t RawFramesCompress( const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, vector<uint32_t>& hashTable )
+{
+    uint8_t* op     = dst;
+    uint8_t* opEnd  = dst + dstCapacity;
+    size_t   anchor = 0;
+
+    hashTable.assign( static_cast<size_t>( 1 ) << HASH_BITS, NO_POSITION );
+
+    // positions are kept as 32 bit values, so larger blocks are not compressed
+    if ( ( srcSize > MATCH_LIMIT ) && ( srcSize < NO_POSITION ) )
+    {
+        size_t matchLimit = srcSize - MATCH_LIMIT;
+        size_t endLimit   = srcSize - LAST_LITERALS;
+        size_t ip         = 1;
+        size_t misses     = 0;
+
+        hashTable[Hash( Read32( src ) )] = 0;
+
+        while ( ( ip < matchLimit ) && ( op != nullptr ) )
+        {
+            uint32_t sequence = Read32( src + ip );
+            uint32_t hash     = Hash( sequence );
+            uint32_t ref      = hashTable[hash];
+
+            hashTable[hash] = static_cast<uint32_t>( ip );
+
+            if ( ( ref != NO_POSITION ) && ( ip - ref <= MAX_DISTANCE ) && ( Read32( src + ref ) == sequence ) )
+            {
+                size_t matchLength = MIN_MATCH;
+
+                while ( ( ip + matchLength < endLimit ) && ( src[ref + matchLength] == src[ip + matchLength] ) )
+                {
+                    matchLength++;
+                }
+
+                op = WriteSequence( op, opEnd, src + anchor, ip - anchor, ip - ref, matchLength );
+
+                ip    += matchLength;
+                anchor = ip;
+                misses = 0;
+            }
+            else
+            {
+                // move faster through data which don't compress
+                ip += 1 + ( misses++ >> 6 );
+            }
+        }
+    }
+
+    if ( op != nullptr )
+    {
+        op = WriteSequence( op, opEnd, src + anchor, srcSize - anchor, 0, 0 );
+    }
+
+    return ( op == nullptr ) ? 0 : static_cast<size_t>( op - dst );
+}
+
+// Decompress the source buffer into the destination one
+bool RawFramesDecompress( const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize )
+{
+    const uint8_t* ip     = src;
+    const uint8_t* srcEnd = src + srcSize;
+    uint8_t*       op     = dst;
+    uint8_t*       opEnd  = dst + dstSize;
+    bool           ret    = true;
+
+    while ( ( ret ) && ( ip < srcEnd ) )
+    {
+        uint8_t token          = *ip++;
+        size_t  literalsLength = token >> 4;
+        size_t  matchLength    = token & 15;
+
+        if ( literalsLength == 15 )
+        {
+            ret = ReadLength( &ip, srcEnd, &literalsLength );
+        }
+
+        if ( ( !ret ) || ( literalsLength > static_cast<size_t>( srcEnd - ip ) ) || ( literalsLength > static_cast<size_t>( opEnd - op ) ) )
+        {
+            ret = false;
+            break;
+        }
+
+        if ( literalsLength != 0 )
+        {
+            memcpy( op, ip, literalsLength );
+            ip += literalsLength;
+            op += literalsLength;
+        }
+
+        // the last sequence has literals only
+        if ( ip == srcEnd )
+        {
+            break;
+        }
+
+        if ( srcEnd - ip < 2 )
+        {
+            ret = false;
+            break;
+        }
+
+        size_t offset = static_cast<size_t>( ip[0] ) | ( static_cast<size_t>( ip[1] ) << 8 );
+        ip += 2;
+
+        if ( matchLength == 15 )
+        {
+            ret = ReadLength( &ip, srcEnd, &matchLength );
+        }
+        matchLength += MIN_MATCH;
+
+        if ( ( !ret ) || ( offset == 0 ) || ( offset > static_cast<size_t>( op - dst ) ) || ( matchLength > static_cast<size_t>( opEnd - op ) ) )
+        {
+            ret = false;
+            break;
+        }
+
+        const uint8_t* match = op - offset;
+
+        if ( offset >= matchLength )
+        {
+            memcpy( op, match, matchLength );
+            op += matchLength;
+        }
+        else
+        {
+            // overlapping match repeats the last offset bytes
+            for ( size_t i = 0; i < matchLength; i++ )
+            {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return ( ( ret ) && ( op == opEnd ) );
+}
@@ -0,0 +1,41 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_RAW_FRAMES_CODEC_HPP
+#define CVS_RAW_FRAMES_CODEC_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Light weight LZ77 compression of frames' data. Compressed blocks use LZ4 block format (sequences of literals
+// followed by 4+ bytes matches within 64K window), so it trades compression ratio for speed of both directions.
+
+// Compress the source buffer into the destination one. Returns size of compressed data or 0 if it does not fit
+// into the destination buffer. The hash table is used as working memory and can be reused between calls.
+size_t RawFramesCompress( const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, std::vector<uint32_t>& hashTable );
+
+// Decompress the source buffer into the destination one. Fails if compressed data are corrupted or they don't
+// decompress into exactly the specified number of bytes.
+bool RawFramesDecompress( const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize );
+
+#endif // CVS_RAW_FRAMES_CODEC_HPP
@@ -0,0 +1,919 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include "RawFramesFile.hpp"
+#include "RawFramesCodec.hpp"
+#include <new>
+#include <memory.h>
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+using namespace CVSandbox::Threading;
+
+namespace Private
+{
+    static const uint32_t FILE_SIGNATURE    = 0x46525643; // "CVRF"
+    static const uint32_t FRAME_SIGNATURE   = 0x4D524643; // "CFRM"
+    static const uint32_t INDEX_SIGNATURE   = 0x58444943; // "CIDX"
+    static const uint32_t FILE_VERSION      = 1;
+    static const size_t   RECORD_ALIGNMENT  = 64;
+    static const size_t   WRITE_BUFFER_SIZE = 16 * 1024 * 1024;
+    static const int32_t  MAX_IMAGE_SIZE    = 65536;
+    static const uint64_t MAX_DATA_SIZE     = 0x7FFFFFFF;
+    // Size of file's part mapped at once by reader (larger one is mapped only for a frame, which does not fit)
+    static const uint64_t MAP_WINDOW_SIZE   = ( sizeof( void* ) > 4 ) ? 1024ull * 1024 * 1024 : 64ull * 1024 * 1024;
+
+    enum
+    {
+        CompressionNone = 0,
+        CompressionLZ   = 1
+    };
+
+    // All structures are kept in little endian byte order
+    struct FileHeader
+    {
+        uint32_t Signature;
+        uint32_t Version;
+        uint32_t HeaderSize;
+        uint32_t FrameHeaderSize;
+        uint32_t Reserved[12];
+    };
+
+    struct FrameHeader
+    {
+        uint32_t Signature;
+        uint32_t Format;
+        int32_t  Width;
+        int32_t  Height;
+        int32_t  Stride;
+        uint32_t Compression;
+        uint32_t DataSize;      // size of uncompressed image data
+        uint32_t StoredSize;    // size of data stored in the file
+        uint64_t Timestamp;     // microseconds
+        uint32_t Reserved[6];
+    };
+
+    struct IndexTrailer
+    {
+        uint32_t Signature;
+        uint32_t Reserved1;
+        uint64_t IndexOffset;
+        uint64_t FramesCount;
+        uint32_t Reserved2[10];
+    };
+
+    static_assert( sizeof( FileHeader )   == RECORD_ALIGNMENT, "Invalid size of raw frames file header" );
+    static_assert( sizeof( FrameHeader )  == RECORD_ALIGNMENT, "Invalid size of raw frames frame header" );
+    static_assert( sizeof( IndexTrailer ) == RECORD_ALIGNMENT, "Invalid size of raw frames index trailer" );
+
+    static inline uint64_t AlignSize( uint64_t size )
+    {
+        return ( size + RECORD_ALIGNMENT - 1 ) & ~static_cast<uint64_t>( RECORD_ALIGNMENT - 1 );
+    }
+
+    // Get stride used to keep image data of the specified format in a file
+    static inline int32_t GetStoredStride( int32_t width, XPixelFormat format )
+    {
+        return static_cast<int32_t>( XImageBytesPerStride( XImageBitsPerPixel( format ) * width ) );
+    }
+
+    // Get size of image data to store, which is 0 if the image is too big
+    static uint32_t GetStoredDataSize( int32_t width, int32_t height, XPixelFormat format )
+    {
+        uint32_t ret = 0;
+
+        if ( ( width > 0 ) && ( height > 0 ) && ( width <= MAX_IMAGE_SIZE ) && ( height <= MAX_IMAGE_SIZE ) )
+        {
+            int32_t stride = GetStoredStride( width, format );
+
+            // planar formats take at most twice the size of luminance plane
+            if ( static_cast<uint64_t>( stride ) * height * 2 <= MAX_DATA_SIZE )
+            {
+                ret = XImageGetBufferSize( height, stride, format );
+            }
+        }
+
+        return ret;
+    }
+
+#ifdef WIN32
+    // Convert UTF8 string to wide character string
+    static wstring Utf8to16( const string& utf8string )
+    {
+        wstring ret;
+        int     charsRequired = MultiByteToWideChar( CP_UTF8, 0, utf8string.c_str( ), -1, NULL, 0 );
+
+        if ( charsRequired > 0 )
+        {
+            vector<wchar_t> utf16string( charsRequired );
+
+            if ( MultiByteToWideChar( CP_UTF8, 0, utf8string.c_str( ), -1, utf16string.data( ), charsRequired ) > 0 )
+            {
+                ret = wstring( utf16string.data( ) );
+            }
+        }
+
+        return ret;
+    }
+#endif
+}
+
+using namespace ::Private;
+
+// ==========================================================================
+
+RawFramesFileWriter::RawFramesFileWriter( FILE* file, bool compress ) :
+    mFile( file ), mCompress( compress ), mActiveBuffer( 0 ), mBufferUsed( 0 ), mFileOffset( 0 ),
+    mFrameOffsets( ), mFrameData( ), mHashTable( ), mThread( ), mWriteRequest( ), mWriteDone( ),
+    mPendingBuffer( nullptr ), mPendingSize( 0 ), mIsWriting( false ), mWriteFailed( false )
+{
+    FileHeader* header;
+
+    mBuffers[0].resize( WRITE_BUFFER_SIZE );
+    mBuffers[1].resize( WRITE_BUFFER_SIZE );
+
+    // file header goes into the first buffer
+    header = reinterpret_cast<FileHeader*>( mBuffers[0].data( ) );
+    memset( header, 0, sizeof( FileHeader ) );
+
+    header->Signature       = FILE_SIGNATURE;
+    header->Version         = FILE_VERSION;
+    header->HeaderSize      = sizeof( FileHeader );
+    header->FrameHeaderSize = sizeof( FrameHeader );
+
+    mBufferUsed = sizeof( FileHeader );
+}
+
+RawFramesFileWriter::~RawFramesFileWriter( )
+{
+    Close( );
+}
+
+// Create new file (overwriting any existing one)
+XErrorCode RawFramesFileWriter::Create( const string& fileName, bool compress, RawFramesFileWriter** writer )
+{
+    XErrorCode ret  = SuccessCode;
+    FILE*      file = nullptr;
+
+    if ( writer == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+    #ifdef WIN32
+        file = _wfopen( Utf8to16( fileName ).c_str( ), L"wb" );
+    #else
+        file = fopen( fileName.c_str( ), "wb" );
+    #endif
+
+        if ( file == nullptr )
+        {
+            ret = ErrorIOFailure;
+        }
+        else
+        {
+            // frames are written in large chunks, so no need for extra buffering
+            setvbuf( file, nullptr, _IONBF, 0 );
+
+            RawFramesFileWriter* newWriter = new (nothrow) RawFramesFileWriter( file, compress );
+
+            if ( newWriter == nullptr )
+            {
+                fclose( file );
+                ret = ErrorOutOfMemory;
+            }
+            else if ( ( !newWriter->mWriteRequest.IsValid( ) ) || ( !newWriter->mWriteDone.IsValid( ) ) ||
+                      ( !newWriter->mThread.Create( WriterThreadHandler, newWriter ) ) )
+            {
+                delete newWriter;
+                ret = ErrorInitializationFailed;
+            }
+            else
+            {
+                *writer = newWriter;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Check if frames of the specified pixel format can be written
+bool RawFramesFileWriter::IsPixelFormatSupported( XPixelFormat format )
+{
+    return ( ( format != XPixelFormatUnknown ) && ( format < XPixelFormatLastValue ) &&
+             ( format != XPixelFormatJPEG ) && ( !XImageIsPixelFormatIndexed( format ) ) );
+}
+
+// Write frame with the specified timestamp (microseconds)
+XErrorCode RawFramesFileWriter::WriteFrame( const ximage* image, uint64_t timestamp )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( image == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( mFile == nullptr )
+    {
+        ret = ErrorIOFailure;
+    }
+    else if ( !IsPixelFormatSupported( image->format ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else
+    {
+        int32_t  stride     = GetStoredStride( image->width, image->format );
+        uint32_t dataSize   = GetStoredDataSize( image->width, image->height, image->format );
+        size_t   recordSize = static_cast<size_t>( sizeof( FrameHeader ) + AlignSize( dataSize ) );
+
+        if ( dataSize == 0 )
+        {
+            ret = ErrorInvalidImageSize;
+        }
+        else if ( mBufferUsed + recordSize > mBuffers[mActiveBuffer].size( ) )
+        {
+            if ( !Flush( ) )
+            {
+                ret = ErrorIOFailure;
+            }
+            else if ( recordSize > mBuffers[mActiveBuffer].size( ) )
+            {
+                mBuffers[mActiveBuffer].resize( recordSize );
+            }
+        }
+
+        if ( ret == SuccessCode )
+        {
+            uint8_t*     record      = mBuffers[mActiveBuffer].data( ) + mBufferUsed;
+            uint8_t*     frameData   = record + sizeof( FrameHeader );
+            FrameHeader* header      = reinterpret_cast<FrameHeader*>( record );
+            uint32_t     compression = CompressionNone;
+            uint32_t     storedSize  = dataSize;
+            ximage       storedImage;
+
+            storedImage.data      = frameData;
+            storedImage.width     = image->width;
+            storedImage.height    = image->height;
+            storedImage.stride    = stride;
+            storedImage.format    = image->format;
+            storedImage.ownBuffer = 0;
+            storedImage.palette   = nullptr;
+
+            if ( !mCompress )
+            {
+                ret = XImageCopyData( image, &storedImage );
+            }
+            else
+            {
+                const uint8_t* src = image->data;
+
+                // compress directly from the source image if its data are already laid out as needed
+                if ( ( image->stride != stride ) || ( XImageIsPixelFormatPlanar( image->format ) ) )
+                {
+                    mFrameData.resize( dataSize );
+                    storedImage.data = mFrameData.data( );
+
+                    ret = XImageCopyData( image, &storedImage );
+                    src = mFrameData.data( );
+                }
+
+                if ( ret == SuccessCode )
+                {
+                    // keep compressed data only if those are smaller
+                    size_t compressedSize = RawFramesCompress( src, dataSize, frameData, dataSize - 1, mHashTable );
+
+                    if ( compressedSize != 0 )
+                    {
+                        compression = CompressionLZ;
+                        storedSize  = static_cast<uint32_t>( compressedSize );
+                    }
+                    else
+                    {
+                        memcpy( frameData, src, dataSize );
+                    }
+                }
+            }
+
+            if ( ret == SuccessCode )
+            {
+                size_t paddedSize = static_cast<size_t>( AlignSize( storedSize ) );
+
+                memset( frameData + storedSize, 0, paddedSize - storedSize );
+                memset( header, 0, sizeof( FrameHeader ) );
+
+                header->Signature   = FRAME_SIGNATURE;
+                header->Format      = image->format;
+                header->Width       = image->width;
+                header->Height      = image->height;
+                header->Stride      = stride;
+                header->Compression = compression;
+                header->DataSize    = dataSize;
+                header->StoredSize  = storedSize;
+                header->Timestamp   = timestamp;
+
+                mFrameOffsets.push_back( mFileOffset + mBufferUsed );
+                mBufferUsed += sizeof( FrameHeader ) + paddedSize;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Write all pending frames and frames' index, then close the file
+XErrorCode RawFramesFileWriter::Close( )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( mFile != nullptr )
+    {
+        if ( mThread.IsRunning( ) )
+        {
+            Flush( );
+            WaitForWrite( );
+
+            // stop background thread
+            mPendingBuffer = nullptr;
+            mPendingSize   = 0;
+            mWriteRequest.Signal( );
+            mThread.Join( );
+
+            if ( !mWriteFailed )
+            {
+                size_t          indexSize = static_cast<size_t>( AlignSize( mFrameOffsets.size( ) * sizeof( uint64_t ) ) );
+                vector<uint8_t> indexData( indexSize + sizeof( IndexTrailer ), 0 );
+                IndexTrailer*   trailer   = reinterpret_cast<IndexTrailer*>( indexData.data( ) + indexSize );
+
+                if ( !mFrameOffsets.empty( ) )
+                {
+                    memcpy( indexData.data( ), mFrameOffsets.data( ), mFrameOffsets.size( ) * sizeof( uint64_t ) );
+                }
+
+                trailer->Signature   = INDEX_SIGNATURE;
+                trailer->IndexOffset = mFileOffset;
+                trailer->FramesCount = mFrameOffsets.size( );
+
+                if ( fwrite( indexData.data( ), 1, indexData.size( ), mFile ) != indexData.size( ) )
+                {
+                    mWriteFailed = true;
+                }
+            }
+        }
+
+        if ( ( fclose( mFile ) != 0 ) || ( mWriteFailed ) )
+        {
+            ret = ErrorIOFailure;
+        }
+
+        mFile = nullptr;
+    }
+
+    return ret;
+}
+
+// Get number of frames written so far
+uint32_t RawFramesFileWriter::FramesCount( ) const
+{
+    return static_cast<uint32_t>( mFrameOffsets.size( ) );
+}
+
+// Pass active buffer to the background thread for writing and switch to the other one
+bool RawFramesFileWriter::Flush( )
+{
+    WaitForWrite( );
+
+    if ( ( !mWriteFailed ) && ( mBufferUsed != 0 ) )
+    {
+        mPendingBuffer = mBuffers[mActiveBuffer].data( );
+        mPendingSize   = mBufferUsed;
+        mIsWriting     = true;
+        mWriteRequest.Signal( );
+
+        mFileOffset  += mBufferUsed;
+        mBufferUsed   = 0;
+        mActiveBuffer = ( mActiveBuffer + 1 ) % 2;
+    }
+
+    return !mWriteFailed;
+}
+
+// Wait till background thread completes writing of the last passed buffer
+void RawFramesFileWriter::WaitForWrite( )
+{
+    if ( mIsWriting )
+    {
+        mWriteDone.Wait( );
+        mIsWriting = false;
+    }
+}
+
+// Writer thread entry point
+void RawFramesFileWriter::WriterThreadHandler( void* param )
+{
+    static_cast<RawFramesFileWriter*>( param )->WriterThread( );
+}
+
+// Write buffers passed by the recording thread, till empty buffer is passed
+void RawFramesFileWriter::WriterThread( )
+{
+    XThread::SetCurrentThreadName( "cvs-raw-writer" );
+
+    for ( ; ; )
+    {
+        mWriteRequest.Wait( );
+
+        if ( mPendingSize == 0 )
+        {
+            break;
+        }
+
+        if ( fwrite( mPendingBuffer, 1, mPendingSize, mFile ) != mPendingSize )
+        {
+            mWriteFailed = true;
+        }
+
+        mWriteDone.Signal( );
+    }
+}
+
+// ==========================================================================
+
+RawFramesFileReader::RawFramesFileReader( ) :
+    mSize( 0 ), mMapHandle( nullptr ), mFile( -1 ), mMapGranularity( 1 ),
+    mWindow( nullptr ), mWindowOffset( 0 ), mWindowSize( 0 ),
+    mFrameOffsets( ), mFrameView( ), mDecodedFrame( nullptr )
+{
+}
+
+RawFramesFileReader::~RawFramesFileReader( )
+{
+    XImageFree( &mDecodedFrame );
+    CloseFile( );
+}
+
+// Open the specified file for reading
+XErrorCode RawFramesFileReader::Open( const string& fileName, RawFramesFileReader** reader )
+{
+    XErrorCode           ret       = SuccessCode;
+    RawFramesFileReader* newReader = nullptr;
+
+    if ( reader == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( newReader = new (nothrow) RawFramesFileReader( ) ) == nullptr )
+    {
+        ret = ErrorOutOfMemory;
+    }
+    else if ( !newReader->OpenFile( fileName ) )
+    {
+        ret = ErrorIOFailure;
+    }
+    else
+    {
+        const FileHeader* header = reinterpret_cast<const FileHeader*>( newReader->MapRange( 0, sizeof( FileHeader ) ) );
+
+        if ( ( header == nullptr ) || ( header->Signature != FILE_SIGNATURE ) ||
+             ( header->Version != FILE_VERSION ) || ( header->HeaderSize != sizeof( FileHeader ) ) ||
+             ( header->FrameHeaderSize != sizeof( FrameHeader ) ) )
+        {
+            ret = ErrorUnknownVideoFileFormat;
+        }
+        else if ( !newReader->ReadIndex( ) )
+        {
+            newReader->RestoreIndex( );
+        }
+    }
+
+    if ( ret == SuccessCode )
+    {
+        *reader = newReader;
+    }
+    else
+    {
+        delete newReader;
+    }
+
+    return ret;
+}
+
+// Get number of frames in the file
+uint32_t RawFramesFileReader::FramesCount( ) const
+{
+    return static_cast<uint32_t>( mFrameOffsets.size( ) );
+}
+
+// Get timestamp of the specified frame (microseconds)
+XErrorCode RawFramesFileReader::GetFrameTimestamp( uint32_t index, uint64_t* timestamp )
+{
+    XErrorCode     ret = SuccessCode;
+    const uint8_t* record;
+
+    if ( timestamp == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( index >= mFrameOffsets.size( ) )
+    {
+        ret = ErrorIndexOutOfBounds;
+    }
+    else if ( ( record = GetFrameRecord( index ) ) == nullptr )
+    {
+        ret = ErrorFailedVideoDecoding;
+    }
+    else
+    {
+        *timestamp = reinterpret_cast<const FrameHeader*>( record )->Timestamp;
+    }
+
+    return ret;
+}
+
+// Get the specified frame
+XErrorCode RawFramesFileReader::GetFrame( uint32_t index, const ximage** image )
+{
+    XErrorCode     ret = SuccessCode;
+    const uint8_t* record;
+
+    if ( image == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( index >= mFrameOffsets.size( ) )
+    {
+        ret = ErrorIndexOutOfBounds;
+    }
+    else if ( ( record = GetFrameRecord( index ) ) == nullptr )
+    {
+        ret = ErrorFailedVideoDecoding;
+    }
+    else
+    {
+        const FrameHeader* header    = reinterpret_cast<const FrameHeader*>( record );
+        const uint8_t*     frameData = record + sizeof( FrameHeader );
+
+        if ( header->Compression == CompressionNone )
+        {
+            // provide view of the mapped data
+            mFrameView.data      = const_cast<uint8_t*>( frameData );
+            mFrameView.width     = header->Width;
+            mFrameView.height    = header->Height;
+            mFrameView.stride    = header->Stride;
+            mFrameView.format    = header->Format;
+            mFrameView.ownBuffer = 0;
+            mFrameView.palette   = nullptr;
+
+            *image = &mFrameView;
+        }
+        else
+        {
+            // the image is reallocated only if frame size/format changes
+            ret = XImageAllocateRaw( header->Width, header->Height, header->Format, &mDecodedFrame );
+
+            if ( ret == SuccessCode )
+            {
+                if ( !RawFramesDecompress( frameData, header->StoredSize, mDecodedFrame->data, header->DataSize ) )
+                {
+                    ret = ErrorFailedVideoDecoding;
+                }
+                else
+                {
+                    *image = mDecodedFrame;
+                }
+            }
+        }
+
+        PrefetchFrame( index + 1 );
+    }
+
+    return ret;
+}
+
+// Open the specified file, so its parts could be mapped into memory
+bool RawFramesFileReader::OpenFile( const string& fileName )
+{
+    bool ret = false;
+
+#ifdef WIN32
+    HANDLE file = CreateFileW( Utf8to16( fileName ).c_str( ), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+
+    if ( file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER fileSize;
+
+        if ( ( GetFileSizeEx( file, &fileSize ) ) && ( fileSize.QuadPart > 0 ) )
+        {
+            // mapping object does not take address space - only its views do
+            HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+            if ( mapping != nullptr )
+            {
+                SYSTEM_INFO systemInfo;
+
+                GetSystemInfo( &systemInfo );
+
+                mMapHandle      = mapping;
+                mSize           = static_cast<uint64_t>( fileSize.QuadPart );
+                mMapGranularity = systemInfo.dwAllocationGranularity;
+                ret             = true;
+            }
+        }
+
+        // mapping keeps its own reference to the file
+        CloseHandle( file );
+    }
+#else
+    int fd = open( fileName.c_str( ), O_RDONLY | O_CLOEXEC );
+
+    if ( fd != -1 )
+    {
+        struct stat fileStat;
+
+        if ( ( fstat( fd, &fileStat ) == 0 ) && ( fileStat.st_size > 0 ) )
+        {
+            mFile           = fd;
+            mSize           = static_cast<uint64_t>( fileStat.st_size );
+            mMapGranularity = static_cast<uint64_t>( sysconf( _SC_PAGESIZE ) );
+            ret             = true;
+        }
+        else
+        {
+            close( fd );
+        }
+    }
+#endif
+
+    return ret;
+}
+
+// Unmap the file and close it
+void RawFramesFileReader::CloseFile( )
+{
+    UnmapWindow( );
+
+#ifdef WIN32
+    if ( mMapHandle != nullptr )
+    {
+        CloseHandle( mMapHandle );
+        mMapHandle = nullptr;
+    }
+#else
+    if ( mFile != -1 )
+    {
+        close( mFile );
+        mFile = -1;
+    }
+#endif
+
+    mSize = 0;
+}
+
+// Get the specified range of the file, mapping another window if the range is not within the current one
+// (which invalidates pointers to the previous window)
+const uint8_t* RawFramesFileReader::MapRange( uint64_t offset, uint64_t size )
+{
+    const uint8_t* ret = nullptr;
+
+    if ( ( offset <= mSize ) && ( size <= mSize - offset ) )
+    {
+        if ( ( mWindow == nullptr ) || ( offset < mWindowOffset ) || ( offset + size > mWindowOffset + mWindowSize ) )
+        {
+            // frames are mostly read one after another, so window starts at the requested range
+            uint64_t windowOffset = offset - ( offset % mMapGranularity );
+            uint64_t windowSize   = offset + size - windowOffset;
+
+            windowSize = ( windowSize < MAP_WINDOW_SIZE ) ? MAP_WINDOW_SIZE : windowSize;
+            windowSize = ( windowSize > mSize - windowOffset ) ? mSize - windowOffset : windowSize;
+
+            UnmapWindow( );
+
+            if ( windowSize <= static_cast<uint64_t>( SIZE_MAX ) )
+            {
+            #ifdef WIN32
+                void* data = MapViewOfFile( mMapHandle, FILE_MAP_READ, static_cast<DWORD>( windowOffset >> 32 ),
+                                            static_cast<DWORD>( windowOffset ), static_cast<SIZE_T>( windowSize ) );
+            #else
+                void* data = nullptr;
+
+                // offset may not fit if large file support is not enabled
+                if ( static_cast<uint64_t>( static_cast<off_t>( windowOffset ) ) == windowOffset )
+                {
+                    data = mmap( nullptr, static_cast<size_t>( windowSize ), PROT_READ, MAP_SHARED, mFile, static_cast<off_t>( windowOffset ) );
+
+                    if ( data == MAP_FAILED )
+                    {
+                        data = nullptr;
+                    }
+                    else
+                    {
+                        madvise( data, static_cast<size_t>( windowSize ), MADV_SEQUENTIAL );
+                    }
+                }
+            #endif
+
+                if ( data != nullptr )
+                {
+                    mWindow       = static_cast<const uint8_t*>( data );
+                    mWindowOffset = windowOffset;
+                    mWindowSize   = windowSize;
+                }
+            }
+        }
+
+        if ( mWindow != nullptr )
+        {
+            ret = mWindow + ( offset - mWindowOffset );
+        }
+    }
+
+    return ret;
+}
+
+// Unmap currently mapped window of the file
+void RawFramesFileReader::UnmapWindow( )
+{
+    if ( mWindow != nullptr )
+    {
+    #ifdef WIN32
+        UnmapViewOfFile( mWindow );
+    #else
+        munmap( const_cast<uint8_t*>( mWindow ), static_cast<size_t>( mWindowSize ) );
+    #endif
+
+        mWindow       = nullptr;
+        mWindowOffset = 0;
+        mWindowSize   = 0;
+    }
+}
+
+// Read index of frames written at the end of the file
+bool RawFramesFileReader::ReadIndex( )
+{
+    bool ret = false;
+
+    // complete files always have size aligned to records' boundary
+    if ( ( mSize >= sizeof( FileHeader ) + sizeof( IndexTrailer ) ) && ( ( mSize % RECORD_ALIGNMENT ) == 0 ) )
+    {
+        uint64_t       indexEnd    = mSize - sizeof( IndexTrailer );
+        const uint8_t* trailerData = MapRange( indexEnd, sizeof( IndexTrailer ) );
+        IndexTrailer   trailer;
+
+        if ( trailerData != nullptr )
+        {
+            // keep a copy, since mapping the index may move the window
+            memcpy( &trailer, trailerData, sizeof( IndexTrailer ) );
+
+            if ( ( trailer.Signature == INDEX_SIGNATURE ) &&
+                 ( trailer.IndexOffset >= sizeof( FileHeader ) ) && ( trailer.IndexOffset <= indexEnd ) &&
+                 ( ( trailer.IndexOffset % RECORD_ALIGNMENT ) == 0 ) &&
+                 ( trailer.FramesCount <= ( indexEnd - trailer.IndexOffset ) / sizeof( uint64_t ) ) )
+            {
+                const uint8_t* indexData = MapRange( trailer.IndexOffset, trailer.FramesCount * sizeof( uint64_t ) );
+                size_t         count     = static_cast<size_t>( trailer.FramesCount );
+
+                if ( indexData != nullptr )
+                {
+                    mFrameOffsets.resize( count );
+                    if ( count != 0 )
+                    {
+                        memcpy( mFrameOffsets.data( ), indexData, count * sizeof( uint64_t ) );
+                    }
+
+                    ret = true;
+
+                    // make sure all frame headers are within the file, while their content is checked on access
+                    for ( size_t i = 0; i < count; i++ )
+                    {
+                        uint64_t offset = mFrameOffsets[i];
+
+                        if ( ( offset < sizeof( FileHeader ) ) || ( ( offset % RECORD_ALIGNMENT ) != 0 ) ||
+                             ( offset > trailer.IndexOffset - sizeof( FrameHeader ) ) )
+                        {
+                            ret = false;
+                            break;
+                        }
+                    }
+
+                    if ( !ret )
+                    {
+                        mFrameOffsets.clear( );
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Restore index of frames by walking through all frame records
+void RawFramesFileReader::RestoreIndex( )
+{
+    uint64_t offset = sizeof( FileHeader );
+
+    mFrameOffsets.clear( );
+
+    while ( mSize - offset >= sizeof( FrameHeader ) )
+    {
+        const FrameHeader* header = reinterpret_cast<const FrameHeader*>( MapRange( offset, sizeof( FrameHeader ) ) );
+
+        // stop at the first incomplete record
+        if ( ( header == nullptr ) || ( header->Signature != FRAME_SIGNATURE ) ||
+             ( header->StoredSize > mSize - offset - sizeof( FrameHeader ) ) )
+        {
+            break;
+        }
+
+        mFrameOffsets.push_back( offset );
+        offset += sizeof( FrameHeader ) + AlignSize( header->StoredSize );
+
+        if ( offset > mSize )
+        {
+            break;
+        }
+    }
+}
+
+// Get record of the specified frame or null if it is not valid
+const uint8_t* RawFramesFileReader::GetFrameRecord( uint32_t index )
+{
+    const uint8_t* ret = nullptr;
+
+    if ( index < mFrameOffsets.size( ) )
+    {
+        uint64_t           offset = mFrameOffsets[index];
+        const FrameHeader* header = reinterpret_cast<const FrameHeader*>( MapRange( offset, sizeof( FrameHeader ) ) );
+
+        if ( ( header != nullptr ) &&
+             ( header->Signature == FRAME_SIGNATURE ) &&
+             ( RawFramesFileWriter::IsPixelFormatSupported( header->Format ) ) &&
+             ( header->DataSize != 0 ) &&
+             ( header->DataSize == GetStoredDataSize( header->Width, header->Height, header->Format ) ) &&
+             ( header->Stride == GetStoredStride( header->Width, header->Format ) ) &&
+             ( header->StoredSize <= mSize - offset - sizeof( FrameHeader ) ) &&
+             ( ( ( header->Compression == CompressionNone ) && ( header->StoredSize == header->DataSize ) ) ||
+               ( ( header->Compression == CompressionLZ ) && ( header->StoredSize != 0 ) && ( header->StoredSize < header->DataSize ) ) ) )
+        {
+            // make sure the entire record is mapped
+            ret = MapRange( offset, sizeof( FrameHeader ) + header->StoredSize );
+        }
+    }
+
+    return ret;
+}
+
+// Hint the system that the specified frame will be needed soon
+void RawFramesFileReader::PrefetchFrame( uint32_t index ) const
+{
+#ifdef WIN32
+    XUNREFERENCED_PARAMETER( index )
+#else
+    // only the part within current window is prefetched, since mapping another one would invalidate the current frame
+    if ( ( index < mFrameOffsets.size( ) ) && ( mWindow != nullptr ) &&
+         ( mFrameOffsets[index] >= mWindowOffset ) && ( mFrameOffsets[index] + sizeof( FrameHeader ) <= mWindowOffset + mWindowSize ) )
+    {
+        uint64_t pageSize = static_cast<uint64_t>( sysconf( _SC_PAGESIZE ) );
+        uint64_t offset   = mFrameOffsets[index] - mWindowOffset;
+        uint64_t start    = offset & ~( pageSize - 1 );
+        uint64_t end      = offset + sizeof( FrameHeader ) + reinterpret_cast<const FrameHeader*>( mWindow + offset )->StoredSize;
+
+        if ( end > mWindowSize )
+        {
+            end = mWindowSize;
+        }
+
+        madvise( const_cast<uint8_t*>( mWindow + start ), static_cast<size_t>( end - start ), MADV_WILLNEED );
+    }
+#endif
+}
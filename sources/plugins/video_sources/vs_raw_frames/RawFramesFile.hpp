@@ -0,0 +1,140 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#pragma once
+#ifndef CVS_RAW_FRAMES_FILE_HPP
+#define CVS_RAW_FRAMES_FILE_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <ximage.h>
+#include <XInterfaces.hpp>
+#include <XAutoResetEvent.hpp>
+#include <XThread.hpp>
+
+// Raw frames file is a simple container of uncompressed (or LZ compressed) video frames:
+//   - 64 bytes file header;
+//   - frame records - 64 bytes header (image format/size and timestamp) followed by frame data, which
+//     is padded to 64 bytes boundary. Image data is kept with the standard stride for the pixel format;
+//   - index of frames' offsets (64 bit each) and 64 bytes trailer, which points to it.
+// Index and trailer are written when file is closed. If those are missing (recording was interrupted),
+// reader restores the index by walking through frame records.
+
+// Writer of raw frames files. Frames are packed into large buffers, which are written sequentially
+// by a background thread, so the video processing thread is not blocked by disk IO.
+class RawFramesFileWriter : private CVSandbox::Uncopyable
+{
+private:
+    RawFramesFileWriter( FILE* file, bool compress );
+
+public:
+    ~RawFramesFileWriter( );
+
+    // Create new file (overwriting any existing one)
+    static XErrorCode Create( const std::string& fileName, bool compress, RawFramesFileWriter** writer );
+
+    // Check if frames of the specified pixel format can be written
+    static bool IsPixelFormatSupported( XPixelFormat format );
+
+    // Write frame with the specified timestamp (microseconds)
+    XErrorCode WriteFrame( const ximage* image, uint64_t timestamp );
+    // Write all pending frames and frames' index, then close the file
+    XErrorCode Close( );
+
+    // Get number of frames written so far
+    uint32_t FramesCount( ) const;
+
+private:
+    bool Flush( );
+    void WaitForWrite( );
+
+    static void WriterThreadHandler( void* param );
+    void WriterThread( );
+
+private:
+    FILE*                                   mFile;
+    bool                                    mCompress;
+    std::vector<uint8_t>                    mBuffers[2];
+    size_t                                  mActiveBuffer;
+    size_t                                  mBufferUsed;
+    uint64_t                                mFileOffset;
+    std::vector<uint64_t>                   mFrameOffsets;
+    std::vector<uint8_t>                    mFrameData;
+    std::vector<uint32_t>                   mHashTable;
+
+    // background writing
+    CVSandbox::Threading::XThread           mThread;
+    CVSandbox::Threading::XAutoResetEvent   mWriteRequest;
+    CVSandbox::Threading::XAutoResetEvent   mWriteDone;
+    const uint8_t*                          mPendingBuffer;
+    size_t                                  mPendingSize;
+    bool                                    mIsWriting;
+    bool                                    mWriteFailed;
+};
+
+// Reader of raw frames files. The file is memory mapped by windows (so that files of any size can be read
+// by 32 bit builds as well), which slide along it as frames are read. Uncompressed frames are provided
+// without copying any image data.
+class RawFramesFileReader : private CVSandbox::Uncopyable
+{
+private:
+    RawFramesFileReader( );
+
+public:
+    ~RawFramesFileReader( );
+
+    // Open the specified file for reading
+    static XErrorCode Open( const std::string& fileName, RawFramesFileReader** reader );
+
+    // Get number of frames in the file
+    uint32_t FramesCount( ) const;
+    // Get timestamp of the specified frame (microseconds)
+    XErrorCode GetFrameTimestamp( uint32_t index, uint64_t* timestamp );
+    // Get the specified frame. The image is owned by reader and stays valid till the next call - it points
+    // directly to the mapped file for uncompressed frames or to the internal buffer for compressed ones.
+    XErrorCode GetFrame( uint32_t index, const ximage** image );
+
+private:
+    bool OpenFile( const std::string& fileName );
+    void CloseFile( );
+    const uint8_t* MapRange( uint64_t offset, uint64_t size );
+    void UnmapWindow( );
+    bool ReadIndex( );
+    void RestoreIndex( );
+    const uint8_t* GetFrameRecord( uint32_t index );
+    void PrefetchFrame( uint32_t index ) const;
+
+private:
+    uint64_t                mSize;
+    void*                   mMapHandle;         // file mapping object (Windows)
+    int                     mFile;              // file descriptor (other systems)
+    uint64_t                mMapGranularity;
+    const uint8_t*          mWindow;
+    uint64_t                mWindowOffset;
+    uint64_t                mWindowSize;
+    std::vector<uint64_t>   mFrameOffsets;
+    ximage                  mFrameView;
+    ximage*                 mDecodedFrame;
+};
+
+#endif // CVS_RAW_FRAMES_FILE_HPP
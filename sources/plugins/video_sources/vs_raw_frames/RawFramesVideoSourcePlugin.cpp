@@ -0,0 +1,581 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include "RawFramesVideoSourcePlugin.hpp"
+#include "RawFramesFile.hpp"
+#include <memory.h>
+#include <string>
+#include <chrono>
+#include <XMutex.hpp>
+#include <XManualResetEvent.hpp>
+#include <XThread.hpp>
+#include <XError.hpp>
+#include <ximaging.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox;
+using namespace CVSandbox::Threading;
+
+namespace Private
+{
+    // Longest time to sleep between frames without checking for seek requests (ms)
+    static const uint32_t MAX_WAIT_SLICE = 50;
+    // Time to wait before moving to the next frame after failing to read one (ms)
+    static const uint32_t ERROR_WAIT_TIME = 100;
+
+    enum
+    {
+        PacingRealTime      = 0,
+        PacingAsFastAsCan   = 1
+    };
+
+    enum
+    {
+        PixelFormatAsRecorded = 0,
+        PixelFormatNV12       = 1,
+        PixelFormatYUV420     = 2
+    };
+
+    // Internal class which hides private parts of the RawFramesVideoSourcePlugin class,
+    // so those are not exposed in the main class
+    class RawFramesVideoSourcePluginData
+    {
+    public:
+        RawFramesVideoSourcePluginData( ) : UserCallbacks( { 0 } ), UserParam( nullptr ),
+            FileName( ), Pacing( PacingRealTime ), CycleFrames( false ),
+            FrameIndex( 0 ), FramesCount( 0 ), SeekRequested( false ), PixelFormat( PixelFormatAsRecorded ),
+            FramesCounter( 0 ), ConvertedImage( nullptr )
+        {
+        }
+
+        ~RawFramesVideoSourcePluginData( )
+        {
+            XImageFree( &ConvertedImage );
+        }
+
+        // Video thread entry point
+        static void WorkerThreadHandler( void* param );
+        // Notify client about new video frame
+        void NewFrameNotify( const ximage* image );
+        // Notify client about error in the video source
+        void ErrorMessageNotify( const char* errorMessage );
+        // Check if seek to another frame was requested
+        bool IsSeekRequested( );
+        // Run video loop in a background worker thread
+        void VideoSourceWorker( );
+        // Play frames from the opened file
+        void PlayFrames( RawFramesFileReader* reader );
+        // Convert frame to the requested planar YUV format (or provide it as is if no conversion is needed)
+        XErrorCode ConvertFrame( const ximage* image, uint8_t pixelFormat, const ximage** frameToProvide );
+
+    public:
+        VideoSourcePluginCallbacks  UserCallbacks;
+        void*                       UserParam;
+
+        string              FileName;
+        uint8_t             Pacing;
+        bool                CycleFrames;
+        uint32_t            FrameIndex;
+        uint32_t            FramesCount;
+        bool                SeekRequested;
+        uint8_t             PixelFormat;
+
+        XMutex              Sync;
+        XManualResetEvent   ExitEvent;
+        XThread             BackgroundThread;
+        uint32_t            FramesCounter;
+        ximage*             ConvertedImage;
+    };
+}
+
+// ==========================================================================
+
+RawFramesVideoSourcePlugin::RawFramesVideoSourcePlugin( ) :
+    mData( new ::Private::RawFramesVideoSourcePluginData( ) )
+{
+}
+
+RawFramesVideoSourcePlugin::~RawFramesVideoSourcePlugin( )
+{
+    delete mData;
+}
+
+void RawFramesVideoSourcePlugin::Dispose( )
+{
+    delete this;
+}
+
+// Start video source so it initializes and begins providing video frames
+XErrorCode RawFramesVideoSourcePlugin::Start( )
+{
+    XScopedLock lock( &mData->Sync );
+    XErrorCode  ret = ErrorFailed;
+
+    mData->FramesCounter = 0;
+    mData->ExitEvent.Reset( );
+
+    if ( mData->BackgroundThread.Create( ::Private::RawFramesVideoSourcePluginData::WorkerThreadHandler, mData ) )
+    {
+        ret = SuccessCode;
+    }
+
+    return ret;
+}
+
+// Signal video to stop, so it could finalize and clean-up
+void RawFramesVideoSourcePlugin::SignalToStop( )
+{
+    XScopedLock lock( &mData->Sync );
+
+    if ( IsRunning( ) )
+    {
+        mData->ExitEvent.Signal( );
+    }
+}
+
+// Wait till video source stops
+void RawFramesVideoSourcePlugin::WaitForStop( )
+{
+    if ( IsRunning( ) )
+    {
+        XScopedLock lock( &mData->Sync );
+        mData->ExitEvent.Signal( );
+    }
+
+    mData->BackgroundThread.Join( );
+}
+
+// Check if video source (its thread) is still running
+bool RawFramesVideoSourcePlugin::IsRunning( )
+{
+    XScopedLock lock( &mData->Sync );
+    return mData->BackgroundThread.IsRunning( );
+}
+
+// Terminate video source - call *ONLY* if video source looks to be frozen and does not stop
+// by itself when signalled (ideally this method should not exist and be called at all)
+void RawFramesVideoSourcePlugin::Terminate( )
+{
+    XScopedLock lock( &mData->Sync );
+
+    if ( IsRunning( ) )
+    {
+        mData->BackgroundThread.Terminate( );
+    }
+}
+
+// Get number of frames received since the the start of the video source
+uint32_t RawFramesVideoSourcePlugin::FramesReceived( )
+{
+    XScopedLock lock( &mData->Sync );
+    return mData->FramesCounter;
+}
+
+// Set callbacks for the video source
+void RawFramesVideoSourcePlugin::SetCallbacks( const VideoSourcePluginCallbacks* callbacks, void* userParam )
+{
+    XScopedLock lock( &mData->Sync );
+
+    if ( callbacks != 0 )
+    {
+        memcpy( &mData->UserCallbacks, callbacks, sizeof( mData->UserCallbacks ) );
+        mData->UserParam = userParam;
+    }
+    else
+    {
+        memset( &mData->UserCallbacks, 0, sizeof( mData->UserCallbacks ) );
+        mData->UserParam = 0;
+    }
+}
+
+// Get specified property value of the plug-in
+XErrorCode RawFramesVideoSourcePlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode  ret = SuccessCode;
+    XScopedLock lock( &mData->Sync );
+
+    switch ( id )
+    {
+    case 0:
+        value->type = XVT_String;
+        value->value.strVal = XStringAlloc( mData->FileName.c_str( ) );
+        break;
+
+    case 1:
+        value->type = XVT_U1;
+        value->value.ubVal = mData->Pacing;
+        break;
+
+    case 2:
+        value->type = XVT_Bool;
+        value->value.boolVal = mData->CycleFrames;
+        break;
+
+    case 3:
+        value->type = XVT_U4;
+        value->value.uiVal = mData->FrameIndex;
+        break;
+
+    case 4:
+        value->type = XVT_U4;
+        value->value.uiVal = mData->FramesCount;
+        break;
+
+    case 5:
+        value->type = XVT_U1;
+        value->value.ubVal = mData->PixelFormat;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+        break;
+    }
+
+    return ret;
+}
+
+// Set specified property value of the plug-in
+XErrorCode RawFramesVideoSourcePlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode  ret = SuccessCode;
+    XScopedLock lock( &mData->Sync );
+
+    xvariant convertedValue;
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 6, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            mData->FileName = string( convertedValue.value.strVal );
+            break;
+
+        case 1:
+            mData->Pacing = convertedValue.value.ubVal;
+            break;
+
+        case 2:
+            mData->CycleFrames = convertedValue.value.boolVal;
+            break;
+
+        case 3:
+            // seek to the specified frame if running or start from it otherwise
+            mData->FrameIndex    = convertedValue.value.uiVal;
+            mData->SeekRequested = true;
+            break;
+
+        case 4:
+            ret = ErrorReadOnlyProperty;
+            break;
+
+        case 5:
+            mData->PixelFormat = convertedValue.value.ubVal;
+            break;
+
+        default:
+            ret = ErrorInvalidProperty;
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
+}
+
+namespace Private
+{
+
+// Video thread entry point
+void RawFramesVideoSourcePluginData::WorkerThreadHandler( void* param )
+{
+    static_cast<RawFramesVideoSourcePluginData*>( param )->VideoSourceWorker( );
+}
+
+// Notify client about new video frame
+void RawFramesVideoSourcePluginData::NewFrameNotify( const ximage* image )
+{
+    XScopedLock lock( &Sync );
+
+    FramesCounter++;
+
+    // provide image only if someone needs it
+    if ( UserCallbacks.NewImageCallback != nullptr )
+    {
+        UserCallbacks.NewImageCallback( UserParam, image );
+    }
+}
+
+// Notify client about error in the video source
+void RawFramesVideoSourcePluginData::ErrorMessageNotify( const char* errorMessage )
+{
+    XScopedLock lock( &Sync );
+
+    if ( UserCallbacks.ErrorMessageCallback != nullptr )
+    {
+        UserCallbacks.ErrorMessageCallback( UserParam, errorMessage );
+    }
+}
+
+// Check if seek to another frame was requested
+bool RawFramesVideoSourcePluginData::IsSeekRequested( )
+{
+    XScopedLock lock( &Sync );
+    return SeekRequested;
+}
+
+// Run video loop in a background thread
+void RawFramesVideoSourcePluginData::VideoSourceWorker( )
+{
+    RawFramesFileReader* reader = nullptr;
+    string               fileName;
+
+    // get copies of the properties we need
+    {
+        XScopedLock lock( &Sync );
+
+        fileName      = FileName;
+        SeekRequested = true;
+    }
+
+    XErrorCode ecode = RawFramesFileReader::Open( fileName, &reader );
+
+    if ( ecode != SuccessCode )
+    {
+        ErrorMessageNotify( XError::Description( ecode ).c_str( ) );
+    }
+    else
+    {
+        {
+            XScopedLock lock( &Sync );
+
+            FramesCount = reader->FramesCount( );
+
+            // start from the beginning if the previous run played all frames
+            if ( FrameIndex >= FramesCount )
+            {
+                FrameIndex = 0;
+            }
+        }
+
+        if ( reader->FramesCount( ) == 0 )
+        {
+            ErrorMessageNotify( "No frames found in the file" );
+        }
+        else
+        {
+            PlayFrames( reader );
+        }
+
+        delete reader;
+    }
+}
+
+// Play frames from the opened file
+void RawFramesVideoSourcePluginData::PlayFrames( RawFramesFileReader* reader )
+{
+    uint32_t                 framesCount   = reader->FramesCount( );
+    bool                     resetTimeBase = true;
+    bool                     needToExit    = false;
+    steady_clock::time_point baseTime;
+    uint64_t                 baseTimestamp = 0;
+    uint32_t                 failedFrames  = 0;
+
+    do
+    {
+        uint32_t index;
+        uint8_t  pacing;
+        uint8_t  pixelFormat;
+        bool     cycleFrames;
+
+        {
+            XScopedLock lock( &Sync );
+
+            index       = FrameIndex;
+            pacing      = Pacing;
+            pixelFormat = PixelFormat;
+            cycleFrames = CycleFrames;
+
+            // start timing from the frame we seek to
+            if ( SeekRequested )
+            {
+                SeekRequested = false;
+                resetTimeBase = true;
+            }
+        }
+
+        if ( index >= framesCount )
+        {
+            if ( cycleFrames )
+            {
+                index         = 0;
+                resetTimeBase = true;
+            }
+            else
+            {
+                ErrorMessageNotify( "No more frames left" );
+                break;
+            }
+        }
+
+        const ximage* image     = nullptr;
+        uint64_t      timestamp = 0;
+        XErrorCode    ecode     = reader->GetFrameTimestamp( index, &timestamp );
+
+        if ( ecode == SuccessCode )
+        {
+            ecode = reader->GetFrame( index, &image );
+        }
+
+        if ( ecode == SuccessCode )
+        {
+            ecode = ConvertFrame( image, pixelFormat, &image );
+        }
+
+        if ( ecode != SuccessCode )
+        {
+            // report only the first of consecutive failures and give up if none of the frames can be read
+            if ( failedFrames == 0 )
+            {
+                ErrorMessageNotify( XError::Description( ecode ).c_str( ) );
+            }
+
+            if ( ++failedFrames >= framesCount )
+            {
+                ErrorMessageNotify( "None of the frames can be read" );
+                break;
+            }
+
+            // don't spin through broken frames, but also don't try catching up on time after them
+            needToExit    = ExitEvent.Wait( ERROR_WAIT_TIME );
+            resetTimeBase = true;
+        }
+        else
+        {
+            failedFrames = 0;
+
+            if ( pacing == PacingRealTime )
+            {
+                if ( ( resetTimeBase ) || ( timestamp < baseTimestamp ) )
+                {
+                    baseTime      = steady_clock::now( );
+                    baseTimestamp = timestamp;
+                    resetTimeBase = false;
+                }
+
+                steady_clock::time_point dueTime = baseTime + microseconds( timestamp - baseTimestamp );
+
+                // wait till it is time to provide the frame, but react to seek requests meanwhile
+                while ( !IsSeekRequested( ) )
+                {
+                    steady_clock::time_point justNow = steady_clock::now( );
+
+                    if ( justNow >= dueTime )
+                    {
+                        break;
+                    }
+
+                    uint32_t timeToWait = static_cast<uint32_t>( duration_cast<milliseconds>( dueTime - justNow ).count( ) ) + 1;
+
+                    if ( ExitEvent.Wait( ( timeToWait > MAX_WAIT_SLICE ) ? MAX_WAIT_SLICE : timeToWait ) )
+                    {
+                        needToExit = true;
+                        break;
+                    }
+                }
+            }
+
+            if ( ( !needToExit ) && ( !IsSeekRequested( ) ) )
+            {
+                NewFrameNotify( image );
+            }
+        }
+
+        // move to the next frame, unless asked to go somewhere else
+        {
+            XScopedLock lock( &Sync );
+
+            if ( !SeekRequested )
+            {
+                FrameIndex = index + 1;
+            }
+        }
+    }
+    while ( ( !needToExit ) && ( !ExitEvent.Wait( 0 ) ) );
+}
+
+// Convert frame to the requested planar YUV format (or provide it as is if no conversion is needed)
+XErrorCode RawFramesVideoSourcePluginData::ConvertFrame( const ximage* image, uint8_t pixelFormat, const ximage** frameToProvide )
+{
+    XErrorCode ret = SuccessCode;
+
+    *frameToProvide = image;
+
+    // only color and grayscale frames are converted, others are provided as recorded
+    if ( ( pixelFormat != PixelFormatAsRecorded ) &&
+         ( ( image->format == XPixelFormatRGB24 ) || ( image->format == XPixelFormatRGBA32 ) ||
+           ( image->format == XPixelFormatGrayscale8 ) ) )
+    {
+        ret = XImageAllocateRaw( image->width, image->height,
+                                 ( pixelFormat == PixelFormatNV12 ) ? XPixelFormatNV12 : XPixelFormatYUV420, &ConvertedImage );
+
+        if ( ret == SuccessCode )
+        {
+            if ( image->format == XPixelFormatGrayscale8 )
+            {
+                ximage* lumaPlane = nullptr;
+
+                // grayscale frame is the luminance plane, while chroma is set to neutral
+                ret = XImageGetPlane( ConvertedImage, &lumaPlane, 0 );
+
+                if ( ret == SuccessCode )
+                {
+                    ret = XImageCopyData( image, lumaPlane );
+                    XImageFree( &lumaPlane );
+                }
+
+                if ( ret == SuccessCode )
+                {
+                    ret = DesaturateYUVImage( ConvertedImage );
+                }
+            }
+            else
+            {
+                ret = ColorToYUV( image, ConvertedImage );
+            }
+        }
+
+        if ( ret == SuccessCode )
+        {
+            *frameToProvide = ConvertedImage;
+        }
+    }
+
+    return ret;
+}
+
+}
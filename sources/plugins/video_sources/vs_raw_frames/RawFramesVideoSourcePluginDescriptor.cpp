@@ -0,0 +1,172 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include <iplugincpp.hpp>
+#include <image_video_16x16.h>
+#include "RawFramesVideoSourcePlugin.hpp"
+
+static void PluginInitializer( );
+static void PluginCleaner( );
+
+// Version of the plug-in
+static xversion PluginVersion = { 1, 0, 0 };
+
+// ID of the plug-in
+static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000021, 0x00000002 };
+
+// File Name property
+static PropertyDescriptor fileNameProperty =
+{ XVT_String, "File Name", "fileName", "Raw frames file to play.", PropertyFlag_PreferredEditor_FileBrowser };
+// Pacing property
+static PropertyDescriptor pacingProperty =
+{ XVT_U1, "Pacing", "pacing", "Specifies how fast frames are provided.", PropertyFlag_SelectionByIndex };
+// Cycle Frames property
+static PropertyDescriptor cycleFramesProperty =
+{ XVT_Bool, "Cycle Frames", "cycleFrames", "Specifies if frames must be cycled in an end-less loop.", PropertyFlag_None };
+// Frame Index property
+static PropertyDescriptor frameIndexProperty =
+{ XVT_U4, "Frame Index", "frameIndex", "Index of the next frame to provide. Setting it while running seeks to the frame.", PropertyFlag_Dynamic };
+// Frames Count property
+static PropertyDescriptor framesCountProperty =
+{ XVT_U4, "Frames Count", "framesCount", "Number of frames in the file (available once started).", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+// Pixel Format property
+static PropertyDescriptor pixelFormatProperty =
+{ XVT_U1, "Pixel Format", "pixelFormat", "Pixel format of provided frames.", PropertyFlag_SelectionByIndex };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &fileNameProperty, &pacingProperty, &cycleFramesProperty,
+    &frameIndexProperty, &framesCountProperty, &pixelFormatProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** RawFramesVideoSourcePlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
+// Register the plug-in
+REGISTER_CPP_PLUGIN_WITH_PROPS
+(
+    PluginID,
+    PluginFamilyID_VirtualVideoSource,
+
+    PluginType_VideoSource,
+    PluginVersion,
+    "Raw Frames Video Source",
+    "RawFramesVideoSource",
+    "Plug-in to replay frames recorded into a raw frames file.",
+
+    /* Long description */
+    "The plug-in replays video frames recorded by <a href='{AF000003-00000000-00000021-00000001}'>Raw Frames Writer</a> "
+    "plug-in. The file is memory mapped, so uncompressed frames are provided without any copying or decoding, which "
+    "allows replaying high resolution recordings with minimal CPU usage.<br><br>"
+
+    "By default frames are provided in real time, i.e. keeping the time intervals between them as they were recorded. "
+    "Alternatively frames can be provided as fast as possible, which is useful for benchmarking image processing. "
+    "The <b>Frame Index</b> property tells which frame is provided next and can be set to seek to a different frame "
+    "(or to start playing from it).<br><br>"
+
+    "The <b>Pixel Format</b> property allows providing color and grayscale frames as planar YUV 4:2:0 images "
+    "(NV12 or YUV420), which is handy for testing image processing of cameras' native formats with recorded video. "
+    "Note: frames have to be converted then, so those are no longer provided without copying."
+    ,
+    &image_video_16x16,
+    nullptr,
+    RawFramesVideoSourcePlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    PluginCleaner,
+    nullptr
+);
+
+// Complete properties description by initializing those parts, which were not
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    // Pacing property
+    pacingProperty.DefaultValue.type = XVT_U1;
+    pacingProperty.DefaultValue.value.ubVal = 0;
+
+    pacingProperty.MinValue.type = XVT_U1;
+    pacingProperty.MinValue.value.ubVal = 0;
+
+    pacingProperty.MaxValue.type = XVT_U1;
+    pacingProperty.MaxValue.value.ubVal = 1;
+
+    pacingProperty.ChoicesCount = 2;
+    pacingProperty.Choices = new xvariant[2];
+
+    pacingProperty.Choices[0].type = XVT_String;
+    pacingProperty.Choices[0].value.strVal = XStringAlloc( "Real time" );
+
+    pacingProperty.Choices[1].type = XVT_String;
+    pacingProperty.Choices[1].value.strVal = XStringAlloc( "As fast as possible" );
+
+    // Cycle Frames property
+    cycleFramesProperty.DefaultValue.type = XVT_Bool;
+    cycleFramesProperty.DefaultValue.value.boolVal = false;
+
+    // Frame Index property
+    frameIndexProperty.DefaultValue.type = XVT_U4;
+    frameIndexProperty.DefaultValue.value.uiVal = 0;
+
+    // Pixel Format property
+    pixelFormatProperty.DefaultValue.type = XVT_U1;
+    pixelFormatProperty.DefaultValue.value.ubVal = 0;
+
+    pixelFormatProperty.MinValue.type = XVT_U1;
+    pixelFormatProperty.MinValue.value.ubVal = 0;
+
+    pixelFormatProperty.MaxValue.type = XVT_U1;
+    pixelFormatProperty.MaxValue.value.ubVal = 2;
+
+    pixelFormatProperty.ChoicesCount = 3;
+    pixelFormatProperty.Choices = new xvariant[3];
+
+    pixelFormatProperty.Choices[0].type = XVT_String;
+    pixelFormatProperty.Choices[0].value.strVal = XStringAlloc( "As recorded" );
+
+    pixelFormatProperty.Choices[1].type = XVT_String;
+    pixelFormatProperty.Choices[1].value.strVal = XStringAlloc( "NV12" );
+
+    pixelFormatProperty.Choices[2].type = XVT_String;
+    pixelFormatProperty.Choices[2].value.strVal = XStringAlloc( "YUV420" );
+}
+
+// Clean-up plug-in - deallocate strings
+static void PluginCleaner( )
+{
+    for ( int i = 0; i < pacingProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &pacingProperty.Choices[i] );
+    }
+
+    delete[] pacingProperty.Choices;
+
+    for ( int i = 0; i < pixelFormatProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &pixelFormatProperty.Choices[i] );
+    }
+
+    delete[] pixelFormatProperty.Choices;
+}
@@ -0,0 +1,234 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include "RawFramesWriterPlugin.hpp"
+#include "RawFramesFile.hpp"
+#include <string>
+#include <chrono>
+#include <XMutex.hpp>
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox::Threading;
+
+// List of supported pixel formats
+const XPixelFormat RawFramesWriterPlugin::supportedPixelFormats[] =
+{
+    XPixelFormatGrayscale8, XPixelFormatRGB24, XPixelFormatRGBA32,
+    XPixelFormatGrayscale16, XPixelFormatRGB48, XPixelFormatRGBA64,
+    XPixelFormatYUV420, XPixelFormatNV12
+};
+
+namespace Private
+{
+    // Internals of raw frames writer class
+    class RawFramesWriterPluginData
+    {
+    public:
+        RawFramesWriterPluginData( ) :
+            FileName( ), Compression( 0 ), Writer( nullptr ), FirstFrameTime( ), FramesWritten( 0 )
+        {
+        }
+
+        ~RawFramesWriterPluginData( )
+        {
+            CloseFile( );
+        }
+
+        void CloseFile( );
+
+    public:
+        mutable XMutex              Sync;
+
+        string                      FileName;
+        uint8_t                     Compression;
+
+        RawFramesFileWriter*        Writer;
+        steady_clock::time_point    FirstFrameTime;
+        uint32_t                    FramesWritten;
+    };
+}
+
+RawFramesWriterPlugin::RawFramesWriterPlugin( ) :
+    mData( new ::Private::RawFramesWriterPluginData( ) )
+{
+}
+
+RawFramesWriterPlugin::~RawFramesWriterPlugin( )
+{
+    delete mData;
+}
+
+void RawFramesWriterPlugin::Dispose( )
+{
+    delete this;
+}
+
+// Get specified property value of the plug-in
+XErrorCode RawFramesWriterPlugin::GetProperty( int32_t id, xvariant* value ) const
+{
+    XErrorCode  ret = SuccessCode;
+    XScopedLock lock( &mData->Sync );
+
+    switch ( id )
+    {
+    case 0:
+        value->type         = XVT_String;
+        value->value.strVal = XStringAlloc( mData->FileName.c_str( ) );
+        break;
+
+    case 1:
+        value->type        = XVT_U1;
+        value->value.ubVal = mData->Compression;
+        break;
+
+    case 2:
+        value->type        = XVT_U4;
+        value->value.uiVal = mData->FramesWritten;
+        break;
+
+    default:
+        ret = ErrorInvalidProperty;
+    }
+
+    return ret;
+}
+
+// Set specified property value of the plug-in
+XErrorCode RawFramesWriterPlugin::SetProperty( int32_t id, const xvariant* value )
+{
+    XErrorCode  ret = ErrorFailed;
+    XScopedLock lock( &mData->Sync );
+    xvariant    convertedValue;
+
+    XVariantInit( &convertedValue );
+
+    // make sure property value has expected type
+    ret = PropertyChangeTypeHelper( id, value, propertiesDescription, 3, &convertedValue );
+
+    if ( ret == SuccessCode )
+    {
+        switch ( id )
+        {
+        case 0:
+            // new frames will go into a new file
+            if ( mData->FileName != convertedValue.value.strVal )
+            {
+                mData->CloseFile( );
+                mData->FileName = convertedValue.value.strVal;
+            }
+            break;
+
+        case 1:
+            mData->Compression = convertedValue.value.ubVal;
+            break;
+
+        case 2:
+            ret = ErrorReadOnlyProperty;
+            break;
+
+        default:
+            ret = ErrorInvalidProperty;
+            break;
+        }
+    }
+
+    XVariantClear( &convertedValue );
+
+    return ret;
+}
+
+// Check if the plug-in does changes to input video frames or not
+bool RawFramesWriterPlugin::IsReadOnlyMode( )
+{
+    return true;
+}
+
+// Get pixel formats supported by the video processing plug-in
+XErrorCode RawFramesWriterPlugin::GetSupportedPixelFormats( XPixelFormat* pixelFormats, int32_t* count )
+{
+    return GetSupportedPixelFormatsImpl( supportedPixelFormats, XARRAY_SIZE( supportedPixelFormats ), pixelFormats, count );
+}
+
+// Process the specified video frame
+XErrorCode RawFramesWriterPlugin::ProcessImage( ximage* src )
+{
+    XErrorCode               ret     = SuccessCode;
+    steady_clock::time_point justNow = steady_clock::now( );
+    XScopedLock              lock( &mData->Sync );
+
+    if ( src == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( mData->FileName.empty( ) )
+    {
+        ret = ErrorInvalidConfiguration;
+    }
+    else
+    {
+        // file is created on the first frame, so timestamps start from zero
+        if ( mData->Writer == nullptr )
+        {
+            ret = RawFramesFileWriter::Create( mData->FileName, ( mData->Compression != 0 ), &mData->Writer );
+
+            mData->FirstFrameTime = justNow;
+            mData->FramesWritten  = 0;
+        }
+
+        if ( ret == SuccessCode )
+        {
+            uint64_t timestamp = static_cast<uint64_t>( duration_cast<microseconds>( justNow - mData->FirstFrameTime ).count( ) );
+
+            ret = mData->Writer->WriteFrame( src, timestamp );
+
+            if ( ret == SuccessCode )
+            {
+                mData->FramesWritten = mData->Writer->FramesCount( );
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Reset run time state of the video processing plug-in
+void RawFramesWriterPlugin::Reset( )
+{
+    XScopedLock lock( &mData->Sync );
+
+    mData->CloseFile( );
+}
+
+namespace Private
+{
+    // Finalize the file being written, if any
+    void RawFramesWriterPluginData::CloseFile( )
+    {
+        if ( Writer != nullptr )
+        {
+            Writer->Close( );
+            delete Writer;
+            Writer = nullptr;
+        }
+    }
+}
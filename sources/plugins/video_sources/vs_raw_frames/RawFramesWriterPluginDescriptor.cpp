@@ -0,0 +1,124 @@
+/*
+    Raw frames recording plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include <iplugincpp.hpp>
+#include <image_video_processing_16x16.h>
+#include "RawFramesWriterPlugin.hpp"
+
+static void PluginInitializer( );
+static void PluginCleaner( );
+
+// Version of the plug-in
+static xversion PluginVersion = { 1, 0, 0 };
+
+// ID of the plug-in
+static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000021, 0x00000001 };
+
+// File Name property
+static PropertyDescriptor fileNameProperty =
+{ XVT_String, "File Name", "fileName", "Raw frames file to write.", PropertyFlag_PreferredEditor_FileBrowser };
+// Compression property
+static PropertyDescriptor compressionProperty =
+{ XVT_U1, "Compression", "compression", "Compression of frames' data.", PropertyFlag_SelectionByIndex };
+// Frames Written property
+static PropertyDescriptor framesWrittenProperty =
+{ XVT_U4, "Frames Written", "framesWritten", "Number of frames written into the current file.", PropertyFlag_ReadOnly | PropertyFlag_Dynamic };
+
+// Array of available properties
+static PropertyDescriptor* pluginProperties[] =
+{
+    &fileNameProperty, &compressionProperty, &framesWrittenProperty
+};
+
+// Let the class itself know description of its properties
+const PropertyDescriptor** RawFramesWriterPlugin::propertiesDescription = (const PropertyDescriptor**) pluginProperties;
+
+// Register the plug-in
+REGISTER_CPP_PLUGIN_WITH_PROPS
+(
+    PluginID,
+    PluginFamilyID_VideoProcessing,
+
+    PluginType_VideoProcessing,
+    PluginVersion,
+    "Raw Frames Writer",
+    "RawFramesWriter",
+    "Plug-in to record uncompressed video frames into a raw frames file.",
+
+    /* Long description */
+    "The plug-in records video frames into a file as they are, together with their time stamps, so the recording "
+    "can be replayed later using <a href='{AF000003-00000000-00000021-00000002}'>Raw Frames Video Source</a> plug-in. "
+    "Unlike video codecs, frames are not altered in any way, which makes the recordings suitable for repeatable testing "
+    "of image processing and computer vision routines. Optionally frames can be compressed with a fast lossless "
+    "compression, which helps with images having large uniform areas.<br><br>"
+
+    "A new file is created (overwriting existing one) on the first frame after the plug-in was started or its file name "
+    "was changed. The file gets finalized when the plug-in is stopped.<br><br>"
+
+    "<b>Note</b>: recording uncompressed video requires a lot of disk space and bandwidth. For example, 640x480 RGB video "
+    "at 30 frames per second takes about 26 MB per second."
+    ,
+    &image_video_processing_16x16,
+    nullptr,
+    RawFramesWriterPlugin,
+
+    XARRAY_SIZE( pluginProperties ),
+    pluginProperties,
+    PluginInitializer,
+    PluginCleaner,
+    nullptr
+);
+
+// Complete properties description by initializing those parts, which were not
+// initialized during properties array declaration
+static void PluginInitializer( )
+{
+    // Compression property
+    compressionProperty.DefaultValue.type = XVT_U1;
+    compressionProperty.DefaultValue.value.ubVal = 0;
+
+    compressionProperty.MinValue.type = XVT_U1;
+    compressionProperty.MinValue.value.ubVal = 0;
+
+    compressionProperty.MaxValue.type = XVT_U1;
+    compressionProperty.MaxValue.value.ubVal = 1;
+
+    compressionProperty.ChoicesCount = 2;
+    compressionProperty.Choices = new xvariant[2];
+
+    compressionProperty.Choices[0].type = XVT_String;
+    compressionProperty.Choices[0].value.strVal = XStringAlloc( "None" );
+
+    compressionProperty.Choices[1].type = XVT_String;
+    compressionProperty.Choices[1].value.strVal = XStringAlloc( "Fast lossless (LZ4 block)" );
+}
+
+// Clean-up plug-in - deallocate strings
+static void PluginCleaner( )
+{
+    for ( int i = 0; i < compressionProperty.ChoicesCount; i++ )
+    {
+        XVariantClear( &compressionProperty.Choices[i] );
+    }
+
+    delete[] compressionProperty.Choices;
+}
@@ -0,0 +1,18 @@
+# vs_raw_frames plug-in source files
+
+# search path for source files
+VPATH = ../../
+
+# source files
+SRC = vs_raw_frames.cpp \
+	RawFramesCodec.cpp RawFramesFile.cpp \
+	RawFramesVideoSourcePlugin.cpp RawFramesVideoSourcePluginDescriptor.cpp \
+	RawFramesWriterPlugin.cpp RawFramesWriterPluginDescriptor.cpp
+
+# additional include folders
+INCLUDES = -I../../../../../afx/afx_types -I../../../../../afx/afx_types+ \
+	-I../../../../../afx/afx_platform+ -I../../../../../afx/afx_imaging \
+	-I../../../../../core/iplugin -I../../../../../images
+
+# libraries to use
+LIBS = -liplugin -lafx_platform+ -lafx_types+ -lafx_imaging -lafx_types
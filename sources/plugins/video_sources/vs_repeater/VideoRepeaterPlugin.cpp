@@ -21,12 +21,16 @@
 
 #include "VideoRepeaterPlugin.hpp"
 #include "VideoRepeaterRegistry.hpp"
+#include "VideoRepeaterSharedBus.hpp"
 #include <memory.h>
 #include <string>
+#include <algorithm>
 #include <XMutex.hpp>
 #include <XManualResetEvent.hpp>
+#include <XAutoResetEvent.hpp>
 #include <XThread.hpp>
 #include <XVariant.hpp>
+#include <XError.hpp>
 
 using namespace std;
 using namespace CVSandbox;
@@ -34,6 +38,9 @@ using namespace CVSandbox::Threading;
 
 static const char* ERROR_MESSAGE = "Failed re-translating image - out of memory";
 
+// Time to wait for frames published into shared memory (or for the bus to appear) before checking exit event
+static const uint32_t SHARED_BUS_WAIT_TIME = 100;
+
 namespace Private
 {
     // Internal class which hides private parts of the VideoRepeaterPlugin class,
@@ -41,8 +48,8 @@ namespace Private
     class VideoRepeaterPluginData
     {
     public:
-        VideoRepeaterPluginData( ) : RepeaterId( ), UserCallbacks( { 0 } ), UserParam( nullptr ),
-            PushedImage( nullptr ), NotifiedImage( nullptr )
+        VideoRepeaterPluginData( ) : RepeaterId( ), SharedMemory( false ), UserCallbacks( { 0 } ), UserParam( nullptr ),
+            PushedImage( nullptr ), NotifiedImage( nullptr ), IsNewImagePushed( false ), IsSharedRun( false )
         {
         }
 
@@ -60,19 +67,24 @@ namespace Private
         void ErrorMessageNotify( const char* errorMessage );
         // Run video loop in a background worker thread
         void VideoSourceWorker( );
+        // Run video loop receiving frames from shared memory
+        void SharedVideoSourceWorker( );
 
     public:
         string                      RepeaterId;
+        bool                        SharedMemory;
         VideoSourcePluginCallbacks  UserCallbacks;
         void*                       UserParam;
 
         ximage*             PushedImage;
         ximage*             NotifiedImage;
+        bool                IsNewImagePushed;
+        bool                IsSharedRun;
 
         XMutex              Sync;
         XMutex              ImageSync;
         XManualResetEvent   ExitEvent;
-        XManualResetEvent   NewImageEvent;
+        XAutoResetEvent     NewImageEvent;
         XThread             BackgroundThread;
         uint32_t            FramesCounter;
     };
@@ -102,11 +114,16 @@ XErrorCode VideoRepeaterPlugin::Start( )
     XErrorCode  ret = ErrorFailed;
 
     mData->FramesCounter = 0;
+    mData->IsSharedRun   = mData->SharedMemory;
     mData->ExitEvent.Reset( );
 
     if ( mData->BackgroundThread.Create( ::Private::VideoRepeaterPluginData::WorkerThreadHandler, mData ) )
     {
-        VideoRepeaterRegistry::Instance( )->AddRepeater( mData->RepeaterId, this );
+        // repeater receiving frames from shared memory does not accept pushes from the same process
+        if ( !mData->IsSharedRun )
+        {
+            VideoRepeaterRegistry::Instance( )->AddRepeater( mData->RepeaterId, this );
+        }
         ret = SuccessCode;
     }
 
@@ -154,7 +171,11 @@ void VideoRepeaterPlugin::Terminate( )
     if ( IsRunning( ) )
     {
         mData->BackgroundThread.Terminate( );
-        VideoRepeaterRegistry::Instance( )->RemoveRepeater( mData->RepeaterId );
+
+        if ( !mData->IsSharedRun )
+        {
+            VideoRepeaterRegistry::Instance( )->RemoveRepeater( mData->RepeaterId );
+        }
     }
 }
 
@@ -194,6 +215,11 @@ XErrorCode VideoRepeaterPlugin::GetProperty( int32_t id, xvariant* value ) const
         value->value.strVal = XStringAlloc( mData->RepeaterId.c_str( ) );
         break;
 
+    case 1:
+        value->type          = XVT_Bool;
+        value->value.boolVal = mData->SharedMemory;
+        break;
+
     default:
         ret = ErrorInvalidProperty;
         break;
@@ -221,6 +247,10 @@ XErrorCode VideoRepeaterPlugin::SetProperty( int32_t id, const xvariant* value )
         }
         break;
 
+    case 1:
+        mData->SharedMemory = xvar.ToBool( &ret );
+        break;
+
     default:
         ret = ErrorInvalidProperty;
         break;
@@ -234,12 +264,14 @@ void VideoRepeaterPlugin::PushImage( const ximage* image )
 {
     XScopedLock lock( &mData->ImageSync );
 
+    // image buffer is reused, if the pushed image is of the same size/format as the one before the last
     if ( XImageClone( image, &mData->PushedImage ) != SuccessCode )
     {
         mData->ErrorMessageNotify( ERROR_MESSAGE );
     }
     else
     {
+        mData->IsNewImagePushed = true;
         mData->NewImageEvent.Signal( );
     }
 }
@@ -249,7 +281,16 @@ namespace Private
     // Video thread entry point
     void VideoRepeaterPluginData::WorkerThreadHandler( void* param )
     {
-        static_cast<VideoRepeaterPluginData*>( param )->VideoSourceWorker( );
+        VideoRepeaterPluginData* self = static_cast<VideoRepeaterPluginData*>( param );
+
+        if ( self->IsSharedRun )
+        {
+            self->SharedVideoSourceWorker( );
+        }
+        else
+        {
+            self->VideoSourceWorker( );
+        }
     }
 
     // Notify client about new video frame
@@ -289,18 +330,21 @@ namespace Private
                 break;
             }
 
+            bool gotImage = false;
+
+            // swap images instead of copying the pushed one, so only one copy is done per frame
             {
                 XScopedLock lock( &ImageSync );
 
-                if ( XImageClone( PushedImage, &NotifiedImage ) != SuccessCode )
+                if ( IsNewImagePushed )
                 {
-                    ErrorMessageNotify( ERROR_MESSAGE );
+                    std::swap( PushedImage, NotifiedImage );
+                    IsNewImagePushed = false;
+                    gotImage         = true;
                 }
             }
 
-            NewImageEvent.Reset( );
-
-            if ( NotifiedImage != nullptr )
+            if ( gotImage )
             {
                 NewFrameNotify( NotifiedImage );
             }
@@ -308,4 +352,52 @@ namespace Private
 
         VideoRepeaterRegistry::Instance( )->RemoveRepeater( RepeaterId );
     }
+
+    // Run video loop receiving frames from shared memory
+    void VideoRepeaterPluginData::SharedVideoSourceWorker( )
+    {
+        VideoRepeaterSharedBus* bus         = nullptr;
+        uint32_t                frameNumber = 0;
+
+        while ( !ExitEvent.Wait( 0 ) )
+        {
+            if ( bus == nullptr )
+            {
+                // publisher may not be running yet or it is re-creating the bus
+                if ( VideoRepeaterSharedBus::Open( RepeaterId, &bus ) != SuccessCode )
+                {
+                    ExitEvent.Wait( SHARED_BUS_WAIT_TIME );
+                    continue;
+                }
+
+                frameNumber = 0;
+            }
+
+            if ( bus->WaitForFrame( frameNumber, SHARED_BUS_WAIT_TIME ) )
+            {
+                uint32_t lastFrameNumber = frameNumber;
+
+                XErrorCode ecode = bus->GetLatestFrame( &frameNumber, &NotifiedImage );
+
+                if ( ecode != SuccessCode )
+                {
+                    ErrorMessageNotify( XError::Description( ecode ).c_str( ) );
+                }
+                else if ( frameNumber != lastFrameNumber )
+                {
+                    NewFrameNotify( NotifiedImage );
+                }
+            }
+            else if ( bus->IsClosed( ) )
+            {
+                delete bus;
+                bus = nullptr;
+
+                // give publisher time to re-create the bus
+                ExitEvent.Wait( SHARED_BUS_WAIT_TIME );
+            }
+        }
+
+        delete bus;
+    }
 }
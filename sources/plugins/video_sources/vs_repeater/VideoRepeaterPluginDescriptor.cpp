@@ -33,10 +33,14 @@ static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000010, 0x00000001 };
 static PropertyDescriptor repeaterIdProperty =
 { XVT_String, "Repeater ID", "id", "ID to associate with the repeater (used by push plug-in).", PropertyFlag_None };
 
+// Shared memory property
+static PropertyDescriptor sharedMemoryProperty =
+{ XVT_Bool, "Shared Memory", "sharedMemory", "Receive images pushed from other processes through shared memory.", PropertyFlag_None };
+
 // Array of available properties
 static PropertyDescriptor* pluginProperties[] =
 {
-    &repeaterIdProperty
+    &repeaterIdProperty, &sharedMemoryProperty
 };
 
 // Let the class itself know description of its properties
@@ -64,6 +68,11 @@ REGISTER_CPP_PLUGIN_WITH_PROPS
     "<b>Note:</b> in order for this plug-in to accept images from a push plug-in, both must be configured with the same "
     "<b>Repeater ID</b>.<br><br>"
 
+    "If <b>Shared Memory</b> property is set, the repeater receives images pushed from other processes (or from the "
+    "same one) by push plug-ins, which have the same property set. Images are passed through a ring buffer in shared "
+    "memory, so video of one application can be processed by a number of other applications. The repeater starts "
+    "providing frames as soon as a publisher appears and keeps waiting for it, if it gets restarted.<br><br>"
+
     "More information : <a href = 'http://www.cvsandbox.com/cvsandbox/tutorials/video_repeaters/'>Video Repeaters</a>"
     ,
     &image_video_repeater_plugin_16x16,
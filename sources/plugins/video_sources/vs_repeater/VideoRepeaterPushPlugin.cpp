@@ -22,6 +22,7 @@
 #include "VideoRepeaterPushPlugin.hpp"
 #include "VideoRepeaterRegistry.hpp"
 #include "VideoRepeaterPlugin.hpp"
+#include "VideoRepeaterSharedBus.hpp"
 #include <XVariant.hpp>
 
 using namespace std;
@@ -40,13 +41,24 @@ namespace Private
     {
     public:
         VideoRepeaterPushPluginData( ) :
-            RepeaterId( )
+            RepeaterId( ), SharedMemory( false ), Bus( nullptr )
         {
         }
 
+        ~VideoRepeaterPushPluginData( )
+        {
+            CloseBus( );
+        }
+
+        XErrorCode PublishImage( const ximage* image );
+        void CloseBus( );
+
     public:
         string RepeaterId;
+        bool   SharedMemory;
 
+    private:
+        VideoRepeaterSharedBus* Bus;
     };
 }
 
@@ -78,6 +90,11 @@ XErrorCode VideoRepeaterPushPlugin::GetProperty( int32_t id, xvariant* value ) c
         value->value.strVal = XStringAlloc( mData->RepeaterId.c_str( ) );
         break;
 
+    case 1:
+        value->type          = XVT_Bool;
+        value->value.boolVal = mData->SharedMemory;
+        break;
+
     default:
         ret = ErrorInvalidProperty;
         break;
@@ -98,6 +115,7 @@ XErrorCode VideoRepeaterPushPlugin::SetProperty( int32_t id, const xvariant* val
         if ( xvar.Type( ) == XVT_String )
         {
             mData->RepeaterId = xvar.ToString( &ret );
+            mData->CloseBus( );
         }
         else
         {
@@ -105,6 +123,11 @@ XErrorCode VideoRepeaterPushPlugin::SetProperty( int32_t id, const xvariant* val
         }
         break;
 
+    case 1:
+        mData->SharedMemory = xvar.ToBool( &ret );
+        mData->CloseBus( );
+        break;
+
     default:
         ret = ErrorInvalidProperty;
         break;
@@ -134,6 +157,10 @@ XErrorCode VideoRepeaterPushPlugin::ProcessImage( ximage* src )
     {
         ret = ErrorNullParameter;
     }
+    else if ( mData->SharedMemory )
+    {
+        ret = mData->PublishImage( src );
+    }
     else
     {
         VideoRepeaterPlugin* repeater = VideoRepeaterRegistry::Instance( )->GetRepeater( mData->RepeaterId );
@@ -151,5 +178,40 @@ XErrorCode VideoRepeaterPushPlugin::ProcessImage( ximage* src )
 // Reset run time state of the video processing plug-in
 void VideoRepeaterPushPlugin::Reset( )
 {
-    // nothing to be done
+    mData->CloseBus( );
+}
+
+namespace Private
+{
+    // Publish image into shared memory bus, creating it if needed
+    XErrorCode VideoRepeaterPushPluginData::PublishImage( const ximage* image )
+    {
+        XErrorCode ret       = SuccessCode;
+        uint32_t   frameSize = VideoRepeaterSharedBus::GetFrameSize( image );
+
+        // re-create the bus if it can not keep the new image - consumers will re-open it
+        if ( ( Bus != nullptr ) && ( frameSize > Bus->MaxFrameSize( ) ) )
+        {
+            CloseBus( );
+        }
+
+        if ( Bus == nullptr )
+        {
+            ret = VideoRepeaterSharedBus::Create( RepeaterId, frameSize, &Bus );
+        }
+
+        if ( ret == SuccessCode )
+        {
+            ret = Bus->Publish( image );
+        }
+
+        return ret;
+    }
+
+    // Close shared memory bus, so consumers know there is no publisher
+    void VideoRepeaterPushPluginData::CloseBus( )
+    {
+        delete Bus;
+        Bus = nullptr;
+    }
 }
@@ -33,10 +33,14 @@ static xguid PluginID = { 0xAF000003, 0x00000000, 0x00000010, 0x00000002 };
 static PropertyDescriptor repeaterIdProperty =
 { XVT_String, "Repeater ID", "id", "Repeater ID to push video into.", PropertyFlag_None };
 
+// Shared memory property
+static PropertyDescriptor sharedMemoryProperty =
+{ XVT_Bool, "Shared Memory", "sharedMemory", "Push images into shared memory, so repeaters of other processes could receive them.", PropertyFlag_None };
+
 // Array of available properties
 static PropertyDescriptor* pluginProperties[] =
 {
-    &repeaterIdProperty
+    &repeaterIdProperty, &sharedMemoryProperty
 };
 
 // Let the class itself know description of its properties
@@ -57,6 +61,11 @@ REGISTER_CPP_PLUGIN_WITH_PROPS
     "This plug-in is used to push images into <a href='{AF000003-00000000-00000010-00000001}'>Video Repeater</a> "
     "with specified <b>Repeater ID</b>. Once image is pushed into repeater, it will generate a new video frame as "
     "any other video source would do.<br><br>"
+
+    "If <b>Shared Memory</b> property is set, images are published into shared memory instead, where they can be "
+    "picked by any number of repeaters running in other processes. Only one push plug-in can publish images with "
+    "the same <b>Repeater ID</b> at a time. Publishing does not wait for the repeaters, which always get the latest "
+    "pushed image.<br><br>"
     
     "More information : <a href = 'http://www.cvsandbox.com/cvsandbox/tutorials/video_repeaters/'>Video Repeaters</a>"
     ,
@@ -0,0 +1,719 @@
+/*
+    Video repeater plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "VideoRepeaterSharedBus.hpp"
+#include <atomic>
+#include <new>
+#include <memory.h>
+#include <XThread.hpp>
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <signal.h>
+    #include <errno.h>
+    #ifdef __linux__
+        #include <limits.h>
+        #include <time.h>
+        #include <sys/syscall.h>
+        #include <linux/futex.h>
+    #endif
+#endif
+
+using namespace std;
+using namespace CVSandbox::Threading;
+
+namespace Private
+{
+    static const uint32_t BUS_MAGIC       = 0x53425643; // "CVBS"
+    static const uint32_t BUS_VERSION     = 1;
+    static const uint32_t BUS_SLOTS_COUNT = 4;
+    static const uint32_t BUS_GENERATIONS = 8;          // re-created bus gets new name while consumers may still map the old one
+    static const size_t   BUS_ALIGNMENT   = 64;         // keep header and slots on separate cache lines
+
+    // Header of the shared memory buffer
+    struct SharedBusHeader
+    {
+        std::atomic<uint32_t> Magic;            // set by publisher last, once the rest is initialized
+        uint32_t              Version;
+        uint32_t              SlotsCount;
+        uint32_t              SlotSize;         // maximum size of frame's data in a slot
+        uint32_t              PublisherId;      // ID of the publishing process
+        std::atomic<uint32_t> Closed;
+        std::atomic<uint32_t> FrameNumber;      // number of published frames, consumers wait on its change
+        std::atomic<uint32_t> WaitersCount;
+    };
+
+    // Header of a slot in the ring buffer, which is followed by frame's data
+    struct SharedBusSlot
+    {
+        std::atomic<uint32_t> Sequence;         // odd while publisher writes into the slot
+        std::atomic<uint32_t> FrameNumber;
+        std::atomic<int32_t>  Width;
+        std::atomic<int32_t>  Height;
+        std::atomic<int32_t>  Format;
+    };
+
+    static_assert( sizeof( SharedBusHeader ) <= BUS_ALIGNMENT, "Shared bus header does not fit into its space" );
+    static_assert( sizeof( SharedBusSlot ) <= BUS_ALIGNMENT, "Shared bus slot header does not fit into its space" );
+    static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "Atomic counters must be usable as futex words" );
+
+    static size_t AlignSize( size_t size )
+    {
+        return ( size + BUS_ALIGNMENT - 1 ) & ~( BUS_ALIGNMENT - 1 );
+    }
+
+    static size_t SlotStride( uint32_t slotSize )
+    {
+        return BUS_ALIGNMENT + AlignSize( slotSize );
+    }
+
+    static size_t BufferSize( uint32_t slotSize, uint32_t slotsCount )
+    {
+        return BUS_ALIGNMENT + SlotStride( slotSize ) * slotsCount;
+    }
+
+    // Get name of the shared memory object to use for the specified repeater ID and bus generation
+    static string GetSharedMemoryName( const string& id, uint32_t generation )
+    {
+        string name;
+
+    #ifdef WIN32
+        name = "Local\\cvsandbox_repeater_";
+    #else
+        name = "/cvsandbox_repeater_";
+    #endif
+
+        // keep only characters which are safe for all systems, making sure name is not too long
+        for ( size_t i = 0, n = id.length( ); ( i < n ) && ( i < 200 ); i++ )
+        {
+            char c = id[i];
+
+            name += ( ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) ) ||
+                      ( ( c >= '0' ) && ( c <= '9' ) ) || ( c == '-' ) || ( c == '.' ) ) ? c : '_';
+        }
+
+        name += '_';
+        name += static_cast<char>( '0' + generation );
+
+        return name;
+    }
+
+    static uint32_t CurrentProcessId( )
+    {
+    #ifdef WIN32
+        return static_cast<uint32_t>( GetCurrentProcessId( ) );
+    #else
+        return static_cast<uint32_t>( getpid( ) );
+    #endif
+    }
+
+    // Check if process with the specified ID is still running
+    static bool IsProcessAlive( uint32_t processId )
+    {
+    #ifdef WIN32
+        HANDLE process = OpenProcess( SYNCHRONIZE, FALSE, static_cast<DWORD>( processId ) );
+        bool   ret     = ( process == NULL ) ? ( GetLastError( ) != ERROR_INVALID_PARAMETER ) :
+                                               ( WaitForSingleObject( process, 0 ) == WAIT_TIMEOUT );
+
+        if ( process != NULL )
+        {
+            CloseHandle( process );
+        }
+
+        return ret;
+    #else
+        return ( ( kill( static_cast<pid_t>( processId ), 0 ) == 0 ) || ( errno != ESRCH ) );
+    #endif
+    }
+
+    // Wake up everyone waiting for change of the specified counter (wake handle is a semaphore on Windows)
+    static void WakeWaiters( std::atomic<uint32_t>* counter, void* wakeHandle, uint32_t waitersCount )
+    {
+    #ifdef WIN32
+        XUNREFERENCED_PARAMETER( counter )
+
+        if ( ( wakeHandle != nullptr ) && ( waitersCount != 0 ) )
+        {
+            ReleaseSemaphore( static_cast<HANDLE>( wakeHandle ), static_cast<LONG>( waitersCount ), NULL );
+        }
+    #elif defined( __linux__ )
+        XUNREFERENCED_PARAMETER( wakeHandle )
+        XUNREFERENCED_PARAMETER( waitersCount )
+
+        // not a private futex, since waiters live in other processes
+        syscall( SYS_futex, reinterpret_cast<uint32_t*>( counter ), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0 );
+    #else
+        XUNREFERENCED_PARAMETER( counter )
+        XUNREFERENCED_PARAMETER( wakeHandle )
+        XUNREFERENCED_PARAMETER( waitersCount )
+    #endif
+    }
+
+    #if !defined( __linux__ )
+    // Poll the counter for the specified amount of time till it changes its value
+    static void PollForChange( std::atomic<uint32_t>* counter, uint32_t value, uint32_t msec )
+    {
+        for ( uint32_t i = 0; ( i < msec ) && ( counter->load( std::memory_order_acquire ) == value ); i++ )
+        {
+            XThread::Sleep( 1 );
+        }
+    }
+    #endif
+
+    // Wait the specified amount of time till the counter changes its value
+    static void WaitForChange( std::atomic<uint32_t>* counter, uint32_t value, void* wakeHandle, uint32_t msec )
+    {
+    #ifdef WIN32
+        if ( wakeHandle != nullptr )
+        {
+            // may wake up for a count released for a waiter which timed out, so caller checks the counter again
+            WaitForSingleObject( static_cast<HANDLE>( wakeHandle ), msec );
+        }
+        else
+        {
+            PollForChange( counter, value, msec );
+        }
+    #elif defined( __linux__ )
+        struct timespec timeout;
+
+        XUNREFERENCED_PARAMETER( wakeHandle )
+
+        timeout.tv_sec  = msec / 1000;
+        timeout.tv_nsec = ( msec % 1000 ) * 1000000;
+
+        syscall( SYS_futex, reinterpret_cast<uint32_t*>( counter ), FUTEX_WAIT, value, &timeout, nullptr, 0 );
+    #else
+        XUNREFERENCED_PARAMETER( wakeHandle )
+
+        // no cross process futex available, so just poll the counter
+        PollForChange( counter, value, msec );
+    #endif
+    }
+
+    #ifndef WIN32
+    // Check if the bus with the specified name was left by a publisher, which did not close it (crashed)
+    static bool IsBusAbandoned( const string& name )
+    {
+        bool ret = false;
+        int  fd = shm_open( name.c_str( ), O_RDONLY, 0 );
+
+        if ( fd != -1 )
+        {
+            void* ptr = mmap( nullptr, BUS_ALIGNMENT, PROT_READ, MAP_SHARED, fd, 0 );
+
+            if ( ptr != MAP_FAILED )
+            {
+                const SharedBusHeader* header = static_cast<const SharedBusHeader*>( ptr );
+
+                if ( header->Magic.load( std::memory_order_acquire ) == BUS_MAGIC )
+                {
+                    ret = ( header->Closed.load( std::memory_order_acquire ) != 0 ) ||
+                          ( !IsProcessAlive( header->PublisherId ) );
+                }
+
+                munmap( ptr, BUS_ALIGNMENT );
+            }
+
+            close( fd );
+        }
+
+        return ret;
+    }
+    #endif
+}
+
+using namespace ::Private;
+
+VideoRepeaterSharedBus::VideoRepeaterSharedBus( const string& name, bool isPublisher ) :
+    mName( name ), mIsPublisher( isPublisher ), mHeader( nullptr ), mBuffer( nullptr ), mBufferSize( 0 ),
+    mMapHandle( nullptr ), mWakeHandle( nullptr )
+{
+}
+
+VideoRepeaterSharedBus::~VideoRepeaterSharedBus( )
+{
+    if ( ( mIsPublisher ) && ( mHeader != nullptr ) )
+    {
+        mHeader->Closed.store( 1, std::memory_order_release );
+        WakeWaiters( &mHeader->FrameNumber, mWakeHandle, mHeader->WaitersCount.load( std::memory_order_seq_cst ) );
+    }
+
+    Unmap( );
+}
+
+// Create new bus for publishing frames of the specified maximum size (in bytes)
+XErrorCode VideoRepeaterSharedBus::Create( const string& id, uint32_t maxFrameSize, VideoRepeaterSharedBus** bus )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( bus == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( ( id.empty( ) ) || ( maxFrameSize == 0 ) )
+    {
+        ret = ErrorInvalidArgument;
+    }
+    else
+    {
+        VideoRepeaterSharedBus* newBus = nullptr;
+
+        // there must be only one publisher for a bus
+        if ( Open( id, &newBus ) == SuccessCode )
+        {
+            delete newBus;
+            newBus = nullptr;
+        }
+        else
+        {
+            // closed buses may still be mapped by consumers, which did not notice it yet, so take first free generation
+            for ( uint32_t generation = 0; ( generation < BUS_GENERATIONS ) && ( newBus == nullptr ); generation++ )
+            {
+                newBus = new VideoRepeaterSharedBus( GetSharedMemoryName( id, generation ), true );
+
+                if ( !newBus->Map( true, BufferSize( maxFrameSize, BUS_SLOTS_COUNT ) ) )
+                {
+                    delete newBus;
+                    newBus = nullptr;
+                }
+            }
+        }
+
+        if ( newBus == nullptr )
+        {
+            ret = ErrorInitializationFailed;
+        }
+        else
+        {
+            SharedBusHeader* header = new ( newBus->mBuffer ) SharedBusHeader( );
+
+            header->Version     = BUS_VERSION;
+            header->SlotsCount  = BUS_SLOTS_COUNT;
+            header->SlotSize    = maxFrameSize;
+            header->PublisherId = CurrentProcessId( );
+            header->Closed.store( 0, std::memory_order_relaxed );
+            header->FrameNumber.store( 0, std::memory_order_relaxed );
+            header->WaitersCount.store( 0, std::memory_order_relaxed );
+
+            for ( uint32_t i = 0; i < BUS_SLOTS_COUNT; i++ )
+            {
+                SharedBusSlot* slot = new ( newBus->mBuffer + BUS_ALIGNMENT + SlotStride( maxFrameSize ) * i ) SharedBusSlot( );
+
+                slot->Sequence.store( 0, std::memory_order_relaxed );
+                slot->FrameNumber.store( 0, std::memory_order_relaxed );
+            }
+
+            // let consumers know the bus is ready to use
+            header->Magic.store( BUS_MAGIC, std::memory_order_release );
+
+            newBus->mHeader = header;
+            *bus = newBus;
+        }
+    }
+
+    return ret;
+}
+
+// Open bus created by another process (or the same one)
+XErrorCode VideoRepeaterSharedBus::Open( const string& id, VideoRepeaterSharedBus** bus )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( bus == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( id.empty( ) )
+    {
+        ret = ErrorInvalidArgument;
+    }
+    else
+    {
+        bool opened = false;
+
+        // look for the generation of the bus, which is still published
+        for ( uint32_t generation = 0; ( generation < BUS_GENERATIONS ) && ( !opened ); generation++ )
+        {
+            opened = OpenExisting( GetSharedMemoryName( id, generation ), bus );
+        }
+
+        if ( !opened )
+        {
+            ret = ErrorDeivceNotReady;
+        }
+    }
+
+    return ret;
+}
+
+// Open bus with the specified shared memory name, if it is ready to use and not closed by its publisher
+bool VideoRepeaterSharedBus::OpenExisting( const string& name, VideoRepeaterSharedBus** bus )
+{
+    VideoRepeaterSharedBus* newBus = new VideoRepeaterSharedBus( name, false );
+    SharedBusHeader*        header = nullptr;
+
+    if ( newBus->Map( false, 0 ) )
+    {
+        header = reinterpret_cast<SharedBusHeader*>( newBus->mBuffer );
+
+        // publisher may still be initializing it, the bus may be of another version or it may be already closed
+        if ( ( header->Magic.load( std::memory_order_acquire ) != BUS_MAGIC ) ||
+             ( header->Version != BUS_VERSION ) || ( header->SlotsCount == 0 ) ||
+             ( BufferSize( header->SlotSize, header->SlotsCount ) > newBus->mBufferSize ) ||
+             ( header->Closed.load( std::memory_order_acquire ) != 0 ) ||
+             ( !IsProcessAlive( header->PublisherId ) ) )
+        {
+            header = nullptr;
+        }
+    }
+
+    if ( header == nullptr )
+    {
+        delete newBus;
+    }
+    else
+    {
+        newBus->mHeader = header;
+        *bus = newBus;
+    }
+
+    return ( header != nullptr );
+}
+
+// Get size of image data, which can be published into the bus
+uint32_t VideoRepeaterSharedBus::GetFrameSize( const ximage* image )
+{
+    return ( image == nullptr ) ? 0 :
+        static_cast<uint32_t>( image->height ) * XImageBytesPerLine( image->width * XImageBitsPerPixel( image->format ) );
+}
+
+// Get maximum size of a frame, which can be published into the bus
+uint32_t VideoRepeaterSharedBus::MaxFrameSize( ) const
+{
+    return mHeader->SlotSize;
+}
+
+// Check if publisher has closed the bus
+bool VideoRepeaterSharedBus::IsClosed( ) const
+{
+    return ( mHeader->Closed.load( std::memory_order_acquire ) != 0 );
+}
+
+// Publish new frame into the bus
+XErrorCode VideoRepeaterSharedBus::Publish( const ximage* image )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( image == nullptr )
+    {
+        ret = ErrorNullParameter;
+    }
+    else if ( !mIsPublisher )
+    {
+        ret = ErrorFailed;
+    }
+    else if ( ( image->format == XPixelFormatJPEG ) || ( XImageIsPixelFormatPlanar( image->format ) ) ||
+              ( XImageIsPixelFormatIndexed( image->format ) ) )
+    {
+        ret = ErrorUnsupportedPixelFormat;
+    }
+    else if ( GetFrameSize( image ) > mHeader->SlotSize )
+    {
+        ret = ErrorImageIsTooBig;
+    }
+    else
+    {
+        // only one publisher writes into the bus, so no need for atomic increment
+        uint32_t       frameNumber = mHeader->FrameNumber.load( std::memory_order_relaxed ) + 1;
+        uint8_t*       slotPtr     = mBuffer + BUS_ALIGNMENT + SlotStride( mHeader->SlotSize ) * ( frameNumber % mHeader->SlotsCount );
+        SharedBusSlot* slot        = reinterpret_cast<SharedBusSlot*>( slotPtr );
+        uint8_t*       dstPtr      = slotPtr + BUS_ALIGNMENT;
+        uint32_t       lineSize    = XImageBytesPerLine( image->width * XImageBitsPerPixel( image->format ) );
+        uint32_t       sequence    = slot->Sequence.load( std::memory_order_relaxed );
+
+        // mark slot as being written, so consumers copying it now could detect that
+        slot->Sequence.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        slot->FrameNumber.store( frameNumber, std::memory_order_relaxed );
+        slot->Width.store( image->width, std::memory_order_relaxed );
+        slot->Height.store( image->height, std::memory_order_relaxed );
+        slot->Format.store( image->format, std::memory_order_relaxed );
+
+        for ( int32_t y = 0; y < image->height; y++ )
+        {
+            memcpy( dstPtr + y * lineSize, image->data + y * image->stride, lineSize );
+        }
+
+        slot->Sequence.store( sequence + 2, std::memory_order_release );
+        mHeader->FrameNumber.store( frameNumber, std::memory_order_release );
+
+        // don't make system call if nobody is waiting
+        uint32_t waitersCount = mHeader->WaitersCount.load( std::memory_order_seq_cst );
+
+        if ( waitersCount != 0 )
+        {
+            WakeWaiters( &mHeader->FrameNumber, mWakeHandle, waitersCount );
+        }
+    }
+
+    return ret;
+}
+
+// Wait the specified amount of time (milliseconds) till a frame newer than the specified one gets published
+bool VideoRepeaterSharedBus::WaitForFrame( uint32_t lastFrameNumber, uint32_t msec )
+{
+    if ( ( mHeader->FrameNumber.load( std::memory_order_acquire ) == lastFrameNumber ) && ( !IsClosed( ) ) )
+    {
+        mHeader->WaitersCount.fetch_add( 1, std::memory_order_seq_cst );
+
+        // check again, in case frame was published before publisher could see us waiting
+        if ( mHeader->FrameNumber.load( std::memory_order_seq_cst ) == lastFrameNumber )
+        {
+            WaitForChange( &mHeader->FrameNumber, lastFrameNumber, mWakeHandle, msec );
+        }
+
+        mHeader->WaitersCount.fetch_sub( 1, std::memory_order_seq_cst );
+    }
+
+    return ( mHeader->FrameNumber.load( std::memory_order_acquire ) != lastFrameNumber );
+}
+
+// Copy the latest frame, if it is newer than the specified one - updates frame number on success
+XErrorCode VideoRepeaterSharedBus::GetLatestFrame( uint32_t* lastFrameNumber, ximage** image )
+{
+    XErrorCode ret = SuccessCode;
+
+    if ( ( lastFrameNumber == nullptr ) || ( image == nullptr ) )
+    {
+        ret = ErrorNullParameter;
+    }
+    else
+    {
+        size_t slotStride = SlotStride( mHeader->SlotSize );
+        bool   done       = false;
+
+        // publisher never waits for consumers, so retry if the slot got overwritten while copying it
+        for ( uint32_t attempt = 0; ( !done ) && ( ret == SuccessCode ) && ( attempt < mHeader->SlotsCount * 2 ); attempt++ )
+        {
+            uint32_t frameNumber = mHeader->FrameNumber.load( std::memory_order_acquire );
+
+            if ( frameNumber == *lastFrameNumber )
+            {
+                break;
+            }
+
+            const uint8_t*       slotPtr  = mBuffer + BUS_ALIGNMENT + slotStride * ( frameNumber % mHeader->SlotsCount );
+            const SharedBusSlot* slot     = reinterpret_cast<const SharedBusSlot*>( slotPtr );
+            uint32_t             sequence = slot->Sequence.load( std::memory_order_acquire );
+
+            if ( ( ( sequence & 1 ) != 0 ) || ( slot->FrameNumber.load( std::memory_order_relaxed ) != frameNumber ) )
+            {
+                continue;
+            }
+
+            int32_t      width    = slot->Width.load( std::memory_order_relaxed );
+            int32_t      height   = slot->Height.load( std::memory_order_relaxed );
+            XPixelFormat format   = static_cast<XPixelFormat>( slot->Format.load( std::memory_order_relaxed ) );
+            uint32_t     lineSize = ( width > 0 ) ? XImageBytesPerLine( width * XImageBitsPerPixel( format ) ) : 0;
+
+            if ( ( height <= 0 ) || ( lineSize == 0 ) ||
+                 ( static_cast<uint64_t>( lineSize ) * height > mHeader->SlotSize ) )
+            {
+                continue;
+            }
+
+            ret = XImageAllocateRaw( width, height, format, image );
+
+            if ( ret == SuccessCode )
+            {
+                const uint8_t* srcPtr = slotPtr + BUS_ALIGNMENT;
+
+                for ( int32_t y = 0; y < height; y++ )
+                {
+                    memcpy( (*image)->data + y * (*image)->stride, srcPtr + y * lineSize, lineSize );
+                }
+
+                std::atomic_thread_fence( std::memory_order_acquire );
+
+                if ( slot->Sequence.load( std::memory_order_relaxed ) == sequence )
+                {
+                    *lastFrameNumber = frameNumber;
+                    done = true;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Map shared memory of the bus, creating it if requested
+bool VideoRepeaterSharedBus::Map( bool create, size_t size )
+{
+    void* ptr = nullptr;
+
+#ifdef WIN32
+    HANDLE mapHandle = NULL;
+
+    if ( create )
+    {
+        mapHandle = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                        static_cast<DWORD>( static_cast<uint64_t>( size ) >> 32 ),
+                                        static_cast<DWORD>( size ), mName.c_str( ) );
+
+        // existing mapping is still used by someone (file mappings are released by system once all
+        // processes close them), so the name can not be used for a new bus
+        if ( ( mapHandle != NULL ) && ( GetLastError( ) == ERROR_ALREADY_EXISTS ) )
+        {
+            CloseHandle( mapHandle );
+            mapHandle = NULL;
+        }
+
+        if ( mapHandle != NULL )
+        {
+            mWakeHandle = CreateSemaphoreA( NULL, 0, MAXLONG, ( mName + "_wake" ).c_str( ) );
+        }
+    }
+    else
+    {
+        mapHandle = OpenFileMappingA( FILE_MAP_ALL_ACCESS, FALSE, mName.c_str( ) );
+
+        if ( mapHandle != NULL )
+        {
+            mWakeHandle = OpenSemaphoreA( SYNCHRONIZE | SEMAPHORE_MODIFY_STATE, FALSE, ( mName + "_wake" ).c_str( ) );
+        }
+    }
+
+    if ( mapHandle != NULL )
+    {
+        ptr = MapViewOfFile( mapHandle, FILE_MAP_ALL_ACCESS, 0, 0, size );
+
+        if ( ptr == nullptr )
+        {
+            CloseHandle( mapHandle );
+
+            if ( mWakeHandle != nullptr )
+            {
+                CloseHandle( static_cast<HANDLE>( mWakeHandle ) );
+                mWakeHandle = nullptr;
+            }
+        }
+        else
+        {
+            if ( !create )
+            {
+                MEMORY_BASIC_INFORMATION info;
+
+                size = ( VirtualQuery( ptr, &info, sizeof( info ) ) != 0 ) ? info.RegionSize : 0;
+            }
+
+            mMapHandle = mapHandle;
+        }
+    }
+#else
+    int fd = shm_open( mName.c_str( ), ( create ) ? ( O_RDWR | O_CREAT | O_EXCL ) : O_RDWR, 0600 );
+
+    // shared memory objects stay in system until unlinked, so remove those left by crashed publishers
+    if ( ( fd == -1 ) && ( create ) && ( errno == EEXIST ) && ( IsBusAbandoned( mName ) ) )
+    {
+        shm_unlink( mName.c_str( ) );
+        fd = shm_open( mName.c_str( ), O_RDWR | O_CREAT | O_EXCL, 0600 );
+    }
+
+    if ( fd != -1 )
+    {
+        struct stat info;
+        bool        sizeIsOk = false;
+
+        if ( create )
+        {
+            sizeIsOk = ( ftruncate( fd, static_cast<off_t>( size ) ) == 0 );
+        }
+        else if ( fstat( fd, &info ) == 0 )
+        {
+            size     = static_cast<size_t>( info.st_size );
+            sizeIsOk = ( size >= BUS_ALIGNMENT );
+        }
+
+        if ( sizeIsOk )
+        {
+            ptr = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+            if ( ptr == MAP_FAILED )
+            {
+                ptr = nullptr;
+            }
+        }
+
+        // mapping stays valid after closing the descriptor
+        close( fd );
+
+        if ( ( ptr == nullptr ) && ( create ) )
+        {
+            shm_unlink( mName.c_str( ) );
+        }
+    }
+#endif
+
+    if ( ptr != nullptr )
+    {
+        mBuffer     = static_cast<uint8_t*>( ptr );
+        mBufferSize = size;
+    }
+
+    return ( ptr != nullptr );
+}
+
+// Unmap shared memory of the bus, removing it if it was created by this instance
+void VideoRepeaterSharedBus::Unmap( )
+{
+    if ( mBuffer != nullptr )
+    {
+#ifdef WIN32
+        UnmapViewOfFile( mBuffer );
+        CloseHandle( static_cast<HANDLE>( mMapHandle ) );
+        mMapHandle = nullptr;
+
+        if ( mWakeHandle != nullptr )
+        {
+            CloseHandle( static_cast<HANDLE>( mWakeHandle ) );
+            mWakeHandle = nullptr;
+        }
+#else
+        munmap( mBuffer, mBufferSize );
+
+        if ( mIsPublisher )
+        {
+            shm_unlink( mName.c_str( ) );
+        }
+#endif
+
+        mHeader     = nullptr;
+        mBuffer     = nullptr;
+        mBufferSize = 0;
+    }
+}
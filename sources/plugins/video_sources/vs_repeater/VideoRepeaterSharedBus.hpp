@@ -0,0 +1,82 @@
+/*
+    Video repeater plug-ins of Computer Vision Sandbox
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#pragma once
+#ifndef CVS_VIDEO_REPEATER_SHARED_BUS_HPP
+#define CVS_VIDEO_REPEATER_SHARED_BUS_HPP
+
+#include <string>
+#include <ximage.h>
+#include <XInterfaces.hpp>
+
+namespace Private
+{
+    struct SharedBusHeader;
+}
+
+// Ring buffer of video frames kept in shared memory, so frames published by one process
+// could be consumed by any number of other processes. Single publisher writes frames into
+// slots protected by sequence counters, while consumers never block it - they just copy
+// the latest frame and retry if it was overwritten in the middle of copying.
+class VideoRepeaterSharedBus : private CVSandbox::Uncopyable
+{
+private:
+    VideoRepeaterSharedBus( const std::string& name, bool isPublisher );
+
+public:
+    ~VideoRepeaterSharedBus( );
+
+    // Create new bus for publishing frames of the specified maximum size (in bytes)
+    static XErrorCode Create( const std::string& id, uint32_t maxFrameSize, VideoRepeaterSharedBus** bus );
+    // Open bus created by another process (or the same one)
+    static XErrorCode Open( const std::string& id, VideoRepeaterSharedBus** bus );
+
+    // Get size of image data, which can be published into the bus
+    static uint32_t GetFrameSize( const ximage* image );
+
+    // Get maximum size of a frame, which can be published into the bus
+    uint32_t MaxFrameSize( ) const;
+    // Check if publisher has closed the bus
+    bool IsClosed( ) const;
+
+    // Publish new frame into the bus
+    XErrorCode Publish( const ximage* image );
+    // Wait the specified amount of time (milliseconds) till a frame newer than the specified one gets published
+    bool WaitForFrame( uint32_t lastFrameNumber, uint32_t msec );
+    // Copy the latest frame, if it is newer than the specified one - updates frame number on success
+    XErrorCode GetLatestFrame( uint32_t* lastFrameNumber, ximage** image );
+
+private:
+    static bool OpenExisting( const std::string& name, VideoRepeaterSharedBus** bus );
+    bool Map( bool create, size_t size );
+    void Unmap( );
+
+private:
+    std::string                mName;
+    bool                       mIsPublisher;
+    Private::SharedBusHeader*  mHeader;
+    uint8_t*                   mBuffer;
+    size_t                     mBufferSize;
+    void*                      mMapHandle;
+    void*                      mWakeHandle;
+};
+
+#endif // CVS_VIDEO_REPEATER_SHARED_BUS_HPP
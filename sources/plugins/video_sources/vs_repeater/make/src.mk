@@ -7,7 +7,7 @@ VPATH = ../../
 SRC = vs_repeater.cpp \
 	VideoRepeaterPlugin.cpp VideoRepeaterPluginDescriptor.cpp \
 	VideoRepeaterPushPlugin.cpp VideoRepeaterPushPluginDescriptor.cpp \
-    VideoRepeaterRegistry.cpp
+    VideoRepeaterRegistry.cpp VideoRepeaterSharedBus.cpp
 
 # additional include folders
 INCLUDES = -I../../../../../afx/afx_types -I../../../../../afx/afx_types+ \
@@ -0,0 +1,606 @@
+/*
+    Plug-ins performance benchmark application
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <functional>
+
+#include <XError.hpp>
+#include <XPluginsEngine.hpp>
+#include <XImageProcessingFilterPlugin.hpp>
+#include <XImageProcessingFilterPlugin2.hpp>
+#include <XImageProcessingPlugin.hpp>
+#include <XDetectionPlugin.hpp>
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox;
+
+// Number of heap allocations done with this application's global operator new - host-side C++ allocations
+// only, since plug-in modules may use their own C++ runtime and C code calls malloc() directly
+static atomic<uint64_t> HostAllocationsCounter( 0 );
+
+void* operator new( size_t size )
+{
+    void* ptr = malloc( ( size == 0 ) ? 1 : size );
+
+    if ( ptr == nullptr )
+    {
+        throw bad_alloc( );
+    }
+
+    HostAllocationsCounter++;
+
+    return ptr;
+}
+
+void* operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept
+{
+    free( ptr );
+}
+
+// Benchmark settings provided from command line
+struct BenchmarkSettings
+{
+    string          PluginsFolder;
+    string          JsonFileName;
+    string          CsvFileName;
+    string          NameFilter;
+    uint32_t        WarmUpRuns;
+    uint32_t        TimedRuns;
+    vector<pair<int32_t, int32_t>> Sizes;
+
+    BenchmarkSettings( ) :
+        PluginsFolder( "./cvsplugins/" ), JsonFileName( "plugins_benchmark.json" ), CsvFileName( "plugins_benchmark.csv" ),
+        NameFilter( ), WarmUpRuns( 3 ), TimedRuns( 20 ), Sizes( )
+    {
+    }
+};
+
+// Result of benchmarking single plug-in with single pixel format/size
+struct BenchmarkResult
+{
+    string          PluginName;
+    string          PluginType;
+    string          PixelFormat;
+    int32_t         Width;
+    int32_t         Height;
+    XErrorCode      Status;
+    uint32_t        Runs;
+    double          Median;         // milliseconds
+    double          Percentile99;   // milliseconds
+    double          MegaPixelsPerSecond;
+    double          HostAllocationsPerRun;
+    uint32_t        Reallocations;  // number of timed runs which reallocated destination image
+};
+
+// Function doing single run of plug-in, which sets reallocation flag if destination image was reallocated
+typedef function<XErrorCode( bool& )> RunFunction;
+
+static bool ParseCommandLine( int argc, char* argv[], BenchmarkSettings& settings );
+static void PrintUsage( );
+static const shared_ptr<XImage> CreateTestImage( int32_t width, int32_t height, XPixelFormat format, uint32_t seed );
+static void BenchmarkPlugins( const shared_ptr<const XPluginsCollection>& plugins, PluginType pluginType,
+                              const BenchmarkSettings& settings, vector<BenchmarkResult>& results );
+static BenchmarkResult RunBenchmark( const RunFunction& run, const BenchmarkSettings& settings );
+static double PercentileOf( const vector<double>& sortedTimes, double percent );
+static bool WriteJsonReport( const string& fileName, const vector<BenchmarkResult>& results, const BenchmarkSettings& settings );
+static bool WriteCsvReport( const string& fileName, const vector<BenchmarkResult>& results );
+static string EscapeJsonString( const string& str );
+
+int main( int argc, char* argv[] )
+{
+    BenchmarkSettings       settings;
+    vector<BenchmarkResult> results;
+    int                     ret = 0;
+
+    if ( !ParseCommandLine( argc, argv, settings ) )
+    {
+        PrintUsage( );
+        ret = 1;
+    }
+    else
+    {
+        shared_ptr<XPluginsEngine> engine = XPluginsEngine::Create( );
+
+        engine->CollectModules( settings.PluginsFolder, PluginType_ImageProcessingFilter | PluginType_ImageProcessingFilter2 |
+                                                        PluginType_ImageProcessing | PluginType_Detection );
+
+        printf( "Benchmarking plug-ins: warm-up runs = %u, timed runs = %u \n", settings.WarmUpRuns, settings.TimedRuns );
+
+        printf( "> Image processing filter plug-ins \n" );
+        BenchmarkPlugins( engine->GetPluginsOfType( PluginType_ImageProcessingFilter ), PluginType_ImageProcessingFilter, settings, results );
+
+        printf( "> Two source image processing filter plug-ins \n" );
+        BenchmarkPlugins( engine->GetPluginsOfType( PluginType_ImageProcessingFilter2 ), PluginType_ImageProcessingFilter2, settings, results );
+
+        printf( "> Image processing plug-ins \n" );
+        BenchmarkPlugins( engine->GetPluginsOfType( PluginType_ImageProcessing ), PluginType_ImageProcessing, settings, results );
+
+        printf( "> Detection plug-ins \n" );
+        BenchmarkPlugins( engine->GetPluginsOfType( PluginType_Detection ), PluginType_Detection, settings, results );
+
+        if ( ( !settings.JsonFileName.empty( ) ) && ( !WriteJsonReport( settings.JsonFileName, results, settings ) ) )
+        {
+            printf( "Failed writing JSON report: %s \n", settings.JsonFileName.c_str( ) );
+            ret = 2;
+        }
+
+        if ( ( !settings.CsvFileName.empty( ) ) && ( !WriteCsvReport( settings.CsvFileName, results ) ) )
+        {
+            printf( "Failed writing CSV report: %s \n", settings.CsvFileName.c_str( ) );
+            ret = 2;
+        }
+
+        printf( "Done. Benchmarked %u plug-in/format/size combinations \n", static_cast<uint32_t>( results.size( ) ) );
+    }
+
+    return ret;
+}
+
+// Parse command line arguments
+bool ParseCommandLine( int argc, char* argv[], BenchmarkSettings& settings )
+{
+    bool ret = true;
+
+    for ( int i = 1; ( i < argc ) && ( ret ); i++ )
+    {
+        string arg   = argv[i];
+        bool   noVal = ( i + 1 >= argc );
+
+        if ( ( arg == "-p" ) && ( !noVal ) )
+        {
+            settings.PluginsFolder = argv[++i];
+        }
+        else if ( ( arg == "-json" ) && ( !noVal ) )
+        {
+            settings.JsonFileName = argv[++i];
+        }
+        else if ( ( arg == "-csv" ) && ( !noVal ) )
+        {
+            settings.CsvFileName = argv[++i];
+        }
+        else if ( ( arg == "-f" ) && ( !noVal ) )
+        {
+            settings.NameFilter = argv[++i];
+        }
+        else if ( ( arg == "-w" ) && ( !noVal ) )
+        {
+            settings.WarmUpRuns = static_cast<uint32_t>( atoi( argv[++i] ) );
+        }
+        else if ( ( arg == "-r" ) && ( !noVal ) )
+        {
+            int runs = atoi( argv[++i] );
+
+            ret = ( runs > 0 );
+            settings.TimedRuns = static_cast<uint32_t>( runs );
+        }
+        else if ( ( arg == "-s" ) && ( !noVal ) )
+        {
+            int width = 0, height = 0;
+
+            ret = ( sscanf( argv[++i], "%dx%d", &width, &height ) == 2 ) && ( width > 0 ) && ( height > 0 );
+            settings.Sizes.push_back( make_pair( width, height ) );
+        }
+        else
+        {
+            ret = false;
+        }
+    }
+
+    if ( settings.Sizes.empty( ) )
+    {
+        settings.Sizes.push_back( make_pair(  640,  480 ) );
+        settings.Sizes.push_back( make_pair( 1280,  720 ) );
+        settings.Sizes.push_back( make_pair( 1920, 1080 ) );
+        settings.Sizes.push_back( make_pair( 3840, 2160 ) );
+    }
+
+    return ret;
+}
+
+// Show application's usage
+void PrintUsage( )
+{
+    printf( "Usage: plugins_benchmark [options] \n" );
+    printf( "  -p <folder>     folder to load plug-ins from (default ./cvsplugins/) \n" );
+    printf( "  -json <file>    JSON report file name, empty string to skip (default plugins_benchmark.json) \n" );
+    printf( "  -csv <file>     CSV report file name, empty string to skip (default plugins_benchmark.csv) \n" );
+    printf( "  -f <text>       benchmark only plug-ins containing the text in their name \n" );
+    printf( "  -w <count>      number of warm-up runs (default 3) \n" );
+    printf( "  -r <count>      number of timed runs (default 20) \n" );
+    printf( "  -s <WxH>        image size to test, can be repeated (default 640x480, 1280x720, 1920x1080, 3840x2160) \n" );
+}
+
+// Create test image filled with pseudo random noise, so plug-ins don't take any shortcuts on uniform data
+const shared_ptr<XImage> CreateTestImage( int32_t width, int32_t height, XPixelFormat format, uint32_t seed )
+{
+    shared_ptr<XImage> image = XImage::AllocateRaw( width, height, format );
+
+    if ( image )
+    {
+        ximage*  data   = image->ImageData( );
+        uint32_t random = seed;
+
+        for ( int32_t y = 0; y < data->height; y++ )
+        {
+            uint8_t* row = data->data + y * data->stride;
+
+            for ( int32_t x = 0; x < data->stride; x++ )
+            {
+                random = random * 1664525 + 1013904223;
+                row[x] = static_cast<uint8_t>( random >> 24 );
+            }
+        }
+
+        // keep floating point images within [0, 255] range
+        if ( format == XPixelFormatGrayscaleR4 )
+        {
+            for ( int32_t y = 0; y < data->height; y++ )
+            {
+                float* row = reinterpret_cast<float*>( data->data + y * data->stride );
+
+                for ( int32_t x = 0; x < data->width; x++ )
+                {
+                    random = random * 1664525 + 1013904223;
+                    row[x] = static_cast<float>( random >> 24 );
+                }
+            }
+        }
+    }
+
+    return image;
+}
+
+// Benchmark all plug-ins from the collection with all supported pixel formats and configured image sizes
+void BenchmarkPlugins( const shared_ptr<const XPluginsCollection>& plugins, PluginType pluginType,
+                       const BenchmarkSettings& settings, vector<BenchmarkResult>& results )
+{
+    const char* typeName = ( pluginType == PluginType_ImageProcessingFilter  ) ? "ImageProcessingFilter"  :
+                           ( pluginType == PluginType_ImageProcessingFilter2 ) ? "ImageProcessingFilter2" :
+                           ( pluginType == PluginType_ImageProcessing        ) ? "ImageProcessing" : "Detection";
+
+    for ( auto it = plugins->begin( ); it != plugins->end( ); ++it )
+    {
+        const shared_ptr<const XPluginDescriptor>& pluginDesc = *it;
+        const string pluginName = pluginDesc->Name( );
+
+        if ( ( !settings.NameFilter.empty( ) ) && ( pluginName.find( settings.NameFilter ) == string::npos ) )
+        {
+            continue;
+        }
+
+        shared_ptr<XPlugin> plugin = pluginDesc->CreateInstance( );
+
+        if ( !plugin )
+        {
+            printf( "Failed creating plug-in's instance: %s \n", pluginName.c_str( ) );
+            continue;
+        }
+
+        vector<XPixelFormat> formats;
+
+        if ( pluginType == PluginType_ImageProcessingFilter )
+        {
+            formats = static_pointer_cast<XImageProcessingFilterPlugin>( plugin )->GetSupportedPixelFormats( );
+        }
+        else if ( pluginType == PluginType_ImageProcessingFilter2 )
+        {
+            formats = static_pointer_cast<XImageProcessingFilterPlugin2>( plugin )->GetSupportedPixelFormats( );
+        }
+        else if ( pluginType == PluginType_ImageProcessing )
+        {
+            formats = static_pointer_cast<XImageProcessingPlugin>( plugin )->GetSupportedPixelFormats( );
+        }
+        else
+        {
+            formats = static_pointer_cast<XDetectionPlugin>( plugin )->GetSupportedPixelFormats( );
+        }
+
+        printf( "  %s \n", pluginName.c_str( ) );
+
+        for ( auto format : formats )
+        {
+            for ( auto size : settings.Sizes )
+            {
+                shared_ptr<XImage> src = CreateTestImage( size.first, size.second, format, 1 );
+                shared_ptr<XImage> src2;
+                shared_ptr<XImage> dst;
+                RunFunction        run;
+
+                if ( !src )
+                {
+                    continue;
+                }
+
+                if ( pluginType == PluginType_ImageProcessingFilter )
+                {
+                    shared_ptr<XImageProcessingFilterPlugin> filter = static_pointer_cast<XImageProcessingFilterPlugin>( plugin );
+
+                    run = [filter, src, &dst] ( bool& reallocated ) -> XErrorCode
+                    {
+                        const ximage* before = ( dst ) ? dst->ImageData( ) : nullptr;
+                        XErrorCode    status = filter->ProcessImage( src, dst );
+
+                        reallocated = ( !dst ) || ( dst->ImageData( ) != before );
+                        return status;
+                    };
+                }
+                else if ( pluginType == PluginType_ImageProcessingFilter2 )
+                {
+                    shared_ptr<XImageProcessingFilterPlugin2> filter = static_pointer_cast<XImageProcessingFilterPlugin2>( plugin );
+
+                    src2 = CreateTestImage( size.first, size.second, filter->GetSecondImageSupportedFormat( format ), 2 );
+
+                    if ( !src2 )
+                    {
+                        continue;
+                    }
+
+                    run = [filter, src, src2, &dst] ( bool& reallocated ) -> XErrorCode
+                    {
+                        const ximage* before = ( dst ) ? dst->ImageData( ) : nullptr;
+                        XErrorCode    status = filter->ProcessImage( src, src2, dst );
+
+                        reallocated = ( !dst ) || ( dst->ImageData( ) != before );
+                        return status;
+                    };
+                }
+                else if ( pluginType == PluginType_ImageProcessing )
+                {
+                    shared_ptr<XImageProcessingPlugin> processing = static_pointer_cast<XImageProcessingPlugin>( plugin );
+
+                    run = [processing, src] ( bool& reallocated ) -> XErrorCode
+                    {
+                        reallocated = false;
+                        return processing->ProcessImage( src );
+                    };
+                }
+                else
+                {
+                    shared_ptr<XDetectionPlugin> detection = static_pointer_cast<XDetectionPlugin>( plugin );
+
+                    detection->Reset( );
+
+                    run = [detection, src] ( bool& reallocated ) -> XErrorCode
+                    {
+                        reallocated = false;
+                        return detection->ProcessImage( src );
+                    };
+                }
+
+                BenchmarkResult result = RunBenchmark( run, settings );
+
+                result.PluginName  = pluginName;
+                result.PluginType  = typeName;
+                result.PixelFormat = XImage::PixelFormatName( format );
+                result.Width       = size.first;
+                result.Height      = size.second;
+
+                if ( result.Status == SuccessCode )
+                {
+                    result.MegaPixelsPerSecond = ( result.Median > 0 ) ?
+                        static_cast<double>( size.first ) * size.second / ( result.Median * 1000.0 ) : 0;
+
+                    printf( "    %-12s %4dx%-4d  median: %9.3f ms  p99: %9.3f ms  %9.2f MPix/s  host C++ allocs/run: %.1f \n",
+                            result.PixelFormat.c_str( ), size.first, size.second,
+                            result.Median, result.Percentile99, result.MegaPixelsPerSecond, result.HostAllocationsPerRun );
+                }
+                else
+                {
+                    printf( "    %-12s %4dx%-4d  failed: %d (%s) \n", result.PixelFormat.c_str( ), size.first, size.second,
+                            result.Status, XError::Description( result.Status ).c_str( ) );
+                }
+
+                results.push_back( result );
+            }
+        }
+    }
+}
+
+// Do warm-up and timed runs of the specified function
+BenchmarkResult RunBenchmark( const RunFunction& run, const BenchmarkSettings& settings )
+{
+    BenchmarkResult result;
+    vector<double>  times;
+    XErrorCode      status      = SuccessCode;
+    bool            reallocated = false;
+    uint64_t        hostAllocs  = 0;
+
+    result.Status                = SuccessCode;
+    result.Runs                  = 0;
+    result.Median                = 0;
+    result.Percentile99          = 0;
+    result.MegaPixelsPerSecond   = 0;
+    result.HostAllocationsPerRun = 0;
+    result.Reallocations         = 0;
+
+    // first run(s) allocate destination image and let plug-in to initialize its internals
+    for ( uint32_t i = 0; ( i < settings.WarmUpRuns + 1 ) && ( status == SuccessCode ); i++ )
+    {
+        status = run( reallocated );
+    }
+
+    times.reserve( settings.TimedRuns );
+
+    for ( uint32_t i = 0; ( i < settings.TimedRuns ) && ( status == SuccessCode ); i++ )
+    {
+        uint64_t                 allocsBefore = HostAllocationsCounter;
+        steady_clock::time_point start        = steady_clock::now( );
+
+        status = run( reallocated );
+
+        steady_clock::time_point end = steady_clock::now( );
+
+        hostAllocs += HostAllocationsCounter - allocsBefore;
+
+        times.push_back( duration_cast<nanoseconds>( end - start ).count( ) / 1000000.0 );
+
+        if ( reallocated )
+        {
+            result.Reallocations++;
+        }
+    }
+
+    result.Status = status;
+
+    if ( ( status == SuccessCode ) && ( !times.empty( ) ) )
+    {
+        sort( times.begin( ), times.end( ) );
+
+        result.Runs                  = static_cast<uint32_t>( times.size( ) );
+        result.Median                = PercentileOf( times, 50.0 );
+        result.Percentile99          = PercentileOf( times, 99.0 );
+        result.HostAllocationsPerRun = static_cast<double>( hostAllocs ) / times.size( );
+    }
+
+    return result;
+}
+
+// Get percentile of the sorted values using linear interpolation between closest ranks
+double PercentileOf( const vector<double>& sortedTimes, double percent )
+{
+    double ret = 0;
+
+    if ( !sortedTimes.empty( ) )
+    {
+        double rank  = percent / 100.0 * ( sortedTimes.size( ) - 1 );
+        size_t lower = static_cast<size_t>( rank );
+        size_t upper = XMIN( lower + 1, sortedTimes.size( ) - 1 );
+
+        ret = sortedTimes[lower] + ( sortedTimes[upper] - sortedTimes[lower] ) * ( rank - lower );
+    }
+
+    return ret;
+}
+
+// Write benchmark results as JSON document
+bool WriteJsonReport( const string& fileName, const vector<BenchmarkResult>& results, const BenchmarkSettings& settings )
+{
+    FILE* file = fopen( fileName.c_str( ), "w" );
+    bool  ret  = ( file != nullptr );
+
+    if ( ret )
+    {
+        fprintf( file, "{\n" );
+        fprintf( file, "  \"warmUpRuns\": %u,\n", settings.WarmUpRuns );
+        fprintf( file, "  \"timedRuns\": %u,\n", settings.TimedRuns );
+        fprintf( file, "  \"results\": [" );
+
+        for ( size_t i = 0; i < results.size( ); i++ )
+        {
+            const BenchmarkResult& r = results[i];
+
+            fprintf( file, "%s\n    { \"plugin\": \"%s\", \"type\": \"%s\", \"format\": \"%s\", \"width\": %d, \"height\": %d, "
+                           "\"status\": %d, \"runs\": %u, \"medianMs\": %.4f, \"p99Ms\": %.4f, \"mpixPerSec\": %.3f, "
+                           "\"hostCppAllocsPerRun\": %.2f, \"reallocations\": %u }",
+                     ( i == 0 ) ? "" : ",",
+                     EscapeJsonString( r.PluginName ).c_str( ), r.PluginType.c_str( ), EscapeJsonString( r.PixelFormat ).c_str( ),
+                     r.Width, r.Height, r.Status, r.Runs, r.Median, r.Percentile99, r.MegaPixelsPerSecond,
+                     r.HostAllocationsPerRun, r.Reallocations );
+        }
+
+        fprintf( file, "\n  ]\n}\n" );
+        ret = ( ferror( file ) == 0 );
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Write benchmark results as CSV table
+bool WriteCsvReport( const string& fileName, const vector<BenchmarkResult>& results )
+{
+    FILE* file = fopen( fileName.c_str( ), "w" );
+    bool  ret  = ( file != nullptr );
+
+    if ( ret )
+    {
+        fprintf( file, "plugin,type,format,width,height,status,runs,median_ms,p99_ms,mpix_per_sec,host_cpp_allocs_per_run,reallocations\n" );
+
+        for ( auto& r : results )
+        {
+            string name = r.PluginName;
+
+            // quotes are doubled inside quoted CSV field
+            for ( size_t pos = name.find( '"' ); pos != string::npos; pos = name.find( '"', pos + 2 ) )
+            {
+                name.insert( pos, 1, '"' );
+            }
+
+            fprintf( file, "\"%s\",%s,%s,%d,%d,%d,%u,%.4f,%.4f,%.3f,%.2f,%u\n",
+                     name.c_str( ), r.PluginType.c_str( ), r.PixelFormat.c_str( ), r.Width, r.Height,
+                     r.Status, r.Runs, r.Median, r.Percentile99, r.MegaPixelsPerSecond, r.HostAllocationsPerRun, r.Reallocations );
+        }
+
+        ret = ( ferror( file ) == 0 );
+        fclose( file );
+    }
+
+    return ret;
+}
+
+// Escape special characters for JSON string
+string EscapeJsonString( const string& str )
+{
+    string ret;
+
+    for ( char c : str )
+    {
+        if ( ( c == '"' ) || ( c == '\\' ) )
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if ( static_cast<unsigned char>( c ) < 0x20 )
+        {
+            char buffer[8];
+
+            sprintf( buffer, "\\u%04x", static_cast<unsigned int>( c ) );
+            ret += buffer;
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+
+    return ret;
+}
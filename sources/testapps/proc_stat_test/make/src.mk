@@ -0,0 +1,10 @@
+# proc_stat_test test application's source files
+
+# search path for source files
+VPATH = ../../
+
+# source files
+SRC = proc_stat_test.cpp ../../plugins/devices/dev_sysinfo/ProcStatParser.cpp
+
+# additional include folders
+INCLUDES = -I../../../../plugins/devices/dev_sysinfo
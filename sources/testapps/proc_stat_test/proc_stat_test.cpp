@@ -0,0 +1,99 @@
+/*
+    Test application for parser of stat files from /proc file system
+
+    Copyright (C) 2011-2019, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <string>
+
+#include "ProcStatParser.hpp"
+
+using namespace std;
+
+// Number of failed checks
+static int FailedChecks = 0;
+
+static void TestStatLine( );
+static void TestNameWithBrackets( );
+static void TestMalformedLine( );
+
+int main( int /* argc */, char** /* argv */ )
+{
+    printf( "Testing parser of /proc/*/stat files ... \n" );
+
+    TestStatLine( );
+    TestNameWithBrackets( );
+    TestMalformedLine( );
+
+    printf( "\n%s\n", ( FailedChecks == 0 ) ? "done" : "FAILED" );
+
+    return ( FailedChecks == 0 ) ? 0 : 1;
+}
+
+// Report result of a check
+static void Check( bool passed, const char* what )
+{
+    printf( "  %s - %s \n", ( passed ) ? "passed" : "FAILED", what );
+
+    if ( !passed )
+    {
+        FailedChecks++;
+    }
+}
+
+// Check ticks are sum of user (14th field) and system (15th field) times
+static void TestStatLine( )
+{
+    // fields 10-17: minflt=5000, cminflt=0, majflt=12, cmajflt=3, utime=250, stime=75, cutime=7, cstime=9
+    const char* stat  = "1234 (cvsandbox) S 1 1234 1234 0 -1 4194560 5000 0 12 3 250 75 7 9 20 0 4 0 100 1000 200\n";
+    uint64_t    ticks = 0;
+    string      name;
+
+    printf( "\n--- Test 1 ---\n" );
+
+    Check( ParseProcStatTicks( stat, &ticks, &name ), "line is parsed" );
+    Check( ticks == 325, "ticks are utime + stime" );
+    Check( name == "cvsandbox", "name is provided" );
+}
+
+// Check fields are counted from the last bracket, since task's name can have spaces and brackets
+static void TestNameWithBrackets( )
+{
+    const char* stat  = "42 (cvs (worker) 1) R 1 42 42 0 -1 4194368 10 0 0 0 1000 500 0 0 20 0 1 0 5 6 7\n";
+    uint64_t    ticks = 0;
+    string      name;
+
+    printf( "\n--- Test 2 ---\n" );
+
+    Check( ParseProcStatTicks( stat, &ticks, &name ), "line is parsed" );
+    Check( ticks == 1500, "ticks are utime + stime" );
+    Check( name == "cvs (worker) 1", "name is provided" );
+}
+
+// Check truncated or invalid content is not accepted
+static void TestMalformedLine( )
+{
+    uint64_t ticks = 0;
+
+    printf( "\n--- Test 3 ---\n" );
+
+    Check( !ParseProcStatTicks( "1234 (cvsandbox) S 1 1234 1234 0 -1", &ticks ), "truncated line is rejected" );
+    Check( !ParseProcStatTicks( "1234 cvsandbox S 1 1234 1234 0 -1 4194560 5000 0 12 3 250 75", &ticks ), "line without name is rejected" );
+    Check( !ParseProcStatTicks( "", &ticks ), "empty line is rejected" );
+}
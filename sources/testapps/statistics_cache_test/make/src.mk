@@ -0,0 +1,20 @@
+# statistics_cache_test test application's source files
+
+# search path for source files
+VPATH = ../../
+
+# source files
+SRC = statistics_cache_test.cpp
+
+# source files of the module with test plug-ins
+PLUGINS_SRC = statistics_cache_test_plugins.cpp
+
+# additional include folders
+INCLUDES = -I../../../../afx/afx_types -I../../../../afx/afx_types+ \
+    -I../../../../afx/afx_platform+ \
+    -I../../../../core/iplugin -I../../../../core/pluginmgr \
+    -I../../../../core/automationserver
+
+# libraries to use
+LIBS = -lautomationserver -lpluginmgr -liplugin -lafx_platform+ -lafx_imaging -lafx_types+ -lafx_types
+PLUGINS_LIBS = -liplugin -lafx_types
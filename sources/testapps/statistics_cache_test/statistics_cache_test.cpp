@@ -0,0 +1,137 @@
+/*
+    Test of histograms shared between video processing steps
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <atomic>
+#include <string>
+
+#include <XThread.hpp>
+#include <XAutomationServer.hpp>
+#include <XPluginsEngine.hpp>
+#include <XVideoSourceProcessingGraph.hpp>
+
+using namespace std;
+using namespace CVSandbox;
+using namespace CVSandbox::Automation;
+using namespace CVSandbox::Threading;
+
+// Number of processed frames to check and the time given to process them
+#define FRAMES_TO_CHECK 50
+#define MAX_WAIT_MS     10000
+
+// Listener counting processed frames and reported errors
+class VideoSourceListener : public IAutomationVideoSourceListener
+{
+public:
+    VideoSourceListener( ) :
+        FramesCount( 0 ), ErrorsCount( 0 )
+    {
+    }
+
+    virtual void OnNewVideoFrame( uint32_t, const shared_ptr<const XImage>& )
+    {
+        FramesCount++;
+    }
+
+    virtual void OnErrorMessage( uint32_t, const string& errorMessage )
+    {
+        if ( ErrorsCount++ == 0 )
+        {
+            printf( "Error: %s \n", errorMessage.c_str( ) );
+        }
+    }
+
+public:
+    atomic<int> FramesCount;
+    atomic<int> ErrorsCount;
+};
+
+int main( int argc, char* argv[] )
+{
+    // folder with the test plug-ins' module
+    string pluginsFolder = ( argc > 1 ) ? argv[1] : "./cvsplugins/";
+    bool   testPassed    = false;
+
+    printf( "Starting the test \n" );
+
+    {
+        shared_ptr<XPluginsEngine>    engine = XPluginsEngine::Create( );
+        shared_ptr<XAutomationServer> server = XAutomationServer::Create( engine );
+        VideoSourceListener           listener;
+
+        engine->CollectModules( pluginsFolder );
+
+        XGuid sourceId( 0xAF00F003, 0x00000000, 0x00000001, 0x00000001 );
+        XGuid highlightId( 0xAF00F003, 0x00000000, 0x00000001, 0x00000002 );
+        XGuid checkId( 0xAF00F003, 0x00000000, 0x00000001, 0x00000003 );
+
+        shared_ptr<const XPluginDescriptor> sourceDesc = engine->GetPlugin( sourceId );
+
+        if ( ( !sourceDesc ) || ( !engine->GetPlugin( highlightId ) ) || ( !engine->GetPlugin( checkId ) ) )
+        {
+            printf( "Failed loading test plug-ins from: %s \n", pluginsFolder.c_str( ) );
+        }
+        else
+        {
+            // histograms are checked before and after the image is changed by the detection step
+            XVideoSourceProcessingGraph graph;
+
+            graph.AddStep( XVideoSourceProcessingStep( "Check 1", checkId ) );
+            graph.AddStep( XVideoSourceProcessingStep( "Highlight", highlightId ) );
+            graph.AddStep( XVideoSourceProcessingStep( "Check 2", checkId ) );
+
+            server->Start( );
+
+            uint32_t videoId = server->AddVideoSource( sourceDesc,
+                static_pointer_cast<XVideoSourcePlugin>( sourceDesc->CreateInstance( ) ) );
+
+            server->SetVideoProcessingGraph( videoId, graph );
+            server->AddVideoSourceListener( videoId, &listener );
+
+            if ( !server->StartVideoSource( videoId ) )
+            {
+                printf( "Failed starting video source \n" );
+            }
+            else
+            {
+                for ( int waited = 0; ( waited < MAX_WAIT_MS ) && ( listener.FramesCount < FRAMES_TO_CHECK ) &&
+                                      ( listener.ErrorsCount == 0 ); waited += 10 )
+                {
+                    XThread::Sleep( 10 );
+                }
+
+                testPassed = ( listener.FramesCount >= FRAMES_TO_CHECK ) && ( listener.ErrorsCount == 0 );
+
+                printf( "Frames processed: %d, errors: %d \n", static_cast<int>( listener.FramesCount ),
+                                                               static_cast<int>( listener.ErrorsCount ) );
+            }
+
+            server->RemoveVideoSourceListener( videoId, &listener );
+            server->FinalizeVideoSource( videoId );
+            server->SignalToStop( );
+            server->WaitForStop( );
+        }
+    }
+
+    printf( "%s \n", ( testPassed ) ? "Test Passed" : "Test FAILED" );
+
+    return ( testPassed ) ? 0 : 1;
+}
@@ -0,0 +1,368 @@
+/*
+    Plug-ins used by the test of histograms shared between video processing steps
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <iplugincpp.hpp>
+#include "imodule.h"
+
+// Size of frames provided by the test video source
+#define FRAME_WIDTH  64
+#define FRAME_HEIGHT 48
+
+// Pixel formats supported by the test plug-ins
+static const XPixelFormat supportedPixelFormats[] = { XPixelFormatGrayscale8 };
+
+// Video source providing grayscale frames of uniform intensity, which changes from frame to frame
+class GrayFramesSourcePlugin : public IVideoSourcePlugin
+{
+public:
+    GrayFramesSourcePlugin( ) :
+        mCallbacks( ), mUserParam( nullptr ), mFramesCount( 0 ), mNeedToStop( false )
+    {
+    }
+
+    void Dispose( )
+    {
+        SignalToStop( );
+        WaitForStop( );
+        delete this;
+    }
+
+    XErrorCode GetProperty( int32_t id, xvariant* value ) const
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    XErrorCode SetProperty( int32_t id, const xvariant* value )
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    XErrorCode Start( )
+    {
+        XErrorCode ret = SuccessCode;
+
+        if ( !IsRunning( ) )
+        {
+            mNeedToStop  = false;
+            mFramesCount = 0;
+            mThread      = std::thread( &GrayFramesSourcePlugin::WorkerThread, this );
+        }
+
+        return ret;
+    }
+
+    void SignalToStop( )
+    {
+        mNeedToStop = true;
+    }
+
+    void WaitForStop( )
+    {
+        if ( mThread.joinable( ) )
+        {
+            mThread.join( );
+        }
+    }
+
+    bool IsRunning( )
+    {
+        return mThread.joinable( );
+    }
+
+    void Terminate( )
+    {
+        SignalToStop( );
+        WaitForStop( );
+    }
+
+    uint32_t FramesReceived( )
+    {
+        return mFramesCount;
+    }
+
+    void SetCallbacks( const VideoSourcePluginCallbacks* callbacks, void* userParam )
+    {
+        if ( callbacks != nullptr )
+        {
+            mCallbacks = *callbacks;
+        }
+        else
+        {
+            mCallbacks.NewImageCallback     = nullptr;
+            mCallbacks.ErrorMessageCallback = nullptr;
+        }
+
+        mUserParam = userParam;
+    }
+
+private:
+    void WorkerThread( )
+    {
+        ximage* image = nullptr;
+
+        if ( XImageAllocate( FRAME_WIDTH, FRAME_HEIGHT, XPixelFormatGrayscale8, &image ) == SuccessCode )
+        {
+            while ( !mNeedToStop )
+            {
+                memset( image->data, 16 + mFramesCount % 128, image->stride * image->height );
+                mFramesCount++;
+
+                if ( mCallbacks.NewImageCallback != nullptr )
+                {
+                    mCallbacks.NewImageCallback( mUserParam, image );
+                }
+
+                std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+            }
+
+            XImageFree( &image );
+        }
+    }
+
+private:
+    VideoSourcePluginCallbacks  mCallbacks;
+    void*                       mUserParam;
+    std::atomic<uint32_t>       mFramesCount;
+    std::atomic<bool>           mNeedToStop;
+    std::thread                 mThread;
+};
+
+// Detection plug-in, which always detects something and highlights it by filling top half of the image
+class HighlightingDetectionPlugin : public IDetectionPlugin
+{
+public:
+    void Dispose( )
+    {
+        delete this;
+    }
+
+    XErrorCode GetProperty( int32_t id, xvariant* value ) const
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    XErrorCode SetProperty( int32_t id, const xvariant* value )
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    bool IsReadOnlyMode( )
+    {
+        return false;
+    }
+
+    XErrorCode GetSupportedPixelFormats( XPixelFormat* pixelFormats, int32_t* count )
+    {
+        return GetSupportedPixelFormatsImpl( supportedPixelFormats, XARRAY_SIZE( supportedPixelFormats ), pixelFormats, count );
+    }
+
+    XErrorCode ProcessImage( ximage* src )
+    {
+        for ( int32_t y = 0; y < src->height / 2; y++ )
+        {
+            memset( src->data + y * src->stride, 255, src->width );
+        }
+
+        return SuccessCode;
+    }
+
+    bool Detected( )
+    {
+        return true;
+    }
+
+    void Reset( )
+    {
+    }
+};
+
+// Image processing plug-in, which fails if histograms it is given don't match the image
+class HistogramCheckPlugin : public IImageProcessingPlugin
+{
+public:
+    void Dispose( )
+    {
+        delete this;
+    }
+
+    XErrorCode GetProperty( int32_t id, xvariant* value ) const
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    XErrorCode SetProperty( int32_t id, const xvariant* value )
+    {
+        XUNREFERENCED_PARAMETER( id )
+        XUNREFERENCED_PARAMETER( value )
+        return ErrorInvalidProperty;
+    }
+
+    XErrorCode GetSupportedPixelFormats( XPixelFormat* pixelFormats, int32_t* count )
+    {
+        return GetSupportedPixelFormatsImpl( supportedPixelFormats, XARRAY_SIZE( supportedPixelFormats ), pixelFormats, count );
+    }
+
+    // The test is about histograms provided by the host, so not getting them is a failure as well
+    XErrorCode ProcessImage( const ximage* image )
+    {
+        XUNREFERENCED_PARAMETER( image )
+        return ErrorFailed;
+    }
+
+    XErrorCode ProcessImageWithHistograms( const ximage* image, const xhistogram* redHistogram,
+                                           const xhistogram* greenHistogram, const xhistogram* blueHistogram )
+    {
+        XErrorCode ret = SuccessCode;
+        uint32_t   values[256] = { 0 };
+
+        XUNREFERENCED_PARAMETER( greenHistogram )
+        XUNREFERENCED_PARAMETER( blueHistogram )
+
+        for ( int32_t y = 0; y < image->height; y++ )
+        {
+            const uint8_t* row = image->data + y * image->stride;
+
+            for ( int32_t x = 0; x < image->width; x++ )
+            {
+                values[row[x]]++;
+            }
+        }
+
+        if ( ( redHistogram == nullptr ) || ( redHistogram->length != 256 ) ||
+             ( memcmp( values, redHistogram->values, sizeof( values ) ) != 0 ) )
+        {
+            ret = ErrorFailed;
+        }
+
+        return ret;
+    }
+};
+
+// Version of the plug-ins
+static xversion PluginVersion = { 1, 0, 0 };
+
+// IDs of the plug-ins
+static xguid GrayFramesSourceID    = { 0xAF00F003, 0x00000000, 0x00000001, 0x00000001 };
+static xguid HighlightDetectionID  = { 0xAF00F003, 0x00000000, 0x00000001, 0x00000002 };
+static xguid HistogramCheckID      = { 0xAF00F003, 0x00000000, 0x00000001, 0x00000003 };
+
+// Register the plug-ins
+REGISTER_CPP_PLUGIN
+(
+    GrayFramesSourceID,
+    PluginFamilyID_VideoSource,
+    PluginType_VideoSource,
+    PluginVersion,
+    "Gray Frames",
+    "GrayFrames",
+    "Provides frames of uniform intensity.",
+    "",
+    0,
+    0,
+    GrayFramesSourcePlugin
+);
+
+REGISTER_CPP_PLUGIN
+(
+    HighlightDetectionID,
+    PluginFamilyID_Detection,
+    PluginType_Detection,
+    PluginVersion,
+    "Highlight Detection",
+    "HighlightDetection",
+    "Detects in every frame and highlights top half of it.",
+    "",
+    0,
+    0,
+    HighlightingDetectionPlugin
+);
+
+REGISTER_CPP_PLUGIN
+(
+    HistogramCheckID,
+    PluginFamilyID_Default,
+    PluginType_ImageProcessing,
+    PluginVersion,
+    "Histogram Check",
+    "HistogramCheck",
+    "Checks the provided histograms match the image.",
+    "",
+    0,
+    0,
+    HistogramCheckPlugin
+);
+
+// Descriptor of the module
+ModuleDescriptor moduleInfo =
+{
+    { 0xAF00F001, 0x00000000, 0x00000000, 0x00000001 },
+    { 1, 0, 0 },
+    "Statistics Cache Test",
+    "statistics_cache_test",
+    "The module contains plug-ins used by the statistics cache test.",
+    "Computer Vision Sandbox",
+    "Copyright Computer Vision Sandbox, 2011-2018",
+    "http://www.cvsandbox.com/",
+    0, // small icon
+    0, // icon
+    0
+};
+
+// Module's exported API
+extern "C"
+{
+
+// Initialize module and provide its descriptor
+MODULE_PUBLIC ModuleDescriptor* ModuleInitialize( )
+{
+    moduleInfo.PluginsCount = GetPluginsCount( );
+
+    return CopyModuleDescriptor( &moduleInfo );
+}
+
+// Perform module clean-up routines
+MODULE_PUBLIC void ModuleCleanup( )
+{
+    UnregisterAllPlugins( );
+}
+
+// Get descriptor of the requested plug-in
+MODULE_PUBLIC PluginDescriptor* GetDescriptor( uint32_t plugin )
+{
+    return GetPluginDescriptor( plugin );
+}
+
+}
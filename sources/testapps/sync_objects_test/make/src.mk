@@ -0,0 +1,13 @@
+# sync_objects_test test application's source files
+
+# search path for source files
+VPATH = ../../
+
+# source files
+SRC = sync_objects_test.cpp
+
+# additional include folders
+INCLUDES = -I../../../../afx/afx_types -I../../../../afx/afx_types+ -I../../../../afx/afx_platform+
+
+# libraries to use
+LIBS = -lafx_platform+
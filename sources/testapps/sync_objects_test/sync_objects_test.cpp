@@ -0,0 +1,440 @@
+/*
+    Test of semaphore and auto reset event synchronization objects
+
+    Copyright (C) 2011-2018, cvsandbox
+    http://www.cvsandbox.com/contacts.html
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+#include <XThread.hpp>
+#include <XSemaphore.hpp>
+#include <XAutoResetEvent.hpp>
+
+using namespace std;
+using namespace std::chrono;
+using namespace CVSandbox::Threading;
+
+// Number of threads waiting on the same object
+#define WAITERS_COUNT    5
+// Number of wake ups done by stress tests
+#define STRESS_WAKE_UPS  100000
+
+// Number of failed checks
+static int FailedChecks = 0;
+
+static void TestSemaphoreTimeout( );
+static void TestSemaphoreInitialCount( );
+static void TestSemaphoreWakeCount( );
+static void TestSemaphoreStress( );
+static void TestEventTimeout( );
+static void TestEventWakesSingleWaiter( );
+static void TestWaitAnyTimeout( );
+static void TestWaitAnyResetsOnlyReturnedEvent( );
+static void TestWaitAnyWakeUp( );
+static void TestWaitAnyStress( );
+
+int main( int /* argc */, char** /* argv */ )
+{
+    printf( "Testing synchronization objects ... \n" );
+
+    TestSemaphoreTimeout( );
+    TestSemaphoreInitialCount( );
+    TestSemaphoreWakeCount( );
+    TestSemaphoreStress( );
+    TestEventTimeout( );
+    TestEventWakesSingleWaiter( );
+    TestWaitAnyTimeout( );
+    TestWaitAnyResetsOnlyReturnedEvent( );
+    TestWaitAnyWakeUp( );
+    TestWaitAnyStress( );
+
+    printf( "\n%s\n", ( FailedChecks == 0 ) ? "done" : "FAILED" );
+
+    return ( FailedChecks == 0 ) ? 0 : 1;
+}
+
+// Report result of a check
+static void Check( bool passed, const char* what )
+{
+    printf( "  %s - %s \n", ( passed ) ? "passed" : "FAILED", what );
+
+    if ( !passed )
+    {
+        FailedChecks++;
+    }
+}
+
+// Get number of milliseconds passed since the specified time
+static uint32_t MsecSince( steady_clock::time_point startTime )
+{
+    return static_cast<uint32_t>( duration_cast<milliseconds>( steady_clock::now( ) - startTime ).count( ) );
+}
+
+// Thread counting how many times it managed to decrease semaphore's count
+struct SemaphoreWaiterParam
+{
+    XSemaphore*         Semaphore;
+    uint32_t            WaitMsec;
+    uint32_t            WaitsCount;
+    atomic<uint32_t>*   Acquired;
+};
+
+static void SemaphoreWaiterThread( void* param )
+{
+    SemaphoreWaiterParam* p = static_cast<SemaphoreWaiterParam*>( param );
+
+    for ( uint32_t i = 0; i < p->WaitsCount; i++ )
+    {
+        if ( p->Semaphore->Wait( p->WaitMsec ) )
+        {
+            ( *p->Acquired )++;
+        }
+    }
+}
+
+// Check waiting on semaphore with zero count times out after the specified time
+static void TestSemaphoreTimeout( )
+{
+    XSemaphore semaphore;
+
+    printf( "\nSemaphore timeout: \n" );
+
+    steady_clock::time_point startTime = steady_clock::now( );
+    bool                     acquired  = semaphore.Wait( 100 );
+    uint32_t                 timeTaken = MsecSince( startTime );
+
+    Check( !acquired, "count is not decreased below zero" );
+    Check( ( timeTaken >= 90 ) && ( timeTaken < 1000 ), "wait takes the specified time" );
+    Check( !semaphore.Wait( 0 ), "zero timeout returns immediately" );
+}
+
+// Check initial count allows that many waits without blocking
+static void TestSemaphoreInitialCount( )
+{
+    XSemaphore semaphore( 3 );
+    int        acquired = 0;
+
+    printf( "\nSemaphore initial count: \n" );
+
+    while ( ( acquired < 10 ) && ( semaphore.Wait( 0 ) ) )
+    {
+        acquired++;
+    }
+
+    Check( acquired == 3, "initial count is taken" );
+
+    semaphore.Release( 2 );
+
+    Check( ( semaphore.Wait( 0 ) ) && ( semaphore.Wait( 0 ) ) && ( !semaphore.Wait( 0 ) ), "released count is taken" );
+}
+
+// Check releasing semaphore wakes as many waiting threads as its count was increased by
+static void TestSemaphoreWakeCount( )
+{
+    XSemaphore           semaphore;
+    atomic<uint32_t>     acquired( 0 );
+    SemaphoreWaiterParam param = { &semaphore, 2000, 1, &acquired };
+    XThread              threads[WAITERS_COUNT];
+
+    printf( "\nSemaphore wake count: \n" );
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Create( SemaphoreWaiterThread, &param );
+    }
+
+    // let waiters go to sleep first
+    XThread::Sleep( 100 );
+
+    semaphore.Release( 3 );
+    XThread::Sleep( 200 );
+
+    Check( acquired == 3, "release of 3 wakes 3 of 5 waiters" );
+
+    semaphore.Release( 2 );
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Join( );
+    }
+
+    Check( acquired == WAITERS_COUNT, "release of 2 more wakes the rest" );
+    Check( !semaphore.Wait( 0 ), "nothing is left in the count" );
+}
+
+// Check no release is lost or doubled when many threads wait and release concurrently
+static void TestSemaphoreStress( )
+{
+    XSemaphore           semaphore;
+    atomic<uint32_t>     acquired( 0 );
+    SemaphoreWaiterParam param = { &semaphore, 5000, STRESS_WAKE_UPS / WAITERS_COUNT, &acquired };
+    XThread              threads[WAITERS_COUNT];
+
+    printf( "\nSemaphore stress: \n" );
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Create( SemaphoreWaiterThread, &param );
+    }
+
+    for ( int i = 0; i < STRESS_WAKE_UPS; i++ )
+    {
+        semaphore.Release( );
+    }
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Join( );
+    }
+
+    Check( acquired == STRESS_WAKE_UPS, "every release is taken by a waiter" );
+    Check( !semaphore.Wait( 0 ), "nothing is left in the count" );
+}
+
+// Thread counting how many times the event released it
+struct EventWaiterParam
+{
+    XAutoResetEvent*    Event;
+    uint32_t            WaitMsec;
+    atomic<uint32_t>*   Released;
+};
+
+static void EventWaiterThread( void* param )
+{
+    EventWaiterParam* p = static_cast<EventWaiterParam*>( param );
+
+    if ( p->Event->Wait( p->WaitMsec ) )
+    {
+        ( *p->Released )++;
+    }
+}
+
+// Check waiting for not signalled event times out after the specified time
+static void TestEventTimeout( )
+{
+    XAutoResetEvent event;
+
+    printf( "\nAuto reset event timeout: \n" );
+
+    steady_clock::time_point startTime = steady_clock::now( );
+    bool                     signalled = event.Wait( 100 );
+    uint32_t                 timeTaken = MsecSince( startTime );
+
+    Check( !signalled, "not signalled event times out" );
+    Check( ( timeTaken >= 90 ) && ( timeTaken < 1000 ), "wait takes the specified time" );
+
+    event.Signal( );
+    event.Signal( );
+
+    Check( ( event.Wait( 0 ) ) && ( !event.Wait( 0 ) ), "event is reset by the first wait" );
+}
+
+// Check single signal releases only one of the waiting threads
+static void TestEventWakesSingleWaiter( )
+{
+    XAutoResetEvent  event;
+    atomic<uint32_t> released( 0 );
+    EventWaiterParam param = { &event, 1000, &released };
+    XThread          threads[WAITERS_COUNT];
+
+    printf( "\nAuto reset event with many waiters: \n" );
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Create( EventWaiterThread, &param );
+    }
+
+    XThread::Sleep( 100 );
+
+    event.Signal( );
+    XThread::Sleep( 200 );
+
+    Check( released == 1, "signal releases one waiter" );
+
+    event.Signal( );
+
+    for ( int i = 0; i < WAITERS_COUNT; i++ )
+    {
+        threads[i].Join( );
+    }
+
+    Check( released == 2, "another signal releases another waiter, the rest time out" );
+}
+
+// Check waiting for any of not signalled events times out after the specified time
+static void TestWaitAnyTimeout( )
+{
+    XAutoResetEvent  event1;
+    XAutoResetEvent  event2;
+    XAutoResetEvent* events[] = { &event1, &event2 };
+
+    printf( "\nWaitAny timeout: \n" );
+
+    steady_clock::time_point startTime = steady_clock::now( );
+    int32_t                  index     = XAutoResetEvent::WaitAny( events, 2, 100 );
+    uint32_t                 timeTaken = MsecSince( startTime );
+
+    Check( index == -1, "-1 is returned on timeout" );
+    Check( ( timeTaken >= 90 ) && ( timeTaken < 1000 ), "wait takes the specified time" );
+    Check( XAutoResetEvent::WaitAny( events, 2, 0 ) == -1, "zero timeout returns immediately" );
+}
+
+// Check only the event, which index is returned, gets reset
+static void TestWaitAnyResetsOnlyReturnedEvent( )
+{
+    XAutoResetEvent  event1;
+    XAutoResetEvent  event2;
+    XAutoResetEvent  event3;
+    XAutoResetEvent* events[] = { &event1, &event2, &event3 };
+
+    printf( "\nWaitAny with signalled events: \n" );
+
+    event2.Signal( );
+    event3.Signal( );
+
+    int32_t index1 = XAutoResetEvent::WaitAny( events, 3, 100 );
+    int32_t index2 = XAutoResetEvent::WaitAny( events, 3, 100 );
+    int32_t index3 = XAutoResetEvent::WaitAny( events, 3, 0 );
+
+    Check( ( index1 == 1 ) && ( index2 == 2 ) && ( index3 == -1 ), "each signalled event is returned once" );
+
+    event3.Signal( );
+
+    Check( XAutoResetEvent::WaitAny( events, 3 ) == 2, "wait without timeout returns signalled event" );
+    Check( ( !event1.Wait( 0 ) ) && ( !event2.Wait( 0 ) ) && ( !event3.Wait( 0 ) ), "no event is left signalled" );
+}
+
+// Thread signalling the specified event after a delay
+struct DelayedSignalParam
+{
+    XAutoResetEvent*    Event;
+    uint32_t            DelayMsec;
+};
+
+static void DelayedSignalThread( void* param )
+{
+    DelayedSignalParam* p = static_cast<DelayedSignalParam*>( param );
+
+    XThread::Sleep( p->DelayMsec );
+    p->Event->Signal( );
+}
+
+// Check WaitAny sleeping thread is woken up by an event signalled later
+static void TestWaitAnyWakeUp( )
+{
+    XAutoResetEvent    event1;
+    XAutoResetEvent    event2;
+    XAutoResetEvent*   events[] = { &event1, &event2 };
+    DelayedSignalParam param    = { &event2, 100 };
+    XThread            thread;
+
+    printf( "\nWaitAny wake up: \n" );
+
+    thread.Create( DelayedSignalThread, &param );
+
+    steady_clock::time_point startTime = steady_clock::now( );
+    int32_t                  index     = XAutoResetEvent::WaitAny( events, 2, 2000 );
+    uint32_t                 timeTaken = MsecSince( startTime );
+
+    thread.Join( );
+
+    Check( index == 1, "index of the signalled event is returned" );
+    Check( ( timeTaken >= 90 ) && ( timeTaken < 1000 ), "waiter is woken up once the event is signalled" );
+
+    // the same event can also be waited directly, while other threads wait for it among others
+    atomic<uint32_t> released( 0 );
+    EventWaiterParam waiterParam = { &event1, 1000, &released };
+    XThread          waiterThread;
+
+    waiterThread.Create( EventWaiterThread, &waiterParam );
+    XThread::Sleep( 50 );
+
+    thread.Create( DelayedSignalThread, &param );
+    index = XAutoResetEvent::WaitAny( events, 2, 1000 );
+    thread.Join( );
+
+    event1.Signal( );
+    waiterThread.Join( );
+
+    Check( ( index == 1 ) && ( released == 1 ), "direct waiter of an event taking part in WaitAny is released as well" );
+}
+
+// Thread signalling one of two events many times, waiting till the signal is consumed each time
+struct PingParam
+{
+    XAutoResetEvent*    Events[2];
+    XAutoResetEvent*    Consumed;
+    uint32_t            Count;
+};
+
+static void PingThread( void* param )
+{
+    PingParam* p = static_cast<PingParam*>( param );
+
+    for ( uint32_t i = 0; i < p->Count; i++ )
+    {
+        p->Events[i & 1]->Signal( );
+
+        if ( !p->Consumed->Wait( 5000 ) )
+        {
+            break;
+        }
+    }
+}
+
+// Check no signal is lost when WaitAny goes to sleep and wakes up many times
+static void TestWaitAnyStress( )
+{
+    XAutoResetEvent  event1;
+    XAutoResetEvent  event2;
+    XAutoResetEvent  consumed;
+    XAutoResetEvent* events[] = { &event1, &event2 };
+    PingParam        param    = { { &event1, &event2 }, &consumed, STRESS_WAKE_UPS };
+    XThread          thread;
+    uint32_t         received = 0;
+    bool             ordered  = true;
+
+    printf( "\nWaitAny stress: \n" );
+
+    thread.Create( PingThread, &param );
+
+    while ( received < STRESS_WAKE_UPS )
+    {
+        int32_t index = XAutoResetEvent::WaitAny( events, 2, 5000 );
+
+        if ( index == -1 )
+        {
+            break;
+        }
+
+        if ( index != static_cast<int32_t>( received & 1 ) )
+        {
+            ordered = false;
+        }
+
+        received++;
+        consumed.Signal( );
+    }
+
+    thread.Join( );
+
+    Check( received == STRESS_WAKE_UPS, "every signal is received" );
+    Check( ordered, "signals are received from the right events" );
+}